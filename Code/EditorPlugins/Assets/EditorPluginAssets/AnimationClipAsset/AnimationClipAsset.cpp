@@ -29,12 +29,13 @@ EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezAnimationClipAssetProperties, 2, ezRTTIDefault
     EZ_MEMBER_PROPERTY("RootMotionVelocity", m_vCustomRootMotion),
     EZ_MEMBER_PROPERTY("Joint1", m_sJoint1),
     EZ_MEMBER_PROPERTY("Joint2", m_sJoint2),
+    EZ_MEMBER_PROPERTY("CompressKeyframes", m_bCompressKeyframes)->AddAttributes(new ezDefaultValueAttribute(true)),
   }
   EZ_END_PROPERTIES;
 }
 EZ_END_DYNAMIC_REFLECTED_TYPE;
 
-EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezAnimationClipAssetDocument, 2, ezRTTINoAllocator)
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezAnimationClipAssetDocument, 5, ezRTTINoAllocator)
 EZ_END_DYNAMIC_REFLECTED_TYPE;
 // clang-format on
 
@@ -132,6 +133,24 @@ ezStatus ezAnimationClipAssetDocument::InternalTransformAsset(ezStreamWriter& st
     }
   }
 
+  // store the motion matching features of every frame, so that they don't need to be computed when the simulation starts
+  if (!pProp->m_sJoint1.IsEmpty() && !pProp->m_sJoint2.IsEmpty())
+  {
+    ezHashedString sLeftFoot, sRightFoot;
+    sLeftFoot.Assign(pProp->m_sJoint1.GetData());
+    sRightFoot.Assign(pProp->m_sJoint2.GetData());
+
+    ezJointMapping mapping;
+    mapping.CreateMapping(skeleton, anim);
+
+    anim.GetMotionMatchingFeatures().Compute(anim, mapping, skeleton, sLeftFoot, sRightFoot);
+  }
+
+  if (pProp->m_bCompressKeyframes)
+  {
+    anim.Compress(ezAnimationClipCompressionSettings());
+  }
+
   anim.Save(stream);
 
   return ezStatus(EZ_SUCCESS);
@@ -176,12 +195,15 @@ void ezAnimationClipAssetDocument::ExtractRootMotionFromFeet(ezAnimationClipReso
   ezAnimationPose pose;
   pose.Configure(skeleton);
 
+  ezJointMapping mapping;
+  mapping.CreateMapping(skeleton, anim);
+
   ezVec3 lastFootPos1(0), lastFootPos2(0);
 
   // init last foot position with very last frame data
   {
     pose.SetToBindPoseInLocalSpace(skeleton);
-    anim.SetPoseToKeyframe(pose, skeleton, anim.GetNumFrames() - 1);
+    anim.SetPoseToKeyframe(pose, mapping, anim.GetNumFrames() - 1);
     pose.ConvertFromLocalSpaceToObjectSpace(skeleton);
 
     lastFootPos1 = pose.GetTransform(uiFoot1).GetTranslationVector();
@@ -195,7 +217,7 @@ void ezAnimationClipAssetDocument::ExtractRootMotionFromFeet(ezAnimationClipReso
   for (ezUInt16 frame = 0; frame < anim.GetNumFrames(); ++frame)
   {
     pose.SetToBindPoseInLocalSpace(skeleton);
-    anim.SetPoseToKeyframe(pose, skeleton, frame);
+    anim.SetPoseToKeyframe(pose, mapping, frame);
     pose.ConvertFromLocalSpaceToObjectSpace(skeleton);
 
     const ezVec3 footPos1 = pose.GetTransform(uiFoot1).GetTranslationVector();
@@ -57,10 +57,10 @@ EZ_END_SUBSYSTEM_DECLARATION;
 
 ezResourceTypeLoader* ezResourceManager::GetResourceTypeLoader(const ezRTTI* pRTTI)
 {
-  return s_State->s_ResourceTypeLoader[pRTTI];
+  return s_State->s_ResourceTypeLoader.GetValueOrDefault(pRTTI, nullptr);
 }
 
-ezMap<const ezRTTI*, ezResourceTypeLoader*>& ezResourceManager::GetResourceTypeLoaders()
+ezBTreeMap<const ezRTTI*, ezResourceTypeLoader*>& ezResourceManager::GetResourceTypeLoaders()
 {
   return s_State->s_ResourceTypeLoader;
 }
@@ -369,7 +369,12 @@ bool ezResourceManager::IsResourceTypeAcquireDuringUpdateContentAllowed(const ez
       visited.Insert(pRtti);
       deps.Insert(pRtti);
 
-      for (const ezRTTI* pNestedRtti : s_State->m_TypeInfo[pRtti].m_NestedTypes)
+      // use Find instead of operator[], inserting into m_TypeInfo would invalidate 'info'
+      auto itNested = s_State->m_TypeInfo.Find(pRtti);
+      if (!itNested.IsValid())
+        continue;
+
+      for (const ezRTTI* pNestedRtti : itNested.Value().m_NestedTypes)
       {
         if (!visited.Contains(pNestedRtti))
         {
@@ -72,7 +72,7 @@ private:
 
   // Type Loaders
 
-  ezMap<const ezRTTI*, ezResourceTypeLoader*> s_ResourceTypeLoader;
+  ezBTreeMap<const ezRTTI*, ezResourceTypeLoader*> s_ResourceTypeLoader;
   ezResourceLoaderFromFile s_FileResourceLoader;
   ezResourceTypeLoader* s_pDefaultResourceLoader = &s_FileResourceLoader;
   ezMap<ezResource*, ezUniquePtr<ezResourceTypeLoader>> s_CustomLoaders;
@@ -80,7 +80,7 @@ private:
 
   // Override / derived resources
 
-  ezMap<const ezRTTI*, ezHybridArray<ezResourceManager::DerivedTypeInfo, 4>> s_DerivedTypeInfos;
+  ezBTreeMap<const ezRTTI*, ezHybridArray<ezResourceManager::DerivedTypeInfo, 4>> s_DerivedTypeInfos;
 
 
   // Named resources
@@ -101,5 +101,5 @@ private:
   ezTime m_AutoFreeUnusedTimeout = ezTime::Zero();
   ezTime m_AutoFreeUnusedThreshold = ezTime::Zero();
 
-  ezMap<const ezRTTI*, ezResourceManager::ResourceTypeInfo> m_TypeInfo;
+  ezBTreeMap<const ezRTTI*, ezResourceManager::ResourceTypeInfo> m_TypeInfo;
 };
@@ -5,6 +5,7 @@
 #include <Core/ResourceManager/ResourceHandle.h>
 #include <Core/ResourceManager/ResourceTypeLoader.h>
 #include <Foundation/Configuration/Plugin.h>
+#include <Foundation/Containers/BTreeMap.h>
 #include <Foundation/Containers/HashTable.h>
 #include <Foundation/Threading/LockedObject.h>
 #include <Foundation/Types/UniquePtr.h>
@@ -463,7 +464,7 @@ private:
 private:
   static ezResourceTypeLoader* GetResourceTypeLoader(const ezRTTI* pRTTI);
 
-  static ezMap<const ezRTTI*, ezResourceTypeLoader*>& GetResourceTypeLoaders();
+  static ezBTreeMap<const ezRTTI*, ezResourceTypeLoader*>& GetResourceTypeLoaders();
 
   // Override / derived resources
 private:
@@ -64,6 +64,10 @@ namespace ezInternal
       m_Random.Initialize(desc.m_uiRandomNumberGeneratorSeed);
     }
 
+    ezStringBuilder sStatName;
+    sStatName.Format(ezFmt(EZ_FMT_STRING("World Update/{0}/Game Object Count"), m_sName));
+    m_GameObjectCountStat.SetName(sStatName);
+
     // insert dummy entry to save some checks
     m_Objects.Insert(nullptr);
 
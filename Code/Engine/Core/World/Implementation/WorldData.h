@@ -6,6 +6,7 @@
 #include <Foundation/Memory/FrameAllocator.h>
 #include <Foundation/Threading/DelegateTask.h>
 #include <Foundation/Time/Clock.h>
+#include <Foundation/Utilities/Stats.h>
 
 #include <Core/World/GameObject.h>
 #include <Core/World/WorldDesc.h>
@@ -203,6 +204,8 @@ namespace ezInternal
     ezClock m_Clock;
     ezRandom m_Random;
 
+    ezStatsGauge m_GameObjectCountStat;
+
     struct QueuedMsgMetaData
     {
       EZ_DECLARE_POD_TYPE();
@@ -0,0 +1,34 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Algorithm/Sorting.h>
+#include <Foundation/Threading/TaskSystem.h>
+
+ezUInt32 ezSorting::GetParallelBlockCount(ezUInt32 uiNumItems)
+{
+  if (uiNumItems < PARALLEL_THRESHOLD)
+    return 1;
+
+  const ezUInt32 uiNumWorkers = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks);
+  const ezUInt32 uiMaxBlocks = uiNumItems / MIN_ITEMS_PER_PARALLEL_BLOCK;
+
+  return ezMath::Clamp<ezUInt32>(ezMath::Min(uiNumWorkers, uiMaxBlocks), 1, MAX_PARALLEL_BLOCKS);
+}
+
+void ezSorting::ParallelForBlocks(ezUInt32 uiNumBlocks, ParallelBlockFunction func)
+{
+  ezParallelForParams params;
+  params.uiBinSize = 1;
+  params.uiMaxTasksPerThread = 1;
+
+  ezTaskSystem::ParallelForIndexed(
+    0, uiNumBlocks,
+    [&func](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+      for (ezUInt32 uiBlock = uiStartIndex; uiBlock < uiEndIndex; ++uiBlock)
+      {
+        func(uiBlock);
+      }
+    },
+    "ezSorting", params);
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Algorithm_Implementation_Sorting);
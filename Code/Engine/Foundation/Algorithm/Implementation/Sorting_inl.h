@@ -153,3 +153,452 @@ void ezSorting::InsertionSort(ezArrayPtr<T>& arrayPtr, ezUInt32 uiStartIndex, ez
     }
   }
 }
+
+
+template <typename KeyType>
+EZ_ALWAYS_INLINE auto ezSorting::ToRadixKey(KeyType key)
+{
+  if constexpr (std::is_same<KeyType, float>::value)
+  {
+    ezUInt32 uiBits;
+    memcpy(&uiBits, &key, sizeof(ezUInt32));
+
+    // negative floats are ordered in reverse, positive ones just need to come after the negative ones
+    return (uiBits & 0x80000000u) ? ~uiBits : (uiBits | 0x80000000u);
+  }
+  else if constexpr (std::is_same<KeyType, double>::value)
+  {
+    ezUInt64 uiBits;
+    memcpy(&uiBits, &key, sizeof(ezUInt64));
+
+    return (uiBits & 0x8000000000000000ull) ? ~uiBits : (uiBits | 0x8000000000000000ull);
+  }
+  else
+  {
+    EZ_CHECK_AT_COMPILETIME_MSG(std::is_integral<KeyType>::value, "RadixSort only supports integral and floating point keys");
+
+    using UnsignedKeyType = typename std::make_unsigned<KeyType>::type;
+
+    if constexpr (std::is_signed<KeyType>::value)
+    {
+      // flip the sign bit, so that negative values come first
+      return static_cast<UnsignedKeyType>(static_cast<UnsignedKeyType>(key) ^ (UnsignedKeyType(1) << (sizeof(UnsignedKeyType) * 8 - 1)));
+    }
+    else
+    {
+      return static_cast<UnsignedKeyType>(key);
+    }
+  }
+}
+
+template <typename T, typename KeyExtractor>
+void ezSorting::RadixSort(ezArrayPtr<T> arrayPtr, const KeyExtractor& keyExtractor)
+{
+  using RadixKey = RadixKeyType<T, KeyExtractor>;
+  constexpr ezUInt32 uiNumPasses = sizeof(RadixKey);
+
+  const ezUInt32 uiCount = arrayPtr.GetCount();
+  if (uiCount <= INSERTION_THRESHOLD)
+  {
+    if (uiCount > 1)
+    {
+      InsertionSort(arrayPtr, 0, uiCount - 1,
+        [&keyExtractor](const T& a, const T& b) { return ToRadixKey(keyExtractor(a)) < ToRadixKey(keyExtractor(b)); });
+    }
+
+    return;
+  }
+
+  T* pData = arrayPtr.GetPtr();
+
+  // build the histograms for all passes at once
+  ezUInt32 histograms[uiNumPasses][256] = {};
+  for (ezUInt32 i = 0; i < uiCount; ++i)
+  {
+    const RadixKey key = ToRadixKey(keyExtractor(pData[i]));
+    for (ezUInt32 uiPass = 0; uiPass < uiNumPasses; ++uiPass)
+    {
+      ++histograms[uiPass][(key >> (uiPass * 8)) & 0xFF];
+    }
+  }
+
+  ezAllocatorBase* pAllocator = ezFoundation::GetDefaultAllocator();
+  T* pTemp = EZ_NEW_RAW_BUFFER(pAllocator, T, uiCount);
+
+  T* pSrc = pData;
+  T* pDst = pTemp;
+
+  for (ezUInt32 uiPass = 0; uiPass < uiNumPasses; ++uiPass)
+  {
+    const ezUInt32 uiShift = uiPass * 8;
+    ezUInt32* pOffsets = histograms[uiPass];
+
+    // all keys have the same value in this byte, nothing to do
+    if (pOffsets[(ToRadixKey(keyExtractor(pSrc[0])) >> uiShift) & 0xFF] == uiCount)
+      continue;
+
+    ezUInt32 uiSum = 0;
+    for (ezUInt32 uiBucket = 0; uiBucket < 256; ++uiBucket)
+    {
+      const ezUInt32 uiBucketCount = pOffsets[uiBucket];
+      pOffsets[uiBucket] = uiSum;
+      uiSum += uiBucketCount;
+    }
+
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      const ezUInt32 uiBucket = (ToRadixKey(keyExtractor(pSrc[i])) >> uiShift) & 0xFF;
+      ezMemoryUtils::RelocateConstruct(pDst + pOffsets[uiBucket]++, pSrc + i, 1);
+    }
+
+    ezMath::Swap(pSrc, pDst);
+  }
+
+  if (pSrc != pData)
+  {
+    ezMemoryUtils::RelocateConstruct(pData, pSrc, uiCount);
+  }
+
+  EZ_DELETE_RAW_BUFFER(pAllocator, pTemp);
+}
+
+template <typename T, typename KeyExtractor>
+void ezSorting::ParallelRadixSort(ezArrayPtr<T> arrayPtr, const KeyExtractor& keyExtractor)
+{
+  using RadixKey = RadixKeyType<T, KeyExtractor>;
+  constexpr ezUInt32 uiNumPasses = sizeof(RadixKey);
+
+  const ezUInt32 uiCount = arrayPtr.GetCount();
+  const ezUInt32 uiNumBlocks = GetParallelBlockCount(uiCount);
+
+  if (uiNumBlocks <= 1)
+  {
+    RadixSort(arrayPtr, keyExtractor);
+    return;
+  }
+
+  struct Context
+  {
+    const KeyExtractor* m_pKeyExtractor;
+    T* m_pSrc;
+    T* m_pDst;
+    ezUInt32* m_pBlockOffsets; // 256 entries per block
+    ezUInt32 m_uiCount;
+    ezUInt32 m_uiNumBlocks;
+    ezUInt32 m_uiShift;
+  };
+
+  ezAllocatorBase* pAllocator = ezFoundation::GetDefaultAllocator();
+  T* pTemp = EZ_NEW_RAW_BUFFER(pAllocator, T, uiCount);
+  ezUInt32* pBlockOffsets = EZ_NEW_RAW_BUFFER(pAllocator, ezUInt32, uiNumBlocks * 256);
+
+  Context ctx;
+  ctx.m_pKeyExtractor = &keyExtractor;
+  ctx.m_pSrc = arrayPtr.GetPtr();
+  ctx.m_pDst = pTemp;
+  ctx.m_pBlockOffsets = pBlockOffsets;
+  ctx.m_uiCount = uiCount;
+  ctx.m_uiNumBlocks = uiNumBlocks;
+
+  for (ezUInt32 uiPass = 0; uiPass < uiNumPasses; ++uiPass)
+  {
+    ctx.m_uiShift = uiPass * 8;
+
+    ParallelForBlocks(uiNumBlocks, [&ctx](ezUInt32 uiBlock) {
+      ezUInt32* pHistogram = ctx.m_pBlockOffsets + uiBlock * 256;
+      ezMemoryUtils::ZeroFill(pHistogram, 256);
+
+      const ezUInt32 uiEnd = GetBlockStart(uiBlock + 1, ctx.m_uiNumBlocks, ctx.m_uiCount);
+      for (ezUInt32 i = GetBlockStart(uiBlock, ctx.m_uiNumBlocks, ctx.m_uiCount); i < uiEnd; ++i)
+      {
+        ++pHistogram[(ToRadixKey((*ctx.m_pKeyExtractor)(ctx.m_pSrc[i])) >> ctx.m_uiShift) & 0xFF];
+      }
+    });
+
+    // turn the per block histograms into per block write offsets: bucket by bucket, and within a bucket block by block to keep it stable
+    ezUInt32 uiSum = 0;
+    bool bAllInOneBucket = false;
+    for (ezUInt32 uiBucket = 0; uiBucket < 256; ++uiBucket)
+    {
+      const ezUInt32 uiBucketStart = uiSum;
+
+      for (ezUInt32 uiBlock = 0; uiBlock < uiNumBlocks; ++uiBlock)
+      {
+        ezUInt32& uiOffset = pBlockOffsets[uiBlock * 256 + uiBucket];
+        const ezUInt32 uiBlockCount = uiOffset;
+        uiOffset = uiSum;
+        uiSum += uiBlockCount;
+      }
+
+      bAllInOneBucket |= (uiSum - uiBucketStart) == uiCount;
+    }
+
+    // all keys have the same value in this byte, nothing to do
+    if (bAllInOneBucket)
+      continue;
+
+    ParallelForBlocks(uiNumBlocks, [&ctx](ezUInt32 uiBlock) {
+      ezUInt32* pOffsets = ctx.m_pBlockOffsets + uiBlock * 256;
+
+      const ezUInt32 uiEnd = GetBlockStart(uiBlock + 1, ctx.m_uiNumBlocks, ctx.m_uiCount);
+      for (ezUInt32 i = GetBlockStart(uiBlock, ctx.m_uiNumBlocks, ctx.m_uiCount); i < uiEnd; ++i)
+      {
+        const ezUInt32 uiBucket = (ToRadixKey((*ctx.m_pKeyExtractor)(ctx.m_pSrc[i])) >> ctx.m_uiShift) & 0xFF;
+        ezMemoryUtils::RelocateConstruct(ctx.m_pDst + pOffsets[uiBucket]++, ctx.m_pSrc + i, 1);
+      }
+    });
+
+    ezMath::Swap(ctx.m_pSrc, ctx.m_pDst);
+  }
+
+  if (ctx.m_pSrc != arrayPtr.GetPtr())
+  {
+    ctx.m_pDst = arrayPtr.GetPtr();
+
+    ParallelForBlocks(uiNumBlocks, [&ctx](ezUInt32 uiBlock) {
+      const ezUInt32 uiStart = GetBlockStart(uiBlock, ctx.m_uiNumBlocks, ctx.m_uiCount);
+      const ezUInt32 uiEnd = GetBlockStart(uiBlock + 1, ctx.m_uiNumBlocks, ctx.m_uiCount);
+      ezMemoryUtils::RelocateConstruct(ctx.m_pDst + uiStart, ctx.m_pSrc + uiStart, uiEnd - uiStart);
+    });
+  }
+
+  EZ_DELETE_RAW_BUFFER(pAllocator, pBlockOffsets);
+  EZ_DELETE_RAW_BUFFER(pAllocator, pTemp);
+}
+
+template <typename T, typename Comparer>
+void ezSorting::MergeSort(ezArrayPtr<T> arrayPtr, const Comparer& comparer)
+{
+  const ezUInt32 uiCount = arrayPtr.GetCount();
+  if (uiCount <= INSERTION_THRESHOLD)
+  {
+    if (uiCount > 1)
+    {
+      InsertionSort(arrayPtr, 0, uiCount - 1, comparer);
+    }
+
+    return;
+  }
+
+  ezAllocatorBase* pAllocator = ezFoundation::GetDefaultAllocator();
+  T* pTemp = EZ_NEW_RAW_BUFFER(pAllocator, T, uiCount);
+
+  MergeSort(arrayPtr.GetPtr(), pTemp, uiCount, comparer);
+
+  EZ_DELETE_RAW_BUFFER(pAllocator, pTemp);
+}
+
+template <typename T, typename Comparer>
+void ezSorting::ParallelMergeSort(ezArrayPtr<T> arrayPtr, const Comparer& comparer)
+{
+  const ezUInt32 uiCount = arrayPtr.GetCount();
+  const ezUInt32 uiNumBlocks = GetParallelBlockCount(uiCount);
+
+  if (uiNumBlocks <= 1)
+  {
+    MergeSort(arrayPtr, comparer);
+    return;
+  }
+
+  struct MergeChunk
+  {
+    ezUInt32 m_uiRunStart;
+    ezUInt32 m_uiRunMid;
+    ezUInt32 m_uiOutputStart; // relative to m_uiRunStart
+    ezUInt32 m_uiOutputEnd;
+    ezUInt32 m_uiStartA; // relative to m_uiRunStart
+    ezUInt32 m_uiEndA;
+  };
+
+  struct Context
+  {
+    const Comparer* m_pComparer;
+    T* m_pSrc;
+    T* m_pDst;
+    ezUInt32 m_uiCount;
+    ezUInt32 m_uiNumBlocks;
+    ezUInt32 m_uiRunStarts[MAX_PARALLEL_BLOCKS + 1];
+    MergeChunk m_Chunks[MAX_PARALLEL_BLOCKS * 2];
+  };
+
+  ezAllocatorBase* pAllocator = ezFoundation::GetDefaultAllocator();
+  T* pTemp = EZ_NEW_RAW_BUFFER(pAllocator, T, uiCount);
+
+  Context ctx;
+  ctx.m_pComparer = &comparer;
+  ctx.m_pSrc = arrayPtr.GetPtr();
+  ctx.m_pDst = pTemp;
+  ctx.m_uiCount = uiCount;
+  ctx.m_uiNumBlocks = uiNumBlocks;
+
+  // sort each block individually
+  ParallelForBlocks(uiNumBlocks, [&ctx](ezUInt32 uiBlock) {
+    const ezUInt32 uiStart = GetBlockStart(uiBlock, ctx.m_uiNumBlocks, ctx.m_uiCount);
+    const ezUInt32 uiEnd = GetBlockStart(uiBlock + 1, ctx.m_uiNumBlocks, ctx.m_uiCount);
+    MergeSort(ctx.m_pSrc + uiStart, ctx.m_pDst + uiStart, uiEnd - uiStart, *ctx.m_pComparer);
+  });
+
+  ezUInt32 uiNumRuns = uiNumBlocks;
+  for (ezUInt32 uiRun = 0; uiRun <= uiNumRuns; ++uiRun)
+  {
+    ctx.m_uiRunStarts[uiRun] = GetBlockStart(uiRun, uiNumBlocks, uiCount);
+  }
+
+  // merge pairs of runs until only one is left, each merge is split into roughly equally sized chunks
+  while (uiNumRuns > 1)
+  {
+    ezUInt32 uiNumChunks = 0;
+
+    for (ezUInt32 uiRun = 0; uiRun < uiNumRuns; uiRun += 2)
+    {
+      const ezUInt32 uiRunStart = ctx.m_uiRunStarts[uiRun];
+      const ezUInt32 uiRunMid = ctx.m_uiRunStarts[ezMath::Min(uiRun + 1, uiNumRuns)];
+      const ezUInt32 uiRunEnd = ctx.m_uiRunStarts[ezMath::Min(uiRun + 2, uiNumRuns)];
+      const ezUInt32 uiRunCount = uiRunEnd - uiRunStart;
+
+      const ezUInt32 uiNumRunChunks = static_cast<ezUInt32>((static_cast<ezUInt64>(uiRunCount) * uiNumBlocks + uiCount - 1) / uiCount);
+
+      // The split points are found before merging, as the merge relocates the source elements, which destroys them for types that
+      // are not mem-relocatable. Searching them while other chunks are merged would read destroyed objects.
+      const T* pA = ctx.m_pSrc + uiRunStart;
+      const T* pB = ctx.m_pSrc + uiRunMid;
+      const ezUInt32 uiCountA = uiRunMid - uiRunStart;
+      const ezUInt32 uiCountB = uiRunEnd - uiRunMid;
+
+      ezUInt32 uiOutputStart = 0;
+      ezUInt32 uiStartA = 0;
+
+      for (ezUInt32 uiChunk = 0; uiChunk < uiNumRunChunks; ++uiChunk)
+      {
+        const ezUInt32 uiOutputEnd = GetBlockStart(uiChunk + 1, uiNumRunChunks, uiRunCount);
+        const ezUInt32 uiEndA = FindMergeSplit(pA, uiCountA, pB, uiCountB, uiOutputEnd, comparer);
+
+        MergeChunk& chunk = ctx.m_Chunks[uiNumChunks++];
+        chunk.m_uiRunStart = uiRunStart;
+        chunk.m_uiRunMid = uiRunMid;
+        chunk.m_uiOutputStart = uiOutputStart;
+        chunk.m_uiOutputEnd = uiOutputEnd;
+        chunk.m_uiStartA = uiStartA;
+        chunk.m_uiEndA = uiEndA;
+
+        uiOutputStart = uiOutputEnd;
+        uiStartA = uiEndA;
+      }
+    }
+
+    ParallelForBlocks(uiNumChunks, [&ctx](ezUInt32 uiChunk) {
+      const MergeChunk& chunk = ctx.m_Chunks[uiChunk];
+
+      T* pA = ctx.m_pSrc + chunk.m_uiRunStart;
+      T* pB = ctx.m_pSrc + chunk.m_uiRunMid;
+
+      const ezUInt32 uiStartB = chunk.m_uiOutputStart - chunk.m_uiStartA;
+      const ezUInt32 uiEndB = chunk.m_uiOutputEnd - chunk.m_uiEndA;
+
+      MergeRuns(pA + chunk.m_uiStartA, chunk.m_uiEndA - chunk.m_uiStartA, pB + uiStartB, uiEndB - uiStartB,
+        ctx.m_pDst + chunk.m_uiRunStart + chunk.m_uiOutputStart, *ctx.m_pComparer);
+    });
+
+    const ezUInt32 uiNumMergedRuns = (uiNumRuns + 1) / 2;
+    for (ezUInt32 uiRun = 0; uiRun <= uiNumMergedRuns; ++uiRun)
+    {
+      ctx.m_uiRunStarts[uiRun] = ctx.m_uiRunStarts[ezMath::Min(uiRun * 2, uiNumRuns)];
+    }
+
+    uiNumRuns = uiNumMergedRuns;
+    ezMath::Swap(ctx.m_pSrc, ctx.m_pDst);
+  }
+
+  if (ctx.m_pSrc != arrayPtr.GetPtr())
+  {
+    ctx.m_pDst = arrayPtr.GetPtr();
+
+    ParallelForBlocks(uiNumBlocks, [&ctx](ezUInt32 uiBlock) {
+      const ezUInt32 uiStart = GetBlockStart(uiBlock, ctx.m_uiNumBlocks, ctx.m_uiCount);
+      const ezUInt32 uiEnd = GetBlockStart(uiBlock + 1, ctx.m_uiNumBlocks, ctx.m_uiCount);
+      ezMemoryUtils::RelocateConstruct(ctx.m_pDst + uiStart, ctx.m_pSrc + uiStart, uiEnd - uiStart);
+    });
+  }
+
+  EZ_DELETE_RAW_BUFFER(pAllocator, pTemp);
+}
+
+template <typename T, typename Comparer>
+void ezSorting::MergeSort(T* pData, T* pTemp, ezUInt32 uiCount, const Comparer& comparer)
+{
+  // sort small runs with insertion sort first
+  for (ezUInt32 uiStart = 0; uiStart < uiCount; uiStart += INSERTION_THRESHOLD)
+  {
+    ezArrayPtr<T> run(pData + uiStart, ezMath::Min<ezUInt32>(INSERTION_THRESHOLD, uiCount - uiStart));
+    InsertionSort(run, 0, run.GetCount() - 1, comparer);
+  }
+
+  T* pSrc = pData;
+  T* pDst = pTemp;
+
+  for (ezUInt32 uiWidth = INSERTION_THRESHOLD; uiWidth < uiCount; uiWidth *= 2)
+  {
+    for (ezUInt32 uiStart = 0; uiStart < uiCount; uiStart += 2 * uiWidth)
+    {
+      const ezUInt32 uiMid = ezMath::Min(uiStart + uiWidth, uiCount);
+      const ezUInt32 uiEnd = ezMath::Min(uiMid + uiWidth, uiCount);
+
+      MergeRuns(pSrc + uiStart, uiMid - uiStart, pSrc + uiMid, uiEnd - uiMid, pDst + uiStart, comparer);
+    }
+
+    ezMath::Swap(pSrc, pDst);
+  }
+
+  if (pSrc != pData)
+  {
+    ezMemoryUtils::RelocateConstruct(pData, pSrc, uiCount);
+  }
+}
+
+template <typename T, typename Comparer>
+void ezSorting::MergeRuns(T* pA, ezUInt32 uiCountA, T* pB, ezUInt32 uiCountB, T* pDestination, const Comparer& comparer)
+{
+  T* pEndA = pA + uiCountA;
+  T* pEndB = pB + uiCountB;
+
+  while (pA != pEndA && pB != pEndB)
+  {
+    // only take from B if it is strictly less, to keep the sort stable
+    if (DoCompare(comparer, *pB, *pA))
+    {
+      ezMemoryUtils::RelocateConstruct(pDestination, pB, 1);
+      ++pB;
+    }
+    else
+    {
+      ezMemoryUtils::RelocateConstruct(pDestination, pA, 1);
+      ++pA;
+    }
+
+    ++pDestination;
+  }
+
+  ezMemoryUtils::RelocateConstruct(pDestination, pA, pEndA - pA);
+  pDestination += pEndA - pA;
+  ezMemoryUtils::RelocateConstruct(pDestination, pB, pEndB - pB);
+}
+
+template <typename T, typename Comparer>
+ezUInt32 ezSorting::FindMergeSplit(const T* pA, ezUInt32 uiCountA, const T* pB, ezUInt32 uiCountB, ezUInt32 uiOutputIndex, const Comparer& comparer)
+{
+  ezUInt32 uiLow = uiOutputIndex > uiCountB ? uiOutputIndex - uiCountB : 0;
+  ezUInt32 uiHigh = ezMath::Min(uiOutputIndex, uiCountA);
+
+  while (uiLow < uiHigh)
+  {
+    const ezUInt32 uiMid = (uiLow + uiHigh) / 2;
+
+    // A[mid] is part of the output range if it is not larger than the element of B it competes with
+    if (DoCompare(comparer, pB[uiOutputIndex - uiMid - 1], pA[uiMid]))
+      uiHigh = uiMid;
+    else
+      uiLow = uiMid + 1;
+  }
+
+  return uiLow;
+}
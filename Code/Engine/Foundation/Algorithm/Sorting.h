@@ -5,9 +5,10 @@
 
 #include <Foundation/Algorithm/Comparer.h>
 #include <Foundation/Math/Math.h>
+#include <Foundation/Types/Delegate.h>
 
 /// \brief This class provides implementations of different sorting algorithms.
-class ezSorting
+class EZ_FOUNDATION_DLL ezSorting
 {
 public:
   /// \brief Sorts the elements in container using a in-place quick sort implementation (not stable).
@@ -27,10 +28,39 @@ public:
   template <typename T, typename Comparer>
   static void InsertionSort(ezArrayPtr<T>& arrayPtr, const Comparer& comparer = Comparer()); // [tested]
 
+
+  /// \brief Sorts the elements in the array using a LSD radix sort (stable, needs a temporary buffer of the same size).
+  ///
+  /// The key extractor is called with an element and must return an integral or floating point key by value,
+  /// e.g. [](const Item& item) { return item.m_uiSortingKey; }. One pass is done per key byte, passes in which all keys
+  /// share the same byte are skipped.
+  template <typename T, typename KeyExtractor>
+  static void RadixSort(ezArrayPtr<T> arrayPtr, const KeyExtractor& keyExtractor); // [tested]
+
+  /// \brief Same as RadixSort, but the histogram and scatter steps of each pass are distributed across the ezTaskSystem worker threads.
+  ///
+  /// Falls back to RadixSort for small arrays. Must not be called from a long running task.
+  template <typename T, typename KeyExtractor>
+  static void ParallelRadixSort(ezArrayPtr<T> arrayPtr, const KeyExtractor& keyExtractor); // [tested]
+
+  /// \brief Sorts the elements in the array using a bottom-up merge sort (stable, needs a temporary buffer of the same size).
+  template <typename T, typename Comparer = ezCompareHelper<T>>
+  static void MergeSort(ezArrayPtr<T> arrayPtr, const Comparer& comparer = Comparer()); // [tested]
+
+  /// \brief Same as MergeSort, but blocks are sorted in parallel and then merged pairwise, each merge being split across the ezTaskSystem
+  /// worker threads.
+  ///
+  /// Falls back to MergeSort for small arrays. Must not be called from a long running task.
+  template <typename T, typename Comparer = ezCompareHelper<T>>
+  static void ParallelMergeSort(ezArrayPtr<T> arrayPtr, const Comparer& comparer = Comparer()); // [tested]
+
 private:
   enum
   {
-    INSERTION_THRESHOLD = 16
+    INSERTION_THRESHOLD = 16,
+    PARALLEL_THRESHOLD = 1024 * 32,
+    MIN_ITEMS_PER_PARALLEL_BLOCK = 1024 * 8,
+    MAX_PARALLEL_BLOCKS = 64,
   };
 
   // Perform comparison either with "Less(a,b)" (prefered) or with operator ()(a,b)
@@ -72,6 +102,40 @@ private:
 
   template <typename T, typename Comparer>
   static void InsertionSort(ezArrayPtr<T>& arrayPtr, ezUInt32 uiStartIndex, ezUInt32 uiEndIndex, const Comparer& comparer);
+
+
+  /// \brief Maps a key to an unsigned integer of the same size whose ordering matches the ordering of the original key.
+  template <typename KeyType>
+  static auto ToRadixKey(KeyType key);
+
+  template <typename T, typename KeyExtractor>
+  using RadixKeyType = decltype(ToRadixKey(std::declval<const KeyExtractor&>()(std::declval<const T&>())));
+
+  template <typename T, typename Comparer>
+  static void MergeSort(T* pData, T* pTemp, ezUInt32 uiCount, const Comparer& comparer);
+
+  /// \brief Relocates the two sorted ranges A and B into pDestination. Elements from A come first if elements are equal.
+  template <typename T, typename Comparer>
+  static void MergeRuns(T* pA, ezUInt32 uiCountA, T* pB, ezUInt32 uiCountB, T* pDestination, const Comparer& comparer);
+
+  /// \brief Returns how many elements of A end up in the first uiOutputIndex elements when merging A and B.
+  template <typename T, typename Comparer>
+  static ezUInt32 FindMergeSplit(const T* pA, ezUInt32 uiCountA, const T* pB, ezUInt32 uiCountB, ezUInt32 uiOutputIndex, const Comparer& comparer);
+
+
+  using ParallelBlockFunction = ezDelegate<void(ezUInt32), 48>;
+
+  /// \brief Returns into how many blocks an array of the given size should be split for the parallel sorting variants. Returns 1 if it
+  /// should be sorted serially.
+  static ezUInt32 GetParallelBlockCount(ezUInt32 uiNumItems);
+
+  /// \brief Calls func for every block index in [0; uiNumBlocks) using the ezTaskSystem and waits for all of them to finish.
+  static void ParallelForBlocks(ezUInt32 uiNumBlocks, ParallelBlockFunction func);
+
+  EZ_ALWAYS_INLINE static ezUInt32 GetBlockStart(ezUInt32 uiBlock, ezUInt32 uiNumBlocks, ezUInt32 uiNumItems)
+  {
+    return static_cast<ezUInt32>((static_cast<ezUInt64>(uiNumItems) * uiBlock) / uiNumBlocks);
+  }
 };
 
 #include <Foundation/Algorithm/Implementation/Sorting_inl.h>
@@ -0,0 +1,448 @@
+#pragma once
+
+#include <Foundation/Algorithm/Comparer.h>
+#include <Foundation/Math/Math.h>
+#include <Foundation/Memory/AllocatorWrapper.h>
+#include <Foundation/SimdMath/SimdTypes.h>
+
+namespace ezInternal
+{
+  /// \brief Searches the sorted key array of a single B-tree node.
+  ///
+  /// The generic version does a branch-free binary search using the comparer. For 32 bit integer keys with the default comparer
+  /// a specialization that compares four keys per instruction is used when SSE is available.
+  template <typename KeyType, typename Comparer>
+  struct ezBTreeNodeSearch
+  {
+    /// \brief Returns the number of keys that are less than \a key, which is the index of the first key that is equal or larger.
+    template <typename CompatibleKeyType>
+    static ezUInt32 CountLess(const KeyType* pKeys, ezUInt32 uiCount, const CompatibleKeyType& key, const Comparer& comparer);
+
+    /// \brief Returns the number of keys that are less than or equal to \a key, which is the index of the first key that is larger.
+    template <typename CompatibleKeyType>
+    static ezUInt32 CountLessEqual(const KeyType* pKeys, ezUInt32 uiCount, const CompatibleKeyType& key, const Comparer& comparer);
+  };
+
+#if EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE
+  /// \brief SSE key search for 32 bit integer keys. Unsigned keys are biased, so that the signed compare instructions can be used.
+  template <typename KeyType, ezUInt32 Bias>
+  struct ezBTreeNodeSearchInt32
+  {
+    static ezUInt32 CountLess(const KeyType* pKeys, ezUInt32 uiCount, KeyType key, const ezCompareHelper<KeyType>& comparer);
+    static ezUInt32 CountLessEqual(const KeyType* pKeys, ezUInt32 uiCount, KeyType key, const ezCompareHelper<KeyType>& comparer);
+  };
+
+  template <>
+  struct ezBTreeNodeSearch<ezInt32, ezCompareHelper<ezInt32>> : public ezBTreeNodeSearchInt32<ezInt32, 0>
+  {
+  };
+
+  template <>
+  struct ezBTreeNodeSearch<ezUInt32, ezCompareHelper<ezUInt32>> : public ezBTreeNodeSearchInt32<ezUInt32, 0x80000000u>
+  {
+  };
+#endif
+
+  /// \brief Moves \a uiCount objects from \a pSource into the uninitialized memory at \a pDestination. The ranges may overlap.
+  /// Source objects that are not overwritten are destructed.
+  template <typename T>
+  void ezBTreeRelocate(T* pDestination, T* pSource, ezUInt32 uiCount);
+} // namespace ezInternal
+
+template <typename KeyType, typename Comparer>
+class ezBTreeSetBase;
+
+/// \brief An associative container with the same interface as ezMap, implemented as a B+ tree with wide nodes.
+///
+/// ezMap allocates one node per element and every lookup has to follow one pointer per tree level, which typically means one cache miss
+/// per level. ezBTreeMapBase stores up to NodeCapacity keys contiguously in each node (roughly 256 bytes of keys), and keeps the values in
+/// separate arrays in the leaves, so lookups only touch a few cache lines per level and the tree is much flatter. All elements are stored
+/// in the leaves, which are linked to each other, so ordered iteration is a linear walk over arrays.
+///
+/// Insertion/erasure/lookup take O(log n) time, just as with ezMap. The downside is that elements are moved around inside the tree when
+/// other elements are inserted or removed. Therefore, unlike with ezMap, iterators and pointers to keys or values are invalidated by
+/// every insertion and removal. Prefer ezMap if such references need to stay valid, and ezArrayMap if the container is rarely modified.
+///
+/// For 32 bit integer keys with the default comparer, the key search inside a node is vectorized when SSE is available.
+template <typename KeyType, typename ValueType, typename Comparer>
+class ezBTreeMapBase
+{
+public:
+  /// \brief The maximum number of keys stored in a single node.
+  static constexpr ezUInt32 NodeCapacity = (256 / sizeof(KeyType)) < 8 ? 8 : ((256 / sizeof(KeyType)) > 64 ? 64 : (256 / sizeof(KeyType)));
+
+private:
+  /// \brief Every node except the root stores at least this many keys.
+  static constexpr ezUInt32 MinNodeCount = NodeCapacity / 2;
+
+  /// \brief Enough for more than 2^32 elements, even with the minimal fan-out.
+  static constexpr ezUInt32 MaxDepth = 32;
+
+  using Search = ezInternal::ezBTreeNodeSearch<KeyType, Comparer>;
+
+  struct Node
+  {
+    EZ_ALWAYS_INLINE KeyType* GetKeys() { return reinterpret_cast<KeyType*>(m_KeyData); }
+
+    ezUInt16 m_uiCount = 0;
+    bool m_bIsLeaf = true;
+    alignas(KeyType) ezUInt8 m_KeyData[NodeCapacity * sizeof(KeyType)];
+  };
+
+  /// \brief Leaves store the elements. Inner nodes only store copies of keys to route the search.
+  struct Leaf : public Node
+  {
+    EZ_ALWAYS_INLINE ValueType* GetValues() { return reinterpret_cast<ValueType*>(m_ValueData); }
+
+    Leaf* m_pPrev = nullptr;
+    Leaf* m_pNext = nullptr;
+    alignas(ValueType) ezUInt8 m_ValueData[NodeCapacity * sizeof(ValueType)];
+  };
+
+  /// \brief Child i contains all keys that are less than key i, child i + 1 all keys that are equal or larger.
+  struct Inner : public Node
+  {
+    Node* m_pChildren[NodeCapacity + 1];
+  };
+
+  /// \brief The nodes visited while descending to a leaf, needed to propagate splits and merges upwards.
+  struct Path
+  {
+    Inner* m_pNodes[MaxDepth];
+    ezUInt32 m_uiChildIndex[MaxDepth];
+    ezUInt32 m_uiDepth = 0;
+  };
+
+public:
+  /// \brief Base class for all iterators.
+  struct ConstIterator
+  {
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = ConstIterator;
+    using difference_type = ptrdiff_t;
+    using pointer = ConstIterator*;
+    using reference = ConstIterator&;
+
+    EZ_DECLARE_POD_TYPE();
+
+    /// \brief Constructs an invalid iterator.
+    EZ_ALWAYS_INLINE ConstIterator() = default; // [tested]
+
+    /// \brief Checks whether this iterator points to a valid element.
+    EZ_ALWAYS_INLINE bool IsValid() const { return (m_pLeaf != nullptr); } // [tested]
+
+    /// \brief Checks whether the two iterators point to the same element.
+    EZ_ALWAYS_INLINE bool operator==(const ConstIterator& it2) const { return m_pLeaf == it2.m_pLeaf && m_uiIndex == it2.m_uiIndex; }
+
+    /// \brief Checks whether the two iterators point to the same element.
+    EZ_ALWAYS_INLINE bool operator!=(const ConstIterator& it2) const { return !(*this == it2); }
+
+    /// \brief Returns the 'key' of the element that this iterator points to.
+    EZ_FORCE_INLINE const KeyType& Key() const
+    {
+      EZ_ASSERT_DEBUG(IsValid(), "Cannot access the 'key' of an invalid iterator.");
+      return m_pLeaf->GetKeys()[m_uiIndex];
+    } // [tested]
+
+    /// \brief Returns the 'value' of the element that this iterator points to.
+    EZ_FORCE_INLINE const ValueType& Value() const
+    {
+      EZ_ASSERT_DEBUG(IsValid(), "Cannot access the 'value' of an invalid iterator.");
+      return m_pLeaf->GetValues()[m_uiIndex];
+    } // [tested]
+
+    /// \brief Returns '*this' to enable foreach
+    EZ_ALWAYS_INLINE ConstIterator& operator*() { return *this; } // [tested]
+
+    /// \brief Advances the iterator to the next element in the map. The iterator will not be valid anymore, if the end is reached.
+    void Next(); // [tested]
+
+    /// \brief Advances the iterator to the previous element in the map. The iterator will not be valid anymore, if the end is reached.
+    void Prev(); // [tested]
+
+    /// \brief Shorthand for 'Next'
+    EZ_ALWAYS_INLINE void operator++() { Next(); } // [tested]
+
+    /// \brief Shorthand for 'Prev'
+    EZ_ALWAYS_INLINE void operator--() { Prev(); } // [tested]
+
+  protected:
+    friend class ezBTreeMapBase<KeyType, ValueType, Comparer>;
+
+    EZ_ALWAYS_INLINE ConstIterator(Leaf* pLeaf, ezUInt32 uiIndex)
+      : m_pLeaf(pLeaf)
+      , m_uiIndex(uiIndex)
+    {
+    }
+
+    Leaf* m_pLeaf = nullptr;
+    ezUInt32 m_uiIndex = 0;
+  };
+
+  /// \brief Forward Iterator to iterate over all elements in sorted order.
+  struct Iterator : public ConstIterator
+  {
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Iterator;
+    using difference_type = ptrdiff_t;
+    using pointer = Iterator*;
+    using reference = Iterator&;
+
+    // this is required to pull in the const version of this function
+    using ConstIterator::Value;
+
+    EZ_DECLARE_POD_TYPE();
+
+    /// \brief Constructs an invalid iterator.
+    EZ_ALWAYS_INLINE Iterator() = default;
+
+    /// \brief Returns the 'value' of the element that this iterator points to.
+    EZ_FORCE_INLINE ValueType& Value()
+    {
+      EZ_ASSERT_DEBUG(this->IsValid(), "Cannot access the 'value' of an invalid iterator.");
+      return this->m_pLeaf->GetValues()[this->m_uiIndex];
+    }
+
+    /// \brief Returns '*this' to enable foreach
+    EZ_ALWAYS_INLINE Iterator& operator*() { return *this; } // [tested]
+
+  private:
+    friend class ezBTreeMapBase<KeyType, ValueType, Comparer>;
+
+    EZ_ALWAYS_INLINE Iterator(Leaf* pLeaf, ezUInt32 uiIndex)
+      : ConstIterator(pLeaf, uiIndex)
+    {
+    }
+  };
+
+protected:
+  /// \brief Initializes the map to be empty.
+  ezBTreeMapBase(const Comparer& comparer, ezAllocatorBase* pAllocator); // [tested]
+
+  /// \brief Copies all key/value pairs from the given map into this one.
+  ezBTreeMapBase(const ezBTreeMapBase<KeyType, ValueType, Comparer>& cc, ezAllocatorBase* pAllocator); // [tested]
+
+  /// \brief Destroys all elements from the map.
+  ~ezBTreeMapBase(); // [tested]
+
+  /// \brief Copies all key/value pairs from the given map into this one.
+  void operator=(const ezBTreeMapBase<KeyType, ValueType, Comparer>& rhs);
+
+public:
+  /// \brief Returns whether there are no elements in the map. O(1) operation.
+  bool IsEmpty() const; // [tested]
+
+  /// \brief Returns the number of elements currently stored in the map. O(1) operation.
+  ezUInt32 GetCount() const; // [tested]
+
+  /// \brief Destroys all elements in the map and resets its size to zero.
+  void Clear(); // [tested]
+
+  /// \brief Returns an Iterator to the very first element.
+  Iterator GetIterator(); // [tested]
+
+  /// \brief Returns a constant Iterator to the very first element.
+  ConstIterator GetIterator() const; // [tested]
+
+  /// \brief Returns an Iterator to the very last element. For reverse traversal.
+  Iterator GetLastIterator(); // [tested]
+
+  /// \brief Returns a constant Iterator to the very last element. For reverse traversal.
+  ConstIterator GetLastIterator() const; // [tested]
+
+  /// \brief Inserts the key/value pair into the tree and returns an Iterator to it. O(log n) operation.
+  template <typename CompatibleKeyType, typename CompatibleValueType>
+  Iterator Insert(CompatibleKeyType&& key, CompatibleValueType&& value); // [tested]
+
+  /// \brief Erases the key/value pair with the given key, if it exists. O(log n) operation.
+  template <typename CompatibleKeyType>
+  bool Remove(const CompatibleKeyType& key); // [tested]
+
+  /// \brief Erases the key/value pair at the given Iterator. O(log n) operation. Returns an iterator to the element after the given
+  /// iterator.
+  Iterator Remove(const Iterator& pos); // [tested]
+
+  /// \brief Searches for the given key and returns an iterator to it. If it did not exist yet, it is default-created. \a bExisted is set to
+  /// true, if the key was found, false if it needed to be created.
+  template <typename CompatibleKeyType>
+  Iterator FindOrAdd(CompatibleKeyType&& key, bool* bExisted = nullptr); // [tested]
+
+  /// \brief Allows read/write access to the value stored under the given key. If there is no such key, a new element is
+  /// default-constructed.
+  ///
+  /// \note The returned reference is invalidated by the next insertion or removal.
+  template <typename CompatibleKeyType>
+  ValueType& operator[](const CompatibleKeyType& key); // [tested]
+
+  /// \brief Returns a pointer to the value of the entry with the given key if found, otherwise returns nullptr.
+  template <typename CompatibleKeyType>
+  const ValueType* GetValue(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Returns a pointer to the value of the entry with the given key if found, otherwise returns nullptr.
+  template <typename CompatibleKeyType>
+  ValueType* GetValue(const CompatibleKeyType& key); // [tested]
+
+  /// \brief Either returns the value of the entry with the given key, if found, or the provided default value.
+  template <typename CompatibleKeyType>
+  const ValueType& GetValueOrDefault(const CompatibleKeyType& key, const ValueType& defaultValue) const; // [tested]
+
+  /// \brief Searches for key, returns an Iterator to it or an invalid iterator, if no such key is found. O(log n) operation.
+  template <typename CompatibleKeyType>
+  Iterator Find(const CompatibleKeyType& key); // [tested]
+
+  /// \brief Returns an Iterator to the element with a key equal or larger than the given key. Returns an invalid iterator, if there is no
+  /// such element.
+  template <typename CompatibleKeyType>
+  Iterator LowerBound(const CompatibleKeyType& key); // [tested]
+
+  /// \brief Returns an Iterator to the element with a key that is LARGER than the given key. Returns an invalid iterator, if there is no
+  /// such element.
+  template <typename CompatibleKeyType>
+  Iterator UpperBound(const CompatibleKeyType& key); // [tested]
+
+  /// \brief Searches for key, returns an Iterator to it or an invalid iterator, if no such key is found. O(log n) operation.
+  template <typename CompatibleKeyType>
+  ConstIterator Find(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Checks whether the given key is in the container.
+  template <typename CompatibleKeyType>
+  bool Contains(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Returns an Iterator to the element with a key equal or larger than the given key. Returns an invalid iterator, if there is no
+  /// such element.
+  template <typename CompatibleKeyType>
+  ConstIterator LowerBound(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Returns an Iterator to the element with a key that is LARGER than the given key. Returns an invalid iterator, if there is no
+  /// such element.
+  template <typename CompatibleKeyType>
+  ConstIterator UpperBound(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Returns the allocator that is used by this instance.
+  ezAllocatorBase* GetAllocator() const { return m_pAllocator; }
+
+  /// \brief Comparison operator
+  bool operator==(const ezBTreeMapBase<KeyType, ValueType, Comparer>& rhs) const; // [tested]
+
+  /// \brief Comparison operator
+  bool operator!=(const ezBTreeMapBase<KeyType, ValueType, Comparer>& rhs) const; // [tested]
+
+  /// \brief Returns the amount of bytes that are currently allocated on the heap.
+  ezUInt64 GetHeapMemoryUsage() const; // [tested]
+
+  /// \brief Swaps this map with the other one.
+  void Swap(ezBTreeMapBase<KeyType, ValueType, Comparer>& other); // [tested]
+
+private:
+  template <typename CompatibleKeyType>
+  Leaf* Internal_FindLeaf(const CompatibleKeyType& key, Path* pPath) const;
+  template <typename CompatibleKeyType>
+  ConstIterator Internal_Find(const CompatibleKeyType& key) const;
+  template <typename CompatibleKeyType>
+  ConstIterator Internal_LowerBound(const CompatibleKeyType& key) const;
+  template <typename CompatibleKeyType>
+  ConstIterator Internal_UpperBound(const CompatibleKeyType& key) const;
+
+  /// \brief Turns a past-the-end position inside a leaf into a position in the next leaf (or into an invalid iterator).
+  static ConstIterator MakeIterator(Leaf* pLeaf, ezUInt32 uiIndex);
+
+  static Iterator ToIterator(const ConstIterator& it) { return Iterator(it.m_pLeaf, it.m_uiIndex); }
+
+  /// \brief ezBTreeSetBase is implemented on top of this class.
+  template <typename, typename>
+  friend class ezBTreeSetBase;
+
+private:
+  Leaf* AcquireLeaf();
+  Inner* AcquireInner();
+  void ReleaseNode(Node* pNode);
+
+  /// \brief Destroys all elements in the sub-tree and releases its nodes.
+  void ReleaseSubTree(Node* pNode);
+
+  /// \brief Splits the full leaf and inserts the new element. Returns the position of the new element.
+  template <typename CompatibleKeyType>
+  Iterator SplitLeafAndInsert(Path& path, Leaf* pLeaf, ezUInt32 uiIndex, CompatibleKeyType&& key);
+
+  /// \brief Inserts the separator key and the new right child into the parent nodes on the path, splitting them as needed.
+  void InsertIntoParent(Path& path, Node* pLeft, KeyType&& separator, Node* pRight);
+
+  /// \brief Removes the element from the leaf, rebalances the tree and returns an iterator to the element that followed it.
+  Iterator RemoveFromLeaf(Path& path, Leaf* pLeaf, ezUInt32 uiIndex);
+
+  /// \brief Removes key i and child i + 1 from an inner node that has underflown and rebalances the inner nodes up the path.
+  void RemoveFromInner(Path& path, ezUInt32 uiDepth, ezUInt32 uiKeyIndex);
+
+  /// \brief Root node of the tree. nullptr when the map is empty.
+  Node* m_pRoot = nullptr;
+
+  /// \brief Leaves are linked, this is where iteration starts.
+  Leaf* m_pFirstLeaf = nullptr;
+  Leaf* m_pLastLeaf = nullptr;
+
+  /// \brief Number of elements in the tree.
+  ezUInt32 m_uiCount = 0;
+
+  ezUInt32 m_uiNumLeaves = 0;
+  ezUInt32 m_uiNumInnerNodes = 0;
+
+  ezAllocatorBase* m_pAllocator = nullptr;
+
+  /// \brief Comparer object
+  Comparer m_Comparer;
+};
+
+
+/// \brief \see ezBTreeMapBase
+template <typename KeyType, typename ValueType, typename Comparer = ezCompareHelper<KeyType>, typename AllocatorWrapper = ezDefaultAllocatorWrapper>
+class ezBTreeMap : public ezBTreeMapBase<KeyType, ValueType, Comparer>
+{
+public:
+  ezBTreeMap();
+  ezBTreeMap(ezAllocatorBase* pAllocator);
+  ezBTreeMap(const Comparer& comparer, ezAllocatorBase* pAllocator);
+
+  ezBTreeMap(const ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>& other);
+  ezBTreeMap(const ezBTreeMapBase<KeyType, ValueType, Comparer>& other);
+
+  void operator=(const ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>& rhs);
+  void operator=(const ezBTreeMapBase<KeyType, ValueType, Comparer>& rhs);
+};
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator begin(ezBTreeMapBase<KeyType, ValueType, Comparer>& container)
+{
+  return container.GetIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator begin(const ezBTreeMapBase<KeyType, ValueType, Comparer>& container)
+{
+  return container.GetIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator cbegin(const ezBTreeMapBase<KeyType, ValueType, Comparer>& container)
+{
+  return container.GetIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator end(ezBTreeMapBase<KeyType, ValueType, Comparer>& container)
+{
+  return typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator end(const ezBTreeMapBase<KeyType, ValueType, Comparer>& container)
+{
+  return typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator cend(const ezBTreeMapBase<KeyType, ValueType, Comparer>& container)
+{
+  return typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator();
+}
+
+#include <Foundation/Containers/Implementation/BTreeMap_inl.h>
@@ -0,0 +1,955 @@
+#pragma once
+
+// ***** Node Search *****
+
+template <typename KeyType, typename Comparer>
+template <typename CompatibleKeyType>
+ezUInt32 ezInternal::ezBTreeNodeSearch<KeyType, Comparer>::CountLess(
+  const KeyType* pKeys, ezUInt32 uiCount, const CompatibleKeyType& key, const Comparer& comparer)
+{
+  if (uiCount == 0)
+    return 0;
+
+  const KeyType* pBase = pKeys;
+
+  while (uiCount > 1)
+  {
+    const ezUInt32 uiHalf = uiCount / 2;
+    pBase = comparer.Less(pBase[uiHalf], key) ? pBase + uiHalf : pBase;
+    uiCount -= uiHalf;
+  }
+
+  return static_cast<ezUInt32>(pBase - pKeys) + (comparer.Less(*pBase, key) ? 1 : 0);
+}
+
+template <typename KeyType, typename Comparer>
+template <typename CompatibleKeyType>
+ezUInt32 ezInternal::ezBTreeNodeSearch<KeyType, Comparer>::CountLessEqual(
+  const KeyType* pKeys, ezUInt32 uiCount, const CompatibleKeyType& key, const Comparer& comparer)
+{
+  if (uiCount == 0)
+    return 0;
+
+  const KeyType* pBase = pKeys;
+
+  while (uiCount > 1)
+  {
+    const ezUInt32 uiHalf = uiCount / 2;
+    pBase = comparer.Less(key, pBase[uiHalf]) ? pBase : pBase + uiHalf;
+    uiCount -= uiHalf;
+  }
+
+  return static_cast<ezUInt32>(pBase - pKeys) + (comparer.Less(key, *pBase) ? 0 : 1);
+}
+
+#if EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE
+
+template <typename KeyType, ezUInt32 Bias>
+ezUInt32 ezInternal::ezBTreeNodeSearchInt32<KeyType, Bias>::CountLess(
+  const KeyType* pKeys, ezUInt32 uiCount, KeyType key, const ezCompareHelper<KeyType>& /*comparer*/)
+{
+  const __m128i bias = _mm_set1_epi32(static_cast<int>(Bias));
+  const __m128i searchKey = _mm_xor_si128(_mm_set1_epi32(static_cast<int>(key)), bias);
+
+  // the keys are sorted, so the first block that is not entirely less than the search key contains the result
+  ezUInt32 i = 0;
+  for (; i + 4 <= uiCount; i += 4)
+  {
+    const __m128i keys = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pKeys + i)), bias);
+    const ezUInt32 uiMask = static_cast<ezUInt32>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(searchKey, keys))));
+
+    if (uiMask != 0xF)
+      return i + ezMath::CountBits(uiMask);
+  }
+
+  while (i < uiCount && pKeys[i] < key)
+    ++i;
+
+  return i;
+}
+
+template <typename KeyType, ezUInt32 Bias>
+ezUInt32 ezInternal::ezBTreeNodeSearchInt32<KeyType, Bias>::CountLessEqual(
+  const KeyType* pKeys, ezUInt32 uiCount, KeyType key, const ezCompareHelper<KeyType>& /*comparer*/)
+{
+  const __m128i bias = _mm_set1_epi32(static_cast<int>(Bias));
+  const __m128i searchKey = _mm_xor_si128(_mm_set1_epi32(static_cast<int>(key)), bias);
+
+  ezUInt32 i = 0;
+  for (; i + 4 <= uiCount; i += 4)
+  {
+    const __m128i keys = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pKeys + i)), bias);
+    const ezUInt32 uiMask = static_cast<ezUInt32>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(keys, searchKey))));
+
+    if (uiMask != 0)
+      return i + 4 - ezMath::CountBits(uiMask);
+  }
+
+  while (i < uiCount && !(key < pKeys[i]))
+    ++i;
+
+  return i;
+}
+
+#endif
+
+template <typename T>
+void ezInternal::ezBTreeRelocate(T* pDestination, T* pSource, ezUInt32 uiCount)
+{
+  if (pDestination == pSource || uiCount == 0)
+    return;
+
+  if constexpr (ezGetTypeClass<T>::value != ezTypeIsClass::value)
+  {
+    memmove(pDestination, pSource, uiCount * sizeof(T));
+  }
+  else if (pDestination < pSource)
+  {
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      ezMemoryUtils::RelocateConstruct(pDestination + i, pSource + i, 1);
+    }
+  }
+  else
+  {
+    for (ezUInt32 i = uiCount; i > 0; --i)
+    {
+      ezMemoryUtils::RelocateConstruct(pDestination + i - 1, pSource + i - 1, 1);
+    }
+  }
+}
+
+// ***** Const Iterator *****
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator::Next()
+{
+  EZ_ASSERT_DEV(m_pLeaf != nullptr, "The Iterator is invalid (end).");
+
+  if (++m_uiIndex >= m_pLeaf->m_uiCount)
+  {
+    m_pLeaf = m_pLeaf->m_pNext;
+    m_uiIndex = 0;
+  }
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator::Prev()
+{
+  EZ_ASSERT_DEV(m_pLeaf != nullptr, "The Iterator is invalid (end).");
+
+  if (m_uiIndex > 0)
+  {
+    --m_uiIndex;
+    return;
+  }
+
+  m_pLeaf = m_pLeaf->m_pPrev;
+  m_uiIndex = m_pLeaf != nullptr ? m_pLeaf->m_uiCount - 1u : 0u;
+}
+
+// ***** ezBTreeMapBase *****
+
+template <typename KeyType, typename ValueType, typename Comparer>
+ezBTreeMapBase<KeyType, ValueType, Comparer>::ezBTreeMapBase(const Comparer& comparer, ezAllocatorBase* pAllocator)
+  : m_pAllocator(pAllocator)
+  , m_Comparer(comparer)
+{
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+ezBTreeMapBase<KeyType, ValueType, Comparer>::ezBTreeMapBase(const ezBTreeMapBase<KeyType, ValueType, Comparer>& cc, ezAllocatorBase* pAllocator)
+  : m_pAllocator(pAllocator)
+  , m_Comparer(cc.m_Comparer)
+{
+  operator=(cc);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+ezBTreeMapBase<KeyType, ValueType, Comparer>::~ezBTreeMapBase()
+{
+  Clear();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::operator=(const ezBTreeMapBase<KeyType, ValueType, Comparer>& rhs)
+{
+  if (this == &rhs)
+    return;
+
+  Clear();
+
+  // the elements arrive in sorted order, so every insertion appends to the last leaf, which then gets split without leaving gaps
+  for (ConstIterator it = rhs.GetIterator(); it.IsValid(); ++it)
+  {
+    Insert(it.Key(), it.Value());
+  }
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+EZ_ALWAYS_INLINE bool ezBTreeMapBase<KeyType, ValueType, Comparer>::IsEmpty() const
+{
+  return m_uiCount == 0;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+EZ_ALWAYS_INLINE ezUInt32 ezBTreeMapBase<KeyType, ValueType, Comparer>::GetCount() const
+{
+  return m_uiCount;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::Clear()
+{
+  if (m_pRoot != nullptr)
+  {
+    ReleaseSubTree(m_pRoot);
+  }
+
+  m_pRoot = nullptr;
+  m_pFirstLeaf = nullptr;
+  m_pLastLeaf = nullptr;
+  m_uiCount = 0;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+EZ_ALWAYS_INLINE typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator ezBTreeMapBase<KeyType, ValueType, Comparer>::GetIterator()
+{
+  return Iterator(m_pFirstLeaf, 0);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+EZ_ALWAYS_INLINE typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator ezBTreeMapBase<KeyType, ValueType, Comparer>::GetIterator() const
+{
+  return ConstIterator(m_pFirstLeaf, 0);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+EZ_ALWAYS_INLINE typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator ezBTreeMapBase<KeyType, ValueType, Comparer>::GetLastIterator()
+{
+  return Iterator(m_pLastLeaf, m_pLastLeaf != nullptr ? m_pLastLeaf->m_uiCount - 1u : 0u);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+EZ_ALWAYS_INLINE typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator ezBTreeMapBase<KeyType, ValueType, Comparer>::GetLastIterator() const
+{
+  return ConstIterator(m_pLastLeaf, m_pLastLeaf != nullptr ? m_pLastLeaf->m_uiCount - 1u : 0u);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Leaf* ezBTreeMapBase<KeyType, ValueType, Comparer>::Internal_FindLeaf(
+  const CompatibleKeyType& key, Path* pPath) const
+{
+  Node* pNode = m_pRoot;
+
+  while (!pNode->m_bIsLeaf)
+  {
+    Inner* pInner = static_cast<Inner*>(pNode);
+    const ezUInt32 uiChild = Search::CountLessEqual(pInner->GetKeys(), pInner->m_uiCount, key, m_Comparer);
+
+    if (pPath != nullptr)
+    {
+      EZ_ASSERT_DEBUG(pPath->m_uiDepth < MaxDepth, "B-tree is deeper than supported");
+      pPath->m_pNodes[pPath->m_uiDepth] = pInner;
+      pPath->m_uiChildIndex[pPath->m_uiDepth] = uiChild;
+      ++pPath->m_uiDepth;
+    }
+
+    pNode = pInner->m_pChildren[uiChild];
+  }
+
+  return static_cast<Leaf*>(pNode);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+EZ_ALWAYS_INLINE typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator ezBTreeMapBase<KeyType, ValueType, Comparer>::MakeIterator(
+  Leaf* pLeaf, ezUInt32 uiIndex)
+{
+  if (uiIndex < pLeaf->m_uiCount)
+    return ConstIterator(pLeaf, uiIndex);
+
+  // non-root leaves are never empty, so the first element of the next leaf is the next element
+  return ConstIterator(pLeaf->m_pNext, 0);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator ezBTreeMapBase<KeyType, ValueType, Comparer>::Internal_Find(
+  const CompatibleKeyType& key) const
+{
+  if (m_pRoot == nullptr)
+    return ConstIterator();
+
+  Leaf* pLeaf = Internal_FindLeaf(key, nullptr);
+  const ezUInt32 uiIndex = Search::CountLess(pLeaf->GetKeys(), pLeaf->m_uiCount, key, m_Comparer);
+
+  if (uiIndex < pLeaf->m_uiCount && m_Comparer.Equal(pLeaf->GetKeys()[uiIndex], key))
+    return ConstIterator(pLeaf, uiIndex);
+
+  return ConstIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator ezBTreeMapBase<KeyType, ValueType, Comparer>::Internal_LowerBound(
+  const CompatibleKeyType& key) const
+{
+  if (m_pRoot == nullptr)
+    return ConstIterator();
+
+  Leaf* pLeaf = Internal_FindLeaf(key, nullptr);
+  return MakeIterator(pLeaf, Search::CountLess(pLeaf->GetKeys(), pLeaf->m_uiCount, key, m_Comparer));
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator ezBTreeMapBase<KeyType, ValueType, Comparer>::Internal_UpperBound(
+  const CompatibleKeyType& key) const
+{
+  if (m_pRoot == nullptr)
+    return ConstIterator();
+
+  Leaf* pLeaf = Internal_FindLeaf(key, nullptr);
+  return MakeIterator(pLeaf, Search::CountLessEqual(pLeaf->GetKeys(), pLeaf->m_uiCount, key, m_Comparer));
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator ezBTreeMapBase<KeyType, ValueType, Comparer>::Find(
+  const CompatibleKeyType& key)
+{
+  return ToIterator(Internal_Find(key));
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator ezBTreeMapBase<KeyType, ValueType, Comparer>::Find(
+  const CompatibleKeyType& key) const
+{
+  return Internal_Find(key);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE bool ezBTreeMapBase<KeyType, ValueType, Comparer>::Contains(const CompatibleKeyType& key) const
+{
+  return Internal_Find(key).IsValid();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator ezBTreeMapBase<KeyType, ValueType, Comparer>::LowerBound(
+  const CompatibleKeyType& key)
+{
+  return ToIterator(Internal_LowerBound(key));
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator ezBTreeMapBase<KeyType, ValueType, Comparer>::LowerBound(
+  const CompatibleKeyType& key) const
+{
+  return Internal_LowerBound(key);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator ezBTreeMapBase<KeyType, ValueType, Comparer>::UpperBound(
+  const CompatibleKeyType& key)
+{
+  return ToIterator(Internal_UpperBound(key));
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator ezBTreeMapBase<KeyType, ValueType, Comparer>::UpperBound(
+  const CompatibleKeyType& key) const
+{
+  return Internal_UpperBound(key);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+ValueType& ezBTreeMapBase<KeyType, ValueType, Comparer>::operator[](const CompatibleKeyType& key)
+{
+  return FindOrAdd(key).Value();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_FORCE_INLINE const ValueType* ezBTreeMapBase<KeyType, ValueType, Comparer>::GetValue(const CompatibleKeyType& key) const
+{
+  const ConstIterator it = Internal_Find(key);
+  return it.IsValid() ? &it.Value() : nullptr;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_FORCE_INLINE ValueType* ezBTreeMapBase<KeyType, ValueType, Comparer>::GetValue(const CompatibleKeyType& key)
+{
+  Iterator it = Find(key);
+  return it.IsValid() ? &it.Value() : nullptr;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_FORCE_INLINE const ValueType& ezBTreeMapBase<KeyType, ValueType, Comparer>::GetValueOrDefault(
+  const CompatibleKeyType& key, const ValueType& defaultValue) const
+{
+  const ConstIterator it = Internal_Find(key);
+  return it.IsValid() ? it.Value() : defaultValue;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator ezBTreeMapBase<KeyType, ValueType, Comparer>::FindOrAdd(
+  CompatibleKeyType&& key, bool* bExisted)
+{
+  if (m_pRoot == nullptr)
+  {
+    Leaf* pLeaf = AcquireLeaf();
+    m_pRoot = pLeaf;
+    m_pFirstLeaf = pLeaf;
+    m_pLastLeaf = pLeaf;
+  }
+
+  Path path;
+  Leaf* pLeaf = Internal_FindLeaf(key, &path);
+  KeyType* pKeys = pLeaf->GetKeys();
+  const ezUInt32 uiCount = pLeaf->m_uiCount;
+  const ezUInt32 uiIndex = Search::CountLess(pKeys, uiCount, key, m_Comparer);
+
+  if (uiIndex < uiCount && m_Comparer.Equal(pKeys[uiIndex], key))
+  {
+    if (bExisted)
+      *bExisted = true;
+
+    return Iterator(pLeaf, uiIndex);
+  }
+
+  if (bExisted)
+    *bExisted = false;
+
+  ++m_uiCount;
+
+  if (uiCount == NodeCapacity)
+    return SplitLeafAndInsert(path, pLeaf, uiIndex, std::forward<CompatibleKeyType>(key));
+
+  ezInternal::ezBTreeRelocate(pKeys + uiIndex + 1, pKeys + uiIndex, uiCount - uiIndex);
+  ezInternal::ezBTreeRelocate(pLeaf->GetValues() + uiIndex + 1, pLeaf->GetValues() + uiIndex, uiCount - uiIndex);
+  ezMemoryUtils::CopyOrMoveConstruct<KeyType>(pKeys + uiIndex, std::forward<CompatibleKeyType>(key));
+  ezMemoryUtils::DefaultConstruct(pLeaf->GetValues() + uiIndex, 1);
+  ++pLeaf->m_uiCount;
+
+  return Iterator(pLeaf, uiIndex);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType, typename CompatibleValueType>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator ezBTreeMapBase<KeyType, ValueType, Comparer>::Insert(
+  CompatibleKeyType&& key, CompatibleValueType&& value)
+{
+  auto it = FindOrAdd(std::forward<CompatibleKeyType>(key));
+  it.Value() = std::forward<CompatibleValueType>(value);
+
+  return it;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator ezBTreeMapBase<KeyType, ValueType, Comparer>::SplitLeafAndInsert(
+  Path& path, Leaf* pLeaf, ezUInt32 uiIndex, CompatibleKeyType&& key)
+{
+  Leaf* pNewLeaf = AcquireLeaf();
+
+  // when appending to the very last leaf (e.g. when filling the map in sorted order), keep the old leaf full instead of splitting it in half
+  const ezUInt32 uiSplit = (uiIndex == NodeCapacity && pLeaf->m_pNext == nullptr) ? NodeCapacity : NodeCapacity / 2;
+
+  ezInternal::ezBTreeRelocate(pNewLeaf->GetKeys(), pLeaf->GetKeys() + uiSplit, NodeCapacity - uiSplit);
+  ezInternal::ezBTreeRelocate(pNewLeaf->GetValues(), pLeaf->GetValues() + uiSplit, NodeCapacity - uiSplit);
+  pNewLeaf->m_uiCount = static_cast<ezUInt16>(NodeCapacity - uiSplit);
+  pLeaf->m_uiCount = static_cast<ezUInt16>(uiSplit);
+
+  pNewLeaf->m_pPrev = pLeaf;
+  pNewLeaf->m_pNext = pLeaf->m_pNext;
+
+  if (pLeaf->m_pNext != nullptr)
+    pLeaf->m_pNext->m_pPrev = pNewLeaf;
+  else
+    m_pLastLeaf = pNewLeaf;
+
+  pLeaf->m_pNext = pNewLeaf;
+
+  Leaf* pTarget = pLeaf;
+  if (uiIndex >= uiSplit)
+  {
+    pTarget = pNewLeaf;
+    uiIndex -= uiSplit;
+  }
+
+  KeyType* pKeys = pTarget->GetKeys();
+  ValueType* pValues = pTarget->GetValues();
+  const ezUInt32 uiCount = pTarget->m_uiCount;
+
+  ezInternal::ezBTreeRelocate(pKeys + uiIndex + 1, pKeys + uiIndex, uiCount - uiIndex);
+  ezInternal::ezBTreeRelocate(pValues + uiIndex + 1, pValues + uiIndex, uiCount - uiIndex);
+  ezMemoryUtils::CopyOrMoveConstruct<KeyType>(pKeys + uiIndex, std::forward<CompatibleKeyType>(key));
+  ezMemoryUtils::DefaultConstruct(pValues + uiIndex, 1);
+  ++pTarget->m_uiCount;
+
+  InsertIntoParent(path, pLeaf, KeyType(pNewLeaf->GetKeys()[0]), pNewLeaf);
+
+  return Iterator(pTarget, uiIndex);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::InsertIntoParent(Path& path, Node* pLeft, KeyType&& separator, Node* pRight)
+{
+  KeyType key(std::move(separator));
+
+  auto InsertIntoInner = [](Inner* pNode, ezUInt32 uiKeyIndex, KeyType&& key, Node* pChild) {
+    KeyType* pKeys = pNode->GetKeys();
+    const ezUInt32 uiCount = pNode->m_uiCount;
+
+    ezInternal::ezBTreeRelocate(pKeys + uiKeyIndex + 1, pKeys + uiKeyIndex, uiCount - uiKeyIndex);
+    ezMemoryUtils::MoveConstruct<KeyType>(pKeys + uiKeyIndex, std::move(key));
+
+    for (ezUInt32 i = uiCount + 1; i > uiKeyIndex + 1; --i)
+    {
+      pNode->m_pChildren[i] = pNode->m_pChildren[i - 1];
+    }
+
+    pNode->m_pChildren[uiKeyIndex + 1] = pChild;
+    ++pNode->m_uiCount;
+  };
+
+  while (path.m_uiDepth > 0)
+  {
+    --path.m_uiDepth;
+    Inner* pParent = path.m_pNodes[path.m_uiDepth];
+    const ezUInt32 uiKeyIndex = path.m_uiChildIndex[path.m_uiDepth];
+
+    if (pParent->m_uiCount < NodeCapacity)
+    {
+      InsertIntoInner(pParent, uiKeyIndex, std::move(key), pRight);
+      return;
+    }
+
+    // split the full inner node, the middle key moves up one level
+    constexpr ezUInt32 uiMid = NodeCapacity / 2;
+    Inner* pNewInner = AcquireInner();
+    KeyType* pKeys = pParent->GetKeys();
+
+    KeyType promotedKey(std::move(pKeys[uiMid]));
+    ezMemoryUtils::Destruct(pKeys + uiMid, 1);
+
+    ezInternal::ezBTreeRelocate(pNewInner->GetKeys(), pKeys + uiMid + 1, NodeCapacity - uiMid - 1);
+    for (ezUInt32 i = uiMid + 1; i <= NodeCapacity; ++i)
+    {
+      pNewInner->m_pChildren[i - uiMid - 1] = pParent->m_pChildren[i];
+    }
+
+    pNewInner->m_uiCount = static_cast<ezUInt16>(NodeCapacity - uiMid - 1);
+    pParent->m_uiCount = static_cast<ezUInt16>(uiMid);
+
+    if (uiKeyIndex <= uiMid)
+      InsertIntoInner(pParent, uiKeyIndex, std::move(key), pRight);
+    else
+      InsertIntoInner(pNewInner, uiKeyIndex - uiMid - 1, std::move(key), pRight);
+
+    pLeft = pParent;
+    pRight = pNewInner;
+    key = std::move(promotedKey);
+  }
+
+  // the root was split, the tree grows by one level
+  Inner* pNewRoot = AcquireInner();
+  ezMemoryUtils::MoveConstruct<KeyType>(pNewRoot->GetKeys(), std::move(key));
+  pNewRoot->m_pChildren[0] = pLeft;
+  pNewRoot->m_pChildren[1] = pRight;
+  pNewRoot->m_uiCount = 1;
+  m_pRoot = pNewRoot;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+bool ezBTreeMapBase<KeyType, ValueType, Comparer>::Remove(const CompatibleKeyType& key)
+{
+  if (m_pRoot == nullptr)
+    return false;
+
+  Path path;
+  Leaf* pLeaf = Internal_FindLeaf(key, &path);
+  const ezUInt32 uiIndex = Search::CountLess(pLeaf->GetKeys(), pLeaf->m_uiCount, key, m_Comparer);
+
+  if (uiIndex >= pLeaf->m_uiCount || !m_Comparer.Equal(pLeaf->GetKeys()[uiIndex], key))
+    return false;
+
+  RemoveFromLeaf(path, pLeaf, uiIndex);
+  return true;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator ezBTreeMapBase<KeyType, ValueType, Comparer>::Remove(const Iterator& pos)
+{
+  EZ_ASSERT_DEV(pos.IsValid(), "The Iterator(pos) is invalid.");
+
+  Path path;
+  Leaf* pLeaf = Internal_FindLeaf(pos.Key(), &path);
+  EZ_ASSERT_DEV(pLeaf == pos.m_pLeaf, "The Iterator(pos) does not belong to this container.");
+
+  return RemoveFromLeaf(path, pLeaf, pos.m_uiIndex);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator ezBTreeMapBase<KeyType, ValueType, Comparer>::RemoveFromLeaf(
+  Path& path, Leaf* pLeaf, ezUInt32 uiIndex)
+{
+  KeyType* pKeys = pLeaf->GetKeys();
+  ValueType* pValues = pLeaf->GetValues();
+  ezUInt32 uiCount = pLeaf->m_uiCount;
+
+  ezMemoryUtils::Destruct(pKeys + uiIndex, 1);
+  ezMemoryUtils::Destruct(pValues + uiIndex, 1);
+  ezInternal::ezBTreeRelocate(pKeys + uiIndex, pKeys + uiIndex + 1, uiCount - uiIndex - 1);
+  ezInternal::ezBTreeRelocate(pValues + uiIndex, pValues + uiIndex + 1, uiCount - uiIndex - 1);
+  pLeaf->m_uiCount = static_cast<ezUInt16>(--uiCount);
+  --m_uiCount;
+
+  if (path.m_uiDepth == 0)
+  {
+    // the leaf is the root, it may become empty
+    if (uiCount == 0)
+    {
+      ReleaseNode(pLeaf);
+      m_pRoot = nullptr;
+      m_pFirstLeaf = nullptr;
+      m_pLastLeaf = nullptr;
+      return Iterator();
+    }
+
+    return ToIterator(MakeIterator(pLeaf, uiIndex));
+  }
+
+  Leaf* pNextLeaf = pLeaf;
+  ezUInt32 uiNextIndex = uiIndex;
+
+  if (uiCount < MinNodeCount)
+  {
+    Inner* pParent = path.m_pNodes[path.m_uiDepth - 1];
+    const ezUInt32 uiChild = path.m_uiChildIndex[path.m_uiDepth - 1];
+    KeyType* pParentKeys = pParent->GetKeys();
+
+    Leaf* pLeft = uiChild > 0 ? static_cast<Leaf*>(pParent->m_pChildren[uiChild - 1]) : nullptr;
+    Leaf* pRight = uiChild < pParent->m_uiCount ? static_cast<Leaf*>(pParent->m_pChildren[uiChild + 1]) : nullptr;
+
+    if (pLeft != nullptr && pLeft->m_uiCount > MinNodeCount)
+    {
+      // take the last element of the left sibling
+      const ezUInt32 uiLast = pLeft->m_uiCount - 1u;
+
+      ezInternal::ezBTreeRelocate(pKeys + 1, pKeys, uiCount);
+      ezInternal::ezBTreeRelocate(pValues + 1, pValues, uiCount);
+      ezInternal::ezBTreeRelocate(pKeys, pLeft->GetKeys() + uiLast, 1);
+      ezInternal::ezBTreeRelocate(pValues, pLeft->GetValues() + uiLast, 1);
+      pLeft->m_uiCount = static_cast<ezUInt16>(uiLast);
+      pLeaf->m_uiCount = static_cast<ezUInt16>(uiCount + 1);
+
+      pParentKeys[uiChild - 1] = pKeys[0];
+      uiNextIndex = uiIndex + 1;
+    }
+    else if (pRight != nullptr && pRight->m_uiCount > MinNodeCount)
+    {
+      // take the first element of the right sibling
+      const ezUInt32 uiRightCount = pRight->m_uiCount - 1u;
+
+      ezInternal::ezBTreeRelocate(pKeys + uiCount, pRight->GetKeys(), 1);
+      ezInternal::ezBTreeRelocate(pValues + uiCount, pRight->GetValues(), 1);
+      ezInternal::ezBTreeRelocate(pRight->GetKeys(), pRight->GetKeys() + 1, uiRightCount);
+      ezInternal::ezBTreeRelocate(pRight->GetValues(), pRight->GetValues() + 1, uiRightCount);
+      pRight->m_uiCount = static_cast<ezUInt16>(uiRightCount);
+      pLeaf->m_uiCount = static_cast<ezUInt16>(uiCount + 1);
+
+      pParentKeys[uiChild] = pRight->GetKeys()[0];
+    }
+    else
+    {
+      // merge with a sibling, the parent loses one key and one child
+      Leaf* pDst = pLeft != nullptr ? pLeft : pLeaf;
+      Leaf* pSrc = pLeft != nullptr ? pLeaf : pRight;
+      const ezUInt32 uiDstCount = pDst->m_uiCount;
+
+      ezInternal::ezBTreeRelocate(pDst->GetKeys() + uiDstCount, pSrc->GetKeys(), pSrc->m_uiCount);
+      ezInternal::ezBTreeRelocate(pDst->GetValues() + uiDstCount, pSrc->GetValues(), pSrc->m_uiCount);
+      pDst->m_uiCount = static_cast<ezUInt16>(uiDstCount + pSrc->m_uiCount);
+      pSrc->m_uiCount = 0;
+
+      pDst->m_pNext = pSrc->m_pNext;
+      if (pSrc->m_pNext != nullptr)
+        pSrc->m_pNext->m_pPrev = pDst;
+      else
+        m_pLastLeaf = pDst;
+
+      ReleaseNode(pSrc);
+
+      if (pLeft != nullptr)
+      {
+        pNextLeaf = pLeft;
+        uiNextIndex = uiDstCount + uiIndex;
+      }
+
+      RemoveFromInner(path, path.m_uiDepth - 1, pLeft != nullptr ? uiChild - 1 : uiChild);
+    }
+  }
+
+  return ToIterator(MakeIterator(pNextLeaf, uiNextIndex));
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::RemoveFromInner(Path& path, ezUInt32 uiDepth, ezUInt32 uiKeyIndex)
+{
+  Inner* pNode = path.m_pNodes[uiDepth];
+  KeyType* pKeys = pNode->GetKeys();
+  ezUInt32 uiCount = pNode->m_uiCount;
+
+  ezMemoryUtils::Destruct(pKeys + uiKeyIndex, 1);
+  ezInternal::ezBTreeRelocate(pKeys + uiKeyIndex, pKeys + uiKeyIndex + 1, uiCount - uiKeyIndex - 1);
+
+  for (ezUInt32 i = uiKeyIndex + 1; i < uiCount; ++i)
+  {
+    pNode->m_pChildren[i] = pNode->m_pChildren[i + 1];
+  }
+
+  pNode->m_uiCount = static_cast<ezUInt16>(--uiCount);
+
+  if (uiDepth == 0)
+  {
+    // the root only has a single child left, the tree shrinks by one level
+    if (uiCount == 0)
+    {
+      m_pRoot = pNode->m_pChildren[0];
+      ReleaseNode(pNode);
+    }
+
+    return;
+  }
+
+  if (uiCount >= MinNodeCount)
+    return;
+
+  Inner* pParent = path.m_pNodes[uiDepth - 1];
+  const ezUInt32 uiChild = path.m_uiChildIndex[uiDepth - 1];
+  KeyType* pParentKeys = pParent->GetKeys();
+
+  Inner* pLeft = uiChild > 0 ? static_cast<Inner*>(pParent->m_pChildren[uiChild - 1]) : nullptr;
+  Inner* pRight = uiChild < pParent->m_uiCount ? static_cast<Inner*>(pParent->m_pChildren[uiChild + 1]) : nullptr;
+
+  if (pLeft != nullptr && pLeft->m_uiCount > MinNodeCount)
+  {
+    // rotate right: the separator moves down into this node, the last key of the left sibling moves up
+    const ezUInt32 uiLast = pLeft->m_uiCount - 1u;
+
+    ezInternal::ezBTreeRelocate(pKeys + 1, pKeys, uiCount);
+    for (ezUInt32 i = uiCount + 1; i > 0; --i)
+    {
+      pNode->m_pChildren[i] = pNode->m_pChildren[i - 1];
+    }
+
+    ezInternal::ezBTreeRelocate(pKeys, pParentKeys + uiChild - 1, 1);
+    ezInternal::ezBTreeRelocate(pParentKeys + uiChild - 1, pLeft->GetKeys() + uiLast, 1);
+    pNode->m_pChildren[0] = pLeft->m_pChildren[uiLast + 1];
+
+    pLeft->m_uiCount = static_cast<ezUInt16>(uiLast);
+    pNode->m_uiCount = static_cast<ezUInt16>(uiCount + 1);
+  }
+  else if (pRight != nullptr && pRight->m_uiCount > MinNodeCount)
+  {
+    // rotate left: the separator moves down into this node, the first key of the right sibling moves up
+    const ezUInt32 uiRightCount = pRight->m_uiCount - 1u;
+
+    ezInternal::ezBTreeRelocate(pKeys + uiCount, pParentKeys + uiChild, 1);
+    pNode->m_pChildren[uiCount + 1] = pRight->m_pChildren[0];
+    ezInternal::ezBTreeRelocate(pParentKeys + uiChild, pRight->GetKeys(), 1);
+
+    ezInternal::ezBTreeRelocate(pRight->GetKeys(), pRight->GetKeys() + 1, uiRightCount);
+    for (ezUInt32 i = 0; i <= uiRightCount; ++i)
+    {
+      pRight->m_pChildren[i] = pRight->m_pChildren[i + 1];
+    }
+
+    pRight->m_uiCount = static_cast<ezUInt16>(uiRightCount);
+    pNode->m_uiCount = static_cast<ezUInt16>(uiCount + 1);
+  }
+  else
+  {
+    // merge with a sibling, the separator moves down into the merged node
+    Inner* pDst = pLeft != nullptr ? pLeft : pNode;
+    Inner* pSrc = pLeft != nullptr ? pNode : pRight;
+    const ezUInt32 uiSeparator = pLeft != nullptr ? uiChild - 1 : uiChild;
+    const ezUInt32 uiDstCount = pDst->m_uiCount;
+    const ezUInt32 uiSrcCount = pSrc->m_uiCount;
+
+    ezMemoryUtils::CopyConstruct(pDst->GetKeys() + uiDstCount, pParentKeys[uiSeparator], 1);
+    ezInternal::ezBTreeRelocate(pDst->GetKeys() + uiDstCount + 1, pSrc->GetKeys(), uiSrcCount);
+
+    for (ezUInt32 i = 0; i <= uiSrcCount; ++i)
+    {
+      pDst->m_pChildren[uiDstCount + 1 + i] = pSrc->m_pChildren[i];
+    }
+
+    pDst->m_uiCount = static_cast<ezUInt16>(uiDstCount + 1 + uiSrcCount);
+    pSrc->m_uiCount = 0;
+    ReleaseNode(pSrc);
+
+    RemoveFromInner(path, uiDepth - 1, uiSeparator);
+  }
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+bool ezBTreeMapBase<KeyType, ValueType, Comparer>::operator==(const ezBTreeMapBase<KeyType, ValueType, Comparer>& rhs) const
+{
+  if (GetCount() != rhs.GetCount())
+    return false;
+
+  ConstIterator itLhs = GetIterator();
+  ConstIterator itRhs = rhs.GetIterator();
+
+  while (itLhs.IsValid())
+  {
+    if (!m_Comparer.Equal(itLhs.Key(), itRhs.Key()))
+      return false;
+
+    if (itLhs.Value() != itRhs.Value())
+      return false;
+
+    itLhs.Next();
+    itRhs.Next();
+  }
+
+  return true;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+EZ_ALWAYS_INLINE bool ezBTreeMapBase<KeyType, ValueType, Comparer>::operator!=(const ezBTreeMapBase<KeyType, ValueType, Comparer>& rhs) const
+{
+  return !operator==(rhs);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+ezUInt64 ezBTreeMapBase<KeyType, ValueType, Comparer>::GetHeapMemoryUsage() const
+{
+  return static_cast<ezUInt64>(m_uiNumLeaves) * sizeof(Leaf) + static_cast<ezUInt64>(m_uiNumInnerNodes) * sizeof(Inner);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::Swap(ezBTreeMapBase<KeyType, ValueType, Comparer>& other)
+{
+  // all nodes are heap allocated, so swapping the pointers (and the allocator that owns the nodes) is enough
+  ezMath::Swap(m_pRoot, other.m_pRoot);
+  ezMath::Swap(m_pFirstLeaf, other.m_pFirstLeaf);
+  ezMath::Swap(m_pLastLeaf, other.m_pLastLeaf);
+  ezMath::Swap(m_uiCount, other.m_uiCount);
+  ezMath::Swap(m_uiNumLeaves, other.m_uiNumLeaves);
+  ezMath::Swap(m_uiNumInnerNodes, other.m_uiNumInnerNodes);
+  ezMath::Swap(m_pAllocator, other.m_pAllocator);
+  ezMath::Swap(m_Comparer, other.m_Comparer);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Leaf* ezBTreeMapBase<KeyType, ValueType, Comparer>::AcquireLeaf()
+{
+  ++m_uiNumLeaves;
+  return EZ_NEW(m_pAllocator, Leaf);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Inner* ezBTreeMapBase<KeyType, ValueType, Comparer>::AcquireInner()
+{
+  ++m_uiNumInnerNodes;
+  Inner* pInner = EZ_NEW(m_pAllocator, Inner);
+  pInner->m_bIsLeaf = false;
+  return pInner;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::ReleaseNode(Node* pNode)
+{
+  if (pNode->m_bIsLeaf)
+  {
+    Leaf* pLeaf = static_cast<Leaf*>(pNode);
+    EZ_DELETE(m_pAllocator, pLeaf);
+    --m_uiNumLeaves;
+  }
+  else
+  {
+    Inner* pInner = static_cast<Inner*>(pNode);
+    EZ_DELETE(m_pAllocator, pInner);
+    --m_uiNumInnerNodes;
+  }
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::ReleaseSubTree(Node* pNode)
+{
+  if (pNode->m_bIsLeaf)
+  {
+    Leaf* pLeaf = static_cast<Leaf*>(pNode);
+    ezMemoryUtils::Destruct(pLeaf->GetValues(), pLeaf->m_uiCount);
+  }
+  else
+  {
+    Inner* pInner = static_cast<Inner*>(pNode);
+    for (ezUInt32 i = 0; i <= pInner->m_uiCount; ++i)
+    {
+      ReleaseSubTree(pInner->m_pChildren[i]);
+    }
+  }
+
+  ezMemoryUtils::Destruct(pNode->GetKeys(), pNode->m_uiCount);
+  ReleaseNode(pNode);
+}
+
+// ***** ezBTreeMap *****
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::ezBTreeMap()
+  : ezBTreeMapBase<KeyType, ValueType, Comparer>(Comparer(), AllocatorWrapper::GetAllocator())
+{
+}
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::ezBTreeMap(ezAllocatorBase* pAllocator)
+  : ezBTreeMapBase<KeyType, ValueType, Comparer>(Comparer(), pAllocator)
+{
+}
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::ezBTreeMap(const Comparer& comparer, ezAllocatorBase* pAllocator)
+  : ezBTreeMapBase<KeyType, ValueType, Comparer>(comparer, pAllocator)
+{
+}
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::ezBTreeMap(const ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>& other)
+  : ezBTreeMapBase<KeyType, ValueType, Comparer>(other, AllocatorWrapper::GetAllocator())
+{
+}
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::ezBTreeMap(const ezBTreeMapBase<KeyType, ValueType, Comparer>& other)
+  : ezBTreeMapBase<KeyType, ValueType, Comparer>(other, AllocatorWrapper::GetAllocator())
+{
+}
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+void ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::operator=(const ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>& rhs)
+{
+  ezBTreeMapBase<KeyType, ValueType, Comparer>::operator=(rhs);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+void ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::operator=(const ezBTreeMapBase<KeyType, ValueType, Comparer>& rhs)
+{
+  ezBTreeMapBase<KeyType, ValueType, Comparer>::operator=(rhs);
+}
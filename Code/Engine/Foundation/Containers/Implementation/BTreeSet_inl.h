@@ -0,0 +1,155 @@
+#pragma once
+
+template <typename KeyType, typename Comparer>
+ezBTreeSetBase<KeyType, Comparer>::ezBTreeSetBase(const Comparer& comparer, ezAllocatorBase* pAllocator)
+  : m_Map(comparer, pAllocator)
+{
+}
+
+template <typename KeyType, typename Comparer>
+ezBTreeSetBase<KeyType, Comparer>::ezBTreeSetBase(const ezBTreeSetBase<KeyType, Comparer>& cc, ezAllocatorBase* pAllocator)
+  : m_Map(cc.m_Map, pAllocator)
+{
+}
+
+template <typename KeyType, typename Comparer>
+void ezBTreeSetBase<KeyType, Comparer>::operator=(const ezBTreeSetBase<KeyType, Comparer>& rhs)
+{
+  m_Map = rhs.m_Map;
+}
+
+template <typename KeyType, typename Comparer>
+template <typename CompatibleKeyType>
+typename ezBTreeSetBase<KeyType, Comparer>::Iterator ezBTreeSetBase<KeyType, Comparer>::Insert(CompatibleKeyType&& key)
+{
+  return Iterator(m_Map.FindOrAdd(std::forward<CompatibleKeyType>(key)));
+}
+
+template <typename KeyType, typename Comparer>
+template <typename CompatibleKeyType>
+bool ezBTreeSetBase<KeyType, Comparer>::Remove(const CompatibleKeyType& key)
+{
+  return m_Map.Remove(key);
+}
+
+template <typename KeyType, typename Comparer>
+typename ezBTreeSetBase<KeyType, Comparer>::Iterator ezBTreeSetBase<KeyType, Comparer>::Remove(const Iterator& pos)
+{
+  return Iterator(m_Map.Remove(pos.m_It));
+}
+
+template <typename KeyType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE typename ezBTreeSetBase<KeyType, Comparer>::Iterator ezBTreeSetBase<KeyType, Comparer>::Find(const CompatibleKeyType& key) const
+{
+  return Iterator(m_Map.Find(key));
+}
+
+template <typename KeyType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE bool ezBTreeSetBase<KeyType, Comparer>::Contains(const CompatibleKeyType& key) const
+{
+  return m_Map.Contains(key);
+}
+
+template <typename KeyType, typename Comparer>
+bool ezBTreeSetBase<KeyType, Comparer>::ContainsSet(const ezBTreeSetBase<KeyType, Comparer>& operand) const
+{
+  for (const KeyType& key : operand)
+  {
+    if (!Contains(key))
+      return false;
+  }
+
+  return true;
+}
+
+template <typename KeyType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE typename ezBTreeSetBase<KeyType, Comparer>::Iterator ezBTreeSetBase<KeyType, Comparer>::LowerBound(
+  const CompatibleKeyType& key) const
+{
+  return Iterator(m_Map.LowerBound(key));
+}
+
+template <typename KeyType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE typename ezBTreeSetBase<KeyType, Comparer>::Iterator ezBTreeSetBase<KeyType, Comparer>::UpperBound(
+  const CompatibleKeyType& key) const
+{
+  return Iterator(m_Map.UpperBound(key));
+}
+
+template <typename KeyType, typename Comparer>
+void ezBTreeSetBase<KeyType, Comparer>::Union(const ezBTreeSetBase<KeyType, Comparer>& operand)
+{
+  for (const KeyType& key : operand)
+  {
+    Insert(key);
+  }
+}
+
+template <typename KeyType, typename Comparer>
+void ezBTreeSetBase<KeyType, Comparer>::Difference(const ezBTreeSetBase<KeyType, Comparer>& operand)
+{
+  for (const KeyType& key : operand)
+  {
+    Remove(key);
+  }
+}
+
+template <typename KeyType, typename Comparer>
+void ezBTreeSetBase<KeyType, Comparer>::Intersection(const ezBTreeSetBase<KeyType, Comparer>& operand)
+{
+  for (Iterator it = GetIterator(); it.IsValid();)
+  {
+    if (!operand.Contains(it.Key()))
+      it = Remove(it);
+    else
+      ++it;
+  }
+}
+
+// ***** ezBTreeSet *****
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+ezBTreeSet<KeyType, Comparer, AllocatorWrapper>::ezBTreeSet()
+  : ezBTreeSetBase<KeyType, Comparer>(Comparer(), AllocatorWrapper::GetAllocator())
+{
+}
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+ezBTreeSet<KeyType, Comparer, AllocatorWrapper>::ezBTreeSet(ezAllocatorBase* pAllocator)
+  : ezBTreeSetBase<KeyType, Comparer>(Comparer(), pAllocator)
+{
+}
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+ezBTreeSet<KeyType, Comparer, AllocatorWrapper>::ezBTreeSet(const Comparer& comparer, ezAllocatorBase* pAllocator)
+  : ezBTreeSetBase<KeyType, Comparer>(comparer, pAllocator)
+{
+}
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+ezBTreeSet<KeyType, Comparer, AllocatorWrapper>::ezBTreeSet(const ezBTreeSet<KeyType, Comparer, AllocatorWrapper>& other)
+  : ezBTreeSetBase<KeyType, Comparer>(other, AllocatorWrapper::GetAllocator())
+{
+}
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+ezBTreeSet<KeyType, Comparer, AllocatorWrapper>::ezBTreeSet(const ezBTreeSetBase<KeyType, Comparer>& other)
+  : ezBTreeSetBase<KeyType, Comparer>(other, AllocatorWrapper::GetAllocator())
+{
+}
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+void ezBTreeSet<KeyType, Comparer, AllocatorWrapper>::operator=(const ezBTreeSet<KeyType, Comparer, AllocatorWrapper>& rhs)
+{
+  ezBTreeSetBase<KeyType, Comparer>::operator=(rhs);
+}
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+void ezBTreeSet<KeyType, Comparer, AllocatorWrapper>::operator=(const ezBTreeSetBase<KeyType, Comparer>& rhs)
+{
+  ezBTreeSetBase<KeyType, Comparer>::operator=(rhs);
+}
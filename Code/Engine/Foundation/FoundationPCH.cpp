@@ -75,6 +75,7 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_DeduplicationContext);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_DependencyFile);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_DirectoryWatcher);
+  EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_JSONCursor);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_JSONParser);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_JSONReader);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_JSONWriter);
@@ -83,6 +84,7 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_OSFile);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_OpenDdlParser);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_OpenDdlReader);
+  EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_OpenDdlPullReader);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_OpenDdlUtils);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_OpenDdlWriter);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_StandardJSONWriter);
@@ -90,6 +92,7 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_StreamOperations);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_StreamOperationsOther);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_StringDeduplicationContext);
+  EZ_STATICLINK_REFERENCE(Foundation_Logging_Implementation_BinaryWriter);
   EZ_STATICLINK_REFERENCE(Foundation_Logging_Implementation_ConsoleWriter);
   EZ_STATICLINK_REFERENCE(Foundation_Logging_Implementation_ETWWriter);
   EZ_STATICLINK_REFERENCE(Foundation_Logging_Implementation_HTMLWriter);
@@ -122,6 +125,7 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_Serialization_Implementation_DdlSerializer);
   EZ_STATICLINK_REFERENCE(Foundation_Serialization_Implementation_GraphPatch);
   EZ_STATICLINK_REFERENCE(Foundation_Serialization_Implementation_GraphVersioning);
+  EZ_STATICLINK_REFERENCE(Foundation_Serialization_Implementation_ReflectionBinarySerializer);
   EZ_STATICLINK_REFERENCE(Foundation_Serialization_Implementation_ReflectionSerializer);
   EZ_STATICLINK_REFERENCE(Foundation_Serialization_Implementation_RttiConverterReader);
   EZ_STATICLINK_REFERENCE(Foundation_Serialization_Implementation_RttiConverterWriter);
@@ -164,6 +168,7 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_Time_Implementation_DefaultTimeStepSmoothing);
   EZ_STATICLINK_REFERENCE(Foundation_Time_Implementation_Stopwatch);
   EZ_STATICLINK_REFERENCE(Foundation_Time_Implementation_Time);
+  EZ_STATICLINK_REFERENCE(Foundation_Time_Implementation_TimeStatistics);
   EZ_STATICLINK_REFERENCE(Foundation_Time_Implementation_Timestamp);
   EZ_STATICLINK_REFERENCE(Foundation_Tracks_Implementation_ColorGradient);
   EZ_STATICLINK_REFERENCE(Foundation_Tracks_Implementation_Curve1D);
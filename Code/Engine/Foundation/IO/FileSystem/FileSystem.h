@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Foundation/Communication/Event.h>
+#include <Foundation/Containers/BTreeMap.h>
 #include <Foundation/Containers/HybridArray.h>
 #include <Foundation/Containers/Map.h>
 #include <Foundation/IO/FileSystem/Implementation/DataDirType.h>
@@ -301,7 +302,7 @@ private:
   static void CleanUpRootName(ezStringBuilder& sRoot);
 
   static ezString s_sSdkRootDir;
-  static ezMap<ezString, ezString> s_SpecialDirectories;
+  static ezBTreeMap<ezString, ezString> s_SpecialDirectories;
   static FileSystemData* s_Data;
 };
 
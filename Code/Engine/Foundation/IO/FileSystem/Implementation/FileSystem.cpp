@@ -23,7 +23,7 @@ EZ_END_SUBSYSTEM_DECLARATION;
 
 ezFileSystem::FileSystemData* ezFileSystem::s_Data = nullptr;
 ezString ezFileSystem::s_sSdkRootDir;
-ezMap<ezString, ezString> ezFileSystem::s_SpecialDirectories;
+ezBTreeMap<ezString, ezString> ezFileSystem::s_SpecialDirectories;
 
 
 void ezFileSystem::RegisterDataDirectoryFactory(ezDataDirFactory Factory, float fPriority /*= 0*/)
@@ -0,0 +1,881 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/IO/JSONCursor.h>
+#include <Foundation/SimdMath/SimdTypes.h>
+#include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Utilities/ConversionUtils.h>
+
+// The document is indexed in blocks of 64 bytes. For each block, one bit per byte is computed for every character class of interest.
+// All further processing then works on these bit masks, which handles 64 bytes at once without any branches.
+namespace
+{
+  struct BlockMasks
+  {
+    ezUInt64 m_uiQuotes = 0;
+    ezUInt64 m_uiBackslashes = 0;
+    ezUInt64 m_uiStructurals = 0;
+    ezUInt64 m_uiWhitespace = 0;
+    ezUInt64 m_uiSlashes = 0;
+  };
+
+#if EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE
+
+  EZ_ALWAYS_INLINE ezUInt64 CompareMask(__m128i value, char c, ezUInt32 uiShift)
+  {
+    return static_cast<ezUInt64>(static_cast<ezUInt32>(_mm_movemask_epi8(_mm_cmpeq_epi8(value, _mm_set1_epi8(c))))) << uiShift;
+  }
+
+  void ClassifyBlock(const ezUInt8* pBlock, BlockMasks& out_masks)
+  {
+    for (ezUInt32 i = 0; i < 4; ++i)
+    {
+      const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pBlock + i * 16));
+      const ezUInt32 uiShift = i * 16;
+
+      // '[' and ']' only differ from '{' and '}' in the 0x20 bit
+      const __m128i brackets = _mm_or_si128(value, _mm_set1_epi8(0x20));
+
+      out_masks.m_uiQuotes |= CompareMask(value, '\"', uiShift);
+      out_masks.m_uiBackslashes |= CompareMask(value, '\\', uiShift);
+      out_masks.m_uiStructurals |=
+        CompareMask(brackets, '{', uiShift) | CompareMask(brackets, '}', uiShift) | CompareMask(value, ':', uiShift) | CompareMask(value, ',', uiShift);
+      out_masks.m_uiWhitespace |=
+        CompareMask(value, ' ', uiShift) | CompareMask(value, '\t', uiShift) | CompareMask(value, '\n', uiShift) | CompareMask(value, '\r', uiShift);
+      out_masks.m_uiSlashes |= CompareMask(value, '/', uiShift);
+    }
+  }
+
+#else
+
+  void ClassifyBlock(const ezUInt8* pBlock, BlockMasks& out_masks)
+  {
+    for (ezUInt32 i = 0; i < 64; ++i)
+    {
+      const ezUInt64 uiBit = 1ull << i;
+
+      switch (pBlock[i])
+      {
+        case '\"':
+          out_masks.m_uiQuotes |= uiBit;
+          break;
+        case '\\':
+          out_masks.m_uiBackslashes |= uiBit;
+          break;
+        case '{':
+        case '}':
+        case '[':
+        case ']':
+        case ':':
+        case ',':
+          out_masks.m_uiStructurals |= uiBit;
+          break;
+        case ' ':
+        case '\t':
+        case '\n':
+        case '\r':
+          out_masks.m_uiWhitespace |= uiBit;
+          break;
+        case '/':
+          out_masks.m_uiSlashes |= uiBit;
+          break;
+      }
+    }
+  }
+
+#endif
+
+  /// \brief Sets every bit to the XOR of itself and all lower bits. For the bits of the quotes, this yields the bits of all string contents.
+  EZ_ALWAYS_INLINE ezUInt64 PrefixXor(ezUInt64 uiBits)
+  {
+    uiBits ^= uiBits << 1;
+    uiBits ^= uiBits << 2;
+    uiBits ^= uiBits << 4;
+    uiBits ^= uiBits << 8;
+    uiBits ^= uiBits << 16;
+    uiBits ^= uiBits << 32;
+    return uiBits;
+  }
+
+  /// \brief Returns the bits of all characters that are escaped by a backslash. Backslashes are rare, so they are simply processed one by one.
+  EZ_ALWAYS_INLINE ezUInt64 ComputeEscaped(ezUInt64 uiBackslashes, ezUInt64& ref_uiEscapeCarry)
+  {
+    ezUInt64 uiEscaped = ref_uiEscapeCarry;
+    ref_uiEscapeCarry = 0;
+
+    while (uiBackslashes != 0)
+    {
+      const ezUInt64 uiBit = uiBackslashes & (~uiBackslashes + 1);
+      uiBackslashes &= uiBackslashes - 1;
+
+      if ((uiEscaped & uiBit) != 0)
+        continue;
+
+      if (uiBit == (1ull << 63))
+        ref_uiEscapeCarry = 1;
+      else
+        uiEscaped |= uiBit << 1;
+    }
+
+    return uiEscaped;
+  }
+
+  void AddIndices(ezDynamicArray<ezUInt32>& ref_indices, ezUInt32 uiBlockStart, ezUInt64 uiBits)
+  {
+    const ezUInt32 uiLow = static_cast<ezUInt32>(uiBits);
+    const ezUInt32 uiHigh = static_cast<ezUInt32>(uiBits >> 32);
+
+    const ezUInt32 uiOldCount = ref_indices.GetCount();
+    ref_indices.SetCountUninitialized(uiOldCount + ezMath::CountBits(uiLow) + ezMath::CountBits(uiHigh));
+
+    ezUInt32* pIndex = ref_indices.GetData() + uiOldCount;
+
+    for (ezUInt32 uiBitsLeft = uiLow; uiBitsLeft != 0; uiBitsLeft &= uiBitsLeft - 1)
+    {
+      *pIndex++ = uiBlockStart + ezMath::FirstBitLow(uiBitsLeft);
+    }
+
+    for (ezUInt32 uiBitsLeft = uiHigh; uiBitsLeft != 0; uiBitsLeft &= uiBitsLeft - 1)
+    {
+      *pIndex++ = uiBlockStart + 32 + ezMath::FirstBitLow(uiBitsLeft);
+    }
+  }
+
+  /// \brief Returns a pointer to the first '"' or '\' in the given range, or pEnd.
+  const char* FindQuoteOrBackslash(const char* pStart, const char* pEnd)
+  {
+#if EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE
+    const __m128i quote = _mm_set1_epi8('\"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+
+    while (pStart + 16 <= pEnd)
+    {
+      const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pStart));
+      const ezUInt32 uiMask = static_cast<ezUInt32>(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(value, quote), _mm_cmpeq_epi8(value, backslash))));
+
+      if (uiMask != 0)
+        return pStart + ezMath::FirstBitLow(uiMask);
+
+      pStart += 16;
+    }
+#endif
+
+    while (pStart < pEnd && *pStart != '\"' && *pStart != '\\')
+      ++pStart;
+
+    return pStart;
+  }
+
+  /// \brief Converts numbers with up to 15 significant digits and small exponents exactly. Returns false for all other numbers.
+  bool ParseDoubleFast(const char* pStart, const char* pEnd, double& out_fValue)
+  {
+    static constexpr double s_Powers[] = {
+      1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    const char* p = pStart;
+    const bool bNegative = (p < pEnd && *p == '-');
+    if (p < pEnd && (*p == '-' || *p == '+'))
+      ++p;
+
+    ezUInt64 uiMantissa = 0;
+    ezUInt32 uiSignificantDigits = 0;
+    ezUInt32 uiAllDigits = 0;
+    ezInt32 iExponent = 0;
+
+    for (; p < pEnd && *p >= '0' && *p <= '9'; ++p, ++uiAllDigits)
+    {
+      uiMantissa = uiMantissa * 10 + (*p - '0');
+      uiSignificantDigits += (uiMantissa != 0) ? 1 : 0;
+    }
+
+    if (p < pEnd && *p == '.')
+    {
+      for (++p; p < pEnd && *p >= '0' && *p <= '9'; ++p, ++uiAllDigits)
+      {
+        uiMantissa = uiMantissa * 10 + (*p - '0');
+        uiSignificantDigits += (uiMantissa != 0) ? 1 : 0;
+        --iExponent;
+
+        if (uiSignificantDigits > 15)
+          return false;
+      }
+    }
+
+    if (uiAllDigits == 0 || uiSignificantDigits > 15)
+      return false;
+
+    if (p < pEnd && (*p == 'e' || *p == 'E'))
+    {
+      ++p;
+
+      const bool bNegativeExponent = (p < pEnd && *p == '-');
+      if (p < pEnd && (*p == '-' || *p == '+'))
+        ++p;
+
+      if (p == pEnd)
+        return false;
+
+      ezInt32 iExplicitExponent = 0;
+      for (; p < pEnd && *p >= '0' && *p <= '9'; ++p)
+      {
+        iExplicitExponent = iExplicitExponent * 10 + (*p - '0');
+
+        if (iExplicitExponent > 1000)
+          return false;
+      }
+
+      iExponent += bNegativeExponent ? -iExplicitExponent : iExplicitExponent;
+    }
+
+    if (p != pEnd || iExponent < -22 || iExponent > 22)
+      return false;
+
+    // both the mantissa and the power of ten are exactly representable, so a single multiplication or division is correctly rounded
+    double fValue = static_cast<double>(uiMantissa);
+    fValue = (iExponent < 0) ? fValue / s_Powers[-iExponent] : fValue * s_Powers[iExponent];
+
+    out_fValue = bNegative ? -fValue : fValue;
+    return true;
+  }
+
+  ezUInt32 ParseHex4(const char* p)
+  {
+    ezUInt32 uiValue = 0;
+
+    for (ezUInt32 i = 0; i < 4; ++i)
+    {
+      const char c = p[i];
+      ezUInt32 uiDigit;
+
+      if (c >= '0' && c <= '9')
+        uiDigit = c - '0';
+      else if (c >= 'a' && c <= 'f')
+        uiDigit = c - 'a' + 10;
+      else if (c >= 'A' && c <= 'F')
+        uiDigit = c - 'A' + 10;
+      else
+        return 0xFFFFFFFF;
+
+      uiValue = (uiValue << 4) | uiDigit;
+    }
+
+    return uiValue;
+  }
+} // namespace
+
+ezJSONCursor::ezJSONCursor() = default;
+ezJSONCursor::~ezJSONCursor() = default;
+
+ezResult ezJSONCursor::SetInput(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset, ezLogInterface* pLog)
+{
+  m_pLog = pLog;
+  m_uiFirstLineOffset = uiFirstLineOffset;
+  m_bHadError = false;
+  m_sErrorMessage.Clear();
+  m_uiErrorPosition = 0;
+  m_uiCurrent = 0;
+  m_OriginalData = data;
+  m_DataWithoutComments.Clear();
+  m_RemovedComments.Clear();
+
+  bool bStringsTerminated = BuildIndex(data);
+
+  // comments are rare, so the index is only built a second time, from a copy without them, when there are any
+  if (m_bContainsComments)
+  {
+    RemoveComments(data);
+    bStringsTerminated = BuildIndex(m_DataWithoutComments.GetArrayPtr());
+  }
+
+  if (!bStringsTerminated)
+  {
+    m_uiCurrent = m_Indices.GetCount() - 1;
+    Error("Reached end of document before end of string was found.");
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+}
+
+bool ezJSONCursor::BuildIndex(ezArrayPtr<const ezUInt8> data)
+{
+  m_Data = data;
+  m_Indices.Clear();
+  m_bContainsComments = false;
+
+  ezUInt64 uiEscapeCarry = 0;
+  ezUInt64 uiInStringCarry = 0;
+  ezUInt64 uiScalarCarry = 0;
+
+  const ezUInt32 uiDataSize = data.GetCount();
+  ezUInt8 lastBlock[64];
+
+  for (ezUInt32 uiBlockStart = 0; uiBlockStart < uiDataSize; uiBlockStart += 64)
+  {
+    const ezUInt8* pBlock = data.GetPtr() + uiBlockStart;
+
+    // pad the last block with whitespace, so that no byte after the end of the data is read
+    if (uiDataSize - uiBlockStart < 64)
+    {
+      ezMemoryUtils::PatternFill(lastBlock, ' ', 64);
+      ezMemoryUtils::Copy(lastBlock, pBlock, uiDataSize - uiBlockStart);
+      pBlock = lastBlock;
+    }
+
+    BlockMasks masks;
+    ClassifyBlock(pBlock, masks);
+
+    const ezUInt64 uiEscaped = ComputeEscaped(masks.m_uiBackslashes, uiEscapeCarry);
+    const ezUInt64 uiQuotes = masks.m_uiQuotes & ~uiEscaped;
+
+    // contains the opening quote and the content of each string, but not the closing quote
+    const ezUInt64 uiInString = PrefixXor(uiQuotes) ^ uiInStringCarry;
+    uiInStringCarry = static_cast<ezUInt64>(static_cast<ezInt64>(uiInString) >> 63);
+
+    // numbers, true, false, null and anything invalid
+    const ezUInt64 uiScalars = ~(masks.m_uiStructurals | masks.m_uiWhitespace | uiQuotes | uiInString);
+    const ezUInt64 uiScalarStarts = uiScalars & ~((uiScalars << 1) | uiScalarCarry);
+    uiScalarCarry = uiScalars >> 63;
+
+    m_bContainsComments |= (masks.m_uiSlashes & ~uiInString) != 0;
+
+    AddIndices(m_Indices, uiBlockStart, (masks.m_uiStructurals & ~uiInString) | (uiQuotes & uiInString) | uiScalarStarts);
+  }
+
+  // the end of the data acts as a '\0' character
+  m_Indices.PushBack(uiDataSize);
+
+  return uiInStringCarry == 0;
+}
+
+void ezJSONCursor::RemoveComments(ezArrayPtr<const ezUInt8> data)
+{
+  const ezUInt32 uiDataSize = data.GetCount();
+
+  m_DataWithoutComments.Clear();
+  m_DataWithoutComments.Reserve(uiDataSize);
+  m_RemovedComments.Clear();
+
+  ezUInt32 i = 0;
+  while (i < uiDataSize)
+  {
+    const ezUInt8 c = data[i];
+    const ezUInt8 next = (i + 1 < uiDataSize) ? data[i + 1] : '\0';
+
+    if (c == '\"')
+    {
+      // copy the string, including the quotes and escape sequences
+      m_DataWithoutComments.PushBack(data[i++]);
+
+      while (i < uiDataSize && data[i] != '\"')
+      {
+        if (data[i] == '\\' && i + 1 < uiDataSize)
+          m_DataWithoutComments.PushBack(data[i++]);
+
+        m_DataWithoutComments.PushBack(data[i++]);
+      }
+
+      if (i < uiDataSize)
+        m_DataWithoutComments.PushBack(data[i++]);
+    }
+    else if (c == '/' && (next == '/' || next == '*'))
+    {
+      // like ezJSONParser, comments are removed entirely, even in the middle of a value
+      if (next == '/')
+      {
+        while (i < uiDataSize && data[i] != '\n')
+          ++i;
+      }
+      else
+      {
+        for (i += 2; i < uiDataSize && !(data[i] == '*' && i + 1 < uiDataSize && data[i + 1] == '/'); ++i)
+        {
+        }
+
+        i = ezMath::Min(i + 2, uiDataSize);
+      }
+
+      // remember where the following data came from, to report errors at the right position
+      auto& removed = m_RemovedComments.ExpandAndGetRef();
+      removed.m_uiPosition = m_DataWithoutComments.GetCount();
+      removed.m_uiOriginalPosition = i;
+    }
+    else
+    {
+      m_DataWithoutComments.PushBack(c);
+      ++i;
+    }
+  }
+}
+
+ezJSONCursor::ValueType ezJSONCursor::GetValueType() const
+{
+  if (m_bHadError)
+    return ValueType::Invalid;
+
+  switch (GetCurrentChar())
+  {
+    case '{':
+      return ValueType::Object;
+
+    case '[':
+      return ValueType::Array;
+
+    case '\"':
+      return ValueType::String;
+
+    case 't':
+    case 'f':
+      return ValueType::Bool;
+
+    case 'n':
+      return ValueType::Null;
+
+    case '+':
+    case '-':
+    case '.':
+    case '0':
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+    case '9':
+      return ValueType::Number;
+
+    default:
+      return ValueType::Invalid;
+  }
+}
+
+bool ezJSONCursor::BeginObject()
+{
+  if (m_bHadError)
+    return false;
+
+  if (GetCurrentChar() != '{')
+  {
+    ezStringBuilder s;
+    s.Format("Expected a { to begin an object. Got '{0}' instead.", ezArgC(GetCurrentChar()));
+    Error(s);
+    return false;
+  }
+
+  ++m_uiCurrent;
+  return true;
+}
+
+bool ezJSONCursor::NextMember(ezStringView& out_sKey)
+{
+  if (m_bHadError)
+    return false;
+
+  ezUInt8 c = GetCurrentChar();
+
+  if (c == ',')
+  {
+    // superfluous commas are ignored
+    do
+    {
+      ++m_uiCurrent;
+      c = GetCurrentChar();
+    } while (c == ',');
+  }
+  else if (c != '}' && (m_uiCurrent == 0 || GetChar(m_uiCurrent - 1) != '{'))
+  {
+    ezStringBuilder s;
+    s.Format("After parsing value: Expected a comma or closing braces. Got '{0}' instead.", ezArgC(c));
+    Error(s);
+    return false;
+  }
+
+  if (c == '}')
+  {
+    ++m_uiCurrent;
+    return false;
+  }
+
+  if (c != '\"')
+  {
+    ezStringBuilder s;
+    s.Format("While parsing object: Expected \" to begin a new variable, or } to close the object. Got '{0}' instead.", ezArgC(c));
+    Error(s);
+    return false;
+  }
+
+  if (ReadStringAt(m_uiCurrent, m_DecodedKey, out_sKey).Failed())
+    return false;
+
+  ++m_uiCurrent;
+
+  if (GetCurrentChar() != ':')
+  {
+    ezStringBuilder s;
+    s.Format("After parsing variable name: Expected : to separate variable and value, Got '{0}' instead.", ezArgC(GetCurrentChar()));
+    Error(s);
+    return false;
+  }
+
+  ++m_uiCurrent;
+  return true;
+}
+
+bool ezJSONCursor::BeginArray()
+{
+  if (m_bHadError)
+    return false;
+
+  if (GetCurrentChar() != '[')
+  {
+    ezStringBuilder s;
+    s.Format("Expected a [ to begin an array. Got '{0}' instead.", ezArgC(GetCurrentChar()));
+    Error(s);
+    return false;
+  }
+
+  ++m_uiCurrent;
+  return true;
+}
+
+bool ezJSONCursor::NextElement()
+{
+  if (m_bHadError)
+    return false;
+
+  ezUInt8 c = GetCurrentChar();
+
+  if (c == ',' && m_uiCurrent > 0 && GetChar(m_uiCurrent - 1) != '[')
+  {
+    ++m_uiCurrent;
+    c = GetCurrentChar();
+  }
+  else if (c != ']' && (m_uiCurrent == 0 || GetChar(m_uiCurrent - 1) != '['))
+  {
+    ezStringBuilder s;
+    s.Format("After parsing value: Expected a comma or closing brackets. Got '{0}' instead.", ezArgC(c));
+    Error(s);
+    return false;
+  }
+
+  // a trailing comma is allowed
+  if (c == ']')
+  {
+    ++m_uiCurrent;
+    return false;
+  }
+
+  return true;
+}
+
+ezResult ezJSONCursor::ReadString(ezStringView& out_sValue)
+{
+  if (m_bHadError)
+    return EZ_FAILURE;
+
+  if (GetCurrentChar() != '\"')
+  {
+    ezStringBuilder s;
+    s.Format("Expected a string. Got '{0}' instead.", ezArgC(GetCurrentChar()));
+    Error(s);
+    return EZ_FAILURE;
+  }
+
+  EZ_SUCCEED_OR_RETURN(ReadStringAt(m_uiCurrent, m_DecodedValue, out_sValue));
+
+  ++m_uiCurrent;
+  return EZ_SUCCESS;
+}
+
+ezResult ezJSONCursor::ReadStringAt(ezUInt32 uiIndex, ezDynamicArray<char>& ref_decoded, ezStringView& out_sValue)
+{
+  const char* pData = reinterpret_cast<const char*>(m_Data.GetPtr());
+  const char* pEnd = pData + m_Data.GetCount();
+  const char* pStart = pData + m_Indices[uiIndex] + 1;
+
+  const char* p = FindQuoteOrBackslash(pStart, pEnd);
+
+  if (p < pEnd && *p == '\"')
+  {
+    out_sValue = ezStringView(pStart, p);
+    return EZ_SUCCESS;
+  }
+
+  ref_decoded.Clear();
+  ref_decoded.PushBackRange(ezArrayPtr<const char>(pStart, static_cast<ezUInt32>(p - pStart)));
+
+  while (p < pEnd && *p != '\"')
+  {
+    if (*p != '\\')
+    {
+      ref_decoded.PushBack(*p);
+      ++p;
+      continue;
+    }
+
+    ++p;
+    const char cEscaped = (p < pEnd) ? *p : '\0';
+    ++p;
+
+    switch (cEscaped)
+    {
+      case '\"':
+      case '\\':
+      case '/':
+        ref_decoded.PushBack(cEscaped);
+        break;
+      case 'b':
+        ref_decoded.PushBack('\b');
+        break;
+      case 'f':
+        ref_decoded.PushBack('\f');
+        break;
+      case 'n':
+        ref_decoded.PushBack('\n');
+        break;
+      case 'r':
+        ref_decoded.PushBack('\r');
+        break;
+      case 't':
+        ref_decoded.PushBack('\t');
+        break;
+
+      case 'u':
+      {
+        ezUInt32 uiChar = (pEnd - p >= 4) ? ParseHex4(p) : 0xFFFFFFFF;
+        p += 4;
+
+        // characters outside of the BMP are written as UTF-16 surrogate pairs
+        if (uiChar >= 0xD800 && uiChar <= 0xDBFF && pEnd - p >= 6 && p[0] == '\\' && p[1] == 'u')
+        {
+          const ezUInt32 uiLow = ParseHex4(p + 2);
+
+          if (uiLow >= 0xDC00 && uiLow <= 0xDFFF)
+          {
+            uiChar = 0x10000 + ((uiChar - 0xD800) << 10) + (uiLow - 0xDC00);
+            p += 6;
+          }
+        }
+
+        if (uiChar == 0xFFFFFFFF || (uiChar >= 0xD800 && uiChar <= 0xDFFF))
+        {
+          m_uiCurrent = uiIndex;
+          Error("Invalid unicode escape-sequence.");
+          return EZ_FAILURE;
+        }
+
+        char szUtf8[4];
+        char* pUtf8 = szUtf8;
+        ezUnicodeUtils::EncodeUtf32ToUtf8(uiChar, pUtf8);
+        ref_decoded.PushBackRange(ezArrayPtr<const char>(szUtf8, static_cast<ezUInt32>(pUtf8 - szUtf8)));
+      }
+      break;
+
+      default:
+      {
+        ezStringBuilder s;
+        s.Format("Unknown escape-sequence '\\{0}'", ezArgC(cEscaped));
+        m_uiCurrent = uiIndex;
+        Error(s);
+      }
+        return EZ_FAILURE;
+    }
+  }
+
+  out_sValue = ezStringView(ref_decoded.GetData(), ref_decoded.GetData() + ref_decoded.GetCount());
+  return EZ_SUCCESS;
+}
+
+ezStringView ezJSONCursor::GetScalarToken() const
+{
+  const char* pData = reinterpret_cast<const char*>(m_Data.GetPtr());
+  const char* pStart = pData + m_Indices[m_uiCurrent];
+  const char* pEnd = pData + m_Indices[m_uiCurrent + 1];
+
+  while (pEnd > pStart && ezStringUtils::IsWhiteSpace(pEnd[-1]))
+    --pEnd;
+
+  return ezStringView(pStart, pEnd);
+}
+
+ezResult ezJSONCursor::ReadDouble(double& out_fValue)
+{
+  if (m_bHadError)
+    return EZ_FAILURE;
+
+  if (GetValueType() != ValueType::Number)
+  {
+    ezStringBuilder s;
+    s.Format("Expected a number. Got '{0}' instead.", ezArgC(GetCurrentChar()));
+    Error(s);
+    return EZ_FAILURE;
+  }
+
+  const ezStringView sToken = GetScalarToken();
+
+  if (!ParseDoubleFast(sToken.GetStartPointer(), sToken.GetEndPointer(), out_fValue))
+  {
+    // long or unusual numbers use the same conversion as ezJSONParser
+    ezStringBuilder sNumber = sToken;
+    const char* szLastParsePosition = nullptr;
+
+    if (ezConversionUtils::StringToFloat(sNumber, out_fValue, &szLastParsePosition).Failed() || *szLastParsePosition != '\0')
+    {
+      ezStringBuilder s;
+      s.Format("Reading number failed: Could not convert '{0}' to a floating point value.", sNumber);
+      Error(s);
+      return EZ_FAILURE;
+    }
+  }
+
+  ++m_uiCurrent;
+  return EZ_SUCCESS;
+}
+
+ezResult ezJSONCursor::ReadBool(bool& out_bValue)
+{
+  if (m_bHadError)
+    return EZ_FAILURE;
+
+  const ezStringView sToken = (GetValueType() == ValueType::Bool) ? GetScalarToken() : ezStringView();
+
+  if (sToken == "true")
+    out_bValue = true;
+  else if (sToken == "false")
+    out_bValue = false;
+  else
+  {
+    ezStringBuilder s;
+    s.Format("Parsing value: Expected 'true' or 'false', Got '{0}' instead.", sToken);
+    Error(s);
+    return EZ_FAILURE;
+  }
+
+  ++m_uiCurrent;
+  return EZ_SUCCESS;
+}
+
+ezResult ezJSONCursor::ReadNull()
+{
+  if (m_bHadError)
+    return EZ_FAILURE;
+
+  const ezStringView sToken = (GetValueType() == ValueType::Null) ? GetScalarToken() : ezStringView();
+
+  if (sToken != "null")
+  {
+    ezStringBuilder s;
+    s.Format("Parsing value: Expected 'null', Got '{0}' instead.", sToken);
+    Error(s);
+    return EZ_FAILURE;
+  }
+
+  ++m_uiCurrent;
+  return EZ_SUCCESS;
+}
+
+void ezJSONCursor::SkipValue()
+{
+  if (m_bHadError)
+    return;
+
+  switch (GetCurrentChar())
+  {
+    case '{':
+    case '[':
+    {
+      ezUInt32 uiDepth = 0;
+
+      do
+      {
+        switch (GetCurrentChar())
+        {
+          case '{':
+          case '[':
+            ++uiDepth;
+            break;
+
+          case '}':
+          case ']':
+            --uiDepth;
+            break;
+
+          case '\0':
+            Error("End of the document reached without closing all objects.");
+            return;
+        }
+
+        ++m_uiCurrent;
+      } while (uiDepth > 0);
+    }
+    break;
+
+    case '}':
+    case ']':
+    case ',':
+    case ':':
+    case '\0':
+    {
+      ezStringBuilder s;
+      s.Format("Parsing value: Expected [, {, f, t, n, \", a number. Got '{0}' instead", ezArgC(GetCurrentChar()));
+      Error(s);
+    }
+    break;
+
+    default:
+      // strings and scalars are a single entry in the index
+      ++m_uiCurrent;
+      break;
+  }
+}
+
+void ezJSONCursor::GetErrorPosition(ezUInt32& out_uiLine, ezUInt32& out_uiColumn) const
+{
+  // map the position back to the data with comments
+  ezUInt32 uiErrorPosition = m_uiErrorPosition;
+  for (ezUInt32 i = m_RemovedComments.GetCount(); i > 0; --i)
+  {
+    const auto& removed = m_RemovedComments[i - 1];
+    if (removed.m_uiPosition <= m_uiErrorPosition)
+    {
+      uiErrorPosition = removed.m_uiOriginalPosition + (m_uiErrorPosition - removed.m_uiPosition);
+      break;
+    }
+  }
+
+  out_uiLine = 1 + m_uiFirstLineOffset;
+  out_uiColumn = 0;
+
+  for (ezUInt32 i = 0; i < uiErrorPosition && i < m_OriginalData.GetCount(); ++i)
+  {
+    if (m_OriginalData[i] == '\n')
+    {
+      ++out_uiLine;
+      out_uiColumn = 0;
+    }
+    else
+      ++out_uiColumn;
+  }
+}
+
+void ezJSONCursor::Error(const char* szMessage)
+{
+  if (m_bHadError)
+    return;
+
+  m_bHadError = true;
+  m_sErrorMessage = szMessage;
+  m_uiErrorPosition = m_Indices[m_uiCurrent];
+
+  ezUInt32 uiLine, uiColumn;
+  GetErrorPosition(uiLine, uiColumn);
+  ezLog::Error(m_pLog, "Line {0} ({1}): {2}", uiLine, uiColumn, szMessage);
+
+  // all further reads fail
+  m_uiCurrent = m_Indices.GetCount() - 1;
+}
+
+
+
+EZ_STATICLINK_FILE(Foundation, Foundation_IO_Implementation_JSONCursor);
@@ -1,5 +1,6 @@
 #include <FoundationPCH.h>
 
+#include <Foundation/IO/JSONCursor.h>
 #include <Foundation/IO/JSONParser.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Utilities/ConversionUtils.h>
@@ -9,6 +10,7 @@ ezJSONParser::ezJSONParser()
   m_uiCurByte = '\0';
   m_uiNextByte = '\0';
   m_pInput = nullptr;
+  m_pCursor = nullptr;
   m_bSkippingMode = false;
   m_pLogInterface = nullptr;
   m_uiCurLine = 1;
@@ -90,6 +92,119 @@ void ezJSONParser::ParseAll()
   }
 }
 
+ezResult ezJSONParser::ParseBuffer(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset)
+{
+  ezJSONCursor json;
+  m_pCursor = &json;
+
+  // only objects and arrays are put onto the stack, with the Finished state at the bottom, just like when parsing a stream
+  m_StateStack.Clear();
+  m_StateStack.ExpandAndGetRef().m_State = Finished;
+
+  if (json.SetInput(data, uiFirstLineOffset, m_pLogInterface).Succeeded() && !json.IsAtEnd() && json.BeginObject())
+  {
+    m_StateStack.ExpandAndGetRef().m_State = ReadingObject;
+    OnBeginObject();
+  }
+
+  ezStringView sValue;
+  ezStringBuilder sTemp;
+
+  while (m_StateStack.GetCount() > 1 && !json.HadError())
+  {
+    if (m_StateStack.PeekBack().m_State == ReadingObject)
+    {
+      if (!json.NextMember(sValue))
+      {
+        m_StateStack.PopBack();
+
+        if (!json.HadError())
+          OnEndObject();
+
+        continue;
+      }
+
+      sTemp = sValue;
+      if (!OnVariable(sTemp))
+      {
+        json.SkipValue();
+        continue;
+      }
+    }
+    else if (!json.NextElement())
+    {
+      m_StateStack.PopBack();
+
+      if (!json.HadError())
+        OnEndArray();
+
+      continue;
+    }
+
+    switch (json.GetValueType())
+    {
+      case ezJSONCursor::ValueType::Object:
+        json.BeginObject();
+        m_StateStack.ExpandAndGetRef().m_State = ReadingObject;
+        OnBeginObject();
+        break;
+
+      case ezJSONCursor::ValueType::Array:
+        json.BeginArray();
+        m_StateStack.ExpandAndGetRef().m_State = ReadingArray;
+        OnBeginArray();
+        break;
+
+      case ezJSONCursor::ValueType::String:
+        if (json.ReadString(sValue).Succeeded())
+        {
+          sTemp = sValue;
+          OnReadValue(sTemp.GetData());
+        }
+        break;
+
+      case ezJSONCursor::ValueType::Number:
+      {
+        double fValue = 0;
+        if (json.ReadDouble(fValue).Succeeded())
+          OnReadValue(fValue);
+      }
+      break;
+
+      case ezJSONCursor::ValueType::Bool:
+      {
+        bool bValue = false;
+        if (json.ReadBool(bValue).Succeeded())
+          OnReadValue(bValue);
+      }
+      break;
+
+      case ezJSONCursor::ValueType::Null:
+        if (json.ReadNull().Succeeded())
+          OnReadValueNULL();
+        break;
+
+      default:
+        // reports the error
+        json.SkipValue();
+        break;
+    }
+  }
+
+  m_pCursor = nullptr;
+  m_StateStack.Clear();
+
+  if (json.HadError())
+  {
+    ezUInt32 uiLine, uiColumn;
+    json.GetErrorPosition(uiLine, uiColumn);
+    OnParsingError(json.GetErrorMessage(), true, uiLine, uiColumn);
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+}
+
 void ezJSONParser::ParsingError(const char* szMessage, bool bFatal)
 {
   if (bFatal)
@@ -119,8 +234,6 @@ void ezJSONParser::SkipArray()
 
 void ezJSONParser::SkipStack(State s)
 {
-  m_bSkippingMode = true;
-
   ezUInt32 iSkipToStackHeight = m_StateStack.GetCount();
 
   for (ezUInt32 top = m_StateStack.GetCount(); top > 1; --top)
@@ -132,6 +245,31 @@ void ezJSONParser::SkipStack(State s)
     }
   }
 
+  if (m_pCursor != nullptr)
+  {
+    ezStringView sKey;
+
+    while (m_StateStack.GetCount() > iSkipToStackHeight)
+    {
+      if (m_StateStack.PeekBack().m_State == ReadingObject)
+      {
+        while (m_pCursor->NextMember(sKey))
+          m_pCursor->SkipValue();
+      }
+      else
+      {
+        while (m_pCursor->NextElement())
+          m_pCursor->SkipValue();
+      }
+
+      m_StateStack.PopBack();
+    }
+
+    return;
+  }
+
+  m_bSkippingMode = true;
+
   while (m_StateStack.GetCount() > iSkipToStackHeight)
     ContinueParsing();
 
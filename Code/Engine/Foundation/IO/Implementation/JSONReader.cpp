@@ -20,6 +20,22 @@ ezResult ezJSONReader::Parse(ezStreamReader& InputStream, ezUInt32 uiFirstLineOf
   {
   }
 
+  return FinishParsing();
+}
+
+ezResult ezJSONReader::Parse(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset)
+{
+  m_bParsingError = false;
+  m_Stack.Clear();
+  m_sLastName.Clear();
+
+  ParseBuffer(data, uiFirstLineOffset).IgnoreResult();
+
+  return FinishParsing();
+}
+
+ezResult ezJSONReader::FinishParsing()
+{
   if (m_bParsingError)
   {
     m_Stack.Clear();
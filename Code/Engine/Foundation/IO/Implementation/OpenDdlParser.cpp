@@ -41,7 +41,26 @@ void ezOpenDdlParser::SetInputStream(ezStreamReader& stream, ezUInt32 uiFirstLin
   EZ_ASSERT_DEV(m_StateStack.IsEmpty(), "OpenDDL Parser cannot be restarted");
 
   m_pInput = &stream;
+  m_pInputBuffer = nullptr;
+  m_pInputBufferEnd = nullptr;
+  m_InputChunk.SetCountUninitialized(s_uiInputChunkSize);
 
+  StartParsing(uiFirstLineOffset);
+}
+
+void ezOpenDdlParser::SetInputBuffer(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset /*= 0*/)
+{
+  EZ_ASSERT_DEV(m_StateStack.IsEmpty(), "OpenDDL Parser cannot be restarted");
+
+  m_pInput = nullptr;
+  m_pInputBuffer = data.GetPtr();
+  m_pInputBufferEnd = data.GetPtr() + data.GetCount();
+
+  StartParsing(uiFirstLineOffset);
+}
+
+void ezOpenDdlParser::StartParsing(ezUInt32 uiFirstLineOffset)
+{
   m_bSkippingMode = false;
   m_uiCurLine = 1 + uiFirstLineOffset;
   m_uiCurColumn = 0;
@@ -163,6 +182,11 @@ void ezOpenDdlParser::StopParsing()
 {
   m_uiCurByte = '\0';
   m_StateStack.Clear();
+
+  // ignore the rest of the input, otherwise parsing would continue after an embedded '\0'
+  m_uiNextByte = '\0';
+  m_pInput = nullptr;
+  m_pInputBuffer = m_pInputBufferEnd;
 }
 
 void ezOpenDdlParser::ParsingError(const char* szMessage, bool bFatal)
@@ -185,7 +209,20 @@ void ezOpenDdlParser::ParsingError(const char* szMessage, bool bFatal)
 
 void ezOpenDdlParser::ReadNextByte()
 {
-  m_pInput->ReadBytes(&m_uiNextByte, sizeof(ezUInt8));
+  if (m_pInputBuffer == m_pInputBufferEnd && m_pInput != nullptr)
+  {
+    const ezUInt64 uiBytesRead = m_pInput->ReadBytes(m_InputChunk.GetData(), m_InputChunk.GetCount());
+
+    m_pInputBuffer = m_InputChunk.GetData();
+    m_pInputBufferEnd = m_InputChunk.GetData() + uiBytesRead;
+  }
+
+  // like a stream, leave the byte untouched at the end of the data
+  if (m_pInputBuffer < m_pInputBufferEnd)
+  {
+    m_uiNextByte = *m_pInputBuffer;
+    ++m_pInputBuffer;
+  }
 
   if (m_uiNextByte == '\n')
   {
@@ -589,8 +626,50 @@ void ezOpenDdlParser::ReadIdentifier(ezUInt8* szString, ezUInt32& count)
   SkipWhitespace();
 }
 
+bool ezOpenDdlParser::ReadStringFromBuffer()
+{
+  // m_uiNextByte holds the first character of the string, which is the last byte that was taken from the buffer
+  if (m_pInput != nullptr || m_uiNextByte == '\0')
+    return false;
+
+  const ezUInt8* pStart = m_pInputBuffer - 1;
+  const ezUInt8* pEnd = pStart;
+
+  while (pEnd < m_pInputBufferEnd && *pEnd != '\"' && *pEnd != '\\' && *pEnd != '\0')
+    ++pEnd;
+
+  // strings with escape sequences need to be converted and a '\0' ends the document, that is done by the regular code path
+  if (pEnd == m_pInputBufferEnd || *pEnd != '\"')
+    return false;
+
+  // do the same line counting as ReadNextByte() would have done for all skipped bytes, including the closing quote
+  for (const ezUInt8* pByte = pStart + 1; pByte <= pEnd; ++pByte)
+  {
+    if (*pByte == '\n')
+    {
+      ++m_uiCurLine;
+      m_uiCurColumn = 0;
+    }
+    else
+      ++m_uiCurColumn;
+  }
+
+  m_CurrentString = ezStringView(reinterpret_cast<const char*>(pStart), reinterpret_cast<const char*>(pEnd));
+
+  // continue as if the closing quote was just read
+  m_pInputBuffer = pEnd + 1;
+  m_uiCurByte = '\"';
+  m_uiNextByte = '\0';
+  ReadNextByte();
+
+  return true;
+}
+
 void ezOpenDdlParser::ReadString()
 {
+  if (ReadStringFromBuffer())
+    return;
+
   m_uiTempStringLength = 0;
 
   while (true)
@@ -674,6 +753,7 @@ void ezOpenDdlParser::ReadString()
   }
 
   m_TempString[m_uiTempStringLength] = '\0';
+  m_CurrentString = ezStringView((const char*)&m_TempString[0], (const char*)&m_TempString[m_uiTempStringLength]);
 }
 
 void ezOpenDdlParser::ReadWord()
@@ -810,9 +890,7 @@ void ezOpenDdlParser::ContinueString()
 
       if (!m_bSkippingMode)
       {
-        ezStringView view((const char*)&m_TempString[0], (const char*)&m_TempString[m_uiTempStringLength]);
-
-        OnPrimitiveString(1, &view, false);
+        OnPrimitiveString(1, &m_CurrentString, false);
       }
 
       return;
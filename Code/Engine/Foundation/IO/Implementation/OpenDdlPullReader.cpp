@@ -0,0 +1,338 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/IO/OpenDdlPullReader.h>
+
+static ezUInt32 GetPrimitiveSize(ezOpenDdlPrimitiveType type)
+{
+  switch (type)
+  {
+    case ezOpenDdlPrimitiveType::Bool:
+      return sizeof(bool);
+    case ezOpenDdlPrimitiveType::Int8:
+      return sizeof(ezInt8);
+    case ezOpenDdlPrimitiveType::Int16:
+      return sizeof(ezInt16);
+    case ezOpenDdlPrimitiveType::Int32:
+      return sizeof(ezInt32);
+    case ezOpenDdlPrimitiveType::Int64:
+      return sizeof(ezInt64);
+    case ezOpenDdlPrimitiveType::UInt8:
+      return sizeof(ezUInt8);
+    case ezOpenDdlPrimitiveType::UInt16:
+      return sizeof(ezUInt16);
+    case ezOpenDdlPrimitiveType::UInt32:
+      return sizeof(ezUInt32);
+    case ezOpenDdlPrimitiveType::UInt64:
+      return sizeof(ezUInt64);
+    case ezOpenDdlPrimitiveType::Float:
+      return sizeof(float);
+    case ezOpenDdlPrimitiveType::Double:
+      return sizeof(double);
+    case ezOpenDdlPrimitiveType::String:
+      return sizeof(ezStringView);
+
+    default:
+      EZ_ASSERT_NOT_IMPLEMENTED;
+      return 0;
+  }
+}
+
+ezOpenDdlPullReader::ezOpenDdlPullReader() = default;
+ezOpenDdlPullReader::~ezOpenDdlPullReader() = default;
+
+void ezOpenDdlPullReader::SetInput(ezStreamReader& stream, ezUInt32 uiFirstLineOffset, ezLogInterface* pLog, ezUInt32 uiCacheSizeInKB)
+{
+  SetupInput(pLog, uiCacheSizeInKB);
+  SetInputStream(stream, uiFirstLineOffset);
+}
+
+void ezOpenDdlPullReader::SetInput(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset, ezLogInterface* pLog, ezUInt32 uiCacheSizeInKB)
+{
+  SetupInput(pLog, uiCacheSizeInKB);
+  SetInputBuffer(data, uiFirstLineOffset);
+
+  m_InputBuffer = data;
+}
+
+void ezOpenDdlPullReader::SetupInput(ezLogInterface* pLog, ezUInt32 uiCacheSizeInKB)
+{
+  SetLogInterface(pLog);
+  SetCacheSize(uiCacheSizeInKB);
+
+  m_Event = EventData();
+  m_uiNumQueuedEvents = 0;
+  m_uiNextQueuedEvent = 0;
+}
+
+ezOpenDdlPullReader::Event ezOpenDdlPullReader::Next()
+{
+  if (m_uiNextQueuedEvent >= m_uiNumQueuedEvents)
+  {
+    m_uiNumQueuedEvents = 0;
+    m_uiNextQueuedEvent = 0;
+
+    while (m_uiNumQueuedEvents == 0 && ContinueParsing())
+    {
+    }
+
+    if (m_uiNumQueuedEvents == 0)
+    {
+      m_Event = EventData();
+      return Event::EndOfDocument;
+    }
+  }
+
+  m_Event = m_QueuedEvents[m_uiNextQueuedEvent];
+  ++m_uiNextQueuedEvent;
+
+  return m_Event.m_Event;
+}
+
+void ezOpenDdlPullReader::SkipElement()
+{
+  EZ_ASSERT_DEV(m_Event.m_Event == Event::BeginObject || m_Event.m_Event == Event::BeginPrimitiveList, "SkipElement() can only be called after an element was started.");
+  EZ_ASSERT_DEBUG(m_uiNextQueuedEvent == m_uiNumQueuedEvents, "The start of an element is always the last event of a parsing step.");
+
+  SkipRestOfObject();
+}
+
+const ezOpenDdlReaderElement* ezOpenDdlPullReader::ReadElement()
+{
+  EZ_ASSERT_DEV(m_Event.m_Event == Event::BeginObject || m_Event.m_Event == Event::BeginPrimitiveList, "ReadElement() can only be called after an element was started.");
+
+  m_Elements.Clear();
+  m_ElementStack.Clear();
+  m_ElementDataOffsets.Clear();
+  m_ElementData.Clear();
+  m_ElementStrings.Clear();
+
+  AddElement(m_Event.m_PrimitiveType, m_Event.m_szType, m_Event.m_szName, m_Event.m_bGlobalName);
+
+  while (!m_ElementStack.IsEmpty())
+  {
+    switch (Next())
+    {
+      case Event::EndOfDocument:
+        return nullptr;
+
+      case Event::BeginObject:
+      case Event::BeginPrimitiveList:
+        AddElement(m_Event.m_PrimitiveType, m_Event.m_szType, m_Event.m_szName, m_Event.m_bGlobalName);
+        break;
+
+      case Event::Primitives:
+        AddElementPrimitives();
+        break;
+
+      case Event::EndObject:
+      case Event::EndPrimitiveList:
+        m_ElementStack.PopBack();
+        break;
+    }
+  }
+
+  // m_ElementData is not resized anymore, so now the primitives can be referenced
+  for (ezUInt32 i = 0; i < m_Elements.GetCount(); ++i)
+  {
+    ezOpenDdlReaderElement& element = m_Elements[i];
+
+    if (element.m_PrimitiveType != ezOpenDdlPrimitiveType::Custom && element.GetNumPrimitives() > 0)
+    {
+      element.m_pFirstChild = m_ElementData.GetData() + m_ElementDataOffsets[i];
+    }
+  }
+
+  return &m_Elements[0];
+}
+
+const char* ezOpenDdlPullReader::CopyElementString(ezStringView sString)
+{
+  if (sString.IsEmpty())
+    return nullptr;
+
+  m_ElementStrings.PushBack(sString);
+  return m_ElementStrings.PeekBack().GetData();
+}
+
+void ezOpenDdlPullReader::AddElement(ezOpenDdlPrimitiveType type, const char* szType, const char* szName, bool bGlobalName)
+{
+  ezOpenDdlReaderElement* pElement = &m_Elements.ExpandAndGetRef();
+  pElement->m_pFirstChild = nullptr;
+  pElement->m_pLastChild = nullptr;
+  pElement->m_PrimitiveType = type;
+  pElement->m_pSiblingElement = nullptr;
+  pElement->m_szCustomType = type == ezOpenDdlPrimitiveType::Custom ? CopyElementString(szType) : nullptr;
+  pElement->m_szName = CopyElementString(szName);
+  pElement->m_uiNumChildElements = bGlobalName ? EZ_BIT(31) : 0;
+
+  // the data of each primitives list is stored in one piece
+  const ezUInt32 uiDataOffset = ezMemoryUtils::AlignSize(m_ElementData.GetCount(), static_cast<ezUInt32>(sizeof(ezUInt64)));
+  m_ElementData.SetCountUninitialized(uiDataOffset);
+  m_ElementDataOffsets.PushBack(uiDataOffset);
+
+  if (!m_ElementStack.IsEmpty())
+  {
+    ezOpenDdlReaderElement* pParent = m_ElementStack.PeekBack();
+    pParent->m_uiNumChildElements++;
+
+    if (pParent->m_pFirstChild == nullptr)
+      pParent->m_pFirstChild = pElement;
+    else
+      const_cast<ezOpenDdlReaderElement*>(pParent->m_pLastChild)->m_pSiblingElement = pElement;
+
+    pParent->m_pLastChild = pElement;
+  }
+
+  m_ElementStack.PushBack(pElement);
+}
+
+void ezOpenDdlPullReader::AddElementPrimitives()
+{
+  ezOpenDdlReaderElement* pElement = m_ElementStack.PeekBack();
+  pElement->m_uiNumChildElements += m_Event.m_uiNumPrimitives;
+
+  const ezUInt32 uiOffset = m_ElementData.GetCount();
+  const ezUInt32 uiBytes = m_Event.m_uiNumPrimitives * GetPrimitiveSize(m_Event.m_PrimitiveType);
+  m_ElementData.SetCountUninitialized(uiOffset + uiBytes);
+
+  if (m_Event.m_PrimitiveType != ezOpenDdlPrimitiveType::String)
+  {
+    ezMemoryUtils::Copy(m_ElementData.GetData() + uiOffset, static_cast<const ezUInt8*>(m_Event.m_pPrimitives), uiBytes);
+    return;
+  }
+
+  const ezStringView* pSource = static_cast<const ezStringView*>(m_Event.m_pPrimitives);
+  ezStringView* pTarget = reinterpret_cast<ezStringView*>(m_ElementData.GetData() + uiOffset);
+
+  const char* pBufferStart = reinterpret_cast<const char*>(m_InputBuffer.GetPtr());
+  const char* pBufferEnd = pBufferStart + m_InputBuffer.GetCount();
+
+  for (ezUInt32 i = 0; i < m_Event.m_uiNumPrimitives; ++i)
+  {
+    // strings in the input buffer stay valid, everything else is only temporary
+    if (pSource[i].GetStartPointer() >= pBufferStart && pSource[i].GetEndPointer() <= pBufferEnd)
+    {
+      pTarget[i] = pSource[i];
+    }
+    else
+    {
+      const char* szCopy = CopyElementString(pSource[i]);
+      pTarget[i] = ezStringView(szCopy, szCopy + pSource[i].GetElementCount());
+    }
+  }
+}
+
+ezOpenDdlPullReader::EventData& ezOpenDdlPullReader::AddEvent(Event event)
+{
+  EZ_ASSERT_DEBUG(m_uiNumQueuedEvents < EZ_ARRAY_SIZE(m_QueuedEvents), "Too many events in one parsing step.");
+
+  EventData& data = m_QueuedEvents[m_uiNumQueuedEvents];
+  ++m_uiNumQueuedEvents;
+
+  data = EventData();
+  data.m_Event = event;
+  data.m_PrimitiveType = m_CurrentPrimitiveType;
+  return data;
+}
+
+void ezOpenDdlPullReader::AddPrimitives(ezUInt32 count, const void* pData)
+{
+  EventData& data = AddEvent(Event::Primitives);
+  data.m_uiNumPrimitives = count;
+  data.m_pPrimitives = pData;
+}
+
+void ezOpenDdlPullReader::OnBeginObject(const char* szType, const char* szName, bool bGlobalName)
+{
+  m_CurrentPrimitiveType = ezOpenDdlPrimitiveType::Custom;
+
+  EventData& data = AddEvent(Event::BeginObject);
+  data.m_szType = szType;
+  data.m_szName = szName;
+  data.m_bGlobalName = bGlobalName;
+}
+
+void ezOpenDdlPullReader::OnEndObject()
+{
+  m_CurrentPrimitiveType = ezOpenDdlPrimitiveType::Custom;
+
+  AddEvent(Event::EndObject);
+}
+
+void ezOpenDdlPullReader::OnBeginPrimitiveList(ezOpenDdlPrimitiveType type, const char* szName, bool bGlobalName)
+{
+  m_CurrentPrimitiveType = type;
+
+  EventData& data = AddEvent(Event::BeginPrimitiveList);
+  data.m_szName = szName;
+  data.m_bGlobalName = bGlobalName;
+}
+
+void ezOpenDdlPullReader::OnEndPrimitiveList()
+{
+  AddEvent(Event::EndPrimitiveList);
+
+  m_CurrentPrimitiveType = ezOpenDdlPrimitiveType::Custom;
+}
+
+void ezOpenDdlPullReader::OnPrimitiveBool(ezUInt32 count, const bool* pData, bool bThisIsAll)
+{
+  AddPrimitives(count, pData);
+}
+
+void ezOpenDdlPullReader::OnPrimitiveInt8(ezUInt32 count, const ezInt8* pData, bool bThisIsAll)
+{
+  AddPrimitives(count, pData);
+}
+
+void ezOpenDdlPullReader::OnPrimitiveInt16(ezUInt32 count, const ezInt16* pData, bool bThisIsAll)
+{
+  AddPrimitives(count, pData);
+}
+
+void ezOpenDdlPullReader::OnPrimitiveInt32(ezUInt32 count, const ezInt32* pData, bool bThisIsAll)
+{
+  AddPrimitives(count, pData);
+}
+
+void ezOpenDdlPullReader::OnPrimitiveInt64(ezUInt32 count, const ezInt64* pData, bool bThisIsAll)
+{
+  AddPrimitives(count, pData);
+}
+
+void ezOpenDdlPullReader::OnPrimitiveUInt8(ezUInt32 count, const ezUInt8* pData, bool bThisIsAll)
+{
+  AddPrimitives(count, pData);
+}
+
+void ezOpenDdlPullReader::OnPrimitiveUInt16(ezUInt32 count, const ezUInt16* pData, bool bThisIsAll)
+{
+  AddPrimitives(count, pData);
+}
+
+void ezOpenDdlPullReader::OnPrimitiveUInt32(ezUInt32 count, const ezUInt32* pData, bool bThisIsAll)
+{
+  AddPrimitives(count, pData);
+}
+
+void ezOpenDdlPullReader::OnPrimitiveUInt64(ezUInt32 count, const ezUInt64* pData, bool bThisIsAll)
+{
+  AddPrimitives(count, pData);
+}
+
+void ezOpenDdlPullReader::OnPrimitiveFloat(ezUInt32 count, const float* pData, bool bThisIsAll)
+{
+  AddPrimitives(count, pData);
+}
+
+void ezOpenDdlPullReader::OnPrimitiveDouble(ezUInt32 count, const double* pData, bool bThisIsAll)
+{
+  AddPrimitives(count, pData);
+}
+
+void ezOpenDdlPullReader::OnPrimitiveString(ezUInt32 count, const ezStringView* pData, bool bThisIsAll)
+{
+  AddPrimitives(count, pData);
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_IO_Implementation_OpenDdlPullReader);
@@ -21,6 +21,26 @@ ezResult ezOpenDdlReader::ParseDocument(ezStreamReader& stream, ezUInt32 uiFirst
   SetCacheSize(uiCacheSizeInKB);
   SetInputStream(stream, uiFirstLineOffset);
 
+  StartDocument();
+
+  return ParseAll();
+}
+
+ezResult ezOpenDdlReader::ParseDocument(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset, ezLogInterface* pLog, ezUInt32 uiCacheSizeInKB)
+{
+  EZ_ASSERT_DEBUG(m_ObjectStack.IsEmpty(), "A reader can only be used once.");
+
+  SetLogInterface(pLog);
+  SetCacheSize(uiCacheSizeInKB);
+  SetInputBuffer(data, uiFirstLineOffset);
+
+  StartDocument();
+
+  return ParseAll();
+}
+
+void ezOpenDdlReader::StartDocument()
+{
   m_TempCache.Reserve(s_uiChunkSize);
 
   ezOpenDdlReaderElement* pElement = &m_Elements.ExpandAndGetRef();
@@ -33,8 +53,6 @@ ezResult ezOpenDdlReader::ParseDocument(ezStreamReader& stream, ezUInt32 uiFirst
   pElement->m_uiNumChildElements = 0;
 
   m_ObjectStack.PushBack(pElement);
-
-  return ParseAll();
 }
 
 const ezOpenDdlReaderElement* ezOpenDdlReader::GetRootElement() const
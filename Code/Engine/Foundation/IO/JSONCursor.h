@@ -0,0 +1,152 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Strings/String.h>
+#include <Foundation/Strings/StringView.h>
+#include <Foundation/Types/ArrayPtr.h>
+
+/// \brief A fast JSON reader that reads a document from memory on demand, without building any in-memory representation of it.
+///
+/// SetInput() scans the entire document once (using SIMD instructions, where available) and records the position of every structural
+/// character ({ } [ ] : ,), every string and every other value in an index. Afterwards the document is read by moving a cursor over
+/// this index. Values that are not of interest are skipped with SkipValue(), which only has to look at the index.
+///
+/// Strings without escape sequences are returned as views into the input data. Strings with escape sequences are decoded into an
+/// internal buffer. Such a key stays valid until the next key with escape sequences is read, such a value until the next value with
+/// escape sequences is read.
+///
+/// Just like ezJSONParser, the reader accepts comments and superfluous commas. All other errors are fatal. They are logged, HadError()
+/// returns true and all further read functions fail.
+///
+/// Usage:
+///   ezJSONCursor json;
+///   if (json.SetInput(data).Failed())
+///     return EZ_FAILURE;
+///
+///   json.BeginObject();
+///
+///   ezStringView sKey;
+///   while (json.NextMember(sKey))
+///   {
+///     if (sKey == "scale")
+///       json.ReadDouble(fScale);
+///     else
+///       json.SkipValue();
+///   }
+///
+///   return json.HadError() ? EZ_FAILURE : EZ_SUCCESS;
+class EZ_FOUNDATION_DLL ezJSONCursor
+{
+public:
+  enum class ValueType : ezUInt8
+  {
+    Invalid, ///< There is no value at the cursor position, e.g. because the end of an object or the document was reached.
+    Object,
+    Array,
+    String,
+    Number,
+    Bool,
+    Null,
+  };
+
+  ezJSONCursor();
+  ~ezJSONCursor();
+
+  /// \brief Indexes the given document and places the cursor at its top-level value.
+  ///
+  /// The data must stay valid while the document is read. Unless the document contains comments, in which case a copy without the
+  /// comments is read instead.
+  ezResult SetInput(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset = 0, ezLogInterface* pLog = ezLog::GetThreadLocalLogSystem());
+
+  /// \brief Returns the type of the value at the cursor position.
+  ValueType GetValueType() const;
+
+  /// \brief Returns true once the cursor has reached the end of the document.
+  bool IsAtEnd() const { return GetCurrentChar() == '\0'; }
+
+  /// \brief Returns whether a fatal error occurred. All read functions fail from then on.
+  bool HadError() const { return m_bHadError; }
+
+  /// \brief Enters the object at the cursor position. Afterwards, call NextMember() until it returns false.
+  bool BeginObject();
+
+  /// \brief Reads the key of the next member of the current object and moves the cursor to its value.
+  ///
+  /// The value must be read or skipped before NextMember() is called again.
+  /// Returns false and moves the cursor behind the object, once the end of the object is reached (or an error occurred).
+  bool NextMember(ezStringView& out_sKey);
+
+  /// \brief Enters the array at the cursor position. Afterwards, call NextElement() until it returns false.
+  bool BeginArray();
+
+  /// \brief Moves the cursor to the next element of the current array.
+  ///
+  /// The element must be read or skipped before NextElement() is called again.
+  /// Returns false and moves the cursor behind the array, once the end of the array is reached (or an error occurred).
+  bool NextElement();
+
+  /// \brief Reads the string at the cursor position.
+  ezResult ReadString(ezStringView& out_sValue);
+
+  /// \brief Reads the number at the cursor position.
+  ezResult ReadDouble(double& out_fValue);
+
+  /// \brief Reads the 'true' or 'false' at the cursor position.
+  ezResult ReadBool(bool& out_bValue);
+
+  /// \brief Reads the 'null' at the cursor position.
+  ezResult ReadNull();
+
+  /// \brief Skips the value at the cursor position, including all its children.
+  ///
+  /// Skipped objects and arrays are only checked for properly nested brackets, their content is not validated.
+  void SkipValue();
+
+  /// \brief Returns the line and column of the last fatal error.
+  void GetErrorPosition(ezUInt32& out_uiLine, ezUInt32& out_uiColumn) const;
+
+  /// \brief Returns the message of the last fatal error.
+  const char* GetErrorMessage() const { return m_sErrorMessage; }
+
+private:
+  EZ_ALWAYS_INLINE ezUInt8 GetChar(ezUInt32 uiIndex) const
+  {
+    const ezUInt32 uiPos = m_Indices[uiIndex];
+    return uiPos < m_Data.GetCount() ? m_Data[uiPos] : '\0';
+  }
+
+  EZ_ALWAYS_INLINE ezUInt8 GetCurrentChar() const { return GetChar(m_uiCurrent); }
+
+  bool BuildIndex(ezArrayPtr<const ezUInt8> data);
+  void RemoveComments(ezArrayPtr<const ezUInt8> data);
+  ezResult ReadStringAt(ezUInt32 uiIndex, ezDynamicArray<char>& ref_decoded, ezStringView& out_sValue);
+  ezStringView GetScalarToken() const;
+  void Error(const char* szMessage);
+
+  struct RemovedComment
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiPosition;         ///< Where the comment was removed in m_DataWithoutComments
+    ezUInt32 m_uiOriginalPosition; ///< Where the data after the comment starts in m_OriginalData
+  };
+
+  ezArrayPtr<const ezUInt8> m_Data;
+  ezArrayPtr<const ezUInt8> m_OriginalData;
+  ezDynamicArray<ezUInt8> m_DataWithoutComments;
+  ezDynamicArray<RemovedComment> m_RemovedComments;
+  ezDynamicArray<ezUInt32> m_Indices; ///< Byte offsets of all structural characters, strings and scalars, plus the end of the data
+  ezUInt32 m_uiCurrent = 0;
+
+  ezDynamicArray<char> m_DecodedKey;
+  ezDynamicArray<char> m_DecodedValue;
+
+  bool m_bHadError = false;
+  bool m_bContainsComments = false;
+  ezUInt32 m_uiFirstLineOffset = 0;
+  ezUInt32 m_uiErrorPosition = 0;
+  ezString m_sErrorMessage;
+  ezLogInterface* m_pLog = nullptr;
+};
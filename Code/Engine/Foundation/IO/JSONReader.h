@@ -19,6 +19,9 @@ public:
   /// error occurred.
   ezResult Parse(ezStreamReader& pInput, ezUInt32 uiFirstLineOffset = 0);
 
+  /// \brief Same as above, but parses the document directly from memory, which is considerably faster. See ezJSONParser::ParseBuffer().
+  ezResult Parse(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset = 0);
+
   /// \brief Returns the top-level object of the JSON document.
   const ezVariantDictionary& GetTopLevelObject() const { return m_Stack.PeekBack().m_Dictionary; }
 
@@ -52,6 +55,8 @@ private:
 
   virtual void OnParsingError(const char* szMessage, bool bFatal, ezUInt32 uiLine, ezUInt32 uiColumn) override;
 
+  ezResult FinishParsing();
+
 protected:
   enum class ElementMode : ezInt8
   {
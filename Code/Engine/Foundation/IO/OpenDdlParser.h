@@ -52,8 +52,17 @@ protected:
   void SetCacheSize(ezUInt32 uiSizeInKB);
 
   /// \brief Configures the parser to read from the given stream. This can only be called once on a parser instance.
+  ///
+  /// The stream is read in chunks of 4 KB, so the parser may read past the end of the document.
   void SetInputStream(ezStreamReader& stream, ezUInt32 uiFirstLineOffset = 0); // [tested]
 
+  /// \brief Configures the parser to read directly from memory, e.g. from an ezMemoryMappedFile. This can only be called once on a parser
+  /// instance.
+  ///
+  /// The data must stay valid and unmodified until parsing is finished. Strings that contain no escape sequences are reported through
+  /// OnPrimitiveString() as views into this buffer, so they are never copied. These views stay valid as long as the buffer does.
+  void SetInputBuffer(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset = 0);
+
   /// \brief Call this to parse the next piece of the document. This may trigger a callback through which data is returned.
   ///
   /// This function returns false when the end of the document has been reached, or a fatal parsing error has been reported.
@@ -160,6 +169,7 @@ private:
     State m_State;
   };
 
+  void StartParsing(ezUInt32 uiFirstLineOffset);
   void ReadNextByte();
   bool ReadCharacter();
   bool ReadCharacterSkipComments();
@@ -167,6 +177,7 @@ private:
   void ContinueIdle();
   void ReadIdentifier(ezUInt8* szString, ezUInt32& count);
   void ReadString();
+  bool ReadStringFromBuffer();
   void ReadWord();
   ezUInt64 ReadDecimalLiteral();
   void PurgeCachedPrimitives(bool bThisIsAll);
@@ -182,8 +193,12 @@ private:
 
   ezHybridArray<DdlState, 32> m_StateStack;
   ezStreamReader* m_pInput;
+  const ezUInt8* m_pInputBuffer;        ///< The next byte to read, either in the input data or in m_InputChunk
+  const ezUInt8* m_pInputBufferEnd;     ///< The end of the input data or of the valid bytes in m_InputChunk
+  ezDynamicArray<ezUInt8> m_InputChunk; ///< Only used with an input stream, which is read in chunks instead of byte by byte
   ezDynamicArray<ezUInt8> m_Cache;
 
+  static const ezUInt32 s_uiInputChunkSize = 4096;
   static const ezUInt32 s_uiMaxIdentifierLength = 64;
 
   ezUInt8 m_uiCurByte;
@@ -196,6 +211,7 @@ private:
   ezUInt8 m_szIdentifierName[s_uiMaxIdentifierLength];
   ezDynamicArray<ezUInt8> m_TempString;
   ezUInt32 m_uiTempStringLength;
+  ezStringView m_CurrentString; ///< The last string read by ReadString(), either in m_TempString or in the input buffer
 
   ezUInt32 m_uiNumCachedPrimitives;
   bool* m_pBoolCache;
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <Foundation/Containers/Deque.h>
+#include <Foundation/IO/OpenDdlParser.h>
+#include <Foundation/IO/OpenDdlReader.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Types/ArrayPtr.h>
+
+/// \brief Reads an OpenDDL document piece by piece, without building an in-memory representation of the whole document.
+///
+/// Call Next() in a loop to step through the document. Each call returns the next event, e.g. the start of an object or a chunk of
+/// primitive values. The data of an event (names and primitives) is only valid until the next call to Next().
+///
+/// When reading from a buffer (e.g. from an ezMemoryMappedFile), strings that contain no escape sequences point directly into that
+/// buffer, so they stay valid as long as the buffer does.
+///
+/// Elements that are not of interest can be skipped with SkipElement(). Small elements that are easier to handle as a whole (e.g. a
+/// 'Vec3' that should be passed to ezOpenDdlUtils) can be read with ReadElement().
+///
+/// Usage:
+///   ezOpenDdlPullReader reader;
+///   reader.SetInput(data);
+///
+///   while (true)
+///   {
+///     switch (reader.Next())
+///     {
+///       case ezOpenDdlPullReader::Event::BeginObject: ...
+///       case ezOpenDdlPullReader::Event::Primitives: ...
+///       case ezOpenDdlPullReader::Event::EndOfDocument: return reader.HadFatalParsingError() ? EZ_FAILURE : EZ_SUCCESS;
+///     }
+///   }
+class EZ_FOUNDATION_DLL ezOpenDdlPullReader : public ezOpenDdlParser
+{
+public:
+  enum class Event : ezUInt8
+  {
+    EndOfDocument,      ///< The end of the document was reached or a fatal parsing error occurred.
+    BeginObject,        ///< A custom object starts. GetCustomType(), GetName() and IsNameGlobal() are valid.
+    EndObject,          ///< The last open custom object was closed.
+    BeginPrimitiveList, ///< A primitives list starts. GetPrimitivesType(), GetName() and IsNameGlobal() are valid.
+    Primitives,         ///< Some or all values of the current primitives list are available through GetPrimitivesXYZ().
+    EndPrimitiveList,   ///< The current primitives list was closed.
+  };
+
+  ezOpenDdlPullReader();
+  ~ezOpenDdlPullReader();
+
+  /// \brief Configures the reader to read the document from a stream. This can only be called once on a reader instance.
+  void SetInput(ezStreamReader& stream, ezUInt32 uiFirstLineOffset = 0, ezLogInterface* pLog = ezLog::GetThreadLocalLogSystem(),
+    ezUInt32 uiCacheSizeInKB = 4);
+
+  /// \brief Configures the reader to read the document directly from memory. This can only be called once on a reader instance.
+  ///
+  /// The data must stay valid while the document is read.
+  void SetInput(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset = 0, ezLogInterface* pLog = ezLog::GetThreadLocalLogSystem(),
+    ezUInt32 uiCacheSizeInKB = 4);
+
+  /// \brief Parses the document up to the next event and returns it.
+  Event Next();
+
+  /// \brief Returns the event that was returned by the last call to Next().
+  EZ_ALWAYS_INLINE Event GetEvent() const { return m_Event.m_Event; }
+
+  /// \brief The type name of the custom object that was just started.
+  EZ_ALWAYS_INLINE const char* GetCustomType() const { return m_Event.m_szType; }
+
+  /// \brief Whether the object or primitives list that was just started has a name.
+  EZ_ALWAYS_INLINE bool HasName() const { return !ezStringUtils::IsNullOrEmpty(m_Event.m_szName); }
+
+  /// \brief The name of the object or primitives list that was just started.
+  EZ_ALWAYS_INLINE const char* GetName() const { return m_Event.m_szName; }
+
+  /// \brief Whether the name of the object or primitives list that was just started is a global or a local name.
+  EZ_ALWAYS_INLINE bool IsNameGlobal() const { return m_Event.m_bGlobalName; }
+
+  /// \brief The type of the primitives list that is currently being read.
+  EZ_ALWAYS_INLINE ezOpenDdlPrimitiveType GetPrimitivesType() const { return m_Event.m_PrimitiveType; }
+
+  /// \brief Returns the values of a Primitives event. Only valid if GetPrimitivesType() returns the requested type.
+  EZ_ALWAYS_INLINE ezArrayPtr<const bool> GetPrimitivesBool() const { return GetPrimitives<bool>(ezOpenDdlPrimitiveType::Bool); }
+  EZ_ALWAYS_INLINE ezArrayPtr<const ezInt8> GetPrimitivesInt8() const { return GetPrimitives<ezInt8>(ezOpenDdlPrimitiveType::Int8); }
+  EZ_ALWAYS_INLINE ezArrayPtr<const ezInt16> GetPrimitivesInt16() const { return GetPrimitives<ezInt16>(ezOpenDdlPrimitiveType::Int16); }
+  EZ_ALWAYS_INLINE ezArrayPtr<const ezInt32> GetPrimitivesInt32() const { return GetPrimitives<ezInt32>(ezOpenDdlPrimitiveType::Int32); }
+  EZ_ALWAYS_INLINE ezArrayPtr<const ezInt64> GetPrimitivesInt64() const { return GetPrimitives<ezInt64>(ezOpenDdlPrimitiveType::Int64); }
+  EZ_ALWAYS_INLINE ezArrayPtr<const ezUInt8> GetPrimitivesUInt8() const { return GetPrimitives<ezUInt8>(ezOpenDdlPrimitiveType::UInt8); }
+  EZ_ALWAYS_INLINE ezArrayPtr<const ezUInt16> GetPrimitivesUInt16() const { return GetPrimitives<ezUInt16>(ezOpenDdlPrimitiveType::UInt16); }
+  EZ_ALWAYS_INLINE ezArrayPtr<const ezUInt32> GetPrimitivesUInt32() const { return GetPrimitives<ezUInt32>(ezOpenDdlPrimitiveType::UInt32); }
+  EZ_ALWAYS_INLINE ezArrayPtr<const ezUInt64> GetPrimitivesUInt64() const { return GetPrimitives<ezUInt64>(ezOpenDdlPrimitiveType::UInt64); }
+  EZ_ALWAYS_INLINE ezArrayPtr<const float> GetPrimitivesFloat() const { return GetPrimitives<float>(ezOpenDdlPrimitiveType::Float); }
+  EZ_ALWAYS_INLINE ezArrayPtr<const double> GetPrimitivesDouble() const { return GetPrimitives<double>(ezOpenDdlPrimitiveType::Double); }
+  EZ_ALWAYS_INLINE ezArrayPtr<const ezStringView> GetPrimitivesString() const
+  {
+    return GetPrimitives<ezStringView>(ezOpenDdlPrimitiveType::String);
+  }
+
+  /// \brief Skips the object or primitives list that was just started, including all its children. No events are returned for it.
+  void SkipElement();
+
+  /// \brief Reads the object or primitives list that was just started, including all its children, into an ezOpenDdlReaderElement.
+  ///
+  /// This allows to use functions such as ezOpenDdlUtils::ConvertToVariant() on parts of the document. Next() continues after the
+  /// end of the element. The returned element stays valid until ReadElement() is called again.
+  /// Returns nullptr if a fatal parsing error occurred.
+  const ezOpenDdlReaderElement* ReadElement();
+
+protected:
+  virtual void OnBeginObject(const char* szType, const char* szName, bool bGlobalName) override;
+  virtual void OnEndObject() override;
+
+  virtual void OnBeginPrimitiveList(ezOpenDdlPrimitiveType type, const char* szName, bool bGlobalName) override;
+  virtual void OnEndPrimitiveList() override;
+
+  virtual void OnPrimitiveBool(ezUInt32 count, const bool* pData, bool bThisIsAll) override;
+
+  virtual void OnPrimitiveInt8(ezUInt32 count, const ezInt8* pData, bool bThisIsAll) override;
+  virtual void OnPrimitiveInt16(ezUInt32 count, const ezInt16* pData, bool bThisIsAll) override;
+  virtual void OnPrimitiveInt32(ezUInt32 count, const ezInt32* pData, bool bThisIsAll) override;
+  virtual void OnPrimitiveInt64(ezUInt32 count, const ezInt64* pData, bool bThisIsAll) override;
+
+  virtual void OnPrimitiveUInt8(ezUInt32 count, const ezUInt8* pData, bool bThisIsAll) override;
+  virtual void OnPrimitiveUInt16(ezUInt32 count, const ezUInt16* pData, bool bThisIsAll) override;
+  virtual void OnPrimitiveUInt32(ezUInt32 count, const ezUInt32* pData, bool bThisIsAll) override;
+  virtual void OnPrimitiveUInt64(ezUInt32 count, const ezUInt64* pData, bool bThisIsAll) override;
+
+  virtual void OnPrimitiveFloat(ezUInt32 count, const float* pData, bool bThisIsAll) override;
+  virtual void OnPrimitiveDouble(ezUInt32 count, const double* pData, bool bThisIsAll) override;
+
+  virtual void OnPrimitiveString(ezUInt32 count, const ezStringView* pData, bool bThisIsAll) override;
+
+private:
+  struct EventData
+  {
+    Event m_Event = Event::EndOfDocument;
+    ezOpenDdlPrimitiveType m_PrimitiveType = ezOpenDdlPrimitiveType::Custom;
+    bool m_bGlobalName = false;
+    const char* m_szType = nullptr;
+    const char* m_szName = nullptr;
+    ezUInt32 m_uiNumPrimitives = 0;
+    const void* m_pPrimitives = nullptr;
+  };
+
+  template <typename T>
+  ezArrayPtr<const T> GetPrimitives(ezOpenDdlPrimitiveType type) const
+  {
+    EZ_ASSERT_DEBUG(m_Event.m_Event == Event::Primitives && m_Event.m_PrimitiveType == type, "Primitives of the requested type are not available.");
+    EZ_IGNORE_UNUSED(type);
+    return ezArrayPtr<const T>(static_cast<const T*>(m_Event.m_pPrimitives), m_Event.m_uiNumPrimitives);
+  }
+
+  void SetupInput(ezLogInterface* pLog, ezUInt32 uiCacheSizeInKB);
+  EventData& AddEvent(Event event);
+  void AddPrimitives(ezUInt32 count, const void* pData);
+
+  const char* CopyElementString(ezStringView sString);
+  void AddElement(ezOpenDdlPrimitiveType type, const char* szType, const char* szName, bool bGlobalName);
+  void AddElementPrimitives();
+
+  // One call to ContinueParsing() reports at most two events (the last primitives and the end of the list)
+  EventData m_Event;
+  EventData m_QueuedEvents[2];
+  ezUInt32 m_uiNumQueuedEvents = 0;
+  ezUInt32 m_uiNextQueuedEvent = 0;
+  ezOpenDdlPrimitiveType m_CurrentPrimitiveType = ezOpenDdlPrimitiveType::Custom;
+
+  // Storage for ReadElement()
+  ezArrayPtr<const ezUInt8> m_InputBuffer;
+  ezDeque<ezOpenDdlReaderElement> m_Elements;
+  ezHybridArray<ezOpenDdlReaderElement*, 16> m_ElementStack;
+  ezDynamicArray<ezUInt32> m_ElementDataOffsets; ///< The offset into m_ElementData for each element in m_Elements
+  ezDynamicArray<ezUInt8> m_ElementData;
+  ezDeque<ezString> m_ElementStrings;
+};
@@ -103,6 +103,7 @@ public:
 
 private:
   friend class ezOpenDdlReader;
+  friend class ezOpenDdlPullReader;
 
   ezOpenDdlPrimitiveType m_PrimitiveType;
   ezUInt32 m_uiNumChildElements;
@@ -130,6 +131,12 @@ public:
   ezResult ParseDocument(ezStreamReader& stream, ezUInt32 uiFirstLineOffset = 0, ezLogInterface* pLog = ezLog::GetThreadLocalLogSystem(),
     ezUInt32 uiCacheSizeInKB = 4); // [tested]
 
+  /// \brief Same as the stream version, but parses the document directly from memory, e.g. from an ezMemoryMappedFile.
+  ///
+  /// The data only needs to stay valid during this call, all strings are copied into the document.
+  ezResult ParseDocument(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset = 0, ezLogInterface* pLog = ezLog::GetThreadLocalLogSystem(),
+    ezUInt32 uiCacheSizeInKB = 4);
+
   /// \brief Every document has exactly one root element.
   const ezOpenDdlReaderElement* GetRootElement() const; // [tested]
 
@@ -163,6 +170,7 @@ protected:
   virtual void OnParsingError(const char* szMessage, bool bFatal, ezUInt32 uiLine, ezUInt32 uiColumn) override;
 
 protected:
+  void StartDocument();
   ezOpenDdlReaderElement* CreateElement(ezOpenDdlPrimitiveType type, const char* szType, const char* szName, bool bGlobalName);
   const char* CopyString(const ezStringView& string);
   void StorePrimitiveData(bool bThisIsAll, ezUInt32 bytecount, const ezUInt8* pData);
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Time/Timestamp.h>
+
+namespace ezLogWriter
+{
+  /// \brief A log writer that writes log messages into a compact binary file, which can be converted to text with ezBinaryLogReader.
+  ///
+  /// Instead of the formatted text, messages that were logged through ezLog::Info() etc. are stored as the ID of their format string and
+  /// the texts of their arguments. Every string (format strings, tags, log block names) is only written once, the first time it is used,
+  /// and is referenced through its ID afterwards. Additionally the thread, a timestamp and the log block nesting of every message are stored.
+  /// Messages that were logged as plain text are deduplicated as well, but only the first 1024 different ones per log, so that the string
+  /// table doesn't grow for the whole session. All further texts are written out every time.
+  ///
+  /// The file is append-only, so that a crash only loses what is still in the write cache. The cache is flushed on errors, serious
+  /// warnings and ezLog::Flush(), just as for the HTML writer.
+  ///
+  /// Create an instance of this class, register the LogMessageHandler at ezGlobalLog and pass the pointer to the instance as the
+  /// pPassThrough argument to it. Use the BinaryLogDecoder tool to convert the file to text or HTML.
+  class EZ_FOUNDATION_DLL Binary
+  {
+  public:
+    ~Binary();
+
+    /// \brief Register this at ezGlobalLog to write all log messages to a binary log file.
+    void LogMessageHandler(const ezLoggingEventData& eventData);
+
+    /// \brief Opens the given file for writing the log. From now on all incoming log messages are written into it.
+    void BeginLog(const char* szFile);
+
+    /// \brief Writes the log into the given stream, e.g. to send it over the network. The stream has to stay valid until EndLog() is called.
+    void BeginLog(ezStreamWriter& ref_stream);
+
+    /// \brief Closes the log file and stops logging the incoming messages.
+    void EndLog();
+
+    /// \brief Returns the name of the log-file that was really opened. Might be slightly different than what was given to BeginLog, to
+    /// allow parallel execution of the same application.
+    const ezFileWriter& GetOpenedLogFile() const;
+
+  private:
+    void WriteHeader();
+    /// \brief Returns ezInvalidIndex if bPlainText is set and no more plain texts are deduplicated.
+    ezUInt32 GetStringID(ezStringView sString, bool bPlainText = false);
+    ezUInt32 GetThreadIndex();
+
+    ezFileWriter m_File;
+    ezStreamWriter* m_pStream = nullptr;
+
+    ezTime m_StartTime;
+    ezInt64 m_iLastTime = 0;
+
+    ezHashTable<ezUInt64, ezUInt32> m_StringIDs; ///< Maps the hash of a string to its ID
+    ezDynamicArray<ezString> m_Strings;           ///< The string of ID i is at index i - 1, to detect hash collisions
+    ezUInt32 m_uiNumPlainTextIDs = 0;
+    ezHashTable<ezUInt64, ezUInt32> m_ThreadIndices;
+
+    ezDynamicArray<ezUInt8> m_Record;
+    ezStringBuilder m_sArguments;
+  };
+} // namespace ezLogWriter
+
+/// \brief Reads log files that were written with ezLogWriter::Binary and reconstructs the log messages.
+class EZ_FOUNDATION_DLL ezBinaryLogReader
+{
+public:
+  /// \brief A single log event as it was written by ezLogWriter::Binary.
+  struct Entry
+  {
+    ezLogMsgType::Enum m_EventType = ezLogMsgType::None;
+    ezUInt8 m_uiIndentation = 0;
+
+    /// \brief Threads are numbered in the order in which they first logged something, starting at 1.
+    ezUInt32 m_uiThreadIndex = 0;
+    ezUInt64 m_uiThreadId = 0;
+
+    ezTimestamp m_Timestamp;
+
+    /// \brief The formatted text, without the tag.
+    ezStringBuilder m_sText;
+    ezStringBuilder m_sTag;
+
+    /// \brief The duration of a log block, only set for ezLogMsgType::EndGroup.
+    double m_fSeconds = 0;
+
+    /// \brief Fills out the event data, such that the entry can be passed to other log writers, e.g. ezLogWriter::HTML.
+    void GetEventData(ezLoggingEventData& out_eventData) const;
+  };
+
+  /// \brief Reads the header of the log. Fails if the stream doesn't contain a binary log with a supported version.
+  ezResult Open(ezStreamReader& ref_stream);
+
+  /// \brief Reads the next log event. Returns false at the end of the log, or if the remaining data is incomplete or corrupted.
+  ///
+  /// Log files of applications that crashed may end with an incomplete entry, which is ignored.
+  bool ReadEntry(Entry& out_entry);
+
+  /// \brief Returns the time at which the log was started.
+  ezTimestamp GetStartTime() const { return m_StartTime; }
+
+private:
+  ezStreamReader* m_pStream = nullptr;
+  ezTimestamp m_StartTime;
+  ezInt64 m_iTime = 0;
+
+  ezDynamicArray<ezString> m_Strings;
+  ezDynamicArray<ezUInt64> m_ThreadIds;
+};
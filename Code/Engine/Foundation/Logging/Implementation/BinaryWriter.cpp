@@ -0,0 +1,485 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Algorithm/HashingUtils.h>
+#include <Foundation/Logging/BinaryWriter.h>
+#include <Foundation/Threading/ThreadUtils.h>
+
+namespace
+{
+  constexpr ezUInt8 BINARY_LOG_VERSION = 2;
+
+  // marks messages that are stored as plain text and must not be formatted again
+  constexpr ezUInt8 PLAIN_TEXT = 0xFF;
+
+  // marks plain text messages whose text directly follows, instead of being referenced through a string ID (version 2)
+  constexpr ezUInt8 PLAIN_TEXT_INLINE = 0xFE;
+
+  // Plain texts often contain varying data, e.g. file names or numbers, so only this many of them are deduplicated per log.
+  // This keeps the string table from growing for the whole session.
+  constexpr ezUInt32 MAX_PLAIN_TEXT_IDS = 1024;
+
+  enum class RecordType : ezUInt8
+  {
+    String = 1,
+    Thread = 2,
+    Message = 3,
+  };
+
+  void WriteVarUInt(ezDynamicArray<ezUInt8>& ref_data, ezUInt64 uiValue)
+  {
+    while (uiValue >= 0x80)
+    {
+      ref_data.PushBack(static_cast<ezUInt8>(uiValue) | 0x80);
+      uiValue >>= 7;
+    }
+
+    ref_data.PushBack(static_cast<ezUInt8>(uiValue));
+  }
+
+  void WriteVarInt(ezDynamicArray<ezUInt8>& ref_data, ezInt64 iValue)
+  {
+    WriteVarUInt(ref_data, (static_cast<ezUInt64>(iValue) << 1) ^ static_cast<ezUInt64>(iValue >> 63));
+  }
+
+  void WriteString(ezDynamicArray<ezUInt8>& ref_data, ezStringView sString)
+  {
+    WriteVarUInt(ref_data, sString.GetElementCount());
+    ref_data.PushBackRange(ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(sString.GetStartPointer()), sString.GetElementCount()));
+  }
+
+  ezResult ReadVarUInt(ezStreamReader& ref_stream, ezUInt64& out_uiValue)
+  {
+    out_uiValue = 0;
+
+    for (ezUInt32 uiShift = 0; uiShift < 64; uiShift += 7)
+    {
+      ezUInt8 uiByte = 0;
+      if (ref_stream.ReadBytes(&uiByte, 1) != 1)
+        return EZ_FAILURE;
+
+      out_uiValue |= static_cast<ezUInt64>(uiByte & 0x7F) << uiShift;
+
+      if ((uiByte & 0x80) == 0)
+        return EZ_SUCCESS;
+    }
+
+    return EZ_FAILURE;
+  }
+
+  ezResult ReadVarInt(ezStreamReader& ref_stream, ezInt64& out_iValue)
+  {
+    ezUInt64 uiValue = 0;
+    EZ_SUCCEED_OR_RETURN(ReadVarUInt(ref_stream, uiValue));
+
+    out_iValue = static_cast<ezInt64>(uiValue >> 1) ^ -static_cast<ezInt64>(uiValue & 1);
+    return EZ_SUCCESS;
+  }
+
+  ezResult ReadString(ezStreamReader& ref_stream, ezStringBuilder& out_sString)
+  {
+    ezUInt64 uiLength = 0;
+    EZ_SUCCEED_OR_RETURN(ReadVarUInt(ref_stream, uiLength));
+
+    // protect against corrupted data
+    if (uiLength > 64 * 1024 * 1024)
+      return EZ_FAILURE;
+
+    ezHybridArray<char, 256> buffer;
+    buffer.SetCountUninitialized(static_cast<ezUInt32>(uiLength) + 1);
+
+    if (ref_stream.ReadBytes(buffer.GetData(), uiLength) != uiLength)
+      return EZ_FAILURE;
+
+    buffer[static_cast<ezUInt32>(uiLength)] = '\0';
+    out_sString = buffer.GetData();
+    return EZ_SUCCESS;
+  }
+} // namespace
+
+ezLogWriter::Binary::~Binary()
+{
+  EndLog();
+}
+
+void ezLogWriter::Binary::BeginLog(const char* szFile)
+{
+  const ezUInt32 uiLogCache = 1024 * 64;
+
+  if (m_File.Open(szFile, uiLogCache, ezFileShareMode::SharedReads) == EZ_FAILURE)
+  {
+    for (ezUInt32 i = 1; i < 32; ++i)
+    {
+      const ezStringBuilder sName = ezPathUtils::GetFileName(szFile);
+
+      ezStringBuilder sNewName;
+      sNewName.Format("{0}_{1}", sName, i);
+
+      ezStringBuilder sPath = szFile;
+      sPath.ChangeFileName(sNewName.GetData());
+
+      if (m_File.Open(sPath.GetData(), uiLogCache) == EZ_SUCCESS)
+        break;
+    }
+  }
+
+  if (!m_File.IsOpen())
+  {
+    ezLog::Error("Could not open Log-File \"{0}\".", szFile);
+    return;
+  }
+
+  m_pStream = &m_File;
+  WriteHeader();
+}
+
+void ezLogWriter::Binary::BeginLog(ezStreamWriter& ref_stream)
+{
+  m_pStream = &ref_stream;
+  WriteHeader();
+}
+
+void ezLogWriter::Binary::EndLog()
+{
+  if (m_pStream == nullptr)
+    return;
+
+  m_pStream->Flush().IgnoreResult();
+  m_pStream = nullptr;
+
+  m_StringIDs.Clear();
+  m_Strings.Clear();
+  m_ThreadIndices.Clear();
+  m_uiNumPlainTextIDs = 0;
+
+  if (m_File.IsOpen())
+  {
+    m_File.Close();
+  }
+}
+
+const ezFileWriter& ezLogWriter::Binary::GetOpenedLogFile() const
+{
+  return m_File;
+}
+
+void ezLogWriter::Binary::WriteHeader()
+{
+  m_StringIDs.Clear();
+  m_Strings.Clear();
+  m_ThreadIndices.Clear();
+  m_uiNumPlainTextIDs = 0;
+
+  m_StartTime = ezTime::Now();
+  m_iLastTime = 0;
+
+  m_Record.Clear();
+
+  const char szMagic[4] = {'E', 'Z', 'B', 'L'};
+  m_Record.PushBackRange(ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(szMagic), 4));
+  m_Record.PushBack(BINARY_LOG_VERSION);
+  WriteVarInt(m_Record, ezTimestamp::CurrentTimestamp().GetInt64(ezSIUnitOfTime::Microsecond));
+
+  m_pStream->WriteBytes(m_Record.GetData(), m_Record.GetCount()).IgnoreResult();
+}
+
+ezUInt32 ezLogWriter::Binary::GetStringID(ezStringView sString, bool bPlainText)
+{
+  // ID 0 is the empty string
+  if (sString.IsEmpty())
+    return 0;
+
+  const ezUInt64 uiHash = ezHashingUtils::xxHash64(sString.GetStartPointer(), sString.GetElementCount());
+
+  ezUInt32 uiID = 0;
+  const bool bKnownHash = m_StringIDs.TryGetValue(uiHash, uiID);
+
+  if (bKnownHash && m_Strings[uiID - 1] == sString)
+    return uiID;
+
+  // a different string with the same hash is not deduplicated, it gets a new ID every time
+  if (bPlainText)
+  {
+    if (bKnownHash || m_uiNumPlainTextIDs >= MAX_PLAIN_TEXT_IDS)
+      return ezInvalidIndex;
+
+    ++m_uiNumPlainTextIDs;
+  }
+
+  m_Strings.PushBack(sString);
+  uiID = m_Strings.GetCount();
+
+  if (!bKnownHash)
+  {
+    m_StringIDs.Insert(uiHash, uiID);
+  }
+
+  // strings are defined right before the first record that uses them, so the file can be read front to back
+  m_Record.PushBack(static_cast<ezUInt8>(RecordType::String));
+  WriteVarUInt(m_Record, uiID);
+  WriteString(m_Record, sString);
+
+  return uiID;
+}
+
+ezUInt32 ezLogWriter::Binary::GetThreadIndex()
+{
+  const ezUInt64 uiThreadId = (ezUInt64)ezThreadUtils::GetCurrentThreadID();
+
+  ezUInt32 uiIndex = 0;
+  if (m_ThreadIndices.TryGetValue(uiThreadId, uiIndex))
+    return uiIndex;
+
+  uiIndex = m_ThreadIndices.GetCount() + 1;
+  m_ThreadIndices.Insert(uiThreadId, uiIndex);
+
+  m_Record.PushBack(static_cast<ezUInt8>(RecordType::Thread));
+  WriteVarUInt(m_Record, uiIndex);
+  WriteVarUInt(m_Record, uiThreadId);
+
+  return uiIndex;
+}
+
+void ezLogWriter::Binary::LogMessageHandler(const ezLoggingEventData& eventData)
+{
+  if (m_pStream == nullptr)
+    return;
+
+  if (eventData.m_EventType == ezLogMsgType::Flush)
+  {
+    m_pStream->Flush().IgnoreResult();
+    return;
+  }
+
+  m_Record.Clear();
+
+  ezUInt32 uiArgumentEnds[10];
+  ezInt32 iNumArguments = -1;
+
+  if (eventData.m_pFormatString != nullptr)
+  {
+    iNumArguments = eventData.m_pFormatString->GetArguments(m_sArguments, uiArgumentEnds);
+  }
+
+  // messages that don't come from a format string are stored as they are, the text is deduplicated as well, up to a limit
+  const ezStringView sText = iNumArguments >= 0 ? ezStringView(eventData.m_pFormatString->GetFormat()) : ezStringView(eventData.m_szText);
+  const ezUInt32 uiTextID = GetStringID(sText, iNumArguments < 0);
+  const bool bInlineText = uiTextID == ezInvalidIndex;
+
+  const ezUInt32 uiTagID = GetStringID(eventData.m_szTag);
+  const ezUInt32 uiThreadIndex = GetThreadIndex();
+
+  const ezInt64 iTime = static_cast<ezInt64>((ezTime::Now() - m_StartTime).GetNanoseconds());
+
+  m_Record.PushBack(static_cast<ezUInt8>(RecordType::Message));
+  m_Record.PushBack(static_cast<ezUInt8>(eventData.m_EventType));
+  m_Record.PushBack(eventData.m_uiIndentation);
+  WriteVarUInt(m_Record, uiThreadIndex);
+  WriteVarInt(m_Record, iTime - m_iLastTime);
+  WriteVarUInt(m_Record, bInlineText ? 0 : uiTextID);
+  WriteVarUInt(m_Record, uiTagID);
+
+  m_iLastTime = iTime;
+
+  if (bInlineText)
+  {
+    m_Record.PushBack(PLAIN_TEXT_INLINE);
+    WriteString(m_Record, sText);
+  }
+  else if (iNumArguments < 0)
+  {
+    m_Record.PushBack(PLAIN_TEXT);
+  }
+  else
+  {
+    m_Record.PushBack(static_cast<ezUInt8>(iNumArguments));
+
+    ezUInt32 uiStart = 0;
+    for (ezInt32 i = 0; i < iNumArguments; ++i)
+    {
+      WriteString(m_Record, ezStringView(m_sArguments.GetData() + uiStart, m_sArguments.GetData() + uiArgumentEnds[i]));
+      uiStart = uiArgumentEnds[i];
+    }
+  }
+
+  if (eventData.m_EventType == ezLogMsgType::EndGroup)
+  {
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+    WriteVarUInt(m_Record, static_cast<ezUInt64>(ezMath::Max(eventData.m_fSeconds, 0.0) * 1000000000.0));
+#else
+    WriteVarUInt(m_Record, 0);
+#endif
+  }
+
+  m_pStream->WriteBytes(m_Record.GetData(), m_Record.GetCount()).IgnoreResult();
+
+  if (eventData.m_EventType == ezLogMsgType::ErrorMsg || eventData.m_EventType == ezLogMsgType::SeriousWarningMsg)
+  {
+    m_pStream->Flush().IgnoreResult();
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezResult ezBinaryLogReader::Open(ezStreamReader& ref_stream)
+{
+  m_pStream = &ref_stream;
+  m_iTime = 0;
+  m_Strings.Clear();
+  m_ThreadIds.Clear();
+
+  // index 0 is the empty string
+  m_Strings.PushBack(ezString());
+
+  char szMagic[4] = {};
+  ezUInt8 uiVersion = 0;
+
+  if (ref_stream.ReadBytes(szMagic, 4) != 4 || ref_stream.ReadBytes(&uiVersion, 1) != 1)
+    return EZ_FAILURE;
+
+  if (szMagic[0] != 'E' || szMagic[1] != 'Z' || szMagic[2] != 'B' || szMagic[3] != 'L' || uiVersion == 0 || uiVersion > BINARY_LOG_VERSION)
+    return EZ_FAILURE;
+
+  ezInt64 iStartTime = 0;
+  EZ_SUCCEED_OR_RETURN(ReadVarInt(ref_stream, iStartTime));
+
+  m_StartTime = ezTimestamp(iStartTime, ezSIUnitOfTime::Microsecond);
+  return EZ_SUCCESS;
+}
+
+bool ezBinaryLogReader::ReadEntry(Entry& out_entry)
+{
+  if (m_pStream == nullptr)
+    return false;
+
+  ezStreamReader& stream = *m_pStream;
+  ezStringBuilder sString;
+
+  while (true)
+  {
+    ezUInt8 uiRecord = 0;
+    if (stream.ReadBytes(&uiRecord, 1) != 1)
+      return false;
+
+    switch (static_cast<RecordType>(uiRecord))
+    {
+      case RecordType::String:
+      {
+        ezUInt64 uiID = 0;
+        if (ReadVarUInt(stream, uiID).Failed() || ReadString(stream, sString).Failed() || uiID != m_Strings.GetCount())
+          return false;
+
+        m_Strings.PushBack(sString);
+      }
+      break;
+
+      case RecordType::Thread:
+      {
+        ezUInt64 uiIndex = 0, uiThreadId = 0;
+        if (ReadVarUInt(stream, uiIndex).Failed() || ReadVarUInt(stream, uiThreadId).Failed() || uiIndex != m_ThreadIds.GetCount() + 1)
+          return false;
+
+        m_ThreadIds.PushBack(uiThreadId);
+      }
+      break;
+
+      case RecordType::Message:
+      {
+        ezUInt8 uiType = 0, uiIndentation = 0, uiNumArguments = 0;
+        ezUInt64 uiThreadIndex = 0, uiTextID = 0, uiTagID = 0;
+        ezInt64 iTimeDelta = 0;
+
+        if (stream.ReadBytes(&uiType, 1) != 1 || stream.ReadBytes(&uiIndentation, 1) != 1)
+          return false;
+
+        if (ReadVarUInt(stream, uiThreadIndex).Failed() || ReadVarInt(stream, iTimeDelta).Failed() || ReadVarUInt(stream, uiTextID).Failed() ||
+            ReadVarUInt(stream, uiTagID).Failed() || stream.ReadBytes(&uiNumArguments, 1) != 1)
+          return false;
+
+        if (uiThreadIndex == 0 || uiThreadIndex > m_ThreadIds.GetCount() || uiTextID >= m_Strings.GetCount() || uiTagID >= m_Strings.GetCount())
+          return false;
+
+        m_iTime += iTimeDelta;
+
+        out_entry.m_EventType = static_cast<ezLogMsgType::Enum>(static_cast<ezInt8>(uiType));
+        out_entry.m_uiIndentation = uiIndentation;
+        out_entry.m_uiThreadIndex = static_cast<ezUInt32>(uiThreadIndex);
+        out_entry.m_uiThreadId = m_ThreadIds[static_cast<ezUInt32>(uiThreadIndex - 1)];
+        out_entry.m_Timestamp = m_StartTime + ezTime::Nanoseconds(static_cast<double>(m_iTime));
+        out_entry.m_sTag = m_Strings[static_cast<ezUInt32>(uiTagID)];
+        out_entry.m_fSeconds = 0;
+
+        const ezString& sText = m_Strings[static_cast<ezUInt32>(uiTextID)];
+
+        if (uiNumArguments == PLAIN_TEXT)
+        {
+          out_entry.m_sText = sText;
+        }
+        else if (uiNumArguments == PLAIN_TEXT_INLINE)
+        {
+          if (ReadString(stream, out_entry.m_sText).Failed())
+            return false;
+        }
+        else
+        {
+          if (uiNumArguments > 10)
+            return false;
+
+          ezStringBuilder args[10];
+          for (ezUInt32 i = 0; i < uiNumArguments; ++i)
+          {
+            if (ReadString(stream, args[i]).Failed())
+              return false;
+          }
+
+          ezStringView a[10];
+          for (ezUInt32 i = 0; i < 10; ++i)
+          {
+            a[i] = args[i];
+          }
+
+          out_entry.m_sText.Format(sText.GetData(), a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7], a[8], a[9]);
+
+          // the format string includes the tag, but the text of a log message doesn't, see ezLog::BroadcastLoggingEvent()
+          if (!out_entry.m_sTag.IsEmpty() && out_entry.m_sText.StartsWith("["))
+          {
+            const char* szTagEnd = out_entry.m_sText.FindSubString("]");
+
+            if (szTagEnd != nullptr)
+            {
+              sString = szTagEnd + 1;
+              out_entry.m_sText = sString;
+            }
+          }
+        }
+
+        if (out_entry.m_EventType == ezLogMsgType::EndGroup)
+        {
+          ezUInt64 uiDuration = 0;
+          if (ReadVarUInt(stream, uiDuration).Failed())
+            return false;
+
+          out_entry.m_fSeconds = static_cast<double>(uiDuration) / 1000000000.0;
+        }
+
+        return true;
+      }
+
+      default:
+        return false;
+    }
+  }
+}
+
+void ezBinaryLogReader::Entry::GetEventData(ezLoggingEventData& out_eventData) const
+{
+  out_eventData.m_EventType = m_EventType;
+  out_eventData.m_uiIndentation = m_uiIndentation;
+  out_eventData.m_szText = m_sText;
+  out_eventData.m_szTag = m_sTag;
+  out_eventData.m_pFormatString = nullptr;
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  out_eventData.m_fSeconds = m_fSeconds;
+#endif
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Logging_Implementation_BinaryWriter);
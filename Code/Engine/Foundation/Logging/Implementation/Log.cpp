@@ -1,10 +1,14 @@
 #include <FoundationPCH.h>
 
+#include <Foundation/Configuration/Startup.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Strings/StringBuilder.h>
 #include <Foundation/Strings/StringConversion.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Threading/ThreadSignal.h>
 #include <Foundation/Time/Time.h>
 #include <Foundation/Time/Timestamp.h>
+#include <Foundation/Types/ScopeExit.h>
 
 #if EZ_ENABLED(EZ_PLATFORM_WINDOWS)
 #  include <Foundation/Logging/Implementation/Win/ETWProvider_win.h>
@@ -23,6 +27,245 @@ static ezMutex s_OverrideLogMutex;
 /// \brief The log system that messages are sent to when the user specifies no system himself.
 static thread_local ezLogInterface* s_DefaultLogSystem = nullptr;
 
+// clang-format off
+EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, Log)
+
+  // no dependencies
+
+  ON_CORESYSTEMS_SHUTDOWN
+  {
+    ezGlobalLog::DisableAsyncMode();
+  }
+
+EZ_END_SUBSYSTEM_DECLARATION;
+// clang-format on
+
+/// \brief Queues log messages in asynchronous mode and passes them to the log writers on a dedicated thread.
+///
+/// The queue is a bounded multi-producer queue, where each slot carries a sequence number that tells producers and the consumer
+/// whether the slot is free or filled. Only one thread drains the queue at a time, which is either the writer thread or a thread that
+/// logs an error.
+class ezAsyncLogWriter : public ezThread
+{
+public:
+  enum
+  {
+    SLOT_SIZE = 512,
+    TAG_SIZE = 32,
+  };
+
+  struct Slot
+  {
+    ezAtomicInteger64 m_iSequence;
+    ezLogMsgType::Enum m_EventType;
+    ezUInt8 m_uiIndentation;
+    bool m_bHasText;
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+    double m_fSeconds;
+#endif
+    char m_szTag[TAG_SIZE];
+    char m_szText[SLOT_SIZE - TAG_SIZE - 32];
+  };
+
+  enum class EnqueueResult
+  {
+    Queued,
+    Full,
+    TooLong,
+  };
+
+  ezAsyncLogWriter(ezUInt32 uiQueueCapacity, ezTime flushInterval)
+    : ezThread("Log Writer")
+    , m_FlushInterval(flushInterval)
+  {
+    m_uiCapacity = ezMath::PowerOfTwo_Ceil(ezMath::Max(uiQueueCapacity, 2u));
+    m_Slots = EZ_DEFAULT_NEW_ARRAY(Slot, m_uiCapacity);
+
+    for (ezUInt32 i = 0; i < m_uiCapacity; ++i)
+    {
+      m_Slots[i].m_iSequence = i;
+    }
+  }
+
+  ~ezAsyncLogWriter() { EZ_DEFAULT_DELETE_ARRAY(m_Slots); }
+
+  void Stop()
+  {
+    m_bStop = true;
+    m_WakeUp.RaiseSignal();
+    Join();
+
+    Drain();
+  }
+
+  EnqueueResult Enqueue(const ezLoggingEventData& le)
+  {
+    const ezUInt32 uiTextLength = le.m_szText != nullptr ? ezStringUtils::GetStringElementCount(le.m_szText) : 0;
+    if (uiTextLength >= EZ_ARRAY_SIZE(Slot::m_szText))
+      return EnqueueResult::TooLong;
+
+    ezInt64 iPos = m_iEnqueuePos;
+    Slot* pSlot = nullptr;
+
+    while (true)
+    {
+      pSlot = &m_Slots[iPos & (m_uiCapacity - 1)];
+      const ezInt64 iDiff = pSlot->m_iSequence - iPos;
+
+      if (iDiff == 0)
+      {
+        // the slot is free, try to claim it
+        if (m_iEnqueuePos.TestAndSet(iPos, iPos + 1))
+          break;
+      }
+      else if (iDiff < 0)
+      {
+        // the slot still holds a message from the previous round, so the queue is full
+        m_WakeUp.RaiseSignal();
+        return EnqueueResult::Full;
+      }
+
+      iPos = m_iEnqueuePos;
+    }
+
+    pSlot->m_EventType = le.m_EventType;
+    pSlot->m_uiIndentation = le.m_uiIndentation;
+    pSlot->m_bHasText = le.m_szText != nullptr;
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+    pSlot->m_fSeconds = le.m_fSeconds;
+#endif
+    ezStringUtils::Copy(pSlot->m_szTag, TAG_SIZE, le.m_szTag);
+    ezMemoryUtils::Copy(pSlot->m_szText, le.m_szText != nullptr ? le.m_szText : "", uiTextLength + 1);
+
+    // publish the message
+    pSlot->m_iSequence = iPos + 1;
+
+    // wake up the writer thread early when the queue fills up, otherwise it only writes once per flush interval
+    if (iPos - m_iDequeuePos == m_uiCapacity / 2)
+    {
+      m_WakeUp.RaiseSignal();
+    }
+
+    return EnqueueResult::Queued;
+  }
+
+  /// \brief Passes all queued messages to the log writers, followed by the given message and a flush, if requested.
+  ///
+  /// Everything that reaches the log writers in asynchronous mode is broadcast from here while m_DrainMutex is held. Thus m_DrainMutex is
+  /// always locked before the mutex of the logging event, never the other way round, which could deadlock.
+  void Drain(const ezLoggingEventData* pMessage = nullptr, bool bFlush = false)
+  {
+    EZ_LOCK(m_DrainMutex);
+
+    // log writers that log something themselves must not recursively drain the queue
+    const bool bWasDraining = s_bIsDraining;
+    s_bIsDraining = true;
+    EZ_SCOPE_EXIT(s_bIsDraining = bWasDraining);
+
+    while (true)
+    {
+      const ezInt64 iPos = m_iDequeuePos;
+      Slot& slot = m_Slots[iPos & (m_uiCapacity - 1)];
+
+      if (slot.m_iSequence != iPos + 1)
+        break;
+
+      ezLoggingEventData le;
+      le.m_EventType = slot.m_EventType;
+      le.m_uiIndentation = slot.m_uiIndentation;
+      le.m_szText = slot.m_bHasText ? slot.m_szText : nullptr;
+      le.m_szTag = slot.m_szTag;
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+      le.m_fSeconds = slot.m_fSeconds;
+#endif
+
+      ezGlobalLog::s_LoggingEvent.Broadcast(le);
+
+      // hand the slot back to the producers for the next round
+      slot.m_iSequence = iPos + m_uiCapacity;
+      m_iDequeuePos = iPos + 1;
+    }
+
+    const ezInt64 iDropped = m_iDroppedMessages;
+    if (iDropped != m_iReportedDroppedMessages)
+    {
+      ezStringBuilder sText;
+      sText.Format("{0} log messages were dropped, because the asynchronous log queue was full", iDropped - m_iReportedDroppedMessages);
+      m_iReportedDroppedMessages = iDropped;
+
+      ezLoggingEventData le;
+      le.m_EventType = ezLogMsgType::WarningMsg;
+      le.m_szText = sText;
+
+      ezGlobalLog::s_uiMessageCount[ezLogMsgType::WarningMsg].Increment();
+      ezGlobalLog::s_LoggingEvent.Broadcast(le);
+    }
+
+    if (pMessage != nullptr)
+    {
+      ezGlobalLog::s_LoggingEvent.Broadcast(*pMessage);
+    }
+
+    if (bFlush)
+    {
+      ezLoggingEventData flush;
+      flush.m_EventType = ezLogMsgType::Flush;
+      flush.m_szText = nullptr;
+      ezGlobalLog::s_LoggingEvent.Broadcast(flush);
+    }
+  }
+
+  void IncrementDroppedMessages() { m_iDroppedMessages.Increment(); }
+  ezUInt64 GetDroppedMessages() const { return static_cast<ezUInt64>(m_iDroppedMessages); }
+
+  static bool IsDraining() { return s_bIsDraining; }
+
+private:
+  virtual ezUInt32 Run() override
+  {
+    while (!m_bStop)
+    {
+      m_WakeUp.WaitForSignal(m_FlushInterval);
+
+      Drain();
+    }
+
+    return 0;
+  }
+
+  static thread_local bool s_bIsDraining;
+
+  ezArrayPtr<Slot> m_Slots;
+  ezUInt32 m_uiCapacity = 0;
+  ezTime m_FlushInterval;
+
+  ezAtomicInteger64 m_iEnqueuePos;
+  ezAtomicInteger64 m_iDequeuePos;
+  ezAtomicInteger64 m_iDroppedMessages;
+  ezInt64 m_iReportedDroppedMessages = 0;
+
+  ezMutex m_DrainMutex;
+  ezThreadSignal m_WakeUp;
+  volatile bool m_bStop = false;
+};
+
+thread_local bool ezAsyncLogWriter::s_bIsDraining = false;
+
+namespace
+{
+  ezMutex s_AsyncLogMutex;
+  ezAsyncLogWriter* s_pAsyncLogWriter = nullptr;
+  ezUInt64 s_uiDroppedMessagesOfPreviousWriters = 0;
+
+  // counts the threads that currently access s_pAsyncLogWriter without holding s_AsyncLogMutex
+  ezAtomicInteger32 s_iAsyncLogProducers;
+
+  ezAsyncLogWriter* GetAsyncLogWriter()
+  {
+    return static_cast<ezAsyncLogWriter*>(ezAtomicUtils::ReadPointer(reinterpret_cast<void* const*>(&s_pAsyncLogWriter)));
+  }
+} // namespace
+
 
 ezEventSubscriptionID ezGlobalLog::AddLogWriter(ezLoggingEvent::Handler handler)
 {
@@ -76,10 +319,95 @@ void ezGlobalLog::HandleLogMessage(const ezLoggingEventData& le)
     if ((ThisType > ezLogMsgType::None) && (ThisType < ezLogMsgType::All))
       s_uiMessageCount[ThisType].Increment();
 
+    // messages logged by the log writers themselves are written directly, to prevent recursions
+    if (GetAsyncLogWriter() != nullptr && !ezAsyncLogWriter::IsDraining())
+    {
+      s_iAsyncLogProducers.Increment();
+
+      // the writer may have been removed in the meantime, but it can't be deleted while this thread is registered as a producer
+      if (ezAsyncLogWriter* pWriter = GetAsyncLogWriter())
+      {
+        const bool bSynchronous = (ThisType == ezLogMsgType::ErrorMsg || ThisType == ezLogMsgType::SeriousWarningMsg);
+        const ezAsyncLogWriter::EnqueueResult result = bSynchronous ? ezAsyncLogWriter::EnqueueResult::TooLong : pWriter->Enqueue(le);
+
+        if (result == ezAsyncLogWriter::EnqueueResult::Full && ThisType > ezLogMsgType::WarningMsg)
+        {
+          pWriter->IncrementDroppedMessages();
+        }
+        else if (result != ezAsyncLogWriter::EnqueueResult::Queued)
+        {
+          // keep the order of messages by writing everything that was queued before
+          pWriter->Drain(&le, bSynchronous);
+        }
+
+        s_iAsyncLogProducers.Decrement();
+        return;
+      }
+
+      s_iAsyncLogProducers.Decrement();
+    }
+
     s_LoggingEvent.Broadcast(le);
   }
 }
 
+void ezGlobalLog::EnableAsyncMode(ezUInt32 uiQueueCapacity, ezTime flushInterval)
+{
+  EZ_LOCK(s_AsyncLogMutex);
+
+  if (s_pAsyncLogWriter != nullptr)
+    return;
+
+  ezAsyncLogWriter* pWriter = EZ_DEFAULT_NEW(ezAsyncLogWriter, uiQueueCapacity, flushInterval);
+  pWriter->Start();
+
+  ezAtomicUtils::WritePointer(reinterpret_cast<void**>(&s_pAsyncLogWriter), pWriter);
+}
+
+void ezGlobalLog::DisableAsyncMode()
+{
+  EZ_LOCK(s_AsyncLogMutex);
+
+  ezAsyncLogWriter* pWriter = s_pAsyncLogWriter;
+  if (pWriter == nullptr)
+    return;
+
+  ezAtomicUtils::WritePointer(reinterpret_cast<void**>(&s_pAsyncLogWriter), nullptr);
+
+  // wait for threads that are still in the process of queuing a message
+  while (s_iAsyncLogProducers > 0)
+  {
+    ezThreadUtils::YieldTimeSlice();
+  }
+
+  pWriter->Stop();
+  s_uiDroppedMessagesOfPreviousWriters += pWriter->GetDroppedMessages();
+
+  EZ_DEFAULT_DELETE(pWriter);
+}
+
+bool ezGlobalLog::IsAsyncModeEnabled()
+{
+  return GetAsyncLogWriter() != nullptr;
+}
+
+void ezGlobalLog::FlushAsyncMessages()
+{
+  EZ_LOCK(s_AsyncLogMutex);
+
+  if (s_pAsyncLogWriter != nullptr)
+  {
+    s_pAsyncLogWriter->Drain();
+  }
+}
+
+ezUInt64 ezGlobalLog::GetDroppedMessageCount()
+{
+  EZ_LOCK(s_AsyncLogMutex);
+
+  return s_uiDroppedMessagesOfPreviousWriters + (s_pAsyncLogWriter != nullptr ? s_pAsyncLogWriter->GetDroppedMessages() : 0);
+}
+
 ezLogBlock::ezLogBlock(const char* szName, const char* szContextInfo)
 {
   m_pLogInterface = ezLog::GetThreadLocalLogSystem();
@@ -173,7 +501,7 @@ void ezLog::WriteBlockHeader(ezLogInterface* pInterface, ezLogBlock* pBlock)
   pInterface->HandleLogMessage(le);
 }
 
-void ezLog::BroadcastLoggingEvent(ezLogInterface* pInterface, ezLogMsgType::Enum type, const char* szString)
+void ezLog::BroadcastLoggingEvent(ezLogInterface* pInterface, ezLogMsgType::Enum type, const char* szString, const ezFormatString* pFormatString)
 {
   ezLogBlock* pTopBlock = pInterface->m_pCurrentBlock;
   ezUInt8 uiIndentation = 0;
@@ -211,6 +539,7 @@ void ezLog::BroadcastLoggingEvent(ezLogInterface* pInterface, ezLogMsgType::Enum
   le.m_szText = szString;
   le.m_uiIndentation = uiIndentation;
   le.m_szTag = szTag;
+  le.m_pFormatString = pFormatString;
 
   pInterface->HandleLogMessage(le);
   pInterface->m_uiLoggedMsgsSinceFlush++;
@@ -306,7 +635,7 @@ void ezLog::Error(ezLogInterface* pInterface, const ezFormatString& string)
     return;
 
   ezStringBuilder tmp;
-  BroadcastLoggingEvent(pInterface, ezLogMsgType::ErrorMsg, string.GetText(tmp));
+  BroadcastLoggingEvent(pInterface, ezLogMsgType::ErrorMsg, string.GetText(tmp), &string);
 }
 
 void ezLog::SeriousWarning(ezLogInterface* pInterface, const ezFormatString& string)
@@ -315,7 +644,7 @@ void ezLog::SeriousWarning(ezLogInterface* pInterface, const ezFormatString& str
     return;
 
   ezStringBuilder tmp;
-  BroadcastLoggingEvent(pInterface, ezLogMsgType::SeriousWarningMsg, string.GetText(tmp));
+  BroadcastLoggingEvent(pInterface, ezLogMsgType::SeriousWarningMsg, string.GetText(tmp), &string);
 }
 
 void ezLog::Warning(ezLogInterface* pInterface, const ezFormatString& string)
@@ -324,7 +653,7 @@ void ezLog::Warning(ezLogInterface* pInterface, const ezFormatString& string)
     return;
 
   ezStringBuilder tmp;
-  BroadcastLoggingEvent(pInterface, ezLogMsgType::WarningMsg, string.GetText(tmp));
+  BroadcastLoggingEvent(pInterface, ezLogMsgType::WarningMsg, string.GetText(tmp), &string);
 }
 
 void ezLog::Success(ezLogInterface* pInterface, const ezFormatString& string)
@@ -333,7 +662,7 @@ void ezLog::Success(ezLogInterface* pInterface, const ezFormatString& string)
     return;
 
   ezStringBuilder tmp;
-  BroadcastLoggingEvent(pInterface, ezLogMsgType::SuccessMsg, string.GetText(tmp));
+  BroadcastLoggingEvent(pInterface, ezLogMsgType::SuccessMsg, string.GetText(tmp), &string);
 }
 
 void ezLog::Info(ezLogInterface* pInterface, const ezFormatString& string)
@@ -342,7 +671,7 @@ void ezLog::Info(ezLogInterface* pInterface, const ezFormatString& string)
     return;
 
   ezStringBuilder tmp;
-  BroadcastLoggingEvent(pInterface, ezLogMsgType::InfoMsg, string.GetText(tmp));
+  BroadcastLoggingEvent(pInterface, ezLogMsgType::InfoMsg, string.GetText(tmp), &string);
 }
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
@@ -353,7 +682,7 @@ void ezLog::Dev(ezLogInterface* pInterface, const ezFormatString& string)
     return;
 
   ezStringBuilder tmp;
-  BroadcastLoggingEvent(pInterface, ezLogMsgType::DevMsg, string.GetText(tmp));
+  BroadcastLoggingEvent(pInterface, ezLogMsgType::DevMsg, string.GetText(tmp), &string);
 }
 
 #endif
@@ -366,7 +695,7 @@ void ezLog::Debug(ezLogInterface* pInterface, const ezFormatString& string)
     return;
 
   ezStringBuilder tmp;
-  BroadcastLoggingEvent(pInterface, ezLogMsgType::DebugMsg, string.GetText(tmp));
+  BroadcastLoggingEvent(pInterface, ezLogMsgType::DebugMsg, string.GetText(tmp), &string);
 }
 
 #endif
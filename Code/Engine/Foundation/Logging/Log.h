@@ -59,6 +59,12 @@ struct EZ_FOUNDATION_DLL ezLoggingEventData
   /// additional configuration, or simply be ignored.
   const char* m_szTag = "";
 
+  /// \brief The format string and arguments that m_szText was generated from, if the message was logged through ezLog::Info() etc.
+  ///
+  /// Log writers can use this to store the format and the arguments instead of the full text, see ezLogWriter::Binary.
+  /// The format string includes the tag. This is nullptr for all other events and when messages are written asynchronously.
+  const ezFormatString* m_pFormatString = nullptr;
+
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
   /// \brief Used by log-blocks for profiling the duration of the block
   double m_fSeconds = 0;
@@ -132,6 +138,33 @@ public:
   /// override is set at the moment.
   static void SetGlobalLogOverride(ezLogInterface* pInterface);
 
+  /// \brief Switches all ezGlobalLog instances to asynchronous mode, in which log writers are called on a dedicated thread.
+  ///
+  /// In asynchronous mode messages are copied into a lock-free queue and the thread that logged them continues immediately. A writer
+  /// thread passes the queued messages to the log writers in batches, every \a flushInterval or earlier when the queue fills up.
+  /// Errors and serious warnings are still written synchronously: the queue is drained first, so that the order of messages is kept, and
+  /// afterwards the log writers are told to flush, such that nothing is lost, if the error is followed by a crash.
+  /// Messages that are too long for a queue slot are written synchronously as well.
+  ///
+  /// If the queue is full, warnings and more severe messages are written synchronously, all other messages are dropped.
+  /// The number of dropped messages is reported through the log and can be queried with GetDroppedMessageCount().
+  ///
+  /// Log writers must be thread-safe when asynchronous mode is used, as they are called from different threads.
+  /// Asynchronous mode is disabled automatically when the core systems are shut down.
+  static void EnableAsyncMode(ezUInt32 uiQueueCapacity = 1024, ezTime flushInterval = ezTime::Milliseconds(50));
+
+  /// \brief Writes all queued messages and switches back to synchronous logging.
+  static void DisableAsyncMode();
+
+  /// \brief Returns whether asynchronous mode is currently enabled.
+  static bool IsAsyncModeEnabled();
+
+  /// \brief Blocks until all messages that are queued in asynchronous mode have been passed to the log writers.
+  static void FlushAsyncMessages();
+
+  /// \brief Returns how many messages were dropped in asynchronous mode, because the queue was full.
+  static ezUInt64 GetDroppedMessageCount();
+
 private:
   /// \brief Counts the number of messages of each type.
   static ezAtomicInteger32 s_uiMessageCount[ezLogMsgType::ENUM_COUNT];
@@ -145,6 +178,7 @@ private:
   EZ_DISALLOW_COPY_AND_ASSIGN(ezGlobalLog);
 
   friend class ezLog; // only ezLog may create instances of this class
+  friend class ezAsyncLogWriter;
   ezGlobalLog() = default;
 };
 
@@ -320,8 +354,9 @@ public:
     ezUInt32 uiNumNewMsgThreshold = 0, ezTime timeIntervalThreshold = ezTime::Seconds(10), ezLogInterface* pInterface = GetThreadLocalLogSystem());
 
   /// \brief Usually called internally by the other log functions, but can be called directly, if the message type is already known.
-  /// pInterface must be != nullptr.
-  static void BroadcastLoggingEvent(ezLogInterface* pInterface, ezLogMsgType::Enum type, const char* szString);
+  /// pInterface must be != nullptr. pFormatString is optional and is passed on to the log writers in ezLoggingEventData::m_pFormatString.
+  static void BroadcastLoggingEvent(
+    ezLogInterface* pInterface, ezLogMsgType::Enum type, const char* szString, const ezFormatString* pFormatString = nullptr);
 
   /// \brief Calls low-level OS functionality to print a string to the typical outputs, e.g. printf and OutputDebugString.
   ///
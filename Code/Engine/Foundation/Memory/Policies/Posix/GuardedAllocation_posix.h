@@ -1,13 +1,99 @@
+#include <Foundation/FoundationInternal.h>
+EZ_FOUNDATION_INTERNAL_HEADER
+
+#include <errno.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 namespace ezMemoryPolicies
 {
-  ezGuardedAllocation::ezGuardedAllocation(ezAllocatorBase* pParent) { EZ_ASSERT_NOT_IMPLEMENTED; }
+  struct AlloctionMetaData
+  {
+    AlloctionMetaData()
+    {
+      m_uiSize = 0;
+
+      for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(m_magic); ++i)
+      {
+        m_magic[i] = 0x12345678;
+      }
+    }
+
+    ~AlloctionMetaData()
+    {
+      for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(m_magic); ++i)
+      {
+        EZ_ASSERT_DEV(m_magic[i] == 0x12345678, "Magic value has been overwritten. This might be the result of a buffer underrun!");
+      }
+    }
+
+    size_t m_uiSize;
+    ezUInt32 m_magic[32];
+  };
+
+  ezGuardedAllocation::ezGuardedAllocation(ezAllocatorBase* pParent) { m_uiPageSize = static_cast<ezUInt32>(sysconf(_SC_PAGESIZE)); }
 
   void* ezGuardedAllocation::Allocate(size_t uiSize, size_t uiAlign)
   {
-    EZ_ASSERT_NOT_IMPLEMENTED;
-    return nullptr;
+    EZ_ASSERT_DEV(ezMath::IsPowerOf2((ezUInt32)uiAlign), "Alignment must be power of two");
+    uiAlign = ezMath::Max<size_t>(uiAlign, EZ_ALIGNMENT_MINIMUM);
+
+    size_t uiAlignedSize = ezMemoryUtils::AlignSize(uiSize, uiAlign);
+    size_t uiTotalSize = uiAlignedSize + sizeof(AlloctionMetaData);
+
+    // align to full pages and add one page in front and one in back
+    size_t uiPageSize = m_uiPageSize;
+    size_t uiFullPageSize = ezMemoryUtils::AlignSize(uiTotalSize, uiPageSize);
+    void* pMemory = mmap(nullptr, uiFullPageSize + 2 * uiPageSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    EZ_ASSERT_DEV(pMemory != MAP_FAILED, "Could not reserve memory pages. Error Code '{0}'", errno);
+
+    // add one page and make the payload pages accessible
+    void* ptr = ezMemoryUtils::AddByteOffset(pMemory, uiPageSize);
+    EZ_VERIFY(mprotect(ptr, uiFullPageSize, PROT_READ | PROT_WRITE) == 0, "Could not commit memory pages. Error Code '{0}'", errno);
+
+    // store information in meta data
+    AlloctionMetaData* metaData = ezMemoryUtils::AddByteOffset(static_cast<AlloctionMetaData*>(ptr), uiFullPageSize - uiTotalSize);
+    ezMemoryUtils::Construct(metaData, 1);
+    metaData->m_uiSize = uiAlignedSize;
+
+    // finally add offset to the actual payload
+    ptr = ezMemoryUtils::AddByteOffset(metaData, sizeof(AlloctionMetaData));
+    return ptr;
   }
 
-  void ezGuardedAllocation::Deallocate(void* ptr) { EZ_ASSERT_NOT_IMPLEMENTED; }
+  void ezGuardedAllocation::Deallocate(void* ptr)
+  {
+    ezLock<ezMutex> lock(m_mutex);
+
+    size_t uiPageSize = m_uiPageSize;
+
+    // munmap needs the size of the mapping, which is stored as a second entry after every allocation
+    if (!m_AllocationsToFreeLater.CanAppend(2))
+    {
+      void* pMemory = m_AllocationsToFreeLater.PeekFront();
+      m_AllocationsToFreeLater.PopFront();
+      const size_t uiMappedSize = reinterpret_cast<size_t>(m_AllocationsToFreeLater.PeekFront());
+      m_AllocationsToFreeLater.PopFront();
+
+      EZ_VERIFY(munmap(pMemory, uiMappedSize) == 0, "Could not free memory pages. Error Code '{0}'", errno);
+    }
+
+    // Retrieve info from meta data first.
+    AlloctionMetaData* metaData = ezMemoryUtils::AddByteOffset(static_cast<AlloctionMetaData*>(ptr), -((ptrdiff_t)sizeof(AlloctionMetaData)));
+    size_t uiAlignedSize = metaData->m_uiSize;
+
+    ezMemoryUtils::Destruct(metaData, 1);
+
+    // Make the pages inaccessible but do not release the memory yet so use-after-free can be detected.
+    size_t uiTotalSize = uiAlignedSize + sizeof(AlloctionMetaData);
+    size_t uiFullPageSize = ezMemoryUtils::AlignSize(uiTotalSize, uiPageSize);
+    ptr = ezMemoryUtils::AddByteOffset(ptr, ((ptrdiff_t)uiAlignedSize) - uiFullPageSize);
+
+    EZ_VERIFY(mprotect(ptr, uiFullPageSize, PROT_NONE) == 0, "Could not decommit memory pages. Error Code '{0}'", errno);
+
+    // Finally store the allocation so we can release it later
+    void* pMemory = ezMemoryUtils::AddByteOffset(ptr, -((ptrdiff_t)uiPageSize));
+    m_AllocationsToFreeLater.PushBack(pMemory);
+    m_AllocationsToFreeLater.PushBack(reinterpret_cast<void*>(uiFullPageSize + 2 * uiPageSize));
+  }
 } // namespace ezMemoryPolicies
@@ -0,0 +1,127 @@
+#include <Foundation/FoundationInternal.h>
+EZ_FOUNDATION_INTERNAL_HEADER
+
+#include <cxxabi.h>
+#include <errno.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <ucontext.h>
+
+namespace
+{
+  void SamplingSignalHandler(int iSignal, siginfo_t* pInfo, void* pContext)
+  {
+    const int iOldErrno = errno;
+
+    void* pInterruptedAddress = nullptr;
+#if defined(__x86_64__)
+    pInterruptedAddress = reinterpret_cast<void*>(static_cast<ucontext_t*>(pContext)->uc_mcontext.gregs[REG_RIP]);
+#elif defined(__aarch64__)
+    pInterruptedAddress = reinterpret_cast<void*>(static_cast<ucontext_t*>(pContext)->uc_mcontext.pc);
+#endif
+
+    RecordSample(pInterruptedAddress);
+
+    errno = iOldErrno;
+  }
+
+  static bool s_bSamplingSignalHandlerInstalled = false;
+
+  ezResult StartSamplingTimer(ezTime interval)
+  {
+    if (!s_bSamplingSignalHandlerInstalled)
+    {
+      // backtrace() loads libgcc when it is called for the first time, which must not happen inside the signal handler
+      void* pDummyFrames[4];
+      ezArrayPtr<void*> dummyFrames(pDummyFrames);
+      ezStackTracer::GetStackTrace(dummyFrames);
+
+      // The handler stays installed, because a signal that is already pending when the timer gets stopped would terminate the process
+      // with the default handler. It ignores signals while sampling is inactive.
+      struct sigaction action = {};
+      action.sa_sigaction = &SamplingSignalHandler;
+      action.sa_flags = SA_SIGINFO | SA_RESTART;
+      sigemptyset(&action.sa_mask);
+
+      if (sigaction(SIGPROF, &action, nullptr) != 0)
+      {
+        ezLog::Error("Failed to install the SIGPROF handler for sampling (errno {})", errno);
+        return EZ_FAILURE;
+      }
+
+      s_bSamplingSignalHandlerInstalled = true;
+    }
+
+    // ITIMER_PROF counts the CPU time of the whole process and sends the signal to the thread that is running when it expires,
+    // so busy threads get sampled in proportion to the time they spend
+    const ezInt64 iMicroseconds = ezMath::Max<ezInt64>(static_cast<ezInt64>(interval.GetMicroseconds()), 1);
+
+    itimerval timer = {};
+    timer.it_interval.tv_sec = static_cast<time_t>(iMicroseconds / 1000000);
+    timer.it_interval.tv_usec = static_cast<suseconds_t>(iMicroseconds % 1000000);
+    timer.it_value = timer.it_interval;
+
+    if (setitimer(ITIMER_PROF, &timer, nullptr) != 0)
+    {
+      ezLog::Error("Failed to start the profiling timer for sampling (errno {})", errno);
+      return EZ_FAILURE;
+    }
+
+    return EZ_SUCCESS;
+  }
+
+  void StopSamplingTimer()
+  {
+    itimerval timer = {};
+    setitimer(ITIMER_PROF, &timer, nullptr);
+  }
+
+  /// \brief Turns a line of ezStackTracer::ResolveStackTrace(), e.g. "./Module(_ZN5ezLog4InfoEPKc+0x1a) [0x4a3f2e]", into a readable name.
+  ///
+  /// Only exported symbols can be resolved (link with -rdynamic to get names for functions of executables), for everything else the module
+  /// and the offset within it are used, e.g. "Module+0x1a2b", which can be resolved with addr2line.
+  void ExtractSampledFunctionName(const char* szResolvedFrame, ezStringBuilder& out_sName)
+  {
+    const char* szOpen = ezStringUtils::FindLastSubString(szResolvedFrame, "(");
+    const char* szClose = szOpen != nullptr ? ezStringUtils::FindSubString(szOpen, ")") : nullptr;
+
+    if (szClose == nullptr)
+    {
+      out_sName = szResolvedFrame;
+      return;
+    }
+
+    const char* szOffset = ezStringUtils::FindSubString(szOpen, "+");
+    if (szOffset == nullptr || szOffset > szClose)
+    {
+      szOffset = szClose;
+    }
+
+    ezStringBuilder sSymbol;
+    sSymbol.SetSubString_FromTo(szOpen + 1, szOffset);
+
+    if (sSymbol.IsEmpty())
+    {
+      ezStringBuilder sModule;
+      sModule.SetSubString_FromTo(szResolvedFrame, szOpen);
+
+      out_sName = sModule.GetFileNameAndExtension();
+      out_sName.Append(ezStringView(szOffset, szClose));
+      return;
+    }
+
+    int iStatus = 0;
+    char* szDemangled = abi::__cxa_demangle(sSymbol, nullptr, nullptr, &iStatus);
+
+    if (iStatus == 0 && szDemangled != nullptr)
+    {
+      out_sName = szDemangled;
+    }
+    else
+    {
+      out_sName = sSymbol;
+    }
+
+    free(szDemangled);
+  }
+} // namespace
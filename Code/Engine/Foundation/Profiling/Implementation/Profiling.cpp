@@ -1,13 +1,19 @@
 #include <FoundationPCH.h>
 
+#include <Foundation/Algorithm/HashingUtils.h>
 #include <Foundation/Communication/DataTransfer.h>
+#include <Foundation/Communication/Telemetry.h>
 #include <Foundation/Configuration/CVar.h>
 #include <Foundation/Configuration/Startup.h>
+#include <Foundation/Containers/HashSet.h>
+#include <Foundation/Containers/HashTable.h>
 #include <Foundation/Containers/IdTable.h>
-#include <Foundation/Containers/StaticRingBuffer.h>
 #include <Foundation/IO/JSONWriter.h>
 #include <Foundation/Memory/CommonAllocators.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/System/StackTracer.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Threading/ThreadSignal.h>
 #include <Foundation/Threading/ThreadUtils.h>
 
 #if EZ_ENABLED(EZ_USE_PROFILING)
@@ -42,6 +48,8 @@ EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, ProfilingSystem)
   ON_CORESYSTEMS_SHUTDOWN
   {
     s_ProfileCaptureDataTransfer.DisableDataTransfer();
+    ezProfilingSystem::StopSampling();
+    ezProfilingSystem::StopStreamingCapture();
     ezProfilingSystem::Reset();
   }
 
@@ -58,71 +66,918 @@ namespace
 
   enum
   {
-    BUFFER_SIZE_FRAMES = 120 * 60,
+    BUFFER_SIZE_FRAMES = 8192, ///< Must be a power of two. About two minutes at 60 fps.
   };
 
-  typedef ezStaticRingBuffer<ezProfilingSystem::GPUScope, BUFFER_SIZE_OTHER_THREAD / sizeof(ezProfilingSystem::GPUScope)> GPUScopesBuffer;
+  /// \brief A ring buffer that is written by exactly one thread and can be read by any number of other threads at the same time.
+  ///
+  /// The writer never waits. When the buffer is full, it overwrites the oldest entries. Entries are addressed by an index that
+  /// increases monotonically, so readers can tell which entries they have seen already. Since the writer may overwrite entries
+  /// while they are being copied, readers check the write index again after copying and drop every entry that might have been
+  /// overwritten in the meantime (similar to a seqlock).
+  template <typename T>
+  struct ProfilingRingBuffer
+  {
+    ProfilingRingBuffer(T* pData, ezUInt32 uiCapacity)
+      : m_pData(pData)
+      , m_uiMask(uiCapacity - 1)
+    {
+      EZ_ASSERT_DEV(ezMath::IsPowerOf2(uiCapacity), "Capacity must be a power of two");
+    }
+
+    /// \brief Must only be called by the thread that owns the buffer.
+    EZ_ALWAYS_INLINE void PushBack(const T& value)
+    {
+      // only this thread modifies the write index, so reading it is not racy
+      const ezInt64 iWriteIndex = m_iWriteIndex;
+      m_pData[static_cast<ezUInt32>(iWriteIndex) & m_uiMask] = value;
+
+      // full barrier, the entry must be written before it gets published
+      m_iWriteIndex.Increment();
+    }
+
+    /// \brief Copies all entries with an index of at least iFromIndex that are still available.
+    ///
+    /// Returns the index after the last written entry, which is where the next read should continue.
+    /// out_uiLost receives the number of entries at or after iFromIndex that were overwritten before they could be read.
+    ezInt64 Read(ezInt64 iFromIndex, ezDynamicArray<T>& out_Data, ezUInt64& out_uiLost) const
+    {
+      const ezInt64 iCapacity = static_cast<ezInt64>(m_uiMask) + 1;
+      const ezInt64 iEndIndex = m_iWriteIndex;
+
+      iFromIndex = ezMath::Max<ezInt64>(iFromIndex, m_iClearIndex);
+      ezInt64 iStartIndex = ezMath::Max(iFromIndex, iEndIndex - iCapacity);
+
+      const ezUInt32 uiCount = static_cast<ezUInt32>(ezMath::Max<ezInt64>(iEndIndex - iStartIndex, 0));
+      out_Data.SetCountUninitialized(uiCount);
+
+      if (uiCount > 0)
+      {
+        const ezUInt32 uiFirst = static_cast<ezUInt32>(iStartIndex) & m_uiMask;
+        const ezUInt32 uiFirstCount = ezMath::Min(uiCount, m_uiMask + 1 - uiFirst);
+
+        ezMemoryUtils::Copy(out_Data.GetData(), m_pData + uiFirst, uiFirstCount);
+        ezMemoryUtils::Copy(out_Data.GetData() + uiFirstCount, m_pData, uiCount - uiFirstCount);
+
+        // The writer may have started to overwrite the entry at (write index - capacity) already, without having published it yet.
+        const ezInt64 iValidIndex = static_cast<ezInt64>(m_iWriteIndex) + 1 - iCapacity;
+        if (iValidIndex > iStartIndex)
+        {
+          const ezUInt32 uiInvalid = static_cast<ezUInt32>(ezMath::Min<ezInt64>(iValidIndex - iStartIndex, uiCount));
+          out_Data.RemoveAtAndCopy(0, uiInvalid);
+          iStartIndex += uiInvalid;
+        }
+      }
+
+      out_uiLost = static_cast<ezUInt64>(ezMath::Max<ezInt64>(iStartIndex - iFromIndex, 0));
+      return iEndIndex;
+    }
+
+    /// \brief Discards all entries that were written up to now. Can be called from any thread.
+    void Clear() { m_iClearIndex.Max(m_iWriteIndex); }
+
+    /// \brief Discards all entries before the given index. Can be called from any thread.
+    void ClearUpTo(ezInt64 iIndex) { m_iClearIndex.Max(iIndex); }
+
+    ezInt64 GetWriteIndex() const { return m_iWriteIndex; }
+
+  private:
+    T* m_pData;
+    ezUInt32 m_uiMask;
+    ezAtomicInteger64 m_iWriteIndex;
+    ezAtomicInteger64 m_iClearIndex;
+  };
+
+  typedef ProfilingRingBuffer<ezProfilingSystem::GPUScope> GPUScopesBuffer;
+
+  struct CpuScopesBuffer
+  {
+    CpuScopesBuffer(ezUInt32 uiCapacity)
+      : m_Storage(EZ_DEFAULT_NEW_RAW_BUFFER(ezProfilingSystem::CPUScope, uiCapacity))
+      , m_Data(m_Storage, uiCapacity)
+    {
+    }
+
+    ~CpuScopesBuffer() { EZ_DEFAULT_DELETE_RAW_BUFFER(m_Storage); }
+
+    ezProfilingSystem::CPUScope* m_Storage;
+    ProfilingRingBuffer<ezProfilingSystem::CPUScope> m_Data;
+
+    ezUInt64 m_uiThreadId = 0;
+    ezInt64 m_iStreamedIndex = 0; ///< Only accessed by the streaming capture thread
+
+    CpuScopesBuffer* m_pNext = nullptr;
+  };
+
+  ezCVarFloat CVarDiscardThresholdMs("g_ProfilingDiscardThresholdMs", 0.1f, ezCVarFlags::Default,
+    "Discard profiling scopes if their duration is shorter than the specified threshold.");
+
+  ezTime s_FrameStartTimesStorage[BUFFER_SIZE_FRAMES];
+  ProfilingRingBuffer<ezTime> s_FrameStartTimes(s_FrameStartTimesStorage, BUFFER_SIZE_FRAMES);
+
+  static ezHybridArray<ezProfilingSystem::ThreadInfo, 16> s_ThreadInfos;
+  static ezHybridArray<ezUInt64, 16> s_DeadThreadIDs;
+  static ezMutex s_ThreadInfosMutex;
+
+#  if EZ_ENABLED(EZ_PLATFORM_64BIT)
+  EZ_CHECK_AT_COMPILETIME(sizeof(ezProfilingSystem::CPUScope) == 64);
+  EZ_CHECK_AT_COMPILETIME(sizeof(ezProfilingSystem::GPUScope) == 64);
+#  endif
+
+  static thread_local CpuScopesBuffer* s_CpuScopes = nullptr;
+
+  /// Threads add their buffer to the front of this list without locking. Only readers of the list lock the mutex, so that Reset()
+  /// doesn't delete a buffer while it is being read.
+  static CpuScopesBuffer* s_pFirstCpuScopes = nullptr;
+  static ezMutex s_AllCpuScopesMutex;
+
+  static GPUScopesBuffer* s_GPUScopes;
+  static ezProfilingSystem::GPUScope* s_GPUScopesStorage;
+
+  CpuScopesBuffer* GetFirstCpuScopes()
+  {
+    return static_cast<CpuScopesBuffer*>(ezAtomicUtils::ReadPointer(reinterpret_cast<void* const volatile*>(&s_pFirstCpuScopes)));
+  }
+
+  /// \brief Removes the buffer from the list and deletes it. s_AllCpuScopesMutex must be locked.
+  void DeleteCpuScopesBuffer(CpuScopesBuffer* pBuffer)
+  {
+    // Other threads may add buffers to the front of the list concurrently, so unlinking the first buffer needs to be atomic.
+    if (!ezAtomicUtils::TestAndSet(reinterpret_cast<void**>(&s_pFirstCpuScopes), pBuffer, pBuffer->m_pNext))
+    {
+      CpuScopesBuffer* pPrevious = GetFirstCpuScopes();
+      while (pPrevious->m_pNext != pBuffer)
+      {
+        pPrevious = pPrevious->m_pNext;
+      }
+
+      pPrevious->m_pNext = pBuffer->m_pNext;
+    }
+
+    EZ_DEFAULT_DELETE(pBuffer);
+  }
+
+  static ezEventSubscriptionID s_PluginEventSubscription = 0;
+  void PluginEvent(const ezPluginEvent& e)
+  {
+    if (e.m_EventType == ezPluginEvent::AfterUnloading)
+    {
+      // When a plugin is unloaded we need to clear all profiling data
+      // since they can contain pointers to function names that don't exist anymore.
+      ezProfilingSystem::Clear();
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////
+  // Sampling
+  //
+  // While sampling is active, a platform specific timer periodically interrupts the threads that are busy and calls RecordSample() on them,
+  // in a signal handler. It must not allocate or lock, so the raw call stack is just copied into a ring buffer. Whoever reads the samples
+  // (Capture() or the streaming capture thread) resolves the function names and turns the call stacks into scopes.
+
+  struct CallstackSample
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    static constexpr ezUInt32 MAX_FRAMES = 48;
+
+    ezUInt64 m_uiThreadId;
+    ezTime m_Time;
+    ezUInt32 m_uiFirstFrame; ///< Frames before this one belong to the sampling code itself.
+    ezUInt32 m_uiNumFrames;
+    void* m_Frames[MAX_FRAMES]; ///< The innermost frame comes first.
+  };
+
+  /// \brief A ring buffer for call stack samples, which any number of threads can write to at the same time, also from signal handlers.
+  ///
+  /// Every slot stores the index of its sample, which is only set once the sample was written completely. Readers use it to detect samples
+  /// that are still being written or that got overwritten while they were copied.
+  struct SamplesRingBuffer
+  {
+    struct Slot
+    {
+      ezAtomicInteger64 m_iIndex;
+      CallstackSample m_Sample;
+    };
+
+    SamplesRingBuffer(ezUInt32 uiCapacity)
+      : m_Slots(EZ_DEFAULT_NEW_ARRAY(Slot, uiCapacity))
+      , m_uiMask(uiCapacity - 1)
+    {
+      EZ_ASSERT_DEV(ezMath::IsPowerOf2(uiCapacity), "Capacity must be a power of two");
+
+      for (Slot& slot : m_Slots)
+      {
+        slot.m_iIndex = -1;
+      }
+    }
+
+    ~SamplesRingBuffer() { EZ_DEFAULT_DELETE_ARRAY(m_Slots); }
+
+    /// \brief Reserves the next slot. The sample must be published with EndPushBack() afterwards.
+    CallstackSample& BeginPushBack(ezInt64& out_iIndex)
+    {
+      out_iIndex = m_iWriteIndex.Increment() - 1;
+
+      Slot& slot = m_Slots[static_cast<ezUInt32>(out_iIndex) & m_uiMask];
+      slot.m_iIndex = -1;
+      return slot.m_Sample;
+    }
+
+    void EndPushBack(ezInt64 iIndex) { m_Slots[static_cast<ezUInt32>(iIndex) & m_uiMask].m_iIndex = iIndex; }
+
+    /// \brief Same as ProfilingRingBuffer::Read(), but stops at the first sample that is still being written.
+    ezInt64 Read(ezInt64 iFromIndex, ezDynamicArray<CallstackSample>& out_Data, ezUInt64& out_uiLost) const
+    {
+      const ezInt64 iCapacity = static_cast<ezInt64>(m_uiMask) + 1;
+      const ezInt64 iEndIndex = m_iWriteIndex;
+
+      iFromIndex = ezMath::Max<ezInt64>(iFromIndex, m_iClearIndex);
+      const ezInt64 iStartIndex = ezMath::Max(iFromIndex, iEndIndex - iCapacity);
+
+      out_Data.Clear();
+      out_uiLost = static_cast<ezUInt64>(ezMath::Max<ezInt64>(iStartIndex - iFromIndex, 0));
+
+      for (ezInt64 i = iStartIndex; i < iEndIndex; ++i)
+      {
+        const Slot& slot = m_Slots[static_cast<ezUInt32>(i) & m_uiMask];
+
+        const ezInt64 iSlotIndex = slot.m_iIndex;
+        if (iSlotIndex < i)
+        {
+          // not published yet, continue here the next time
+          return i;
+        }
+
+        if (iSlotIndex == i)
+        {
+          out_Data.PushBack(slot.m_Sample);
+
+          if (slot.m_iIndex == i)
+            continue;
+
+          out_Data.PopBack();
+        }
+
+        ++out_uiLost;
+      }
+
+      return iEndIndex;
+    }
+
+    void Clear() { m_iClearIndex.Max(m_iWriteIndex); }
+    void ClearUpTo(ezInt64 iIndex) { m_iClearIndex.Max(iIndex); }
+    ezInt64 GetWriteIndex() const { return m_iWriteIndex; }
+
+  private:
+    ezArrayPtr<Slot> m_Slots;
+    ezUInt32 m_uiMask;
+    ezAtomicInteger64 m_iWriteIndex;
+    ezAtomicInteger64 m_iClearIndex;
+  };
+
+  enum
+  {
+    SAMPLES_BUFFER_SIZE = 8192, ///< Must be a power of two. About 8 seconds of one busy thread at the default rate.
+  };
+
+  /// Samples are shown on their own timeline next to the thread that was sampled. Thread IDs end up as numbers in JSON, which are doubles,
+  /// so the offset must keep them below 2^53.
+  constexpr ezUInt64 SAMPLES_THREAD_ID_OFFSET = 1ull << 48;
+
+  static SamplesRingBuffer* s_pSamples = nullptr;
+  static ezAtomicBool s_bSamplingActive;
+  static ezAtomicInteger32 s_iSamplingHandlersRunning;
+  static ezTime s_SamplingInterval;
+  static ezMutex s_SamplingMutex;
+
+  /// \brief Called by the platform specific sampling timer on the thread that was interrupted.
+  ///
+  /// pInterruptedAddress is the instruction at which the thread was interrupted, if known, which is used to skip the frames of the
+  /// signal handler.
+  void RecordSample(void* pInterruptedAddress)
+  {
+    s_iSamplingHandlersRunning.Increment();
+
+    if (s_bSamplingActive)
+    {
+      ezInt64 iIndex = 0;
+      CallstackSample& sample = s_pSamples->BeginPushBack(iIndex);
+
+      sample.m_uiThreadId = (ezUInt64)ezThreadUtils::GetCurrentThreadID();
+      sample.m_Time = ezTime::Now();
+
+      ezArrayPtr<void*> frames(sample.m_Frames);
+      sample.m_uiNumFrames = ezStackTracer::GetStackTrace(frames);
+
+      // without the interrupted address, skip this function, the signal handler and the signal trampoline
+      sample.m_uiFirstFrame = ezMath::Min(3u, sample.m_uiNumFrames);
+      for (ezUInt32 i = 0; i < sample.m_uiNumFrames; ++i)
+      {
+        if (sample.m_Frames[i] == pInterruptedAddress)
+        {
+          sample.m_uiFirstFrame = i;
+          break;
+        }
+      }
+
+      s_pSamples->EndPushBack(iIndex);
+    }
+
+    s_iSamplingHandlersRunning.Decrement();
+  }
+
+  struct SampledFunction
+  {
+    ezString m_sName;
+    char m_szShortName[ezProfilingSystem::CPUScope::NAME_SIZE];
+  };
+
+  // only accessed with s_SamplingMutex locked
+  static ezDeque<SampledFunction> s_SampledFunctions;
+  static ezHashTable<ezUInt64, const SampledFunction*> s_SampledFunctionByAddress;
+  static ezHashTable<ezUInt64, const SampledFunction*> s_SampledFunctionByName;
+
+  void ExtractSampledFunctionName(const char* szResolvedFrame, ezStringBuilder& out_sName);
+
+  /// \brief Returns the function that contains the given code address. The same function is always returned with the same pointer.
+  const SampledFunction* GetSampledFunction(void* pAddress)
+  {
+    const ezUInt64 uiAddress = reinterpret_cast<ezUInt64>(pAddress);
+
+    const SampledFunction* pFunction = nullptr;
+    if (s_SampledFunctionByAddress.TryGetValue(uiAddress, pFunction))
+      return pFunction;
+
+    ezStringBuilder sResolved;
+    ezStackTracer::ResolveStackTrace(ezArrayPtr<void*>(&pAddress, 1), [&](const char* szText) { sResolved.Append(szText); });
+    sResolved.Trim("\r\n");
+
+    ezStringBuilder sName;
+    ExtractSampledFunctionName(sResolved, sName);
+
+    const ezUInt64 uiNameHash = ezHashingUtils::xxHash64(sName.GetData(), sName.GetElementCount());
+    if (!s_SampledFunctionByName.TryGetValue(uiNameHash, pFunction))
+    {
+      SampledFunction& function = s_SampledFunctions.ExpandAndGetRef();
+      function.m_sName = sName;
+
+      // the short name omits the parameters, which are only shown in the details
+      const char* szParameters = sName.FindLastSubString(")");
+      for (ezInt32 iDepth = 0; szParameters != nullptr && szParameters > sName.GetData(); --szParameters)
+      {
+        iDepth += *szParameters == ')' ? 1 : (*szParameters == '(' ? -1 : 0);
+        if (iDepth == 0)
+          break;
+      }
+
+      if (szParameters != nullptr && szParameters > sName.GetData())
+      {
+        sName.SetSubString_FromTo(sName.GetData(), szParameters);
+      }
+
+      ezStringUtils::Copy(function.m_szShortName, EZ_ARRAY_SIZE(function.m_szShortName), sName);
+
+      pFunction = &function;
+      s_SampledFunctionByName.Insert(uiNameHash, pFunction);
+    }
+
+    s_SampledFunctionByAddress.Insert(uiAddress, pFunction);
+    return pFunction;
+  }
+
+  void ClearSampledFunctions()
+  {
+    s_SampledFunctionByAddress.Clear();
+    s_SampledFunctionByName.Clear();
+    s_SampledFunctions.Clear();
+  }
+
+  void GetSampledThreadName(ezUInt64 uiThreadId, ezArrayPtr<const ezProfilingSystem::ThreadInfo> threadInfos, ezStringBuilder& out_sName)
+  {
+    out_sName.Clear();
+
+    // thread IDs can be reused, the latest entry is the current one
+    for (ezUInt32 i = threadInfos.GetCount(); i > 0; --i)
+    {
+      if (threadInfos[i - 1].m_uiThreadId == uiThreadId)
+      {
+        out_sName = threadInfos[i - 1].m_sName;
+        break;
+      }
+    }
+
+    if (out_sName.IsEmpty())
+    {
+      out_sName.Format("Thread {}", uiThreadId);
+    }
+
+    out_sName.Append(" (Samples)");
+  }
+
+  /// \brief Turns call stack samples into scopes, on a separate timeline for every sampled thread. s_SamplingMutex must be locked.
+  ///
+  /// Every frame of a call stack becomes a scope that lasts until the next sample of the thread. Consecutive samples of a thread that share
+  /// their outer frames are merged into longer scopes, so the timeline looks like a flame graph.
+  void ConvertSamples(ezArrayPtr<const CallstackSample> samples, ezDynamicArray<ezProfilingSystem::CPUScopesBufferFlat>& out_Buffers)
+  {
+    struct OpenFrame
+    {
+      const SampledFunction* m_pFunction;
+      ezTime m_BeginTime;
+    };
+
+    struct ThreadState
+    {
+      ezUInt32 m_uiBuffer;
+      ezTime m_LastSampleTime;
+      ezHybridArray<OpenFrame, CallstackSample::MAX_FRAMES> m_OpenFrames;
+    };
+
+    ezHybridArray<ThreadState, 16> threads;
+    ezHybridArray<const SampledFunction*, CallstackSample::MAX_FRAMES> functions;
+
+    auto closeFrames = [&](ThreadState& thread, ezUInt32 uiKeep, ezTime endTime) {
+      ezDynamicArray<ezProfilingSystem::CPUScope>& scopes = out_Buffers[thread.m_uiBuffer].m_Data;
+
+      while (thread.m_OpenFrames.GetCount() > uiKeep)
+      {
+        const OpenFrame& frame = thread.m_OpenFrames.PeekBack();
+
+        ezProfilingSystem::CPUScope& scope = scopes.ExpandAndGetRef();
+        scope.m_szFunctionName = frame.m_pFunction->m_sName;
+        scope.m_BeginTime = frame.m_BeginTime;
+        scope.m_EndTime = endTime;
+        ezMemoryUtils::Copy(scope.m_szName, frame.m_pFunction->m_szShortName, ezProfilingSystem::CPUScope::NAME_SIZE);
+
+        thread.m_OpenFrames.PopBack();
+      }
+    };
+
+    for (const CallstackSample& sample : samples)
+    {
+      const ezUInt64 uiThreadId = sample.m_uiThreadId + SAMPLES_THREAD_ID_OFFSET;
+
+      ThreadState* pThread = nullptr;
+      for (ThreadState& thread : threads)
+      {
+        if (out_Buffers[thread.m_uiBuffer].m_uiThreadId == uiThreadId)
+        {
+          pThread = &thread;
+          break;
+        }
+      }
+
+      if (pThread == nullptr)
+      {
+        pThread = &threads.ExpandAndGetRef();
+        pThread->m_uiBuffer = out_Buffers.GetCount();
+
+        out_Buffers.ExpandAndGetRef().m_uiThreadId = uiThreadId;
+      }
+
+      ThreadState& thread = *pThread;
+
+      // outermost frame first
+      functions.Clear();
+      for (ezUInt32 i = sample.m_uiNumFrames; i > sample.m_uiFirstFrame; --i)
+      {
+        functions.PushBack(GetSampledFunction(sample.m_Frames[i - 1]));
+      }
+
+      // The timer counts the CPU time of the whole process and has the granularity of the scheduler tick, so the time between two samples
+      // of one thread varies a lot. Only a long gap means that the thread didn't run in between.
+      if (sample.m_Time > thread.m_LastSampleTime + s_SamplingInterval * 20)
+      {
+        closeFrames(thread, 0, thread.m_LastSampleTime + s_SamplingInterval);
+      }
+
+      // Call stacks can't always be unwound completely, e.g. when a thread was interrupted in code without unwind information.
+      // Such a partial call stack is attached to the innermost open frame of its outermost function.
+      ezUInt32 uiFirstOpen = 0;
+      if (!functions.IsEmpty() && !thread.m_OpenFrames.IsEmpty() && thread.m_OpenFrames[0].m_pFunction != functions[0])
+      {
+        for (ezUInt32 i = thread.m_OpenFrames.GetCount(); i > 1; --i)
+        {
+          if (thread.m_OpenFrames[i - 1].m_pFunction == functions[0])
+          {
+            uiFirstOpen = i - 1;
+            break;
+          }
+        }
+      }
+
+      ezUInt32 uiCommon = uiFirstOpen;
+      while (uiCommon < thread.m_OpenFrames.GetCount() && uiCommon - uiFirstOpen < functions.GetCount() &&
+             thread.m_OpenFrames[uiCommon].m_pFunction == functions[uiCommon - uiFirstOpen])
+      {
+        ++uiCommon;
+      }
+
+      closeFrames(thread, uiCommon, sample.m_Time);
+
+      for (ezUInt32 i = uiCommon - uiFirstOpen; i < functions.GetCount(); ++i)
+      {
+        thread.m_OpenFrames.PushBack({functions[i], sample.m_Time});
+      }
+
+      thread.m_LastSampleTime = sample.m_Time;
+    }
+
+    for (ThreadState& thread : threads)
+    {
+      closeFrames(thread, 0, thread.m_LastSampleTime + s_SamplingInterval);
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////
+  // Streaming capture
+  //
+  // The binary format starts with the magic 'EZPT', a version byte and the process ID. It is followed by records, each of which starts with
+  // a StreamRecord byte. Most numbers are stored as variable-length integers, times as nanoseconds. Within one record, begin times are
+  // stored relative to the previous begin time and end times relative to the begin time. Names are stored only once, as a StreamRecord::String,
+  // and afterwards referenced by their ID.
+
+  constexpr ezUInt8 STREAM_VERSION = 1;
+
+  enum class StreamRecord : ezUInt8
+  {
+    String = 1,     ///< id, string
+    ThreadName = 2, ///< thread id, string
+    CpuScopes = 3,  ///< thread id, count, [name id, function id (0 = none), begin, duration]
+    GpuScopes = 4,  ///< count, [name id, begin, duration]
+    Frames = 5,     ///< index of the first frame, count, [start time]
+    LostScopes = 6, ///< thread id, count
+  };
+
+  EZ_ALWAYS_INLINE void WriteVarUInt(ezDynamicArray<ezUInt8>& ref_data, ezUInt64 uiValue)
+  {
+    while (uiValue >= 0x80)
+    {
+      ref_data.PushBack(static_cast<ezUInt8>(uiValue) | 0x80);
+      uiValue >>= 7;
+    }
+
+    ref_data.PushBack(static_cast<ezUInt8>(uiValue));
+  }
+
+  EZ_ALWAYS_INLINE void WriteVarInt(ezDynamicArray<ezUInt8>& ref_data, ezInt64 iValue)
+  {
+    // zig-zag encoding, so that small negative values stay small
+    WriteVarUInt(ref_data, (static_cast<ezUInt64>(iValue) << 1) ^ static_cast<ezUInt64>(iValue >> 63));
+  }
+
+  void WriteStreamString(ezDynamicArray<ezUInt8>& ref_data, ezStringView sString)
+  {
+    WriteVarUInt(ref_data, sString.GetElementCount());
+    ref_data.PushBackRange(ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(sString.GetStartPointer()), sString.GetElementCount()));
+  }
+
+  ezResult ReadVarUInt(ezStreamReader& stream, ezUInt64& out_uiValue)
+  {
+    out_uiValue = 0;
+
+    for (ezUInt32 uiShift = 0; uiShift < 64; uiShift += 7)
+    {
+      ezUInt8 uiByte = 0;
+      if (stream.ReadBytes(&uiByte, 1) != 1)
+        return EZ_FAILURE;
+
+      out_uiValue |= static_cast<ezUInt64>(uiByte & 0x7F) << uiShift;
+
+      if ((uiByte & 0x80) == 0)
+        return EZ_SUCCESS;
+    }
+
+    return EZ_FAILURE;
+  }
+
+  ezResult ReadVarInt(ezStreamReader& stream, ezInt64& out_iValue)
+  {
+    ezUInt64 uiValue = 0;
+    EZ_SUCCEED_OR_RETURN(ReadVarUInt(stream, uiValue));
+
+    out_iValue = static_cast<ezInt64>(uiValue >> 1) ^ -static_cast<ezInt64>(uiValue & 1);
+    return EZ_SUCCESS;
+  }
+
+  ezResult ReadStreamString(ezStreamReader& stream, ezStringBuilder& out_sString)
+  {
+    ezUInt64 uiLength = 0;
+    EZ_SUCCEED_OR_RETURN(ReadVarUInt(stream, uiLength));
+
+    ezHybridArray<char, 256> buffer;
+    buffer.SetCountUninitialized(static_cast<ezUInt32>(uiLength));
+    if (stream.ReadBytes(buffer.GetData(), uiLength) != uiLength)
+      return EZ_FAILURE;
+
+    out_sString = ezStringView(buffer.GetData(), buffer.GetData() + buffer.GetCount());
+    return EZ_SUCCESS;
+  }
+
+  EZ_ALWAYS_INLINE ezInt64 ToNanoseconds(ezTime t) { return static_cast<ezInt64>(t.GetNanoseconds()); }
+
+  class ezProfilingStreamingThread : public ezThread
+  {
+  public:
+    ezProfilingStreamingThread(ezStreamWriter* pOutput, ezTime flushInterval)
+      : ezThread("Profiling Capture")
+      , m_pOutput(pOutput)
+      , m_FlushInterval(flushInterval)
+    {
+      // only new data is written
+      EZ_LOCK(s_AllCpuScopesMutex);
+
+      for (CpuScopesBuffer* pBuffer = GetFirstCpuScopes(); pBuffer != nullptr; pBuffer = pBuffer->m_pNext)
+      {
+        pBuffer->m_iStreamedIndex = pBuffer->m_Data.GetWriteIndex();
+      }
+
+      m_iStreamedFrames = s_FrameStartTimes.GetWriteIndex();
+      m_iStreamedGPUScopes = s_GPUScopes != nullptr ? s_GPUScopes->GetWriteIndex() : 0;
+
+      EZ_LOCK(s_SamplingMutex);
+      m_iStreamedSamples = s_pSamples != nullptr ? s_pSamples->GetWriteIndex() : 0;
+    }
+
+    void Stop()
+    {
+      m_bStop = true;
+      m_WakeUp.RaiseSignal();
+      Join();
+    }
+
+    ezUInt64 GetLostScopes() const { return static_cast<ezUInt64>(m_iLostScopes); }
+
+  private:
+    virtual ezUInt32 Run() override
+    {
+      WriteHeader();
+
+      while (!m_bStop)
+      {
+        m_WakeUp.WaitForSignal(m_FlushInterval);
+
+        WriteNewData();
+      }
+
+      return 0;
+    }
+
+    void WriteHeader()
+    {
+      const char szMagic[4] = {'E', 'Z', 'P', 'T'};
+      m_Data.PushBackRange(ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(szMagic), 4));
+      m_Data.PushBack(STREAM_VERSION);
+
+#  if EZ_ENABLED(EZ_SUPPORTS_PROCESSES)
+      WriteVarUInt(m_Data, static_cast<ezUInt64>(ezProcess::GetCurrentProcessID()));
+#  else
+      WriteVarUInt(m_Data, 0);
+#  endif
+    }
+
+    ezUInt32 GetStringID(ezStringView sString)
+    {
+      const ezUInt64 uiHash = ezHashingUtils::xxHash64(sString.GetStartPointer(), sString.GetElementCount());
+
+      ezUInt32 uiID = 0;
+      if (!m_StringIDs.TryGetValue(uiHash, uiID))
+      {
+        uiID = m_StringIDs.GetCount() + 1;
+        m_StringIDs.Insert(uiHash, uiID);
+
+        m_Data.PushBack(static_cast<ezUInt8>(StreamRecord::String));
+        WriteVarUInt(m_Data, uiID);
+        WriteStreamString(m_Data, sString);
+      }
+
+      return uiID;
+    }
+
+    void WriteNewData()
+    {
+      // thread names
+      {
+        EZ_LOCK(s_ThreadInfosMutex);
+
+        for (; m_uiStreamedThreadInfos < s_ThreadInfos.GetCount(); ++m_uiStreamedThreadInfos)
+        {
+          const ezProfilingSystem::ThreadInfo& info = s_ThreadInfos[m_uiStreamedThreadInfos];
+
+          m_Data.PushBack(static_cast<ezUInt8>(StreamRecord::ThreadName));
+          WriteVarUInt(m_Data, info.m_uiThreadId);
+          WriteStreamString(m_Data, info.m_sName);
+        }
+      }
+
+      // CPU scopes
+      {
+        EZ_LOCK(s_AllCpuScopesMutex);
+
+        for (CpuScopesBuffer* pBuffer = GetFirstCpuScopes(); pBuffer != nullptr; pBuffer = pBuffer->m_pNext)
+        {
+          ezUInt64 uiLost = 0;
+          pBuffer->m_iStreamedIndex = pBuffer->m_Data.Read(pBuffer->m_iStreamedIndex, m_CpuScopes, uiLost);
+
+          WriteLostScopes(pBuffer->m_uiThreadId, uiLost);
+          WriteCpuScopes(pBuffer->m_uiThreadId, m_CpuScopes);
+        }
+      }
+
+      // call stack samples
+      {
+        EZ_LOCK(s_SamplingMutex);
+
+        if (s_pSamples != nullptr)
+        {
+          ezUInt64 uiLost = 0;
+          m_iStreamedSamples = s_pSamples->Read(m_iStreamedSamples, m_Samples, uiLost);
+
+          m_SampleBuffers.Clear();
+          ConvertSamples(m_Samples, m_SampleBuffers);
+
+          for (const ezProfilingSystem::CPUScopesBufferFlat& buffer : m_SampleBuffers)
+          {
+            if (!m_SampledThreads.Contains(buffer.m_uiThreadId))
+            {
+              m_SampledThreads.Insert(buffer.m_uiThreadId);
+
+              ezStringBuilder sName;
+              {
+                EZ_LOCK(s_ThreadInfosMutex);
+                GetSampledThreadName(buffer.m_uiThreadId - SAMPLES_THREAD_ID_OFFSET, s_ThreadInfos, sName);
+              }
+
+              m_Data.PushBack(static_cast<ezUInt8>(StreamRecord::ThreadName));
+              WriteVarUInt(m_Data, buffer.m_uiThreadId);
+              WriteStreamString(m_Data, sName);
+            }
+
+            WriteCpuScopes(buffer.m_uiThreadId, buffer.m_Data);
+          }
+        }
+      }
+
+      // GPU scopes
+      if (s_GPUScopes != nullptr)
+      {
+        ezUInt64 uiLost = 0;
+        m_iStreamedGPUScopes = s_GPUScopes->Read(m_iStreamedGPUScopes, m_GPUScopes, uiLost);
+
+        if (!m_GPUScopes.IsEmpty())
+        {
+          m_ScopeStringIDs.SetCountUninitialized(m_GPUScopes.GetCount());
+          for (ezUInt32 i = 0; i < m_GPUScopes.GetCount(); ++i)
+          {
+            m_ScopeStringIDs[i] = GetStringID(m_GPUScopes[i].m_szName);
+          }
+
+          m_Data.PushBack(static_cast<ezUInt8>(StreamRecord::GpuScopes));
+          WriteVarUInt(m_Data, m_GPUScopes.GetCount());
+
+          ezInt64 iPrevBegin = 0;
+          for (ezUInt32 i = 0; i < m_GPUScopes.GetCount(); ++i)
+          {
+            const ezProfilingSystem::GPUScope& scope = m_GPUScopes[i];
+            const ezInt64 iBegin = ToNanoseconds(scope.m_BeginTime);
+
+            WriteVarUInt(m_Data, m_ScopeStringIDs[i]);
+            WriteVarInt(m_Data, iBegin - iPrevBegin);
+            WriteVarUInt(m_Data, static_cast<ezUInt64>(ezMath::Max<ezInt64>(ToNanoseconds(scope.m_EndTime) - iBegin, 0)));
+
+            iPrevBegin = iBegin;
+          }
+        }
+      }
+
+      // frames
+      {
+        ezUInt64 uiLost = 0;
+        const ezInt64 iFromIndex = m_iStreamedFrames;
+        m_iStreamedFrames = s_FrameStartTimes.Read(iFromIndex, m_FrameStartTimes, uiLost);
+
+        if (!m_FrameStartTimes.IsEmpty())
+        {
+          m_Data.PushBack(static_cast<ezUInt8>(StreamRecord::Frames));
+          WriteVarUInt(m_Data, static_cast<ezUInt64>(m_iStreamedFrames) - m_FrameStartTimes.GetCount());
+          WriteVarUInt(m_Data, m_FrameStartTimes.GetCount());
+
+          ezInt64 iPrevTime = 0;
+          for (ezTime t : m_FrameStartTimes)
+          {
+            const ezInt64 iTime = ToNanoseconds(t);
+            WriteVarInt(m_Data, iTime - iPrevTime);
+            iPrevTime = iTime;
+          }
+        }
+      }
+
+      if (m_Data.IsEmpty())
+        return;
+
+      if (m_pOutput != nullptr)
+      {
+        m_pOutput->WriteBytes(m_Data.GetData(), m_Data.GetCount()).IgnoreResult();
+      }
+      else
+      {
+        ezTelemetry::Broadcast(ezTelemetry::Reliable, 'PROF', 'TRCE', m_Data.GetData(), m_Data.GetCount());
+      }
+
+      m_Data.Clear();
+    }
+
+    void WriteCpuScopes(ezUInt64 uiThreadId, const ezDynamicArray<ezProfilingSystem::CPUScope>& scopes)
+    {
+      if (scopes.IsEmpty())
+        return;
 
-  static ezUInt64 s_MainThreadId = 0;
+      // strings have to be written before the record that uses them
+      m_ScopeStringIDs.SetCountUninitialized(scopes.GetCount() * 2);
+      for (ezUInt32 i = 0; i < scopes.GetCount(); ++i)
+      {
+        const ezProfilingSystem::CPUScope& scope = scopes[i];
+        m_ScopeStringIDs[i * 2 + 0] = GetStringID(scope.m_szName);
+        m_ScopeStringIDs[i * 2 + 1] = scope.m_szFunctionName != nullptr ? GetStringID(scope.m_szFunctionName) : 0;
+      }
 
-  struct CpuScopesBufferBase
-  {
-    virtual ~CpuScopesBufferBase() = default;
+      m_Data.PushBack(static_cast<ezUInt8>(StreamRecord::CpuScopes));
+      WriteVarUInt(m_Data, uiThreadId);
+      WriteVarUInt(m_Data, scopes.GetCount());
 
-    ezUInt64 m_uiThreadId = 0;
-    bool IsMainThread() const { return m_uiThreadId == s_MainThreadId; }
-  };
+      ezInt64 iPrevBegin = 0;
+      for (ezUInt32 i = 0; i < scopes.GetCount(); ++i)
+      {
+        const ezProfilingSystem::CPUScope& scope = scopes[i];
+        const ezInt64 iBegin = ToNanoseconds(scope.m_BeginTime);
 
-  template <ezUInt32 SizeInBytes>
-  struct CpuScopesBuffer : public CpuScopesBufferBase
-  {
-    ezStaticRingBuffer<ezProfilingSystem::CPUScope, SizeInBytes / sizeof(ezProfilingSystem::CPUScope)> m_Data;
-  };
+        WriteVarUInt(m_Data, m_ScopeStringIDs[i * 2 + 0]);
+        WriteVarUInt(m_Data, m_ScopeStringIDs[i * 2 + 1]);
+        WriteVarInt(m_Data, iBegin - iPrevBegin);
+        WriteVarUInt(m_Data, static_cast<ezUInt64>(ezMath::Max<ezInt64>(ToNanoseconds(scope.m_EndTime) - iBegin, 0)));
 
-  CpuScopesBuffer<BUFFER_SIZE_MAIN_THREAD>* CastToMainThreadEventBuffer(CpuScopesBufferBase* pEventBuffer)
-  {
-    EZ_ASSERT_DEV(pEventBuffer->IsMainThread(), "Implementation error");
-    return static_cast<CpuScopesBuffer<BUFFER_SIZE_MAIN_THREAD>*>(pEventBuffer);
-  }
+        iPrevBegin = iBegin;
+      }
+    }
 
-  CpuScopesBuffer<BUFFER_SIZE_OTHER_THREAD>* CastToOtherThreadEventBuffer(CpuScopesBufferBase* pEventBuffer)
-  {
-    EZ_ASSERT_DEV(!pEventBuffer->IsMainThread(), "Implementation error");
-    return static_cast<CpuScopesBuffer<BUFFER_SIZE_OTHER_THREAD>*>(pEventBuffer);
-  }
+    void WriteLostScopes(ezUInt64 uiThreadId, ezUInt64 uiLost)
+    {
+      if (uiLost == 0)
+        return;
 
-  ezCVarFloat CVarDiscardThresholdMs("g_ProfilingDiscardThresholdMs", 0.1f, ezCVarFlags::Default,
-    "Discard profiling scopes if their duration is shorter than the specified threshold.");
+      m_iLostScopes.Add(static_cast<ezInt64>(uiLost));
 
-  ezStaticRingBuffer<ezTime, BUFFER_SIZE_FRAMES> s_FrameStartTimes;
-  ezUInt64 s_uiFrameCount = 0;
+      m_Data.PushBack(static_cast<ezUInt8>(StreamRecord::LostScopes));
+      WriteVarUInt(m_Data, uiThreadId);
+      WriteVarUInt(m_Data, uiLost);
+    }
 
-  static ezHybridArray<ezProfilingSystem::ThreadInfo, 16> s_ThreadInfos;
-  static ezHybridArray<ezUInt64, 16> s_DeadThreadIDs;
-  static ezMutex s_ThreadInfosMutex;
+    ezStreamWriter* m_pOutput;
+    ezTime m_FlushInterval;
+    ezThreadSignal m_WakeUp;
+    ezAtomicBool m_bStop;
 
-#  if EZ_ENABLED(EZ_PLATFORM_64BIT)
-  EZ_CHECK_AT_COMPILETIME(sizeof(ezProfilingSystem::CPUScope) == 64);
-  EZ_CHECK_AT_COMPILETIME(sizeof(ezProfilingSystem::GPUScope) == 64);
-#  endif
+    ezDynamicArray<ezUInt8> m_Data;
+    ezHashTable<ezUInt64, ezUInt32> m_StringIDs;
 
-  static thread_local CpuScopesBufferBase* s_CpuScopes = nullptr;
-  static ezDynamicArray<CpuScopesBufferBase*> s_AllCpuScopes;
-  static ezMutex s_AllCpuScopesMutex;
+    ezUInt32 m_uiStreamedThreadInfos = 0;
+    ezInt64 m_iStreamedGPUScopes = 0;
+    ezInt64 m_iStreamedFrames = 0;
+    ezInt64 m_iStreamedSamples = 0;
+    ezAtomicInteger64 m_iLostScopes;
 
-  static GPUScopesBuffer* s_GPUScopes;
+    ezDynamicArray<ezProfilingSystem::CPUScope> m_CpuScopes;
+    ezDynamicArray<ezProfilingSystem::GPUScope> m_GPUScopes;
+    ezDynamicArray<ezTime> m_FrameStartTimes;
+    ezDynamicArray<ezUInt32> m_ScopeStringIDs;
 
-  static ezEventSubscriptionID s_PluginEventSubscription = 0;
-  void PluginEvent(const ezPluginEvent& e)
+    ezDynamicArray<CallstackSample> m_Samples;
+    ezDynamicArray<ezProfilingSystem::CPUScopesBufferFlat> m_SampleBuffers;
+    ezHashSet<ezUInt64> m_SampledThreads;
+  };
+
+  static ezProfilingStreamingThread* s_pStreamingThread = nullptr;
+  static ezUInt64 s_uiStreamingLostScopes = 0;
+  static ezMutex s_StreamingMutex;
+} // namespace
+
+#  if EZ_ENABLED(EZ_PLATFORM_LINUX)
+#    include <Foundation/Profiling/Implementation/Linux/Sampling_linux.h>
+#  else
+namespace
+{
+  ezResult StartSamplingTimer(ezTime interval)
   {
-    if (e.m_EventType == ezPluginEvent::AfterUnloading)
-    {
-      // When a plugin is unloaded we need to clear all profiling data
-      // since they can contain pointers to function names that don't exist anymore.
-      ezProfilingSystem::Clear();
-    }
+    ezLog::Warning("Sampling is not supported on this platform");
+    return EZ_FAILURE;
   }
+
+  void StopSamplingTimer() {}
+
+  void ExtractSampledFunctionName(const char* szResolvedFrame, ezStringBuilder& out_sName) { out_sName = szResolvedFrame; }
 } // namespace
+#  endif
 
 void ezProfilingSystem::ProfilingData::Clear()
 {
@@ -135,6 +990,7 @@ void ezProfilingSystem::ProfilingData::Clear()
   m_FrameStartTimes.Clear();
   m_GPUScopes.Clear();
   m_ThreadInfos.Clear();
+  m_StringStorage.Clear();
 }
 
 void ezProfilingSystem::ProfilingData::Merge(ProfilingData& out_Merged, ezArrayPtr<const ProfilingData*> inputs)
@@ -463,21 +1319,171 @@ ezResult ezProfilingSystem::ProfilingData::Write(ezStreamWriter& outputStream) c
   return writer.HadWriteError() ? EZ_FAILURE : EZ_SUCCESS;
 }
 
-// static
-void ezProfilingSystem::Clear()
+ezResult ezProfilingSystem::ProfilingData::ReadStreamingCapture(ezStreamReader& inputStream)
 {
+  Clear();
+
+  char szMagic[4] = {};
+  ezUInt8 uiVersion = 0;
+  inputStream.ReadBytes(szMagic, 4);
+  inputStream >> uiVersion;
+
+  if (szMagic[0] != 'E' || szMagic[1] != 'Z' || szMagic[2] != 'P' || szMagic[3] != 'T' || uiVersion != STREAM_VERSION)
+    return EZ_FAILURE;
+
+  ezUInt64 uiProcessID = 0;
+  EZ_SUCCEED_OR_RETURN(ReadVarUInt(inputStream, uiProcessID));
+
+  m_uiProcessID = static_cast<ezOsProcessID>(uiProcessID);
+  m_uiFramesThreadID = 1;
+  m_uiGPUThreadID = 0;
+
+  // index 0 means 'no string'
+  ezDynamicArray<const char*> strings;
+  strings.PushBack(nullptr);
+
+  auto getString = [&](ezUInt64 uiID) -> const char* { return uiID < strings.GetCount() ? strings[static_cast<ezUInt32>(uiID)] : nullptr; };
+
+  ezMap<ezUInt64, ezUInt32> threadBuffers;
+  ezStringBuilder sString;
+
+  while (true)
   {
-    EZ_LOCK(s_AllCpuScopesMutex);
-    for (auto pEventBuffer : s_AllCpuScopes)
+    ezUInt8 uiRecord = 0;
+    if (inputStream.ReadBytes(&uiRecord, 1) != 1)
+      break;
+
+    switch (static_cast<StreamRecord>(uiRecord))
     {
-      if (pEventBuffer->IsMainThread())
+      case StreamRecord::String:
       {
-        CastToMainThreadEventBuffer(pEventBuffer)->m_Data.Clear();
+        ezUInt64 uiID = 0;
+        EZ_SUCCEED_OR_RETURN(ReadVarUInt(inputStream, uiID));
+        EZ_SUCCEED_OR_RETURN(ReadStreamString(inputStream, sString));
+
+        if (uiID != strings.GetCount())
+          return EZ_FAILURE;
+
+        ezString& sStored = m_StringStorage.ExpandAndGetRef();
+        sStored = sString;
+        strings.PushBack(sStored.GetData());
       }
-      else
+      break;
+
+      case StreamRecord::ThreadName:
+      {
+        ThreadInfo& info = m_ThreadInfos.ExpandAndGetRef();
+        EZ_SUCCEED_OR_RETURN(ReadVarUInt(inputStream, info.m_uiThreadId));
+        EZ_SUCCEED_OR_RETURN(ReadStreamString(inputStream, sString));
+        info.m_sName = sString;
+      }
+      break;
+
+      case StreamRecord::CpuScopes:
+      {
+        ezUInt64 uiThreadId = 0, uiCount = 0;
+        EZ_SUCCEED_OR_RETURN(ReadVarUInt(inputStream, uiThreadId));
+        EZ_SUCCEED_OR_RETURN(ReadVarUInt(inputStream, uiCount));
+
+        bool bExisted = false;
+        auto it = threadBuffers.FindOrAdd(uiThreadId, &bExisted);
+        if (!bExisted)
+        {
+          it.Value() = m_AllEventBuffers.GetCount();
+          m_AllEventBuffers.ExpandAndGetRef().m_uiThreadId = uiThreadId;
+        }
+
+        ezDynamicArray<CPUScope>& scopes = m_AllEventBuffers[it.Value()].m_Data;
+
+        ezInt64 iBegin = 0;
+        for (ezUInt64 i = 0; i < uiCount; ++i)
+        {
+          ezUInt64 uiNameID = 0, uiFunctionID = 0, uiDuration = 0;
+          ezInt64 iBeginDelta = 0;
+          EZ_SUCCEED_OR_RETURN(ReadVarUInt(inputStream, uiNameID));
+          EZ_SUCCEED_OR_RETURN(ReadVarUInt(inputStream, uiFunctionID));
+          EZ_SUCCEED_OR_RETURN(ReadVarInt(inputStream, iBeginDelta));
+          EZ_SUCCEED_OR_RETURN(ReadVarUInt(inputStream, uiDuration));
+
+          iBegin += iBeginDelta;
+
+          CPUScope& scope = scopes.ExpandAndGetRef();
+          scope.m_szFunctionName = getString(uiFunctionID);
+          scope.m_BeginTime = ezTime::Nanoseconds(static_cast<double>(iBegin));
+          scope.m_EndTime = ezTime::Nanoseconds(static_cast<double>(iBegin + static_cast<ezInt64>(uiDuration)));
+          ezStringUtils::Copy(scope.m_szName, CPUScope::NAME_SIZE, getString(uiNameID));
+        }
+      }
+      break;
+
+      case StreamRecord::GpuScopes:
+      {
+        ezUInt64 uiCount = 0;
+        EZ_SUCCEED_OR_RETURN(ReadVarUInt(inputStream, uiCount));
+
+        ezInt64 iBegin = 0;
+        for (ezUInt64 i = 0; i < uiCount; ++i)
+        {
+          ezUInt64 uiNameID = 0, uiDuration = 0;
+          ezInt64 iBeginDelta = 0;
+          EZ_SUCCEED_OR_RETURN(ReadVarUInt(inputStream, uiNameID));
+          EZ_SUCCEED_OR_RETURN(ReadVarInt(inputStream, iBeginDelta));
+          EZ_SUCCEED_OR_RETURN(ReadVarUInt(inputStream, uiDuration));
+
+          iBegin += iBeginDelta;
+
+          GPUScope& scope = m_GPUScopes.ExpandAndGetRef();
+          scope.m_BeginTime = ezTime::Nanoseconds(static_cast<double>(iBegin));
+          scope.m_EndTime = ezTime::Nanoseconds(static_cast<double>(iBegin + static_cast<ezInt64>(uiDuration)));
+          ezStringUtils::Copy(scope.m_szName, GPUScope::NAME_SIZE, getString(uiNameID));
+        }
+      }
+      break;
+
+      case StreamRecord::Frames:
+      {
+        ezUInt64 uiFirstFrame = 0, uiCount = 0;
+        EZ_SUCCEED_OR_RETURN(ReadVarUInt(inputStream, uiFirstFrame));
+        EZ_SUCCEED_OR_RETURN(ReadVarUInt(inputStream, uiCount));
+
+        ezInt64 iTime = 0;
+        for (ezUInt64 i = 0; i < uiCount; ++i)
+        {
+          ezInt64 iTimeDelta = 0;
+          EZ_SUCCEED_OR_RETURN(ReadVarInt(inputStream, iTimeDelta));
+
+          iTime += iTimeDelta;
+          m_FrameStartTimes.PushBack(ezTime::Nanoseconds(static_cast<double>(iTime)));
+        }
+
+        m_uiFrameCount = uiFirstFrame + uiCount;
+      }
+      break;
+
+      case StreamRecord::LostScopes:
       {
-        CastToOtherThreadEventBuffer(pEventBuffer)->m_Data.Clear();
+        ezUInt64 uiThreadId = 0, uiCount = 0;
+        EZ_SUCCEED_OR_RETURN(ReadVarUInt(inputStream, uiThreadId));
+        EZ_SUCCEED_OR_RETURN(ReadVarUInt(inputStream, uiCount));
       }
+      break;
+
+      default:
+        return EZ_FAILURE;
+    }
+  }
+
+  return EZ_SUCCESS;
+}
+
+// static
+void ezProfilingSystem::Clear()
+{
+  {
+    EZ_LOCK(s_AllCpuScopesMutex);
+    for (CpuScopesBuffer* pEventBuffer = GetFirstCpuScopes(); pEventBuffer != nullptr; pEventBuffer = pEventBuffer->m_pNext)
+    {
+      pEventBuffer->m_Data.Clear();
     }
   }
 
@@ -487,6 +1493,18 @@ void ezProfilingSystem::Clear()
   {
     s_GPUScopes->Clear();
   }
+
+  {
+    EZ_LOCK(s_SamplingMutex);
+
+    if (s_pSamples != nullptr)
+    {
+      s_pSamples->Clear();
+    }
+
+    // code addresses may belong to a different function now
+    ClearSampledFunctions();
+  }
 }
 
 // static
@@ -515,78 +1533,211 @@ void ezProfilingSystem::Capture(ezProfilingSystem::ProfilingData& profilingData,
     }
   }
 
+  ezUInt64 uiLost = 0;
+
   {
     EZ_LOCK(s_AllCpuScopesMutex);
 
-    profilingData.m_AllEventBuffers.Reserve(s_AllCpuScopes.GetCount());
-    for (ezUInt32 i = 0; i < s_AllCpuScopes.GetCount(); ++i)
+    for (CpuScopesBuffer* pSourceEventBuffer = GetFirstCpuScopes(); pSourceEventBuffer != nullptr; pSourceEventBuffer = pSourceEventBuffer->m_pNext)
     {
-      const auto& sourceEventBuffer = s_AllCpuScopes[i];
       CPUScopesBufferFlat& targetEventBuffer = profilingData.m_AllEventBuffers.ExpandAndGetRef();
+      targetEventBuffer.m_uiThreadId = pSourceEventBuffer->m_uiThreadId;
 
-      targetEventBuffer.m_uiThreadId = sourceEventBuffer->m_uiThreadId;
+      const ezInt64 iEndIndex = pSourceEventBuffer->m_Data.Read(0, targetEventBuffer.m_Data, uiLost);
 
-      ezUInt32 uiSourceCount = sourceEventBuffer->IsMainThread() ? CastToMainThreadEventBuffer(sourceEventBuffer)->m_Data.GetCount()
-                                                                 : CastToOtherThreadEventBuffer(sourceEventBuffer)->m_Data.GetCount();
-      targetEventBuffer.m_Data.SetCountUninitialized(uiSourceCount);
-      for (ezUInt32 j = 0; j < uiSourceCount; ++j)
+      if (bClearAfterCapture)
       {
-        const CPUScope& sourceEvent = sourceEventBuffer->IsMainThread() ? CastToMainThreadEventBuffer(sourceEventBuffer)->m_Data[j]
-                                                                        : CastToOtherThreadEventBuffer(sourceEventBuffer)->m_Data[j];
-
-        CPUScope& copiedEvent = targetEventBuffer.m_Data[j];
-        copiedEvent.m_szFunctionName = sourceEvent.m_szFunctionName;
-        copiedEvent.m_BeginTime = sourceEvent.m_BeginTime;
-        copiedEvent.m_EndTime = sourceEvent.m_EndTime;
-        ezStringUtils::Copy(copiedEvent.m_szName, CPUScope::NAME_SIZE, sourceEvent.m_szName);
+        // only discard what was captured, scopes that were added in the meantime are kept
+        pSourceEventBuffer->m_Data.ClearUpTo(iEndIndex);
       }
     }
   }
 
-  profilingData.m_uiFrameCount = s_uiFrameCount;
-
-  profilingData.m_FrameStartTimes.SetCountUninitialized(s_FrameStartTimes.GetCount());
-  for (ezUInt32 i = 0; i < s_FrameStartTimes.GetCount(); ++i)
   {
-    profilingData.m_FrameStartTimes[i] = s_FrameStartTimes[i];
+    const ezInt64 iEndIndex = s_FrameStartTimes.Read(0, profilingData.m_FrameStartTimes, uiLost);
+    profilingData.m_uiFrameCount = static_cast<ezUInt64>(iEndIndex);
+
+    if (bClearAfterCapture)
+    {
+      s_FrameStartTimes.ClearUpTo(iEndIndex);
+    }
   }
 
   if (s_GPUScopes != nullptr)
   {
-    profilingData.m_GPUScopes.SetCountUninitialized(s_GPUScopes->GetCount());
-    for (ezUInt32 i = 0; i < s_GPUScopes->GetCount(); ++i)
-    {
-      const GPUScope& sourceGpuDat = (*s_GPUScopes)[i];
+    const ezInt64 iEndIndex = s_GPUScopes->Read(0, profilingData.m_GPUScopes, uiLost);
 
-      GPUScope& copiedGpuData = profilingData.m_GPUScopes[i];
-      copiedGpuData.m_BeginTime = sourceGpuDat.m_BeginTime;
-      copiedGpuData.m_EndTime = sourceGpuDat.m_EndTime;
-      ezStringUtils::Copy(copiedGpuData.m_szName, GPUScope::NAME_SIZE, sourceGpuDat.m_szName);
+    if (bClearAfterCapture)
+    {
+      s_GPUScopes->ClearUpTo(iEndIndex);
     }
   }
 
-  if (bClearAfterCapture)
   {
-    Clear();
+    EZ_LOCK(s_SamplingMutex);
+
+    if (s_pSamples != nullptr)
+    {
+      ezDynamicArray<CallstackSample> samples;
+      const ezInt64 iEndIndex = s_pSamples->Read(0, samples, uiLost);
+
+      if (bClearAfterCapture)
+      {
+        s_pSamples->ClearUpTo(iEndIndex);
+      }
+
+      const ezUInt32 uiFirstBuffer = profilingData.m_AllEventBuffers.GetCount();
+      ConvertSamples(samples, profilingData.m_AllEventBuffers);
+
+      // the capture must not reference the function names of the sampling system, they are cleared when a plugin gets unloaded
+      ezHashTable<const char*, const char*> functionNames;
+      ezStringBuilder sThreadName;
+
+      for (ezUInt32 i = uiFirstBuffer; i < profilingData.m_AllEventBuffers.GetCount(); ++i)
+      {
+        CPUScopesBufferFlat& buffer = profilingData.m_AllEventBuffers[i];
+
+        GetSampledThreadName(buffer.m_uiThreadId - SAMPLES_THREAD_ID_OFFSET, profilingData.m_ThreadInfos, sThreadName);
+
+        ThreadInfo& info = profilingData.m_ThreadInfos.ExpandAndGetRef();
+        info.m_uiThreadId = buffer.m_uiThreadId;
+        info.m_sName = sThreadName;
+
+        for (CPUScope& scope : buffer.m_Data)
+        {
+          const char* szName = nullptr;
+          if (!functionNames.TryGetValue(scope.m_szFunctionName, szName))
+          {
+            ezString& sName = profilingData.m_StringStorage.ExpandAndGetRef();
+            sName = scope.m_szFunctionName;
+
+            szName = sName;
+            functionNames.Insert(scope.m_szFunctionName, szName);
+          }
+
+          scope.m_szFunctionName = szName;
+        }
+      }
+    }
   }
 }
 
 // static
-void ezProfilingSystem::SetDiscardThreshold(ezTime threshold)
+void ezProfilingSystem::StartStreamingCapture(ezStreamWriter& ref_output, ezTime flushInterval)
 {
-  CVarDiscardThresholdMs = static_cast<float>(threshold.GetMilliseconds());
+  EZ_LOCK(s_StreamingMutex);
+  EZ_ASSERT_DEV(s_pStreamingThread == nullptr, "A streaming capture is already running");
+
+  s_pStreamingThread = EZ_DEFAULT_NEW(ezProfilingStreamingThread, &ref_output, flushInterval);
+  s_pStreamingThread->Start();
 }
 
 // static
-void ezProfilingSystem::StartNewFrame()
+void ezProfilingSystem::StartStreamingCaptureToTelemetry(ezTime flushInterval)
+{
+  EZ_LOCK(s_StreamingMutex);
+  EZ_ASSERT_DEV(s_pStreamingThread == nullptr, "A streaming capture is already running");
+
+  s_pStreamingThread = EZ_DEFAULT_NEW(ezProfilingStreamingThread, nullptr, flushInterval);
+  s_pStreamingThread->Start();
+}
+
+// static
+void ezProfilingSystem::StopStreamingCapture()
+{
+  EZ_LOCK(s_StreamingMutex);
+
+  if (s_pStreamingThread == nullptr)
+    return;
+
+  s_pStreamingThread->Stop();
+  s_uiStreamingLostScopes = s_pStreamingThread->GetLostScopes();
+
+  EZ_DEFAULT_DELETE(s_pStreamingThread);
+}
+
+// static
+bool ezProfilingSystem::IsStreamingCaptureActive()
+{
+  EZ_LOCK(s_StreamingMutex);
+  return s_pStreamingThread != nullptr;
+}
+
+// static
+ezUInt64 ezProfilingSystem::GetStreamingCaptureLostScopes()
+{
+  EZ_LOCK(s_StreamingMutex);
+  return s_pStreamingThread != nullptr ? s_pStreamingThread->GetLostScopes() : s_uiStreamingLostScopes;
+}
+
+// static
+ezResult ezProfilingSystem::StartSampling(ezUInt32 uiSamplesPerSecond)
+{
+  EZ_LOCK(s_SamplingMutex);
+  EZ_ASSERT_DEV(uiSamplesPerSecond > 0, "Invalid sampling rate");
+
+  if (s_bSamplingActive)
+  {
+    StopSamplingTimer();
+    s_bSamplingActive = false;
+  }
+
+  if (s_pSamples == nullptr)
+  {
+    s_pSamples = EZ_DEFAULT_NEW(SamplesRingBuffer, SAMPLES_BUFFER_SIZE);
+  }
+
+  s_SamplingInterval = ezTime::Seconds(1.0 / uiSamplesPerSecond);
+  s_bSamplingActive = true;
+
+  if (StartSamplingTimer(s_SamplingInterval).Failed())
+  {
+    s_bSamplingActive = false;
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+}
+
+// static
+void ezProfilingSystem::StopSampling()
 {
-  ++s_uiFrameCount;
+  EZ_LOCK(s_SamplingMutex);
+
+  if (!s_bSamplingActive)
+    return;
 
-  if (!s_FrameStartTimes.CanAppend())
+  StopSamplingTimer();
+  s_bSamplingActive = false;
+
+  // signal handlers that already started may still be writing a sample
+  while (s_iSamplingHandlersRunning > 0)
   {
-    s_FrameStartTimes.PopFront();
+    ezThreadUtils::YieldTimeSlice();
   }
+}
+
+// static
+bool ezProfilingSystem::IsSamplingActive()
+{
+  return s_bSamplingActive;
+}
+
+// static
+void ezProfilingSystem::SetDiscardThreshold(ezTime threshold)
+{
+  CVarDiscardThresholdMs = static_cast<float>(threshold.GetMilliseconds());
+}
 
+// static
+ezTime ezProfilingSystem::GetDiscardThreshold()
+{
+  return ezTime::Milliseconds(CVarDiscardThresholdMs);
+}
+
+// static
+void ezProfilingSystem::StartNewFrame()
+{
   s_FrameStartTimes.PushBack(ezTime::Now());
 }
 
@@ -597,26 +1748,23 @@ void ezProfilingSystem::AddCPUScope(const char* szName, const char* szFunctionNa
   if (endTime - beginTime < ezTime::Milliseconds(CVarDiscardThresholdMs))
     return;
 
-  ::CpuScopesBufferBase* pScopes = s_CpuScopes;
+  CpuScopesBuffer* pScopes = s_CpuScopes;
 
   if (pScopes == nullptr)
   {
-    if (ezThreadUtils::IsMainThread())
-    {
-      pScopes = EZ_DEFAULT_NEW(::CpuScopesBuffer<BUFFER_SIZE_MAIN_THREAD>);
-    }
-    else
-    {
-      pScopes = EZ_DEFAULT_NEW(::CpuScopesBuffer<BUFFER_SIZE_OTHER_THREAD>);
-    }
+    const ezUInt32 uiBufferSize = ezThreadUtils::IsMainThread() ? BUFFER_SIZE_MAIN_THREAD : BUFFER_SIZE_OTHER_THREAD;
 
+    pScopes = EZ_DEFAULT_NEW(CpuScopesBuffer, uiBufferSize / sizeof(CPUScope));
     pScopes->m_uiThreadId = (ezUInt64)ezThreadUtils::GetCurrentThreadID();
     s_CpuScopes = pScopes;
 
+    // add the buffer to the front of the list without locking
+    void* pFirst = nullptr;
+    do
     {
-      EZ_LOCK(s_AllCpuScopesMutex);
-      s_AllCpuScopes.PushBack(pScopes);
-    }
+      pFirst = GetFirstCpuScopes();
+      pScopes->m_pNext = static_cast<CpuScopesBuffer*>(pFirst);
+    } while (!ezAtomicUtils::TestAndSet(reinterpret_cast<void**>(&s_pFirstCpuScopes), pFirst, pScopes));
   }
 
   CPUScope scope;
@@ -625,26 +1773,7 @@ void ezProfilingSystem::AddCPUScope(const char* szName, const char* szFunctionNa
   scope.m_EndTime = endTime;
   ezStringUtils::Copy(scope.m_szName, EZ_ARRAY_SIZE(scope.m_szName), szName);
 
-  if (ezThreadUtils::IsMainThread())
-  {
-    auto pMainThreadBuffer = CastToMainThreadEventBuffer(pScopes);
-    if (!pMainThreadBuffer->m_Data.CanAppend())
-    {
-      pMainThreadBuffer->m_Data.PopFront();
-    }
-
-    pMainThreadBuffer->m_Data.PushBack(scope);
-  }
-  else
-  {
-    auto pOtherThreadBuffer = CastToOtherThreadEventBuffer(pScopes);
-    if (!pOtherThreadBuffer->m_Data.CanAppend())
-    {
-      pOtherThreadBuffer->m_Data.PopFront();
-    }
-
-    pOtherThreadBuffer->m_Data.PushBack(scope);
-  }
+  pScopes->m_Data.PushBack(scope);
 }
 
 // static
@@ -652,8 +1781,6 @@ void ezProfilingSystem::Initialize()
 {
   SetThreadName("Main Thread");
 
-  s_MainThreadId = (ezUInt64)ezThreadUtils::GetCurrentThreadID();
-
   s_PluginEventSubscription = ezPlugin::s_PluginEvents.AddEventHandler(&PluginEvent);
 }
 
@@ -676,19 +1803,39 @@ void ezProfilingSystem::Reset()
         break;
       }
     }
-    for (ezUInt32 k = 0; k < s_AllCpuScopes.GetCount(); k++)
+
+    // Buffers of a re-used thread ID were added to the list after the buffer of the dead thread, so start at the back.
+    CpuScopesBuffer* pDeadBuffer = nullptr;
+    for (CpuScopesBuffer* pEventBuffer = GetFirstCpuScopes(); pEventBuffer != nullptr; pEventBuffer = pEventBuffer->m_pNext)
     {
-      CpuScopesBufferBase* pEventBuffer = s_AllCpuScopes[k];
       if (pEventBuffer->m_uiThreadId == uiThreadId)
       {
-        EZ_DEFAULT_DELETE(pEventBuffer);
-        // Forward order and no swap important, see comment above.
-        s_AllCpuScopes.RemoveAtAndCopy(k);
+        pDeadBuffer = pEventBuffer;
       }
     }
+
+    if (pDeadBuffer != nullptr)
+    {
+      DeleteCpuScopesBuffer(pDeadBuffer);
+    }
   }
   s_DeadThreadIDs.Clear();
 
+  // The calling thread releases its buffer as well. Should it record more scopes, a new buffer is created.
+  if (s_CpuScopes != nullptr)
+  {
+    DeleteCpuScopesBuffer(s_CpuScopes);
+    s_CpuScopes = nullptr;
+  }
+
+  {
+    EZ_LOCK(s_SamplingMutex);
+
+    // sampling was stopped before, so no signal handler accesses the samples anymore
+    EZ_DEFAULT_DELETE(s_pSamples);
+    ClearSampledFunctions();
+  }
+
   ezPlugin::s_PluginEvents.RemoveEventHandler(s_PluginEventSubscription);
 }
 
@@ -715,7 +1862,10 @@ void ezProfilingSystem::InitializeGPUData()
 {
   if (s_GPUScopes == nullptr)
   {
-    s_GPUScopes = EZ_DEFAULT_NEW(GPUScopesBuffer);
+    const ezUInt32 uiCapacity = BUFFER_SIZE_OTHER_THREAD / sizeof(GPUScope);
+
+    s_GPUScopesStorage = EZ_DEFAULT_NEW_RAW_BUFFER(GPUScope, uiCapacity);
+    s_GPUScopes = EZ_DEFAULT_NEW(GPUScopesBuffer, s_GPUScopesStorage, uiCapacity);
   }
 }
 
@@ -725,11 +1875,6 @@ void ezProfilingSystem::AddGPUScope(const char* szName, ezTime beginTime, ezTime
   if (endTime - beginTime < ezTime::Milliseconds(CVarDiscardThresholdMs))
     return;
 
-  if (!s_GPUScopes->CanAppend())
-  {
-    s_GPUScopes->PopFront();
-  }
-
   GPUScope scope;
   scope.m_BeginTime = beginTime;
   scope.m_EndTime = endTime;
@@ -795,12 +1940,50 @@ ezResult ezProfilingSystem::ProfilingData::Write(ezStreamWriter& outputStream) c
   return EZ_FAILURE;
 }
 
+ezResult ezProfilingSystem::ProfilingData::ReadStreamingCapture(ezStreamReader& inputStream)
+{
+  return EZ_FAILURE;
+}
+
 void ezProfilingSystem::Clear() {}
 
 void ezProfilingSystem::Capture(ezProfilingSystem::ProfilingData& out_Capture, bool bClearAfterCapture) {}
 
+void ezProfilingSystem::StartStreamingCapture(ezStreamWriter& ref_output, ezTime flushInterval) {}
+
+void ezProfilingSystem::StartStreamingCaptureToTelemetry(ezTime flushInterval) {}
+
+void ezProfilingSystem::StopStreamingCapture() {}
+
+bool ezProfilingSystem::IsStreamingCaptureActive()
+{
+  return false;
+}
+
+ezUInt64 ezProfilingSystem::GetStreamingCaptureLostScopes()
+{
+  return 0;
+}
+
+ezResult ezProfilingSystem::StartSampling(ezUInt32 uiSamplesPerSecond)
+{
+  return EZ_FAILURE;
+}
+
+void ezProfilingSystem::StopSampling() {}
+
+bool ezProfilingSystem::IsSamplingActive()
+{
+  return false;
+}
+
 void ezProfilingSystem::SetDiscardThreshold(ezTime threshold) {}
 
+ezTime ezProfilingSystem::GetDiscardThreshold()
+{
+  return ezTime::Zero();
+}
+
 void ezProfilingSystem::StartNewFrame() {}
 
 void ezProfilingSystem::AddCPUScope(const char* szName, const char* szFunctionName, ezTime beginTime, ezTime endTime) {}
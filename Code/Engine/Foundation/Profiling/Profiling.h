@@ -1,11 +1,13 @@
 #pragma once
 
 #include <Foundation/Basics.h>
+#include <Foundation/Containers/Deque.h>
 #include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/Containers/StaticRingBuffer.h>
 #include <Foundation/System/Process.h>
 #include <Foundation/Time/Time.h>
 
+class ezStreamReader;
 class ezStreamWriter;
 class ezThread;
 
@@ -109,9 +111,17 @@ public:
 
     ezDynamicArray<GPUScope> m_GPUScopes;
 
+    /// \brief Owns the function names of scopes that were read with ReadStreamingCapture().
+    ezDeque<ezString> m_StringStorage;
+
     /// \brief Writes profiling data as JSON to the output stream.
     ezResult Write(ezStreamWriter& outputStream) const;
 
+    /// \brief Reads the binary data of a streaming capture (see ezProfilingSystem::StartStreamingCapture()).
+    ///
+    /// Use Write() afterwards to convert the capture to JSON, which can be viewed in chrome://tracing or Perfetto.
+    ezResult ReadStreamingCapture(ezStreamReader& inputStream);
+
     void Clear();
 
     /// \brief Concatenates all given ProfilingData instances into one merge struct
@@ -121,11 +131,49 @@ public:
 public:
   static void Clear();
 
+  /// \brief Copies the profiling data that is currently stored in the ring buffers. Does not block the threads that record profiling data.
   static void Capture(ezProfilingSystem::ProfilingData& out_Capture, bool bClearAfterCapture = false);
 
+  /// \brief Starts a background thread that continuously writes all new profiling data to the given stream, in a compact binary format.
+  ///
+  /// This allows to record arbitrarily long sessions. The stream must stay valid until StopStreamingCapture() is called.
+  /// Threads that record profiling data are never blocked. If they record data faster than it is written, the oldest data is lost.
+  /// Use ProfilingData::ReadStreamingCapture() to read the data again.
+  static void StartStreamingCapture(ezStreamWriter& ref_output, ezTime flushInterval = ezTime::Milliseconds(100));
+
+  /// \brief Same as StartStreamingCapture(), but broadcasts the binary data through ezTelemetry (system 'PROF', message 'TRCE').
+  static void StartStreamingCaptureToTelemetry(ezTime flushInterval = ezTime::Milliseconds(100));
+
+  /// \brief Writes all remaining profiling data and stops the streaming capture.
+  static void StopStreamingCapture();
+
+  /// \brief Returns whether a streaming capture is currently running.
+  static bool IsStreamingCaptureActive();
+
+  /// \brief Returns how many scopes were overwritten in the ring buffers before the current or last streaming capture could write them.
+  static ezUInt64 GetStreamingCaptureLostScopes();
+
+  /// \brief Starts to periodically sample the call stacks of all busy threads, so that time spent in code without profiling scopes shows up
+  /// as well. Currently only supported on Linux.
+  ///
+  /// Samples are taken in proportion to the CPU time of each thread, idle threads are not sampled. Captures and streaming captures contain
+  /// the samples as a separate timeline next to each sampled thread, on which consecutive samples with the same callers are merged into
+  /// scopes. Function names are resolved through ezStackTracer, which only knows exported symbols. Functions of executables only get a name
+  /// if they are linked with -rdynamic, otherwise they are shown as the module and the offset within it.
+  static ezResult StartSampling(ezUInt32 uiSamplesPerSecond = 1000);
+
+  /// \brief Stops sampling. The samples that were taken so far stay available for Capture().
+  static void StopSampling();
+
+  /// \brief Returns whether call stacks are currently sampled.
+  static bool IsSamplingActive();
+
   /// \brief Scopes are discarded if their duration is shorter than the specified threshold. Default is 0.1ms.
   static void SetDiscardThreshold(ezTime threshold);
 
+  /// \brief Returns the threshold that was set with SetDiscardThreshold().
+  static ezTime GetDiscardThreshold();
+
   /// \brief Should be called once per frame to capture the timestamp of the new frame.
   static void StartNewFrame();
 
@@ -1,5 +1,6 @@
 #include <FoundationPCH.h>
 
+#include <Foundation/IO/OpenDdlPullReader.h>
 #include <Foundation/IO/OpenDdlReader.h>
 #include <Foundation/IO/OpenDdlUtils.h>
 #include <Foundation/IO/OpenDdlWriter.h>
@@ -178,19 +179,178 @@ static void ReadGraph(ezAbstractObjectGraph* pGraph, const ezOpenDdlReaderElemen
   }
 }
 
+/// \brief Reads the graph from the block object that \a reader just started, up to and including the end of that object.
+static void ReadGraph(ezAbstractObjectGraph* pGraph, ezOpenDdlPullReader& reader)
+{
+  using Event = ezOpenDdlPullReader::Event;
+
+  ezStringBuilder sType, sName;
+  ezHybridArray<ezAbstractObjectNode::Property, 32> properties;
+  ezVariant varTmp;
+
+  while (true)
+  {
+    const Event objectEvent = reader.Next();
+
+    if (objectEvent == Event::EndObject || objectEvent == Event::EndOfDocument)
+      return;
+
+    if (objectEvent != Event::BeginObject || !ezStringUtils::IsEqual(reader.GetCustomType(), "o"))
+    {
+      reader.SkipElement();
+      continue;
+    }
+
+    // the children of an object are read in any order and the node is only added once all of them are known
+    bool bHasGuid = false, bValidGuid = false, bHasType = false, bHasProps = false;
+    ezUuid guid;
+    ezUInt32 uiTypeVersion = 0;
+    sType.Clear();
+    sName.Clear();
+    properties.Clear();
+
+    while (true)
+    {
+      const Event childEvent = reader.Next();
+
+      if (childEvent == Event::EndObject || childEvent == Event::EndOfDocument)
+        break;
+
+      if (childEvent == Event::BeginObject && ezStringUtils::IsEqual(reader.GetName(), "id"))
+      {
+        bHasGuid = true;
+        const ezOpenDdlReaderElement* pGuid = reader.ReadElement();
+        bValidGuid = pGuid != nullptr && ezOpenDdlUtils::ConvertToUuid(pGuid, guid).Succeeded();
+      }
+      else if (childEvent == Event::BeginObject && ezStringUtils::IsEqual(reader.GetCustomType(), "p"))
+      {
+        bHasProps = true;
+
+        while (reader.Next() == Event::BeginObject || reader.GetEvent() == Event::BeginPrimitiveList)
+        {
+          if (!reader.HasName())
+          {
+            reader.SkipElement();
+            continue;
+          }
+
+          const ezOpenDdlReaderElement* pProp = reader.ReadElement();
+          if (pProp == nullptr || ezOpenDdlUtils::ConvertToVariant(pProp, varTmp).Failed())
+            continue;
+
+          auto& prop = properties.ExpandAndGetRef();
+          prop.m_szPropertyName = pGraph->RegisterString(pProp->GetName());
+          prop.m_Value = varTmp;
+        }
+      }
+      else if (childEvent == Event::BeginPrimitiveList && (reader.GetPrimitivesType() == ezOpenDdlPrimitiveType::String ||
+                                                             reader.GetPrimitivesType() == ezOpenDdlPrimitiveType::UInt32))
+      {
+        ezStringBuilder* pTarget = nullptr;
+        bool bIsVersion = false;
+
+        if (reader.GetPrimitivesType() == ezOpenDdlPrimitiveType::String && ezStringUtils::IsEqual(reader.GetName(), "t"))
+          pTarget = &sType;
+        else if (reader.GetPrimitivesType() == ezOpenDdlPrimitiveType::String && ezStringUtils::IsEqual(reader.GetName(), "n"))
+          pTarget = &sName;
+        else if (reader.GetPrimitivesType() == ezOpenDdlPrimitiveType::UInt32 && ezStringUtils::IsEqual(reader.GetName(), "v"))
+          bIsVersion = true;
+
+        bool bFirst = true;
+        while (reader.Next() == Event::Primitives)
+        {
+          if (bFirst && pTarget != nullptr && !reader.GetPrimitivesString().IsEmpty())
+          {
+            *pTarget = reader.GetPrimitivesString()[0];
+            bHasType |= pTarget == &sType;
+            bFirst = false;
+          }
+          else if (bFirst && bIsVersion && !reader.GetPrimitivesUInt32().IsEmpty())
+          {
+            uiTypeVersion = reader.GetPrimitivesUInt32()[0];
+            bFirst = false;
+          }
+        }
+      }
+      else
+      {
+        reader.SkipElement();
+      }
+    }
+
+    if (!bHasGuid || !bHasType || !bHasProps)
+    {
+      EZ_REPORT_FAILURE("Object contains invalid elements");
+      continue;
+    }
+
+    if (!bValidGuid)
+    {
+      EZ_REPORT_FAILURE("Object has an invalid guid");
+      continue;
+    }
+
+    auto* pNode = pGraph->AddNode(guid, sType, uiTypeVersion, sName);
+
+    for (const auto& prop : properties)
+    {
+      pNode->AddProperty(prop.m_szPropertyName, prop.m_Value);
+    }
+  }
+}
+
 ezResult ezAbstractGraphDdlSerializer::Read(
   ezStreamReader& stream, ezAbstractObjectGraph* pGraph, ezAbstractObjectGraph* pTypesGraph, bool bApplyPatches)
 {
-  ezOpenDdlReader reader;
-  if (reader.ParseDocument(stream, 0, ezLog::GetThreadLocalLogSystem()).Failed())
+  ezOpenDdlPullReader reader;
+  reader.SetInput(stream, 0, ezLog::GetThreadLocalLogSystem());
+
+  ezUniquePtr<ezAbstractObjectGraph> pOwnedTypesGraph;
+  ezAbstractObjectGraph* pTempTypesGraph = pTypesGraph;
+  if (pTempTypesGraph == nullptr)
+  {
+    pOwnedTypesGraph = EZ_DEFAULT_NEW(ezAbstractObjectGraph);
+    pTempTypesGraph = pOwnedTypesGraph.Borrow();
+  }
+
+  bool bFoundObjects = false;
+  while (reader.Next() != ezOpenDdlPullReader::Event::EndOfDocument)
+  {
+    if (reader.GetEvent() == ezOpenDdlPullReader::Event::BeginObject && ezStringUtils::IsEqual(reader.GetCustomType(), "Objects"))
+    {
+      ReadGraph(pGraph, reader);
+      bFoundObjects = true;
+    }
+    else if (reader.GetEvent() == ezOpenDdlPullReader::Event::BeginObject && ezStringUtils::IsEqual(reader.GetCustomType(), "Types"))
+    {
+      ReadGraph(pTempTypesGraph, reader);
+    }
+    else
+    {
+      reader.SkipElement();
+    }
+  }
+
+  if (reader.HadFatalParsingError())
   {
     ezLog::Error("Failed to parse DDL graph");
     return EZ_FAILURE;
   }
 
-  return Read(reader.GetRootElement(), pGraph, pTypesGraph, bApplyPatches);
-}
+  if (!bFoundObjects)
+  {
+    ezLog::Error("DDL graph does not contain an 'Objects' root object");
+    return EZ_FAILURE;
+  }
 
+  if (bApplyPatches)
+  {
+    ezGraphVersioning::GetSingleton()->PatchGraph(pTempTypesGraph);
+    ezGraphVersioning::GetSingleton()->PatchGraph(pGraph, pTempTypesGraph);
+  }
+
+  return EZ_SUCCESS;
+}
 
 ezResult ezAbstractGraphDdlSerializer::Read(const ezOpenDdlReaderElement* pRootElement, ezAbstractObjectGraph* pGraph,
   ezAbstractObjectGraph* pTypesGraph /*= nullptr*/, bool bApplyPatches /*= true*/)
@@ -232,19 +392,28 @@ ezResult ezAbstractGraphDdlSerializer::Read(const ezOpenDdlReaderElement* pRootE
 
 ezResult ezAbstractGraphDdlSerializer::ReadBlocks(ezStreamReader& stream, ezHybridArray<ezSerializedBlock, 3>& blocks)
 {
-  ezOpenDdlReader reader;
-  if (reader.ParseDocument(stream, 0, ezLog::GetThreadLocalLogSystem()).Failed())
+  ezOpenDdlPullReader reader;
+  reader.SetInput(stream, 0, ezLog::GetThreadLocalLogSystem());
+
+  while (reader.Next() != ezOpenDdlPullReader::Event::EndOfDocument)
   {
-    ezLog::Error("Failed to parse DDL graph");
-    return EZ_FAILURE;
+    if (reader.GetEvent() == ezOpenDdlPullReader::Event::BeginObject)
+    {
+      ezSerializedBlock* pBlock = GetOrCreateBlock(blocks, reader.GetCustomType());
+      ReadGraph(pBlock->m_Graph.Borrow(), reader);
+    }
+    else
+    {
+      reader.SkipElement();
+    }
   }
 
-  const ezOpenDdlReaderElement* pRoot = reader.GetRootElement();
-  for (const ezOpenDdlReaderElement* pChild = pRoot->GetFirstChild(); pChild != nullptr; pChild = pChild->GetSibling())
+  if (reader.HadFatalParsingError())
   {
-    ezSerializedBlock* pBlock = GetOrCreateBlock(blocks, pChild->GetCustomType());
-    ReadGraph(pBlock->m_Graph.Borrow(), pChild);
+    ezLog::Error("Failed to parse DDL graph");
+    return EZ_FAILURE;
   }
+
   return EZ_SUCCESS;
 }
 
@@ -0,0 +1,1569 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Configuration/Plugin.h>
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Reflection/ReflectionUtils.h>
+#include <Foundation/Serialization/AbstractObjectGraph.h>
+#include <Foundation/Serialization/GraphVersioning.h>
+#include <Foundation/Serialization/ReflectionBinarySerializer.h>
+#include <Foundation/Serialization/RttiConverter.h>
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/Mutex.h>
+#include <Foundation/Types/ScopeExit.h>
+
+struct ezReflectionBinarySerializerVersion
+{
+  enum Enum : ezUInt8
+  {
+    InvalidVersion = 0,
+    Version1,
+    // << insert new versions here >>
+
+    ENUM_COUNT,
+    CurrentVersion = ENUM_COUNT - 1 // automatically the highest version number
+  };
+};
+
+namespace
+{
+  /// \brief How a single entry of a plan is written and read.
+  enum class OpType : ezUInt8
+  {
+    PodRun,        ///< Directly accessible POD members that are adjacent in memory, copied as one block.
+    String,        ///< Directly accessible ezString member.
+    Variant,       ///< Any other standard type member, converted through ezVariant.
+    Enum,          ///< Enum or bitflags member, stored as ezInt64.
+    Class,         ///< Directly accessible embedded class.
+    ClassAccessor, ///< Embedded class that can only be accessed through Get/SetValuePtr.
+    OwnerPointer,  ///< Owned pointer, stores the type table index of the dynamic type followed by the object.
+    Array,         ///< Array of standard types. Elements of POD types are stored as raw bytes.
+    ArrayClass,    ///< Array of embedded classes.
+    Set,           ///< Set of standard types.
+    Map,           ///< Map of standard types.
+    MapClass,      ///< Map of embedded classes.
+  };
+
+  /// \brief Stored in the place of the type table index for owned pointers that are nullptr.
+  constexpr ezUInt32 s_uiNullObject = 0xFFFFFFFFu;
+
+  struct PodMember
+  {
+    const char* m_szName = nullptr;
+    ezUInt32 m_uiOffset = 0; ///< Relative to the start of the run.
+    ezVariantType::Enum m_Type = ezVariantType::Invalid;
+  };
+
+  struct Plan;
+
+  struct PlanOp
+  {
+    OpType m_Type = OpType::PodRun;
+    ezVariantType::Enum m_ElementType = ezVariantType::Invalid; ///< Array
+    ezUInt32 m_uiOffset = 0;                                   ///< PodRun, String, Class
+    ezUInt32 m_uiSize = 0;                                     ///< PodRun: size of the run, Array: size of a POD element or 0
+    ezUInt32 m_uiFirstMember = 0;                              ///< PodRun: index into Plan::m_PodMembers
+    ezUInt32 m_uiNumMembers = 0;                               ///< PodRun
+    ezAbstractProperty* m_pProperty = nullptr;                 ///< Everything but PodRun
+    Plan* m_pSubPlan = nullptr;                                ///< Class, ClassAccessor, ArrayClass, MapClass
+  };
+
+  struct Plan
+  {
+    enum class State : ezUInt8
+    {
+      Building,
+      Validating,
+      Done,
+    };
+
+    const ezRTTI* m_pType = nullptr;
+    ezDynamicArray<PlanOp> m_Ops;
+    ezDynamicArray<PodMember> m_PodMembers;
+
+    /// The serialized description of m_Ops, written in front of the data. Reading compares it byte by byte to detect changes.
+    ezDynamicArray<ezUInt8> m_Schema;
+
+    State m_State = State::Building;
+    bool m_bCanHandleType = true;     ///< false if the type itself uses unsupported features
+    bool m_bSupported = false;        ///< false if the type or any of its embedded types can't be handled
+    bool m_bHasOwnerPointers = false; ///< true if the type or any of its embedded classes has owned pointers
+  };
+
+  static ezMutex s_PlanMutex;
+  static ezHashTable<const ezRTTI*, Plan*, ezHashHelper<const ezRTTI*>, ezStaticAllocatorWrapper> s_Plans;
+
+  //////////////////////////////////////////////////////////////////////////
+
+  static bool IsPodVariantType(ezVariantType::Enum type)
+  {
+    return (type >= ezVariantType::Bool && type <= ezVariantType::Transform) || type == ezVariantType::Time || type == ezVariantType::Uuid ||
+           type == ezVariantType::Angle;
+  }
+
+  struct GetPodSizeFunc
+  {
+    template <typename T>
+    EZ_ALWAYS_INLINE void operator()()
+    {
+      if constexpr (std::is_trivially_copyable<T>::value)
+      {
+        m_uiSize = sizeof(T);
+      }
+      else
+      {
+        m_uiSize = 0;
+      }
+    }
+
+    ezUInt32 m_uiSize = 0;
+  };
+
+  /// \brief Returns the size of the raw data for the given variant type, or zero if values of this type can't be copied as raw bytes.
+  static ezUInt32 GetPodSize(ezVariantType::Enum type)
+  {
+    if (!IsPodVariantType(type))
+      return 0;
+
+    GetPodSizeFunc func;
+    ezVariant::DispatchTo(func, type);
+    return func.m_uiSize;
+  }
+
+  struct PodToVariantFunc
+  {
+    template <typename T>
+    EZ_ALWAYS_INLINE void operator()()
+    {
+      if constexpr (std::is_trivially_copyable<T>::value)
+      {
+        T value;
+        ezMemoryUtils::RawByteCopy(&value, m_pData, sizeof(T));
+        *m_pResult = value;
+      }
+      else
+      {
+        EZ_REPORT_FAILURE("Type is not a POD type");
+      }
+    }
+
+    const void* m_pData = nullptr;
+    ezVariant* m_pResult = nullptr;
+  };
+
+  static ezVariant PodToVariant(ezVariantType::Enum type, const void* pData)
+  {
+    ezVariant result;
+    PodToVariantFunc func;
+    func.m_pData = pData;
+    func.m_pResult = &result;
+    ezVariant::DispatchTo(func, type);
+    return result;
+  }
+
+  static bool HasOnObjectCreatedFunction(const ezRTTI* pType)
+  {
+    for (ezAbstractFunctionProperty* pFunc : pType->GetFunctions())
+    {
+      if (ezStringUtils::IsEqual(pFunc->GetPropertyName(), "OnObjectCreated"))
+        return true;
+    }
+
+    return false;
+  }
+
+  // The schemas are cached and compared byte by byte, so their strings must not go through an ezStringDeduplicationWriteContext.
+  static void WriteSchemaString(ezStreamWriter& stream, const char* szString)
+  {
+    const ezUInt32 uiLength = ezStringUtils::GetStringElementCount(szString);
+    stream << uiLength;
+    stream.WriteBytes(szString, uiLength).IgnoreResult();
+  }
+
+  /// \brief Schemas are read from data that may be corrupted, so all lengths and counts are checked against the size of the schema.
+  static bool HasRemainingBytes(const ezRawMemoryStreamReader& stream, ezUInt64 uiNumBytes)
+  {
+    return uiNumBytes <= stream.GetByteCount() - stream.GetReadPosition();
+  }
+
+  static ezResult ReadSchemaString(ezRawMemoryStreamReader& stream, ezString& out_sString)
+  {
+    ezUInt32 uiLength = 0;
+    stream >> uiLength;
+
+    if (!HasRemainingBytes(stream, uiLength))
+      return EZ_FAILURE;
+
+    ezHybridArray<char, 256> buffer;
+    buffer.SetCountUninitialized(uiLength);
+    stream.ReadBytes(buffer.GetData(), uiLength);
+
+    out_sString = ezStringView(buffer.GetData(), buffer.GetData() + uiLength);
+    return EZ_SUCCESS;
+  }
+
+  static const ezRTTI* GetDynamicType(const ezRTTI* pType, const void* pObject)
+  {
+    if (pType->IsDerivedFrom<ezReflectedClass>())
+      return static_cast<const ezReflectedClass*>(pObject)->GetDynamicRTTI();
+
+    return pType;
+  }
+
+  //////////////////////////////////////////////////////////////////////////
+  // Building plans
+  //////////////////////////////////////////////////////////////////////////
+
+  static Plan* GetPlanLocked(const ezRTTI* pType);
+
+  static void AddPodMember(Plan* pPlan, const char* szName, ezVariantType::Enum type, ezUInt32 uiOffset, ezUInt32 uiSize)
+  {
+    PodMember& member = pPlan->m_PodMembers.ExpandAndGetRef();
+    member.m_szName = szName;
+    member.m_Type = type;
+
+    if (!pPlan->m_Ops.IsEmpty())
+    {
+      PlanOp& lastOp = pPlan->m_Ops.PeekBack();
+      if (lastOp.m_Type == OpType::PodRun && lastOp.m_uiOffset + lastOp.m_uiSize == uiOffset)
+      {
+        member.m_uiOffset = lastOp.m_uiSize;
+        lastOp.m_uiSize += uiSize;
+        lastOp.m_uiNumMembers++;
+        return;
+      }
+    }
+
+    PlanOp& op = pPlan->m_Ops.ExpandAndGetRef();
+    op.m_Type = OpType::PodRun;
+    op.m_uiOffset = uiOffset;
+    op.m_uiSize = uiSize;
+    op.m_uiFirstMember = pPlan->m_PodMembers.GetCount() - 1;
+    op.m_uiNumMembers = 1;
+  }
+
+  static void AddOp(Plan* pPlan, OpType type, ezAbstractProperty* pProp, Plan* pSubPlan = nullptr)
+  {
+    PlanOp& op = pPlan->m_Ops.ExpandAndGetRef();
+    op.m_Type = type;
+    op.m_pProperty = pProp;
+    op.m_pSubPlan = pSubPlan;
+  }
+
+  /// \brief Mirrors ezRttiConverterWriter::AddProperty. Properties that the graph writer skips are skipped here as well.
+  static void AddProperty(Plan* pPlan, ezAbstractProperty* pProp, const void* pInstance)
+  {
+    if (pProp->GetFlags().IsSet(ezPropertyFlags::ReadOnly))
+      return;
+
+    const ezRTTI* pPropType = pProp->GetSpecificType();
+
+    switch (pProp->GetCategory())
+    {
+      case ezPropertyCategory::Member:
+      {
+        ezAbstractMemberProperty* pSpecific = static_cast<ezAbstractMemberProperty*>(pProp);
+
+        if (pProp->GetFlags().IsSet(ezPropertyFlags::Pointer))
+        {
+          if (pProp->GetFlags().IsSet(ezPropertyFlags::PointerOwner))
+            AddOp(pPlan, OpType::OwnerPointer, pProp);
+          else
+            pPlan->m_bCanHandleType = false;
+        }
+        else if (pProp->GetFlags().IsAnySet(ezPropertyFlags::IsEnum | ezPropertyFlags::Bitflags))
+        {
+          AddOp(pPlan, OpType::Enum, pProp);
+        }
+        else if (pProp->GetFlags().IsSet(ezPropertyFlags::StandardType))
+        {
+          const void* pMember = pSpecific->GetPropertyPointer(pInstance);
+
+          if (pMember != nullptr)
+          {
+            const ezUInt32 uiOffset = static_cast<ezUInt32>(static_cast<const ezUInt8*>(pMember) - static_cast<const ezUInt8*>(pInstance));
+            const ezUInt32 uiPodSize = GetPodSize(pPropType->GetVariantType());
+
+            if (uiPodSize != 0 && uiPodSize == pPropType->GetTypeSize())
+            {
+              AddPodMember(pPlan, pProp->GetPropertyName(), pPropType->GetVariantType(), uiOffset, uiPodSize);
+              break;
+            }
+
+            if (pPropType == ezGetStaticRTTI<ezString>())
+            {
+              AddOp(pPlan, OpType::String, pProp);
+              pPlan->m_Ops.PeekBack().m_uiOffset = uiOffset;
+              break;
+            }
+          }
+
+          AddOp(pPlan, OpType::Variant, pProp);
+        }
+        else if (pProp->GetFlags().IsSet(ezPropertyFlags::Class) && pPropType->GetProperties().GetCount() > 0)
+        {
+          const void* pMember = pSpecific->GetPropertyPointer(pInstance);
+
+          if (pMember != nullptr)
+          {
+            AddOp(pPlan, OpType::Class, pProp, GetPlanLocked(pPropType));
+            pPlan->m_Ops.PeekBack().m_uiOffset = static_cast<ezUInt32>(static_cast<const ezUInt8*>(pMember) - static_cast<const ezUInt8*>(pInstance));
+          }
+          else if (pPropType->GetAllocator()->CanAllocate())
+          {
+            AddOp(pPlan, OpType::ClassAccessor, pProp, GetPlanLocked(pPropType));
+          }
+        }
+      }
+      break;
+
+      case ezPropertyCategory::Array:
+      {
+        if (pProp->GetFlags().IsSet(ezPropertyFlags::Pointer))
+        {
+          pPlan->m_bCanHandleType = false;
+        }
+        else if (pProp->GetFlags().IsSet(ezPropertyFlags::StandardType))
+        {
+          AddOp(pPlan, OpType::Array, pProp);
+          PlanOp& op = pPlan->m_Ops.PeekBack();
+          op.m_ElementType = pPropType->GetVariantType();
+
+          const ezUInt32 uiPodSize = GetPodSize(op.m_ElementType);
+          if (uiPodSize == pPropType->GetTypeSize())
+            op.m_uiSize = uiPodSize;
+        }
+        else if (pProp->GetFlags().IsSet(ezPropertyFlags::Class) && pPropType->GetAllocator()->CanAllocate())
+        {
+          AddOp(pPlan, OpType::ArrayClass, pProp, GetPlanLocked(pPropType));
+        }
+      }
+      break;
+
+      case ezPropertyCategory::Set:
+      {
+        // the graph writer ignores sets of classes
+        if (pProp->GetFlags().IsSet(ezPropertyFlags::Pointer))
+          pPlan->m_bCanHandleType = false;
+        else if (pProp->GetFlags().IsSet(ezPropertyFlags::StandardType))
+          AddOp(pPlan, OpType::Set, pProp);
+      }
+      break;
+
+      case ezPropertyCategory::Map:
+      {
+        if (pProp->GetFlags().IsSet(ezPropertyFlags::Pointer))
+        {
+          pPlan->m_bCanHandleType = false;
+        }
+        else if (pProp->GetFlags().IsSet(ezPropertyFlags::StandardType))
+        {
+          AddOp(pPlan, OpType::Map, pProp);
+        }
+        else if (pProp->GetFlags().IsSet(ezPropertyFlags::Class))
+        {
+          if (pPropType->GetAllocator()->CanAllocate())
+            AddOp(pPlan, OpType::MapClass, pProp, GetPlanLocked(pPropType));
+          else
+            pPlan->m_bCanHandleType = false;
+        }
+      }
+      break;
+
+      default:
+        break;
+    }
+  }
+
+  static void WriteSchema(Plan* pPlan)
+  {
+    ezMemoryStreamContainerWrapperStorage<ezDynamicArray<ezUInt8>> storage(&pPlan->m_Schema);
+    ezMemoryStreamWriter schema(&storage);
+
+    ezUInt32 uiNumParents = 0;
+    for (const ezRTTI* pParent = pPlan->m_pType->GetParentType(); pParent != nullptr; pParent = pParent->GetParentType())
+      ++uiNumParents;
+
+    schema << uiNumParents;
+    for (const ezRTTI* pParent = pPlan->m_pType->GetParentType(); pParent != nullptr; pParent = pParent->GetParentType())
+    {
+      WriteSchemaString(schema, pParent->GetTypeName());
+      schema << pParent->GetTypeVersion();
+    }
+
+    schema << pPlan->m_Ops.GetCount();
+    for (const PlanOp& op : pPlan->m_Ops)
+    {
+      schema << static_cast<ezUInt8>(op.m_Type);
+
+      if (op.m_Type == OpType::PodRun)
+      {
+        schema << op.m_uiSize;
+        schema << op.m_uiNumMembers;
+
+        for (ezUInt32 i = 0; i < op.m_uiNumMembers; ++i)
+        {
+          const PodMember& member = pPlan->m_PodMembers[op.m_uiFirstMember + i];
+          WriteSchemaString(schema, member.m_szName);
+          schema << static_cast<ezUInt8>(member.m_Type);
+          schema << member.m_uiOffset;
+        }
+
+        continue;
+      }
+
+      WriteSchemaString(schema, op.m_pProperty->GetPropertyName());
+
+      if (op.m_Type == OpType::Enum)
+      {
+        WriteSchemaString(schema, op.m_pProperty->GetSpecificType()->GetTypeName());
+      }
+      else if (op.m_Type == OpType::Array)
+      {
+        schema << static_cast<ezUInt8>(op.m_ElementType);
+        schema << op.m_uiSize;
+      }
+      else if (op.m_pSubPlan != nullptr)
+      {
+        WriteSchemaString(schema, op.m_pSubPlan->m_pType->GetTypeName());
+      }
+    }
+  }
+
+  static void BuildPlan(Plan* pPlan, const ezRTTI* pType)
+  {
+    pPlan->m_pType = pType;
+
+    if (!pType->GetAllocator()->CanAllocate() || HasOnObjectCreatedFunction(pType))
+    {
+      pPlan->m_bCanHandleType = false;
+      return;
+    }
+
+    // The offsets of the directly accessible members are computed from an uninitialized block of the size of the type. The member
+    // accessors only do address arithmetic on it, so the type does not need to be constructed.
+    ezAllocatorBase* pAllocator = ezFoundation::GetAlignedAllocator();
+    void* pInstance = pAllocator->Allocate(ezMath::Max<size_t>(pType->GetTypeSize(), 1), 16);
+    EZ_SCOPE_EXIT(pAllocator->Deallocate(pInstance));
+
+    ezHybridArray<const ezRTTI*, 8> hierarchy;
+    for (const ezRTTI* pCurType = pType; pCurType != nullptr; pCurType = pCurType->GetParentType())
+      hierarchy.PushBack(pCurType);
+
+    for (ezUInt32 i = hierarchy.GetCount(); i > 0; --i)
+    {
+      for (ezAbstractProperty* pProp : hierarchy[i - 1]->GetProperties())
+      {
+        AddProperty(pPlan, pProp, pInstance);
+      }
+    }
+
+    if (pPlan->m_bCanHandleType)
+    {
+      WriteSchema(pPlan);
+    }
+  }
+
+  /// \brief Determines whether the plan and all plans of embedded classes can be handled.
+  static void ValidatePlan(Plan* pPlan)
+  {
+    if (pPlan->m_State != Plan::State::Building)
+      return;
+
+    // recursive references are only possible through containers, assume they are fine until proven otherwise
+    pPlan->m_State = Plan::State::Validating;
+    pPlan->m_bSupported = pPlan->m_bCanHandleType;
+
+    bool bSupported = pPlan->m_bCanHandleType;
+    bool bHasOwnerPointers = false;
+
+    for (const PlanOp& op : pPlan->m_Ops)
+    {
+      if (op.m_Type == OpType::OwnerPointer)
+        bHasOwnerPointers = true;
+
+      if (op.m_pSubPlan == nullptr)
+        continue;
+
+      ValidatePlan(op.m_pSubPlan);
+      bSupported &= op.m_pSubPlan->m_bSupported;
+
+      if (op.m_Type == OpType::Class)
+      {
+        bHasOwnerPointers |= op.m_pSubPlan->m_bHasOwnerPointers;
+      }
+      else if (op.m_pSubPlan->m_bHasOwnerPointers)
+      {
+        // temporary copies of objects with owned pointers would transfer or delete the pointees
+        bSupported = false;
+      }
+    }
+
+    pPlan->m_bSupported = bSupported;
+    pPlan->m_bHasOwnerPointers = bHasOwnerPointers;
+    pPlan->m_State = Plan::State::Done;
+  }
+
+  static Plan* GetPlanLocked(const ezRTTI* pType)
+  {
+    Plan* pPlan = nullptr;
+    if (s_Plans.TryGetValue(pType, pPlan))
+      return pPlan;
+
+    pPlan = EZ_DEFAULT_NEW(Plan);
+    s_Plans.Insert(pType, pPlan);
+
+    BuildPlan(pPlan, pType);
+    return pPlan;
+  }
+
+  static const Plan* GetPlan(const ezRTTI* pType)
+  {
+    EZ_LOCK(s_PlanMutex);
+
+    Plan* pPlan = GetPlanLocked(pType);
+    ValidatePlan(pPlan);
+    return pPlan;
+  }
+
+  //////////////////////////////////////////////////////////////////////////
+  // Writing
+  //////////////////////////////////////////////////////////////////////////
+
+  struct WriteContext
+  {
+    ezStreamWriter* m_pStream = nullptr;
+    ezHybridArray<const Plan*, 16> m_Types;
+    bool m_bFailed = false;
+
+    ezUInt32 AddType(const Plan* pPlan)
+    {
+      ezUInt32 uiIndex = m_Types.IndexOf(pPlan);
+      if (uiIndex != ezInvalidIndex)
+        return uiIndex;
+
+      uiIndex = m_Types.GetCount();
+      m_Types.PushBack(pPlan);
+
+      // the schema references embedded classes by name, so they need to be in the table as well
+      for (const PlanOp& op : pPlan->m_Ops)
+      {
+        if (op.m_pSubPlan != nullptr)
+          AddType(op.m_pSubPlan);
+      }
+
+      return uiIndex;
+    }
+  };
+
+  static void WriteProperties(const Plan& plan, const void* pObject, WriteContext& ctx)
+  {
+    ezStreamWriter& stream = *ctx.m_pStream;
+    const ezUInt8* pData = static_cast<const ezUInt8*>(pObject);
+
+    for (const PlanOp& op : plan.m_Ops)
+    {
+      switch (op.m_Type)
+      {
+        case OpType::PodRun:
+          stream.WriteBytes(pData + op.m_uiOffset, op.m_uiSize).IgnoreResult();
+          break;
+
+        case OpType::String:
+          stream << *reinterpret_cast<const ezString*>(pData + op.m_uiOffset);
+          break;
+
+        case OpType::Variant:
+        case OpType::Enum:
+          stream << ezReflectionUtils::GetMemberPropertyValue(static_cast<const ezAbstractMemberProperty*>(op.m_pProperty), pObject);
+          break;
+
+        case OpType::Class:
+          WriteProperties(*op.m_pSubPlan, pData + op.m_uiOffset, ctx);
+          break;
+
+        case OpType::ClassAccessor:
+        {
+          const ezRTTI* pPropType = op.m_pSubPlan->m_pType;
+          void* pSubObject = pPropType->GetAllocator()->Allocate<void>();
+          EZ_SCOPE_EXIT(pPropType->GetAllocator()->Deallocate(pSubObject));
+
+          static_cast<const ezAbstractMemberProperty*>(op.m_pProperty)->GetValuePtr(pObject, pSubObject);
+          WriteProperties(*op.m_pSubPlan, pSubObject, ctx);
+        }
+        break;
+
+        case OpType::OwnerPointer:
+        {
+          void* pPointee = nullptr;
+          static_cast<const ezAbstractMemberProperty*>(op.m_pProperty)->GetValuePtr(pObject, &pPointee);
+
+          if (pPointee == nullptr)
+          {
+            stream << s_uiNullObject;
+            break;
+          }
+
+          const Plan* pPointeePlan = GetPlan(GetDynamicType(op.m_pProperty->GetSpecificType(), pPointee));
+          if (!pPointeePlan->m_bSupported)
+          {
+            ctx.m_bFailed = true;
+            return;
+          }
+
+          stream << ctx.AddType(pPointeePlan);
+          WriteProperties(*pPointeePlan, pPointee, ctx);
+        }
+        break;
+
+        case OpType::Array:
+        {
+          const ezAbstractArrayProperty* pSpecific = static_cast<const ezAbstractArrayProperty*>(op.m_pProperty);
+          const ezUInt32 uiCount = pSpecific->GetCount(pObject);
+          stream << uiCount;
+
+          if (op.m_uiSize != 0)
+          {
+            ezUInt64 element[8];
+            EZ_ASSERT_DEBUG(op.m_uiSize <= sizeof(element), "POD element type is too large");
+
+            for (ezUInt32 i = 0; i < uiCount; ++i)
+            {
+              pSpecific->GetValue(pObject, i, element);
+              stream.WriteBytes(element, op.m_uiSize).IgnoreResult();
+            }
+          }
+          else
+          {
+            for (ezUInt32 i = 0; i < uiCount; ++i)
+            {
+              stream << ezReflectionUtils::GetArrayPropertyValue(pSpecific, pObject, i);
+            }
+          }
+        }
+        break;
+
+        case OpType::ArrayClass:
+        {
+          const ezAbstractArrayProperty* pSpecific = static_cast<const ezAbstractArrayProperty*>(op.m_pProperty);
+          const ezUInt32 uiCount = pSpecific->GetCount(pObject);
+          stream << uiCount;
+
+          const ezRTTI* pPropType = op.m_pSubPlan->m_pType;
+          void* pSubObject = pPropType->GetAllocator()->Allocate<void>();
+          EZ_SCOPE_EXIT(pPropType->GetAllocator()->Deallocate(pSubObject));
+
+          for (ezUInt32 i = 0; i < uiCount; ++i)
+          {
+            pSpecific->GetValue(pObject, i, pSubObject);
+            WriteProperties(*op.m_pSubPlan, pSubObject, ctx);
+          }
+        }
+        break;
+
+        case OpType::Set:
+        {
+          ezHybridArray<ezVariant, 16> values;
+          static_cast<const ezAbstractSetProperty*>(op.m_pProperty)->GetValues(pObject, values);
+
+          stream << values.GetCount();
+          for (const ezVariant& value : values)
+          {
+            stream << value;
+          }
+        }
+        break;
+
+        case OpType::Map:
+        {
+          const ezAbstractMapProperty* pSpecific = static_cast<const ezAbstractMapProperty*>(op.m_pProperty);
+
+          ezHybridArray<ezString, 16> keys;
+          pSpecific->GetKeys(pObject, keys);
+
+          stream << keys.GetCount();
+          for (const ezString& sKey : keys)
+          {
+            stream << sKey;
+            stream << ezReflectionUtils::GetMapPropertyValue(pSpecific, pObject, sKey);
+          }
+        }
+        break;
+
+        case OpType::MapClass:
+        {
+          const ezAbstractMapProperty* pSpecific = static_cast<const ezAbstractMapProperty*>(op.m_pProperty);
+
+          ezHybridArray<ezString, 16> keys;
+          pSpecific->GetKeys(pObject, keys);
+
+          const ezRTTI* pPropType = op.m_pSubPlan->m_pType;
+          void* pSubObject = pPropType->GetAllocator()->Allocate<void>();
+          EZ_SCOPE_EXIT(pPropType->GetAllocator()->Deallocate(pSubObject));
+
+          stream << keys.GetCount();
+          for (const ezString& sKey : keys)
+          {
+            EZ_VERIFY(pSpecific->GetValue(pObject, sKey, pSubObject), "Key should be valid.");
+
+            stream << sKey;
+            WriteProperties(*op.m_pSubPlan, pSubObject, ctx);
+          }
+        }
+        break;
+      }
+
+      if (ctx.m_bFailed)
+        return;
+    }
+  }
+
+  static void WriteHeader(ezStreamWriter& stream, const WriteContext& ctx)
+  {
+    const ezUInt8 uiVersion = ezReflectionBinarySerializerVersion::CurrentVersion;
+
+    stream << ezReflectionBinarySerializer::s_uiFormatTag;
+    stream << uiVersion;
+    stream << ctx.m_Types.GetCount();
+
+    for (const Plan* pPlan : ctx.m_Types)
+    {
+      stream << pPlan->m_pType->GetTypeName();
+      stream << pPlan->m_pType->GetTypeVersion();
+      stream << pPlan->m_Schema.GetCount();
+      stream.WriteBytes(pPlan->m_Schema.GetData(), pPlan->m_Schema.GetCount()).IgnoreResult();
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////
+  // Reading
+  //////////////////////////////////////////////////////////////////////////
+
+  struct TypeEntry
+  {
+    ezString m_sName;
+    ezUInt32 m_uiVersion = 0;
+    ezUInt32 m_uiSchemaOffset = 0;
+    ezUInt32 m_uiSchemaSize = 0;
+    const Plan* m_pPlan = nullptr; ///< The runtime plan, if its schema is identical
+  };
+
+  struct Header
+  {
+    ezHybridArray<TypeEntry, 16> m_Types;
+    ezHybridArray<ezUInt8, 1024> m_Schemas;
+    bool m_bAllTypesMatch = true;
+  };
+
+  static ezResult ReadHeader(ezStreamReader& stream, Header& header)
+  {
+    ezUInt32 uiTag = 0;
+    ezUInt8 uiVersion = 0;
+    stream >> uiTag;
+    stream >> uiVersion;
+
+    if (uiTag != ezReflectionBinarySerializer::s_uiFormatTag)
+    {
+      ezLog::Error("Data was not written by ezReflectionBinarySerializer.");
+      return EZ_FAILURE;
+    }
+
+    if (uiVersion == ezReflectionBinarySerializerVersion::InvalidVersion || uiVersion > ezReflectionBinarySerializerVersion::CurrentVersion)
+    {
+      ezLog::Error("Unsupported reflection binary format version {0}.", uiVersion);
+      return EZ_FAILURE;
+    }
+
+    ezUInt32 uiNumTypes = 0;
+    stream >> uiNumTypes;
+
+    if (uiNumTypes == 0)
+    {
+      ezLog::Error("Reflection binary data contains no types.");
+      return EZ_FAILURE;
+    }
+
+    // The counts and sizes in the header are not trusted, the arrays only grow as far as data could actually be read, so that corrupted
+    // data can't trigger huge allocations.
+    for (ezUInt32 uiType = 0; uiType < uiNumTypes; ++uiType)
+    {
+      TypeEntry& type = header.m_Types.ExpandAndGetRef();
+      stream >> type.m_sName;
+      stream >> type.m_uiVersion;
+      stream >> type.m_uiSchemaSize;
+
+      type.m_uiSchemaOffset = header.m_Schemas.GetCount();
+
+      for (ezUInt32 uiRead = 0; uiRead < type.m_uiSchemaSize;)
+      {
+        const ezUInt32 uiChunkSize = ezMath::Min<ezUInt32>(type.m_uiSchemaSize - uiRead, 4096);
+        header.m_Schemas.SetCountUninitialized(type.m_uiSchemaOffset + uiRead + uiChunkSize);
+
+        if (stream.ReadBytes(header.m_Schemas.GetData() + type.m_uiSchemaOffset + uiRead, uiChunkSize) != uiChunkSize)
+        {
+          ezLog::Error("Reflection binary data is truncated.");
+          return EZ_FAILURE;
+        }
+
+        uiRead += uiChunkSize;
+      }
+
+      const ezRTTI* pType = ezRTTI::FindTypeByName(type.m_sName);
+      if (pType != nullptr && pType->GetTypeVersion() == type.m_uiVersion)
+      {
+        const Plan* pPlan = GetPlan(pType);
+
+        if (pPlan->m_bSupported && pPlan->m_Schema.GetCount() == type.m_uiSchemaSize &&
+            ezMemoryUtils::IsEqual(pPlan->m_Schema.GetData(), header.m_Schemas.GetData() + type.m_uiSchemaOffset, type.m_uiSchemaSize))
+        {
+          type.m_pPlan = pPlan;
+        }
+      }
+
+      header.m_bAllTypesMatch &= (type.m_pPlan != nullptr);
+    }
+
+    return EZ_SUCCESS;
+  }
+
+  struct ReadContext
+  {
+    ezStreamReader* m_pStream = nullptr;
+    const Header* m_pHeader = nullptr;
+  };
+
+  static void ReadProperties(const Plan& plan, void* pObject, ReadContext& ctx)
+  {
+    ezStreamReader& stream = *ctx.m_pStream;
+    ezUInt8* pData = static_cast<ezUInt8*>(pObject);
+
+    for (const PlanOp& op : plan.m_Ops)
+    {
+      switch (op.m_Type)
+      {
+        case OpType::PodRun:
+          stream.ReadBytes(pData + op.m_uiOffset, op.m_uiSize);
+          break;
+
+        case OpType::String:
+          stream >> *reinterpret_cast<ezString*>(pData + op.m_uiOffset);
+          break;
+
+        case OpType::Variant:
+        case OpType::Enum:
+        {
+          ezVariant value;
+          stream >> value;
+          ezReflectionUtils::SetMemberPropertyValue(static_cast<ezAbstractMemberProperty*>(op.m_pProperty), pObject, value);
+        }
+        break;
+
+        case OpType::Class:
+          ReadProperties(*op.m_pSubPlan, pData + op.m_uiOffset, ctx);
+          break;
+
+        case OpType::ClassAccessor:
+        {
+          const ezRTTI* pPropType = op.m_pSubPlan->m_pType;
+          void* pSubObject = pPropType->GetAllocator()->Allocate<void>();
+          EZ_SCOPE_EXIT(pPropType->GetAllocator()->Deallocate(pSubObject));
+
+          ReadProperties(*op.m_pSubPlan, pSubObject, ctx);
+          static_cast<ezAbstractMemberProperty*>(op.m_pProperty)->SetValuePtr(pObject, pSubObject);
+        }
+        break;
+
+        case OpType::OwnerPointer:
+        {
+          ezUInt32 uiTypeIndex = s_uiNullObject;
+          stream >> uiTypeIndex;
+
+          void* pPointee = nullptr;
+          if (uiTypeIndex < ctx.m_pHeader->m_Types.GetCount())
+          {
+            const Plan* pPointeePlan = ctx.m_pHeader->m_Types[uiTypeIndex].m_pPlan;
+            pPointee = pPointeePlan->m_pType->GetAllocator()->Allocate<void>();
+            ReadProperties(*pPointeePlan, pPointee, ctx);
+          }
+
+          ezAbstractMemberProperty* pSpecific = static_cast<ezAbstractMemberProperty*>(op.m_pProperty);
+
+          void* pOldPointee = nullptr;
+          pSpecific->GetValuePtr(pObject, &pOldPointee);
+          pSpecific->SetValuePtr(pObject, &pPointee);
+          ezReflectionUtils::DeleteObject(pOldPointee, op.m_pProperty);
+        }
+        break;
+
+        case OpType::Array:
+        {
+          ezAbstractArrayProperty* pSpecific = static_cast<ezAbstractArrayProperty*>(op.m_pProperty);
+
+          ezUInt32 uiCount = 0;
+          stream >> uiCount;
+          pSpecific->SetCount(pObject, uiCount);
+
+          if (op.m_uiSize != 0)
+          {
+            ezUInt64 element[8];
+
+            for (ezUInt32 i = 0; i < uiCount; ++i)
+            {
+              stream.ReadBytes(element, op.m_uiSize);
+              pSpecific->SetValue(pObject, i, element);
+            }
+          }
+          else
+          {
+            ezVariant value;
+            for (ezUInt32 i = 0; i < uiCount; ++i)
+            {
+              stream >> value;
+              ezReflectionUtils::SetArrayPropertyValue(pSpecific, pObject, i, value);
+            }
+          }
+        }
+        break;
+
+        case OpType::ArrayClass:
+        {
+          ezAbstractArrayProperty* pSpecific = static_cast<ezAbstractArrayProperty*>(op.m_pProperty);
+
+          ezUInt32 uiCount = 0;
+          stream >> uiCount;
+          pSpecific->SetCount(pObject, uiCount);
+
+          const ezRTTI* pPropType = op.m_pSubPlan->m_pType;
+          void* pSubObject = pPropType->GetAllocator()->Allocate<void>();
+          EZ_SCOPE_EXIT(pPropType->GetAllocator()->Deallocate(pSubObject));
+
+          for (ezUInt32 i = 0; i < uiCount; ++i)
+          {
+            ReadProperties(*op.m_pSubPlan, pSubObject, ctx);
+            pSpecific->SetValue(pObject, i, pSubObject);
+          }
+        }
+        break;
+
+        case OpType::Set:
+        {
+          ezAbstractSetProperty* pSpecific = static_cast<ezAbstractSetProperty*>(op.m_pProperty);
+          pSpecific->Clear(pObject);
+
+          ezUInt32 uiCount = 0;
+          stream >> uiCount;
+
+          ezVariant value;
+          for (ezUInt32 i = 0; i < uiCount; ++i)
+          {
+            stream >> value;
+            ezReflectionUtils::InsertSetPropertyValue(pSpecific, pObject, value);
+          }
+        }
+        break;
+
+        case OpType::Map:
+        {
+          ezAbstractMapProperty* pSpecific = static_cast<ezAbstractMapProperty*>(op.m_pProperty);
+          pSpecific->Clear(pObject);
+
+          ezUInt32 uiCount = 0;
+          stream >> uiCount;
+
+          ezStringBuilder sKey;
+          ezVariant value;
+          for (ezUInt32 i = 0; i < uiCount; ++i)
+          {
+            stream >> sKey;
+            stream >> value;
+            ezReflectionUtils::SetMapPropertyValue(pSpecific, pObject, sKey, value);
+          }
+        }
+        break;
+
+        case OpType::MapClass:
+        {
+          ezAbstractMapProperty* pSpecific = static_cast<ezAbstractMapProperty*>(op.m_pProperty);
+          pSpecific->Clear(pObject);
+
+          ezUInt32 uiCount = 0;
+          stream >> uiCount;
+
+          const ezRTTI* pPropType = op.m_pSubPlan->m_pType;
+          void* pSubObject = pPropType->GetAllocator()->Allocate<void>();
+          EZ_SCOPE_EXIT(pPropType->GetAllocator()->Deallocate(pSubObject));
+
+          ezStringBuilder sKey;
+          for (ezUInt32 i = 0; i < uiCount; ++i)
+          {
+            stream >> sKey;
+            ReadProperties(*op.m_pSubPlan, pSubObject, ctx);
+            pSpecific->Insert(pObject, sKey, pSubObject);
+          }
+        }
+        break;
+      }
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////
+  // Decoding into an ezAbstractObjectGraph, used when the schemas differ from the runtime types
+  //////////////////////////////////////////////////////////////////////////
+
+  struct SchemaMember
+  {
+    ezString m_sName;
+    ezVariantType::Enum m_Type = ezVariantType::Invalid;
+    ezUInt32 m_uiOffset = 0;
+  };
+
+  struct SchemaOp
+  {
+    OpType m_Type = OpType::PodRun;
+    ezString m_sName;
+    ezUInt32 m_uiSize = 0;
+    ezVariantType::Enum m_ElementType = ezVariantType::Invalid;
+    ezString m_sTypeName; ///< Enum type or embedded class type
+    ezUInt32 m_uiSubType = s_uiNullObject;
+    ezDynamicArray<SchemaMember> m_Members;
+  };
+
+  struct TypeSchema
+  {
+    ezHybridArray<ezString, 4> m_ParentNames;
+    ezHybridArray<ezUInt32, 4> m_ParentVersions;
+    ezDynamicArray<SchemaOp> m_Ops;
+  };
+
+  struct DecodeContext
+  {
+    ezStreamReader* m_pStream = nullptr;
+    const Header* m_pHeader = nullptr;
+    ezDynamicArray<TypeSchema> m_Schemas;
+    ezAbstractObjectGraph* m_pGraph = nullptr;
+  };
+
+  static ezResult ParseSchemas(DecodeContext& ctx)
+  {
+    const Header& header = *ctx.m_pHeader;
+    ctx.m_Schemas.SetCount(header.m_Types.GetCount());
+
+    for (ezUInt32 uiType = 0; uiType < header.m_Types.GetCount(); ++uiType)
+    {
+      const TypeEntry& type = header.m_Types[uiType];
+      TypeSchema& schema = ctx.m_Schemas[uiType];
+
+      ezRawMemoryStreamReader reader(header.m_Schemas.GetData() + type.m_uiSchemaOffset, type.m_uiSchemaSize);
+
+      auto InvalidSchema = [&type]() -> ezResult {
+        ezLog::Error("Invalid schema for type '{0}'.", type.m_sName);
+        return EZ_FAILURE;
+      };
+
+      // every parent, op and member takes up at least one byte, which limits the counts
+      ezUInt32 uiNumParents = 0;
+      reader >> uiNumParents;
+      if (!HasRemainingBytes(reader, uiNumParents))
+        return InvalidSchema();
+
+      schema.m_ParentNames.SetCount(uiNumParents);
+      schema.m_ParentVersions.SetCount(uiNumParents);
+
+      for (ezUInt32 i = 0; i < uiNumParents; ++i)
+      {
+        if (ReadSchemaString(reader, schema.m_ParentNames[i]).Failed())
+          return InvalidSchema();
+
+        reader >> schema.m_ParentVersions[i];
+      }
+
+      ezUInt32 uiNumOps = 0;
+      reader >> uiNumOps;
+      if (!HasRemainingBytes(reader, uiNumOps))
+        return InvalidSchema();
+
+      schema.m_Ops.SetCount(uiNumOps);
+
+      for (SchemaOp& op : schema.m_Ops)
+      {
+        ezUInt8 uiOpType = 0;
+        reader >> uiOpType;
+        op.m_Type = static_cast<OpType>(uiOpType);
+
+        if (op.m_Type == OpType::PodRun)
+        {
+          ezUInt32 uiNumMembers = 0;
+          reader >> op.m_uiSize;
+          reader >> uiNumMembers;
+          if (!HasRemainingBytes(reader, uiNumMembers))
+            return InvalidSchema();
+
+          op.m_Members.SetCount(uiNumMembers);
+
+          for (SchemaMember& member : op.m_Members)
+          {
+            ezUInt8 uiMemberType = 0;
+            if (ReadSchemaString(reader, member.m_sName).Failed())
+              return InvalidSchema();
+
+            reader >> uiMemberType;
+            reader >> member.m_uiOffset;
+            member.m_Type = static_cast<ezVariantType::Enum>(uiMemberType);
+
+            if (member.m_uiOffset + GetPodSize(member.m_Type) > op.m_uiSize)
+              return InvalidSchema();
+          }
+
+          continue;
+        }
+
+        if (ReadSchemaString(reader, op.m_sName).Failed())
+          return InvalidSchema();
+
+        switch (op.m_Type)
+        {
+          case OpType::Enum:
+            if (ReadSchemaString(reader, op.m_sTypeName).Failed())
+              return InvalidSchema();
+            break;
+
+          case OpType::Array:
+          {
+            ezUInt8 uiElementType = 0;
+            reader >> uiElementType;
+            reader >> op.m_uiSize;
+            op.m_ElementType = static_cast<ezVariantType::Enum>(uiElementType);
+
+            if (op.m_uiSize != 0 && op.m_uiSize != GetPodSize(op.m_ElementType))
+              return InvalidSchema();
+          }
+          break;
+
+          case OpType::Class:
+          case OpType::ClassAccessor:
+          case OpType::ArrayClass:
+          case OpType::MapClass:
+          {
+            if (ReadSchemaString(reader, op.m_sTypeName).Failed())
+              return InvalidSchema();
+
+            for (ezUInt32 i = 0; i < header.m_Types.GetCount(); ++i)
+            {
+              if (header.m_Types[i].m_sName == op.m_sTypeName)
+              {
+                op.m_uiSubType = i;
+                break;
+              }
+            }
+
+            if (op.m_uiSubType == s_uiNullObject)
+            {
+              ezLog::Error("Schema of type '{0}' references unknown type '{1}'.", type.m_sName, op.m_sTypeName);
+              return EZ_FAILURE;
+            }
+          }
+          break;
+
+          case OpType::PodRun:
+          case OpType::String:
+          case OpType::Variant:
+          case OpType::OwnerPointer:
+          case OpType::Set:
+          case OpType::Map:
+            break;
+
+          default:
+            return InvalidSchema();
+        }
+      }
+    }
+
+    return EZ_SUCCESS;
+  }
+
+  /// \brief Same as ezRttiConverterContext::GenerateObjectGuid.
+  static ezUuid GenerateObjectGuid(const ezUuid& parentGuid, const char* szProperty, const ezUuid& index = ezUuid())
+  {
+    ezUuid guid = parentGuid;
+    guid.HashCombine(ezUuid::StableUuidForString(szProperty));
+
+    if (index.IsValid())
+      guid.HashCombine(index);
+
+    return guid;
+  }
+
+  static void DecodeObject(ezUInt32 uiType, const ezUuid& guid, DecodeContext& ctx, const char* szNodeName = nullptr);
+
+  static ezVariant ReadPodOrVariant(ezStreamReader& stream, ezVariantType::Enum type, ezUInt32 uiPodSize)
+  {
+    if (uiPodSize == 0)
+    {
+      ezVariant value;
+      stream >> value;
+      return value;
+    }
+
+    ezUInt64 element[8];
+    stream.ReadBytes(element, uiPodSize);
+    return PodToVariant(type, element);
+  }
+
+  static void DecodeProperties(const TypeSchema& schema, ezAbstractObjectNode* pNode, DecodeContext& ctx)
+  {
+    ezStreamReader& stream = *ctx.m_pStream;
+    ezHybridArray<ezUInt8, 256> podData;
+
+    for (const SchemaOp& op : schema.m_Ops)
+    {
+      switch (op.m_Type)
+      {
+        case OpType::PodRun:
+        {
+          podData.SetCountUninitialized(op.m_uiSize);
+          stream.ReadBytes(podData.GetData(), op.m_uiSize);
+
+          for (const SchemaMember& member : op.m_Members)
+          {
+            pNode->AddProperty(member.m_sName, PodToVariant(member.m_Type, podData.GetData() + member.m_uiOffset));
+          }
+        }
+        break;
+
+        case OpType::String:
+        {
+          ezStringBuilder sValue;
+          stream >> sValue;
+          pNode->AddProperty(op.m_sName, sValue.GetData());
+        }
+        break;
+
+        case OpType::Variant:
+        {
+          ezVariant value;
+          stream >> value;
+          pNode->AddProperty(op.m_sName, value);
+        }
+        break;
+
+        case OpType::Enum:
+        {
+          ezVariant value;
+          stream >> value;
+
+          // the graph stores enums as strings, which is what patches expect
+          ezStringBuilder sTemp;
+          const ezRTTI* pEnumType = ezRTTI::FindTypeByName(op.m_sTypeName);
+          if (pEnumType != nullptr && value.IsA<ezInt64>() && ezReflectionUtils::EnumerationToString(pEnumType, value.Get<ezInt64>(), sTemp))
+            pNode->AddProperty(op.m_sName, sTemp.GetData());
+          else
+            pNode->AddProperty(op.m_sName, value);
+        }
+        break;
+
+        case OpType::Class:
+        case OpType::ClassAccessor:
+        {
+          const ezUuid subGuid = GenerateObjectGuid(pNode->GetGuid(), op.m_sName);
+          pNode->AddProperty(op.m_sName, subGuid);
+          DecodeObject(op.m_uiSubType, subGuid, ctx);
+        }
+        break;
+
+        case OpType::OwnerPointer:
+        {
+          ezUInt32 uiTypeIndex = s_uiNullObject;
+          stream >> uiTypeIndex;
+
+          if (uiTypeIndex >= ctx.m_pHeader->m_Types.GetCount())
+          {
+            pNode->AddProperty(op.m_sName, ezUuid());
+            break;
+          }
+
+          const ezUuid subGuid = GenerateObjectGuid(pNode->GetGuid(), op.m_sName);
+          pNode->AddProperty(op.m_sName, subGuid);
+          DecodeObject(uiTypeIndex, subGuid, ctx);
+        }
+        break;
+
+        case OpType::Array:
+        case OpType::Set:
+        {
+          ezUInt32 uiCount = 0;
+          stream >> uiCount;
+
+          ezVariantArray values;
+          values.SetCount(uiCount);
+
+          for (ezUInt32 i = 0; i < uiCount; ++i)
+          {
+            values[i] = ReadPodOrVariant(stream, op.m_ElementType, op.m_uiSize);
+          }
+
+          pNode->AddProperty(op.m_sName, values);
+        }
+        break;
+
+        case OpType::ArrayClass:
+        {
+          ezUInt32 uiCount = 0;
+          stream >> uiCount;
+
+          ezVariantArray values;
+          values.SetCount(uiCount);
+
+          for (ezUInt32 i = 0; i < uiCount; ++i)
+          {
+            const ezUuid subGuid = GenerateObjectGuid(pNode->GetGuid(), op.m_sName, ezUuid::StableUuidForInt(i));
+            DecodeObject(op.m_uiSubType, subGuid, ctx);
+            values[i] = subGuid;
+          }
+
+          pNode->AddProperty(op.m_sName, values);
+        }
+        break;
+
+        case OpType::Map:
+        case OpType::MapClass:
+        {
+          ezUInt32 uiCount = 0;
+          stream >> uiCount;
+
+          ezVariantDictionary values;
+          values.Reserve(uiCount);
+
+          ezStringBuilder sKey;
+          for (ezUInt32 i = 0; i < uiCount; ++i)
+          {
+            stream >> sKey;
+
+            if (op.m_Type == OpType::Map)
+            {
+              ezVariant value;
+              stream >> value;
+              values.Insert(sKey, value);
+            }
+            else
+            {
+              const ezUuid subGuid = GenerateObjectGuid(pNode->GetGuid(), op.m_sName, ezUuid::StableUuidForString(sKey));
+              DecodeObject(op.m_uiSubType, subGuid, ctx);
+              values.Insert(sKey, subGuid);
+            }
+          }
+
+          pNode->AddProperty(op.m_sName, values);
+        }
+        break;
+      }
+    }
+  }
+
+  static void DecodeObject(ezUInt32 uiType, const ezUuid& guid, DecodeContext& ctx, const char* szNodeName)
+  {
+    const TypeEntry& type = ctx.m_pHeader->m_Types[uiType];
+    ezAbstractObjectNode* pNode = ctx.m_pGraph->AddNode(guid, type.m_sName, type.m_uiVersion, szNodeName);
+    DecodeProperties(ctx.m_Schemas[uiType], pNode, ctx);
+  }
+
+  /// \brief Decodes the data into a graph, the same way ezRttiConverterWriter would have written it, and applies the type patches.
+  static ezAbstractObjectNode* DecodeGraph(ezStreamReader& stream, const Header& header, ezAbstractObjectGraph& graph)
+  {
+    DecodeContext ctx;
+    ctx.m_pStream = &stream;
+    ctx.m_pHeader = &header;
+    ctx.m_pGraph = &graph;
+
+    if (ParseSchemas(ctx).Failed())
+      return nullptr;
+
+    ezUuid rootGuid;
+    rootGuid.CreateNewUuid();
+    DecodeObject(0, rootGuid, ctx, "root");
+
+    if (ezGraphVersioning::GetSingleton() != nullptr)
+    {
+      // the type information of all written types, like the editor stores it in its documents
+      ezAbstractObjectGraph typesGraph;
+      auto AddTypeNode = [&](const ezString& sName, ezUInt32 uiVersion, const char* szParent) {
+        const ezUuid typeGuid = ezUuid::StableUuidForString(sName);
+        if (typesGraph.GetNode(typeGuid) != nullptr)
+          return;
+
+        ezAbstractObjectNode* pTypeNode = typesGraph.AddNode(typeGuid, "ezReflectedTypeDescriptor", 1);
+        pTypeNode->AddProperty("TypeName", sName.GetData());
+        pTypeNode->AddProperty("ParentTypeName", szParent);
+        pTypeNode->AddProperty("TypeVersion", uiVersion);
+      };
+
+      for (ezUInt32 uiType = 0; uiType < header.m_Types.GetCount(); ++uiType)
+      {
+        const TypeSchema& schema = ctx.m_Schemas[uiType];
+        const ezUInt32 uiNumParents = schema.m_ParentNames.GetCount();
+
+        AddTypeNode(header.m_Types[uiType].m_sName, header.m_Types[uiType].m_uiVersion, uiNumParents > 0 ? schema.m_ParentNames[0].GetData() : "");
+        for (ezUInt32 i = 0; i < uiNumParents; ++i)
+        {
+          AddTypeNode(schema.m_ParentNames[i], schema.m_ParentVersions[i], i + 1 < uiNumParents ? schema.m_ParentNames[i + 1].GetData() : "");
+        }
+      }
+
+      // the types graph is generated from the stream, so unlike the graph serializers there are no type descriptors to patch
+      ezGraphVersioning::GetSingleton()->PatchGraph(&graph, &typesGraph);
+    }
+
+    return graph.GetNodeByName("root");
+  }
+
+  //////////////////////////////////////////////////////////////////////////
+
+  static void PluginEventHandler(const ezPluginEvent& e)
+  {
+    if (e.m_EventType == ezPluginEvent::BeforeUnloading)
+    {
+      ezReflectionBinarySerializer::ClearCache();
+    }
+  }
+} // namespace
+
+// clang-format off
+EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, ReflectionBinarySerializer)
+
+  BEGIN_SUBSYSTEM_DEPENDENCIES
+  "Reflection"
+  END_SUBSYSTEM_DEPENDENCIES
+
+  ON_CORESYSTEMS_STARTUP
+  {
+    ezPlugin::s_PluginEvents.AddEventHandler(PluginEventHandler);
+  }
+
+  ON_CORESYSTEMS_SHUTDOWN
+  {
+    ezPlugin::s_PluginEvents.RemoveEventHandler(PluginEventHandler);
+    ezReflectionBinarySerializer::ClearCache();
+  }
+
+EZ_END_SUBSYSTEM_DECLARATION;
+// clang-format on
+
+ezResult ezReflectionBinarySerializer::WriteObject(ezStreamWriter& stream, const ezRTTI* pRtti, const void* pObject)
+{
+  const Plan* pPlan = GetPlan(pRtti);
+  if (!pPlan->m_bSupported)
+    return EZ_FAILURE;
+
+  WriteContext ctx;
+  ctx.AddType(pPlan);
+
+  if (!pPlan->m_bHasOwnerPointers)
+  {
+    // all types are known up front, the data can go directly to the stream
+    ctx.m_pStream = &stream;
+    WriteHeader(stream, ctx);
+    WriteProperties(*pPlan, pObject, ctx);
+    return EZ_SUCCESS;
+  }
+
+  // the types of the owned objects are only known after walking them
+  ezMemoryStreamStorage storage;
+  ezMemoryStreamWriter writer(&storage);
+  ctx.m_pStream = &writer;
+
+  WriteProperties(*pPlan, pObject, ctx);
+  if (ctx.m_bFailed)
+    return EZ_FAILURE;
+
+  WriteHeader(stream, ctx);
+  return stream.WriteBytes(storage.GetData(), storage.GetStorageSize());
+}
+
+void* ezReflectionBinarySerializer::ReadObject(ezStreamReader& stream, const ezRTTI*& out_pRtti)
+{
+  out_pRtti = nullptr;
+
+  Header header;
+  if (ReadHeader(stream, header).Failed())
+    return nullptr;
+
+  if (header.m_bAllTypesMatch)
+  {
+    const Plan* pPlan = header.m_Types[0].m_pPlan;
+
+    out_pRtti = pPlan->m_pType;
+    void* pObject = pPlan->m_pType->GetAllocator()->Allocate<void>();
+
+    ReadContext ctx;
+    ctx.m_pStream = &stream;
+    ctx.m_pHeader = &header;
+    ReadProperties(*pPlan, pObject, ctx);
+
+    return pObject;
+  }
+
+  ezAbstractObjectGraph graph;
+  ezAbstractObjectNode* pRootNode = DecodeGraph(stream, header, graph);
+  if (pRootNode == nullptr)
+    return nullptr;
+
+  out_pRtti = ezRTTI::FindTypeByName(pRootNode->GetType());
+  if (out_pRtti == nullptr)
+  {
+    ezLog::Error("RTTI type '{0}' is unknown, ReadObject failed.", pRootNode->GetType());
+    return nullptr;
+  }
+
+  ezRttiConverterContext context;
+  ezRttiConverterReader convRead(&graph, &context);
+
+  void* pObject = context.CreateObject(pRootNode->GetGuid(), out_pRtti);
+  if (pObject != nullptr)
+  {
+    convRead.ApplyPropertiesToObject(pRootNode, out_pRtti, pObject);
+  }
+
+  return pObject;
+}
+
+ezResult ezReflectionBinarySerializer::ReadObjectProperties(ezStreamReader& stream, const ezRTTI& rtti, void* pObject)
+{
+  Header header;
+  EZ_SUCCEED_OR_RETURN(ReadHeader(stream, header));
+
+  if (header.m_bAllTypesMatch && header.m_Types[0].m_pPlan->m_pType == &rtti)
+  {
+    ReadContext ctx;
+    ctx.m_pStream = &stream;
+    ctx.m_pHeader = &header;
+    ReadProperties(*header.m_Types[0].m_pPlan, pObject, ctx);
+
+    return EZ_SUCCESS;
+  }
+
+  ezAbstractObjectGraph graph;
+  ezAbstractObjectNode* pRootNode = DecodeGraph(stream, header, graph);
+  if (pRootNode == nullptr)
+    return EZ_FAILURE;
+
+  ezRttiConverterContext context;
+  ezRttiConverterReader convRead(&graph, &context);
+  convRead.ApplyPropertiesToObject(pRootNode, &rtti, pObject);
+
+  return EZ_SUCCESS;
+}
+
+void ezReflectionBinarySerializer::ClearCache()
+{
+  EZ_LOCK(s_PlanMutex);
+
+  for (auto it = s_Plans.GetIterator(); it.IsValid(); ++it)
+  {
+    EZ_DEFAULT_DELETE(it.Value());
+  }
+
+  s_Plans.Clear();
+  s_Plans.Compact();
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Serialization_Implementation_ReflectionBinarySerializer);
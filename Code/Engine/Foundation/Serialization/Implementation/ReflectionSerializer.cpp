@@ -5,10 +5,51 @@
 #include <Foundation/Reflection/ReflectionUtils.h>
 #include <Foundation/Serialization/BinarySerializer.h>
 #include <Foundation/Serialization/DdlSerializer.h>
+#include <Foundation/Serialization/ReflectionBinarySerializer.h>
 #include <Foundation/Serialization/ReflectionSerializer.h>
 #include <Foundation/Serialization/RttiConverter.h>
 #include <Foundation/Types/ScopeExit.h>
 
+namespace
+{
+  /// \brief Returns bytes that were already read from a stream, followed by the rest of that stream.
+  ///
+  /// Used to look at the first bytes of binary data to decide which reader to pass it to.
+  class ezPrefixedStreamReader : public ezStreamReader
+  {
+  public:
+    ezPrefixedStreamReader(const void* pPrefix, ezUInt32 uiPrefixSize, ezStreamReader& stream)
+      : m_pPrefix(static_cast<const ezUInt8*>(pPrefix))
+      , m_uiPrefixSize(uiPrefixSize)
+      , m_Stream(stream)
+    {
+    }
+
+    virtual ezUInt64 ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead) override
+    {
+      ezUInt8* pBuffer = static_cast<ezUInt8*>(pReadBuffer);
+      const ezUInt32 uiFromPrefix = static_cast<ezUInt32>(ezMath::Min<ezUInt64>(uiBytesToRead, m_uiPrefixSize - m_uiPrefixRead));
+
+      if (uiFromPrefix > 0)
+      {
+        ezMemoryUtils::RawByteCopy(pBuffer, m_pPrefix + m_uiPrefixRead, uiFromPrefix);
+        m_uiPrefixRead += uiFromPrefix;
+      }
+
+      if (uiBytesToRead == uiFromPrefix)
+        return uiFromPrefix;
+
+      return uiFromPrefix + m_Stream.ReadBytes(pBuffer + uiFromPrefix, uiBytesToRead - uiFromPrefix);
+    }
+
+  private:
+    const ezUInt8* m_pPrefix;
+    ezUInt32 m_uiPrefixSize;
+    ezUInt32 m_uiPrefixRead = 0;
+    ezStreamReader& m_Stream;
+  };
+} // namespace
+
 ////////////////////////////////////////////////////////////////////////
 // ezReflectionSerializer public static functions
 ////////////////////////////////////////////////////////////////////////
@@ -46,6 +87,10 @@ void ezReflectionSerializer::WriteObjectToDDL(ezOpenDdlWriter& ddl, const ezRTTI
 
 void ezReflectionSerializer::WriteObjectToBinary(ezStreamWriter& stream, const ezRTTI* pRtti, const void* pObject)
 {
+  if (ezReflectionBinarySerializer::WriteObject(stream, pRtti, pObject).Succeeded())
+    return;
+
+  // the type is not supported by the direct serializer, go through the object graph instead
   ezAbstractObjectGraph graph;
   ezRttiConverterContext context;
   ezRttiConverterWriter conv(&graph, &context, false, true);
@@ -94,10 +139,17 @@ void* ezReflectionSerializer::ReadObjectFromDDL(const ezOpenDdlReaderElement* pR
 
 void* ezReflectionSerializer::ReadObjectFromBinary(ezStreamReader& stream, const ezRTTI*& pRtti)
 {
+  ezUInt32 uiFormat = 0;
+  stream.ReadBytes(&uiFormat, sizeof(uiFormat));
+  ezPrefixedStreamReader reader(&uiFormat, sizeof(uiFormat), stream);
+
+  if (uiFormat == ezReflectionBinarySerializer::s_uiFormatTag)
+    return ezReflectionBinarySerializer::ReadObject(reader, pRtti);
+
   ezAbstractObjectGraph graph;
   ezRttiConverterContext context;
 
-  ezAbstractGraphBinarySerializer::Read(stream, &graph);
+  ezAbstractGraphBinarySerializer::Read(reader, &graph);
 
   ezRttiConverterReader convRead(&graph, &context);
   auto* pRootNode = graph.GetNodeByName("root");
@@ -133,10 +185,20 @@ void ezReflectionSerializer::ReadObjectPropertiesFromDDL(ezStreamReader& stream,
 
 void ezReflectionSerializer::ReadObjectPropertiesFromBinary(ezStreamReader& stream, const ezRTTI& rtti, void* pObject)
 {
+  ezUInt32 uiFormat = 0;
+  stream.ReadBytes(&uiFormat, sizeof(uiFormat));
+  ezPrefixedStreamReader reader(&uiFormat, sizeof(uiFormat), stream);
+
+  if (uiFormat == ezReflectionBinarySerializer::s_uiFormatTag)
+  {
+    ezReflectionBinarySerializer::ReadObjectProperties(reader, rtti, pObject).IgnoreResult();
+    return;
+  }
+
   ezAbstractObjectGraph graph;
   ezRttiConverterContext context;
 
-  ezAbstractGraphBinarySerializer::Read(stream, &graph);
+  ezAbstractGraphBinarySerializer::Read(reader, &graph);
 
   ezRttiConverterReader convRead(&graph, &context);
   auto* pRootNode = graph.GetNodeByName("root");
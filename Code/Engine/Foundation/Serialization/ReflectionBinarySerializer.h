@@ -0,0 +1,47 @@
+#pragma once
+
+#include <Foundation/IO/Stream.h>
+
+class ezRTTI;
+
+/// \brief Writes and reads reflected objects in a compact binary format, without building an ezAbstractObjectGraph.
+///
+/// For every type a 'plan' is built once from its reflected properties and cached. The plan lists the serialized properties in
+/// the same order as ezRttiConverterWriter visits them. Members that are directly accessible and of a POD type (bool, numbers,
+/// vectors, ezTime, ezUuid, ...) are merged into runs of adjacent memory, which are written and read with a single copy.
+/// Only strings, variants, containers and sub-objects need further work.
+///
+/// The stream starts with the schema of every type that is contained in the data. When reading, each schema is compared to the
+/// plan of the current runtime type. If they all match, the data is read straight into the object. If not (e.g. because a type
+/// version changed), the data is decoded into an ezAbstractObjectGraph, patched with ezGraphVersioning and applied through
+/// ezRttiConverterReader, so properties are matched by name just like with the graph based serializer.
+///
+/// Types that rely on features that the direct path does not handle (non-owning pointers, pointers in containers,
+/// 'OnObjectCreated' functions, ...) cannot be written. ezReflectionSerializer falls back to the graph format for those.
+class EZ_FOUNDATION_DLL ezReflectionBinarySerializer
+{
+public:
+  /// \brief The first four bytes of every stream written by WriteObject().
+  ///
+  /// This never matches the version number at the start of data written by ezAbstractGraphBinarySerializer, so both formats can
+  /// be told apart.
+  static constexpr ezUInt32 s_uiFormatTag = 0x42525A45; // 'EZRB'
+
+  /// \brief Writes all properties of pObject of type pRtti to the stream.
+  ///
+  /// Returns EZ_FAILURE, without writing anything, if the type (or any type reachable from it) cannot be handled.
+  static ezResult WriteObject(ezStreamWriter& stream, const ezRTTI* pRtti, const void* pObject);
+
+  /// \brief Allocates an object of the serialized type and restores all its properties. Returns nullptr if the data is invalid
+  /// or the type is unknown.
+  static void* ReadObject(ezStreamReader& stream, const ezRTTI*& out_pRtti);
+
+  /// \brief Restores all properties of an existing object.
+  ///
+  /// If rtti is not the type that was written, the properties are matched by name.
+  static ezResult ReadObjectProperties(ezStreamReader& stream, const ezRTTI& rtti, void* pObject);
+
+  /// \brief Discards all cached plans. This is done automatically before plugins are unloaded and must not be called while
+  /// objects are serialized on other threads.
+  static void ClearCache();
+};
@@ -25,6 +25,9 @@ public:
   static void WriteObjectToDDL(ezOpenDdlWriter& ddl, const ezRTTI* pRtti, const void* pObject, ezUuid guid = ezUuid()); // [tested]
 
   /// \brief Same as WriteObjectToDDL but binary.
+  ///
+  /// Uses ezReflectionBinarySerializer, which doesn't need to build an intermediate object graph. Types that it can't handle are
+  /// written in the object graph format instead. The read functions accept both formats.
   static void WriteObjectToBinary(ezStreamWriter& stream, const ezRTTI* pRtti, const void* pObject); // [tested]
 
   /// \brief Reads the entire DDL data in the stream and restores a reflected object.
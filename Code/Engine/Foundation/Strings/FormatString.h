@@ -51,6 +51,16 @@ struct ezStringView;
 /// would otherwise just use uint32 formatting).
 ///
 /// To implement custom formatting see the various free standing 'BuildString' functions.
+///
+///
+/// === Compile-time format strings ===
+///
+/// ezFmt() parses the format string every time the text is generated. For string literals that are formatted often
+/// (e.g. logging in hot loops), the literal can be wrapped into EZ_FMT_STRING:
+///   ezLog::Info(ezFmt(EZ_FMT_STRING("Pos: {0}, {1}"), x, y));
+///
+/// The placeholders are then parsed at compile time and validated against the number of passed arguments.
+/// Dynamic format strings always use the regular runtime path.
 class EZ_FOUNDATION_DLL ezFormatString
 {
   EZ_DISALLOW_COPY_AND_ASSIGN(ezFormatString); // pass by reference, never pass by value
@@ -72,16 +82,30 @@ public:
 
   bool IsEmpty() const { return ezStringUtils::IsNullOrEmpty(m_szString); }
 
+  /// \brief Returns the unformatted string, ie. the text including all placeholders.
+  const char* GetFormat() const { return m_szString; }
+
+  /// \brief Converts every argument to text, without generating the formatted text.
+  ///
+  /// The texts of all arguments are appended to \a ref_sStorage one after another, \a pArgumentEnds receives the end position of each
+  /// argument in \a ref_sStorage and has to provide room for 10 entries.
+  /// Returns the number of arguments, or -1 if this is a plain text that doesn't need formatting at all.
+  ///
+  /// This allows to store the format and the arguments separately (e.g. for binary logs) and to generate the text later.
+  virtual ezInt32 GetArguments(ezStringBuilder& ref_sStorage, ezUInt32* pArgumentEnds) const { return -1; }
+
 protected:
   // out of line function so that we don't need to include ezStringBuilder here, to break include dependency cycle
   static void SBAppendView(ezStringBuilder& sb, const ezStringView& sub);
   static void SBClear(ezStringBuilder& sb);
   static void SBAppendChar(ezStringBuilder& sb, ezUInt32 uiChar);
   static const char* SBReturn(ezStringBuilder& sb);
+  static ezUInt32 SBGetElementCount(const ezStringBuilder& sb);
 
   const char* m_szString;
 };
 
+#include <Foundation/Strings/Implementation/FormatStringCompiled.h>
 #include <Foundation/Strings/Implementation/FormatStringImpl.h>
 
 template <typename... ARGS>
@@ -89,3 +113,9 @@ EZ_ALWAYS_INLINE ezFormatStringImpl<ARGS...> ezFmt(const char* szFormat, ARGS&&.
 {
   return ezFormatStringImpl<ARGS...>(szFormat, std::forward<ARGS>(args)...);
 }
+
+template <typename FORMAT, typename... ARGS, typename = std::enable_if_t<std::is_base_of_v<ezCompileTimeFormatString, FORMAT>>>
+EZ_ALWAYS_INLINE ezCompiledFormatStringImpl<FORMAT, ARGS...> ezFmt(FORMAT, ARGS&&... args)
+{
+  return ezCompiledFormatStringImpl<FORMAT, ARGS...>(std::forward<ARGS>(args)...);
+}
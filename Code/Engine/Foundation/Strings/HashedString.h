@@ -14,7 +14,8 @@ class ezTempHashedString;
 /// (it's a pointer comparison).\n
 /// Copying ezHashedString objects around and assigning between them is very fast as well.\n
 /// \n
-/// Assigning from some other string type is rather slow though, as it requires thread synchronization.\n
+/// Assigning from some other string type is rather slow though, as it requires a hash table lookup. Looking up strings that already exist
+/// does not take any lock, only adding new strings to the central storage does.\n
 /// You can also get access to the actual string data via GetString().\n
 /// \n
 /// You should use ezHashedString whenever the size of the encapsulating object is important and when changes to the string itself
@@ -29,12 +30,16 @@ public:
 #if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
     ezAtomicInteger32 m_iRefCount;
 #endif
+    ezUInt32 m_uiHash;
     ezString m_sString;
+
+    /// \brief Next entry in the same bucket of the central storage. Only modified while the owning shard is locked.
+    HashedData* volatile m_pNext;
   };
 
-  // Do NOT use a hash-table! The map does not relocate memory when it resizes, which is a vital aspect for the hashed strings to work.
-  typedef ezMap<ezUInt32, HashedData, ezCompareHelper<ezUInt32>, ezStaticAllocatorWrapper> StringStorage;
-  typedef StringStorage::Iterator HashedType;
+  // The central storage never relocates an entry once it was created, which is a vital aspect for the hashed strings to work.
+  // Lookups of existing strings are lock-free, only adding new strings and ClearUnusedStrings() need to lock (one shard of) the storage.
+  typedef HashedData* HashedType;
 
 #if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
   /// \brief This will remove all hashed strings from the central storage, that are not referenced anymore.
@@ -32,6 +32,11 @@ const char* ezFormatString::SBReturn(ezStringBuilder& sb)
   return sb.GetData();
 }
 
+ezUInt32 ezFormatString::SBGetElementCount(const ezStringBuilder& sb)
+{
+  return sb.GetElementCount();
+}
+
 ezStringView BuildString(char* tmp, ezUInt32 uiLength, const ezArgI& arg)
 {
   ezUInt32 writepos = 0;
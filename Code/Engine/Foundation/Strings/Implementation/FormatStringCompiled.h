@@ -0,0 +1,231 @@
+#pragma once
+
+#include <tuple>
+#include <utility>
+
+/// \brief Base class for the types generated by EZ_FMT_STRING. Only used to detect compile-time format strings.
+struct ezCompileTimeFormatString
+{
+};
+
+/// \brief Wraps a string literal such that ezFmt() can parse it at compile time.
+///
+/// Usage:
+///   ezLog::Info(ezFmt(EZ_FMT_STRING("Entity {0} at {1}"), sName, vPos));
+///
+/// The placeholders are validated against the number of arguments at compile time. Referencing an argument that was not passed,
+/// using more than 10 placeholders or a single '%' sign results in a compile error.
+#define EZ_FMT_STRING(szFormat)                                                  \
+  [] {                                                                           \
+    struct ezFormatStringLiteral : public ezCompileTimeFormatString              \
+    {                                                                            \
+      static constexpr const char* GetString() { return szFormat; }              \
+    };                                                                           \
+    return ezFormatStringLiteral();                                              \
+  }()
+
+namespace ezInternal
+{
+  /// \brief One piece of a pre-parsed format string. Either a range of literal text or a reference to an argument.
+  struct ezFormatStringSegment
+  {
+    ezUInt32 m_uiStart = 0;
+    ezUInt32 m_uiLength = 0;
+    ezInt32 m_iArgument = -1; ///< -1 for literal text
+  };
+
+  template <ezUInt32 NumSegments>
+  struct ezFormatStringSegments
+  {
+    ezFormatStringSegment m_Segments[NumSegments > 0 ? NumSegments : 1];
+    ezUInt32 m_uiNumSegments = 0;
+
+    bool m_bArgumentOutOfRange = false;
+    bool m_bTooManyPlaceholders = false;
+    bool m_bSinglePercentSign = false;
+  };
+
+  /// \brief Splits the format string into literal text and argument segments, using the same rules as ezFormatStringImpl::GetText().
+  ///
+  /// If pResult is nullptr, only the number of segments is computed.
+  template <ezUInt32 NumSegments>
+  constexpr void ParseFormatString(const char* szFormat, ezUInt32 uiNumArguments, ezFormatStringSegments<NumSegments>* pResult, ezUInt32& out_uiNumSegments)
+  {
+    ezUInt32 uiNumSegments = 0;
+    ezInt32 iLastParam = -1;
+    ezUInt32 uiLiteralStart = 0;
+    ezUInt32 i = 0;
+
+    auto AddSegment = [&](ezUInt32 uiStart, ezUInt32 uiLength, ezInt32 iArgument) {
+      if (iArgument < 0 && uiLength == 0)
+        return;
+
+      if (pResult != nullptr)
+      {
+        pResult->m_Segments[uiNumSegments].m_uiStart = uiStart;
+        pResult->m_Segments[uiNumSegments].m_uiLength = uiLength;
+        pResult->m_Segments[uiNumSegments].m_iArgument = iArgument;
+      }
+
+      ++uiNumSegments;
+    };
+
+    while (szFormat[i] != '\0')
+    {
+      if (szFormat[i] == '%')
+      {
+        if (szFormat[i + 1] == '%')
+        {
+          // keep the first '%' as part of the literal, skip the second one
+          AddSegment(uiLiteralStart, i + 1 - uiLiteralStart, -1);
+          i += 2;
+        }
+        else
+        {
+          if (pResult != nullptr)
+            pResult->m_bSinglePercentSign = true;
+
+          AddSegment(uiLiteralStart, i - uiLiteralStart, -1);
+          i += (szFormat[i + 1] != '\0') ? 2 : 1;
+        }
+
+        uiLiteralStart = i;
+      }
+      else if (szFormat[i] == '{' && szFormat[i + 1] >= '0' && szFormat[i + 1] <= '9' && szFormat[i + 2] == '}')
+      {
+        AddSegment(uiLiteralStart, i - uiLiteralStart, -1);
+
+        iLastParam = szFormat[i + 1] - '0';
+        AddSegment(0, 0, iLastParam);
+
+        if (pResult != nullptr && iLastParam >= static_cast<ezInt32>(uiNumArguments))
+          pResult->m_bArgumentOutOfRange = true;
+
+        i += 3;
+        uiLiteralStart = i;
+      }
+      else if (szFormat[i] == '{' && szFormat[i + 1] == '}')
+      {
+        AddSegment(uiLiteralStart, i - uiLiteralStart, -1);
+
+        ++iLastParam;
+        AddSegment(0, 0, iLastParam);
+
+        if (pResult != nullptr && iLastParam >= 10)
+          pResult->m_bTooManyPlaceholders = true;
+        else if (pResult != nullptr && iLastParam >= static_cast<ezInt32>(uiNumArguments))
+          pResult->m_bArgumentOutOfRange = true;
+
+        i += 2;
+        uiLiteralStart = i;
+      }
+      else
+      {
+        ++i;
+      }
+    }
+
+    AddSegment(uiLiteralStart, i - uiLiteralStart, -1);
+
+    if (pResult != nullptr)
+      pResult->m_uiNumSegments = uiNumSegments;
+
+    out_uiNumSegments = uiNumSegments;
+  }
+
+  constexpr ezUInt32 CountFormatStringSegments(const char* szFormat)
+  {
+    ezUInt32 uiNumSegments = 0;
+    ParseFormatString<0>(szFormat, 0, nullptr, uiNumSegments);
+    return uiNumSegments;
+  }
+
+  template <ezUInt32 NumSegments>
+  constexpr ezFormatStringSegments<NumSegments> ParseFormatString(const char* szFormat, ezUInt32 uiNumArguments)
+  {
+    ezFormatStringSegments<NumSegments> result;
+    ezUInt32 uiNumSegments = 0;
+    ParseFormatString<NumSegments>(szFormat, uiNumArguments, &result, uiNumSegments);
+    return result;
+  }
+} // namespace ezInternal
+
+/// \brief The ezFormatString implementation for format strings that were wrapped in EZ_FMT_STRING.
+///
+/// The placeholders are parsed at compile time, so GetText() only appends the literal text pieces and the formatted arguments
+/// to the string builder. Arguments are only converted to text where they are referenced.
+template <typename FORMAT, typename... ARGS>
+class ezCompiledFormatStringImpl : public ezFormatString
+{
+  // see ezFormatStringImpl
+  static constexpr ezUInt32 TempStringLength = 64;
+
+  static constexpr ezUInt32 NumSegments = ezInternal::CountFormatStringSegments(FORMAT::GetString());
+  static constexpr ezInternal::ezFormatStringSegments<NumSegments> Segments = ezInternal::ParseFormatString<NumSegments>(FORMAT::GetString(), sizeof...(ARGS));
+
+  static_assert(sizeof...(ARGS) <= 10, "Maximum number of format arguments reached");
+  static_assert(!Segments.m_bArgumentOutOfRange, "The format string references an argument index that was not passed to ezFmt");
+  static_assert(!Segments.m_bTooManyPlaceholders, "Too many placeholders in format string");
+  static_assert(!Segments.m_bSinglePercentSign, "Single percentage signs are not allowed in ezFormatString. Use double percentage signs for the actual character.");
+
+public:
+  ezCompiledFormatStringImpl(ARGS&&... args)
+    : m_Arguments(std::forward<ARGS>(args)...)
+  {
+    m_szString = FORMAT::GetString();
+  }
+
+  virtual const char* GetText(ezStringBuilder& sb) const override
+  {
+    SBClear(sb);
+    AppendSegments(sb, std::make_index_sequence<NumSegments>());
+    return SBReturn(sb);
+  }
+
+  virtual ezInt32 GetArguments(ezStringBuilder& ref_sStorage, ezUInt32* pArgumentEnds) const override
+  {
+    SBClear(ref_sStorage);
+    AppendArguments(ref_sStorage, pArgumentEnds, std::make_index_sequence<sizeof...(ARGS)>());
+    return static_cast<ezInt32>(sizeof...(ARGS));
+  }
+
+private:
+  template <std::size_t... Indices>
+  EZ_ALWAYS_INLINE void AppendArguments(ezStringBuilder& sb, ezUInt32* pArgumentEnds, std::index_sequence<Indices...>) const
+  {
+    (AppendArgument<Indices>(sb, pArgumentEnds), ...);
+  }
+
+  template <std::size_t Index>
+  EZ_ALWAYS_INLINE void AppendArgument(ezStringBuilder& sb, ezUInt32* pArgumentEnds) const
+  {
+    char tmp[TempStringLength];
+    SBAppendView(sb, BuildString(tmp, TempStringLength - 1, std::get<Index>(m_Arguments)));
+    pArgumentEnds[Index] = SBGetElementCount(sb);
+  }
+
+  template <std::size_t... Indices>
+  EZ_ALWAYS_INLINE void AppendSegments(ezStringBuilder& sb, std::index_sequence<Indices...>) const
+  {
+    (AppendSegment<Indices>(sb), ...);
+  }
+
+  template <std::size_t Index>
+  EZ_ALWAYS_INLINE void AppendSegment(ezStringBuilder& sb) const
+  {
+    constexpr ezInternal::ezFormatStringSegment segment = Segments.m_Segments[Index];
+
+    if constexpr (segment.m_iArgument < 0)
+    {
+      SBAppendView(sb, ezStringView(FORMAT::GetString() + segment.m_uiStart, segment.m_uiLength));
+    }
+    else
+    {
+      char tmp[TempStringLength];
+      SBAppendView(sb, BuildString(tmp, TempStringLength - 1, std::get<segment.m_iArgument>(m_Arguments)));
+    }
+  }
+
+  // stores the arguments
+  std::tuple<ARGS...> m_Arguments;
+};
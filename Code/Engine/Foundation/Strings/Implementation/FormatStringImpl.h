@@ -80,14 +80,39 @@ public:
       }
       else
       {
-        const ezUInt32 character = ezUnicodeUtils::DecodeUtf8ToUtf32(szString);
-        SBAppendChar(sb, character);
+        // append everything up to the next potential placeholder at once
+        // multi-byte UTF-8 sequences never contain '%' or '{', so this can't split a character
+        const char* szLiteralEnd = szString + 1;
+        while (*szLiteralEnd != '\0' && *szLiteralEnd != '%' && *szLiteralEnd != '{')
+        {
+          ++szLiteralEnd;
+        }
+
+        SBAppendView(sb, ezStringView(szString, szLiteralEnd));
+        szString = szLiteralEnd;
       }
     }
 
     return SBReturn(sb);
   }
 
+  virtual ezInt32 GetArguments(ezStringBuilder& ref_sStorage, ezUInt32* pArgumentEnds) const override
+  {
+    ezStringView param[10];
+
+    char tmp[10][TempStringLength];
+    ReplaceString<0>(tmp, param);
+
+    SBClear(ref_sStorage);
+    for (ezUInt32 i = 0; i < sizeof...(ARGS); ++i)
+    {
+      SBAppendView(ref_sStorage, param[i]);
+      pArgumentEnds[i] = SBGetElementCount(ref_sStorage);
+    }
+
+    return static_cast<ezInt32>(sizeof...(ARGS));
+  }
+
 private:
   template <ezInt32 N>
   typename std::enable_if<sizeof...(ARGS) != N>::type ReplaceString(char tmp[10][TempStringLength], ezStringView* pViews) const
@@ -1,15 +1,269 @@
 #include <FoundationPCH.h>
 
+#include <Foundation/Containers/HybridArray.h>
 #include <Foundation/Strings/HashedString.h>
 #include <Foundation/Threading/Lock.h>
 #include <Foundation/Threading/Mutex.h>
+#include <Foundation/Threading/ThreadUtils.h>
 
-struct HashedStringData
+// The central string storage is split into shards, each of which is a chained hash table.
+// Looking up an existing string never takes a lock: readers only register themselves in the shard's current 'epoch' and then walk the bucket
+// chains with acquire loads. Adding a string, growing the bucket array and removing unused strings lock the shard's mutex. Memory that might
+// still be visible to readers (unlinked strings, old bucket arrays) is only freed once all readers that entered before the modification
+// have left again.
+
+namespace
 {
-  ezMutex m_Mutex;
-  ezHashedString::StringStorage m_Storage;
-  ezHashedString::HashedType m_Empty;
-};
+  enum
+  {
+    SHARD_COUNT_BITS = 5,
+    SHARD_COUNT = 1 << SHARD_COUNT_BITS,
+    INITIAL_BUCKET_COUNT = 64,
+  };
+
+  /// Refcount value of strings that were removed by ClearUnusedStrings(). Lock-free lookups must not resurrect such strings.
+  constexpr ezInt32 s_iRemovedRefCount = -0x40000000;
+
+  template <typename T>
+  EZ_ALWAYS_INLINE T* LoadPointer(T* const volatile* pSrc)
+  {
+    return static_cast<T*>(ezAtomicUtils::ReadPointer(reinterpret_cast<void* const volatile*>(pSrc)));
+  }
+
+  template <typename T>
+  EZ_ALWAYS_INLINE void StorePointer(T* volatile* pDest, T* pValue)
+  {
+    ezAtomicUtils::WritePointer(reinterpret_cast<void* volatile*>(pDest), pValue);
+  }
+
+  struct BucketArray
+  {
+    ezUInt32 m_uiBucketMask;
+    ezHashedString::HashedType volatile m_Buckets[1]; // actually m_uiBucketMask + 1 entries
+
+    static BucketArray* Create(ezUInt32 uiBucketCount)
+    {
+      const size_t uiSize = sizeof(BucketArray) + (uiBucketCount - 1) * sizeof(ezHashedString::HashedType);
+
+      BucketArray* pBuckets = static_cast<BucketArray*>(ezStaticAllocatorWrapper::GetAllocator()->Allocate(uiSize, EZ_ALIGNMENT_OF(BucketArray)));
+      ezMemoryUtils::ZeroFill(static_cast<ezUInt8*>(static_cast<void*>(pBuckets)), uiSize);
+      pBuckets->m_uiBucketMask = uiBucketCount - 1;
+
+      return pBuckets;
+    }
+
+    static void Destroy(BucketArray* pBuckets) { ezStaticAllocatorWrapper::GetAllocator()->Deallocate(pBuckets); }
+
+    EZ_ALWAYS_INLINE ezHashedString::HashedType volatile& GetBucket(ezUInt32 uiHash)
+    {
+      // the lower bits already selected the shard
+      return m_Buckets[(uiHash >> SHARD_COUNT_BITS) & m_uiBucketMask];
+    }
+  };
+
+  struct EZ_ALIGN(HashedStringShard, 64)
+  {
+    HashedStringShard() { m_pBuckets = BucketArray::Create(INITIAL_BUCKET_COUNT); }
+
+    /// \brief Lock-free lookup. Returns nullptr if the string does not exist (or is just being removed).
+    ezHashedString::HashedType FindAndAddRef(ezUInt32 uiHash)
+    {
+      const ezUInt32 uiReaderSlot = EnterRead();
+
+      ezHashedString::HashedType pResult = nullptr;
+
+      BucketArray* pBuckets = LoadPointer(&m_pBuckets);
+      for (ezHashedString::HashedType pData = LoadPointer(&pBuckets->GetBucket(uiHash)); pData != nullptr; pData = LoadPointer(&pData->m_pNext))
+      {
+        if (pData->m_uiHash == uiHash)
+        {
+#if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
+          if (TryAddRef(pData))
+            pResult = pData;
+#else
+          pResult = pData;
+#endif
+          break;
+        }
+      }
+
+      LeaveRead(uiReaderSlot);
+      return pResult;
+    }
+
+    ezHashedString::HashedType FindOrAdd(const char* szString, ezUInt32 uiHash)
+    {
+      EZ_LOCK(m_Mutex);
+
+      ezHashedString::HashedType volatile& bucket = m_pBuckets->GetBucket(uiHash);
+
+      // the string might have been added in the meantime
+      // removed strings are unlinked while the lock is held, so everything that can be found here is alive
+      for (ezHashedString::HashedType pData = bucket; pData != nullptr; pData = pData->m_pNext)
+      {
+        if (pData->m_uiHash == uiHash)
+        {
+#if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
+          pData->m_iRefCount.Increment();
+#endif
+          return pData;
+        }
+      }
+
+      ezHashedString::HashedType pData = EZ_NEW(ezStaticAllocatorWrapper::GetAllocator(), ezHashedString::HashedData);
+#if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
+      pData->m_iRefCount = 1;
+#endif
+      pData->m_uiHash = uiHash;
+      pData->m_sString = szString;
+      pData->m_pNext = bucket;
+
+      // publishes the fully initialized entry to the lock-free readers
+      StorePointer(&bucket, pData);
+
+      ++m_uiCount;
+      if (m_uiCount > m_pBuckets->m_uiBucketMask + 1)
+      {
+        Grow();
+      }
+
+      return pData;
+    }
+
+#if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
+    ezUInt32 ClearUnusedStrings()
+    {
+      EZ_LOCK(m_Mutex);
+
+      ezHybridArray<ezHashedString::HashedType, 64> unlinked;
+
+      for (ezUInt32 i = 0; i <= m_pBuckets->m_uiBucketMask; ++i)
+      {
+        ezHashedString::HashedType volatile* pLink = &m_pBuckets->m_Buckets[i];
+
+        while (ezHashedString::HashedType pData = *pLink)
+        {
+          // once marked as removed, no lock-free lookup will hand out new references to this string anymore
+          if (pData->m_iRefCount.TestAndSet(0, s_iRemovedRefCount))
+          {
+            // readers that currently stand on pData can still continue through its m_pNext, so that one is left untouched
+            StorePointer(pLink, pData->m_pNext);
+            unlinked.PushBack(pData);
+          }
+          else
+          {
+            pLink = &pData->m_pNext;
+          }
+        }
+      }
+
+      if (unlinked.IsEmpty())
+        return 0;
+
+      m_uiCount -= unlinked.GetCount();
+
+      WaitForReaders();
+
+      for (ezHashedString::HashedType pData : unlinked)
+      {
+        EZ_DELETE(ezStaticAllocatorWrapper::GetAllocator(), pData);
+      }
+
+      return unlinked.GetCount();
+    }
+
+    static bool TryAddRef(ezHashedString::HashedType pData)
+    {
+      while (true)
+      {
+        const ezInt32 iRefCount = pData->m_iRefCount;
+        if (iRefCount < 0)
+          return false;
+
+        if (pData->m_iRefCount.TestAndSet(iRefCount, iRefCount + 1))
+          return true;
+      }
+    }
+#endif
+
+  private:
+    EZ_ALWAYS_INLINE ezUInt32 EnterRead()
+    {
+      while (true)
+      {
+        const ezInt32 iEpoch = m_iEpoch;
+        m_iReaders[iEpoch & 1].Increment();
+
+        // if a writer advanced the epoch in between, it might not wait for us, so register again for the new epoch
+        if (m_iEpoch == iEpoch)
+          return iEpoch & 1;
+
+        m_iReaders[iEpoch & 1].Decrement();
+      }
+    }
+
+    EZ_ALWAYS_INLINE void LeaveRead(ezUInt32 uiReaderSlot) { m_iReaders[uiReaderSlot].Decrement(); }
+
+    /// \brief Waits until all readers that might still see data that was unlinked before this call have finished. Requires the lock.
+    void WaitForReaders()
+    {
+      const ezInt32 iEpoch = m_iEpoch;
+
+      // new readers register in the other slot from now on
+      m_iEpoch.Increment();
+
+      while (m_iReaders[iEpoch & 1] != 0)
+      {
+        ezThreadUtils::YieldTimeSlice();
+      }
+    }
+
+    /// \brief Doubles the number of buckets. Requires the lock.
+    void Grow()
+    {
+      BucketArray* pOldBuckets = m_pBuckets;
+      BucketArray* pNewBuckets = BucketArray::Create((pOldBuckets->m_uiBucketMask + 1) * 2);
+
+      // Relinking the entries can make concurrent readers in the old array miss a string, which only sends them to the locked path.
+      // Every intermediate state is free of cycles, since moved entries only ever point to other moved entries.
+      for (ezUInt32 i = 0; i <= pOldBuckets->m_uiBucketMask; ++i)
+      {
+        ezHashedString::HashedType pData = pOldBuckets->m_Buckets[i];
+
+        while (pData != nullptr)
+        {
+          ezHashedString::HashedType pNext = pData->m_pNext;
+
+          ezHashedString::HashedType volatile& newBucket = pNewBuckets->GetBucket(pData->m_uiHash);
+          StorePointer(&pData->m_pNext, static_cast<ezHashedString::HashedType>(newBucket));
+          newBucket = pData;
+
+          pData = pNext;
+        }
+      }
+
+      StorePointer(&m_pBuckets, pNewBuckets);
+
+      WaitForReaders();
+      BucketArray::Destroy(pOldBuckets);
+    }
+
+    ezMutex m_Mutex;
+    BucketArray* volatile m_pBuckets = nullptr;
+    ezUInt32 m_uiCount = 0;
+
+    ezAtomicInteger32 m_iEpoch;
+    ezAtomicInteger32 m_iReaders[2];
+  };
+
+  struct HashedStringData
+  {
+    HashedStringShard m_Shards[SHARD_COUNT];
+    ezHashedString::HashedType m_Empty;
+
+    EZ_ALWAYS_INLINE HashedStringShard& GetShard(ezUInt32 uiHash) { return m_Shards[uiHash & (SHARD_COUNT - 1)]; }
+  };
+} // namespace
 
 static HashedStringData* s_pHSData;
 
@@ -22,29 +276,13 @@ ezHashedString::HashedType ezHashedString::AddHashedString(const char* szString,
   if (s_pHSData == nullptr)
     InitHashedString();
 
-  EZ_LOCK(s_pHSData->m_Mutex);
+  HashedStringShard& shard = s_pHSData->GetShard(uiHash);
 
-  // try to find the existing string
-  bool bExisted = false;
-  auto ret = s_pHSData->m_Storage.FindOrAdd(uiHash, &bExisted);
+  // if it already exists, the lookup has already increased the refcount
+  if (HashedType pExisting = shard.FindAndAddRef(uiHash))
+    return pExisting;
 
-  // if it already exists, just increase the refcount
-  if (bExisted)
-  {
-#if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
-    ret.Value().m_iRefCount.Increment();
-#endif
-  }
-  else
-  {
-    ezHashedString::HashedData& d = ret.Value();
-#if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
-    d.m_iRefCount = 1;
-#endif
-    d.m_sString = szString;
-  }
-
-  return ret;
+  return shard.FindOrAdd(szString, uiHash);
 }
 
 EZ_MSVC_ANALYSIS_WARNING_POP
@@ -63,26 +301,21 @@ void ezHashedString::InitHashedString()
 
 #if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
   // this one should never get deleted, so make sure its refcount is 2
-  s_pHSData->m_Empty.Value().m_iRefCount.Increment();
+  s_pHSData->m_Empty->m_iRefCount.Increment();
 #endif
 }
 
 #if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
 ezUInt32 ezHashedString::ClearUnusedStrings()
 {
-  EZ_LOCK(s_pHSData->m_Mutex);
+  if (s_pHSData == nullptr)
+    return 0;
 
   ezUInt32 uiDeleted = 0;
 
-  for (auto it = s_pHSData->m_Storage.GetIterator(); it.IsValid();)
+  for (HashedStringShard& shard : s_pHSData->m_Shards)
   {
-    if (it.Value().m_iRefCount == 0)
-    {
-      it = s_pHSData->m_Storage.Remove(it);
-      ++uiDeleted;
-    }
-    else
-      ++it;
+    uiDeleted += shard.ClearUnusedStrings();
   }
 
   return uiDeleted;
@@ -103,7 +336,7 @@ ezHashedString::ezHashedString()
 
   m_Data = s_pHSData->m_Empty;
 #if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
-  m_Data.Value().m_iRefCount.Increment();
+  m_Data->m_iRefCount.Increment();
 #endif
 }
 
@@ -122,9 +355,9 @@ void ezHashedString::Clear()
     HashedType tmp = m_Data;
 
     m_Data = s_pHSData->m_Empty;
-    m_Data.Value().m_iRefCount.Increment();
+    m_Data->m_iRefCount.Increment();
 
-    tmp.Value().m_iRefCount.Decrement();
+    tmp->m_iRefCount.Decrement();
   }
 #else
   m_Data = s_pHSData->m_Empty;
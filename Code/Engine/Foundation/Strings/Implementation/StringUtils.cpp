@@ -1,5 +1,6 @@
 #include <FoundationPCH.h>
 
+#include <Foundation/SimdMath/SimdTypes.h>
 #include <Foundation/Strings/StringView.h>
 #include <Foundation/Utilities/ConversionUtils.h>
 
@@ -48,6 +49,200 @@ void ezStringUtils::PrintStringLengthStatistics()
 
 #endif
 
+// SIMD helpers for the hot string loops.
+// They only skip over bytes that the scalar loops would have processed without any effect, and stop at every byte that needs attention
+// (a difference, a terminator, the end pointer, a non-ASCII byte, ...). The scalar loops then continue exactly as before, which keeps the
+// results identical to the FPU implementation.
+namespace
+{
+#if EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE
+
+// The loops read 16 bytes at a time and may thus read past the terminator of a string. This can never fault, since such reads never cross
+// a page boundary, but address sanitizers would still report them.
+#  if EZ_ENABLED(EZ_COMPILER_GCC) || EZ_ENABLED(EZ_COMPILER_CLANG)
+#    define EZ_STRING_SIMD_NO_SANITIZE __attribute__((no_sanitize_address))
+#  else
+#    define EZ_STRING_SIMD_NO_SANITIZE
+#  endif
+
+  /// \brief Whether all 16 bytes at pString are before the end pointer. Always false for ezMaxStringEnd, which isn't a real end.
+  EZ_ALWAYS_INLINE bool IsBeforeEnd16(const char* pString, const char* pStringEnd)
+  {
+    return pStringEnd != ezUnicodeUtils::GetMaxStringEnd<char>() && pStringEnd - pString >= 16;
+  }
+
+  /// \brief Whether 16 bytes can be read at pString. That is the case when they are all before the end pointer or when they are on the same
+  /// memory page. For zero terminated strings only the latter is checked, the terminator might be anywhere within the 16 bytes.
+  EZ_ALWAYS_INLINE bool CanLoad16(const char* pString, const char* pStringEnd)
+  {
+    return IsBeforeEnd16(pString, pStringEnd) || ((reinterpret_cast<size_t>(pString) & 4095) <= 4096 - 16);
+  }
+
+  /// \brief Returns a bit for each of the 16 bytes at pString that is located before the end pointer.
+  EZ_ALWAYS_INLINE ezUInt32 GetInRangeMask(const char* pString, const char* pStringEnd)
+  {
+    if (pStringEnd == ezUnicodeUtils::GetMaxStringEnd<char>() || IsBeforeEnd16(pString, pStringEnd))
+      return 0xFFFFu;
+
+    return (1u << (pStringEnd - pString)) - 1u;
+  }
+
+  EZ_ALWAYS_INLINE ezUInt32 MoveMask(__m128i value)
+  {
+    return static_cast<ezUInt32>(_mm_movemask_epi8(value));
+  }
+
+  /// \brief Advances both strings over identical bytes. Stops at the first difference, terminator or end pointer.
+  EZ_STRING_SIMD_NO_SANITIZE void SkipEqualBytes(const char*& pString1, const char*& pString2, const char* pString1End, const char* pString2End)
+  {
+    const __m128i zero = _mm_setzero_si128();
+
+    while (CanLoad16(pString1, pString1End) && CanLoad16(pString2, pString2End))
+    {
+      const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pString1));
+      const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pString2));
+
+      const ezUInt32 uiContinue = MoveMask(_mm_andnot_si128(_mm_cmpeq_epi8(a, zero), _mm_cmpeq_epi8(a, b))) &
+                                  GetInRangeMask(pString1, pString1End) & GetInRangeMask(pString2, pString2End);
+
+      if (uiContinue != 0xFFFFu)
+      {
+        const ezUInt32 uiSkip = ezMath::FirstBitLow(~uiContinue);
+        pString1 += uiSkip;
+        pString2 += uiSkip;
+        return;
+      }
+
+      pString1 += 16;
+      pString2 += 16;
+    }
+  }
+
+  EZ_ALWAYS_INLINE __m128i ToUpperAscii(__m128i value)
+  {
+    // bytes >= 0x80 are negative and thus never in the range of lower case letters
+    const __m128i isLower = _mm_and_si128(_mm_cmpgt_epi8(value, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(value, _mm_set1_epi8('z' + 1)));
+    return _mm_sub_epi8(value, _mm_and_si128(isLower, _mm_set1_epi8('a' - 'A')));
+  }
+
+  /// \brief Advances both strings over ASCII characters that are equal when ignoring the case. Stops at the first difference, non-ASCII byte,
+  /// terminator or end pointer.
+  EZ_STRING_SIMD_NO_SANITIZE void SkipEqualAsciiBytes_NoCase(
+    const char*& pString1, const char*& pString2, const char* pString1End, const char* pString2End)
+  {
+    const __m128i zero = _mm_setzero_si128();
+
+    while (CanLoad16(pString1, pString1End) && CanLoad16(pString2, pString2End))
+    {
+      const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pString1));
+      const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pString2));
+
+      const ezUInt32 uiEqual = MoveMask(_mm_andnot_si128(_mm_cmpeq_epi8(a, zero), _mm_cmpeq_epi8(ToUpperAscii(a), ToUpperAscii(b))));
+      const ezUInt32 uiContinue = uiEqual & ~MoveMask(_mm_or_si128(a, b)) & GetInRangeMask(pString1, pString1End) &
+                                  GetInRangeMask(pString2, pString2End);
+
+      if (uiContinue != 0xFFFFu)
+      {
+        const ezUInt32 uiSkip = ezMath::FirstBitLow(~uiContinue);
+        pString1 += uiSkip;
+        pString2 += uiSkip;
+        return;
+      }
+
+      pString1 += 16;
+      pString2 += 16;
+    }
+  }
+
+  /// \brief Returns the first position at or after pString that holds c1, c2 or the terminator, that is at the end pointer or, if
+  /// bStopAtNonAscii is set, that holds a non-ASCII byte. May also stop earlier, at any position where the SIMD loop cannot continue.
+  EZ_STRING_SIMD_NO_SANITIZE const char* SkipToBytes(const char* pString, const char* pStringEnd, char c1, char c2, bool bStopAtNonAscii)
+  {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i char1 = _mm_set1_epi8(c1);
+    const __m128i char2 = _mm_set1_epi8(c2);
+    const ezUInt32 uiNonAsciiMask = bStopAtNonAscii ? 0xFFFFu : 0u;
+
+    while (CanLoad16(pString, pStringEnd))
+    {
+      const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pString));
+
+      const ezUInt32 uiStop = MoveMask(_mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(a, zero), _mm_cmpeq_epi8(a, char1)), _mm_cmpeq_epi8(a, char2))) |
+                              (MoveMask(a) & uiNonAsciiMask) | (~GetInRangeMask(pString, pStringEnd) & 0xFFFFu);
+
+      if (uiStop != 0)
+        return pString + ezMath::FirstBitLow(uiStop);
+
+      pString += 16;
+    }
+
+    return pString;
+  }
+
+  /// \brief Advances pString over all bytes before the terminator or end pointer and returns the number of Utf8 start bytes among them. May
+  /// stop earlier, at any position where the SIMD loop cannot continue.
+  EZ_STRING_SIMD_NO_SANITIZE ezUInt32 SkipAndCountCharacters(const char*& pString, const char* pStringEnd)
+  {
+    const __m128i zero = _mm_setzero_si128();
+
+    // continuation bytes are 0x80 to 0xBF, i.e. all signed values below (ezInt8)0xC0
+    const __m128i firstNonContinuation = _mm_set1_epi8(static_cast<char>(0xC0));
+
+    ezUInt32 uiCharacters = 0;
+
+    while (CanLoad16(pString, pStringEnd))
+    {
+      const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pString));
+
+      const ezUInt32 uiStartBytes = ~MoveMask(_mm_cmplt_epi8(a, firstNonContinuation)) & 0xFFFFu;
+      const ezUInt32 uiContinue = ~MoveMask(_mm_cmpeq_epi8(a, zero)) & GetInRangeMask(pString, pStringEnd);
+
+      if (uiContinue != 0xFFFFu)
+      {
+        const ezUInt32 uiSkip = ezMath::FirstBitLow(~uiContinue);
+        uiCharacters += ezMath::CountBits(uiStartBytes & ((1u << uiSkip) - 1u));
+        pString += uiSkip;
+        return uiCharacters;
+      }
+
+      uiCharacters += ezMath::CountBits(uiStartBytes);
+      pString += 16;
+    }
+
+    return uiCharacters;
+  }
+
+  /// \brief Advances pString over ASCII bytes (including zero bytes). Stops at the first non-ASCII byte or the end pointer, which must not be
+  /// the maximum string end.
+  EZ_STRING_SIMD_NO_SANITIZE void SkipAsciiBytes(const char*& pString, const char* pStringEnd)
+  {
+    while (pString + 16 <= pStringEnd)
+    {
+      const ezUInt32 uiNonAscii = MoveMask(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pString)));
+
+      if (uiNonAscii != 0)
+      {
+        pString += ezMath::FirstBitLow(uiNonAscii);
+        return;
+      }
+
+      pString += 16;
+    }
+  }
+
+#  undef EZ_STRING_SIMD_NO_SANITIZE
+
+#else
+
+  EZ_ALWAYS_INLINE void SkipEqualBytes(const char*&, const char*&, const char*, const char*) {}
+  EZ_ALWAYS_INLINE void SkipEqualAsciiBytes_NoCase(const char*&, const char*&, const char*, const char*) {}
+  EZ_ALWAYS_INLINE const char* SkipToBytes(const char* pString, const char*, char, char, bool) { return pString; }
+  EZ_ALWAYS_INLINE ezUInt32 SkipAndCountCharacters(const char*&, const char*) { return 0; }
+  EZ_ALWAYS_INLINE void SkipAsciiBytes(const char*&, const char*) {}
+
+#endif
+} // namespace
+
 // Unicode ToUpper / ToLower character conversion
 //  License: $(WEB www.boost.org/LICENSE_1_0.txt, Boost License 1.0).
 //  Authors: $(WEB digitalmars.com, Walter Bright), Jonathan M Davis, and Kenji Hara
@@ -200,6 +395,84 @@ ezUInt32 ezStringUtils::ToLowerChar(ezUInt32 wc)
 }
 
 
+ezUInt32 ezStringUtils::GetCharacterCount(const char* szUtf8, const char* pStringEnd)
+{
+  if (IsNullOrEmpty(szUtf8))
+    return 0;
+
+  ezUInt32 uiCharacters = SkipAndCountCharacters(szUtf8, pStringEnd);
+
+  while ((*szUtf8 != '\0') && (szUtf8 < pStringEnd))
+  {
+    // skip all the Utf8 continuation bytes
+    if (!ezUnicodeUtils::IsUtf8ContinuationByte(*szUtf8))
+      ++uiCharacters;
+
+    ++szUtf8;
+
+    uiCharacters += SkipAndCountCharacters(szUtf8, pStringEnd);
+  }
+
+  return uiCharacters;
+}
+
+void ezStringUtils::GetCharacterAndElementCount(const char* szUtf8, ezUInt32& uiCharacterCount, ezUInt32& uiElementCount, const char* pStringEnd)
+{
+  uiCharacterCount = 0;
+  uiElementCount = 0;
+
+  if (IsNullOrEmpty(szUtf8))
+    return;
+
+  const char* szStart = szUtf8;
+
+  uiCharacterCount = SkipAndCountCharacters(szUtf8, pStringEnd);
+
+  while (szUtf8 < pStringEnd)
+  {
+    char uiByte = *szUtf8;
+    if (uiByte == '\0')
+    {
+      break;
+    }
+
+    // skip all the Utf8 continuation bytes
+    if (!ezUnicodeUtils::IsUtf8ContinuationByte(uiByte))
+      ++uiCharacterCount;
+
+    ++szUtf8;
+
+    uiCharacterCount += SkipAndCountCharacters(szUtf8, pStringEnd);
+  }
+
+  uiElementCount = static_cast<ezUInt32>(szUtf8 - szStart);
+}
+
+bool ezUnicodeUtils::IsValidUtf8(const char* szString, const char* szStringEnd)
+{
+  if (szStringEnd == GetMaxStringEnd<char>())
+    szStringEnd = szString + strlen(szString);
+
+  // most text is pure ASCII, so only the multi-byte sequences in between need to be validated one by one
+  SkipAsciiBytes(szString, szStringEnd);
+
+  while (szString < szStringEnd)
+  {
+    if (IsASCII(static_cast<ezUInt8>(*szString)))
+    {
+      ++szString;
+    }
+    else if (utf8::internal::validate_next(szString, szStringEnd) != utf8::internal::UTF8_OK)
+    {
+      return false;
+    }
+
+    SkipAsciiBytes(szString, szStringEnd);
+  }
+
+  return true;
+}
+
 ezUInt32 ezStringUtils::ToUpperString(char* pString, const char* pStringEnd)
 {
   char* pWriteStart = pString;
@@ -265,6 +538,8 @@ ezInt32 ezStringUtils::Compare(const char* pString1, const char* pString2, const
 {
   EZ_STRINGCOMPARE_HANDLE_NULL_PTRS(pString1, pString2, 0, -1, 1, pString1End, pString2End);
 
+  SkipEqualBytes(pString1, pString2, pString1End, pString2End);
+
   while ((*pString1 != '\0') && (*pString2 != '\0') && (pString1 < pString1End) && (pString2 < pString2End))
   {
     if (*pString1 != *pString2)
@@ -272,6 +547,8 @@ ezInt32 ezStringUtils::Compare(const char* pString1, const char* pString2, const
 
     ++pString1;
     ++pString2;
+
+    SkipEqualBytes(pString1, pString2, pString1End, pString2End);
   }
 
   if (pString1 >= pString1End)
@@ -333,6 +610,8 @@ ezInt32 ezStringUtils::Compare_NoCase(const char* pString1, const char* pString2
 {
   EZ_STRINGCOMPARE_HANDLE_NULL_PTRS(pString1, pString2, 0, -1, 1, pString1End, pString2End);
 
+  SkipEqualAsciiBytes_NoCase(pString1, pString2, pString1End, pString2End);
+
   while ((*pString1 != '\0') && (*pString2 != '\0') && (pString1 < pString1End) && (pString2 < pString2End))
   {
     // utf8::next will already advance the iterators
@@ -343,6 +622,8 @@ ezInt32 ezStringUtils::Compare_NoCase(const char* pString1, const char* pString2
 
     if (iComparison != 0)
       return iComparison;
+
+    SkipEqualAsciiBytes_NoCase(pString1, pString2, pString1End, pString2End);
   }
 
 
@@ -512,6 +793,8 @@ bool ezStringUtils::StartsWith(const char* szString, const char* szStartsWith, c
   if (IsNullOrEmpty(szString, pStringEnd))
     return false;
 
+  SkipEqualBytes(szString, szStartsWith, pStringEnd, szStartsWithEnd);
+
   while ((*szString != '\0') && (szString < pStringEnd))
   {
     // if we have reached the end of the StartsWith string, the other string DOES start with it
@@ -523,6 +806,8 @@ bool ezStringUtils::StartsWith(const char* szString, const char* szStartsWith, c
 
     ++szString;
     ++szStartsWith;
+
+    SkipEqualBytes(szString, szStartsWith, pStringEnd, szStartsWithEnd);
   }
 
   // if both are equally long, this comparison will return true
@@ -608,14 +893,19 @@ const char* ezStringUtils::FindSubString(const char* szSource, const char* szStr
   if ((IsNullOrEmpty(szSource)) || (IsNullOrEmpty(szStringToFind)))
     return nullptr;
 
+  const char cFirst = szStringToFind[0];
   const char* pCurPos = &szSource[0];
 
+  // only character starts are candidates, which is what MoveToNextUtf8 would step over
+  // all other bytes that can not be the start of a match are skipped quickly
   while ((*pCurPos != '\0') && (pCurPos < pSourceEnd))
   {
-    if (ezStringUtils::StartsWith(pCurPos, szStringToFind, pSourceEnd))
+    if (*pCurPos == cFirst && (pCurPos == szSource || !ezUnicodeUtils::IsUtf8ContinuationByte(*pCurPos)) &&
+        ezStringUtils::StartsWith(pCurPos, szStringToFind, pSourceEnd))
       return pCurPos;
 
-    ezUnicodeUtils::MoveToNextUtf8(pCurPos);
+    ++pCurPos;
+    pCurPos = SkipToBytes(pCurPos, pSourceEnd, cFirst, cFirst, false);
   }
 
   return nullptr;
@@ -629,6 +919,25 @@ const char* ezStringUtils::FindSubString_NoCase(const char* szSource, const char
 
   const char* pCurPos = &szSource[0];
 
+  if (ezUnicodeUtils::IsASCII(static_cast<ezUInt8>(szStringToFind[0])))
+  {
+    // A non-ASCII character in the source may still match an ASCII character when ignoring the case, so those always have to be checked.
+    const char cFirstUpper = static_cast<char>(ToUpperChar(szStringToFind[0]));
+    const char cFirstLower = static_cast<char>(ToLowerChar(szStringToFind[0]));
+
+    while ((*pCurPos != '\0') && (pCurPos < pSourceEnd))
+    {
+      if ((pCurPos == szSource || !ezUnicodeUtils::IsUtf8ContinuationByte(*pCurPos)) &&
+          ezStringUtils::StartsWith_NoCase(pCurPos, szStringToFind, pSourceEnd))
+        return pCurPos;
+
+      ++pCurPos;
+      pCurPos = SkipToBytes(pCurPos, pSourceEnd, cFirstUpper, cFirstLower, true);
+    }
+
+    return nullptr;
+  }
+
   while ((*pCurPos != '\0') && (pCurPos < pSourceEnd))
   {
     if (ezStringUtils::StartsWith_NoCase(pCurPos, szStringToFind, pSourceEnd))
@@ -51,58 +51,21 @@ ezUInt32 ezStringUtils::GetStringElementCount(const T* pString, const T* pString
   if (pStringEnd != ezUnicodeUtils::GetMaxStringEnd<T>())
     return (ezUInt32)(pStringEnd - pString);
 
-  ezUInt32 uiCount = 0;
-  while ((*pString != '\0') && (pString < pStringEnd))
+  if constexpr (sizeof(T) == 1)
   {
-    ++pString;
-    ++uiCount;
+    // the CRT implementation is vectorized
+    return (ezUInt32)strlen(reinterpret_cast<const char*>(pString));
   }
-
-  return uiCount;
-}
-
-inline ezUInt32 ezStringUtils::GetCharacterCount(const char* szUtf8, const char* pStringEnd)
-{
-  if (IsNullOrEmpty(szUtf8))
-    return 0;
-
-  ezUInt32 uiCharacters = 0;
-
-  while ((*szUtf8 != '\0') && (szUtf8 < pStringEnd))
-  {
-    // skip all the Utf8 continuation bytes
-    if (!ezUnicodeUtils::IsUtf8ContinuationByte(*szUtf8))
-      ++uiCharacters;
-
-    ++szUtf8;
-  }
-
-  return uiCharacters;
-}
-
-inline void ezStringUtils::GetCharacterAndElementCount(
-  const char* szUtf8, ezUInt32& uiCharacterCount, ezUInt32& uiElementCount, const char* pStringEnd)
-{
-  uiCharacterCount = 0;
-  uiElementCount = 0;
-
-  if (IsNullOrEmpty(szUtf8))
-    return;
-
-  while (szUtf8 < pStringEnd)
+  else
   {
-    char uiByte = *szUtf8;
-    if (uiByte == '\0')
+    ezUInt32 uiCount = 0;
+    while ((*pString != '\0') && (pString < pStringEnd))
     {
-      break;
+      ++pString;
+      ++uiCount;
     }
 
-    // skip all the Utf8 continuation bytes
-    if (!ezUnicodeUtils::IsUtf8ContinuationByte(uiByte))
-      ++uiCharacterCount;
-
-    ++szUtf8;
-    ++uiElementCount;
+    return uiCount;
   }
 }
 
@@ -97,6 +97,12 @@ struct EZ_FOUNDATION_DLL ezAtomicUtils
   /// function returns false.
   static bool TestAndSet(void** volatile dest, void* expected, void* value); // [tested]
 
+  /// \brief Reads the pointer at *src* with acquire semantics, ie. all writes that were published through WritePointer() are visible afterwards.
+  static void* ReadPointer(void* const volatile* src); // [tested]
+
+  /// \brief Writes *value* to *dest* with release semantics, ie. all previous writes are visible to a thread that reads the pointer via ReadPointer().
+  static void WritePointer(void* volatile* dest, void* value); // [tested]
+
   /// \brief If *dest* is equal to *expected*, this function sets *dest* to *value*. Otherwise *dest* will not be modified. Always returns the value
   /// of *dest* before the modification.
   static ezInt32 CompareAndSwap(volatile ezInt32& dest, ezInt32 expected, ezInt32 value); // [tested]
@@ -189,6 +189,16 @@ EZ_ALWAYS_INLINE bool ezAtomicUtils::TestAndSet(void** volatile dest, void* expe
 #endif
 }
 
+EZ_ALWAYS_INLINE void* ezAtomicUtils::ReadPointer(void* const volatile* src)
+{
+  return __atomic_load_n(src, __ATOMIC_ACQUIRE);
+}
+
+EZ_ALWAYS_INLINE void ezAtomicUtils::WritePointer(void* volatile* dest, void* value)
+{
+  __atomic_store_n(dest, value, __ATOMIC_RELEASE);
+}
+
 EZ_ALWAYS_INLINE ezInt32 ezAtomicUtils::CompareAndSwap(volatile ezInt32& dest, ezInt32 expected, ezInt32 value)
 {
   return __sync_val_compare_and_swap(&dest, expected, value);
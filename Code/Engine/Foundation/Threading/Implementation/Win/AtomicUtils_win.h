@@ -265,6 +265,29 @@ EZ_ALWAYS_INLINE bool ezAtomicUtils::TestAndSet(void** volatile dest, void* expe
   return _InterlockedCompareExchangePointer(dest, value, expected) == expected;
 }
 
+EZ_ALWAYS_INLINE void* ezAtomicUtils::ReadPointer(void* const volatile* src)
+{
+#if EZ_ENABLED(EZ_PLATFORM_ARCH_X86)
+  // aligned loads are atomic and already have acquire semantics on x86, only the compiler must not reorder
+  void* value = *src;
+  _ReadWriteBarrier();
+  return value;
+#else
+  return _InterlockedCompareExchangePointer(const_cast<void* volatile*>(src), nullptr, nullptr);
+#endif
+}
+
+EZ_ALWAYS_INLINE void ezAtomicUtils::WritePointer(void* volatile* dest, void* value)
+{
+#if EZ_ENABLED(EZ_PLATFORM_ARCH_X86)
+  // aligned stores are atomic and already have release semantics on x86, only the compiler must not reorder
+  _ReadWriteBarrier();
+  *dest = value;
+#else
+  _InterlockedExchangePointer(dest, value);
+#endif
+}
+
 EZ_ALWAYS_INLINE ezInt32 ezAtomicUtils::CompareAndSwap(volatile ezInt32& dest, ezInt32 expected, ezInt32 value)
 {
   return _InterlockedCompareExchange(reinterpret_cast<volatile long*>(&dest), value, expected);
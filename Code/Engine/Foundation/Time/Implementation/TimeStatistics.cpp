@@ -0,0 +1,55 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Containers/HybridArray.h>
+#include <Foundation/Time/TimeStatistics.h>
+
+namespace
+{
+  double GetMedianOfSorted(ezArrayPtr<const double> sorted)
+  {
+    const ezUInt32 uiCount = sorted.GetCount();
+    if ((uiCount % 2) == 1)
+      return sorted[uiCount / 2];
+
+    return (sorted[uiCount / 2 - 1] + sorted[uiCount / 2]) * 0.5;
+  }
+} // namespace
+
+void ezTimeStatistics::Compute(ezArrayPtr<const ezTime> samples)
+{
+  *this = ezTimeStatistics();
+  m_uiSamples = samples.GetCount();
+
+  if (m_uiSamples == 0)
+    return;
+
+  ezHybridArray<double, 64> values;
+  values.SetCountUninitialized(m_uiSamples);
+
+  for (ezUInt32 i = 0; i < m_uiSamples; ++i)
+  {
+    values[i] = samples[i].GetMilliseconds();
+    m_fMean += values[i];
+  }
+
+  values.Sort();
+
+  m_fMean /= m_uiSamples;
+  m_fMin = values[0];
+  m_fMax = values[m_uiSamples - 1];
+  m_fMedian = GetMedianOfSorted(values);
+
+  // nearest-rank method, ie. the smallest sample that is larger or equal to 95% of all samples
+  const ezUInt32 uiRank95 = (ezUInt32)ezMath::Ceil(0.95 * m_uiSamples);
+  m_fPercentile95 = values[ezMath::Clamp<ezUInt32>(uiRank95, 1, m_uiSamples) - 1];
+
+  for (ezUInt32 i = 0; i < m_uiSamples; ++i)
+  {
+    values[i] = ezMath::Abs(values[i] - m_fMedian);
+  }
+
+  values.Sort();
+  m_fMedianAbsoluteDeviation = GetMedianOfSorted(values);
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Time_Implementation_TimeStatistics);
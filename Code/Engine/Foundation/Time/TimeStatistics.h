@@ -0,0 +1,24 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+#include <Foundation/Time/Time.h>
+#include <Foundation/Types/ArrayPtr.h>
+
+/// \brief Statistics of a set of measured durations, e.g. the runs of a benchmark or the frame times of an application. All times are in
+/// milliseconds.
+///
+/// The median and the median absolute deviation (MAD) are meant for comparisons, as they are hardly affected by single outliers,
+/// e.g. when the OS scheduled another process in between. The 95th percentile shows how bad the spikes are.
+struct EZ_FOUNDATION_DLL ezTimeStatistics
+{
+  ezUInt32 m_uiSamples = 0;
+  double m_fMedian = 0;
+  double m_fPercentile95 = 0;
+  double m_fMedianAbsoluteDeviation = 0;
+  double m_fMin = 0;
+  double m_fMax = 0;
+  double m_fMean = 0;
+
+  /// \brief Computes all statistics from the given samples. Without any samples, all values are zero.
+  void Compute(ezArrayPtr<const ezTime> samples);
+};
@@ -6,6 +6,19 @@ ezMutex ezStats::s_Mutex;
 ezStats::MapType ezStats::s_Stats;
 ezStats::ezEventStats ezStats::s_StatsEvents;
 
+namespace
+{
+  // Metrics may be global variables, which are constructed during static initialization, so the list head must not depend on the
+  // initialization order of other globals.
+  ezStatsMetric* s_pFirstMetric = nullptr;
+
+  ezMutex& GetMetricsMutex()
+  {
+    static ezMutex s_MetricsMutex;
+    return s_MetricsMutex;
+  }
+} // namespace
+
 void ezStats::RemoveStat(const char* szStatName)
 {
   EZ_LOCK(s_Mutex);
@@ -44,5 +57,256 @@ void ezStats::SetStat(const char* szStatName, const ezVariant& value)
   s_StatsEvents.Broadcast(e);
 }
 
+void ezStats::FlushMetrics()
+{
+  EZ_LOCK(GetMetricsMutex());
+
+  for (ezStatsMetric* pMetric = s_pFirstMetric; pMetric != nullptr; pMetric = pMetric->m_pNextMetric)
+  {
+    if (!pMetric->m_sName.IsEmpty())
+    {
+      pMetric->Flush();
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezStatsMetric::ezStatsMetric(ezStringView sName)
+  : m_sName(sName)
+{
+  EZ_LOCK(GetMetricsMutex());
+
+  m_pNextMetric = s_pFirstMetric;
+  if (s_pFirstMetric != nullptr)
+  {
+    s_pFirstMetric->m_pPrevMetric = this;
+  }
+
+  s_pFirstMetric = this;
+}
+
+ezStatsMetric::~ezStatsMetric()
+{
+  EZ_LOCK(GetMetricsMutex());
+
+  if (m_pPrevMetric != nullptr)
+  {
+    m_pPrevMetric->m_pNextMetric = m_pNextMetric;
+  }
+  else
+  {
+    s_pFirstMetric = m_pNextMetric;
+  }
+
+  if (m_pNextMetric != nullptr)
+  {
+    m_pNextMetric->m_pPrevMetric = m_pPrevMetric;
+  }
+}
+
+void ezStatsMetric::SetName(ezStringView sName)
+{
+  // the name is read during flushing
+  EZ_LOCK(GetMetricsMutex());
+
+  m_sName = sName;
+  OnNameChanged();
+}
+
+ezUInt32 ezStatsMetric::AssignThreadShard()
+{
+  static ezAtomicInteger32 s_iNextShard;
+  return static_cast<ezUInt32>(s_iNextShard.PostIncrement()) % ShardCount;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezStatsCounter::ezStatsCounter(ezStringView sName, bool bResetOnFlush)
+  : ezStatsMetric(sName)
+  , m_bResetOnFlush(bResetOnFlush)
+{
+}
+
+ezInt64 ezStatsCounter::GetValue() const
+{
+  ezInt64 iValue = m_iFlushedValue;
+
+  for (const Shard& shard : m_Shards)
+  {
+    iValue += shard.m_iValue;
+  }
+
+  return iValue;
+}
+
+void ezStatsCounter::Flush()
+{
+  ezInt64 iValue = 0;
+
+  for (Shard& shard : m_Shards)
+  {
+    iValue += shard.m_iValue.Set(0);
+  }
+
+  if (m_bResetOnFlush)
+  {
+    ezStats::SetStat(m_sName, iValue);
+    return;
+  }
+
+  // keep the total in a plain variable, the shards only hold what was added since the last flush
+  m_iFlushedValue += iValue;
+
+  ezStats::SetStat(m_sName, m_iFlushedValue);
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezStatsGauge::ezStatsGauge(ezStringView sName)
+  : ezStatsMetric(sName)
+{
+}
+
+void ezStatsGauge::Flush()
+{
+  ezStats::SetStat(m_sName, GetValue());
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezStatsHistogram::ezStatsHistogram(ezStringView sName, ValueType valueType)
+  : ezStatsMetric(sName)
+  , m_ValueType(valueType)
+{
+  OnNameChanged();
+}
+
+// static
+ezUInt64 ezStatsHistogram::GetBucketLowerBound(ezUInt32 uiBucketIndex)
+{
+  if (uiBucketIndex < SubBucketCount)
+    return uiBucketIndex;
+
+  const ezUInt32 uiExponent = uiBucketIndex / SubBucketCount + SubBucketBits - 1;
+  const ezUInt64 uiSubBucket = uiBucketIndex % SubBucketCount;
+
+  return (SubBucketCount + uiSubBucket) << (uiExponent - SubBucketBits);
+}
+
+// static
+ezUInt64 ezStatsHistogram::GetBucketValue(ezUInt32 uiBucketIndex)
+{
+  if (uiBucketIndex < SubBucketCount)
+    return uiBucketIndex;
+
+  const ezUInt32 uiExponent = uiBucketIndex / SubBucketCount + SubBucketBits - 1;
+  const ezUInt64 uiBucketWidth = ezUInt64(1) << (uiExponent - SubBucketBits);
+
+  return GetBucketLowerBound(uiBucketIndex) + uiBucketWidth / 2;
+}
+
+void ezStatsHistogram::OnNameChanged()
+{
+  if (m_sName.IsEmpty())
+    return;
+
+  ezStringBuilder sName;
+
+  sName.Set(m_sName, "/Count");
+  m_sCountName = sName;
+  sName.Set(m_sName, "/Mean");
+  m_sMeanName = sName;
+  sName.Set(m_sName, "/P50");
+  m_sP50Name = sName;
+  sName.Set(m_sName, "/P90");
+  m_sP90Name = sName;
+  sName.Set(m_sName, "/P99");
+  m_sP99Name = sName;
+  sName.Set(m_sName, "/Max");
+  m_sMaxName = sName;
+}
+
+void ezStatsHistogram::SetStatValue(const ezString& sName, ezUInt64 uiValue)
+{
+  if (m_ValueType == ValueType::Time)
+  {
+    ezStats::SetStat(sName, ezTime::Nanoseconds(static_cast<double>(uiValue)));
+  }
+  else
+  {
+    ezStats::SetStat(sName, static_cast<ezInt64>(uiValue));
+  }
+}
+
+void ezStatsHistogram::Flush()
+{
+  ezUInt32 buckets[BucketCount] = {};
+  ezUInt64 uiTotal = 0;
+  ezUInt64 uiSum = 0;
+  ezUInt64 uiMax = 0;
+
+  for (HistogramShard& shard : m_Shards)
+  {
+    // if the count was zero, nothing was recorded into this shard, except for values that are being recorded right now
+    if (shard.m_iCount.Set(0) == 0)
+      continue;
+
+    uiSum += static_cast<ezUInt64>(shard.m_iSum.Set(0));
+    uiMax = ezMath::Max(uiMax, static_cast<ezUInt64>(shard.m_iMax.Set(0)));
+
+    for (ezUInt32 i = 0; i < BucketCount; ++i)
+    {
+      // most buckets are empty, only pay for the atomic exchange where something was recorded
+      if (shard.m_Buckets[i] == 0)
+        continue;
+
+      const ezUInt32 uiCount = static_cast<ezUInt32>(shard.m_Buckets[i].Set(0));
+      buckets[i] += uiCount;
+      uiTotal += uiCount;
+    }
+  }
+
+  ezStats::SetStat(m_sCountName, static_cast<ezInt64>(uiTotal));
+
+  if (uiTotal == 0)
+    return;
+
+  const ezUInt64 uiRank50 = (uiTotal * 50 + 99) / 100;
+  const ezUInt64 uiRank90 = (uiTotal * 90 + 99) / 100;
+  const ezUInt64 uiRank99 = (uiTotal * 99 + 99) / 100;
+
+  ezUInt64 uiP50 = 0, uiP90 = 0, uiP99 = 0;
+  ezUInt64 uiAccumulated = 0;
+
+  for (ezUInt32 i = 0; i < BucketCount; ++i)
+  {
+    if (buckets[i] == 0)
+      continue;
+
+    const ezUInt64 uiPrevious = uiAccumulated;
+    uiAccumulated += buckets[i];
+
+    // the bucket center may be larger than the largest recorded value
+    const ezUInt64 uiValue = ezMath::Min(GetBucketValue(i), uiMax);
+
+    if (uiPrevious < uiRank50 && uiAccumulated >= uiRank50)
+      uiP50 = uiValue;
+    if (uiPrevious < uiRank90 && uiAccumulated >= uiRank90)
+      uiP90 = uiValue;
+    if (uiPrevious < uiRank99 && uiAccumulated >= uiRank99)
+    {
+      uiP99 = uiValue;
+      break;
+    }
+  }
+
+  SetStatValue(m_sMeanName, uiSum / uiTotal);
+  SetStatValue(m_sP50Name, uiP50);
+  SetStatValue(m_sP90Name, uiP90);
+  SetStatValue(m_sP99Name, uiP99);
+  SetStatValue(m_sMaxName, uiMax);
+}
+
 
 EZ_STATICLINK_FILE(Foundation, Foundation_Utilities_Implementation_Stats);
@@ -3,7 +3,10 @@
 #include <Foundation/Basics.h>
 #include <Foundation/Communication/Event.h>
 #include <Foundation/Containers/Map.h>
+#include <Foundation/Math/Math.h>
 #include <Foundation/Strings/String.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Time/Time.h>
 #include <Foundation/Types/Variant.h>
 
 /// \brief This class holds a simple map that maps strings (keys) to strings (values), which represent certain stats.
@@ -35,6 +38,12 @@ public:
   /// \brief Returns the entire map of stats, can be used to display them.
   static const MapType& GetAllStats() { return s_Stats; }
 
+  /// \brief Writes the current values of all registered metrics (ezStatsCounter, ezStatsGauge, ezStatsHistogram) into the stats map.
+  ///
+  /// This is called once per frame by the game application. The metrics themselves are only updated through atomics, so this is the only
+  /// place where their values end up in the map and get sent through ezTelemetry.
+  static void FlushMetrics();
+
   /// \brief The event data that is broadcast whenever a stat is changed.
   struct StatsEventData
   {
@@ -64,3 +73,199 @@ private:
   static MapType s_Stats;
   static ezEventStats s_StatsEvents;
 };
+
+/// \brief Base class for typed metrics, which are cheap to update and get written into the ezStats map once per frame.
+///
+/// Metrics register themselves on construction and unregister on destruction, so they can be declared as global variables or as class
+/// members. Updating a metric never takes a lock and never formats a string, which makes them usable in code that runs many times per frame.
+/// The values are transferred to ezStats through ezStats::FlushMetrics().
+/// A metric without a name is not flushed, which allows to set the name after construction, e.g. once the owner knows its own name.
+class EZ_FOUNDATION_DLL ezStatsMetric
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezStatsMetric);
+
+public:
+  /// \brief The number of slots that concurrent updates are spread across to avoid contention on a single cache line.
+  static constexpr ezUInt32 ShardCount = 8;
+
+  /// \brief Sets the name under which the metric is shown in the stats. May contain slashes to define groups, see ezStats::SetStat().
+  void SetName(ezStringView sName);
+
+  /// \brief Returns the name under which the metric is shown in the stats.
+  const ezString& GetName() const { return m_sName; }
+
+protected:
+  ezStatsMetric(ezStringView sName);
+  virtual ~ezStatsMetric();
+
+  /// \brief Called once per frame by ezStats::FlushMetrics() to write the current value(s) into ezStats.
+  virtual void Flush() = 0;
+
+  /// \brief Called after the name was changed, so that derived classes can update the names of additional stats.
+  virtual void OnNameChanged() {}
+
+  /// \brief Returns the shard that the calling thread should write to.
+  EZ_ALWAYS_INLINE static ezUInt32 GetThreadShard()
+  {
+    static thread_local ezUInt32 s_uiShard = AssignThreadShard();
+    return s_uiShard;
+  }
+
+  struct Shard
+  {
+    ezAtomicInteger64 m_iValue;
+
+    // pad to a full cache line, so that threads that write to different shards don't write to the same cache line
+    ezUInt8 m_Padding[64 - sizeof(ezAtomicInteger64)];
+  };
+
+  ezString m_sName;
+
+private:
+  friend class ezStats;
+
+  static ezUInt32 AssignThreadShard();
+
+  ezStatsMetric* m_pNextMetric = nullptr;
+  ezStatsMetric* m_pPrevMetric = nullptr;
+};
+
+/// \brief A metric that accumulates a value, e.g. the number of times something happened.
+///
+/// The accumulated value is flushed as an ezInt64 stat. If 'reset on flush' is enabled, the counter starts at zero again after each flush,
+/// which turns it into a 'per frame' count.
+class EZ_FOUNDATION_DLL ezStatsCounter : public ezStatsMetric
+{
+public:
+  ezStatsCounter(ezStringView sName = {}, bool bResetOnFlush = false);
+
+  /// \brief Adds one to the counter.
+  EZ_ALWAYS_INLINE void Increment() { m_Shards[GetThreadShard()].m_iValue.Increment(); }
+
+  /// \brief Adds the given amount to the counter.
+  EZ_ALWAYS_INLINE void Add(ezInt64 iAmount) { m_Shards[GetThreadShard()].m_iValue.Add(iAmount); }
+
+  /// \brief Returns the value that has been accumulated since the last reset.
+  ezInt64 GetValue() const;
+
+protected:
+  virtual void Flush() override;
+
+private:
+  Shard m_Shards[ShardCount];
+  ezInt64 m_iFlushedValue = 0;
+  bool m_bResetOnFlush = false;
+};
+
+/// \brief A metric that represents a current value, e.g. the number of objects in a world.
+///
+/// Only the last value that was set before a flush is written to the stats.
+class EZ_FOUNDATION_DLL ezStatsGauge : public ezStatsMetric
+{
+public:
+  ezStatsGauge(ezStringView sName = {});
+
+  /// \brief Sets the current value.
+  EZ_ALWAYS_INLINE void Set(ezInt64 iValue) { m_iValue.Set(iValue); }
+
+  /// \brief Changes the current value by the given amount.
+  EZ_ALWAYS_INLINE void Add(ezInt64 iAmount) { m_iValue.Add(iAmount); }
+
+  /// \brief Returns the current value.
+  ezInt64 GetValue() const { return m_iValue; }
+
+protected:
+  virtual void Flush() override;
+
+private:
+  ezAtomicInteger64 m_iValue;
+};
+
+/// \brief A metric that records the distribution of values, typically latencies, and reports percentiles of each frame.
+///
+/// Values are sorted into logarithmic buckets with 8 linear sub-buckets each (similar to an HDR histogram), so every recorded value is
+/// known with a precision of 12.5%, independent of its magnitude. Each thread records into its own set of buckets.
+/// On flush the buckets of the last frame are merged and reset, and the stats '<Name>/Count', '<Name>/Mean', '<Name>/P50', '<Name>/P90',
+/// '<Name>/P99' and '<Name>/Max' are written. Frames in which nothing was recorded only update the count.
+/// Values that are recorded while a flush is in progress may be attributed to the next frame.
+class EZ_FOUNDATION_DLL ezStatsHistogram : public ezStatsMetric
+{
+public:
+  /// \brief Determines how the recorded values are interpreted when they are written to the stats.
+  enum class ValueType
+  {
+    Integer, ///< Values are reported as ezInt64.
+    Time,    ///< Values are recorded with RecordTime() and reported as ezTime.
+  };
+
+  ezStatsHistogram(ezStringView sName = {}, ValueType valueType = ValueType::Integer);
+
+  /// \brief Records a single value.
+  EZ_ALWAYS_INLINE void Record(ezUInt64 uiValue)
+  {
+    HistogramShard& shard = m_Shards[GetThreadShard() % HistogramShardCount];
+    shard.m_Buckets[GetBucketIndex(uiValue)].Increment();
+    shard.m_iSum.Add(static_cast<ezInt64>(uiValue));
+    shard.m_iMax.Max(static_cast<ezInt64>(uiValue));
+    shard.m_iCount.Increment();
+  }
+
+  /// \brief Records a duration. The histogram stores durations with nanosecond precision.
+  EZ_ALWAYS_INLINE void RecordTime(ezTime duration)
+  {
+    EZ_ASSERT_DEBUG(m_ValueType == ValueType::Time, "This histogram does not record durations");
+    Record(duration.GetNanoseconds() > 0.0 ? static_cast<ezUInt64>(duration.GetNanoseconds()) : 0);
+  }
+
+  /// \brief The number of linear sub-buckets per power of two, as a power of two.
+  static constexpr ezUInt32 SubBucketBits = 3;
+  static constexpr ezUInt32 SubBucketCount = 1u << SubBucketBits;
+  static constexpr ezUInt32 BucketCount = (64 - SubBucketBits + 1) * SubBucketCount;
+
+  /// \brief Returns the index of the bucket into which the given value is sorted.
+  EZ_ALWAYS_INLINE static ezUInt32 GetBucketIndex(ezUInt64 uiValue)
+  {
+    if (uiValue < SubBucketCount)
+      return static_cast<ezUInt32>(uiValue);
+
+    const ezUInt32 uiHigh = static_cast<ezUInt32>(uiValue >> 32);
+    const ezUInt32 uiExponent = uiHigh != 0 ? 32 + ezMath::FirstBitHigh(uiHigh) : ezMath::FirstBitHigh(static_cast<ezUInt32>(uiValue));
+    const ezUInt32 uiSubBucket = static_cast<ezUInt32>(uiValue >> (uiExponent - SubBucketBits)) & (SubBucketCount - 1);
+
+    return (uiExponent - SubBucketBits + 1) * SubBucketCount + uiSubBucket;
+  }
+
+  /// \brief Returns the smallest value that is sorted into the given bucket.
+  static ezUInt64 GetBucketLowerBound(ezUInt32 uiBucketIndex);
+
+  /// \brief Returns the value that is reported for all values in the given bucket, which is the center of the bucket's range.
+  static ezUInt64 GetBucketValue(ezUInt32 uiBucketIndex);
+
+protected:
+  virtual void Flush() override;
+  virtual void OnNameChanged() override;
+
+private:
+  static constexpr ezUInt32 HistogramShardCount = 4;
+
+  struct HistogramShard
+  {
+    ezAtomicInteger64 m_iCount;
+    ezAtomicInteger64 m_iSum;
+    ezAtomicInteger64 m_iMax;
+    ezUInt8 m_Padding[64 - 3 * sizeof(ezAtomicInteger64)];
+    ezAtomicInteger32 m_Buckets[BucketCount];
+  };
+
+  void SetStatValue(const ezString& sName, ezUInt64 uiValue);
+
+  ValueType m_ValueType;
+  HistogramShard m_Shards[HistogramShardCount];
+
+  ezString m_sCountName;
+  ezString m_sMeanName;
+  ezString m_sP50Name;
+  ezString m_sP90Name;
+  ezString m_sP99Name;
+  ezString m_sMaxName;
+};
@@ -3,13 +3,27 @@
 #include <GameEngine/GameEngineDLL.h>
 #include <RendererCore/AnimationSystem/AnimationGraph/AnimationClipSampler.h>
 #include <RendererCore/AnimationSystem/AnimationPose.h>
+#include <RendererCore/AnimationSystem/AnimationPoseSoA.h>
 #include <RendererCore/Meshes/SkinnedMeshComponent.h>
 
 struct ezSkeletonResourceDescriptor;
 typedef ezTypedResourceHandle<class ezAnimationClipResource> ezAnimationClipResourceHandle;
 typedef ezTypedResourceHandle<class ezSkeletonResource> ezSkeletonResourceHandle;
 
-typedef ezComponentManagerSimple<class ezAnimatedMeshComponent, ezComponentUpdateType::WhenSimulating> ezAnimatedMeshComponentManager;
+/// \brief Evaluates the poses of all animated meshes in parallel during the asynchronous update phase and publishes them afterwards.
+class EZ_GAMEENGINE_DLL ezAnimatedMeshComponentManager : public ezComponentManager<class ezAnimatedMeshComponent, ezBlockStorageType::FreeList>
+{
+  using SUPER = ezComponentManager<class ezAnimatedMeshComponent, ezBlockStorageType::FreeList>;
+
+public:
+  ezAnimatedMeshComponentManager(ezWorld* pWorld);
+
+  virtual void Initialize() override;
+
+private:
+  void UpdatePoses(const ezWorldModule::UpdateContext& context);
+  void PublishPoses(const ezWorldModule::UpdateContext& context);
+};
 
 class EZ_GAMEENGINE_DLL ezAnimatedMeshComponent : public ezSkinnedMeshComponent
 {
@@ -48,13 +62,22 @@ public:
 
 
 protected:
-  void Update();
+  /// \brief Samples the animation and computes the object space and skinning space pose. Only touches data of this component, so it is
+  /// called for many components in parallel.
+  void UpdatePose();
+
+  /// \brief Sends the new pose to child objects and applies the root motion. Called from the synchronous update phase.
+  void PublishPose();
+
   void CreatePhysicsShapes(const ezSkeletonResourceDescriptor& skeleton, const ezAnimationPose& pose);
 
   void* m_pRagdoll = nullptr;
 
   bool m_bApplyRootMotion = false;
   bool m_bVisualizeSkeleton = false;
+  bool m_bPoseUpdated = false;
+  ezTransform m_RootMotion;
+  ezAnimationPoseSoA m_LocalPose;
   ezAnimationPose m_AnimationPose;
   ezSkeletonResourceHandle m_hSkeleton;
   ezAnimationClipSampler m_AnimationClipSampler;
@@ -9,6 +9,59 @@
 #include <RendererCore/Debug/DebugRendererContext.h>
 #include <RendererFoundation/Device/Device.h>
 
+ezAnimatedMeshComponentManager::ezAnimatedMeshComponentManager(ezWorld* pWorld)
+  : SUPER(pWorld)
+{
+}
+
+void ezAnimatedMeshComponentManager::Initialize()
+{
+  // sampling and converting the poses only touches the data of each component, so it is spread over multiple threads
+  // sending the pose to the child objects and moving the owner (root motion) has to happen afterwards in a synchronous phase
+  {
+    auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ezAnimatedMeshComponentManager::UpdatePoses, this);
+    desc.m_Phase = ezWorldModule::UpdateFunctionDesc::Phase::Async;
+    desc.m_bOnlyUpdateWhenSimulating = true;
+    desc.m_uiGranularity = 32;
+
+    this->RegisterUpdateFunction(desc);
+  }
+
+  {
+    auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ezAnimatedMeshComponentManager::PublishPoses, this);
+    desc.m_Phase = ezWorldModule::UpdateFunctionDesc::Phase::PostAsync;
+    desc.m_bOnlyUpdateWhenSimulating = true;
+
+    this->RegisterUpdateFunction(desc);
+  }
+}
+
+void ezAnimatedMeshComponentManager::UpdatePoses(const ezWorldModule::UpdateContext& context)
+{
+  for (auto it = this->m_ComponentStorage.GetIterator(context.m_uiFirstComponentIndex, context.m_uiComponentCount); it.IsValid(); ++it)
+  {
+    ComponentType* pComponent = it;
+    if (pComponent->IsActiveAndInitialized())
+    {
+      pComponent->UpdatePose();
+    }
+  }
+}
+
+void ezAnimatedMeshComponentManager::PublishPoses(const ezWorldModule::UpdateContext& context)
+{
+  for (auto it = this->m_ComponentStorage.GetIterator(context.m_uiFirstComponentIndex, context.m_uiComponentCount); it.IsValid(); ++it)
+  {
+    ComponentType* pComponent = it;
+    if (pComponent->IsActiveAndInitialized())
+    {
+      pComponent->PublishPose();
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 // clang-format off
 EZ_BEGIN_COMPONENT_TYPE(ezAnimatedMeshComponent, 10, ezComponentMode::Dynamic);
 {
@@ -77,6 +130,7 @@ void ezAnimatedMeshComponent::OnSimulationStarted()
     ezResourceLock<ezSkeletonResource> pSkeleton(m_hSkeleton, ezResourceAcquireMode::BlockTillLoaded);
 
     const ezSkeleton& skeleton = pSkeleton->GetDescriptor().m_Skeleton;
+    m_LocalPose.Configure(skeleton);
     m_AnimationPose.Configure(skeleton);
     m_AnimationPose.ConvertFromLocalSpaceToObjectSpace(skeleton);
 
@@ -152,30 +206,45 @@ void ezAnimatedMeshComponent::SetAnimationSpeed(float speed)
   m_AnimationClipSampler.SetPlaybackSpeed(speed);
 }
 
-void ezAnimatedMeshComponent::Update()
+void ezAnimatedMeshComponent::UpdatePose()
 {
+  m_bPoseUpdated = false;
+
   if (!m_AnimationClipSampler.GetAnimationClip().IsValid() || !m_hSkeleton.IsValid())
     return;
 
   ezResourceLock<ezSkeletonResource> pSkeleton(m_hSkeleton, ezResourceAcquireMode::AllowLoadingFallback);
   const ezSkeleton& skeleton = pSkeleton->GetDescriptor().m_Skeleton;
 
-  ezTransform rootMotion;
-  rootMotion.SetIdentity();
+  m_RootMotion.SetIdentity();
 
-  m_AnimationPose.SetToBindPoseInLocalSpace(skeleton);
+  m_LocalPose.SetToBindPose(skeleton);
   m_AnimationClipSampler.Step(GetWorld()->GetClock().GetTimeDiff());
-  m_AnimationClipSampler.Execute(skeleton, m_AnimationPose, &rootMotion);
+  m_AnimationClipSampler.Execute(*pSkeleton.GetPointer(), m_LocalPose, &m_RootMotion);
 
-  m_AnimationPose.ConvertFromLocalSpaceToObjectSpace(skeleton);
+  m_LocalPose.ConvertToObjectSpace(m_AnimationPose);
+
+  ezArrayPtr<ezMat4> pRenderMatrices = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezMat4, m_AnimationPose.GetTransformCount());
+  m_LocalPose.ConvertToSkinningSpace(pRenderMatrices);
+
+  m_SkinningMatrices = pRenderMatrices;
+  m_bPoseUpdated = true;
+}
+
+void ezAnimatedMeshComponent::PublishPose()
+{
+  if (!m_bPoseUpdated)
+    return;
+
+  ezResourceLock<ezSkeletonResource> pSkeleton(m_hSkeleton, ezResourceAcquireMode::AllowLoadingFallback);
+  const ezSkeleton& skeleton = pSkeleton->GetDescriptor().m_Skeleton;
 
   if (m_bVisualizeSkeleton)
   {
     m_AnimationPose.VisualizePose(GetWorld(), skeleton, GetOwner()->GetGlobalTransform());
   }
 
-  // inform child nodes/components that a new skinning pose is available
-  // do this before the pose is transformed into skinning space
+  // inform child nodes/components that a new pose is available
   {
     ezMsgAnimationPoseUpdated msg;
     msg.m_pSkeleton = &skeleton;
@@ -184,20 +253,13 @@ void ezAnimatedMeshComponent::Update()
     GetOwner()->SendMessageRecursive(msg);
   }
 
-  m_AnimationPose.ConvertFromObjectSpaceToSkinningSpace(skeleton);
-
-  ezArrayPtr<ezMat4> pRenderMatrices = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezMat4, m_AnimationPose.GetTransformCount());
-  ezMemoryUtils::Copy(pRenderMatrices.GetPtr(), m_AnimationPose.GetAllTransforms().GetPtr(), m_AnimationPose.GetTransformCount());
-
-  m_SkinningMatrices = pRenderMatrices;
-
   if (m_bApplyRootMotion)
   {
     auto* pOwner = GetOwner();
 
     const ezQuat qOldRot = pOwner->GetLocalRotation();
-    const ezVec3 vNewPos = qOldRot * (rootMotion.m_vPosition * pOwner->GetGlobalScaling().x) + pOwner->GetLocalPosition();
-    const ezQuat qNewRot = rootMotion.m_qRotation * qOldRot;
+    const ezVec3 vNewPos = qOldRot * (m_RootMotion.m_vPosition * pOwner->GetGlobalScaling().x) + pOwner->GetLocalPosition();
+    const ezQuat qNewRot = m_RootMotion.m_qRotation * qOldRot;
 
     pOwner->SetLocalPosition(vNewPos);
     pOwner->SetLocalRotation(qNewRot);
@@ -9,6 +9,57 @@
 #include <RendererCore/Debug/DebugRenderer.h>
 #include <RendererFoundation/Device/Device.h>
 
+ezMotionMatchingComponentManager::ezMotionMatchingComponentManager(ezWorld* pWorld)
+  : SUPER(pWorld)
+{
+}
+
+void ezMotionMatchingComponentManager::Initialize()
+{
+  {
+    auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ezMotionMatchingComponentManager::UpdatePoses, this);
+    desc.m_Phase = ezWorldModule::UpdateFunctionDesc::Phase::Async;
+    desc.m_bOnlyUpdateWhenSimulating = true;
+    desc.m_uiGranularity = 32;
+
+    this->RegisterUpdateFunction(desc);
+  }
+
+  {
+    auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ezMotionMatchingComponentManager::PublishPoses, this);
+    desc.m_Phase = ezWorldModule::UpdateFunctionDesc::Phase::PostAsync;
+    desc.m_bOnlyUpdateWhenSimulating = true;
+
+    this->RegisterUpdateFunction(desc);
+  }
+}
+
+void ezMotionMatchingComponentManager::UpdatePoses(const ezWorldModule::UpdateContext& context)
+{
+  for (auto it = this->m_ComponentStorage.GetIterator(context.m_uiFirstComponentIndex, context.m_uiComponentCount); it.IsValid(); ++it)
+  {
+    ComponentType* pComponent = it;
+    if (pComponent->IsActiveAndInitialized())
+    {
+      pComponent->UpdatePose();
+    }
+  }
+}
+
+void ezMotionMatchingComponentManager::PublishPoses(const ezWorldModule::UpdateContext& context)
+{
+  for (auto it = this->m_ComponentStorage.GetIterator(context.m_uiFirstComponentIndex, context.m_uiComponentCount); it.IsValid(); ++it)
+  {
+    ComponentType* pComponent = it;
+    if (pComponent->IsActiveAndInitialized())
+    {
+      pComponent->PublishPose();
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 // clang-format off
 EZ_BEGIN_COMPONENT_TYPE(ezMotionMatchingComponent, 2, ezComponentMode::Dynamic);
 {
@@ -68,6 +119,8 @@ void ezMotionMatchingComponent::OnSimulationStarted()
     ezResourceLock<ezSkeletonResource> pSkeleton(m_hSkeleton, ezResourceAcquireMode::BlockTillLoaded);
 
     const ezSkeleton& skeleton = pSkeleton->GetDescriptor().m_Skeleton;
+    m_LocalPose.Configure(skeleton);
+    m_BlendPose.Configure(skeleton);
     m_AnimationPose.Configure(skeleton);
     m_AnimationPose.ConvertFromLocalSpaceToObjectSpace(skeleton);
     m_AnimationPose.ConvertFromObjectSpaceToSkinningSpace(skeleton);
@@ -84,6 +137,9 @@ void ezMotionMatchingComponent::OnSimulationStarted()
 
     m_hSkinningTransformsBuffer = ezGALDevice::GetDefaultDevice()->CreateBuffer(
       BufferDesc, ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(m_AnimationPose.GetAllTransforms().GetPtr()), BufferDesc.m_uiTotalSize));
+
+    m_uiLeftFootJoint = skeleton.FindJointByName("Bip01_L_Foot");
+    m_uiRightFootJoint = skeleton.FindJointByName("Bip01_R_Foot");
   }
 
   // m_AnimationClipSampler.RestartAnimation();
@@ -96,19 +152,27 @@ void ezMotionMatchingComponent::OnSimulationStarted()
   m_Keyframe1.m_uiAnimClip = 0;
   m_Keyframe1.m_uiKeyframe = 1;
 
-  for (ezUInt32 anim = 0; anim < m_Animations.GetCount(); ++anim)
+  m_pDatabase = nullptr;
+  m_fMaxRootSpeed = 0.0f;
+
+  if (m_hSkeleton.IsValid() && m_uiLeftFootJoint != ezInvalidJointIndex && m_uiRightFootJoint != ezInvalidJointIndex)
   {
-    ezResourceLock<ezAnimationClipResource> pClip(m_Animations[anim], ezResourceAcquireMode::BlockTillLoaded);
-    ezResourceLock<ezSkeletonResource> pSkeleton(m_hSkeleton, ezResourceAcquireMode::AllowLoadingFallback);
+    ezHashedString sLeftFoot, sRightFoot;
+    sLeftFoot.Assign("Bip01_L_Foot");
+    sRightFoot.Assign("Bip01_R_Foot");
 
-    PrecomputeMotion(m_MotionData, "Bip01_L_Foot", "Bip01_R_Foot", pClip->GetDescriptor(), anim, pSkeleton->GetDescriptor().m_Skeleton);
+    ezResourceLock<ezSkeletonResource> pSkeleton(m_hSkeleton, ezResourceAcquireMode::AllowLoadingFallback);
+    m_pDatabase = pSkeleton->GetMotionMatchingDatabase(m_Animations, sLeftFoot, sRightFoot);
+    m_fMaxRootSpeed = m_pDatabase->GetMaxRootSpeed();
   }
 
   m_vLeftFootPos.SetZero();
   m_vRightFootPos.SetZero();
+  m_vTargetVelocity.SetZero();
 
   ConfigureInput();
 }
+
 void ezMotionMatchingComponent::ConfigureInput()
 {
   ezInputActionConfig iac;
@@ -157,8 +221,13 @@ ezVec3 ezMotionMatchingComponent::GetInputDirection() const
   dir.x = r - l;
   dir.z = 0;
 
-  // dir.NormalizeIfNotZero(ezVec3::ZeroVector());
-  return dir * 3.0f;
+  // keyboard input would otherwise be faster diagonally
+  if (dir.GetLengthSquared() > 1.0f)
+  {
+    dir.Normalize();
+  }
+
+  return dir;
 }
 
 ezQuat ezMotionMatchingComponent::GetInputRotation() const
@@ -175,8 +244,10 @@ ezQuat ezMotionMatchingComponent::GetInputRotation() const
   return q;
 }
 
-void ezMotionMatchingComponent::Update()
+void ezMotionMatchingComponent::UpdatePose()
 {
+  m_bPoseUpdated = false;
+
   if (!m_hSkeleton.IsValid() || m_Animations.IsEmpty())
     return;
 
@@ -189,18 +260,12 @@ void ezMotionMatchingComponent::Update()
   const float fKeyframeFraction = (float)GetWorld()->GetClock().GetTimeDiff().GetSeconds() * 24.0f; // assuming 24 FPS in the animations
 
   {
-    const ezVec3 vTargetDir = GetInputDirection() / GetOwner()->GetGlobalScaling().x;
-
-    ezStringBuilder tmp;
-    tmp.Format("Gamepad: {0} / {1}", ezArgF(vTargetDir.x, 1), ezArgF(vTargetDir.y, 1));
-    ezDebugRenderer::Draw2DText(GetWorld(), tmp, ezVec2I32(10, 10), ezColor::White);
-
     m_fKeyframeLerp += fKeyframeFraction;
     while (m_fKeyframeLerp > 1.0f)
     {
 
       m_Keyframe0 = m_Keyframe1;
-      m_Keyframe1 = FindNextKeyframe(m_Keyframe1, vTargetDir);
+      m_Keyframe1 = FindNextKeyframe(m_Keyframe1, m_vTargetVelocity);
 
       // ezLog::Info("Old KF: {0} | {1} - {2}", m_Keyframe0.m_uiAnimClip, m_Keyframe0.m_uiKeyframe, m_fKeyframeLerp);
       m_fKeyframeLerp -= 1.0f;
@@ -208,7 +273,8 @@ void ezMotionMatchingComponent::Update()
     }
   }
 
-  m_AnimationPose.SetToBindPoseInLocalSpace(skeleton);
+  m_LocalPose.SetToBindPose(skeleton);
+  m_BlendPose.SetToBindPose(skeleton);
 
   {
     ezResourceLock<ezAnimationClipResource> pAnimClip0(m_Animations[m_Keyframe0.m_uiAnimClip], ezResourceAcquireMode::BlockTillLoaded);
@@ -217,36 +283,12 @@ void ezMotionMatchingComponent::Update()
     const auto& animDesc0 = pAnimClip0->GetDescriptor();
     const auto& animDesc1 = pAnimClip1->GetDescriptor();
 
-    const auto& animatedJoints0 = animDesc0.GetAllJointIndices();
-
-    for (ezUInt32 b = 0; b < animatedJoints0.GetCount(); ++b)
-    {
-      const ezHashedString sJointName = animatedJoints0.GetKey(b);
-      const ezUInt32 uiAnimJointIdx0 = animatedJoints0.GetValue(b);
-      const ezUInt32 uiAnimJointIdx1 = animDesc1.FindJointIndexByName(sJointName);
-
-      const ezUInt16 uiSkeletonJointIdx = skeleton.FindJointByName(sJointName);
-      if (uiSkeletonJointIdx != ezInvalidJointIndex)
-      {
-        ezArrayPtr<const ezTransform> pTransforms0 = animDesc0.GetJointKeyframes(uiAnimJointIdx0);
-        ezArrayPtr<const ezTransform> pTransforms1 = animDesc1.GetJointKeyframes(uiAnimJointIdx1);
-
-        const ezTransform jointTransform1 = pTransforms0[m_Keyframe0.m_uiKeyframe];
-        const ezTransform jointTransform2 = pTransforms1[m_Keyframe1.m_uiKeyframe];
-
-        ezTransform res;
-        res.m_vPosition = ezMath::Lerp(jointTransform1.m_vPosition, jointTransform2.m_vPosition, m_fKeyframeLerp);
-        res.m_qRotation.SetSlerp(jointTransform1.m_qRotation, jointTransform2.m_qRotation, m_fKeyframeLerp);
-        res.m_vScale = ezMath::Lerp(jointTransform1.m_vScale, jointTransform2.m_vScale, m_fKeyframeLerp);
-
-        m_AnimationPose.SetTransform(uiSkeletonJointIdx, res.GetAsMat4());
-      }
-    }
+    animDesc0.SetPoseToKeyframe(m_LocalPose, *pAnimClip0->GetJointMapping(*pSkeleton.GetPointer()), m_Keyframe0.m_uiKeyframe);
+    animDesc1.SetPoseToKeyframe(m_BlendPose, *pAnimClip1->GetJointMapping(*pSkeleton.GetPointer()), m_Keyframe1.m_uiKeyframe);
+    m_LocalPose.Blend(m_BlendPose, m_fKeyframeLerp);
 
-    // root motion
+    // root motion, applied to the owner in PublishPose()
     {
-      auto* pOwner = GetOwner();
-
       ezVec3 vRootMotion0, vRootMotion1;
       vRootMotion0.SetZero();
       vRootMotion1.SetZero();
@@ -256,33 +298,18 @@ void ezMotionMatchingComponent::Update()
       if (animDesc1.HasRootMotion())
         vRootMotion1 = animDesc1.GetJointKeyframes(animDesc1.GetRootMotionJoint())[m_Keyframe1.m_uiKeyframe].m_vPosition;
 
-      const ezVec3 vRootMotion = ezMath::Lerp(vRootMotion0, vRootMotion1, m_fKeyframeLerp) * fKeyframeFraction * pOwner->GetGlobalScaling().x;
-
-      const ezQuat qRotate = GetInputRotation();
-
-      const ezQuat qOldRot = pOwner->GetLocalRotation();
-      const ezVec3 vNewPos = qOldRot * vRootMotion + pOwner->GetLocalPosition();
-      const ezQuat qNewRot = qRotate * qOldRot;
-
-      pOwner->SetLocalPosition(vNewPos);
-      pOwner->SetLocalRotation(qNewRot);
+      m_vRootMotion = ezMath::Lerp(vRootMotion0, vRootMotion1, m_fKeyframeLerp) * fKeyframeFraction * GetOwner()->GetGlobalScaling().x;
     }
   }
 
-  m_AnimationPose.ConvertFromLocalSpaceToObjectSpace(skeleton);
+  m_LocalPose.ConvertToObjectSpace(m_AnimationPose);
 
-  const ezUInt16 uiLeftFootJoint = skeleton.FindJointByName("Bip01_L_Foot");
-  const ezUInt16 uiRightFootJoint = skeleton.FindJointByName("Bip01_R_Foot");
-  if (uiLeftFootJoint != ezInvalidJointIndex && uiRightFootJoint != ezInvalidJointIndex)
+  if (m_uiLeftFootJoint != ezInvalidJointIndex && m_uiRightFootJoint != ezInvalidJointIndex)
   {
     ezTransform tLeft, tRight;
-    ezBoundingSphere sphere(ezVec3::ZeroVector(), 0.5f);
 
-    tLeft.SetFromMat4(m_AnimationPose.GetTransform(uiLeftFootJoint));
-    tRight.SetFromMat4(m_AnimationPose.GetTransform(uiRightFootJoint));
-
-    m_AnimationPose.VisualizePose(GetWorld(), skeleton, GetOwner()->GetGlobalTransform(), 1.0f / 6.0f, uiLeftFootJoint);
-    m_AnimationPose.VisualizePose(GetWorld(), skeleton, GetOwner()->GetGlobalTransform(), 1.0f / 6.0f, uiRightFootJoint);
+    tLeft.SetFromMat4(m_AnimationPose.GetTransform(m_uiLeftFootJoint));
+    tRight.SetFromMat4(m_AnimationPose.GetTransform(m_uiRightFootJoint));
 
     // const float fScaleToPerSec = (float)(1.0 / GetWorld()->GetClock().GetTimeDiff().GetSeconds());
 
@@ -293,12 +320,56 @@ void ezMotionMatchingComponent::Update()
     m_vRightFootPos = tRight.m_vPosition;
   }
 
-  m_AnimationPose.ConvertFromObjectSpaceToSkinningSpace(skeleton);
-
   ezArrayPtr<ezMat4> pRenderMatrices = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezMat4, m_AnimationPose.GetTransformCount());
-  ezMemoryUtils::Copy(pRenderMatrices.GetPtr(), m_AnimationPose.GetAllTransforms().GetPtr(), m_AnimationPose.GetTransformCount());
+  m_LocalPose.ConvertToSkinningSpace(pRenderMatrices);
 
   m_SkinningMatrices = pRenderMatrices;
+  m_bPoseUpdated = true;
+}
+
+void ezMotionMatchingComponent::PublishPose()
+{
+  if (!m_bPoseUpdated)
+    return;
+
+  ezResourceLock<ezSkeletonResource> pSkeleton(m_hSkeleton, ezResourceAcquireMode::AllowLoadingFallback);
+  const ezSkeleton& skeleton = pSkeleton->GetDescriptor().m_Skeleton;
+
+  if (m_uiLeftFootJoint != ezInvalidJointIndex && m_uiRightFootJoint != ezInvalidJointIndex)
+  {
+    m_AnimationPose.VisualizePose(GetWorld(), skeleton, GetOwner()->GetGlobalTransform(), 1.0f / 6.0f, m_uiLeftFootJoint);
+    m_AnimationPose.VisualizePose(GetWorld(), skeleton, GetOwner()->GetGlobalTransform(), 1.0f / 6.0f, m_uiRightFootJoint);
+  }
+
+  // inform child nodes/components that a new pose is available
+  {
+    ezMsgAnimationPoseUpdated msg;
+    msg.m_pSkeleton = &skeleton;
+    msg.m_pPose = &m_AnimationPose;
+
+    GetOwner()->SendMessageRecursive(msg);
+  }
+
+  {
+    auto* pOwner = GetOwner();
+
+    const ezQuat qOldRot = pOwner->GetLocalRotation();
+    const ezVec3 vNewPos = qOldRot * m_vRootMotion + pOwner->GetLocalPosition();
+    const ezQuat qNewRot = GetInputRotation() * qOldRot;
+
+    pOwner->SetLocalPosition(vNewPos);
+    pOwner->SetLocalRotation(qNewRot);
+  }
+
+  // the input manager and the debug renderer must not be used from the async phase, the next UpdatePose() uses this velocity
+  {
+    // the root velocity features are in m/s in the space of the skeleton, so full input asks for the fastest animation
+    m_vTargetVelocity = GetInputDirection() * m_fMaxRootSpeed;
+
+    ezStringBuilder tmp;
+    tmp.Format("Target Velocity: {0} / {1}", ezArgF(m_vTargetVelocity.x, 1), ezArgF(m_vTargetVelocity.y, 1));
+    ezDebugRenderer::Draw2DText(GetWorld(), tmp, ezVec2I32(10, 10), ezColor::White);
+  }
 }
 
 void ezMotionMatchingComponent::SetAnimation(ezUInt32 uiIndex, const ezAnimationClipResourceHandle& hResource)
@@ -357,31 +428,36 @@ void ezMotionMatchingComponent::Animations_Remove(ezUInt32 uiIndex)
   m_Animations.RemoveAtAndCopy(uiIndex);
 }
 
-ezMotionMatchingComponent::TargetKeyframe ezMotionMatchingComponent::FindNextKeyframe(const TargetKeyframe& current, const ezVec3& vTargetDir) const
+ezMotionMatchingComponent::TargetKeyframe ezMotionMatchingComponent::FindNextKeyframe(const TargetKeyframe& current, const ezVec3& vTargetVelocity) const
 {
   TargetKeyframe kf;
   kf.m_uiAnimClip = current.m_uiAnimClip;
   kf.m_uiKeyframe = current.m_uiKeyframe + 1;
 
   {
-    // ezResourceLock<ezAnimationClipResource> pAnimClipCur(m_Animations[current.m_uiAnimClip], ezResourceAcquireMode::NoFallback);
-    // const auto& animClip = pAnimClipCur->GetDescriptor();
-
-    // const ezUInt32 uiLeftFootJoint = animClip.FindJointIndexByName("Bip01_L_Foot");
-    // const ezUInt32 uiRightFootJoint = animClip.FindJointIndexByName("Bip01_R_Foot");
-
-    const ezVec3 vLeftFootPos = m_vLeftFootPos;   // animClip.GetJointKeyframes(uiLeftFootJoint)[current.m_uiKeyframe].m_vPosition;
-    const ezVec3 vRightFootPos = m_vRightFootPos; // animClip.GetJointKeyframes(uiRightFootJoint)[current.m_uiKeyframe].m_vPosition;
+    ezMotionMatchingFeatures query;
+    query.m_vRootVelocity = vTargetVelocity;
+    query.m_vLeftFootPosition = m_vLeftFootPos;
+    query.m_vRightFootPosition = m_vRightFootPos;
 
-    const ezUInt32 uiBestMM = FindBestKeyframe(current, vLeftFootPos, vRightFootPos, vTargetDir);
+    // the desired trajectory simply continues with the target velocity
+    for (ezUInt32 i = 0; i < ezMotionMatchingFeatures::NumTrajectoryPoints; ++i)
+    {
+      query.m_vTrajectory[i] = (vTargetVelocity * ((i + 1) * ezMotionMatchingFeatures::TrajectoryPointInterval)).GetAsVec2();
+    }
 
-    TargetKeyframe nkf;
-    nkf.m_uiAnimClip = m_MotionData[uiBestMM].m_uiAnimClipIndex;
-    nkf.m_uiKeyframe = m_MotionData[uiBestMM].m_uiKeyframeIndex;
+    const ezUInt32 uiBestEntry = FindBestKeyframe(current, query);
 
-    if ((nkf.m_uiAnimClip != kf.m_uiAnimClip) || (nkf.m_uiKeyframe != kf.m_uiKeyframe && nkf.m_uiKeyframe != current.m_uiKeyframe))
+    if (uiBestEntry != ezInvalidIndex)
     {
-      kf = nkf;
+      TargetKeyframe nkf;
+      nkf.m_uiAnimClip = m_pDatabase->GetEntryClip(uiBestEntry);
+      nkf.m_uiKeyframe = m_pDatabase->GetEntryKeyframe(uiBestEntry);
+
+      if ((nkf.m_uiAnimClip != kf.m_uiAnimClip) || (nkf.m_uiKeyframe != kf.m_uiKeyframe && nkf.m_uiKeyframe != current.m_uiKeyframe))
+      {
+        kf = nkf;
+      }
     }
   }
 
@@ -396,124 +472,28 @@ ezMotionMatchingComponent::TargetKeyframe ezMotionMatchingComponent::FindNextKey
   return kf;
 }
 
-void ezMotionMatchingComponent::PrecomputeMotion(ezDynamicArray<MotionData>& motionData, ezTempHashedString jointName1, ezTempHashedString jointName2,
-  const ezAnimationClipResourceDescriptor& animClip, ezUInt16 uiAnimClipIndex, const ezSkeleton& skeleton)
+ezUInt32 ezMotionMatchingComponent::FindBestKeyframe(const TargetKeyframe& current, const ezMotionMatchingFeatures& query) const
 {
-  const ezUInt16 uiRootJoint = animClip.HasRootMotion() ? animClip.GetRootMotionJoint() : 0xFFFFu;
-  // const ezUInt16 uiJoint1IndexInAnim = animClip.FindJointIndexByName(jointName1);
-  // const ezUInt16 uiJoint2IndexInAnim = animClip.FindJointIndexByName(jointName2);
-
-  const ezUInt16 uiJoint1IndexInSkeleton = skeleton.FindJointByName(jointName1);
-  const ezUInt16 uiJoint2IndexInSkeleton = skeleton.FindJointByName(jointName2);
-  if (uiJoint1IndexInSkeleton == ezInvalidJointIndex || uiJoint2IndexInSkeleton == ezInvalidJointIndex)
-    return;
-
-  const auto& jointNamesToIndices = animClip.GetAllJointIndices();
-
-  const ezUInt32 uiFirstMotionDataIdx = motionData.GetCount();
-  motionData.Reserve(uiFirstMotionDataIdx + animClip.GetNumFrames());
-
-  const float fRootMotionToVelocity = animClip.GetFramesPerSecond();
-
-  ezAnimationPose pose;
-  pose.Configure(skeleton);
-
-  for (ezUInt16 uiFrameIdx = 0; uiFrameIdx < animClip.GetNumFrames(); ++uiFrameIdx)
-  {
-    pose.SetToBindPoseInLocalSpace(skeleton);
-
-    for (ezUInt32 b = 0; b < jointNamesToIndices.GetCount(); ++b)
-    {
-      const ezUInt16 uiJointIndexInPose = skeleton.FindJointByName(jointNamesToIndices.GetKey(b));
-      if (uiJointIndexInPose != ezInvalidJointIndex)
-      {
-        const ezTransform jointTransform = animClip.GetJointKeyframes(jointNamesToIndices.GetValue(b))[uiFrameIdx];
+  if (m_pDatabase == nullptr)
+    return ezInvalidIndex;
 
-        pose.SetTransform(uiJointIndexInPose, jointTransform.GetAsMat4());
-      }
-    }
+  // do NOT allow to transition backwards to a keyframe within a certain range
+  const ezMotionMatchingDatabase::FilterFunction filter([&current](ezUInt16 uiClip, ezUInt16 uiKeyframe) -> bool {
+    return uiClip != current.m_uiAnimClip || uiKeyframe >= current.m_uiKeyframe || uiKeyframe + 10 <= current.m_uiKeyframe;
+  });
 
-    pose.ConvertFromLocalSpaceToObjectSpace(skeleton);
-
-    MotionData& md = motionData.ExpandAndGetRef();
-    md.m_vLeftFootPosition = pose.GetTransform(uiJoint1IndexInSkeleton).GetTranslationVector();
-    md.m_vRightFootPosition = pose.GetTransform(uiJoint2IndexInSkeleton).GetTranslationVector();
-    md.m_uiAnimClipIndex = uiAnimClipIndex;
-    md.m_uiKeyframeIndex = uiFrameIdx;
-    md.m_vLeftFootVelocity.SetZero();
-    md.m_vRightFootVelocity.SetZero();
-    md.m_vRootVelocity =
-      animClip.HasRootMotion() ? fRootMotionToVelocity * animClip.GetJointKeyframes(uiRootJoint)[uiFrameIdx].m_vPosition : ezVec3::ZeroVector();
-  }
+  float fBestDistance = 0.0f;
+  const ezUInt32 uiBestEntry = m_pDatabase->FindBestEntry(query, filter, &fBestDistance);
 
-  // now compute the velocity
+  // prefer to stay on the current keyframe, unless another one matches clearly better
+  const ezUInt32 uiCurrentEntry = m_pDatabase->FindEntry(current.m_uiAnimClip, current.m_uiKeyframe);
+  if (uiBestEntry != ezInvalidIndex && uiCurrentEntry != ezInvalidIndex && m_pDatabase->ComputeDistance(uiCurrentEntry, query) * 0.9f <= fBestDistance)
   {
-    const float fScaleToVelPerSec = animClip.GetFramesPerSecond();
-
-    ezUInt32 uiPrevMdIdx = motionData.GetCount() - 1;
-
-    for (ezUInt32 uiMotionDataIdx = uiFirstMotionDataIdx; uiMotionDataIdx < motionData.GetCount(); ++uiMotionDataIdx)
-    {
-      {
-        ezVec3 vel = motionData[uiMotionDataIdx].m_vLeftFootPosition - motionData[uiPrevMdIdx].m_vLeftFootPosition;
-        motionData[uiMotionDataIdx].m_vLeftFootVelocity = vel * fScaleToVelPerSec;
-      }
-      {
-        ezVec3 vel = motionData[uiMotionDataIdx].m_vRightFootPosition - motionData[uiPrevMdIdx].m_vRightFootPosition;
-        motionData[uiMotionDataIdx].m_vRightFootVelocity = vel * fScaleToVelPerSec;
-      }
-
-      uiPrevMdIdx = uiMotionDataIdx;
-    }
+    return uiCurrentEntry;
   }
-}
 
-ezUInt32 ezMotionMatchingComponent::FindBestKeyframe(
-  const TargetKeyframe& current, ezVec3 vLeftFootPosition, ezVec3 vRightFootPosition, ezVec3 vTargetDir) const
-{
-  float fClosest = 1000000000.0f;
-  ezUInt32 uiClosest = 0xFFFFFFFFu;
-
-  const float fDirWeight = 3.0f;
-
-  for (ezUInt32 i = 0; i < m_MotionData.GetCount(); ++i)
-  {
-    const auto& md = m_MotionData[i];
-
-    float penaltyMul = 1.1f;
-    float penaltyAdd = 100;
-
-    if (md.m_uiAnimClipIndex == current.m_uiAnimClip)
-    {
-      // do NOT allow to transition backwards to a keyframe within a certain range
-      if (md.m_uiKeyframeIndex < current.m_uiKeyframe && md.m_uiKeyframeIndex + 10 > current.m_uiKeyframe)
-        continue;
-
-      penaltyMul = 1.0f;
-
-      if (md.m_uiKeyframeIndex == current.m_uiKeyframe)
-      {
-        penaltyAdd = 0;
-        penaltyMul = 0.9f;
-      }
-    }
-
-    const float dirDist = ezMath::Pow((md.m_vRootVelocity - vTargetDir).GetLength(), fDirWeight);
-    const float leftFootDist = (md.m_vLeftFootPosition - vLeftFootPosition).GetLengthSquared();
-    const float rightFootDist = (md.m_vRightFootPosition - vRightFootPosition).GetLengthSquared();
-
-    const float fScore = dirDist + (leftFootDist + rightFootDist) * penaltyMul + penaltyAdd;
-
-    if (fScore < fClosest)
-    {
-      fClosest = fScore;
-      uiClosest = i;
-    }
-  }
-
-  return uiClosest;
+  return uiBestEntry;
 }
 
 
-
 EZ_STATICLINK_FILE(GameEngine, GameEngine_Animation_Skeletal_Implementation_MotionMatchingComponent);
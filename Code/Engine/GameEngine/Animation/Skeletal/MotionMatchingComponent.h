@@ -3,12 +3,28 @@
 #include <GameEngine/GameEngineDLL.h>
 #include <RendererCore/AnimationSystem/AnimationGraph/AnimationClipSampler.h>
 #include <RendererCore/AnimationSystem/AnimationPose.h>
+#include <RendererCore/AnimationSystem/AnimationPoseSoA.h>
+#include <RendererCore/AnimationSystem/MotionMatchingDatabase.h>
 #include <RendererCore/Meshes/SkinnedMeshComponent.h>
 
 typedef ezTypedResourceHandle<class ezAnimationClipResource> ezAnimationClipResourceHandle;
 typedef ezTypedResourceHandle<class ezSkeletonResource> ezSkeletonResourceHandle;
 
-typedef ezComponentManagerSimple<class ezMotionMatchingComponent, ezComponentUpdateType::WhenSimulating> ezMotionMatchingComponentManager;
+/// \brief Evaluates the poses of all motion matching components in parallel during the asynchronous update phase and publishes them
+/// afterwards.
+class EZ_GAMEENGINE_DLL ezMotionMatchingComponentManager : public ezComponentManager<class ezMotionMatchingComponent, ezBlockStorageType::FreeList>
+{
+  using SUPER = ezComponentManager<class ezMotionMatchingComponent, ezBlockStorageType::FreeList>;
+
+public:
+  ezMotionMatchingComponentManager(ezWorld* pWorld);
+
+  virtual void Initialize() override;
+
+private:
+  void UpdatePoses(const ezWorldModule::UpdateContext& context);
+  void PublishPoses(const ezWorldModule::UpdateContext& context);
+};
 
 class EZ_GAMEENGINE_DLL ezMotionMatchingComponent : public ezSkinnedMeshComponent
 {
@@ -36,7 +52,13 @@ public:
   ezAnimationClipResourceHandle GetAnimation(ezUInt32 uiIndex) const;
 
 protected:
-  void Update();
+  /// \brief Picks the next keyframes and computes the blended pose. Only touches data of this component, so it is called for many
+  /// components in parallel.
+  void UpdatePose();
+
+  /// \brief Sends the new pose to child objects, applies the root motion and reads the input for the next UpdatePose(). Called from the
+  /// synchronous update phase.
+  void PublishPose();
 
   ezUInt32 Animations_GetCount() const;                          // [ property ]
   const char* Animations_GetValue(ezUInt32 uiIndex) const;       // [ property ]
@@ -45,28 +67,25 @@ protected:
   void Animations_Remove(ezUInt32 uiIndex);                      // [ property ]
 
   void ConfigureInput();
+  /// \brief Returns the direction from the input, with a length of at most one.
   ezVec3 GetInputDirection() const;
   ezQuat GetInputRotation() const;
 
+  bool m_bPoseUpdated = false;
+  ezVec3 m_vRootMotion;
+  ezVec3 m_vTargetVelocity; ///< From the input, read in PublishPose() since the input manager is not thread-safe
+  ezAnimationPoseSoA m_LocalPose;
+  ezAnimationPoseSoA m_BlendPose;
   ezAnimationPose m_AnimationPose;
   ezSkeletonResourceHandle m_hSkeleton;
 
   ezDynamicArray<ezAnimationClipResourceHandle> m_Animations;
 
+  ezUInt16 m_uiLeftFootJoint = ezInvalidJointIndex;
+  ezUInt16 m_uiRightFootJoint = ezInvalidJointIndex;
   ezVec3 m_vLeftFootPos;
   ezVec3 m_vRightFootPos;
 
-  struct MotionData
-  {
-    ezUInt16 m_uiAnimClipIndex;
-    ezUInt16 m_uiKeyframeIndex;
-    ezVec3 m_vLeftFootPosition;
-    ezVec3 m_vLeftFootVelocity;
-    ezVec3 m_vRightFootPosition;
-    ezVec3 m_vRightFootVelocity;
-    ezVec3 m_vRootVelocity;
-  };
-
   struct TargetKeyframe
   {
     ezUInt16 m_uiAnimClip;
@@ -77,12 +96,15 @@ protected:
   TargetKeyframe m_Keyframe1;
   float m_fKeyframeLerp = 0.0f;
 
-  TargetKeyframe FindNextKeyframe(const TargetKeyframe& current, const ezVec3& vTargetDir) const;
+  TargetKeyframe FindNextKeyframe(const TargetKeyframe& current, const ezVec3& vTargetVelocity) const;
 
-  ezDynamicArray<MotionData> m_MotionData;
+  /// \brief The features of all keyframes of all animations, retrieved from the skeleton when the simulation starts. Shared by all
+  /// components with the same skeleton and animations.
+  ezSharedPtr<const ezMotionMatchingDatabase> m_pDatabase;
 
-  static void PrecomputeMotion(ezDynamicArray<MotionData>& motionData, ezTempHashedString jointName1, ezTempHashedString jointName2,
-    const ezAnimationClipResourceDescriptor& animClip, ezUInt16 uiAnimClipIndex, const ezSkeleton& skeleton);
+  /// \brief The highest root motion speed of all keyframes. Full input asks for this speed.
+  float m_fMaxRootSpeed = 0.0f;
 
-  ezUInt32 FindBestKeyframe(const TargetKeyframe& current, ezVec3 vLeftFootPosition, ezVec3 vRightFootPosition, ezVec3 vTargetDir) const;
+  /// \brief Returns the database entry that matches the query best, or ezInvalidIndex if there is no database or it is empty.
+  ezUInt32 FindBestKeyframe(const TargetKeyframe& current, const ezMotionMatchingFeatures& query) const;
 };
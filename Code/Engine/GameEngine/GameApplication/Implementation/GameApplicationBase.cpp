@@ -12,6 +12,7 @@
 #include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Time/Clock.h>
 #include <Foundation/Time/Timestamp.h>
+#include <Foundation/Utilities/Stats.h>
 #include <GameEngine/ActorSystem/ActorManager.h>
 #include <GameEngine/GameApplication/GameApplicationBase.h>
 #include <GameEngine/Interfaces/FrameCaptureInterface.h>
@@ -503,6 +504,9 @@ void ezGameApplicationBase::Run_Present() {}
 
 void ezGameApplicationBase::Run_FinishFrame()
 {
+  // write the metrics of this frame into the stats before telemetry sends them
+  ezStats::FlushMetrics();
+
   ezTelemetry::PerFrameUpdate();
   ezResourceManager::PerFrameUpdate();
   ezTaskSystem::FinishFrameTasks();
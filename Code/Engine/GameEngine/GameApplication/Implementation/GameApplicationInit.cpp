@@ -18,6 +18,7 @@
 #include <RendererCore/ShaderCompiler/ShaderManager.h>
 #include <RendererCore/Textures/Texture2DResource.h>
 #include <RendererCore/Textures/TextureCubeResource.h>
+#include <RendererFoundation/Device/Device.h>
 
 #if EZ_ENABLED(EZ_PLATFORM_WINDOWS)
 #  include <RendererDX11/Device/DeviceDX11.h>
@@ -228,21 +229,26 @@ void ezGameApplication::Init_SetupDefaultResources()
 
 void ezGameApplication::Init_SetupGraphicsDevice()
 {
-#if EZ_ENABLED(EZ_PLATFORM_WINDOWS)
   ezGALDeviceCreationDescription DeviceInit;
   DeviceInit.m_bCreatePrimarySwapChain = false;
 
-#  if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
   DeviceInit.m_bDebugDevice = true;
-#  endif
+#endif
 
   {
     ezGALDevice* pDevice = nullptr;
 
     if (s_DefaultDeviceCreator.IsValid())
       pDevice = s_DefaultDeviceCreator(DeviceInit);
+#if EZ_ENABLED(EZ_PLATFORM_WINDOWS)
     else
       pDevice = EZ_DEFAULT_NEW(ezGALDeviceDefault, DeviceInit);
+#endif
+
+    // there is no default device on this platform, only a custom device creator can provide one
+    if (pDevice == nullptr)
+      return;
 
     EZ_VERIFY(pDevice->Init() == EZ_SUCCESS, "Graphics device creation failed!");
     ezGALDevice::SetDefaultDevice(pDevice);
@@ -252,14 +258,8 @@ void ezGameApplication::Init_SetupGraphicsDevice()
   ezGPUResourcePool* pResourcePool = EZ_DEFAULT_NEW(ezGPUResourcePool);
   ezGPUResourcePool::SetDefaultInstance(pResourcePool);
 
-#  if EZ_ENABLED(EZ_PLATFORM_WINDOWS)
+  // the shaders are only compiled for DX11, devices that don't execute shaders, e.g. ezGALDeviceNull, use those as well
   ezShaderManager::Configure("DX11_SM50", true);
-#  else
-  EZ_ASSERT_NOT_IMPLEMENTED;
-  ezShaderManager::Configure("GL3", true);
-#  endif
-
-#endif
 }
 
 void ezGameApplication::Init_LoadRequiredPlugins()
@@ -285,7 +285,6 @@ void ezGameApplication::Init_LoadRequiredPlugins()
 
 void ezGameApplication::Deinit_ShutdownGraphicsDevice()
 {
-#if EZ_ENABLED(EZ_PLATFORM_WINDOWS)
   if (!ezGALDevice::HasDefaultDevice())
     return;
 
@@ -298,7 +297,6 @@ void ezGameApplication::Deinit_ShutdownGraphicsDevice()
   pDevice->Shutdown();
   EZ_DEFAULT_DELETE(pDevice);
   ezGALDevice::SetDefaultDevice(nullptr);
-#endif
 }
 
 
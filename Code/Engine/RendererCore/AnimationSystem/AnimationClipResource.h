@@ -2,11 +2,19 @@
 
 #include <Core/ResourceManager/Resource.h>
 #include <Foundation/Containers/ArrayMap.h>
+#include <Foundation/Containers/Map.h>
 #include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/Mutex.h>
+#include <Foundation/Types/SharedPtr.h>
+#include <RendererCore/AnimationSystem/CompressedAnimationClip.h>
+#include <RendererCore/AnimationSystem/JointMapping.h>
+#include <RendererCore/AnimationSystem/MotionMatchingDatabase.h>
 #include <RendererCore/RendererCoreDLL.h>
 
 class ezAnimationPose;
+class ezAnimationPoseSoA;
 class ezSkeleton;
+class ezSkeletonResource;
 
 struct EZ_RENDERERCORE_DLL ezAnimationClipResourceDescriptor
 {
@@ -25,11 +33,29 @@ public:
   /// \brief returns ezInvalidJointIndex if no joint with the given name is known
   ezUInt16 FindJointIndexByName(const ezTempHashedString& sJointName) const;
 
+  /// \brief Returns the uncompressed keyframes of a joint. Once the clip is compressed, only the root motion joint is still available.
   ezArrayPtr<const ezTransform> GetJointKeyframes(ezUInt16 uiJoint) const;
   ezArrayPtr<ezTransform> GetJointKeyframes(ezUInt16 uiJoint);
 
+  /// \brief Returns the number of joints that SampleJoints() writes, which includes the root motion joint.
+  ezUInt16 GetNumSampledJoints() const;
+
+  /// \brief Computes the local transforms of all joints (indexed like GetAllJointIndices()) at uiFrame + fLerpToNext.
+  ///
+  /// Works for compressed and uncompressed clips. out_JointTransforms must have room for GetNumSampledJoints() transforms.
+  void SampleJoints(ezUInt16 uiFrame, float fLerpToNext, ezArrayPtr<ezTransform> out_JointTransforms) const;
+
+  /// \brief Replaces the keyframes of all joints by their compressed form. The root motion keyframes are kept uncompressed.
+  void Compress(const ezAnimationClipCompressionSettings& settings);
+
+  bool IsCompressed() const { return !m_CompressedKeyframes.IsEmpty(); }
+
+  /// \brief The motion matching features of all frames, computed when the asset is transformed. Empty if the clip has none.
+  const ezMotionMatchingClipFeatures& GetMotionMatchingFeatures() const { return m_MotionMatchingFeatures; }
+  ezMotionMatchingClipFeatures& GetMotionMatchingFeatures() { return m_MotionMatchingFeatures; }
+
   void Save(ezStreamWriter& stream) const;
-  void Load(ezStreamReader& stream);
+  ezResult Load(ezStreamReader& stream);
 
   ezUInt64 GetHeapMemoryUsage() const;
 
@@ -39,8 +65,13 @@ public:
 
   ezUInt16 GetRootMotionJoint() const;
 
-  void SetPoseToKeyframe(ezAnimationPose& pose, const ezSkeleton& skeleton, ezUInt16 uiKeyframe) const;
-  void SetPoseToBlendedKeyframe(ezAnimationPose& pose, const ezSkeleton& skeleton, ezUInt16 uiKeyframe0, float fBlendToKeyframe1) const;
+  /// \brief Writes the sampled joint transforms into the pose. The mapping must have been created from this clip, see
+  /// ezAnimationClipResource::GetJointMapping().
+  void SetPoseToKeyframe(ezAnimationPose& pose, const ezJointMapping& mapping, ezUInt16 uiKeyframe) const;
+  void SetPoseToBlendedKeyframe(ezAnimationPose& pose, const ezJointMapping& mapping, ezUInt16 uiKeyframe0, float fBlendToKeyframe1) const;
+
+  void SetPoseToKeyframe(ezAnimationPoseSoA& pose, const ezJointMapping& mapping, ezUInt16 uiKeyframe) const;
+  void SetPoseToBlendedKeyframe(ezAnimationPoseSoA& pose, const ezJointMapping& mapping, ezUInt16 uiKeyframe0, float fBlendToKeyframe1) const;
 
 private:
   ezUInt16 m_uiNumJoints = 0;
@@ -50,6 +81,8 @@ private:
   ezTime m_Duration;
 
   ezDynamicArray<ezTransform> m_JointTransforms;
+  ezCompressedAnimationClip m_CompressedKeyframes;
+  ezMotionMatchingClipFeatures m_MotionMatchingFeatures;
   ezArrayMap<ezHashedString, ezUInt16> m_JointNameToIndex;
 };
 
@@ -66,10 +99,29 @@ public:
 
   const ezAnimationClipResourceDescriptor& GetDescriptor() const { return m_Descriptor; }
 
+  /// \brief Returns the mapping from the joints of this clip to the joints of the given skeleton.
+  ///
+  /// The mapping is created on first use and cached until this clip or the skeleton is reloaded. It is safe to call this from multiple
+  /// threads. A reload never modifies a mapping that has been returned before, it only creates a new one, so the returned mapping stays
+  /// valid for as long as it is referenced.
+  ezSharedPtr<const ezJointMapping> GetJointMapping(const ezSkeletonResource& skeleton) const;
+
 private:
   virtual ezResourceLoadDesc UnloadData(Unload WhatToUnload) override;
   virtual ezResourceLoadDesc UpdateContent(ezStreamReader* Stream) override;
   virtual void UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage) override;
 
+  void ClearJointMappings();
+
+  struct CachedJointMapping
+  {
+    ezUInt32 m_uiSkeletonIDHash = 0;
+    ezUInt32 m_uiSkeletonChangeCounter = 0;
+    ezSharedPtr<const ezJointMapping> m_pMapping;
+  };
+
   ezAnimationClipResourceDescriptor m_Descriptor;
+
+  mutable ezMutex m_JointMappingMutex;
+  mutable ezMap<const ezSkeletonResource*, CachedJointMapping> m_JointMappings;
 };
@@ -20,7 +20,7 @@ public:
   ~ezAnimationClipSampler();
 
   virtual void Step(ezTime tDiff) override;
-  virtual bool Execute(const ezSkeleton& skeleton, ezAnimationPose& currentPose, ezTransform* pRootMotion) override;
+  virtual bool Execute(const ezSkeletonResource& skeleton, ezAnimationPoseSoA& currentPose, ezTransform* pRootMotion) override;
 
   void Save(ezStreamWriter& stream) const;
   void Load(ezStreamReader& stream);
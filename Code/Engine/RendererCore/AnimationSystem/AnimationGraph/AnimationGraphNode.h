@@ -2,7 +2,7 @@
 
 #include <Core/ResourceManager/ResourceHandle.h>
 #include <Foundation/Time/Time.h>
-#include <RendererCore/AnimationSystem/AnimationPose.h>
+#include <RendererCore/AnimationSystem/AnimationPoseSoA.h>
 
 typedef ezTypedResourceHandle<class ezAnimationClipResource> ezAnimationClipResourceHandle;
 typedef ezTypedResourceHandle<class ezSkeletonResource> ezSkeletonResourceHandle;
@@ -14,5 +14,5 @@ public:
   virtual ~ezAnimationGraphNode();
 
   virtual void Step(ezTime tDiff);
-  virtual bool Execute(const ezSkeleton& skeleton, ezAnimationPose& currentPose, ezTransform* pRootMotion) = 0;
+  virtual bool Execute(const ezSkeletonResource& skeleton, ezAnimationPoseSoA& currentPose, ezTransform* pRootMotion) = 0;
 };
@@ -21,7 +21,7 @@ void ezAnimationClipSampler::Step(ezTime tDiff)
   m_SampleTime = m_SampleTime + tDiff * m_fPlaybackSpeed;
 }
 
-bool ezAnimationClipSampler::Execute(const ezSkeleton& skeleton, ezAnimationPose& currentPose, ezTransform* pRootMotion)
+bool ezAnimationClipSampler::Execute(const ezSkeletonResource& skeleton, ezAnimationPoseSoA& currentPose, ezTransform* pRootMotion)
 {
   // early out, when this is already known
   if (m_State == ezAnimationClipSamplerState::Stopped)
@@ -58,7 +58,7 @@ bool ezAnimationClipSampler::Execute(const ezSkeleton& skeleton, ezAnimationPose
     }
   }
 
-  animDesc.SetPoseToBlendedKeyframe(currentPose, skeleton, uiFirstFrame, (float)fAnimLerp);
+  animDesc.SetPoseToBlendedKeyframe(currentPose, *pAnimClip->GetJointMapping(skeleton), uiFirstFrame, (float)fAnimLerp);
 
   return true;
 }
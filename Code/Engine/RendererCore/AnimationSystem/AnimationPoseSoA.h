@@ -0,0 +1,112 @@
+#pragma once
+
+#include <RendererCore/AnimationSystem/Declarations.h>
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Math/Transform.h>
+#include <Foundation/SimdMath/SimdVec4f.h>
+
+class ezSkeleton;
+
+/// \brief Per joint weights that restrict ezAnimationPoseSoA::Blend() and ezAnimationPoseSoA::AddAdditive() to a part of the skeleton.
+///
+/// A weight of zero leaves a joint unaffected, a weight of one applies the full operation.
+class EZ_RENDERERCORE_DLL ezAnimationJointMask
+{
+public:
+  ezAnimationJointMask();
+  ~ezAnimationJointMask();
+
+  /// \brief Sets the weight of all joints of the skeleton to fWeight.
+  void Configure(const ezSkeleton& skeleton, float fWeight);
+
+  void SetWeight(ezUInt16 uiJoint, float fWeight);
+  float GetWeight(ezUInt16 uiJoint) const;
+
+  /// \brief Sets the weight of uiRootJoint and all its descendants.
+  void SetBranchWeight(const ezSkeleton& skeleton, ezUInt16 uiRootJoint, float fWeight);
+
+private:
+  friend class ezAnimationPoseSoA;
+
+  ezDynamicArray<ezSimdVec4f, ezAlignedAllocatorWrapper> m_Weights; ///< One weight per joint, four joints per element.
+};
+
+/// \brief Stores the local transforms of all joints of a skeleton in structure-of-arrays layout.
+///
+/// The translation, rotation and scale components of four consecutive joints are stored next to each other, so that blending and the
+/// conversion into object space work on four joints with every SIMD instruction. All operations that modify a pose in local space should
+/// be done on this type. ezAnimationPose with its matrices is the output, that is what gets visualized, sent to other components and
+/// uploaded for skinning.
+class EZ_RENDERERCORE_DLL ezAnimationPoseSoA
+{
+public:
+  ezAnimationPoseSoA();
+  ~ezAnimationPoseSoA();
+
+  /// \brief Allocates the streams for the skeleton and precomputes the order in which the hierarchy is converted.
+  void Configure(const ezSkeleton& skeleton);
+
+  ezUInt16 GetJointCount() const { return m_uiNumJoints; }
+
+  /// \brief Sets all joints to the local bind pose of the skeleton.
+  void SetToBindPose(const ezSkeleton& skeleton);
+
+  void SetTransform(ezUInt16 uiJoint, const ezTransform& transform);
+  ezTransform GetTransform(ezUInt16 uiJoint) const;
+
+  /// \brief Blends this pose towards the other pose. Rotations are interpolated with a normalized lerp along the shorter arc.
+  ///
+  /// If a mask is given, fWeight is multiplied by the weight of each joint.
+  void Blend(const ezAnimationPoseSoA& other, float fWeight, const ezAnimationJointMask* pMask = nullptr);
+
+  /// \brief Applies an additive pose, which stores the difference to a reference pose, on top of this pose.
+  ///
+  /// Translations are added, rotations are concatenated in front of the rotations of this pose and scales are multiplied.
+  void AddAdditive(const ezAnimationPoseSoA& additive, float fWeight, const ezAnimationJointMask* pMask = nullptr);
+
+  /// \brief Concatenates the parent transforms of all joints and writes the resulting object space matrices into out_pose.
+  ///
+  /// Joints of the same depth in the hierarchy don't depend on each other, so they are converted four at a time. Like ezTransform, the
+  /// concatenation doesn't introduce shear for non-uniformly scaled parents.
+  /// out_pose must be configured for the same skeleton. All of its transforms are marked as valid.
+  void ConvertToObjectSpace(ezAnimationPose& out_pose);
+
+  /// \brief Writes the skinning matrices of the last ConvertToObjectSpace() call, ie. the object space matrices multiplied with the
+  /// inverse bind pose of each joint.
+  void ConvertToSkinningSpace(ezArrayPtr<ezMat4> out_transforms) const;
+
+private:
+  /// \brief The transforms of four joints.
+  struct JointGroup
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezSimdVec4f m_Position[3];
+    ezSimdVec4f m_Rotation[4];
+    ezSimdVec4f m_Scale[3];
+  };
+
+  /// \brief The upper 3x4 part of the matrices of four joints, row by row.
+  struct MatrixGroup
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezSimdVec4f m_Rows[3][4];
+  };
+
+  static void ComputeMatrices(const JointGroup& group, MatrixGroup& out_matrices);
+
+  ezUInt16 m_uiNumJoints = 0;
+
+  ezDynamicArray<JointGroup, ezAlignedAllocatorWrapper> m_LocalTransforms;
+  ezDynamicArray<JointGroup, ezAlignedAllocatorWrapper> m_ObjectTransforms;
+  ezDynamicArray<MatrixGroup, ezAlignedAllocatorWrapper> m_ObjectMatrices;
+  ezDynamicArray<MatrixGroup, ezAlignedAllocatorWrapper> m_InverseBindPose;
+
+  /// All non-root joints sorted by their depth in the hierarchy, in batches of four that only contain joints of the same depth.
+  /// Batches that are not full repeat their last joint.
+  ezDynamicArray<ezUInt16> m_HierarchyBatches;
+  ezDynamicArray<ezUInt16> m_HierarchyBatchParents;
+  ezDynamicArray<ezUInt16> m_RootJoints;
+};
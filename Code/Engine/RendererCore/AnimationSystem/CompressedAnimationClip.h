@@ -0,0 +1,93 @@
+#pragma once
+
+#include <RendererCore/RendererCoreDLL.h>
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Math/Angle.h>
+#include <Foundation/Math/Transform.h>
+#include <Foundation/Math/Vec4.h>
+
+class ezStreamWriter;
+class ezStreamReader;
+
+/// \brief The tolerances within which ezCompressedAnimationClip may drop keys and whole tracks.
+struct ezAnimationClipCompressionSettings
+{
+  float m_fTranslationTolerance = 0.0001f;              ///< Maximum distance between a compressed and the original position.
+  ezAngle m_RotationTolerance = ezAngle::Degree(0.05f); ///< Maximum angle between a compressed and the original rotation.
+  float m_fScaleTolerance = 0.0001f;                    ///< Maximum difference of each scale component.
+};
+
+/// \brief Stores the keyframes of all joints of an animation clip in a compact form.
+///
+/// Every joint has a translation, a rotation and a scale track. Tracks that don't change (within the tolerances) are reduced to a
+/// single key. All other tracks only keep the keys that can't be reconstructed by interpolating linearly between the neighboring
+/// keys. The tolerances are checked against the quantized keys. Keys are quantized to 16 bit per component, relative to the value range
+/// of their track. Rotations drop the largest component of the quaternion, which is reconstructed during sampling, and store the other
+/// three with 15 bit each. The remaining two bits store which component was dropped.
+///
+/// Sampling decodes four joints at once with SIMD operations. Rotations are interpolated with a normalized lerp.
+class EZ_RENDERERCORE_DLL ezCompressedAnimationClip
+{
+public:
+  ezCompressedAnimationClip();
+  ~ezCompressedAnimationClip();
+
+  /// \brief Compresses the given keyframes, which are stored joint after joint, with uiNumFrames keyframes per joint.
+  void Compress(ezUInt16 uiNumJoints, ezUInt16 uiNumFrames, ezArrayPtr<const ezTransform> jointKeyframes, const ezAnimationClipCompressionSettings& settings);
+
+  void Clear();
+
+  bool IsEmpty() const { return m_Tracks.IsEmpty(); }
+
+  ezUInt16 GetNumJoints() const { return m_uiNumJoints; }
+  ezUInt16 GetNumFrames() const { return m_uiNumFrames; }
+
+  /// \brief Returns the number of keys that are stored for all tracks together. Without compression this would be 3 * joints * frames.
+  ezUInt32 GetNumKeys() const { return m_KeyFrames.GetCount(); }
+
+  /// \brief Computes the local transforms of all joints at the position uiFrame + fLerpToNext.
+  ///
+  /// out_JointTransforms must have room for GetNumJoints() transforms.
+  void SampleJoints(ezUInt16 uiFrame, float fLerpToNext, ezArrayPtr<ezTransform> out_JointTransforms) const;
+
+  void Save(ezStreamWriter& stream) const;
+  ezResult Load(ezStreamReader& stream);
+
+  ezUInt64 GetHeapMemoryUsage() const;
+
+private:
+  enum TrackType
+  {
+    Translation,
+    Rotation,
+    Scale,
+    NumTrackTypes
+  };
+
+  struct Track
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    float m_fMin[3];   ///< The smallest value of each component.
+    float m_fScale[3]; ///< Converts the quantized values back into the value range of the track. Zero for components that don't change.
+    ezUInt32 m_uiFirstKey;
+    ezUInt32 m_uiNumKeys;
+  };
+
+  static ezVec4 InterpolateKeys(TrackType type, const ezVec4& a, const ezVec4& b, float fLerp);
+  static float GetKeyError(TrackType type, const ezVec4& a, const ezVec4& b);
+  static ezVec4 DecodeKey(TrackType type, const Track& track, const ezUInt16* pValue);
+
+  void CompressTrack(TrackType type, ezArrayPtr<const ezVec4> values, float fTolerance, Track& out_track);
+
+  template <TrackType Type>
+  void SampleTrackGroup(ezUInt16 uiFirstJoint, ezUInt16 uiFrame, float fLerpToNext, ezArrayPtr<ezTransform> out_JointTransforms) const;
+
+  ezUInt16 m_uiNumJoints = 0;
+  ezUInt16 m_uiNumFrames = 0;
+
+  ezDynamicArray<Track> m_Tracks;       ///< Three tracks per joint, in the order of TrackType.
+  ezDynamicArray<ezUInt16> m_KeyFrames; ///< The frame of every key.
+  ezDynamicArray<ezUInt16> m_KeyValues; ///< Three quantized components per key.
+};
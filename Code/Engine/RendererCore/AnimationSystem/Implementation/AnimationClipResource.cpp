@@ -3,7 +3,9 @@
 #include <Core/Assets/AssetFileHeader.h>
 #include <RendererCore/AnimationSystem/AnimationClipResource.h>
 #include <RendererCore/AnimationSystem/AnimationPose.h>
+#include <RendererCore/AnimationSystem/AnimationPoseSoA.h>
 #include <RendererCore/AnimationSystem/Skeleton.h>
+#include <RendererCore/AnimationSystem/SkeletonResource.h>
 
 // clang-format off
 EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezAnimationClipResource, 1, ezRTTIDefaultAllocator<ezAnimationClipResource>)
@@ -19,6 +21,7 @@ ezAnimationClipResource::ezAnimationClipResource()
 
 EZ_RESOURCE_IMPLEMENT_CREATEABLE(ezAnimationClipResource, ezAnimationClipResourceDescriptor)
 {
+  ClearJointMappings();
   m_Descriptor = descriptor;
 
   ezResourceLoadDesc res;
@@ -31,6 +34,8 @@ EZ_RESOURCE_IMPLEMENT_CREATEABLE(ezAnimationClipResource, ezAnimationClipResourc
 
 ezResourceLoadDesc ezAnimationClipResource::UnloadData(Unload WhatToUnload)
 {
+  ClearJointMappings();
+
   ezResourceLoadDesc res;
   res.m_uiQualityLevelsDiscardable = 0;
   res.m_uiQualityLevelsLoadable = 0;
@@ -63,7 +68,13 @@ ezResourceLoadDesc ezAnimationClipResource::UpdateContent(ezStreamReader* Stream
   ezAssetFileHeader AssetHash;
   AssetHash.Read(*Stream);
 
-  m_Descriptor.Load(*Stream);
+  ClearJointMappings();
+
+  if (m_Descriptor.Load(*Stream).Failed())
+  {
+    res.m_State = ezResourceState::LoadedResourceMissing;
+    return res;
+  }
 
   res.m_State = ezResourceState::Loaded;
   return res;
@@ -75,6 +86,33 @@ void ezAnimationClipResource::UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage)
   out_NewMemoryUsage.m_uiMemoryCPU = sizeof(ezAnimationClipResource) + static_cast<ezUInt32>(m_Descriptor.GetHeapMemoryUsage());
 }
 
+ezSharedPtr<const ezJointMapping> ezAnimationClipResource::GetJointMapping(const ezSkeletonResource& skeleton) const
+{
+  EZ_LOCK(m_JointMappingMutex);
+
+  // the skeleton's change counter increases whenever it is reloaded, the ID hash guards against a different skeleton at the same address
+  CachedJointMapping& cached = m_JointMappings[&skeleton];
+  if (cached.m_pMapping == nullptr || cached.m_uiSkeletonIDHash != skeleton.GetResourceIDHash() ||
+      cached.m_uiSkeletonChangeCounter != skeleton.GetCurrentResourceChangeCounter())
+  {
+    // other threads may still use the previous mapping, so it is replaced and not rebuilt in place
+    ezSharedPtr<ezJointMapping> pMapping = EZ_DEFAULT_NEW(ezJointMapping);
+    pMapping->CreateMapping(skeleton.GetDescriptor().m_Skeleton, m_Descriptor);
+
+    cached.m_uiSkeletonIDHash = skeleton.GetResourceIDHash();
+    cached.m_uiSkeletonChangeCounter = skeleton.GetCurrentResourceChangeCounter();
+    cached.m_pMapping = pMapping;
+  }
+
+  return cached.m_pMapping;
+}
+
+void ezAnimationClipResource::ClearJointMappings()
+{
+  EZ_LOCK(m_JointMappingMutex);
+  m_JointMappings.Clear();
+}
+
 void ezAnimationClipResourceDescriptor::Configure(ezUInt16 uiNumJoints, ezUInt16 uiNumFrames, ezUInt8 uiFramesPerSecond, bool bIncludeRootMotion)
 {
   EZ_ASSERT_DEV(uiNumFrames >= 2, "Invalid number of key frames");
@@ -136,17 +174,71 @@ ezUInt16 ezAnimationClipResourceDescriptor::FindJointIndexByName(const ezTempHas
 
 ezArrayPtr<const ezTransform> ezAnimationClipResourceDescriptor::GetJointKeyframes(ezUInt16 uiJoint) const
 {
+  EZ_ASSERT_DEBUG((uiJoint + 1) * m_uiNumFrames <= m_JointTransforms.GetCount(), "The keyframes of joint {0} are only available in compressed form", uiJoint);
   return ezArrayPtr<const ezTransform>(&m_JointTransforms[uiJoint * m_uiNumFrames], m_uiNumFrames);
 }
 
 ezArrayPtr<ezTransform> ezAnimationClipResourceDescriptor::GetJointKeyframes(ezUInt16 uiJoint)
 {
+  EZ_ASSERT_DEBUG((uiJoint + 1) * m_uiNumFrames <= m_JointTransforms.GetCount(), "The keyframes of joint {0} are only available in compressed form", uiJoint);
   return ezArrayPtr<ezTransform>(&m_JointTransforms[uiJoint * m_uiNumFrames], m_uiNumFrames);
 }
 
+ezUInt16 ezAnimationClipResourceDescriptor::GetNumSampledJoints() const
+{
+  if (IsCompressed())
+    return m_CompressedKeyframes.GetNumJoints();
+
+  return m_uiNumFrames > 0 ? static_cast<ezUInt16>(m_JointTransforms.GetCount() / m_uiNumFrames) : 0;
+}
+
+void ezAnimationClipResourceDescriptor::SampleJoints(ezUInt16 uiFrame, float fLerpToNext, ezArrayPtr<ezTransform> out_JointTransforms) const
+{
+  if (IsCompressed())
+  {
+    m_CompressedKeyframes.SampleJoints(uiFrame, fLerpToNext, out_JointTransforms);
+    return;
+  }
+
+  const ezUInt16 uiNumJoints = GetNumSampledJoints();
+  EZ_ASSERT_DEV(out_JointTransforms.GetCount() >= uiNumJoints, "Output array is too small");
+
+  if (uiNumJoints == 0)
+    return;
+
+  const ezUInt16 uiNextFrame = ezMath::Min<ezUInt16>(uiFrame + 1, m_uiNumFrames - 1);
+
+  for (ezUInt16 uiJoint = 0; uiJoint < uiNumJoints; ++uiJoint)
+  {
+    const ezTransform& jointTransform1 = m_JointTransforms[uiJoint * m_uiNumFrames + uiFrame];
+    const ezTransform& jointTransform2 = m_JointTransforms[uiJoint * m_uiNumFrames + uiNextFrame];
+
+    ezTransform& res = out_JointTransforms[uiJoint];
+    res.m_vPosition = ezMath::Lerp(jointTransform1.m_vPosition, jointTransform2.m_vPosition, fLerpToNext);
+    res.m_qRotation.SetSlerp(jointTransform1.m_qRotation, jointTransform2.m_qRotation, fLerpToNext);
+    res.m_vScale = ezMath::Lerp(jointTransform1.m_vScale, jointTransform2.m_vScale, fLerpToNext);
+  }
+}
+
+void ezAnimationClipResourceDescriptor::Compress(const ezAnimationClipCompressionSettings& settings)
+{
+  if (IsCompressed() || m_uiNumFrames == 0)
+    return;
+
+  m_CompressedKeyframes.Compress(GetNumSampledJoints(), m_uiNumFrames, m_JointTransforms, settings);
+
+  // root motion is extracted from the raw keyframes, and it is always joint 0
+  if (HasRootMotion())
+    m_JointTransforms.SetCount(m_uiNumFrames);
+  else
+    m_JointTransforms.Clear();
+
+  m_JointTransforms.Compact();
+}
+
 void ezAnimationClipResourceDescriptor::Save(ezStreamWriter& stream) const
 {
-  const ezUInt8 uiVersion = 2;
+  const ezUInt8 uiVersion = 5;
   stream << uiVersion;
 
   stream << m_uiNumJoints;
@@ -166,9 +258,25 @@ void ezAnimationClipResourceDescriptor::Save(ezStreamWriter& stream) const
       stream << m_JointNameToIndex.GetValue(b);
     }
   }
+
+  // version 3
+  {
+    const bool bCompressed = IsCompressed();
+    stream << bCompressed;
+
+    if (bCompressed)
+    {
+      m_CompressedKeyframes.Save(stream);
+    }
+  }
+
+  // version 4
+  {
+    m_MotionMatchingFeatures.Save(stream);
+  }
 }
 
-void ezAnimationClipResourceDescriptor::Load(ezStreamReader& stream)
+ezResult ezAnimationClipResourceDescriptor::Load(ezStreamReader& stream)
 {
   ezUInt8 uiVersion = 0;
   stream >> uiVersion;
@@ -202,12 +310,37 @@ void ezAnimationClipResourceDescriptor::Load(ezStreamReader& stream)
     // should do nothing
     m_JointNameToIndex.Sort();
   }
+
+  m_CompressedKeyframes.Clear();
+
+  // version 3
+  if (uiVersion >= 3)
+  {
+    bool bCompressed = false;
+    stream >> bCompressed;
+
+    if (bCompressed)
+    {
+      EZ_SUCCEED_OR_RETURN(m_CompressedKeyframes.Load(stream));
+    }
+  }
+
+  m_MotionMatchingFeatures.Clear();
+
+  // version 4, the trajectory points were added in version 5
+  if (uiVersion >= 4)
+  {
+    m_MotionMatchingFeatures.Load(stream, uiVersion >= 5);
+  }
+
+  return EZ_SUCCESS;
 }
 
 
 ezUInt64 ezAnimationClipResourceDescriptor::GetHeapMemoryUsage() const
 {
-  return m_JointTransforms.GetHeapMemoryUsage();
+  return m_JointTransforms.GetHeapMemoryUsage() + m_CompressedKeyframes.GetHeapMemoryUsage() +
+         m_MotionMatchingFeatures.m_Frames.GetHeapMemoryUsage();
 }
 
 bool ezAnimationClipResourceDescriptor::HasRootMotion() const
@@ -231,46 +364,40 @@ ezUInt16 ezAnimationClipResourceDescriptor::GetRootMotionJoint() const
   return jointIdx;
 }
 
-void ezAnimationClipResourceDescriptor::SetPoseToKeyframe(ezAnimationPose& pose, const ezSkeleton& skeleton, ezUInt16 uiKeyframe) const
+void ezAnimationClipResourceDescriptor::SetPoseToKeyframe(ezAnimationPose& pose, const ezJointMapping& mapping, ezUInt16 uiKeyframe) const
 {
-  for (ezUInt32 b = 0; b < m_JointNameToIndex.GetCount(); ++b)
-  {
-    const ezHashedString& sJointName = m_JointNameToIndex.GetKey(b);
-    const ezUInt32 uiAnimJointIdx = m_JointNameToIndex.GetValue(b);
-
-    const ezUInt16 uiSkeletonJointIdx = skeleton.FindJointByName(sJointName);
-    if (uiSkeletonJointIdx != ezInvalidJointIndex)
-    {
-      ezArrayPtr<const ezTransform> pTransforms = GetJointKeyframes(uiAnimJointIdx);
-
-      pose.SetTransform(uiSkeletonJointIdx, pTransforms[uiKeyframe].GetAsMat4());
-    }
-  }
+  SetPoseToBlendedKeyframe(pose, mapping, uiKeyframe, 0.0f);
 }
 
 
 void ezAnimationClipResourceDescriptor::SetPoseToBlendedKeyframe(
-  ezAnimationPose& pose, const ezSkeleton& skeleton, ezUInt16 uiKeyframe0, float fBlendToKeyframe1) const
+  ezAnimationPose& pose, const ezJointMapping& mapping, ezUInt16 uiKeyframe0, float fBlendToKeyframe1) const
 {
-  for (ezUInt32 b = 0; b < m_JointNameToIndex.GetCount(); ++b)
+  ezHybridArray<ezTransform, 128> jointTransforms;
+  jointTransforms.SetCountUninitialized(GetNumSampledJoints());
+  SampleJoints(uiKeyframe0, fBlendToKeyframe1, jointTransforms);
+
+  for (const ezJointMapping::Mapping& m : mapping.GetAllMappings())
   {
-    const ezHashedString& sJointName = m_JointNameToIndex.GetKey(b);
-    const ezUInt32 uiAnimJointIdx = m_JointNameToIndex.GetValue(b);
+    pose.SetTransform(m.m_uiJointInSkeleton, jointTransforms[m.m_uiJointInAnimation].GetAsMat4());
+  }
+}
 
-    const ezUInt16 uiSkeletonJointIdx = skeleton.FindJointByName(sJointName);
-    if (uiSkeletonJointIdx != ezInvalidJointIndex)
-    {
-      ezArrayPtr<const ezTransform> pTransforms = GetJointKeyframes(uiAnimJointIdx);
-      const ezTransform jointTransform1 = pTransforms[uiKeyframe0];
-      const ezTransform jointTransform2 = pTransforms[uiKeyframe0 + 1];
+void ezAnimationClipResourceDescriptor::SetPoseToKeyframe(ezAnimationPoseSoA& pose, const ezJointMapping& mapping, ezUInt16 uiKeyframe) const
+{
+  SetPoseToBlendedKeyframe(pose, mapping, uiKeyframe, 0.0f);
+}
 
-      ezTransform res;
-      res.m_vPosition = ezMath::Lerp(jointTransform1.m_vPosition, jointTransform2.m_vPosition, fBlendToKeyframe1);
-      res.m_qRotation.SetSlerp(jointTransform1.m_qRotation, jointTransform2.m_qRotation, fBlendToKeyframe1);
-      res.m_vScale = ezMath::Lerp(jointTransform1.m_vScale, jointTransform2.m_vScale, fBlendToKeyframe1);
+void ezAnimationClipResourceDescriptor::SetPoseToBlendedKeyframe(
+  ezAnimationPoseSoA& pose, const ezJointMapping& mapping, ezUInt16 uiKeyframe0, float fBlendToKeyframe1) const
+{
+  ezHybridArray<ezTransform, 128> jointTransforms;
+  jointTransforms.SetCountUninitialized(GetNumSampledJoints());
+  SampleJoints(uiKeyframe0, fBlendToKeyframe1, jointTransforms);
 
-      pose.SetTransform(uiSkeletonJointIdx, res.GetAsMat4());
-    }
+  for (const ezJointMapping::Mapping& m : mapping.GetAllMappings())
+  {
+    pose.SetTransform(m.m_uiJointInSkeleton, jointTransforms[m.m_uiJointInAnimation]);
   }
 }
 
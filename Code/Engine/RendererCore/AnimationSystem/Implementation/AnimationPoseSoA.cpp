@@ -0,0 +1,485 @@
+#include <RendererCorePCH.h>
+
+#include <RendererCore/AnimationSystem/AnimationPose.h>
+#include <RendererCore/AnimationSystem/AnimationPoseSoA.h>
+#include <RendererCore/AnimationSystem/Skeleton.h>
+
+#include <Foundation/SimdMath/SimdMat4f.h>
+
+namespace
+{
+  constexpr ezUInt32 s_uiNumJointGroupComponents = 10;
+
+  /// Returns the address of a single float of a joint, the components are numbered like in JointGroup.
+  template <typename GroupType>
+  EZ_ALWAYS_INLINE float* GetJointComponent(GroupType* pGroups, ezUInt32 uiJoint, ezUInt32 uiComponent)
+  {
+    return reinterpret_cast<float*>(&pGroups[uiJoint / 4]) + uiComponent * 4 + (uiJoint % 4);
+  }
+
+  template <typename GroupType>
+  EZ_ALWAYS_INLINE const float* GetJointComponent(const GroupType* pGroups, ezUInt32 uiJoint, ezUInt32 uiComponent)
+  {
+    return reinterpret_cast<const float*>(&pGroups[uiJoint / 4]) + uiComponent * 4 + (uiJoint % 4);
+  }
+
+  /// Quaternion multiplication q1 * q2 of four quaternions.
+  EZ_ALWAYS_INLINE void MultiplyQuats(const ezSimdVec4f* q1, const ezSimdVec4f* q2, ezSimdVec4f* out_q)
+  {
+    const ezSimdVec4f x = q1[3].CompMul(q2[0]) + q2[3].CompMul(q1[0]) + q1[1].CompMul(q2[2]) - q1[2].CompMul(q2[1]);
+    const ezSimdVec4f y = q1[3].CompMul(q2[1]) + q2[3].CompMul(q1[1]) + q1[2].CompMul(q2[0]) - q1[0].CompMul(q2[2]);
+    const ezSimdVec4f z = q1[3].CompMul(q2[2]) + q2[3].CompMul(q1[2]) + q1[0].CompMul(q2[1]) - q1[1].CompMul(q2[0]);
+    const ezSimdVec4f w = q1[3].CompMul(q2[3]) - q1[0].CompMul(q2[0]) - q1[1].CompMul(q2[1]) - q1[2].CompMul(q2[2]);
+
+    out_q[0] = x;
+    out_q[1] = y;
+    out_q[2] = z;
+    out_q[3] = w;
+  }
+
+  /// Rotates four vectors by four quaternions.
+  EZ_ALWAYS_INLINE void RotateVectors(const ezSimdVec4f* q, const ezSimdVec4f* v, ezSimdVec4f* out_v)
+  {
+    // t = 2 * cross(q.xyz, v)
+    const ezSimdVec4f tx = (q[1].CompMul(v[2]) - q[2].CompMul(v[1])) * 2.0f;
+    const ezSimdVec4f ty = (q[2].CompMul(v[0]) - q[0].CompMul(v[2])) * 2.0f;
+    const ezSimdVec4f tz = (q[0].CompMul(v[1]) - q[1].CompMul(v[0])) * 2.0f;
+
+    // v + w * t + cross(q.xyz, t)
+    out_v[0] = v[0] + q[3].CompMul(tx) + q[1].CompMul(tz) - q[2].CompMul(ty);
+    out_v[1] = v[1] + q[3].CompMul(ty) + q[2].CompMul(tx) - q[0].CompMul(tz);
+    out_v[2] = v[2] + q[3].CompMul(tz) + q[0].CompMul(ty) - q[1].CompMul(tx);
+  }
+
+  EZ_ALWAYS_INLINE void NormalizeQuats(ezSimdVec4f* q)
+  {
+    const ezSimdVec4f invLength = (q[0].CompMul(q[0]) + q[1].CompMul(q[1]) + q[2].CompMul(q[2]) + q[3].CompMul(q[3])).GetInvSqrt();
+
+    for (ezUInt32 i = 0; i < 4; ++i)
+    {
+      q[i] = q[i].CompMul(invLength);
+    }
+  }
+
+  /// Writes the matrices of uiNumLanes joints, given as the rows of four 3x4 matrices, into column-major ezMat4s.
+  EZ_ALWAYS_INLINE void StoreMatrices(const ezSimdVec4f (&rows)[3][4], ezMat4* pOut, ezUInt32 uiNumLanes)
+  {
+    const ezSimdVec4f zero = ezSimdVec4f::ZeroVector();
+    const ezSimdVec4f one(1.0f);
+
+    for (ezUInt32 c = 0; c < 4; ++c)
+    {
+      // after the transpose, column i holds column c of the matrix in lane i
+      ezSimdMat4f m;
+      m.SetRows(rows[0][c], rows[1][c], rows[2][c], c == 3 ? one : zero);
+
+      const ezSimdVec4f* columns[4] = {&m.m_col0, &m.m_col1, &m.m_col2, &m.m_col3};
+      for (ezUInt32 uiLane = 0; uiLane < uiNumLanes; ++uiLane)
+      {
+        columns[uiLane]->Store<4>(&pOut[uiLane].m_fElementsCM[c * 4]);
+      }
+    }
+  }
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+
+ezAnimationJointMask::ezAnimationJointMask() = default;
+ezAnimationJointMask::~ezAnimationJointMask() = default;
+
+void ezAnimationJointMask::Configure(const ezSkeleton& skeleton, float fWeight)
+{
+  m_Weights.SetCountUninitialized((skeleton.GetJointCount() + 3) / 4);
+
+  for (ezSimdVec4f& weights : m_Weights)
+  {
+    weights.Set(fWeight);
+  }
+}
+
+void ezAnimationJointMask::SetWeight(ezUInt16 uiJoint, float fWeight)
+{
+  *GetJointComponent(m_Weights.GetData(), uiJoint, 0) = fWeight;
+}
+
+float ezAnimationJointMask::GetWeight(ezUInt16 uiJoint) const
+{
+  return *GetJointComponent(m_Weights.GetData(), uiJoint, 0);
+}
+
+void ezAnimationJointMask::SetBranchWeight(const ezSkeleton& skeleton, ezUInt16 uiRootJoint, float fWeight)
+{
+  for (ezUInt16 uiJoint = uiRootJoint; uiJoint < skeleton.GetJointCount(); ++uiJoint)
+  {
+    // children always come after their parents, so nothing before the root joint can be part of the branch
+    if (skeleton.IsJointDescendantOf(uiJoint, uiRootJoint))
+    {
+      SetWeight(uiJoint, fWeight);
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezAnimationPoseSoA::ezAnimationPoseSoA() = default;
+ezAnimationPoseSoA::~ezAnimationPoseSoA() = default;
+
+void ezAnimationPoseSoA::Configure(const ezSkeleton& skeleton)
+{
+  EZ_ASSERT_DEV(skeleton.GetJointCount() > 0, "Animation pose needs a valid skeleton which also has at least one joint!");
+
+  m_uiNumJoints = skeleton.GetJointCount();
+  const ezUInt32 uiNumGroups = (m_uiNumJoints + 3) / 4;
+
+  // unused lanes of the last group hold identity transforms, so that they never produce invalid floats
+  JointGroup identity;
+  for (ezUInt32 i = 0; i < 3; ++i)
+  {
+    identity.m_Position[i].SetZero();
+    identity.m_Rotation[i].SetZero();
+    identity.m_Scale[i].Set(1.0f);
+  }
+  identity.m_Rotation[3].Set(1.0f);
+
+  m_LocalTransforms.SetCountUninitialized(uiNumGroups);
+  m_ObjectTransforms.SetCountUninitialized(uiNumGroups);
+  m_ObjectMatrices.SetCountUninitialized(uiNumGroups);
+  m_InverseBindPose.SetCountUninitialized(uiNumGroups);
+
+  for (ezUInt32 i = 0; i < uiNumGroups; ++i)
+  {
+    m_LocalTransforms[i] = identity;
+    m_ObjectTransforms[i] = identity;
+  }
+
+  for (ezUInt16 uiJoint = 0; uiJoint < m_uiNumJoints; ++uiJoint)
+  {
+    const ezMat4 inverseBindPose = skeleton.GetJointByIndex(uiJoint).GetInverseBindPoseGlobalTransform().GetAsMat4();
+
+    for (ezUInt32 r = 0; r < 3; ++r)
+    {
+      for (ezUInt32 c = 0; c < 4; ++c)
+      {
+        *GetJointComponent(m_InverseBindPose.GetData(), uiJoint, r * 4 + c) = inverseBindPose.Element(c, r);
+      }
+    }
+  }
+
+  // sort the joints by their depth in the hierarchy, parents always come before their children, so the depth is known in a single pass
+  ezHybridArray<ezUInt16, 128> depths;
+  depths.SetCountUninitialized(m_uiNumJoints);
+  ezUInt16 uiMaxDepth = 0;
+
+  m_RootJoints.Clear();
+
+  for (ezUInt16 uiJoint = 0; uiJoint < m_uiNumJoints; ++uiJoint)
+  {
+    const ezSkeletonJoint& joint = skeleton.GetJointByIndex(uiJoint);
+
+    if (joint.IsRootJoint())
+    {
+      depths[uiJoint] = 0;
+      m_RootJoints.PushBack(uiJoint);
+    }
+    else
+    {
+      EZ_ASSERT_DEV(joint.GetParentIndex() < uiJoint, "Joint {0} comes before its parent", uiJoint);
+
+      depths[uiJoint] = depths[joint.GetParentIndex()] + 1;
+      uiMaxDepth = ezMath::Max(uiMaxDepth, depths[uiJoint]);
+    }
+  }
+
+  m_HierarchyBatches.Clear();
+  m_HierarchyBatchParents.Clear();
+
+  for (ezUInt16 uiDepth = 1; uiDepth <= uiMaxDepth; ++uiDepth)
+  {
+    const ezUInt32 uiFirstInLevel = m_HierarchyBatches.GetCount();
+
+    for (ezUInt16 uiJoint = 0; uiJoint < m_uiNumJoints; ++uiJoint)
+    {
+      if (depths[uiJoint] == uiDepth)
+      {
+        m_HierarchyBatches.PushBack(uiJoint);
+        m_HierarchyBatchParents.PushBack(skeleton.GetJointByIndex(uiJoint).GetParentIndex());
+      }
+    }
+
+    // pad the last batch of this level, computing the same joint twice gives the same result
+    while ((m_HierarchyBatches.GetCount() - uiFirstInLevel) % 4 != 0)
+    {
+      m_HierarchyBatches.PushBack(m_HierarchyBatches.PeekBack());
+      m_HierarchyBatchParents.PushBack(m_HierarchyBatchParents.PeekBack());
+    }
+  }
+
+  SetToBindPose(skeleton);
+}
+
+void ezAnimationPoseSoA::SetToBindPose(const ezSkeleton& skeleton)
+{
+  EZ_ASSERT_DEV(skeleton.GetJointCount() == m_uiNumJoints, "Pose and skeleton have different joint count!");
+
+  for (ezUInt16 uiJoint = 0; uiJoint < m_uiNumJoints; ++uiJoint)
+  {
+    SetTransform(uiJoint, skeleton.GetJointByIndex(uiJoint).GetBindPoseLocalTransform());
+  }
+}
+
+void ezAnimationPoseSoA::SetTransform(ezUInt16 uiJoint, const ezTransform& transform)
+{
+  JointGroup* pGroups = m_LocalTransforms.GetData();
+
+  *GetJointComponent(pGroups, uiJoint, 0) = transform.m_vPosition.x;
+  *GetJointComponent(pGroups, uiJoint, 1) = transform.m_vPosition.y;
+  *GetJointComponent(pGroups, uiJoint, 2) = transform.m_vPosition.z;
+  *GetJointComponent(pGroups, uiJoint, 3) = transform.m_qRotation.v.x;
+  *GetJointComponent(pGroups, uiJoint, 4) = transform.m_qRotation.v.y;
+  *GetJointComponent(pGroups, uiJoint, 5) = transform.m_qRotation.v.z;
+  *GetJointComponent(pGroups, uiJoint, 6) = transform.m_qRotation.w;
+  *GetJointComponent(pGroups, uiJoint, 7) = transform.m_vScale.x;
+  *GetJointComponent(pGroups, uiJoint, 8) = transform.m_vScale.y;
+  *GetJointComponent(pGroups, uiJoint, 9) = transform.m_vScale.z;
+}
+
+ezTransform ezAnimationPoseSoA::GetTransform(ezUInt16 uiJoint) const
+{
+  const JointGroup* pGroups = m_LocalTransforms.GetData();
+
+  ezTransform res;
+  res.m_vPosition.Set(*GetJointComponent(pGroups, uiJoint, 0), *GetJointComponent(pGroups, uiJoint, 1), *GetJointComponent(pGroups, uiJoint, 2));
+  res.m_qRotation = ezQuat(*GetJointComponent(pGroups, uiJoint, 3), *GetJointComponent(pGroups, uiJoint, 4), *GetJointComponent(pGroups, uiJoint, 5),
+    *GetJointComponent(pGroups, uiJoint, 6));
+  res.m_vScale.Set(*GetJointComponent(pGroups, uiJoint, 7), *GetJointComponent(pGroups, uiJoint, 8), *GetJointComponent(pGroups, uiJoint, 9));
+  return res;
+}
+
+void ezAnimationPoseSoA::Blend(const ezAnimationPoseSoA& other, float fWeight, const ezAnimationJointMask* pMask)
+{
+  EZ_ASSERT_DEV(other.m_uiNumJoints == m_uiNumJoints, "Poses have different joint count");
+  EZ_ASSERT_DEV(pMask == nullptr || pMask->m_Weights.GetCount() == m_LocalTransforms.GetCount(), "Mask has a different joint count");
+
+  const ezSimdVec4f zero = ezSimdVec4f::ZeroVector();
+
+  for (ezUInt32 g = 0; g < m_LocalTransforms.GetCount(); ++g)
+  {
+    JointGroup& a = m_LocalTransforms[g];
+    const JointGroup& b = other.m_LocalTransforms[g];
+
+    const ezSimdVec4f weight = pMask ? pMask->m_Weights[g] * fWeight : ezSimdVec4f(fWeight);
+
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      a.m_Position[i] = ezSimdVec4f::Lerp(a.m_Position[i], b.m_Position[i], weight);
+      a.m_Scale[i] = ezSimdVec4f::Lerp(a.m_Scale[i], b.m_Scale[i], weight);
+    }
+
+    // interpolate along the shorter arc
+    const ezSimdVec4f dot =
+      a.m_Rotation[0].CompMul(b.m_Rotation[0]) + a.m_Rotation[1].CompMul(b.m_Rotation[1]) + a.m_Rotation[2].CompMul(b.m_Rotation[2]) + a.m_Rotation[3].CompMul(b.m_Rotation[3]);
+    const ezSimdVec4b flip = dot < zero;
+
+    for (ezUInt32 i = 0; i < 4; ++i)
+    {
+      a.m_Rotation[i] = ezSimdVec4f::Lerp(a.m_Rotation[i], b.m_Rotation[i].FlipSign(flip), weight);
+    }
+
+    NormalizeQuats(a.m_Rotation);
+  }
+}
+
+void ezAnimationPoseSoA::AddAdditive(const ezAnimationPoseSoA& additive, float fWeight, const ezAnimationJointMask* pMask)
+{
+  EZ_ASSERT_DEV(additive.m_uiNumJoints == m_uiNumJoints, "Poses have different joint count");
+  EZ_ASSERT_DEV(pMask == nullptr || pMask->m_Weights.GetCount() == m_LocalTransforms.GetCount(), "Mask has a different joint count");
+
+  const ezSimdVec4f zero = ezSimdVec4f::ZeroVector();
+  const ezSimdVec4f one(1.0f);
+
+  for (ezUInt32 g = 0; g < m_LocalTransforms.GetCount(); ++g)
+  {
+    JointGroup& a = m_LocalTransforms[g];
+    const JointGroup& b = additive.m_LocalTransforms[g];
+
+    const ezSimdVec4f weight = pMask ? pMask->m_Weights[g] * fWeight : ezSimdVec4f(fWeight);
+
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      a.m_Position[i] = ezSimdVec4f::MulAdd(b.m_Position[i], weight, a.m_Position[i]);
+      a.m_Scale[i] = a.m_Scale[i].CompMul(ezSimdVec4f::Lerp(one, b.m_Scale[i], weight));
+    }
+
+    // weight the additive rotation by interpolating from the identity rotation along the shorter arc
+    const ezSimdVec4b flip = b.m_Rotation[3] < zero;
+
+    ezSimdVec4f rotation[4];
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      rotation[i] = b.m_Rotation[i].FlipSign(flip).CompMul(weight);
+    }
+    rotation[3] = ezSimdVec4f::Lerp(one, b.m_Rotation[3].FlipSign(flip), weight);
+
+    NormalizeQuats(rotation);
+    MultiplyQuats(rotation, a.m_Rotation, a.m_Rotation);
+  }
+}
+
+void ezAnimationPoseSoA::ComputeMatrices(const JointGroup& group, MatrixGroup& out_matrices)
+{
+  const ezSimdVec4f& x = group.m_Rotation[0];
+  const ezSimdVec4f& y = group.m_Rotation[1];
+  const ezSimdVec4f& z = group.m_Rotation[2];
+  const ezSimdVec4f& w = group.m_Rotation[3];
+
+  const ezSimdVec4f x2 = x + x;
+  const ezSimdVec4f y2 = y + y;
+  const ezSimdVec4f z2 = z + z;
+
+  const ezSimdVec4f xx = x.CompMul(x2);
+  const ezSimdVec4f yy = y.CompMul(y2);
+  const ezSimdVec4f zz = z.CompMul(z2);
+  const ezSimdVec4f xy = x.CompMul(y2);
+  const ezSimdVec4f xz = x.CompMul(z2);
+  const ezSimdVec4f yz = y.CompMul(z2);
+  const ezSimdVec4f wx = w.CompMul(x2);
+  const ezSimdVec4f wy = w.CompMul(y2);
+  const ezSimdVec4f wz = w.CompMul(z2);
+
+  const ezSimdVec4f one(1.0f);
+
+  // rotation matrix with the scale applied to its columns
+  out_matrices.m_Rows[0][0] = (one - yy - zz).CompMul(group.m_Scale[0]);
+  out_matrices.m_Rows[0][1] = (xy - wz).CompMul(group.m_Scale[1]);
+  out_matrices.m_Rows[0][2] = (xz + wy).CompMul(group.m_Scale[2]);
+  out_matrices.m_Rows[0][3] = group.m_Position[0];
+
+  out_matrices.m_Rows[1][0] = (xy + wz).CompMul(group.m_Scale[0]);
+  out_matrices.m_Rows[1][1] = (one - xx - zz).CompMul(group.m_Scale[1]);
+  out_matrices.m_Rows[1][2] = (yz - wx).CompMul(group.m_Scale[2]);
+  out_matrices.m_Rows[1][3] = group.m_Position[1];
+
+  out_matrices.m_Rows[2][0] = (xz - wy).CompMul(group.m_Scale[0]);
+  out_matrices.m_Rows[2][1] = (yz + wx).CompMul(group.m_Scale[1]);
+  out_matrices.m_Rows[2][2] = (one - xx - yy).CompMul(group.m_Scale[2]);
+  out_matrices.m_Rows[2][3] = group.m_Position[2];
+}
+
+void ezAnimationPoseSoA::ConvertToObjectSpace(ezAnimationPose& out_pose)
+{
+  EZ_ASSERT_DEV(out_pose.GetTransformCount() == m_uiNumJoints, "Pose has a different joint count");
+
+  const JointGroup* pLocal = m_LocalTransforms.GetData();
+  JointGroup* pObject = m_ObjectTransforms.GetData();
+
+  for (ezUInt16 uiJoint : m_RootJoints)
+  {
+    for (ezUInt32 c = 0; c < s_uiNumJointGroupComponents; ++c)
+    {
+      *GetJointComponent(pObject, uiJoint, c) = *GetJointComponent(pLocal, uiJoint, c);
+    }
+  }
+
+  // all joints of a batch have the same depth, their parents have been computed by a previous batch
+  for (ezUInt32 uiBatch = 0; uiBatch < m_HierarchyBatches.GetCount(); uiBatch += 4)
+  {
+    const ezUInt16* pJoints = &m_HierarchyBatches[uiBatch];
+    const ezUInt16* pParents = &m_HierarchyBatchParents[uiBatch];
+
+    // the components of a joint are four floats apart
+    const float* pLocalLanes[4];
+    const float* pParentLanes[4];
+    float* pResultLanes[4];
+    for (ezUInt32 uiLane = 0; uiLane < 4; ++uiLane)
+    {
+      pLocalLanes[uiLane] = GetJointComponent(pLocal, pJoints[uiLane], 0);
+      pParentLanes[uiLane] = GetJointComponent(pObject, pParents[uiLane], 0);
+      pResultLanes[uiLane] = GetJointComponent(pObject, pJoints[uiLane], 0);
+    }
+
+    JointGroup local, parent;
+    float* pLocalFloats = reinterpret_cast<float*>(&local);
+    float* pParentFloats = reinterpret_cast<float*>(&parent);
+
+    for (ezUInt32 c = 0; c < s_uiNumJointGroupComponents; ++c)
+    {
+      for (ezUInt32 uiLane = 0; uiLane < 4; ++uiLane)
+      {
+        pLocalFloats[c * 4 + uiLane] = pLocalLanes[uiLane][c * 4];
+        pParentFloats[c * 4 + uiLane] = pParentLanes[uiLane][c * 4];
+      }
+    }
+
+    JointGroup result;
+
+    ezSimdVec4f scaledPosition[3];
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      scaledPosition[i] = local.m_Position[i].CompMul(parent.m_Scale[i]);
+      result.m_Scale[i] = local.m_Scale[i].CompMul(parent.m_Scale[i]);
+    }
+
+    RotateVectors(parent.m_Rotation, scaledPosition, result.m_Position);
+
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      result.m_Position[i] += parent.m_Position[i];
+    }
+
+    MultiplyQuats(parent.m_Rotation, local.m_Rotation, result.m_Rotation);
+
+    const float* pResultFloats = reinterpret_cast<const float*>(&result);
+    for (ezUInt32 c = 0; c < s_uiNumJointGroupComponents; ++c)
+    {
+      for (ezUInt32 uiLane = 0; uiLane < 4; ++uiLane)
+      {
+        pResultLanes[uiLane][c * 4] = pResultFloats[c * 4 + uiLane];
+      }
+    }
+  }
+
+  ezArrayPtr<ezMat4> transforms = out_pose.GetAllTransforms();
+
+  for (ezUInt32 g = 0; g < m_ObjectTransforms.GetCount(); ++g)
+  {
+    ComputeMatrices(m_ObjectTransforms[g], m_ObjectMatrices[g]);
+
+    StoreMatrices(m_ObjectMatrices[g].m_Rows, &transforms[g * 4], ezMath::Min<ezUInt32>(4, m_uiNumJoints - g * 4));
+  }
+
+  out_pose.SetValidityOfAllTransforms(true);
+}
+
+void ezAnimationPoseSoA::ConvertToSkinningSpace(ezArrayPtr<ezMat4> out_transforms) const
+{
+  EZ_ASSERT_DEV(out_transforms.GetCount() >= m_uiNumJoints, "Output array is too small");
+
+  for (ezUInt32 g = 0; g < m_ObjectMatrices.GetCount(); ++g)
+  {
+    const MatrixGroup& o = m_ObjectMatrices[g];
+    const MatrixGroup& i = m_InverseBindPose[g];
+
+    MatrixGroup skinning;
+
+    for (ezUInt32 r = 0; r < 3; ++r)
+    {
+      for (ezUInt32 c = 0; c < 4; ++c)
+      {
+        ezSimdVec4f res = o.m_Rows[r][0].CompMul(i.m_Rows[0][c]);
+        res = ezSimdVec4f::MulAdd(o.m_Rows[r][1], i.m_Rows[1][c], res);
+        res = ezSimdVec4f::MulAdd(o.m_Rows[r][2], i.m_Rows[2][c], res);
+
+        if (c == 3)
+          res += o.m_Rows[r][3];
+
+        skinning.m_Rows[r][c] = res;
+      }
+    }
+
+    StoreMatrices(skinning.m_Rows, &out_transforms[g * 4], ezMath::Min<ezUInt32>(4, m_uiNumJoints - g * 4));
+  }
+}
+
+
+
+EZ_STATICLINK_FILE(RendererCore, RendererCore_AnimationSystem_Implementation_AnimationPoseSoA);
@@ -0,0 +1,504 @@
+#include <RendererCorePCH.h>
+
+#include <Foundation/IO/Stream.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/SimdMath/SimdVec4f.h>
+#include <RendererCore/AnimationSystem/CompressedAnimationClip.h>
+
+namespace
+{
+  // Limits the cost of the key reduction for long tracks that hardly change.
+  constexpr ezUInt32 s_uiMaxKeyDistance = 256;
+
+  constexpr float s_fMaxQuantizedValue = 65535.0f;
+
+  // The top bits of the first two values of a rotation key store which quaternion component was dropped.
+  constexpr float s_fMaxQuantizedRotationValue = 32767.0f;
+  constexpr ezUInt16 s_uiRotationValueMask = 0x7FFFu;
+
+  constexpr ezUInt8 s_uiVersion = 2;
+} // namespace
+
+ezCompressedAnimationClip::ezCompressedAnimationClip() = default;
+ezCompressedAnimationClip::~ezCompressedAnimationClip() = default;
+
+ezVec4 ezCompressedAnimationClip::InterpolateKeys(TrackType type, const ezVec4& a, const ezVec4& b, float fLerp)
+{
+  if (type != Rotation)
+    return ezMath::Lerp(a, b, fLerp);
+
+  // same as the sampler: a normalized lerp along the shorter arc
+  ezVec4 res = ezMath::Lerp(a, a.Dot(b) < 0.0f ? -b : b, fLerp);
+  res.NormalizeIfNotZero(ezVec4(0, 0, 0, 1)).IgnoreResult();
+  return res;
+}
+
+float ezCompressedAnimationClip::GetKeyError(TrackType type, const ezVec4& a, const ezVec4& b)
+{
+  if (type == Rotation)
+  {
+    // |a - b| = 2 * sin(angle / 4), which is much more precise for small angles than the acos of the dot product
+    const float fDistance = ezMath::Min((a - b).GetLength(), (a + b).GetLength());
+    return 4.0f * ezMath::ASin(ezMath::Min(0.5f * fDistance, 1.0f)).GetRadian();
+  }
+
+  if (type == Translation)
+    return (a - b).GetLength();
+
+  const ezVec4 diff = (a - b).Abs();
+  return ezMath::Max(diff.x, ezMath::Max(diff.y, diff.z));
+}
+
+void ezCompressedAnimationClip::Compress(
+  ezUInt16 uiNumJoints, ezUInt16 uiNumFrames, ezArrayPtr<const ezTransform> jointKeyframes, const ezAnimationClipCompressionSettings& settings)
+{
+  EZ_ASSERT_DEV(uiNumFrames > 0, "Invalid number of key frames");
+  EZ_ASSERT_DEV(jointKeyframes.GetCount() == (ezUInt32)uiNumJoints * uiNumFrames, "Expected {0} keyframes, got {1}", (ezUInt32)uiNumJoints * uiNumFrames,
+    jointKeyframes.GetCount());
+
+  Clear();
+
+  m_uiNumJoints = uiNumJoints;
+  m_uiNumFrames = uiNumFrames;
+  m_Tracks.SetCountUninitialized(uiNumJoints * NumTrackTypes);
+
+  ezDynamicArray<ezVec4> values;
+  values.SetCountUninitialized(uiNumFrames);
+
+  for (ezUInt32 uiJoint = 0; uiJoint < uiNumJoints; ++uiJoint)
+  {
+    ezArrayPtr<const ezTransform> keyframes = jointKeyframes.GetSubArray(uiJoint * uiNumFrames, uiNumFrames);
+
+    for (ezUInt32 uiFrame = 0; uiFrame < uiNumFrames; ++uiFrame)
+    {
+      values[uiFrame] = keyframes[uiFrame].m_vPosition.GetAsVec4(0.0f);
+    }
+
+    CompressTrack(Translation, values, settings.m_fTranslationTolerance, m_Tracks[uiJoint * NumTrackTypes + Translation]);
+
+    for (ezUInt32 uiFrame = 0; uiFrame < uiNumFrames; ++uiFrame)
+    {
+      ezQuat q = keyframes[uiFrame].m_qRotation;
+      q.Normalize();
+      values[uiFrame].Set(q.v.x, q.v.y, q.v.z, q.w);
+    }
+
+    CompressTrack(Rotation, values, settings.m_RotationTolerance.GetRadian(), m_Tracks[uiJoint * NumTrackTypes + Rotation]);
+
+    for (ezUInt32 uiFrame = 0; uiFrame < uiNumFrames; ++uiFrame)
+    {
+      values[uiFrame] = keyframes[uiFrame].m_vScale.GetAsVec4(0.0f);
+    }
+
+    CompressTrack(Scale, values, settings.m_fScaleTolerance, m_Tracks[uiJoint * NumTrackTypes + Scale]);
+  }
+
+  m_KeyFrames.Compact();
+  m_KeyValues.Compact();
+}
+
+ezVec4 ezCompressedAnimationClip::DecodeKey(TrackType type, const Track& track, const ezUInt16* pValue)
+{
+  if (type != Rotation)
+  {
+    return ezVec4(pValue[0] * track.m_fScale[0] + track.m_fMin[0], pValue[1] * track.m_fScale[1] + track.m_fMin[1],
+      pValue[2] * track.m_fScale[2] + track.m_fMin[2], 0.0f);
+  }
+
+  float fStored[3];
+  for (ezUInt32 i = 0; i < 3; ++i)
+  {
+    fStored[i] = (pValue[i] & s_uiRotationValueMask) * track.m_fScale[i] + track.m_fMin[i];
+  }
+
+  const ezUInt32 uiLargest = (pValue[0] >> 15) | ((pValue[1] >> 15) << 1);
+  const float fLargest = ezMath::Sqrt(ezMath::Max(0.0f, 1.0f - fStored[0] * fStored[0] - fStored[1] * fStored[1] - fStored[2] * fStored[2]));
+
+  float q[4];
+  for (ezUInt32 i = 0, uiStored = 0; i < 4; ++i)
+  {
+    q[i] = (i == uiLargest) ? fLargest : fStored[uiStored++];
+  }
+
+  return ezVec4(q[0], q[1], q[2], q[3]);
+}
+
+void ezCompressedAnimationClip::CompressTrack(TrackType type, ezArrayPtr<const ezVec4> values, float fTolerance, Track& out_track)
+{
+  const ezUInt32 uiNumFrames = values.GetCount();
+
+  // Rotations drop their largest component, which is made positive and reconstructed from the other three. These are in the range
+  // [-1/sqrt(2), 1/sqrt(2)], which gives a much better precision than dropping w, if w is small.
+  ezHybridArray<ezVec3, 64> stored;
+  ezHybridArray<ezUInt32, 64> largest;
+  stored.SetCountUninitialized(uiNumFrames);
+  largest.SetCount(uiNumFrames);
+
+  for (ezUInt32 uiFrame = 0; uiFrame < uiNumFrames; ++uiFrame)
+  {
+    const ezVec4& v = values[uiFrame];
+
+    if (type != Rotation)
+    {
+      stored[uiFrame] = v.GetAsVec3();
+      continue;
+    }
+
+    const float q[4] = {v.x, v.y, v.z, v.w};
+
+    ezUInt32 uiLargest = 0;
+    for (ezUInt32 i = 1; i < 4; ++i)
+    {
+      uiLargest = ezMath::Abs(q[i]) > ezMath::Abs(q[uiLargest]) ? i : uiLargest;
+    }
+
+    // q and -q are the same rotation
+    const float fSign = q[uiLargest] < 0.0f ? -1.0f : 1.0f;
+
+    for (ezUInt32 i = 0, uiStored = 0; i < 4; ++i)
+    {
+      if (i != uiLargest)
+        stored[uiFrame].GetData()[uiStored++] = q[i] * fSign;
+    }
+
+    largest[uiFrame] = uiLargest;
+  }
+
+  // quantize all frames relative to the value range of the track
+  ezVec3 vMin = stored[0];
+  ezVec3 vMax = vMin;
+  for (const ezVec3& v : stored)
+  {
+    vMin = vMin.CompMin(v);
+    vMax = vMax.CompMax(v);
+  }
+
+  const float fMaxQuantizedValue = type == Rotation ? s_fMaxQuantizedRotationValue : s_fMaxQuantizedValue;
+  const ezVec3 vScale = (vMax - vMin) / fMaxQuantizedValue;
+
+  for (ezUInt32 i = 0; i < 3; ++i)
+  {
+    out_track.m_fMin[i] = vMin.GetData()[i];
+    out_track.m_fScale[i] = vScale.GetData()[i];
+  }
+
+  ezHybridArray<ezUInt16, 64 * 3> quantized;
+  quantized.SetCountUninitialized(uiNumFrames * 3);
+
+  for (ezUInt32 uiFrame = 0; uiFrame < uiNumFrames; ++uiFrame)
+  {
+    ezUInt16* pQuantized = &quantized[uiFrame * 3];
+
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      const float fValue = stored[uiFrame].GetData()[i];
+      const float fQuantized = out_track.m_fScale[i] > 0.0f ? ezMath::Round((fValue - out_track.m_fMin[i]) / out_track.m_fScale[i]) : 0.0f;
+      pQuantized[i] = static_cast<ezUInt16>(ezMath::Clamp(fQuantized, 0.0f, fMaxQuantizedValue));
+    }
+
+    if (type == Rotation)
+    {
+      pQuantized[0] |= static_cast<ezUInt16>((largest[uiFrame] & 1u) << 15);
+      pQuantized[1] |= static_cast<ezUInt16>((largest[uiFrame] >> 1) << 15);
+    }
+  }
+
+  // the key reduction compares what the sampler will actually reconstruct with the original values, so the quantization error counts too
+  ezHybridArray<ezVec4, 64> decoded;
+  decoded.SetCountUninitialized(uiNumFrames);
+
+  for (ezUInt32 uiFrame = 0; uiFrame < uiNumFrames; ++uiFrame)
+  {
+    decoded[uiFrame] = DecodeKey(type, out_track, &quantized[uiFrame * 3]);
+  }
+
+  bool bConstant = true;
+  for (ezUInt32 uiFrame = 0; uiFrame < uiNumFrames && bConstant; ++uiFrame)
+  {
+    bConstant = GetKeyError(type, decoded[0], values[uiFrame]) <= fTolerance;
+  }
+
+  ezHybridArray<ezUInt16, 64> keys;
+  keys.PushBack(0);
+
+  if (!bConstant)
+  {
+    // greedily extend every segment as long as linear interpolation between its ends reproduces all frames in between
+    ezUInt32 uiStart = 0;
+    while (uiStart + 1 < uiNumFrames)
+    {
+      ezUInt32 uiEnd = uiStart + 1;
+
+      while (uiEnd + 1 < uiNumFrames && uiEnd + 1 - uiStart <= s_uiMaxKeyDistance)
+      {
+        const ezUInt32 uiCandidate = uiEnd + 1;
+        const float fInvLength = 1.0f / (uiCandidate - uiStart);
+
+        bool bWithinTolerance = true;
+        for (ezUInt32 uiFrame = uiStart + 1; uiFrame < uiCandidate && bWithinTolerance; ++uiFrame)
+        {
+          const ezVec4 interpolated = InterpolateKeys(type, decoded[uiStart], decoded[uiCandidate], (uiFrame - uiStart) * fInvLength);
+          bWithinTolerance = GetKeyError(type, interpolated, values[uiFrame]) <= fTolerance;
+        }
+
+        if (!bWithinTolerance)
+          break;
+
+        uiEnd = uiCandidate;
+      }
+
+      keys.PushBack(static_cast<ezUInt16>(uiEnd));
+      uiStart = uiEnd;
+    }
+  }
+
+  out_track.m_uiFirstKey = m_KeyFrames.GetCount();
+  out_track.m_uiNumKeys = keys.GetCount();
+
+  for (ezUInt16 uiKeyFrame : keys)
+  {
+    m_KeyFrames.PushBack(uiKeyFrame);
+    m_KeyValues.PushBackRange(ezMakeArrayPtr(&quantized[uiKeyFrame * 3], 3));
+  }
+}
+
+void ezCompressedAnimationClip::Clear()
+{
+  m_uiNumJoints = 0;
+  m_uiNumFrames = 0;
+  m_Tracks.Clear();
+  m_KeyFrames.Clear();
+  m_KeyValues.Clear();
+}
+
+void ezCompressedAnimationClip::SampleJoints(ezUInt16 uiFrame, float fLerpToNext, ezArrayPtr<ezTransform> out_JointTransforms) const
+{
+  EZ_ASSERT_DEV(out_JointTransforms.GetCount() >= m_uiNumJoints, "Not enough space for {0} joints", m_uiNumJoints);
+
+  for (ezUInt32 uiFirstJoint = 0; uiFirstJoint < m_uiNumJoints; uiFirstJoint += 4)
+  {
+    SampleTrackGroup<Translation>(static_cast<ezUInt16>(uiFirstJoint), uiFrame, fLerpToNext, out_JointTransforms);
+    SampleTrackGroup<Rotation>(static_cast<ezUInt16>(uiFirstJoint), uiFrame, fLerpToNext, out_JointTransforms);
+    SampleTrackGroup<Scale>(static_cast<ezUInt16>(uiFirstJoint), uiFrame, fLerpToNext, out_JointTransforms);
+  }
+}
+
+template <ezCompressedAnimationClip::TrackType Type>
+void ezCompressedAnimationClip::SampleTrackGroup(
+  ezUInt16 uiFirstJoint, ezUInt16 uiFrame, float fLerpToNext, ezArrayPtr<ezTransform> out_JointTransforms) const
+{
+  const ezUInt32 uiNumLanes = ezMath::Min<ezUInt32>(4, m_uiNumJoints - uiFirstJoint);
+
+  // Gather the keys of four tracks in SoA layout. Unused lanes repeat the last joint.
+  EZ_ALIGN_16(float fKeyA[3][4]);
+  EZ_ALIGN_16(float fKeyB[3][4]);
+  EZ_ALIGN_16(float fMin[3][4]);
+  EZ_ALIGN_16(float fScale[3][4]);
+  EZ_ALIGN_16(float fLerp[4]);
+  EZ_ALIGN_16(float fLargestA[4]);
+  EZ_ALIGN_16(float fLargestB[4]);
+
+  // the arrays are accessed directly, this is the innermost loop of every animated mesh
+  const Track* pTracks = m_Tracks.GetData();
+  const ezUInt16* pKeyFrames = m_KeyFrames.GetData();
+  const ezUInt16* pKeyValues = m_KeyValues.GetData();
+  const float fFrame = uiFrame + fLerpToNext;
+
+  for (ezUInt32 uiLane = 0; uiLane < 4; ++uiLane)
+  {
+    const ezUInt32 uiJoint = uiFirstJoint + ezMath::Min(uiLane, uiNumLanes - 1);
+    const Track& track = pTracks[uiJoint * NumTrackTypes + Type];
+
+    // binary search for the last key at or before uiFrame
+    const ezUInt16* pFirst = pKeyFrames + track.m_uiFirstKey;
+    ezUInt32 uiKeyA = 0;
+    ezUInt32 uiCount = track.m_uiNumKeys;
+    while (uiCount > 1)
+    {
+      const ezUInt32 uiHalf = uiCount / 2;
+      uiKeyA = (pFirst[uiKeyA + uiHalf] <= uiFrame) ? uiKeyA + uiHalf : uiKeyA;
+      uiCount -= uiHalf;
+    }
+
+    const ezUInt32 uiKeyB = ezMath::Min(uiKeyA + 1, track.m_uiNumKeys - 1);
+
+    fLerp[uiLane] = 0.0f;
+    if (uiKeyB != uiKeyA)
+    {
+      const float fFrameA = pFirst[uiKeyA];
+      fLerp[uiLane] = (fFrame - fFrameA) / (pFirst[uiKeyB] - fFrameA);
+    }
+
+    const ezUInt16* pValueA = pKeyValues + (track.m_uiFirstKey + uiKeyA) * 3;
+    const ezUInt16* pValueB = pKeyValues + (track.m_uiFirstKey + uiKeyB) * 3;
+
+    const ezUInt16 uiValueMask = (Type == Rotation) ? s_uiRotationValueMask : 0xFFFFu;
+
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      fKeyA[i][uiLane] = pValueA[i] & uiValueMask;
+      fKeyB[i][uiLane] = pValueB[i] & uiValueMask;
+      fMin[i][uiLane] = track.m_fMin[i];
+      fScale[i][uiLane] = track.m_fScale[i];
+    }
+
+    fLargestA[uiLane] = static_cast<float>((pValueA[0] >> 15) | ((pValueA[1] >> 15) << 1));
+    fLargestB[uiLane] = static_cast<float>((pValueB[0] >> 15) | ((pValueB[1] >> 15) << 1));
+  }
+
+  ezSimdVec4f lerp;
+  lerp.Load<4>(fLerp);
+
+  ezSimdVec4f a[3], b[3], res[4];
+  for (ezUInt32 i = 0; i < 3; ++i)
+  {
+    ezSimdVec4f vMin, vScale, vKeyA, vKeyB;
+    vMin.Load<4>(fMin[i]);
+    vScale.Load<4>(fScale[i]);
+    vKeyA.Load<4>(fKeyA[i]);
+    vKeyB.Load<4>(fKeyB[i]);
+
+    a[i] = ezSimdVec4f::MulAdd(vKeyA, vScale, vMin);
+    b[i] = ezSimdVec4f::MulAdd(vKeyB, vScale, vMin);
+  }
+
+  if (Type == Rotation)
+  {
+    const ezSimdVec4f zero = ezSimdVec4f::ZeroVector();
+    const ezSimdVec4f one(1.0f);
+    const ezSimdVec4f two(2.0f);
+    const ezSimdVec4f three(3.0f);
+
+    // reconstruct the dropped component and move it to its place, the stored components keep their order
+    auto Decode = [&](const ezSimdVec4f* pStored, const float* pLargest, ezSimdVec4f* out_pQuat) {
+      ezSimdVec4f largest;
+      largest.Load<4>(pLargest);
+
+      const ezSimdVec4f lengthSquared = pStored[0].CompMul(pStored[0]) + pStored[1].CompMul(pStored[1]) + pStored[2].CompMul(pStored[2]);
+      const ezSimdVec4f w = (one - lengthSquared).CompMax(zero).GetSqrt();
+
+      out_pQuat[0] = ezSimdVec4f::Select(largest == zero, w, pStored[0]);
+      out_pQuat[1] = ezSimdVec4f::Select(largest < one, pStored[0], ezSimdVec4f::Select(largest == one, w, pStored[1]));
+      out_pQuat[2] = ezSimdVec4f::Select(largest < two, pStored[1], ezSimdVec4f::Select(largest == two, w, pStored[2]));
+      out_pQuat[3] = ezSimdVec4f::Select(largest < three, pStored[2], w);
+    };
+
+    ezSimdVec4f qa[4], qb[4];
+    Decode(a, fLargestA, qa);
+    Decode(b, fLargestB, qb);
+
+    // interpolate along the shorter arc
+    const ezSimdVec4f dot = qa[0].CompMul(qb[0]) + qa[1].CompMul(qb[1]) + qa[2].CompMul(qb[2]) + qa[3].CompMul(qb[3]);
+    const ezSimdVec4b flip = dot < zero;
+
+    for (ezUInt32 i = 0; i < 4; ++i)
+    {
+      res[i] = ezSimdVec4f::Lerp(qa[i], qb[i].FlipSign(flip), lerp);
+    }
+
+    const ezSimdVec4f invLength = (res[0].CompMul(res[0]) + res[1].CompMul(res[1]) + res[2].CompMul(res[2]) + res[3].CompMul(res[3])).GetInvSqrt();
+    for (ezUInt32 i = 0; i < 4; ++i)
+    {
+      res[i] = res[i].CompMul(invLength);
+    }
+  }
+  else
+  {
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      res[i] = ezSimdVec4f::Lerp(a[i], b[i], lerp);
+    }
+  }
+
+  EZ_ALIGN_16(float fResult[4][4]);
+  for (ezUInt32 i = 0; i < (Type == Rotation ? 4u : 3u); ++i)
+  {
+    res[i].Store<4>(fResult[i]);
+  }
+
+  for (ezUInt32 uiLane = 0; uiLane < uiNumLanes; ++uiLane)
+  {
+    ezTransform& transform = out_JointTransforms[uiFirstJoint + uiLane];
+
+    if (Type == Translation)
+      transform.m_vPosition.Set(fResult[0][uiLane], fResult[1][uiLane], fResult[2][uiLane]);
+    else if (Type == Rotation)
+      transform.m_qRotation = ezQuat(fResult[0][uiLane], fResult[1][uiLane], fResult[2][uiLane], fResult[3][uiLane]);
+    else
+      transform.m_vScale.Set(fResult[0][uiLane], fResult[1][uiLane], fResult[2][uiLane]);
+  }
+}
+
+void ezCompressedAnimationClip::Save(ezStreamWriter& stream) const
+{
+  stream << s_uiVersion;
+
+  stream << m_uiNumJoints;
+  stream << m_uiNumFrames;
+
+  const ezUInt32 uiNumTracks = m_Tracks.GetCount();
+  stream << uiNumTracks;
+
+  for (const Track& track : m_Tracks)
+  {
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      stream << track.m_fMin[i];
+      stream << track.m_fScale[i];
+    }
+
+    stream << track.m_uiFirstKey;
+    stream << track.m_uiNumKeys;
+  }
+
+  stream.WriteArray(m_KeyFrames);
+  stream.WriteArray(m_KeyValues);
+}
+
+ezResult ezCompressedAnimationClip::Load(ezStreamReader& stream)
+{
+  Clear();
+
+  ezUInt8 uiVersion = 0;
+  stream >> uiVersion;
+
+  // version 1 stored rotations with positive w instead of the smallest three components, it can't be sampled anymore
+  if (uiVersion != s_uiVersion)
+  {
+    ezLog::Error("Unsupported compressed animation clip version {0}, the asset needs to be transformed again", uiVersion);
+    return EZ_FAILURE;
+  }
+
+  stream >> m_uiNumJoints;
+  stream >> m_uiNumFrames;
+
+  ezUInt32 uiNumTracks = 0;
+  stream >> uiNumTracks;
+  m_Tracks.SetCountUninitialized(uiNumTracks);
+
+  for (Track& track : m_Tracks)
+  {
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      stream >> track.m_fMin[i];
+      stream >> track.m_fScale[i];
+    }
+
+    stream >> track.m_uiFirstKey;
+    stream >> track.m_uiNumKeys;
+  }
+
+  stream.ReadArray(m_KeyFrames);
+  stream.ReadArray(m_KeyValues);
+
+  return EZ_SUCCESS;
+}
+
+ezUInt64 ezCompressedAnimationClip::GetHeapMemoryUsage() const
+{
+  return m_Tracks.GetHeapMemoryUsage() + m_KeyFrames.GetHeapMemoryUsage() + m_KeyValues.GetHeapMemoryUsage();
+}
+
+
+
+EZ_STATICLINK_FILE(RendererCore, RendererCore_AnimationSystem_Implementation_CompressedAnimationClip);
@@ -0,0 +1,543 @@
+#include <RendererCorePCH.h>
+
+#include <Foundation/Algorithm/Sorting.h>
+#include <Foundation/IO/Stream.h>
+#include <RendererCore/AnimationSystem/AnimationClipResource.h>
+#include <RendererCore/AnimationSystem/AnimationPose.h>
+#include <RendererCore/AnimationSystem/JointMapping.h>
+#include <RendererCore/AnimationSystem/MotionMatchingDatabase.h>
+#include <RendererCore/AnimationSystem/Skeleton.h>
+
+bool ezMotionMatchingClipFeatures::Compute(const ezAnimationClipResourceDescriptor& clip, const ezJointMapping& mapping, const ezSkeleton& skeleton,
+  const ezHashedString& sLeftFootJoint, const ezHashedString& sRightFootJoint)
+{
+  Clear();
+
+  const ezUInt16 uiLeftFootJoint = skeleton.FindJointByName(sLeftFootJoint);
+  const ezUInt16 uiRightFootJoint = skeleton.FindJointByName(sRightFootJoint);
+
+  if (uiLeftFootJoint == ezInvalidJointIndex || uiRightFootJoint == ezInvalidJointIndex)
+    return false;
+
+  m_sLeftFootJoint = sLeftFootJoint;
+  m_sRightFootJoint = sRightFootJoint;
+
+  const bool bHasRootMotion = clip.HasRootMotion();
+  const ezUInt16 uiRootMotionJoint = bHasRootMotion ? clip.GetRootMotionJoint() : ezInvalidJointIndex;
+  const float fRootMotionToVelocity = clip.GetFramesPerSecond();
+
+  ezAnimationPose pose;
+  pose.Configure(skeleton);
+
+  const ezUInt16 uiNumFrames = clip.GetNumFrames();
+  m_Frames.SetCountUninitialized(uiNumFrames);
+
+  ezUInt32 uiTrajectoryFrames[ezMotionMatchingFeatures::NumTrajectoryPoints];
+  for (ezUInt32 i = 0; i < ezMotionMatchingFeatures::NumTrajectoryPoints; ++i)
+  {
+    uiTrajectoryFrames[i] = ezMath::Max(1u, (ezUInt32)ezMath::Round((i + 1) * ezMotionMatchingFeatures::TrajectoryPointInterval * clip.GetFramesPerSecond()));
+  }
+
+  for (ezUInt16 uiFrame = 0; uiFrame < clip.GetNumFrames(); ++uiFrame)
+  {
+    pose.SetToBindPoseInLocalSpace(skeleton);
+    clip.SetPoseToKeyframe(pose, mapping, uiFrame);
+    pose.ConvertFromLocalSpaceToObjectSpace(skeleton);
+
+    ezMotionMatchingFeatures& features = m_Frames[uiFrame];
+    features.m_vLeftFootPosition = pose.GetTransform(uiLeftFootJoint).GetTranslationVector();
+    features.m_vRightFootPosition = pose.GetTransform(uiRightFootJoint).GetTranslationVector();
+    features.m_vRootVelocity =
+      bHasRootMotion ? fRootMotionToVelocity * clip.GetJointKeyframes(uiRootMotionJoint)[uiFrame].m_vPosition : ezVec3::ZeroVector();
+
+    // accumulate the root motion of the following frames, wrapping around at the end, as clips are played in a loop
+    ezVec3 vOffset = ezVec3::ZeroVector();
+    ezUInt32 uiOffsetFrames = 0;
+
+    for (ezUInt32 i = 0; i < ezMotionMatchingFeatures::NumTrajectoryPoints; ++i)
+    {
+      if (bHasRootMotion)
+      {
+        for (; uiOffsetFrames < uiTrajectoryFrames[i]; ++uiOffsetFrames)
+        {
+          vOffset += clip.GetJointKeyframes(uiRootMotionJoint)[(uiFrame + uiOffsetFrames) % uiNumFrames].m_vPosition;
+        }
+      }
+
+      features.m_vTrajectory[i] = vOffset.GetAsVec2();
+    }
+  }
+
+  return true;
+}
+
+void ezMotionMatchingClipFeatures::Clear()
+{
+  m_sLeftFootJoint.Clear();
+  m_sRightFootJoint.Clear();
+  m_Frames.Clear();
+}
+
+void ezMotionMatchingClipFeatures::Save(ezStreamWriter& stream) const
+{
+  stream << m_sLeftFootJoint;
+  stream << m_sRightFootJoint;
+
+  const ezUInt32 uiNumFrames = m_Frames.GetCount();
+  stream << uiNumFrames;
+
+  for (const ezMotionMatchingFeatures& features : m_Frames)
+  {
+    stream << features.m_vRootVelocity;
+    stream << features.m_vLeftFootPosition;
+    stream << features.m_vRightFootPosition;
+
+    for (const ezVec2& vPoint : features.m_vTrajectory)
+    {
+      stream << vPoint;
+    }
+  }
+}
+
+void ezMotionMatchingClipFeatures::Load(ezStreamReader& stream, bool bWithTrajectory)
+{
+  stream >> m_sLeftFootJoint;
+  stream >> m_sRightFootJoint;
+
+  ezUInt32 uiNumFrames = 0;
+  stream >> uiNumFrames;
+  m_Frames.SetCountUninitialized(uiNumFrames);
+
+  for (ezMotionMatchingFeatures& features : m_Frames)
+  {
+    stream >> features.m_vRootVelocity;
+    stream >> features.m_vLeftFootPosition;
+    stream >> features.m_vRightFootPosition;
+
+    if (bWithTrajectory)
+    {
+      for (ezVec2& vPoint : features.m_vTrajectory)
+      {
+        stream >> vPoint;
+      }
+    }
+  }
+
+  if (!bWithTrajectory)
+  {
+    Clear();
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+  // the query is compared against the padding in the last group as well, so these should never be closer than any real entry
+  constexpr float s_fPaddingValue = 1e15f;
+
+  struct PointComparer
+  {
+    EZ_ALWAYS_INLINE float GetValue(ezUInt32 uiPoint) const { return m_pValues[uiPoint * m_uiStride + m_uiDimension]; }
+    EZ_ALWAYS_INLINE bool Less(ezUInt32 a, ezUInt32 b) const { return GetValue(a) < GetValue(b); }
+    EZ_ALWAYS_INLINE bool Equal(ezUInt32 a, ezUInt32 b) const { return GetValue(a) == GetValue(b); }
+
+    const float* m_pValues;
+    ezUInt32 m_uiStride;
+    ezUInt32 m_uiDimension;
+  };
+
+  EZ_ALWAYS_INLINE const float* GetFeatureValues(const ezMotionMatchingFeatures& features)
+  {
+    static_assert(sizeof(ezMotionMatchingFeatures) == sizeof(float) * (9 + 2 * ezMotionMatchingFeatures::NumTrajectoryPoints),
+      "The features are expected to be a tightly packed float array");
+    return &features.m_vRootVelocity.x;
+  }
+} // namespace
+
+ezMotionMatchingDatabase::ezMotionMatchingDatabase()
+{
+  for (ezUInt32 d = 0; d < NumDimensions; ++d)
+  {
+    m_fMean[d] = 0.0f;
+    m_fScale[d] = 1.0f;
+  }
+}
+
+ezMotionMatchingDatabase::~ezMotionMatchingDatabase() = default;
+
+void ezMotionMatchingDatabase::Clear()
+{
+  m_Features.Clear();
+  m_Entries.Clear();
+  m_Clips.Clear();
+  m_fMaxRootSpeed = 0.0f;
+  m_Groups.Clear();
+  m_GroupEntries.Clear();
+  m_Nodes.Clear();
+}
+
+void ezMotionMatchingDatabase::AddClip(ezUInt16 uiClip, ezArrayPtr<const ezMotionMatchingFeatures> frames)
+{
+  while (m_Clips.GetCount() <= uiClip)
+  {
+    ClipRange& range = m_Clips.ExpandAndGetRef();
+    range.m_uiFirstEntry = 0;
+    range.m_uiNumEntries = 0;
+  }
+
+  EZ_ASSERT_DEV(m_Clips[uiClip].m_uiNumEntries == 0, "Clip {0} has been added before", uiClip);
+  EZ_ASSERT_DEV(frames.GetCount() <= 0xFFFFu, "Too many frames in clip {0}", uiClip);
+
+  m_Clips[uiClip].m_uiFirstEntry = m_Entries.GetCount();
+  m_Clips[uiClip].m_uiNumEntries = frames.GetCount();
+
+  m_Features.PushBackRange(frames);
+
+  for (ezUInt32 uiFrame = 0; uiFrame < frames.GetCount(); ++uiFrame)
+  {
+    Entry& entry = m_Entries.ExpandAndGetRef();
+    entry.m_uiClip = uiClip;
+    entry.m_uiKeyframe = static_cast<ezUInt16>(uiFrame);
+
+    m_fMaxRootSpeed = ezMath::Max(m_fMaxRootSpeed, frames[uiFrame].m_vRootVelocity.GetLength());
+  }
+}
+
+void ezMotionMatchingDatabase::Build(const Weights& weights)
+{
+  m_Groups.Clear();
+  m_GroupEntries.Clear();
+  m_Nodes.Clear();
+
+  const ezUInt32 uiNumEntries = m_Entries.GetCount();
+  if (uiNumEntries == 0)
+    return;
+
+  // normalize every dimension by the standard deviation of the feature that it belongs to, so that the weights are independent of units
+  {
+    double fSum[NumDimensions] = {};
+    double fSumSquared[NumDimensions] = {};
+
+    for (const ezMotionMatchingFeatures& features : m_Features)
+    {
+      const float* pValues = GetFeatureValues(features);
+
+      for (ezUInt32 d = 0; d < NumDimensions; ++d)
+      {
+        fSum[d] += pValues[d];
+        fSumSquared[d] += (double)pValues[d] * pValues[d];
+      }
+    }
+
+    double fVariance[NumDimensions];
+    for (ezUInt32 d = 0; d < NumDimensions; ++d)
+    {
+      const double fMean = fSum[d] / uiNumEntries;
+      m_fMean[d] = (float)fMean;
+      fVariance[d] = ezMath::Max(0.0, fSumSquared[d] / uiNumEntries - fMean * fMean);
+    }
+
+    // dimensions 0 - 2 are the root velocity, 3 - 8 the pose and the rest the future trajectory points
+    auto GetScale = [&](ezUInt32 uiFirst, ezUInt32 uiEnd, float fWeight) {
+      double fVarianceSum = 0.0;
+      for (ezUInt32 d = uiFirst; d < uiEnd; ++d)
+      {
+        fVarianceSum += fVariance[d];
+      }
+
+      return fWeight / (float)ezMath::Max(ezMath::Sqrt(fVarianceSum / (uiEnd - uiFirst)), 0.0001);
+    };
+
+    const float fVelocityScale = GetScale(0, 3, weights.m_fTrajectory);
+    const float fPoseScale = GetScale(3, 9, weights.m_fPose);
+    const float fTrajectoryScale = GetScale(9, NumDimensions, weights.m_fTrajectory);
+
+    for (ezUInt32 d = 0; d < NumDimensions; ++d)
+    {
+      m_fScale[d] = d < 3 ? fVelocityScale : (d < 9 ? fPoseScale : fTrajectoryScale);
+    }
+  }
+
+  ezDynamicArray<float> values;
+  values.SetCountUninitialized(uiNumEntries * NumDimensions);
+
+  ezDynamicArray<ezUInt32> points;
+  points.SetCountUninitialized(uiNumEntries);
+
+  for (ezUInt32 i = 0; i < uiNumEntries; ++i)
+  {
+    Normalize(m_Features[i], &values[i * NumDimensions]);
+    points[i] = i;
+  }
+
+  // small databases are always searched with brute force, so the points can stay in their original order
+  if (uiNumEntries >= BruteForceThreshold)
+  {
+    BuildNode(points.GetArrayPtr(), 0, values);
+  }
+
+  // store the points in tree order, four per group, so that every leaf can be compared with the query using SIMD instructions
+  const ezUInt32 uiNumGroups = (uiNumEntries + 3) / 4;
+  m_Groups.SetCountUninitialized(uiNumGroups);
+  m_GroupEntries.SetCountUninitialized(uiNumGroups * 4);
+
+  for (ezUInt32 g = 0; g < uiNumGroups; ++g)
+  {
+    float fGroupValues[NumDimensions][4];
+
+    for (ezUInt32 uiLane = 0; uiLane < 4; ++uiLane)
+    {
+      const ezUInt32 uiPoint = g * 4 + uiLane;
+
+      if (uiPoint < uiNumEntries)
+      {
+        m_GroupEntries[uiPoint] = points[uiPoint];
+
+        for (ezUInt32 d = 0; d < NumDimensions; ++d)
+        {
+          fGroupValues[d][uiLane] = values[points[uiPoint] * NumDimensions + d];
+        }
+      }
+      else
+      {
+        m_GroupEntries[uiPoint] = ezInvalidIndex;
+
+        for (ezUInt32 d = 0; d < NumDimensions; ++d)
+        {
+          fGroupValues[d][uiLane] = s_fPaddingValue;
+        }
+      }
+    }
+
+    for (ezUInt32 d = 0; d < NumDimensions; ++d)
+    {
+      m_Groups[g].m_Dimensions[d].Load<4>(fGroupValues[d]);
+    }
+  }
+}
+
+ezUInt32 ezMotionMatchingDatabase::FindEntry(ezUInt16 uiClip, ezUInt16 uiKeyframe) const
+{
+  if (uiClip >= m_Clips.GetCount() || uiKeyframe >= m_Clips[uiClip].m_uiNumEntries)
+    return ezInvalidIndex;
+
+  return m_Clips[uiClip].m_uiFirstEntry + uiKeyframe;
+}
+
+float ezMotionMatchingDatabase::ComputeDistance(ezUInt32 uiEntry, const ezMotionMatchingFeatures& query) const
+{
+  float fEntryValues[NumDimensions];
+  float fQueryValues[NumDimensions];
+
+  Normalize(m_Features[uiEntry], fEntryValues);
+  Normalize(query, fQueryValues);
+
+  float fDistance = 0.0f;
+  for (ezUInt32 d = 0; d < NumDimensions; ++d)
+  {
+    fDistance += ezMath::Square(fEntryValues[d] - fQueryValues[d]);
+  }
+
+  return fDistance;
+}
+
+ezUInt32 ezMotionMatchingDatabase::FindBestEntry(const ezMotionMatchingFeatures& query, const FilterFunction& filter, float* out_pDistance) const
+{
+  if (m_Nodes.IsEmpty())
+    return FindBestEntryBruteForce(query, filter, out_pDistance);
+
+  Query q;
+  PrepareQuery(query, q);
+
+  SearchResult result;
+  result.m_fDistance = ezMath::MaxValue<float>();
+  result.m_uiEntry = ezInvalidIndex;
+
+  SearchNode(0, q, filter, result);
+
+  if (out_pDistance)
+    *out_pDistance = result.m_fDistance;
+
+  return result.m_uiEntry;
+}
+
+ezUInt32 ezMotionMatchingDatabase::FindBestEntryBruteForce(
+  const ezMotionMatchingFeatures& query, const FilterFunction& filter, float* out_pDistance) const
+{
+  Query q;
+  PrepareQuery(query, q);
+
+  SearchResult result;
+  result.m_fDistance = ezMath::MaxValue<float>();
+  result.m_uiEntry = ezInvalidIndex;
+
+  SearchGroups(0, m_Groups.GetCount(), q, filter, result);
+
+  if (out_pDistance)
+    *out_pDistance = result.m_fDistance;
+
+  return result.m_uiEntry;
+}
+
+void ezMotionMatchingDatabase::Normalize(const ezMotionMatchingFeatures& features, float* out_pValues) const
+{
+  const float* pValues = GetFeatureValues(features);
+
+  for (ezUInt32 d = 0; d < NumDimensions; ++d)
+  {
+    out_pValues[d] = (pValues[d] - m_fMean[d]) * m_fScale[d];
+  }
+}
+
+void ezMotionMatchingDatabase::PrepareQuery(const ezMotionMatchingFeatures& features, Query& out_query) const
+{
+  Normalize(features, out_query.m_fValues);
+
+  for (ezUInt32 d = 0; d < NumDimensions; ++d)
+  {
+    out_query.m_Dimensions[d] = ezSimdVec4f(out_query.m_fValues[d]);
+  }
+}
+
+ezUInt32 ezMotionMatchingDatabase::BuildNode(ezArrayPtr<ezUInt32> points, ezUInt32 uiFirstPoint, const ezDynamicArray<float>& values)
+{
+  // uiFirstPoint is always a multiple of four, so every node covers whole groups
+  const ezUInt32 uiNodeIndex = m_Nodes.GetCount();
+
+  {
+    Node& node = m_Nodes.ExpandAndGetRef();
+    node.m_fSplitValue = 0.0f;
+    node.m_uiSplitDimension = ezInvalidIndex;
+    node.m_uiFirstGroup = uiFirstPoint / 4;
+    node.m_uiNumGroups = (points.GetCount() + 3) / 4;
+    node.m_uiRightChild = ezInvalidIndex;
+  }
+
+  if (points.GetCount() <= MaxLeafPoints)
+    return uiNodeIndex;
+
+  // split along the dimension with the largest extent
+  ezUInt32 uiSplitDimension = 0;
+  {
+    float fMin[NumDimensions];
+    float fMax[NumDimensions];
+
+    for (ezUInt32 d = 0; d < NumDimensions; ++d)
+    {
+      fMin[d] = ezMath::MaxValue<float>();
+      fMax[d] = -ezMath::MaxValue<float>();
+    }
+
+    for (ezUInt32 uiPoint : points)
+    {
+      for (ezUInt32 d = 0; d < NumDimensions; ++d)
+      {
+        const float fValue = values[uiPoint * NumDimensions + d];
+        fMin[d] = ezMath::Min(fMin[d], fValue);
+        fMax[d] = ezMath::Max(fMax[d], fValue);
+      }
+    }
+
+    float fLargestExtent = 0.0f;
+    for (ezUInt32 d = 0; d < NumDimensions; ++d)
+    {
+      if (fMax[d] - fMin[d] > fLargestExtent)
+      {
+        fLargestExtent = fMax[d] - fMin[d];
+        uiSplitDimension = d;
+      }
+    }
+
+    // all points are identical
+    if (fLargestExtent <= 0.0f)
+      return uiNodeIndex;
+  }
+
+  PointComparer comparer;
+  comparer.m_pValues = values.GetData();
+  comparer.m_uiStride = NumDimensions;
+  comparer.m_uiDimension = uiSplitDimension;
+  ezSorting::QuickSort(points, comparer);
+
+  // split at the median, rounded down to whole groups
+  const ezUInt32 uiSplit = (points.GetCount() / 2) & ~3u;
+
+  const float fSplitValue = 0.5f * (comparer.GetValue(points[uiSplit - 1]) + comparer.GetValue(points[uiSplit]));
+
+  BuildNode(points.GetSubArray(0, uiSplit), uiFirstPoint, values);
+  const ezUInt32 uiRightChild = BuildNode(points.GetSubArray(uiSplit), uiFirstPoint + uiSplit, values);
+
+  Node& node = m_Nodes[uiNodeIndex];
+  node.m_fSplitValue = fSplitValue;
+  node.m_uiSplitDimension = uiSplitDimension;
+  node.m_uiRightChild = uiRightChild;
+
+  return uiNodeIndex;
+}
+
+void ezMotionMatchingDatabase::SearchNode(ezUInt32 uiNode, const Query& query, const FilterFunction& filter, SearchResult& inout_result) const
+{
+  const Node& node = m_Nodes[uiNode];
+
+  if (node.m_uiSplitDimension == ezInvalidIndex)
+  {
+    SearchGroups(node.m_uiFirstGroup, node.m_uiNumGroups, query, filter, inout_result);
+    return;
+  }
+
+  const float fDiff = query.m_fValues[node.m_uiSplitDimension] - node.m_fSplitValue;
+
+  const ezUInt32 uiNearChild = fDiff < 0.0f ? uiNode + 1 : node.m_uiRightChild;
+  const ezUInt32 uiFarChild = fDiff < 0.0f ? node.m_uiRightChild : uiNode + 1;
+
+  SearchNode(uiNearChild, query, filter, inout_result);
+
+  // all points on the far side are at least as far away as the split plane
+  if (fDiff * fDiff < inout_result.m_fDistance)
+  {
+    SearchNode(uiFarChild, query, filter, inout_result);
+  }
+}
+
+void ezMotionMatchingDatabase::SearchGroups(
+  ezUInt32 uiFirstGroup, ezUInt32 uiNumGroups, const Query& query, const FilterFunction& filter, SearchResult& inout_result) const
+{
+  const bool bHasFilter = filter.IsValid();
+
+  for (ezUInt32 g = uiFirstGroup; g < uiFirstGroup + uiNumGroups; ++g)
+  {
+    const PointGroup& group = m_Groups[g];
+
+    ezSimdVec4f vDistance = ezSimdVec4f::ZeroVector();
+    for (ezUInt32 d = 0; d < NumDimensions; ++d)
+    {
+      const ezSimdVec4f vDiff = group.m_Dimensions[d] - query.m_Dimensions[d];
+      vDistance = ezSimdVec4f::MulAdd(vDiff, vDiff, vDistance);
+    }
+
+    if (!(vDistance < ezSimdVec4f(inout_result.m_fDistance)).AnySet<4>())
+      continue;
+
+    float fDistance[4];
+    vDistance.Store<4>(fDistance);
+
+    for (ezUInt32 uiLane = 0; uiLane < 4; ++uiLane)
+    {
+      if (fDistance[uiLane] >= inout_result.m_fDistance)
+        continue;
+
+      const ezUInt32 uiEntry = m_GroupEntries[g * 4 + uiLane];
+      if (uiEntry == ezInvalidIndex)
+        continue;
+
+      if (bHasFilter && !filter(m_Entries[uiEntry].m_uiClip, m_Entries[uiEntry].m_uiKeyframe))
+        continue;
+
+      inout_result.m_fDistance = fDistance[uiLane];
+      inout_result.m_uiEntry = uiEntry;
+    }
+  }
+}
+
+EZ_STATICLINK_FILE(RendererCore, RendererCore_AnimationSystem_Implementation_MotionMatchingDatabase);
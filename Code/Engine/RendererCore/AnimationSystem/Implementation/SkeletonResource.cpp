@@ -1,6 +1,7 @@
 #include <RendererCorePCH.h>
 
 #include <Core/Assets/AssetFileHeader.h>
+#include <RendererCore/AnimationSystem/AnimationClipResource.h>
 #include <RendererCore/AnimationSystem/SkeletonResource.h>
 
 // clang-format off
@@ -19,6 +20,7 @@ ezSkeletonResource::~ezSkeletonResource() = default;
 
 EZ_RESOURCE_IMPLEMENT_CREATEABLE(ezSkeletonResource, ezSkeletonResourceDescriptor)
 {
+  ClearMotionMatchingDatabases();
   m_Descriptor = descriptor;
 
   ezResourceLoadDesc res;
@@ -31,6 +33,8 @@ EZ_RESOURCE_IMPLEMENT_CREATEABLE(ezSkeletonResource, ezSkeletonResourceDescripto
 
 ezResourceLoadDesc ezSkeletonResource::UnloadData(Unload WhatToUnload)
 {
+  ClearMotionMatchingDatabases();
+
   ezResourceLoadDesc res;
   res.m_uiQualityLevelsDiscardable = 0;
   res.m_uiQualityLevelsLoadable = 0;
@@ -63,6 +67,7 @@ ezResourceLoadDesc ezSkeletonResource::UpdateContent(ezStreamReader* Stream)
   ezAssetFileHeader AssetHash;
   AssetHash.Read(*Stream);
 
+  ClearMotionMatchingDatabases();
   m_Descriptor.Load(*Stream);
 
   res.m_State = ezResourceState::Loaded;
@@ -75,6 +80,81 @@ void ezSkeletonResource::UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage)
   out_NewMemoryUsage.m_uiMemoryCPU = sizeof(ezSkeletonResource); // TODO
 }
 
+ezSharedPtr<const ezMotionMatchingDatabase> ezSkeletonResource::GetMotionMatchingDatabase(ezArrayPtr<const ezAnimationClipResourceHandle> clips,
+  const ezHashedString& sLeftFootJoint, const ezHashedString& sRightFootJoint) const
+{
+  // a clip's change counter increases whenever it is reloaded, so a cached database that was built from older clip data doesn't match
+  ezHybridArray<ezUInt32, 16> clipChangeCounters;
+  for (const ezAnimationClipResourceHandle& hClip : clips)
+  {
+    ezResourceLock<ezAnimationClipResource> pClip(hClip, ezResourceAcquireMode::BlockTillLoaded);
+    clipChangeCounters.PushBack(pClip->GetCurrentResourceChangeCounter());
+  }
+
+  EZ_LOCK(m_MotionMatchingMutex);
+
+  for (ezUInt32 i = 0; i < m_MotionMatchingDatabases.GetCount(); ++i)
+  {
+    const CachedMotionMatchingDatabase& cached = m_MotionMatchingDatabases[i];
+    if (cached.m_Clips != clips || cached.m_sLeftFootJoint != sLeftFootJoint || cached.m_sRightFootJoint != sRightFootJoint)
+      continue;
+
+    if (cached.m_ClipChangeCounters == clipChangeCounters.GetArrayPtr())
+      return cached.m_pDatabase;
+
+    // outdated, users of the old database keep their reference
+    m_MotionMatchingDatabases.RemoveAtAndSwap(i);
+    break;
+  }
+
+  CachedMotionMatchingDatabase& cached = m_MotionMatchingDatabases.ExpandAndGetRef();
+  cached.m_Clips = clips;
+  cached.m_sLeftFootJoint = sLeftFootJoint;
+  cached.m_sRightFootJoint = sRightFootJoint;
+  cached.m_pDatabase = BuildMotionMatchingDatabase(clips, sLeftFootJoint, sRightFootJoint, cached.m_ClipChangeCounters);
+
+  return cached.m_pDatabase;
+}
+
+ezSharedPtr<const ezMotionMatchingDatabase> ezSkeletonResource::BuildMotionMatchingDatabase(ezArrayPtr<const ezAnimationClipResourceHandle> clips,
+  const ezHashedString& sLeftFootJoint, const ezHashedString& sRightFootJoint, ezDynamicArray<ezUInt32>& out_ClipChangeCounters) const
+{
+  ezSharedPtr<ezMotionMatchingDatabase> pDatabase = EZ_DEFAULT_NEW(ezMotionMatchingDatabase);
+  out_ClipChangeCounters.Clear();
+
+  const ezSkeleton& skeleton = m_Descriptor.m_Skeleton;
+  ezMotionMatchingClipFeatures computedFeatures;
+
+  for (ezUInt16 uiClip = 0; uiClip < clips.GetCount(); ++uiClip)
+  {
+    ezResourceLock<ezAnimationClipResource> pClip(clips[uiClip], ezResourceAcquireMode::BlockTillLoaded);
+    out_ClipChangeCounters.PushBack(pClip->GetCurrentResourceChangeCounter());
+
+    const ezAnimationClipResourceDescriptor& animDesc = pClip->GetDescriptor();
+    const ezMotionMatchingClipFeatures& storedFeatures = animDesc.GetMotionMatchingFeatures();
+
+    // the features are usually computed when the asset is transformed, only older assets or ones using other feet need to do it here
+    if (storedFeatures.m_sLeftFootJoint == sLeftFootJoint && storedFeatures.m_sRightFootJoint == sRightFootJoint &&
+        storedFeatures.m_Frames.GetCount() == animDesc.GetNumFrames())
+    {
+      pDatabase->AddClip(uiClip, storedFeatures.m_Frames);
+    }
+    else if (computedFeatures.Compute(animDesc, *pClip->GetJointMapping(*this), skeleton, sLeftFootJoint, sRightFootJoint))
+    {
+      pDatabase->AddClip(uiClip, computedFeatures.m_Frames);
+    }
+  }
+
+  pDatabase->Build(ezMotionMatchingDatabase::Weights());
+  return pDatabase;
+}
+
+void ezSkeletonResource::ClearMotionMatchingDatabases()
+{
+  EZ_LOCK(m_MotionMatchingMutex);
+  m_MotionMatchingDatabases.Clear();
+}
+
 void ezSkeletonResourceDescriptor::Save(ezStreamWriter& stream) const
 {
   const ezUInt8 uiVersion = 1;
@@ -2,11 +2,17 @@
 
 #include <RendererCore/RendererCoreDLL.h>
 
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Types/RefCounted.h>
 #include <RendererCore/AnimationSystem/Declarations.h>
 
 class ezSkeleton;
 
-class ezJointMapping
+/// \brief Maps the joints of an animation clip to the joints of a skeleton.
+///
+/// Creating a mapping requires a name lookup for each joint of the clip, so it should be created once and then be reused, for example
+/// through ezAnimationClipResource::GetJointMapping().
+class EZ_RENDERERCORE_DLL ezJointMapping : public ezRefCounted
 {
 public:
   struct Mapping
@@ -19,6 +25,8 @@ public:
 
   ezArrayPtr<const Mapping> GetAllMappings() const;
 
+  void Clear();
+
   void CreateMapping(const ezSkeleton& skeleton, const ezAnimationClipResourceDescriptor& animClip);
   void CreatePartialMapping(const ezSkeleton& skeleton, const ezAnimationClipResourceDescriptor& animClip, const ezTempHashedString& rootJoint);
 
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <RendererCore/AnimationSystem/Declarations.h>
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Math/Vec2.h>
+#include <Foundation/Math/Vec3.h>
+#include <Foundation/SimdMath/SimdVec4f.h>
+#include <Foundation/Strings/HashedString.h>
+#include <Foundation/Types/Delegate.h>
+#include <Foundation/Types/RefCounted.h>
+
+class ezJointMapping;
+class ezStreamWriter;
+class ezStreamReader;
+
+/// \brief The features of one animation frame that motion matching compares.
+///
+/// The trajectory is described by the current root motion velocity and the positions that the root motion reaches in the future, the pose
+/// by the object space positions of both feet. All of them are in the space of the skeleton.
+struct ezMotionMatchingFeatures
+{
+  EZ_DECLARE_POD_TYPE();
+
+  enum
+  {
+    NumTrajectoryPoints = 3,
+  };
+
+  /// \brief The time in seconds between two future trajectory points, ie. the trajectory covers the next second.
+  static constexpr float TrajectoryPointInterval = 1.0f / NumTrajectoryPoints;
+
+  ezVec3 m_vRootVelocity;
+  ezVec3 m_vLeftFootPosition;
+  ezVec3 m_vRightFootPosition;
+
+  /// \brief The horizontal (XY) offsets of the root in 1, 2 and 3 times TrajectoryPointInterval seconds.
+  ezVec2 m_vTrajectory[NumTrajectoryPoints];
+};
+
+/// \brief The motion matching features of all frames of one animation clip.
+///
+/// These are computed when an animation clip asset is transformed and stored in ezAnimationClipResourceDescriptor, so that they don't
+/// need to be computed at runtime.
+struct EZ_RENDERERCORE_DLL ezMotionMatchingClipFeatures
+{
+  /// \brief Computes the features of all frames of the clip. Returns false and leaves the features empty, if one of the foot joints
+  /// doesn't exist in the skeleton.
+  bool Compute(const ezAnimationClipResourceDescriptor& clip, const ezJointMapping& mapping, const ezSkeleton& skeleton,
+    const ezHashedString& sLeftFootJoint, const ezHashedString& sRightFootJoint);
+
+  void Clear();
+  bool IsEmpty() const { return m_Frames.IsEmpty(); }
+
+  void Save(ezStreamWriter& stream) const;
+
+  /// \brief Reads the data written by Save(). Data that was written before the trajectory points were added has to be loaded with
+  /// bWithTrajectory set to false. Such features are incomplete, so they are skipped and the features stay empty.
+  void Load(ezStreamReader& stream, bool bWithTrajectory = true);
+
+  ezHashedString m_sLeftFootJoint;
+  ezHashedString m_sRightFootJoint;
+  ezDynamicArray<ezMotionMatchingFeatures> m_Frames;
+};
+
+/// \brief Stores the features of the frames of many animation clips and finds the frame that matches a query best.
+///
+/// Every feature is normalized by its standard deviation over all frames and multiplied by a weight. The distance between a frame and
+/// a query is then the squared euclidean distance of the two normalized feature vectors. Databases with many frames are searched with a
+/// kd-tree, small ones by comparing the query with every frame. In both cases four frames are compared at a time with SIMD instructions.
+///
+/// Once built, a database is only read, so one database can be shared by many users, see ezSkeletonResource::GetMotionMatchingDatabase().
+class EZ_RENDERERCORE_DLL ezMotionMatchingDatabase : public ezRefCounted
+{
+public:
+  struct Weights
+  {
+    float m_fTrajectory = 1.0f;
+    float m_fPose = 1.0f;
+  };
+
+  /// \brief Returns whether a frame of a clip may be returned by FindBestEntry().
+  typedef ezDelegate<bool(ezUInt16 uiClip, ezUInt16 uiKeyframe)> FilterFunction;
+
+  ezMotionMatchingDatabase();
+  ~ezMotionMatchingDatabase();
+
+  void Clear();
+
+  /// \brief Adds all frames of a clip to the database. Build() has to be called after all clips have been added.
+  void AddClip(ezUInt16 uiClip, ezArrayPtr<const ezMotionMatchingFeatures> frames);
+
+  /// \brief Normalizes the features of all frames and builds the search structure.
+  void Build(const Weights& weights);
+
+  ezUInt32 GetEntryCount() const { return m_Entries.GetCount(); }
+  ezUInt16 GetEntryClip(ezUInt32 uiEntry) const { return m_Entries[uiEntry].m_uiClip; }
+  ezUInt16 GetEntryKeyframe(ezUInt32 uiEntry) const { return m_Entries[uiEntry].m_uiKeyframe; }
+
+  /// \brief Returns the highest root motion speed of all entries.
+  float GetMaxRootSpeed() const { return m_fMaxRootSpeed; }
+
+  /// \brief Returns the entry for the given keyframe of a clip, or ezInvalidIndex, if the database doesn't contain it.
+  ezUInt32 FindEntry(ezUInt16 uiClip, ezUInt16 uiKeyframe) const;
+
+  /// \brief Returns the distance between the features of an entry and the query.
+  float ComputeDistance(ezUInt32 uiEntry, const ezMotionMatchingFeatures& query) const;
+
+  /// \brief Returns the entry that is closest to the query and passes the filter, or ezInvalidIndex if there is none.
+  ezUInt32 FindBestEntry(
+    const ezMotionMatchingFeatures& query, const FilterFunction& filter = FilterFunction(), float* out_pDistance = nullptr) const;
+
+  /// \brief Same as FindBestEntry(), but always compares the query with all entries.
+  ezUInt32 FindBestEntryBruteForce(
+    const ezMotionMatchingFeatures& query, const FilterFunction& filter = FilterFunction(), float* out_pDistance = nullptr) const;
+
+private:
+  enum
+  {
+    NumDimensions = 9 + 2 * ezMotionMatchingFeatures::NumTrajectoryPoints,
+    MaxLeafPoints = 16,
+    BruteForceThreshold = 256, ///< Databases with fewer entries are not searched with the kd-tree.
+  };
+
+  struct Entry
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt16 m_uiClip;
+    ezUInt16 m_uiKeyframe;
+  };
+
+  struct ClipRange
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiFirstEntry;
+    ezUInt32 m_uiNumEntries;
+  };
+
+  /// \brief The normalized features of four entries, one vector per dimension.
+  struct PointGroup
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezSimdVec4f m_Dimensions[NumDimensions];
+  };
+
+  struct Node
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    float m_fSplitValue;
+    ezUInt32 m_uiSplitDimension; ///< ezInvalidIndex for leaf nodes
+    ezUInt32 m_uiFirstGroup;
+    ezUInt32 m_uiNumGroups;
+    ezUInt32 m_uiRightChild; ///< The left child always directly follows its parent.
+  };
+
+  struct Query
+  {
+    float m_fValues[NumDimensions];
+    ezSimdVec4f m_Dimensions[NumDimensions];
+  };
+
+  struct SearchResult
+  {
+    float m_fDistance;
+    ezUInt32 m_uiEntry;
+  };
+
+  void Normalize(const ezMotionMatchingFeatures& features, float* out_pValues) const;
+  void PrepareQuery(const ezMotionMatchingFeatures& features, Query& out_query) const;
+
+  ezUInt32 BuildNode(ezArrayPtr<ezUInt32> points, ezUInt32 uiFirstPoint, const ezDynamicArray<float>& values);
+  void SearchNode(ezUInt32 uiNode, const Query& query, const FilterFunction& filter, SearchResult& inout_result) const;
+  void SearchGroups(ezUInt32 uiFirstGroup, ezUInt32 uiNumGroups, const Query& query, const FilterFunction& filter, SearchResult& inout_result) const;
+
+  ezDynamicArray<ezMotionMatchingFeatures> m_Features;
+  ezDynamicArray<Entry> m_Entries;
+  ezDynamicArray<ClipRange> m_Clips;
+  float m_fMaxRootSpeed = 0.0f;
+
+  float m_fMean[NumDimensions];
+  float m_fScale[NumDimensions];
+
+  ezDynamicArray<PointGroup, ezAlignedAllocatorWrapper> m_Groups;
+  ezDynamicArray<ezUInt32> m_GroupEntries; ///< Four per group, ezInvalidIndex for padding
+  ezDynamicArray<Node> m_Nodes;
+};
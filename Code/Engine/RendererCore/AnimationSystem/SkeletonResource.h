@@ -1,7 +1,10 @@
 #pragma once
 
 #include <Core/ResourceManager/Resource.h>
+#include <Foundation/Threading/Mutex.h>
+#include <Foundation/Types/SharedPtr.h>
 #include <RendererCore/AnimationSystem/Declarations.h>
+#include <RendererCore/AnimationSystem/MotionMatchingDatabase.h>
 #include <RendererCore/AnimationSystem/Skeleton.h>
 #include <RendererCore/RendererCoreDLL.h>
 
@@ -23,6 +26,7 @@ struct EZ_RENDERERCORE_DLL ezSkeletonResourceDescriptor
 };
 
 typedef ezTypedResourceHandle<class ezSkeletonResource> ezSkeletonResourceHandle;
+typedef ezTypedResourceHandle<class ezAnimationClipResource> ezAnimationClipResourceHandle;
 
 class EZ_RENDERERCORE_DLL ezSkeletonResource : public ezResource
 {
@@ -36,10 +40,35 @@ public:
 
   const ezSkeletonResourceDescriptor& GetDescriptor() const { return m_Descriptor; }
 
+  /// \brief Returns a built motion matching database with the features of all frames of the given clips. The index of a clip in the array
+  /// is its clip index in the database.
+  ///
+  /// The database is built on first use, which blocks until all clips are loaded. It is shared by everyone who asks for the same clips
+  /// and foot joints, until this skeleton or one of the clips is reloaded. A shared database is never modified, so it can be used from
+  /// multiple threads and stays valid after a reload.
+  ezSharedPtr<const ezMotionMatchingDatabase> GetMotionMatchingDatabase(ezArrayPtr<const ezAnimationClipResourceHandle> clips,
+    const ezHashedString& sLeftFootJoint, const ezHashedString& sRightFootJoint) const;
+
 private:
   virtual ezResourceLoadDesc UnloadData(Unload WhatToUnload) override;
   virtual ezResourceLoadDesc UpdateContent(ezStreamReader* Stream) override;
   virtual void UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage) override;
 
+  ezSharedPtr<const ezMotionMatchingDatabase> BuildMotionMatchingDatabase(ezArrayPtr<const ezAnimationClipResourceHandle> clips,
+    const ezHashedString& sLeftFootJoint, const ezHashedString& sRightFootJoint, ezDynamicArray<ezUInt32>& out_ClipChangeCounters) const;
+  void ClearMotionMatchingDatabases();
+
+  struct CachedMotionMatchingDatabase
+  {
+    ezDynamicArray<ezAnimationClipResourceHandle> m_Clips;
+    ezDynamicArray<ezUInt32> m_ClipChangeCounters; ///< The change counters of the clips when the database was built
+    ezHashedString m_sLeftFootJoint;
+    ezHashedString m_sRightFootJoint;
+    ezSharedPtr<const ezMotionMatchingDatabase> m_pDatabase;
+  };
+
   ezSkeletonResourceDescriptor m_Descriptor;
+
+  mutable ezMutex m_MotionMatchingMutex;
+  mutable ezDynamicArray<CachedMotionMatchingDatabase> m_MotionMatchingDatabases;
 };
@@ -8,7 +8,8 @@ EZ_BEGIN_ABSTRACT_COMPONENT_TYPE(ezRenderComponent, 1)
 {
   EZ_BEGIN_MESSAGEHANDLERS
   {
-    EZ_MESSAGE_HANDLER(ezMsgUpdateLocalBounds, OnUpdateLocalBounds)
+    EZ_MESSAGE_HANDLER(ezMsgUpdateLocalBounds, OnUpdateLocalBounds),
+    EZ_MESSAGE_HANDLER(ezMsgTransformChanged, OnTransformChanged),
   }
   EZ_END_MESSAGEHANDLERS;
 }
@@ -27,6 +28,9 @@ void ezRenderComponent::Deinitialize()
 
 void ezRenderComponent::OnActivated()
 {
+  // The render data of static objects is cached, so it needs to be updated when a static object is moved.
+  GetOwner()->EnableStaticTransformChangesNotifications();
+
   TriggerLocalBoundsUpdate();
 }
 
@@ -60,6 +64,11 @@ void ezRenderComponent::OnUpdateLocalBounds(ezMsgUpdateLocalBounds& msg)
   }
 }
 
+void ezRenderComponent::OnTransformChanged(ezMsgTransformChanged& msg)
+{
+  InvalidateCachedRenderData();
+}
+
 void ezRenderComponent::InvalidateCachedRenderData()
 {
   if (IsActiveAndInitialized())
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Core/Messages/TransformChangedMessage.h>
 #include <Core/Messages/UpdateLocalBoundsMessage.h>
 #include <Core/World/World.h>
 #include <RendererCore/RendererCoreDLL.h>
@@ -41,5 +42,6 @@ public:
 
 protected:
   void OnUpdateLocalBounds(ezMsgUpdateLocalBounds& msg);
+  void OnTransformChanged(ezMsgTransformChanged& msg);
   void InvalidateCachedRenderData();
 };
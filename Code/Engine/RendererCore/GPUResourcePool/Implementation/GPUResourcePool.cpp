@@ -289,7 +289,7 @@ void ezGPUResourcePool::UpdateMemoryStats() const
   float fMegaBytes = float(m_uiCurrentlyAllocatedMemory) / (1024.0f * 1024.0f);
 
   ezStringBuilder sOut;
-  sOut.Format("{0} (Mb)", ezArgF(fMegaBytes, 4));
+  sOut.Format(ezFmt(EZ_FMT_STRING("{0} (Mb)"), ezArgF(fMegaBytes, 4)));
   ezStats::SetStat("GPU Resource Pool/Memory Consumption", sOut.GetData());
 
 #endif
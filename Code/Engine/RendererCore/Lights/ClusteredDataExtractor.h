@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Foundation/SimdMath/SimdMat4f.h>
 #include <Foundation/Types/UniquePtr.h>
 #include <RendererCore/Pipeline/Extractor.h>
 
@@ -7,7 +8,7 @@ struct ezPerLightData;
 struct ezPerDecalData;
 struct ezPerClusterData;
 
-class ezClusteredDataCPU : public ezRenderData
+class EZ_RENDERERCORE_DLL ezClusteredDataCPU : public ezRenderData
 {
   EZ_ADD_DYNAMIC_REFLECTION(ezClusteredDataCPU, ezRenderData);
 
@@ -48,7 +49,18 @@ public:
     const ezView& view, const ezDynamicArray<const ezGameObject*>& visibleObjects, ezExtractedRenderData& extractedRenderData) override;
 
 private:
-  void FillItemListAndClusterData(ezClusteredDataCPU* pData);
+  struct ClusterItemCounts
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiLights;
+    ezUInt32 m_uiDecals;
+  };
+
+  void RasterizeSlice(ezUInt32 uiSliceIndex);
+  void CountClusterItems(ezUInt32 uiSliceIndex, ezArrayPtr<ClusterItemCounts> itemCounts);
+  void FillClusterItems(ezUInt32 uiSliceIndex, ezArrayPtr<const ClusterItemCounts> itemCounts, ezClusteredDataCPU* pData);
+  void FillItemListAndClusterData(ezArrayPtr<const ClusterItemCounts> itemCounts, ezClusteredDataCPU* pData);
 
   template <ezUInt32 MaxData>
   struct TempCluster
@@ -58,11 +70,47 @@ private:
     ezUInt32 m_BitMask[MaxData / 32];
   };
 
+  /// \brief The clusters that may be affected by a light or decal, inclusive.
+  struct ClusterRange
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt8 m_uiMinX;
+    ezUInt8 m_uiMaxX;
+    ezUInt8 m_uiMinY;
+    ezUInt8 m_uiMaxY;
+    ezUInt8 m_uiMinZ;
+    ezUInt8 m_uiMaxZ;
+  };
+
+  /// \brief Everything that is needed to rasterize a light into the clusters, gathered up front so that the depth slices can be
+  /// rasterized in parallel.
+  struct LightBinningData
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezSimdVec4f m_PositionAndRange; ///< Bounding sphere of point lights, cone apex and range of spot lights
+    ezSimdVec4f m_ForwardDir;       ///< Spot lights only
+    ezSimdVec4f m_SinCosAngle;      ///< Spot lights only
+    ezUInt32 m_uiType;
+  };
+
+  struct DecalBinningData
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezSimdMat4f m_WorldToDecal;
+    ezSimdVec4f m_RadiusScale; ///< The maximum scale of m_WorldToDecal, in all components
+  };
+
   ezDynamicArray<ezPerLightData, ezAlignedAllocatorWrapper> m_TempLightData;
   ezDynamicArray<ezPerDecalData, ezAlignedAllocatorWrapper> m_TempDecalData;
+  ezDynamicArray<LightBinningData, ezAlignedAllocatorWrapper> m_TempLightBinningData;
+  ezDynamicArray<DecalBinningData, ezAlignedAllocatorWrapper> m_TempDecalBinningData;
+  ezDynamicArray<ClusterRange> m_TempLightClusterRanges; ///< Kept separate from the binning data, as every slice checks all of them
+  ezDynamicArray<ClusterRange> m_TempDecalClusterRanges;
   ezDynamicArray<TempCluster<ezClusteredDataCPU::MAX_LIGHT_DATA>> m_TempLightsClusters;
   ezDynamicArray<TempCluster<ezClusteredDataCPU::MAX_DECAL_DATA>> m_TempDecalsClusters;
-  ezDynamicArray<ezUInt32> m_TempClusterItemList;
 
   ezDynamicArray<ezSimdBSphere, ezAlignedAllocatorWrapper> m_ClusterBoundingSpheres;
 };
@@ -3,6 +3,7 @@
 #include <Core/Graphics/Camera.h>
 #include <Foundation/Configuration/CVar.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/Components/FogComponent.h>
 #include <RendererCore/Debug/DebugRenderer.h>
 #include <RendererCore/Lights/AmbientLightComponent.h>
@@ -10,6 +11,41 @@
 #include <RendererCore/Lights/Implementation/ClusteredDataUtils.h>
 #include <RendererCore/Pipeline/ExtractedRenderData.h>
 #include <RendererCore/Pipeline/View.h>
+#include <RendererCore/RenderWorld/RenderWorld.h>
+
+ezCVarBool CVarParallelClusterBinning(
+  "r_ParallelClusterBinning", true, ezCVarFlags::Default, "Enables rasterizing lights and decals into the depth slices of the clusters in parallel");
+
+namespace
+{
+  template <typename Func>
+  void ForEachDepthSlice(const char* szTaskName, Func func)
+  {
+    if (CVarParallelClusterBinning && ezRenderWorld::GetUseMultithreadedRendering())
+    {
+      ezParallelForParams params;
+      params.uiBinSize = 1;
+      params.nestingMode = ezTaskNesting::Never;
+
+      ezTaskSystem::ParallelForIndexed(
+        0, NUM_CLUSTERS_Z,
+        [&](ezUInt32 uiStartSlice, ezUInt32 uiEndSlice) {
+          for (ezUInt32 uiSliceIndex = uiStartSlice; uiSliceIndex < uiEndSlice; ++uiSliceIndex)
+          {
+            func(uiSliceIndex);
+          }
+        },
+        szTaskName, params);
+    }
+    else
+    {
+      for (ezUInt32 uiSliceIndex = 0; uiSliceIndex < NUM_CLUSTERS_Z; ++uiSliceIndex)
+      {
+        func(uiSliceIndex);
+      }
+    }
+  }
+} // namespace
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
 ezCVarBool CVarVisClusteredData("r_VisClusteredData", false, ezCVarFlags::Default, "Enables debug visualization of clustered light data");
@@ -178,7 +214,8 @@ void ezClusteredDataExtractor::PostSortAndBatch(
   // Lights
   {
     m_TempLightData.Clear();
-    ezMemoryUtils::ZeroFill(m_TempLightsClusters.GetData(), NUM_CLUSTERS);
+    m_TempLightBinningData.Clear();
+    m_TempLightClusterRanges.Clear();
 
     auto batchList = extractedRenderData.GetRenderDataBatchesWithCategory(ezDefaultRenderDataCategories::Light);
     const ezUInt32 uiBatchCount = batchList.GetBatchCount();
@@ -202,8 +239,7 @@ void ezClusteredDataExtractor::PostSortAndBatch(
 
           ezSimdBSphere pointLightSphere =
             ezSimdBSphere(ezSimdConversion::ToVec3(pPointLightRenderData->m_GlobalTransform.m_vPosition), pPointLightRenderData->m_fRange);
-          RasterizePointLight(
-            pointLightSphere, uiLightIndex, viewMatrix, projectionMatrix, m_TempLightsClusters.GetData(), m_ClusterBoundingSpheres.GetData());
+          FillPointLightBinningData(m_TempLightBinningData.ExpandAndGetRef(), m_TempLightClusterRanges.ExpandAndGetRef(), pointLightSphere, viewMatrix, projectionMatrix);
 
           if (false)
           {
@@ -228,13 +264,13 @@ void ezClusteredDataExtractor::PostSortAndBatch(
           cone.m_PositionAndRange.SetW(pSpotLightRenderData->m_fRange);
           cone.m_ForwardDir = ezSimdConversion::ToVec3(pSpotLightRenderData->m_GlobalTransform.m_qRotation * ezVec3(1.0f, 0.0f, 0.0f));
           cone.m_SinCosAngle = ezSimdVec4f(ezMath::Sin(halfAngle), ezMath::Cos(halfAngle), 0.0f);
-          RasterizeSpotLight(cone, uiLightIndex, viewMatrix, projectionMatrix, m_TempLightsClusters.GetData(), m_ClusterBoundingSpheres.GetData());
+          FillSpotLightBinningData(m_TempLightBinningData.ExpandAndGetRef(), m_TempLightClusterRanges.ExpandAndGetRef(), cone, viewMatrix, projectionMatrix);
         }
         else if (auto pDirLightRenderData = ezDynamicCast<const ezDirectionalLightRenderData*>(it))
         {
           FillDirLightData(m_TempLightData.ExpandAndGetRef(), pDirLightRenderData);
 
-          RasterizeDirLight(pDirLightRenderData, uiLightIndex, m_TempLightsClusters.GetArrayPtr());
+          FillDirLightBinningData(m_TempLightBinningData.ExpandAndGetRef(), m_TempLightClusterRanges.ExpandAndGetRef());
         }
         else if (auto pFogRenderData = ezDynamicCast<const ezFogRenderData*>(it))
         {
@@ -270,7 +306,8 @@ void ezClusteredDataExtractor::PostSortAndBatch(
   // Decals
   {
     m_TempDecalData.Clear();
-    ezMemoryUtils::ZeroFill(m_TempDecalsClusters.GetData(), NUM_CLUSTERS);
+    m_TempDecalBinningData.Clear();
+    m_TempDecalClusterRanges.Clear();
 
     auto batchList = extractedRenderData.GetRenderDataBatchesWithCategory(ezDefaultRenderDataCategories::Decal);
     const ezUInt32 uiBatchCount = batchList.GetBatchCount();
@@ -292,7 +329,7 @@ void ezClusteredDataExtractor::PostSortAndBatch(
         {
           FillDecalData(m_TempDecalData.ExpandAndGetRef(), pDecalRenderData);
 
-          RasterizeDecal(pDecalRenderData, uiDecalIndex, viewProjectionMatrix, m_TempDecalsClusters.GetData(), m_ClusterBoundingSpheres.GetData());
+          FillDecalBinningData(m_TempDecalBinningData.ExpandAndGetRef(), m_TempDecalClusterRanges.ExpandAndGetRef(), pDecalRenderData, viewProjectionMatrix);
         }
         else
         {
@@ -305,7 +342,16 @@ void ezClusteredDataExtractor::PostSortAndBatch(
     pData->m_DecalData.CopyFrom(m_TempDecalData);
   }
 
-  FillItemListAndClusterData(pData);
+  // The packed counts in the cluster data only have 10 bits, so the item list is laid out with the full counts.
+  ezArrayPtr<ClusterItemCounts> itemCounts = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ClusterItemCounts, NUM_CLUSTERS);
+
+  // every depth slice only writes to its own clusters, so they can be rasterized independently of each other
+  ForEachDepthSlice("RasterizeClusterSlices", [&](ezUInt32 uiSliceIndex) {
+    RasterizeSlice(uiSliceIndex);
+    CountClusterItems(uiSliceIndex, itemCounts);
+  });
+
+  FillItemListAndClusterData(itemCounts, pData);
 
   extractedRenderData.AddFrameData(pData);
 
@@ -314,84 +360,162 @@ void ezClusteredDataExtractor::PostSortAndBatch(
 #endif
 }
 
+void ezClusteredDataExtractor::RasterizeSlice(ezUInt32 uiSliceIndex)
+{
+  ezSimdMat4f sliceSphereGroups[NUM_CLUSTERS_XY / 4];
+  GetClusterSphereGroups(m_ClusterBoundingSpheres.GetData(), uiSliceIndex, sliceSphereGroups);
+
+  const ezUInt32 uiFirstClusterIndex = uiSliceIndex * NUM_CLUSTERS_XY;
+
+  // Lights
+  {
+    ezMemoryUtils::ZeroFill(m_TempLightsClusters.GetData() + uiFirstClusterIndex, NUM_CLUSTERS_XY);
+
+    const ezUInt32 uiNumLights = m_TempLightBinningData.GetCount();
+    for (ezUInt32 uiLightIndex = 0; uiLightIndex < uiNumLights; ++uiLightIndex)
+    {
+      const ClusterRange& range = m_TempLightClusterRanges[uiLightIndex];
+      if (uiSliceIndex < range.m_uiMinZ || uiSliceIndex > range.m_uiMaxZ)
+        continue;
+
+      const LightBinningData& light = m_TempLightBinningData[uiLightIndex];
+
+      if (light.m_uiType == LIGHT_TYPE_POINT)
+      {
+        RasterizePointLight(light, range, uiLightIndex, uiSliceIndex, sliceSphereGroups, m_TempLightsClusters.GetData());
+      }
+      else if (light.m_uiType == LIGHT_TYPE_SPOT)
+      {
+        RasterizeSpotLight(light, range, uiLightIndex, uiSliceIndex, sliceSphereGroups, m_TempLightsClusters.GetData());
+      }
+      else
+      {
+        RasterizeDirLight(uiLightIndex, uiSliceIndex, m_TempLightsClusters.GetData());
+      }
+    }
+  }
+
+  // Decals
+  {
+    ezMemoryUtils::ZeroFill(m_TempDecalsClusters.GetData() + uiFirstClusterIndex, NUM_CLUSTERS_XY);
+
+    const ezUInt32 uiNumDecals = m_TempDecalBinningData.GetCount();
+    for (ezUInt32 uiDecalIndex = 0; uiDecalIndex < uiNumDecals; ++uiDecalIndex)
+    {
+      const ClusterRange& range = m_TempDecalClusterRanges[uiDecalIndex];
+      if (uiSliceIndex < range.m_uiMinZ || uiSliceIndex > range.m_uiMaxZ)
+        continue;
+
+      RasterizeDecal(m_TempDecalBinningData[uiDecalIndex], range, uiDecalIndex, uiSliceIndex, sliceSphereGroups, m_TempDecalsClusters.GetData());
+    }
+  }
+}
+
 namespace
 {
   ezUInt32 PackIndex(ezUInt32 uiLightIndex, ezUInt32 uiDecalIndex) { return uiDecalIndex << 10 | uiLightIndex; }
+
+  /// \brief A cluster can contain up to MAX_LIGHT_DATA lights and MAX_DECAL_DATA decals, which doesn't fit into the 10 bits of the packed
+  /// counts. Shaders then only see the first items of the cluster.
+  ezUInt32 PackCounts(ezUInt32 uiLightCount, ezUInt32 uiDecalCount)
+  {
+    return PackIndex(ezMath::Min<ezUInt32>(uiLightCount, LIGHT_BITMASK), ezMath::Min<ezUInt32>(uiDecalCount, DECAL_BITMASK));
+  }
+
+  template <typename Cluster>
+  EZ_ALWAYS_INLINE ezUInt32 CountItems(const Cluster& cluster, ezUInt32 uiMaxBlockIndex)
+  {
+    ezUInt32 uiCount = 0;
+    for (ezUInt32 uiBlockIndex = 0; uiBlockIndex < uiMaxBlockIndex; ++uiBlockIndex)
+    {
+      uiCount += ezMath::CountBits(cluster.m_BitMask[uiBlockIndex]);
+    }
+
+    return uiCount;
+  }
 } // namespace
 
-void ezClusteredDataExtractor::FillItemListAndClusterData(ezClusteredDataCPU* pData)
+void ezClusteredDataExtractor::CountClusterItems(ezUInt32 uiSliceIndex, ezArrayPtr<ClusterItemCounts> itemCounts)
 {
-  m_TempClusterItemList.Clear();
+  const ezUInt32 uiMaxLightBlockIndex = (m_TempLightData.GetCount() + 31) / 32;
+  const ezUInt32 uiMaxDecalBlockIndex = (m_TempDecalData.GetCount() + 31) / 32;
 
-  const ezUInt32 uiNumLights = m_TempLightData.GetCount();
-  const ezUInt32 uiMaxLightBlockIndex = (uiNumLights + 31) / 32;
+  const ezUInt32 uiFirstClusterIndex = uiSliceIndex * NUM_CLUSTERS_XY;
+  for (ezUInt32 i = uiFirstClusterIndex; i < uiFirstClusterIndex + NUM_CLUSTERS_XY; ++i)
+  {
+    itemCounts[i].m_uiLights = CountItems(m_TempLightsClusters[i], uiMaxLightBlockIndex);
+    itemCounts[i].m_uiDecals = CountItems(m_TempDecalsClusters[i], uiMaxDecalBlockIndex);
+  }
+}
 
-  const ezUInt32 uiNumDecals = m_TempDecalData.GetCount();
-  const ezUInt32 uiMaxDecalBlockIndex = (uiNumDecals + 31) / 32;
+void ezClusteredDataExtractor::FillClusterItems(ezUInt32 uiSliceIndex, ezArrayPtr<const ClusterItemCounts> itemCounts, ezClusteredDataCPU* pData)
+{
+  const ezUInt32 uiMaxLightBlockIndex = (m_TempLightData.GetCount() + 31) / 32;
+  const ezUInt32 uiMaxDecalBlockIndex = (m_TempDecalData.GetCount() + 31) / 32;
 
-  for (ezUInt32 i = 0; i < NUM_CLUSTERS; ++i)
+  const ezUInt32 uiFirstClusterIndex = uiSliceIndex * NUM_CLUSTERS_XY;
+  for (ezUInt32 i = uiFirstClusterIndex; i < uiFirstClusterIndex + NUM_CLUSTERS_XY; ++i)
   {
-    ezUInt32 uiOffset = m_TempClusterItemList.GetCount();
-    ezUInt32 uiLightCount = 0;
+    const ezPerClusterData& clusterData = pData->m_ClusterData[i];
+    ezUInt32* pItems = pData->m_ClusterItemList.GetPtr() + clusterData.offset;
+
+    const ezUInt32 uiLightCount = itemCounts[i].m_uiLights;
 
     // Lights
     {
-      auto& tempCluster = m_TempLightsClusters[i];
+      const auto& tempCluster = m_TempLightsClusters[i];
+      ezUInt32 uiItem = 0;
       for (ezUInt32 uiBlockIndex = 0; uiBlockIndex < uiMaxLightBlockIndex; ++uiBlockIndex)
       {
         ezUInt32 mask = tempCluster.m_BitMask[uiBlockIndex];
 
         while (mask > 0)
         {
-          ezUInt32 uiLightIndex = ezMath::FirstBitLow(mask);
-          mask &= ~(1 << uiLightIndex);
-
-          uiLightIndex += uiBlockIndex * 32;
-          m_TempClusterItemList.PushBack(uiLightIndex);
-          ++uiLightCount;
+          pItems[uiItem] = ezMath::FirstBitLow(mask) + uiBlockIndex * 32;
+          mask &= mask - 1;
+          ++uiItem;
         }
       }
     }
 
-    ezUInt32 uiDecalCount = 0;
-
-    // Decals
+    // Decals share the items with the lights, the remaining items only contain a decal
     {
-      auto& tempCluster = m_TempDecalsClusters[i];
+      const auto& tempCluster = m_TempDecalsClusters[i];
+      ezUInt32 uiItem = 0;
       for (ezUInt32 uiBlockIndex = 0; uiBlockIndex < uiMaxDecalBlockIndex; ++uiBlockIndex)
       {
         ezUInt32 mask = tempCluster.m_BitMask[uiBlockIndex];
 
         while (mask > 0)
         {
-          ezUInt32 uiDecalIndex = ezMath::FirstBitLow(mask);
-          mask &= ~(1 << uiDecalIndex);
-
-          uiDecalIndex += uiBlockIndex * 32;
-
-          if (uiDecalCount < uiLightCount)
-          {
-            auto& item = m_TempClusterItemList[uiOffset + uiDecalCount];
-            item = PackIndex(item, uiDecalIndex);
-          }
-          else
-          {
-            auto& item = m_TempClusterItemList.ExpandAndGetRef();
-            item = PackIndex(0, uiDecalIndex);
-          }
+          const ezUInt32 uiDecalIndex = ezMath::FirstBitLow(mask) + uiBlockIndex * 32;
+          mask &= mask - 1;
 
-          ++uiDecalCount;
+          pItems[uiItem] = PackIndex(uiItem < uiLightCount ? pItems[uiItem] : 0, uiDecalIndex);
+          ++uiItem;
         }
       }
     }
+  }
+}
+
+void ezClusteredDataExtractor::FillItemListAndClusterData(ezArrayPtr<const ClusterItemCounts> itemCounts, ezClusteredDataCPU* pData)
+{
+  // The items of each cluster are stored consecutively, so the offsets are the exclusive prefix sum of the item counts.
+  ezUInt32 uiNumItems = 0;
+  for (ezUInt32 i = 0; i < NUM_CLUSTERS; ++i)
+  {
+    const ClusterItemCounts& counts = itemCounts[i];
 
     auto& clusterData = pData->m_ClusterData[i];
-    clusterData.offset = uiOffset;
-    clusterData.counts = PackIndex(uiLightCount, uiDecalCount);
+    clusterData.offset = uiNumItems;
+    clusterData.counts = PackCounts(counts.m_uiLights, counts.m_uiDecals);
+    uiNumItems += ezMath::Max(counts.m_uiLights, counts.m_uiDecals);
   }
 
-  pData->m_ClusterItemList = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezUInt32, m_TempClusterItemList.GetCount());
-  pData->m_ClusterItemList.CopyFrom(m_TempClusterItemList);
+  pData->m_ClusterItemList = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezUInt32, uiNumItems);
+
+  ForEachDepthSlice("FillClusterItems", [&](ezUInt32 uiSliceIndex) { FillClusterItems(uiSliceIndex, itemCounts, pData); });
 }
 
 
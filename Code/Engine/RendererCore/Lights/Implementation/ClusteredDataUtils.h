@@ -241,9 +241,8 @@ namespace
     return ezSimdBBox(mi, ma);
   }
 
-  template <typename Cluster, typename IntersectionFunc>
-  EZ_FORCE_INLINE void FillCluster(
-    const ezSimdBBox& screenSpaceBounds, ezUInt32 uiBlockIndex, ezUInt32 uiMask, Cluster* clusters, IntersectionFunc func)
+  template <typename ClusterRange>
+  EZ_FORCE_INLINE void GetClusterRange(const ezSimdBBox& screenSpaceBounds, ClusterRange& out_range)
   {
     ezSimdVec4f scale = ezSimdVec4f(0.5f * NUM_CLUSTERS_X, -0.5f * NUM_CLUSTERS_Y, 1.0f, 1.0f);
     ezSimdVec4f bias = ezSimdVec4f(0.5f * NUM_CLUSTERS_X, 0.5f * NUM_CLUSTERS_Y, 0.0f, 0.0f);
@@ -257,44 +256,83 @@ namespace
     minXY_maxXY = minXY_maxXY.CompMin(maxClusterIndex - ezSimdVec4i(1));
     minXY_maxXY = minXY_maxXY.CompMax(ezSimdVec4i::ZeroVector());
 
-    ezUInt32 xMin = minXY_maxXY.x();
-    ezUInt32 yMin = minXY_maxXY.w();
+    out_range.m_uiMinX = static_cast<ezUInt8>(minXY_maxXY.x());
+    out_range.m_uiMinY = static_cast<ezUInt8>(minXY_maxXY.w());
 
-    ezUInt32 xMax = minXY_maxXY.z();
-    ezUInt32 yMax = minXY_maxXY.y();
+    out_range.m_uiMaxX = static_cast<ezUInt8>(minXY_maxXY.z());
+    out_range.m_uiMaxY = static_cast<ezUInt8>(minXY_maxXY.y());
 
-    ezUInt32 zMin = GetSliceIndexFromDepth(screenSpaceBounds.m_Min.z());
-    ezUInt32 zMax = GetSliceIndexFromDepth(screenSpaceBounds.m_Max.z());
+    out_range.m_uiMinZ = static_cast<ezUInt8>(GetSliceIndexFromDepth(screenSpaceBounds.m_Min.z()));
+    out_range.m_uiMaxZ = static_cast<ezUInt8>(GetSliceIndexFromDepth(screenSpaceBounds.m_Max.z()));
+  }
+
+  template <typename ClusterRange>
+  EZ_FORCE_INLINE void GetFullClusterRange(ClusterRange& out_range)
+  {
+    out_range.m_uiMinX = 0;
+    out_range.m_uiMaxX = NUM_CLUSTERS_X - 1;
+    out_range.m_uiMinY = 0;
+    out_range.m_uiMaxY = NUM_CLUSTERS_Y - 1;
+    out_range.m_uiMinZ = 0;
+    out_range.m_uiMaxZ = NUM_CLUSTERS_Z - 1;
+  }
+
+  static_assert(NUM_CLUSTERS_X % 4 == 0, "The clusters of a row are tested in groups of four");
+
+  // Transposes the bounding spheres of one depth slice into groups of four adjacent clusters of a row,
+  // with the x, y and z coordinates of the centers in m_col0, m_col1 and m_col2 and the radii in m_col3.
+  EZ_FORCE_INLINE void GetClusterSphereGroups(const ezSimdBSphere* clusterBoundingSpheres, ezUInt32 uiSliceIndex, ezSimdMat4f* out_pGroups)
+  {
+    const ezSimdBSphere* pSliceSpheres = clusterBoundingSpheres + uiSliceIndex * NUM_CLUSTERS_XY;
+
+    for (ezUInt32 i = 0; i < NUM_CLUSTERS_XY / 4; ++i)
+    {
+      ezSimdMat4f& group = out_pGroups[i];
+      group.m_col0 = pSliceSpheres[i * 4 + 0].m_CenterAndRadius;
+      group.m_col1 = pSliceSpheres[i * 4 + 1].m_CenterAndRadius;
+      group.m_col2 = pSliceSpheres[i * 4 + 2].m_CenterAndRadius;
+      group.m_col3 = pSliceSpheres[i * 4 + 3].m_CenterAndRadius;
+      group.Transpose();
+    }
+  }
+
+  // Calls func for every group of four clusters of the given depth slice that intersects the range and sets the item's bit
+  // in every cluster for which func returned true.
+  template <typename Cluster, typename ClusterRange, typename IntersectionFunc>
+  EZ_FORCE_INLINE void FillClusterSlice(const ClusterRange& range, ezUInt32 uiSliceIndex, ezUInt32 uiItemIndex, const ezSimdMat4f* sliceSphereGroups,
+    Cluster* clusters, IntersectionFunc func)
+  {
+    const ezUInt32 uiBlockIndex = uiItemIndex / 32;
+    const ezUInt32 uiMask = 1 << (uiItemIndex - uiBlockIndex * 32);
+
+    const ezUInt32 uiMinGroup = range.m_uiMinX / 4;
+    const ezUInt32 uiMaxGroup = range.m_uiMaxX / 4;
 
-    for (ezUInt32 z = zMin; z <= zMax; ++z)
+    for (ezUInt32 y = range.m_uiMinY; y <= range.m_uiMaxY; ++y)
     {
-      for (ezUInt32 y = yMin; y <= yMax; ++y)
+      for (ezUInt32 uiGroup = uiMinGroup; uiGroup <= uiMaxGroup; ++uiGroup)
       {
+        const ezSimdVec4b overlaps = func(sliceSphereGroups[y * (NUM_CLUSTERS_X / 4) + uiGroup]);
+        if (overlaps.NoneSet())
+          continue;
+
+        const bool laneOverlaps[4] = {overlaps.x(), overlaps.y(), overlaps.z(), overlaps.w()};
+
+        const ezUInt32 uiFirstX = uiGroup * 4;
+        const ezUInt32 xMin = ezMath::Max<ezUInt32>(uiFirstX, range.m_uiMinX);
+        const ezUInt32 xMax = ezMath::Min<ezUInt32>(uiFirstX + 3, range.m_uiMaxX);
+
         for (ezUInt32 x = xMin; x <= xMax; ++x)
         {
-          ezUInt32 uiClusterIndex = GetClusterIndexFromCoord(x, y, z);
-          if (func(uiClusterIndex))
+          if (laneOverlaps[x - uiFirstX])
           {
-            clusters[uiClusterIndex].m_BitMask[uiBlockIndex] |= uiMask;
+            clusters[GetClusterIndexFromCoord(x, y, uiSliceIndex)].m_BitMask[uiBlockIndex] |= uiMask;
           }
         }
       }
     }
   }
 
-  template <typename Cluster>
-  void RasterizePointLight(const ezSimdBSphere& pointLightSphere, ezUInt32 uiLightIndex, const ezSimdMat4f& viewMatrix,
-    const ezSimdMat4f& projectionMatrix, Cluster* clusters, ezSimdBSphere* clusterBoundingSpheres)
-  {
-    ezSimdBBox screenSpaceBounds = GetScreenSpaceBounds(pointLightSphere, viewMatrix, projectionMatrix);
-
-    const ezUInt32 uiBlockIndex = uiLightIndex / 32;
-    const ezUInt32 uiMask = 1 << (uiLightIndex - uiBlockIndex * 32);
-
-    FillCluster(screenSpaceBounds, uiBlockIndex, uiMask, clusters,
-      [&](ezUInt32 uiClusterIndex) { return pointLightSphere.Overlaps(clusterBoundingSpheres[uiClusterIndex]); });
-  }
-
   struct BoundingCone
   {
     ezSimdBSphere m_BoundingSphere;
@@ -303,9 +341,19 @@ namespace
     ezSimdVec4f m_SinCosAngle;
   };
 
-  template <typename Cluster>
-  void RasterizeSpotLight(const BoundingCone& spotLightCone, ezUInt32 uiLightIndex, const ezSimdMat4f& viewMatrix,
-    const ezSimdMat4f& projectionMatrix, Cluster* clusters, ezSimdBSphere* clusterBoundingSpheres)
+  template <typename BinningData, typename ClusterRange>
+  void FillPointLightBinningData(BinningData& out_binningData, ClusterRange& out_range, const ezSimdBSphere& pointLightSphere,
+    const ezSimdMat4f& viewMatrix, const ezSimdMat4f& projectionMatrix)
+  {
+    out_binningData.m_uiType = LIGHT_TYPE_POINT;
+    out_binningData.m_PositionAndRange = pointLightSphere.m_CenterAndRadius;
+
+    GetClusterRange(GetScreenSpaceBounds(pointLightSphere, viewMatrix, projectionMatrix), out_range);
+  }
+
+  template <typename BinningData, typename ClusterRange>
+  void FillSpotLightBinningData(BinningData& out_binningData, ClusterRange& out_range, const BoundingCone& spotLightCone, const ezSimdMat4f& viewMatrix,
+    const ezSimdMat4f& projectionMatrix)
   {
     ezSimdVec4f position = spotLightCone.m_PositionAndRange;
     ezSimdFloat range = spotLightCone.m_PositionAndRange.w();
@@ -328,43 +376,26 @@ namespace
     }
 
     ezSimdBSphere spotLightSphere(bSphereCenter, bSphereRadius);
-    ezSimdBBox screenSpaceBounds = GetScreenSpaceBounds(spotLightSphere, viewMatrix, projectionMatrix);
-
-    const ezUInt32 uiBlockIndex = uiLightIndex / 32;
-    const ezUInt32 uiMask = 1 << (uiLightIndex - uiBlockIndex * 32);
-
-    FillCluster(screenSpaceBounds, uiBlockIndex, uiMask, clusters, [&](ezUInt32 uiClusterIndex) {
-      ezSimdBSphere clusterSphere = clusterBoundingSpheres[uiClusterIndex];
-      ezSimdFloat clusterRadius = clusterSphere.GetRadius();
 
-      ezSimdVec4f toConePos = clusterSphere.m_CenterAndRadius - position;
-      ezSimdFloat projected = forwardDir.Dot<3>(toConePos);
-      ezSimdFloat distToConeSq = toConePos.Dot<3>(toConePos);
-      ezSimdFloat distClosestP = cosAngle * (distToConeSq - projected * projected).GetSqrt() - projected * sinAngle;
+    out_binningData.m_uiType = LIGHT_TYPE_SPOT;
+    out_binningData.m_PositionAndRange = spotLightCone.m_PositionAndRange;
+    out_binningData.m_ForwardDir = spotLightCone.m_ForwardDir;
+    out_binningData.m_SinCosAngle = spotLightCone.m_SinCosAngle;
 
-      bool angleCull = distClosestP > clusterRadius;
-      bool frontCull = projected > clusterRadius + range;
-      bool backCull = projected < -clusterRadius;
-
-      return !(angleCull || frontCull || backCull);
-    });
+    GetClusterRange(GetScreenSpaceBounds(spotLightSphere, viewMatrix, projectionMatrix), out_range);
   }
 
-  template <typename Cluster>
-  void RasterizeDirLight(const ezDirectionalLightRenderData* pDirLightRenderData, ezUInt32 uiLightIndex, ezArrayPtr<Cluster> clusters)
+  template <typename BinningData, typename ClusterRange>
+  void FillDirLightBinningData(BinningData& out_binningData, ClusterRange& out_range)
   {
-    const ezUInt32 uiBlockIndex = uiLightIndex / 32;
-    const ezUInt32 uiMask = 1 << (uiLightIndex - uiBlockIndex * 32);
+    out_binningData.m_uiType = LIGHT_TYPE_DIR;
 
-    for (ezUInt32 i = 0; i < clusters.GetCount(); ++i)
-    {
-      clusters[i].m_BitMask[uiBlockIndex] |= uiMask;
-    }
+    GetFullClusterRange(out_range);
   }
 
-  template <typename Cluster>
-  void RasterizeDecal(const ezDecalRenderData* pDecalRenderData, ezUInt32 uiDecalIndex, const ezSimdMat4f& viewProjectionMatrix, Cluster* clusters,
-    ezSimdBSphere* clusterBoundingSpheres)
+  template <typename BinningData, typename ClusterRange>
+  void FillDecalBinningData(
+    BinningData& out_binningData, ClusterRange& out_range, const ezDecalRenderData* pDecalRenderData, const ezSimdMat4f& viewProjectionMatrix)
   {
     ezSimdMat4f decalToWorld = ezSimdConversion::ToTransform(pDecalRenderData->m_GlobalTransform).GetAsMat4();
     ezSimdMat4f worldToDecal = decalToWorld.GetInverse();
@@ -396,17 +427,122 @@ namespace
       screenSpaceBounds.m_Max = ezSimdVec4f(1.0f).GetCombined<ezSwizzle::XYZW>(screenSpaceBounds.m_Max);
     }
 
-    ezSimdVec4f decalHalfExtents = ezSimdVec4f(1.0f);
-    ezSimdBBox localDecalBounds = ezSimdBBox(-decalHalfExtents, decalHalfExtents);
+    // same as ezSimdBSphere::Transform
+    ezSimdFloat maxScaleSquared = worldToDecal.m_col0.Dot<3>(worldToDecal.m_col0);
+    maxScaleSquared = maxScaleSquared.Max(worldToDecal.m_col1.Dot<3>(worldToDecal.m_col1));
+    maxScaleSquared = maxScaleSquared.Max(worldToDecal.m_col2.Dot<3>(worldToDecal.m_col2));
+
+    out_binningData.m_WorldToDecal = worldToDecal;
+    out_binningData.m_RadiusScale = ezSimdVec4f(maxScaleSquared.GetSqrt());
+
+    GetClusterRange(screenSpaceBounds, out_range);
+  }
+
+  template <typename Cluster, typename BinningData, typename ClusterRange>
+  void RasterizePointLight(const BinningData& pointLight, const ClusterRange& clusterRange, ezUInt32 uiLightIndex, ezUInt32 uiSliceIndex,
+    const ezSimdMat4f* sliceSphereGroups, Cluster* clusters)
+  {
+    const ezSimdVec4f centerX = pointLight.m_PositionAndRange.template Get<ezSwizzle::XXXX>();
+    const ezSimdVec4f centerY = pointLight.m_PositionAndRange.template Get<ezSwizzle::YYYY>();
+    const ezSimdVec4f centerZ = pointLight.m_PositionAndRange.template Get<ezSwizzle::ZZZZ>();
+    const ezSimdVec4f radius = pointLight.m_PositionAndRange.template Get<ezSwizzle::WWWW>();
+
+    // same as ezSimdBSphere::Overlaps for four clusters at once
+    FillClusterSlice(clusterRange, uiSliceIndex, uiLightIndex, sliceSphereGroups, clusters, [&](const ezSimdMat4f& clusterSpheres) {
+      const ezSimdVec4f dx = clusterSpheres.m_col0 - centerX;
+      const ezSimdVec4f dy = clusterSpheres.m_col1 - centerY;
+      const ezSimdVec4f dz = clusterSpheres.m_col2 - centerZ;
+      const ezSimdVec4f distSq = ezSimdVec4f::MulAdd(dz, dz, ezSimdVec4f::MulAdd(dy, dy, dx.CompMul(dx)));
+      const ezSimdVec4f combinedRadius = clusterSpheres.m_col3 + radius;
+
+      return distSq < combinedRadius.CompMul(combinedRadius);
+    });
+  }
+
+  template <typename Cluster, typename BinningData, typename ClusterRange>
+  void RasterizeSpotLight(const BinningData& spotLight, const ClusterRange& clusterRange, ezUInt32 uiLightIndex, ezUInt32 uiSliceIndex,
+    const ezSimdMat4f* sliceSphereGroups, Cluster* clusters)
+  {
+    const ezSimdVec4f positionX = spotLight.m_PositionAndRange.template Get<ezSwizzle::XXXX>();
+    const ezSimdVec4f positionY = spotLight.m_PositionAndRange.template Get<ezSwizzle::YYYY>();
+    const ezSimdVec4f positionZ = spotLight.m_PositionAndRange.template Get<ezSwizzle::ZZZZ>();
+    const ezSimdVec4f range = spotLight.m_PositionAndRange.template Get<ezSwizzle::WWWW>();
+    const ezSimdVec4f forwardX = spotLight.m_ForwardDir.template Get<ezSwizzle::XXXX>();
+    const ezSimdVec4f forwardY = spotLight.m_ForwardDir.template Get<ezSwizzle::YYYY>();
+    const ezSimdVec4f forwardZ = spotLight.m_ForwardDir.template Get<ezSwizzle::ZZZZ>();
+    const ezSimdVec4f sinAngle = spotLight.m_SinCosAngle.template Get<ezSwizzle::XXXX>();
+    const ezSimdVec4f cosAngle = spotLight.m_SinCosAngle.template Get<ezSwizzle::YYYY>();
+
+    FillClusterSlice(clusterRange, uiSliceIndex, uiLightIndex, sliceSphereGroups, clusters, [&](const ezSimdMat4f& clusterSpheres) {
+      const ezSimdVec4f clusterRadius = clusterSpheres.m_col3;
+
+      const ezSimdVec4f toConePosX = clusterSpheres.m_col0 - positionX;
+      const ezSimdVec4f toConePosY = clusterSpheres.m_col1 - positionY;
+      const ezSimdVec4f toConePosZ = clusterSpheres.m_col2 - positionZ;
+
+      const ezSimdVec4f projected = ezSimdVec4f::MulAdd(forwardZ, toConePosZ, ezSimdVec4f::MulAdd(forwardY, toConePosY, forwardX.CompMul(toConePosX)));
+      const ezSimdVec4f distToConeSq =
+        ezSimdVec4f::MulAdd(toConePosZ, toConePosZ, ezSimdVec4f::MulAdd(toConePosY, toConePosY, toConePosX.CompMul(toConePosX)));
+      const ezSimdVec4f distClosestP = cosAngle.CompMul((distToConeSq - projected.CompMul(projected)).GetSqrt()) - projected.CompMul(sinAngle);
+
+      const ezSimdVec4b angleCull = distClosestP > clusterRadius;
+      const ezSimdVec4b frontCull = projected > clusterRadius + range;
+      const ezSimdVec4b backCull = projected < -clusterRadius;
+
+      return !(angleCull || frontCull || backCull);
+    });
+  }
 
-    const ezUInt32 uiBlockIndex = uiDecalIndex / 32;
-    const ezUInt32 uiMask = 1 << (uiDecalIndex - uiBlockIndex * 32);
+  template <typename Cluster>
+  void RasterizeDirLight(ezUInt32 uiLightIndex, ezUInt32 uiSliceIndex, Cluster* clusters)
+  {
+    const ezUInt32 uiBlockIndex = uiLightIndex / 32;
+    const ezUInt32 uiMask = 1 << (uiLightIndex - uiBlockIndex * 32);
 
-    FillCluster(screenSpaceBounds, uiBlockIndex, uiMask, clusters, [&](ezUInt32 uiClusterIndex) {
-      ezSimdBSphere clusterSphere = clusterBoundingSpheres[uiClusterIndex];
-      clusterSphere.Transform(worldToDecal);
+    Cluster* pSliceClusters = clusters + uiSliceIndex * NUM_CLUSTERS_XY;
+    for (ezUInt32 i = 0; i < NUM_CLUSTERS_XY; ++i)
+    {
+      pSliceClusters[i].m_BitMask[uiBlockIndex] |= uiMask;
+    }
+  }
 
-      return localDecalBounds.Overlaps(clusterSphere);
+  template <typename Cluster, typename BinningData, typename ClusterRange>
+  void RasterizeDecal(const BinningData& decal, const ClusterRange& clusterRange, ezUInt32 uiDecalIndex, ezUInt32 uiSliceIndex,
+    const ezSimdMat4f* sliceSphereGroups, Cluster* clusters)
+  {
+    const ezSimdMat4f& m = decal.m_WorldToDecal;
+    const ezSimdVec4f m00 = m.m_col0.template Get<ezSwizzle::XXXX>();
+    const ezSimdVec4f m10 = m.m_col0.template Get<ezSwizzle::YYYY>();
+    const ezSimdVec4f m20 = m.m_col0.template Get<ezSwizzle::ZZZZ>();
+    const ezSimdVec4f m01 = m.m_col1.template Get<ezSwizzle::XXXX>();
+    const ezSimdVec4f m11 = m.m_col1.template Get<ezSwizzle::YYYY>();
+    const ezSimdVec4f m21 = m.m_col1.template Get<ezSwizzle::ZZZZ>();
+    const ezSimdVec4f m02 = m.m_col2.template Get<ezSwizzle::XXXX>();
+    const ezSimdVec4f m12 = m.m_col2.template Get<ezSwizzle::YYYY>();
+    const ezSimdVec4f m22 = m.m_col2.template Get<ezSwizzle::ZZZZ>();
+    const ezSimdVec4f m03 = m.m_col3.template Get<ezSwizzle::XXXX>();
+    const ezSimdVec4f m13 = m.m_col3.template Get<ezSwizzle::YYYY>();
+    const ezSimdVec4f m23 = m.m_col3.template Get<ezSwizzle::ZZZZ>();
+
+    const ezSimdVec4f decalHalfExtents = ezSimdVec4f(1.0f);
+
+    // same as transforming the cluster spheres into decal space and testing them against the decal box with ezSimdBBox::Overlaps
+    FillClusterSlice(clusterRange, uiSliceIndex, uiDecalIndex, sliceSphereGroups, clusters, [&](const ezSimdMat4f& clusterSpheres) {
+      const ezSimdVec4f& x = clusterSpheres.m_col0;
+      const ezSimdVec4f& y = clusterSpheres.m_col1;
+      const ezSimdVec4f& z = clusterSpheres.m_col2;
+
+      const ezSimdVec4f localX = ezSimdVec4f::MulAdd(m02, z, ezSimdVec4f::MulAdd(m01, y, ezSimdVec4f::MulAdd(m00, x, m03)));
+      const ezSimdVec4f localY = ezSimdVec4f::MulAdd(m12, z, ezSimdVec4f::MulAdd(m11, y, ezSimdVec4f::MulAdd(m10, x, m13)));
+      const ezSimdVec4f localZ = ezSimdVec4f::MulAdd(m22, z, ezSimdVec4f::MulAdd(m21, y, ezSimdVec4f::MulAdd(m20, x, m23)));
+      const ezSimdVec4f localRadius = clusterSpheres.m_col3.CompMul(decal.m_RadiusScale);
+
+      const ezSimdVec4f dx = localX - localX.CompMin(decalHalfExtents).CompMax(-decalHalfExtents);
+      const ezSimdVec4f dy = localY - localY.CompMin(decalHalfExtents).CompMax(-decalHalfExtents);
+      const ezSimdVec4f dz = localZ - localZ.CompMin(decalHalfExtents).CompMax(-decalHalfExtents);
+      const ezSimdVec4f distSq = ezSimdVec4f::MulAdd(dz, dz, ezSimdVec4f::MulAdd(dy, dy, dx.CompMul(dx)));
+
+      return distSq <= localRadius.CompMul(localRadius);
     });
   }
 } // namespace
@@ -168,6 +168,9 @@ void ezMeshComponentBase::OnMsgExtractRenderData(ezMsgExtractRenderData& msg) co
   ezResourceLock<ezMeshResource> pMesh(m_hMesh, ezResourceAcquireMode::AllowLoadingFallback);
   ezArrayPtr<const ezMeshResourceDescriptor::SubMesh> parts = pMesh->GetSubMeshes();
 
+  // the fallback mesh may have different sub meshes than the final one
+  const bool bMeshIsFallback = pMesh.GetAcquireResult() == ezResourceAcquireResult::LoadingFallback;
+
   for (ezUInt32 uiPartIndex = 0; uiPartIndex < parts.GetCount(); ++uiPartIndex)
   {
     const ezUInt32 uiMaterialIndex = parts[uiPartIndex].m_uiMaterialIndex;
@@ -192,7 +195,7 @@ void ezMeshComponentBase::OnMsgExtractRenderData(ezMsgExtractRenderData& msg) co
       pRenderData->FillBatchIdAndSortingKey();
     }
 
-    bool bDontCacheYet = false;
+    bool bDontCacheYet = bMeshIsFallback;
 
     // Determine render data category.
     ezRenderData::Category category = m_RenderDataCategory;
@@ -234,6 +237,7 @@ void ezMeshComponentBase::SetMesh(const ezMeshResourceHandle& hMesh)
   m_hMesh = hMesh;
 
   TriggerLocalBoundsUpdate();
+  InvalidateCachedRenderData();
 }
 
 void ezMeshComponentBase::SetMaterial(ezUInt32 uiIndex, const ezMaterialResourceHandle& hMaterial)
@@ -34,6 +34,12 @@ public:
   void AddRenderData(const ezRenderData* pRenderData, ezRenderData::Category category);
   void AddFrameData(const ezRenderData* pFrameData);
 
+  /// \brief Appends all render data of the given object behind the already added render data, in its original order.
+  ///
+  /// This is used to merge render data that was extracted in parallel into separate objects. The sorting keys are not recomputed,
+  /// so the other object must have been set up with the same camera. Frame data is not merged.
+  void MergeRenderData(const ezExtractedRenderData& other);
+
   void SortAndBatch();
 
   void Clear();
@@ -50,6 +56,8 @@ public:
 private:
   const ezRenderData* GetFrameData(const ezRTTI* pRtti) const;
 
+  void MergeBatches(ezDynamicArray<ezRenderDataBatch::SortableRenderData>& data);
+
   struct DataPerCategory
   {
     ezDynamicArray<ezRenderDataBatch> m_Batches;
@@ -65,4 +73,27 @@ private:
 
   ezHybridArray<DataPerCategory, 16> m_DataPerCategory;
   ezHybridArray<const ezRenderData*, 16> m_FrameData;
+
+  // temporary data of MergeBatches, kept to avoid allocations every frame
+  struct Run
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiStartIndex;
+    ezUInt32 m_uiGroupIndex;
+  };
+
+  struct Group
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    const ezRenderData* m_pFirstRenderData;
+    ezUInt32 m_uiOffset;
+    ezUInt32 m_uiPrevGroupWithSameKey; ///< ezInvalidIndex if this is the first group with its batch key
+  };
+
+  ezHashTable<ezUInt64, ezUInt32> m_BatchKeyToGroupIndex; ///< The last group with a batch key
+  ezDynamicArray<Group> m_Groups;
+  ezDynamicArray<Run> m_Runs;
+  ezDynamicArray<ezRenderDataBatch::SortableRenderData> m_MergedSortableRenderData;
 };
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <RendererCore/Pipeline/ExtractedRenderData.h>
 #include <RendererCore/Pipeline/RenderData.h>
 
 class EZ_RENDERERCORE_DLL ezExtractor : public ezReflectedClass
@@ -42,8 +44,9 @@ protected:
   ezHybridArray<ezHashedString, 4> m_DependsOn;
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-  mutable ezUInt32 m_uiNumCachedRenderData;
-  mutable ezUInt32 m_uiNumUncachedRenderData;
+  // atomic, since ezVisibleObjectsExtractor extracts from several threads at once
+  mutable ezAtomicInteger32 m_NumCachedRenderData;
+  mutable ezAtomicInteger32 m_NumUncachedRenderData;
 #endif
 };
 
@@ -55,8 +58,18 @@ class EZ_RENDERERCORE_DLL ezVisibleObjectsExtractor : public ezExtractor
 public:
   ezVisibleObjectsExtractor(const char* szName = "VisibleObjectsExtractor");
 
+  /// \brief Extracts the render data of all visible objects.
+  ///
+  /// With multi-threaded rendering enabled (and r_ParallelExtraction), the visible objects are split into chunks of a fixed size
+  /// which are extracted in parallel into separate ezExtractedRenderData. These are merged in chunk order afterwards,
+  /// so the render data is added in exactly the same order as with sequential extraction and sorting gives the same result.
   virtual void Extract(
     const ezView& view, const ezDynamicArray<const ezGameObject*>& visibleObjects, ezExtractedRenderData& extractedRenderData) override;
+
+private:
+  void ExtractObjects(const ezView& view, ezArrayPtr<const ezGameObject* const> objects, ezExtractedRenderData& extractedRenderData) const;
+
+  ezDynamicArray<ezExtractedRenderData> m_ChunkRenderData;
 };
 
 class EZ_RENDERERCORE_DLL ezSelectedObjectsExtractor : public ezExtractor
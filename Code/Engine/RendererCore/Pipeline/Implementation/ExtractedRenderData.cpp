@@ -1,8 +1,49 @@
 #include <RendererCorePCH.h>
 
+#include <Foundation/Configuration/CVar.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Utilities/Stats.h>
+#include <RendererCore/Meshes/MeshComponentBase.h>
 #include <RendererCore/Pipeline/ExtractedRenderData.h>
 
+ezCVarBool CVarAutoInstancing(
+  "r_AutoInstancing", true, ezCVarFlags::Default, "Merges render data with the same batch id into one batch, even if it is not adjacent after sorting");
+ezCVarInt CVarAutoInstancingMaxBatchSize(
+  "r_AutoInstancingMaxBatchSize", 1024, ezCVarFlags::Default, "Maximum number of render data in one batch of an auto instancing category");
+
+namespace
+{
+  ezStatsCounter s_NumBatches("Renderer/Batches", true);
+  ezStatsCounter s_NumBatchesSavedByAutoInstancing("Renderer/Batches Saved by Auto Instancing", true);
+
+  EZ_ALWAYS_INLINE bool IsMergeableType(const ezRTTI* pType)
+  {
+    return pType == ezGetStaticRTTI<ezMeshRenderData>();
+  }
+
+  /// \brief Batch ids are hashes. For mesh render data, which can be merged across a whole category, the data the batch id was computed
+  /// from is compared as well, so that different meshes or materials never end up in the same batch.
+  EZ_ALWAYS_INLINE bool IsSameBatch(const ezRenderData* a, const ezRenderData* b)
+  {
+    if (a->m_uiBatchId != b->m_uiBatchId || a->GetDynamicRTTI() != b->GetDynamicRTTI())
+      return false;
+
+    if (!IsMergeableType(a->GetDynamicRTTI()))
+      return true;
+
+    const ezMeshRenderData* pMeshA = static_cast<const ezMeshRenderData*>(a);
+    const ezMeshRenderData* pMeshB = static_cast<const ezMeshRenderData*>(b);
+    return pMeshA->m_hMesh == pMeshB->m_hMesh && pMeshA->m_hMaterial == pMeshB->m_hMaterial &&
+           pMeshA->m_uiSubMeshIndex == pMeshB->m_uiSubMeshIndex && pMeshA->m_uiFlipWinding == pMeshB->m_uiFlipWinding;
+  }
+
+  EZ_ALWAYS_INLINE ezUInt64 GetBatchKey(const ezRenderData* pRenderData)
+  {
+    // Collisions are resolved with IsSameBatch.
+    return (ezUInt64(pRenderData->m_uiBatchId) << 32) ^ ezUInt64(reinterpret_cast<size_t>(pRenderData->GetDynamicRTTI()));
+  }
+} // namespace
+
 ezExtractedRenderData::ezExtractedRenderData() {}
 
 void ezExtractedRenderData::AddRenderData(const ezRenderData* pRenderData, ezRenderData::Category category)
@@ -19,56 +60,184 @@ void ezExtractedRenderData::AddFrameData(const ezRenderData* pFrameData)
   m_FrameData.PushBack(pFrameData);
 }
 
+void ezExtractedRenderData::MergeRenderData(const ezExtractedRenderData& other)
+{
+  m_DataPerCategory.EnsureCount(other.m_DataPerCategory.GetCount());
+
+  for (ezUInt32 uiCategory = 0; uiCategory < other.m_DataPerCategory.GetCount(); ++uiCategory)
+  {
+    m_DataPerCategory[uiCategory].m_SortableRenderData.PushBackRange(other.m_DataPerCategory[uiCategory].m_SortableRenderData);
+  }
+}
+
 void ezExtractedRenderData::SortAndBatch()
 {
   EZ_PROFILE_SCOPE("SortAndBatch");
 
-  struct RenderDataComparer
+  struct BatchIdComparer
   {
     EZ_FORCE_INLINE bool Less(const ezRenderDataBatch::SortableRenderData& a, const ezRenderDataBatch::SortableRenderData& b) const
     {
-      if (a.m_uiSortingKey == b.m_uiSortingKey)
-      {
-        return a.m_pRenderData->m_uiBatchId < b.m_pRenderData->m_uiBatchId;
-      }
-
-      return a.m_uiSortingKey < b.m_uiSortingKey;
+      return a.m_pRenderData->m_uiBatchId < b.m_pRenderData->m_uiBatchId;
     }
   };
 
-  for (auto& dataPerCategory : m_DataPerCategory)
+  const ezUInt32 uiMaxAutoInstancingBatchSize = ezMath::Max(CVarAutoInstancingMaxBatchSize.GetValue(), 1);
+
+  for (ezUInt32 uiCategory = 0; uiCategory < m_DataPerCategory.GetCount(); ++uiCategory)
   {
+    auto& dataPerCategory = m_DataPerCategory[uiCategory];
     if (dataPerCategory.m_SortableRenderData.IsEmpty())
       continue;
 
     auto& data = dataPerCategory.m_SortableRenderData;
 
-    // Sort
-    data.Sort(RenderDataComparer());
+    // Sort by sorting key first, then sort runs with equal sorting keys by batch id
+    ezSorting::RadixSort(data.GetArrayPtr(), [](const ezRenderDataBatch::SortableRenderData& d) { return d.m_uiSortingKey; });
+
+    for (ezUInt32 uiRunStart = 0; uiRunStart < data.GetCount();)
+    {
+      ezUInt32 uiRunEnd = uiRunStart + 1;
+      while (uiRunEnd < data.GetCount() && data[uiRunEnd].m_uiSortingKey == data[uiRunStart].m_uiSortingKey)
+      {
+        ++uiRunEnd;
+      }
+
+      if (uiRunEnd - uiRunStart > 1)
+      {
+        ezArrayPtr<ezRenderDataBatch::SortableRenderData> run = data.GetArrayPtr().GetSubArray(uiRunStart, uiRunEnd - uiRunStart);
+        ezSorting::QuickSort(run, BatchIdComparer());
+      }
+
+      uiRunStart = uiRunEnd;
+    }
+
+    const bool bAutoInstancing = CVarAutoInstancing && ezRenderData::GetCategoryAutoInstancing(ezRenderData::Category(uiCategory));
+    const ezUInt32 uiMaxBatchSize = bAutoInstancing ? uiMaxAutoInstancingBatchSize : ezInvalidIndex;
+
+    if (bAutoInstancing)
+    {
+      MergeBatches(data);
+    }
 
     // Find batches
-    ezUInt32 uiCurrentBatchId = data[0].m_pRenderData->m_uiBatchId;
     ezUInt32 uiCurrentBatchStartIndex = 0;
-    const ezRTTI* pCurrentBatchType = data[0].m_pRenderData->GetDynamicRTTI();
+    const ezRenderData* pCurrentBatchRenderData = data[0].m_pRenderData;
 
     for (ezUInt32 i = 1; i < data.GetCount(); ++i)
     {
       auto pRenderData = data[i].m_pRenderData;
 
-      if (pRenderData->m_uiBatchId != uiCurrentBatchId || pRenderData->GetDynamicRTTI() != pCurrentBatchType)
+      if (!IsSameBatch(pRenderData, pCurrentBatchRenderData) || i - uiCurrentBatchStartIndex >= uiMaxBatchSize)
       {
         dataPerCategory.m_Batches.ExpandAndGetRef().m_Data = ezMakeArrayPtr(&data[uiCurrentBatchStartIndex], i - uiCurrentBatchStartIndex);
 
-        uiCurrentBatchId = pRenderData->m_uiBatchId;
         uiCurrentBatchStartIndex = i;
-        pCurrentBatchType = pRenderData->GetDynamicRTTI();
+        pCurrentBatchRenderData = pRenderData;
       }
     }
 
     dataPerCategory.m_Batches.ExpandAndGetRef().m_Data = ezMakeArrayPtr(&data[uiCurrentBatchStartIndex], data.GetCount() - uiCurrentBatchStartIndex);
+
+    s_NumBatches.Add(dataPerCategory.m_Batches.GetCount());
   }
 }
 
+void ezExtractedRenderData::MergeBatches(ezDynamicArray<ezRenderDataBatch::SortableRenderData>& data)
+{
+  // Sorting only makes render data with the same batch id adjacent if their sorting keys are equal up to the distance, which is rarely the
+  // case for meshes with several parts or for hash collisions in the sorting key. Thus all runs of the same mesh batch are moved to the
+  // position of their first run. This keeps the relative order of the batches and of the render data within a batch.
+  // Other render data types are only batched when they are adjacent, as the data behind their batch ids can't be compared.
+
+  m_BatchKeyToGroupIndex.Clear();
+  m_Groups.Clear();
+  m_Runs.Clear();
+
+  const ezUInt32 uiDataCount = data.GetCount();
+  for (ezUInt32 uiRunStart = 0; uiRunStart < uiDataCount;)
+  {
+    ezUInt32 uiRunEnd = uiRunStart + 1;
+    while (uiRunEnd < uiDataCount && IsSameBatch(data[uiRunStart].m_pRenderData, data[uiRunEnd].m_pRenderData))
+    {
+      ++uiRunEnd;
+    }
+
+    const ezRenderData* pRenderData = data[uiRunStart].m_pRenderData;
+
+    ezUInt32 uiGroupIndex = ezInvalidIndex;
+    ezUInt32 uiPrevGroupWithSameKey = ezInvalidIndex;
+
+    if (IsMergeableType(pRenderData->GetDynamicRTTI()))
+    {
+      // groups with the same key are chained, the key only collides for different batches in very rare cases
+      const ezUInt64 uiBatchKey = GetBatchKey(pRenderData);
+      if (m_BatchKeyToGroupIndex.TryGetValue(uiBatchKey, uiPrevGroupWithSameKey))
+      {
+        ezUInt32 uiCandidate = uiPrevGroupWithSameKey;
+        for (; uiCandidate != ezInvalidIndex; uiCandidate = m_Groups[uiCandidate].m_uiPrevGroupWithSameKey)
+        {
+          if (IsSameBatch(pRenderData, m_Groups[uiCandidate].m_pFirstRenderData))
+          {
+            uiGroupIndex = uiCandidate;
+            break;
+          }
+        }
+      }
+
+      if (uiGroupIndex == ezInvalidIndex)
+      {
+        m_BatchKeyToGroupIndex[uiBatchKey] = m_Groups.GetCount();
+      }
+    }
+
+    if (uiGroupIndex == ezInvalidIndex)
+    {
+      uiGroupIndex = m_Groups.GetCount();
+
+      Group& group = m_Groups.ExpandAndGetRef();
+      group.m_pFirstRenderData = pRenderData;
+      group.m_uiOffset = 0;
+      group.m_uiPrevGroupWithSameKey = uiPrevGroupWithSameKey;
+    }
+
+    // count the elements per group first, these are turned into offsets below
+    m_Groups[uiGroupIndex].m_uiOffset += uiRunEnd - uiRunStart;
+    m_Runs.PushBack({uiRunStart, uiGroupIndex});
+
+    uiRunStart = uiRunEnd;
+  }
+
+  const ezUInt32 uiNumGroups = m_Groups.GetCount();
+  if (uiNumGroups == m_Runs.GetCount())
+    return;
+
+  s_NumBatchesSavedByAutoInstancing.Add(m_Runs.GetCount() - uiNumGroups);
+
+  ezUInt32 uiOffset = 0;
+  for (Group& group : m_Groups)
+  {
+    const ezUInt32 uiGroupCount = group.m_uiOffset;
+    group.m_uiOffset = uiOffset;
+    uiOffset += uiGroupCount;
+  }
+
+  m_MergedSortableRenderData.SetCountUninitialized(uiDataCount);
+
+  for (ezUInt32 uiRunIndex = 0; uiRunIndex < m_Runs.GetCount(); ++uiRunIndex)
+  {
+    const Run& run = m_Runs[uiRunIndex];
+    const ezUInt32 uiRunEnd = (uiRunIndex + 1 < m_Runs.GetCount()) ? m_Runs[uiRunIndex + 1].m_uiStartIndex : uiDataCount;
+    const ezUInt32 uiRunCount = uiRunEnd - run.m_uiStartIndex;
+
+    ezUInt32& uiGroupOffset = m_Groups[run.m_uiGroupIndex].m_uiOffset;
+    ezMemoryUtils::Copy(&m_MergedSortableRenderData[uiGroupOffset], &data[run.m_uiStartIndex], uiRunCount);
+    uiGroupOffset += uiRunCount;
+  }
+
+  data.Swap(m_MergedSortableRenderData);
+}
+
 void ezExtractedRenderData::Clear()
 {
   for (auto& dataPerCategory : m_DataPerCategory)
@@ -3,12 +3,16 @@
 #include <Core/World/SpatialSystem_RegularGrid.h>
 #include <Core/World/World.h>
 #include <Foundation/Configuration/CVar.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/Debug/DebugRenderer.h>
 #include <RendererCore/Pipeline/ExtractedRenderData.h>
 #include <RendererCore/Pipeline/Extractor.h>
 #include <RendererCore/Pipeline/View.h>
 #include <RendererCore/RenderWorld/RenderWorld.h>
 
+ezCVarBool CVarParallelExtraction(
+  "r_ParallelExtraction", true, ezCVarFlags::Default, "Enables extracting the visible objects of a view in parallel chunks");
+
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
 ezCVarBool CVarVisBounds("r_VisBounds", false, ezCVarFlags::Default, "Enables debug visualization of object bounds");
 ezCVarBool CVarVisLocalBBox("r_VisLocalBBox", false, ezCVarFlags::Default, "Enables debug visualization of object local bounding box");
@@ -25,6 +29,9 @@ ezCVarBool CVarExtractionStats("r_ExtractionStats", false, ezCVarFlags::Default,
 
 namespace
 {
+  // The chunk size must not depend on the number of worker threads, otherwise the merged order would differ between machines.
+  constexpr ezUInt32 s_uiExtractionChunkSize = 256;
+
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
   void VisualizeSpatialData(const ezView& view)
   {
@@ -104,11 +111,6 @@ ezExtractor::ezExtractor(const char* szName)
 {
   m_bActive = true;
   m_sName.Assign(szName);
-
-#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-  m_uiNumCachedRenderData = 0;
-  m_uiNumUncachedRenderData = 0;
-#endif
 }
 
 ezExtractor::~ezExtractor() {}
@@ -231,8 +233,8 @@ void ezExtractor::ExtractRenderData(
   }
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-  m_uiNumCachedRenderData += msg.m_ExtractedRenderData.GetCount() - uiNumUncachedRenderData;
-  m_uiNumUncachedRenderData += uiNumUncachedRenderData;
+  m_NumCachedRenderData.Add(msg.m_ExtractedRenderData.GetCount() - uiNumUncachedRenderData);
+  m_NumUncachedRenderData.Add(uiNumUncachedRenderData);
 #endif
 }
 
@@ -258,33 +260,55 @@ ezVisibleObjectsExtractor::ezVisibleObjectsExtractor(const char* szName)
 void ezVisibleObjectsExtractor::Extract(
   const ezView& view, const ezDynamicArray<const ezGameObject*>& visibleObjects, ezExtractedRenderData& extractedRenderData)
 {
-  ezMsgExtractRenderData msg;
-  msg.m_pView = &view;
-
   EZ_LOCK(view.GetWorld()->GetReadMarker());
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
   VisualizeSpatialData(view);
 
-  m_uiNumCachedRenderData = 0;
-  m_uiNumUncachedRenderData = 0;
+  m_NumCachedRenderData = 0;
+  m_NumUncachedRenderData = 0;
 #endif
 
-  for (auto pObject : visibleObjects)
+  const ezUInt32 uiNumObjects = visibleObjects.GetCount();
+  const ezUInt32 uiNumChunks = (uiNumObjects + s_uiExtractionChunkSize - 1) / s_uiExtractionChunkSize;
+
+  if (uiNumChunks > 1 && CVarParallelExtraction && ezRenderWorld::GetUseMultithreadedRendering())
   {
-    ExtractRenderData(view, pObject, msg, extractedRenderData);
+    m_ChunkRenderData.EnsureCount(uiNumChunks);
 
-#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-    if (CVarVisBounds || CVarVisLocalBBox || CVarVisSpatialData)
+    for (ezUInt32 uiChunk = 0; uiChunk < uiNumChunks; ++uiChunk)
     {
-      if ((CVarVisObjectName.GetValue().IsEmpty() ||
-            ezStringUtils::FindSubString_NoCase(pObject->GetName(), CVarVisObjectName.GetValue()) != nullptr) &&
-          !CVarVisObjectSelection)
-      {
-        VisualizeObject(view, pObject);
-      }
+      m_ChunkRenderData[uiChunk].Clear();
+      m_ChunkRenderData[uiChunk].SetCamera(extractedRenderData.GetCamera());
     }
-#endif
+
+    ezParallelForParams params;
+    params.uiBinSize = 1;
+    params.uiMaxTasksPerThread = 2;
+    params.nestingMode = ezTaskNesting::Maybe; // components may wait for resources during extraction
+
+    ezTaskSystem::ParallelForIndexed(
+      0, uiNumChunks,
+      [&](ezUInt32 uiStartChunk, ezUInt32 uiEndChunk) {
+        for (ezUInt32 uiChunk = uiStartChunk; uiChunk < uiEndChunk; ++uiChunk)
+        {
+          const ezUInt32 uiStartIndex = uiChunk * s_uiExtractionChunkSize;
+          const ezUInt32 uiCount = ezMath::Min(s_uiExtractionChunkSize, uiNumObjects - uiStartIndex);
+
+          ExtractObjects(view, visibleObjects.GetArrayPtr().GetSubArray(uiStartIndex, uiCount), m_ChunkRenderData[uiChunk]);
+        }
+      },
+      "ExtractVisibleObjects", params);
+
+    // merging in chunk order keeps the order of sequential extraction
+    for (ezUInt32 uiChunk = 0; uiChunk < uiNumChunks; ++uiChunk)
+    {
+      extractedRenderData.MergeRenderData(m_ChunkRenderData[uiChunk]);
+    }
+  }
+  else
+  {
+    ExtractObjects(view, visibleObjects, extractedRenderData);
   }
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
@@ -298,15 +322,39 @@ void ezVisibleObjectsExtractor::Extract(
 
     ezDebugRenderer::Draw2DText(hView, "Extraction Stats", ezVec2I32(10, 200), ezColor::LimeGreen);
 
-    sb.Format("Num Cached Render Data: {0}", m_uiNumCachedRenderData);
+    sb.Format("Num Cached Render Data: {0}", (ezInt32)m_NumCachedRenderData);
     ezDebugRenderer::Draw2DText(hView, sb, ezVec2I32(10, 220), ezColor::LimeGreen);
 
-    sb.Format("Num Uncached Render Data: {0}", m_uiNumUncachedRenderData);
+    sb.Format("Num Uncached Render Data: {0}", (ezInt32)m_NumUncachedRenderData);
     ezDebugRenderer::Draw2DText(hView, sb, ezVec2I32(10, 240), ezColor::LimeGreen);
   }
 #endif
 }
 
+void ezVisibleObjectsExtractor::ExtractObjects(
+  const ezView& view, ezArrayPtr<const ezGameObject* const> objects, ezExtractedRenderData& extractedRenderData) const
+{
+  ezMsgExtractRenderData msg;
+  msg.m_pView = &view;
+
+  for (auto pObject : objects)
+  {
+    ExtractRenderData(view, pObject, msg, extractedRenderData);
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+    if (CVarVisBounds || CVarVisLocalBBox || CVarVisSpatialData)
+    {
+      if ((CVarVisObjectName.GetValue().IsEmpty() ||
+            ezStringUtils::FindSubString_NoCase(pObject->GetName(), CVarVisObjectName.GetValue()) != nullptr) &&
+          !CVarVisObjectSelection)
+      {
+        VisualizeObject(view, pObject);
+      }
+    }
+#endif
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezSelectedObjectsExtractor, 1, ezRTTINoAllocator)
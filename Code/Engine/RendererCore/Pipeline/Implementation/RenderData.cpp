@@ -47,7 +47,7 @@ ezDynamicArray<ezUniquePtr<ezRenderer>> ezRenderData::s_RendererInstances;
 bool ezRenderData::s_bRendererInstancesDirty = false;
 
 // static
-ezRenderData::Category ezRenderData::RegisterCategory(const char* szCategoryName, SortingKeyFunc sortingKeyFunc)
+ezRenderData::Category ezRenderData::RegisterCategory(const char* szCategoryName, SortingKeyFunc sortingKeyFunc, bool bAutoInstancing)
 {
   Category oldCategory = FindCategory(szCategoryName);
   if (oldCategory != ezInvalidRenderDataCategory)
@@ -58,6 +58,7 @@ ezRenderData::Category ezRenderData::RegisterCategory(const char* szCategoryName
   auto& data = s_CategoryData.ExpandAndGetRef();
   data.m_sName.Assign(szCategoryName);
   data.m_sortingKeyFunc = sortingKeyFunc;
+  data.m_bAutoInstancing = bAutoInstancing;
 
   return newCategory;
 }
@@ -161,21 +162,21 @@ ezRenderData::Category ezDefaultRenderDataCategories::Decal =
 ezRenderData::Category ezDefaultRenderDataCategories::Sky =
   ezRenderData::RegisterCategory("Sky", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack);
 ezRenderData::Category ezDefaultRenderDataCategories::LitOpaque =
-  ezRenderData::RegisterCategory("LitOpaque", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack);
+  ezRenderData::RegisterCategory("LitOpaque", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack, true);
 ezRenderData::Category ezDefaultRenderDataCategories::LitMasked =
-  ezRenderData::RegisterCategory("LitMasked", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack);
+  ezRenderData::RegisterCategory("LitMasked", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack, true);
 ezRenderData::Category ezDefaultRenderDataCategories::LitTransparent =
   ezRenderData::RegisterCategory("LitTransparent", &ezRenderSortingFunctions::BackToFrontThenByRenderData);
 ezRenderData::Category ezDefaultRenderDataCategories::LitForeground =
-  ezRenderData::RegisterCategory("LitForeground", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack);
+  ezRenderData::RegisterCategory("LitForeground", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack, true);
 ezRenderData::Category ezDefaultRenderDataCategories::SimpleOpaque =
-  ezRenderData::RegisterCategory("SimpleOpaque", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack);
+  ezRenderData::RegisterCategory("SimpleOpaque", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack, true);
 ezRenderData::Category ezDefaultRenderDataCategories::SimpleTransparent =
   ezRenderData::RegisterCategory("SimpleTransparent", &ezRenderSortingFunctions::BackToFrontThenByRenderData);
 ezRenderData::Category ezDefaultRenderDataCategories::SimpleForeground =
-  ezRenderData::RegisterCategory("SimpleForeground", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack);
+  ezRenderData::RegisterCategory("SimpleForeground", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack, true);
 ezRenderData::Category ezDefaultRenderDataCategories::Selection =
-  ezRenderData::RegisterCategory("Selection", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack);
+  ezRenderData::RegisterCategory("Selection", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack, true);
 ezRenderData::Category ezDefaultRenderDataCategories::GUI =
   ezRenderData::RegisterCategory("GUI", &ezRenderSortingFunctions::BackToFrontThenByRenderData);
 
@@ -47,6 +47,11 @@ EZ_FORCE_INLINE const char* ezRenderData::GetCategoryName(Category category)
   return s_CategoryData[category.m_uiValue].m_sName.GetString();
 }
 
+EZ_FORCE_INLINE bool ezRenderData::GetCategoryAutoInstancing(Category category)
+{
+  return s_CategoryData[category.m_uiValue].m_bAutoInstancing;
+}
+
 EZ_FORCE_INLINE ezUInt64 ezRenderData::GetCategorySortingKey(Category category, const ezCamera& camera) const
 {
   return s_CategoryData[category.m_uiValue].m_sortingKeyFunc(this, m_uiSortingKey, camera);
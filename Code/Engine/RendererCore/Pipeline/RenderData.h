@@ -36,13 +36,20 @@ public:
   /// \brief This function generates a 64bit sorting key for the given render data. Data with lower sorting key is rendered first.
   typedef ezDelegate<ezUInt64(const ezRenderData*, ezUInt32, const ezCamera&)> SortingKeyFunc;
 
-  static Category RegisterCategory(const char* szCategoryName, SortingKeyFunc sortingKeyFunc);
+  /// \brief Registers a new render data category.
+  ///
+  /// If bAutoInstancing is set, ezExtractedRenderData::SortAndBatch merges all render data of this category with the same batch id into one
+  /// batch, even if other render data was sorted in between. This must only be enabled for categories where the order between different
+  /// batches is not important, e.g. opaque geometry.
+  static Category RegisterCategory(const char* szCategoryName, SortingKeyFunc sortingKeyFunc, bool bAutoInstancing = false);
   static Category FindCategory(const char* szCategoryName);
 
   static const ezRenderer* GetCategoryRenderer(Category category, const ezRTTI* pRenderDataType);
 
   static const char* GetCategoryName(Category category);
 
+  static bool GetCategoryAutoInstancing(Category category);
+
   ezUInt64 GetCategorySortingKey(Category category, const ezCamera& camera) const;
 
   ezUInt32 m_uiBatchId = 0; ///< BatchId is used to group render data in batches.
@@ -70,6 +77,7 @@ private:
   {
     ezHashedString m_sName;
     SortingKeyFunc m_sortingKeyFunc;
+    bool m_bAutoInstancing = false;
 
     ezHashTable<const ezRTTI*, ezUInt32> m_TypeToRendererIndex;
   };
@@ -111,8 +119,9 @@ struct EZ_RENDERERCORE_DLL ezMsgExtractRenderData : public ezMessage
   ezRenderData::Category m_OverrideCategory = ezInvalidRenderDataCategory;
 
   /// \brief Adds render data for the current view. This data can be cached depending on the specified caching behavior.
-  /// Non-cached data is only valid for this frame. Cached data must be manually deleted using the ezRenderWorld::DeleteCachedRenderData
-  /// function.
+  /// Non-cached data is only valid for this frame. Cached data of ezRenderComponents is deleted automatically when their static owner
+  /// is moved, any other change must be handled by manually deleting it with ezRenderWorld::DeleteCachedRenderData or
+  /// ezRenderComponent::InvalidateCachedRenderData.
   void AddRenderData(const ezRenderData* pRenderData, ezRenderData::Category category, ezRenderData::Caching::Enum cachingBehavior);
 
 private:
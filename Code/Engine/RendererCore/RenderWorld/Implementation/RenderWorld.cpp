@@ -11,6 +11,8 @@
 
 ezCVarBool CVarMultithreadedRendering("r_Multithreading", true, ezCVarFlags::Default, "Enables multi-threaded update and rendering");
 ezCVarBool CVarCacheRenderData("r_CacheRenderData", true, ezCVarFlags::Default, "Enables render data caching of static objects");
+ezCVarInt CVarCacheRenderDataMaxNewEntries("r_CacheRenderDataMaxNewEntries", 4096, ezCVarFlags::Default,
+  "Maximum number of components per view whose render data is added to the cache per frame");
 
 ezEvent<ezView*, ezMutex> ezRenderWorld::s_ViewCreatedEvent;
 ezEvent<ezView*, ezMutex> ezRenderWorld::s_ViewDeletedEvent;
@@ -56,11 +58,6 @@ namespace
   typedef ezHybridArray<const ezRenderData*, 4> CachedRenderDataPerComponent;
   static ezHashTable<ezComponentHandle, CachedRenderDataPerComponent> s_CachedRenderData;
   static ezDynamicArray<const ezRenderData*> s_DeletedRenderData;
-
-  enum
-  {
-    MaxNumNewCacheEntries = 32
-  };
 } // namespace
 
 namespace ezInternal
@@ -69,11 +66,42 @@ namespace ezInternal
   {
     RenderDataCache(ezAllocatorBase* pAllocator)
       : m_EntriesPerObject(pAllocator)
+      , m_NewEntriesPerComponent(pAllocator)
+    {
+      m_uiMaxNumNewEntries = static_cast<ezUInt32>(ezMath::Max<ezInt32>(CVarCacheRenderDataMaxNewEntries, 0));
+    }
+
+    /// \brief Grows the new entries to the number of components that wanted to be cached in the last frame, up to the cvar limit.
+    ///
+    /// The new entries start out empty, so views that never see static objects don't pay for the maximum. Components that didn't fit are
+    /// simply cached a frame later. Must not be called during extraction, since CacheRenderData() writes into the new entries without a lock.
+    void UpdateNewEntriesCapacity(ezUInt32 uiNumRequestedEntries)
     {
-      m_NewEntriesPerComponent.SetCount(m_NewEntriesPerComponent.GetCapacity());
-      for (auto& newEntry : m_NewEntriesPerComponent)
+      m_uiMaxNumNewEntries = static_cast<ezUInt32>(ezMath::Max<ezInt32>(CVarCacheRenderDataMaxNewEntries, 0));
+
+      const ezUInt32 uiOldCount = m_NewEntriesPerComponent.GetCount();
+      ezUInt32 uiNewCount = uiOldCount;
+
+      if (uiNumRequestedEntries > uiOldCount)
       {
-        newEntry.m_CacheEntries = CacheEntriesPerObject(pAllocator);
+        uiNewCount = ezMath::Max(uiNumRequestedEntries, uiOldCount * 2, 32u);
+      }
+
+      uiNewCount = ezMath::Min(uiNewCount, m_uiMaxNumNewEntries);
+      if (uiNewCount == uiOldCount)
+        return;
+
+      m_NewEntriesPerComponent.SetCount(uiNewCount);
+
+      if (uiNewCount < uiOldCount)
+      {
+        // the cvar was lowered
+        m_NewEntriesPerComponent.Compact();
+      }
+
+      for (ezUInt32 i = uiOldCount; i < uiNewCount; ++i)
+      {
+        m_NewEntriesPerComponent[i].m_CacheEntries = CacheEntriesPerObject(m_EntriesPerObject.GetAllocator());
       }
     }
 
@@ -88,8 +116,9 @@ namespace ezInternal
       CacheEntriesPerObject m_CacheEntries;
     };
 
-    ezStaticArray<NewEntryPerComponent, MaxNumNewCacheEntries> m_NewEntriesPerComponent;
-    ezAtomicInteger32 m_NewEntriesCount;
+    ezDynamicArray<NewEntryPerComponent> m_NewEntriesPerComponent;
+    ezAtomicInteger32 m_NewEntriesCount; ///< Also counts the components that didn't fit into m_NewEntriesPerComponent
+    ezUInt32 m_uiMaxNumNewEntries = 0;
   };
 
 #if EZ_ENABLED(EZ_PLATFORM_64BIT)
@@ -236,14 +265,16 @@ void ezRenderWorld::CacheRenderData(const ezView& view, const ezGameObjectHandle
 {
   if (CVarCacheRenderData)
   {
+    const ezUInt32 uiMaxNumNewEntries = view.m_pRenderDataCache->m_uiMaxNumNewEntries;
+
     ezUInt32 uiNewEntriesCount = view.m_pRenderDataCache->m_NewEntriesCount;
-    if (uiNewEntriesCount >= MaxNumNewCacheEntries)
+    if (uiNewEntriesCount >= uiMaxNumNewEntries)
     {
       return;
     }
 
     uiNewEntriesCount = view.m_pRenderDataCache->m_NewEntriesCount.Increment();
-    if (uiNewEntriesCount <= MaxNumNewCacheEntries)
+    if (uiNewEntriesCount <= view.m_pRenderDataCache->m_NewEntriesPerComponent.GetCount())
     {
       auto& newEntry = view.m_pRenderDataCache->m_NewEntriesPerComponent[uiNewEntriesCount - 1];
       newEntry.m_hOwnerObject = hOwnerObject;
@@ -579,14 +610,17 @@ void ezRenderWorld::UpdateRenderDataCache()
   for (auto it = s_Views.GetIterator(); it.IsValid(); ++it)
   {
     ezView* pView = it.Value();
-    ezUInt32 uiNumNewEntries = ezMath::Min<ezInt32>(pView->m_pRenderDataCache->m_NewEntriesCount, MaxNumNewCacheEntries);
+    auto& newEntriesPerComponent = pView->m_pRenderDataCache->m_NewEntriesPerComponent;
+
+    const ezUInt32 uiNumRequestedEntries = pView->m_pRenderDataCache->m_NewEntriesCount;
+    const ezUInt32 uiNumNewEntries = ezMath::Min(uiNumRequestedEntries, newEntriesPerComponent.GetCount());
     pView->m_pRenderDataCache->m_NewEntriesCount = 0;
 
     auto& entriesPerObject = pView->m_pRenderDataCache->m_EntriesPerObject;
 
     for (ezUInt32 uiNewEntryIndex = 0; uiNewEntryIndex < uiNumNewEntries; ++uiNewEntryIndex)
     {
-      auto& newEntries = pView->m_pRenderDataCache->m_NewEntriesPerComponent[uiNewEntryIndex];
+      auto& newEntries = newEntriesPerComponent[uiNewEntryIndex];
       EZ_ASSERT_DEV(!newEntries.m_hOwnerObject.IsInvalidated(), "Implementation error");
 
       // find or create cached render data
@@ -634,6 +668,9 @@ void ezRenderWorld::UpdateRenderDataCache()
         }
       }
     }
+
+    // resize here, since the new entries are written without a lock during extraction
+    pView->m_pRenderDataCache->UpdateNewEntriesCapacity(uiNumRequestedEntries);
   }
 }
 
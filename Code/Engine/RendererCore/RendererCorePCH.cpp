@@ -9,8 +9,11 @@ EZ_STATICLINK_LIBRARY(RendererCore)
   EZ_STATICLINK_REFERENCE(RendererCore_AnimationSystem_AnimationGraph_Implementation_AnimationGraphNode);
   EZ_STATICLINK_REFERENCE(RendererCore_AnimationSystem_Implementation_AnimationClipResource);
   EZ_STATICLINK_REFERENCE(RendererCore_AnimationSystem_Implementation_AnimationPose);
+  EZ_STATICLINK_REFERENCE(RendererCore_AnimationSystem_Implementation_AnimationPoseSoA);
+  EZ_STATICLINK_REFERENCE(RendererCore_AnimationSystem_Implementation_CompressedAnimationClip);
   EZ_STATICLINK_REFERENCE(RendererCore_AnimationSystem_Implementation_EditableSkeleton);
   EZ_STATICLINK_REFERENCE(RendererCore_AnimationSystem_Implementation_JointMapping);
+  EZ_STATICLINK_REFERENCE(RendererCore_AnimationSystem_Implementation_MotionMatchingDatabase);
   EZ_STATICLINK_REFERENCE(RendererCore_AnimationSystem_Implementation_Skeleton);
   EZ_STATICLINK_REFERENCE(RendererCore_AnimationSystem_Implementation_SkeletonBuilder);
   EZ_STATICLINK_REFERENCE(RendererCore_AnimationSystem_Implementation_SkeletonResource);
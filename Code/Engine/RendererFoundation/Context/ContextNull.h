@@ -0,0 +1,240 @@
+
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <RendererFoundation/Context/Context.h>
+
+/// \brief Counts the commands that reached an ezGALContextNull, ie. everything that a real render API would have to process.
+///
+/// State changes that ezGALContext already filtered out as redundant are not counted.
+struct ezGALNullContextStatistics
+{
+  ezUInt32 m_uiDrawCalls = 0;
+  ezUInt32 m_uiInstances = 0; ///< Sum of the instance counts of all draw calls. Non-instanced draws count as one, indirect draws as zero.
+  ezUInt32 m_uiDispatchCalls = 0;
+  ezUInt32 m_uiStateChanges = 0;
+  ezUInt32 m_uiClears = 0;
+  ezUInt32 m_uiCopies = 0;
+  ezUInt32 m_uiBufferUpdates = 0;
+  ezUInt64 m_uiBufferBytesUploaded = 0;
+  ezUInt32 m_uiTextureUpdates = 0;
+  ezUInt64 m_uiTextureBytesUploaded = 0;
+};
+
+/// \brief A single command as recorded by ezGALContextNull.
+struct ezGALNullCommand
+{
+  EZ_DECLARE_POD_TYPE();
+
+  /// \brief The recorded arguments depend on the type:
+  ///   Draw: m_uiArg0 = vertex or index count per instance, m_uiArg1 = instance count (both 0 for indirect draws)
+  ///   Dispatch: m_uiArg0 = number of thread groups (0 for indirect dispatches)
+  ///   SetVertexBuffer, SetConstantBuffer, SetUnorderedAccessView, SetStreamOutBuffer: m_uiArg0 = slot
+  ///   SetSamplerState, SetResourceView: m_uiArg0 = shader stage, m_uiArg1 = slot
+  ///   SetPrimitiveTopology: m_uiArg0 = topology
+  ///   SetRenderTargetSetup: m_uiArg0 = number of color targets
+  ///   UpdateBuffer: m_uiArg0 = number of bytes, m_uiArg1 = destination offset
+  ///   UpdateTexture: m_uiArg0 = number of bytes
+  enum class Type : ezUInt8
+  {
+    Clear,
+    ClearUnorderedAccessView,
+    Draw,
+    Dispatch,
+    SetShader,
+    SetIndexBuffer,
+    SetVertexBuffer,
+    SetVertexDeclaration,
+    SetPrimitiveTopology,
+    SetConstantBuffer,
+    SetSamplerState,
+    SetResourceView,
+    SetRenderTargetSetup,
+    SetUnorderedAccessView,
+    SetBlendState,
+    SetDepthStencilState,
+    SetRasterizerState,
+    SetViewport,
+    SetScissorRect,
+    SetStreamOutBuffer,
+    UpdateBuffer,
+    UpdateTexture,
+    Copy,
+  };
+
+  Type m_Type;
+  ezUInt32 m_uiArg0 = 0;
+  ezUInt32 m_uiArg1 = 0;
+  const void* m_pObject = nullptr; ///< The GAL object that was bound or updated, if any.
+};
+
+/// \brief The context of ezGALDeviceNull. It doesn't execute anything, but counts all commands and can optionally record them.
+///
+/// This allows to measure and verify the CPU side of rendering, e.g. extraction, sorting, batching and state caching,
+/// without a GPU or a window.
+class EZ_RENDERERFOUNDATION_DLL ezGALContextNull : public ezGALContext
+{
+public:
+  /// \brief Returns the statistics since the last call to ResetStatistics(). ezGALDeviceNull resets them at the end of every frame.
+  const ezGALNullContextStatistics& GetStatistics() const { return m_Statistics; }
+
+  void ResetStatistics() { m_Statistics = ezGALNullContextStatistics(); }
+
+  /// \brief Enables recording every command into a list, e.g. to verify the order of state changes and draw calls in a test.
+  ///
+  /// Recording is disabled by default, as it costs memory and time. The list is cleared at the beginning of every frame.
+  void SetRecordCommands(bool bRecord) { m_bRecordCommands = bRecord; }
+
+  bool GetRecordCommands() const { return m_bRecordCommands; }
+
+  ezArrayPtr<const ezGALNullCommand> GetRecordedCommands() const { return m_RecordedCommands; }
+
+  void ClearRecordedCommands() { m_RecordedCommands.Clear(); }
+
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALContextNull(ezGALDevice* pDevice);
+
+  ~ezGALContextNull();
+
+  // Draw functions
+
+  virtual void ClearPlatform(const ezColor& ClearColor, ezUInt32 uiRenderTargetClearMask, bool bClearDepth, bool bClearStencil, float fDepthClear,
+    ezUInt8 uiStencilClear) override;
+
+  virtual void ClearUnorderedAccessViewPlatform(const ezGALUnorderedAccessView* pUnorderedAccessView, ezVec4 clearValues) override;
+
+  virtual void ClearUnorderedAccessViewPlatform(const ezGALUnorderedAccessView* pUnorderedAccessView, ezVec4U32 clearValues) override;
+
+  virtual void DrawPlatform(ezUInt32 uiVertexCount, ezUInt32 uiStartVertex) override;
+
+  virtual void DrawIndexedPlatform(ezUInt32 uiIndexCount, ezUInt32 uiStartIndex) override;
+
+  virtual void DrawIndexedInstancedPlatform(ezUInt32 uiIndexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartIndex) override;
+
+  virtual void DrawIndexedInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes) override;
+
+  virtual void DrawInstancedPlatform(ezUInt32 uiVertexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartVertex) override;
+
+  virtual void DrawInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes) override;
+
+  virtual void DrawAutoPlatform() override;
+
+  virtual void BeginStreamOutPlatform() override;
+
+  virtual void EndStreamOutPlatform() override;
+
+  // Dispatch
+
+  virtual void DispatchPlatform(ezUInt32 uiThreadGroupCountX, ezUInt32 uiThreadGroupCountY, ezUInt32 uiThreadGroupCountZ) override;
+
+  virtual void DispatchIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes) override;
+
+
+  // State setting functions
+
+  virtual void SetShaderPlatform(const ezGALShader* pShader) override;
+
+  virtual void SetIndexBufferPlatform(const ezGALBuffer* pIndexBuffer) override;
+
+  virtual void SetVertexBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pVertexBuffer) override;
+
+  virtual void SetVertexDeclarationPlatform(const ezGALVertexDeclaration* pVertexDeclaration) override;
+
+  virtual void SetPrimitiveTopologyPlatform(ezGALPrimitiveTopology::Enum Topology) override;
+
+  virtual void SetConstantBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pBuffer) override;
+
+  virtual void SetSamplerStatePlatform(ezGALShaderStage::Enum Stage, ezUInt32 uiSlot, const ezGALSamplerState* pSamplerState) override;
+
+  virtual void SetResourceViewPlatform(ezGALShaderStage::Enum Stage, ezUInt32 uiSlot, const ezGALResourceView* pResourceView) override;
+
+  virtual void SetRenderTargetSetupPlatform(
+    ezArrayPtr<const ezGALRenderTargetView*> pRenderTargetViews, const ezGALRenderTargetView* pDepthStencilView) override;
+
+  virtual void SetUnorderedAccessViewPlatform(ezUInt32 uiSlot, const ezGALUnorderedAccessView* pUnorderedAccessView) override;
+
+  virtual void SetBlendStatePlatform(const ezGALBlendState* pBlendState, const ezColor& BlendFactor, ezUInt32 uiSampleMask) override;
+
+  virtual void SetDepthStencilStatePlatform(const ezGALDepthStencilState* pDepthStencilState, ezUInt8 uiStencilRefValue) override;
+
+  virtual void SetRasterizerStatePlatform(const ezGALRasterizerState* pRasterizerState) override;
+
+  virtual void SetViewportPlatform(const ezRectFloat& rect, float fMinDepth, float fMaxDepth) override;
+
+  virtual void SetScissorRectPlatform(const ezRectU32& rect) override;
+
+  virtual void SetStreamOutBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pBuffer, ezUInt32 uiOffset) override;
+
+  // Fence & Query functions
+
+  virtual void InsertFencePlatform(const ezGALFence* pFence) override;
+
+  virtual bool IsFenceReachedPlatform(const ezGALFence* pFence) override;
+
+  virtual void WaitForFencePlatform(const ezGALFence* pFence) override;
+
+  virtual void BeginQueryPlatform(const ezGALQuery* pQuery) override;
+
+  virtual void EndQueryPlatform(const ezGALQuery* pQuery) override;
+
+  virtual ezResult GetQueryResultPlatform(const ezGALQuery* pQuery, ezUInt64& uiQueryResult) override;
+
+  // Timestamp functions
+
+  virtual void InsertTimestampPlatform(ezGALTimestampHandle hTimestamp) override;
+
+  // Resource update functions
+
+  virtual void CopyBufferPlatform(const ezGALBuffer* pDestination, const ezGALBuffer* pSource) override;
+
+  virtual void CopyBufferRegionPlatform(
+    const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, const ezGALBuffer* pSource, ezUInt32 uiSourceOffset, ezUInt32 uiByteCount) override;
+
+  virtual void UpdateBufferPlatform(
+    const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, ezArrayPtr<const ezUInt8> pSourceData, ezGALUpdateMode::Enum updateMode) override;
+
+  virtual void CopyTexturePlatform(const ezGALTexture* pDestination, const ezGALTexture* pSource) override;
+
+  virtual void CopyTextureRegionPlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& DestinationSubResource,
+    const ezVec3U32& DestinationPoint, const ezGALTexture* pSource, const ezGALTextureSubresource& SourceSubResource,
+    const ezBoundingBoxu32& Box) override;
+
+  virtual void UpdateTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& DestinationSubResource,
+    const ezBoundingBoxu32& DestinationBox, const ezGALSystemMemoryDescription& pSourceData) override;
+
+  virtual void ResolveTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& DestinationSubResource,
+    const ezGALTexture* pSource, const ezGALTextureSubresource& SourceSubResource) override;
+
+  virtual void ReadbackTexturePlatform(const ezGALTexture* pTexture) override;
+
+  virtual void CopyTextureReadbackResultPlatform(const ezGALTexture* pTexture, const ezArrayPtr<ezGALSystemMemoryDescription>* pData) override;
+
+  virtual void GenerateMipMapsPlatform(const ezGALResourceView* pResourceView) override;
+
+  // Misc
+
+  virtual void FlushPlatform() override;
+
+  // Debug helper functions
+
+  virtual void PushMarkerPlatform(const char* szMarker) override;
+
+  virtual void PopMarkerPlatform() override;
+
+  virtual void InsertEventMarkerPlatform(const char* szMarker) override;
+
+
+  void RecordStateChange(ezGALNullCommand::Type type, const void* pObject, ezUInt32 uiArg0 = 0, ezUInt32 uiArg1 = 0);
+
+  void RecordDraw(ezUInt32 uiCount, ezUInt32 uiInstanceCount);
+
+  void Record(ezGALNullCommand::Type type, const void* pObject, ezUInt32 uiArg0 = 0, ezUInt32 uiArg1 = 0);
+
+  ezGALNullContextStatistics m_Statistics;
+
+  bool m_bRecordCommands = false;
+  ezDynamicArray<ezGALNullCommand> m_RecordedCommands;
+};
@@ -0,0 +1,320 @@
+#include <RendererFoundationPCH.h>
+
+#include <RendererFoundation/Context/ContextNull.h>
+#include <RendererFoundation/Device/DeviceNull.h>
+#include <RendererFoundation/Resources/Buffer.h>
+#include <RendererFoundation/Resources/Texture.h>
+
+ezGALContextNull::ezGALContextNull(ezGALDevice* pDevice)
+  : ezGALContext(pDevice)
+{
+}
+
+ezGALContextNull::~ezGALContextNull() = default;
+
+// Draw functions
+
+void ezGALContextNull::ClearPlatform(
+  const ezColor& ClearColor, ezUInt32 uiRenderTargetClearMask, bool bClearDepth, bool bClearStencil, float fDepthClear, ezUInt8 uiStencilClear)
+{
+  m_Statistics.m_uiClears++;
+  Record(ezGALNullCommand::Type::Clear, nullptr, uiRenderTargetClearMask);
+}
+
+void ezGALContextNull::ClearUnorderedAccessViewPlatform(const ezGALUnorderedAccessView* pUnorderedAccessView, ezVec4 clearValues)
+{
+  m_Statistics.m_uiClears++;
+  Record(ezGALNullCommand::Type::ClearUnorderedAccessView, pUnorderedAccessView);
+}
+
+void ezGALContextNull::ClearUnorderedAccessViewPlatform(const ezGALUnorderedAccessView* pUnorderedAccessView, ezVec4U32 clearValues)
+{
+  m_Statistics.m_uiClears++;
+  Record(ezGALNullCommand::Type::ClearUnorderedAccessView, pUnorderedAccessView);
+}
+
+void ezGALContextNull::DrawPlatform(ezUInt32 uiVertexCount, ezUInt32 uiStartVertex)
+{
+  RecordDraw(uiVertexCount, 1);
+}
+
+void ezGALContextNull::DrawIndexedPlatform(ezUInt32 uiIndexCount, ezUInt32 uiStartIndex)
+{
+  RecordDraw(uiIndexCount, 1);
+}
+
+void ezGALContextNull::DrawIndexedInstancedPlatform(ezUInt32 uiIndexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartIndex)
+{
+  RecordDraw(uiIndexCountPerInstance, uiInstanceCount);
+}
+
+void ezGALContextNull::DrawIndexedInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes)
+{
+  // the arguments are only known to the GPU
+  RecordDraw(0, 0);
+}
+
+void ezGALContextNull::DrawInstancedPlatform(ezUInt32 uiVertexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartVertex)
+{
+  RecordDraw(uiVertexCountPerInstance, uiInstanceCount);
+}
+
+void ezGALContextNull::DrawInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes)
+{
+  RecordDraw(0, 0);
+}
+
+void ezGALContextNull::DrawAutoPlatform()
+{
+  RecordDraw(0, 1);
+}
+
+void ezGALContextNull::BeginStreamOutPlatform() {}
+
+void ezGALContextNull::EndStreamOutPlatform() {}
+
+// Dispatch
+
+void ezGALContextNull::DispatchPlatform(ezUInt32 uiThreadGroupCountX, ezUInt32 uiThreadGroupCountY, ezUInt32 uiThreadGroupCountZ)
+{
+  m_Statistics.m_uiDispatchCalls++;
+  Record(ezGALNullCommand::Type::Dispatch, nullptr, uiThreadGroupCountX * uiThreadGroupCountY * uiThreadGroupCountZ);
+}
+
+void ezGALContextNull::DispatchIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes)
+{
+  m_Statistics.m_uiDispatchCalls++;
+  Record(ezGALNullCommand::Type::Dispatch, pIndirectArgumentBuffer);
+}
+
+
+// State setting functions
+
+void ezGALContextNull::SetShaderPlatform(const ezGALShader* pShader)
+{
+  RecordStateChange(ezGALNullCommand::Type::SetShader, pShader);
+}
+
+void ezGALContextNull::SetIndexBufferPlatform(const ezGALBuffer* pIndexBuffer)
+{
+  RecordStateChange(ezGALNullCommand::Type::SetIndexBuffer, pIndexBuffer);
+}
+
+void ezGALContextNull::SetVertexBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pVertexBuffer)
+{
+  RecordStateChange(ezGALNullCommand::Type::SetVertexBuffer, pVertexBuffer, uiSlot);
+}
+
+void ezGALContextNull::SetVertexDeclarationPlatform(const ezGALVertexDeclaration* pVertexDeclaration)
+{
+  RecordStateChange(ezGALNullCommand::Type::SetVertexDeclaration, pVertexDeclaration);
+}
+
+void ezGALContextNull::SetPrimitiveTopologyPlatform(ezGALPrimitiveTopology::Enum Topology)
+{
+  RecordStateChange(ezGALNullCommand::Type::SetPrimitiveTopology, nullptr, Topology);
+}
+
+void ezGALContextNull::SetConstantBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pBuffer)
+{
+  RecordStateChange(ezGALNullCommand::Type::SetConstantBuffer, pBuffer, uiSlot);
+}
+
+void ezGALContextNull::SetSamplerStatePlatform(ezGALShaderStage::Enum Stage, ezUInt32 uiSlot, const ezGALSamplerState* pSamplerState)
+{
+  RecordStateChange(ezGALNullCommand::Type::SetSamplerState, pSamplerState, Stage, uiSlot);
+}
+
+void ezGALContextNull::SetResourceViewPlatform(ezGALShaderStage::Enum Stage, ezUInt32 uiSlot, const ezGALResourceView* pResourceView)
+{
+  RecordStateChange(ezGALNullCommand::Type::SetResourceView, pResourceView, Stage, uiSlot);
+}
+
+void ezGALContextNull::SetRenderTargetSetupPlatform(
+  ezArrayPtr<const ezGALRenderTargetView*> pRenderTargetViews, const ezGALRenderTargetView* pDepthStencilView)
+{
+  RecordStateChange(ezGALNullCommand::Type::SetRenderTargetSetup, pDepthStencilView, pRenderTargetViews.GetCount());
+}
+
+void ezGALContextNull::SetUnorderedAccessViewPlatform(ezUInt32 uiSlot, const ezGALUnorderedAccessView* pUnorderedAccessView)
+{
+  RecordStateChange(ezGALNullCommand::Type::SetUnorderedAccessView, pUnorderedAccessView, uiSlot);
+}
+
+void ezGALContextNull::SetBlendStatePlatform(const ezGALBlendState* pBlendState, const ezColor& BlendFactor, ezUInt32 uiSampleMask)
+{
+  RecordStateChange(ezGALNullCommand::Type::SetBlendState, pBlendState);
+}
+
+void ezGALContextNull::SetDepthStencilStatePlatform(const ezGALDepthStencilState* pDepthStencilState, ezUInt8 uiStencilRefValue)
+{
+  RecordStateChange(ezGALNullCommand::Type::SetDepthStencilState, pDepthStencilState);
+}
+
+void ezGALContextNull::SetRasterizerStatePlatform(const ezGALRasterizerState* pRasterizerState)
+{
+  RecordStateChange(ezGALNullCommand::Type::SetRasterizerState, pRasterizerState);
+}
+
+void ezGALContextNull::SetViewportPlatform(const ezRectFloat& rect, float fMinDepth, float fMaxDepth)
+{
+  RecordStateChange(ezGALNullCommand::Type::SetViewport, nullptr);
+}
+
+void ezGALContextNull::SetScissorRectPlatform(const ezRectU32& rect)
+{
+  RecordStateChange(ezGALNullCommand::Type::SetScissorRect, nullptr);
+}
+
+void ezGALContextNull::SetStreamOutBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pBuffer, ezUInt32 uiOffset)
+{
+  RecordStateChange(ezGALNullCommand::Type::SetStreamOutBuffer, pBuffer, uiSlot);
+}
+
+// Fence & Query functions
+
+void ezGALContextNull::InsertFencePlatform(const ezGALFence* pFence) {}
+
+bool ezGALContextNull::IsFenceReachedPlatform(const ezGALFence* pFence)
+{
+  // there is no GPU that could lag behind
+  return true;
+}
+
+void ezGALContextNull::WaitForFencePlatform(const ezGALFence* pFence) {}
+
+void ezGALContextNull::BeginQueryPlatform(const ezGALQuery* pQuery) {}
+
+void ezGALContextNull::EndQueryPlatform(const ezGALQuery* pQuery) {}
+
+ezResult ezGALContextNull::GetQueryResultPlatform(const ezGALQuery* pQuery, ezUInt64& uiQueryResult)
+{
+  uiQueryResult = 0;
+  return EZ_SUCCESS;
+}
+
+// Timestamp functions
+
+void ezGALContextNull::InsertTimestampPlatform(ezGALTimestampHandle hTimestamp)
+{
+  static_cast<ezGALDeviceNull*>(GetDevice())->SetTimestamp(hTimestamp, ezTime::Now());
+}
+
+// Resource update functions
+
+void ezGALContextNull::CopyBufferPlatform(const ezGALBuffer* pDestination, const ezGALBuffer* pSource)
+{
+  m_Statistics.m_uiCopies++;
+  Record(ezGALNullCommand::Type::Copy, pDestination);
+}
+
+void ezGALContextNull::CopyBufferRegionPlatform(
+  const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, const ezGALBuffer* pSource, ezUInt32 uiSourceOffset, ezUInt32 uiByteCount)
+{
+  m_Statistics.m_uiCopies++;
+  Record(ezGALNullCommand::Type::Copy, pDestination);
+}
+
+void ezGALContextNull::UpdateBufferPlatform(
+  const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, ezArrayPtr<const ezUInt8> pSourceData, ezGALUpdateMode::Enum updateMode)
+{
+  EZ_ASSERT_DEV(uiDestOffset + pSourceData.GetCount() <= pDestination->GetSize(), "Buffer update of {0} bytes at offset {1} exceeds the size {2}",
+    pSourceData.GetCount(), uiDestOffset, pDestination->GetSize());
+
+  m_Statistics.m_uiBufferUpdates++;
+  m_Statistics.m_uiBufferBytesUploaded += pSourceData.GetCount();
+  Record(ezGALNullCommand::Type::UpdateBuffer, pDestination, pSourceData.GetCount(), uiDestOffset);
+}
+
+void ezGALContextNull::CopyTexturePlatform(const ezGALTexture* pDestination, const ezGALTexture* pSource)
+{
+  m_Statistics.m_uiCopies++;
+  Record(ezGALNullCommand::Type::Copy, pDestination);
+}
+
+void ezGALContextNull::CopyTextureRegionPlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& DestinationSubResource,
+  const ezVec3U32& DestinationPoint, const ezGALTexture* pSource, const ezGALTextureSubresource& SourceSubResource, const ezBoundingBoxu32& Box)
+{
+  m_Statistics.m_uiCopies++;
+  Record(ezGALNullCommand::Type::Copy, pDestination);
+}
+
+void ezGALContextNull::UpdateTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& DestinationSubResource,
+  const ezBoundingBoxu32& DestinationBox, const ezGALSystemMemoryDescription& pSourceData)
+{
+  const ezVec3U32 size = DestinationBox.m_vMax - DestinationBox.m_vMin;
+  const ezUInt32 uiBytes = ezGALResourceFormat::GetBitsPerElement(pDestination->GetDescription().m_Format) * size.x * size.y * size.z / 8;
+
+  m_Statistics.m_uiTextureUpdates++;
+  m_Statistics.m_uiTextureBytesUploaded += uiBytes;
+  Record(ezGALNullCommand::Type::UpdateTexture, pDestination, uiBytes);
+}
+
+void ezGALContextNull::ResolveTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& DestinationSubResource,
+  const ezGALTexture* pSource, const ezGALTextureSubresource& SourceSubResource)
+{
+  m_Statistics.m_uiCopies++;
+  Record(ezGALNullCommand::Type::Copy, pDestination);
+}
+
+void ezGALContextNull::ReadbackTexturePlatform(const ezGALTexture* pTexture)
+{
+  EZ_ASSERT_DEV(pTexture->GetDescription().m_ResourceAccess.m_bReadBack,
+    "A texture supplied to read-back needs to be created with the correct resource usage (m_bReadBack = true)!");
+}
+
+void ezGALContextNull::CopyTextureReadbackResultPlatform(const ezGALTexture* pTexture, const ezArrayPtr<ezGALSystemMemoryDescription>* pData)
+{
+  // nothing was ever rendered, so the result is black
+  const ezGALTextureCreationDescription& desc = pTexture->GetDescription();
+  const ezUInt32 uiRowSize = ezGALResourceFormat::GetBitsPerElement(desc.m_Format) * desc.m_uiWidth / 8;
+
+  for (ezUInt32 y = 0; y < desc.m_uiHeight; ++y)
+  {
+    ezMemoryUtils::ZeroFill(static_cast<ezUInt8*>(ezMemoryUtils::AddByteOffset((*pData)[0].m_pData, y * (*pData)[0].m_uiRowPitch)), uiRowSize);
+  }
+}
+
+void ezGALContextNull::GenerateMipMapsPlatform(const ezGALResourceView* pResourceView) {}
+
+// Misc
+
+void ezGALContextNull::FlushPlatform() {}
+
+// Debug helper functions
+
+void ezGALContextNull::PushMarkerPlatform(const char* szMarker) {}
+
+void ezGALContextNull::PopMarkerPlatform() {}
+
+void ezGALContextNull::InsertEventMarkerPlatform(const char* szMarker) {}
+
+
+void ezGALContextNull::RecordStateChange(ezGALNullCommand::Type type, const void* pObject, ezUInt32 uiArg0, ezUInt32 uiArg1)
+{
+  m_Statistics.m_uiStateChanges++;
+  Record(type, pObject, uiArg0, uiArg1);
+}
+
+void ezGALContextNull::RecordDraw(ezUInt32 uiCount, ezUInt32 uiInstanceCount)
+{
+  m_Statistics.m_uiDrawCalls++;
+  m_Statistics.m_uiInstances += uiInstanceCount;
+  Record(ezGALNullCommand::Type::Draw, nullptr, uiCount, uiInstanceCount);
+}
+
+void ezGALContextNull::Record(ezGALNullCommand::Type type, const void* pObject, ezUInt32 uiArg0, ezUInt32 uiArg1)
+{
+  if (!m_bRecordCommands)
+    return;
+
+  ezGALNullCommand& command = m_RecordedCommands.ExpandAndGetRef();
+  command.m_Type = type;
+  command.m_uiArg0 = uiArg0;
+  command.m_uiArg1 = uiArg1;
+  command.m_pObject = pObject;
+}
+
+
+
+EZ_STATICLINK_FILE(RendererFoundation, RendererFoundation_Context_Implementation_ContextNull);
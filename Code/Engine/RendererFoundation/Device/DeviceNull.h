@@ -0,0 +1,141 @@
+
+#pragma once
+
+#include <Foundation/Math/Size.h>
+#include <RendererFoundation/Context/ContextNull.h>
+#include <RendererFoundation/Device/Device.h>
+
+/// \brief A device implementation of the graphics abstraction layer that doesn't render anything.
+///
+/// All resources and states are only CPU-side bookkeeping objects and all commands are counted by ezGALContextNull.
+/// This allows to run the CPU side of the renderer, e.g. ezRenderPipeline, ezRenderContext and ezRenderWorld::Render(),
+/// on machines without a GPU or a window, e.g. to benchmark it on a build server. Swap chains never access their window
+/// (which must still be set) and use a back buffer of the size passed to SetBackBufferSize().
+///
+/// Shaders are never executed, so anything that reads back GPU results (queries, read-back textures) only gets zeros.
+class EZ_RENDERERFOUNDATION_DLL ezGALDeviceNull : public ezGALDevice
+{
+public:
+  ezGALDeviceNull(const ezGALDeviceCreationDescription& Description);
+
+  virtual ~ezGALDeviceNull();
+
+  ezGALContextNull* GetNullContext() const { return static_cast<ezGALContextNull*>(m_pPrimaryContext); }
+
+  /// \brief The statistics of the primary context during the last completed frame, ie. between the last BeginFrame() and EndFrame().
+  const ezGALNullContextStatistics& GetLastFrameStatistics() const { return m_LastFrameStatistics; }
+
+  /// \brief Sets the size of the back buffers of all swap chains that are created afterwards. The default is 1280x720.
+  void SetBackBufferSize(ezSizeU32 size) { m_BackBufferSize = size; }
+
+  ezSizeU32 GetBackBufferSize() const { return m_BackBufferSize; }
+
+protected:
+  // Init & shutdown functions
+
+  virtual ezResult InitPlatform() override;
+
+  virtual ezResult ShutdownPlatform() override;
+
+
+  // State creation functions
+
+  virtual ezGALBlendState* CreateBlendStatePlatform(const ezGALBlendStateCreationDescription& Description) override;
+
+  virtual void DestroyBlendStatePlatform(ezGALBlendState* pBlendState) override;
+
+  virtual ezGALDepthStencilState* CreateDepthStencilStatePlatform(const ezGALDepthStencilStateCreationDescription& Description) override;
+
+  virtual void DestroyDepthStencilStatePlatform(ezGALDepthStencilState* pDepthStencilState) override;
+
+  virtual ezGALRasterizerState* CreateRasterizerStatePlatform(const ezGALRasterizerStateCreationDescription& Description) override;
+
+  virtual void DestroyRasterizerStatePlatform(ezGALRasterizerState* pRasterizerState) override;
+
+  virtual ezGALSamplerState* CreateSamplerStatePlatform(const ezGALSamplerStateCreationDescription& Description) override;
+
+  virtual void DestroySamplerStatePlatform(ezGALSamplerState* pSamplerState) override;
+
+
+  // Resource creation functions
+
+  virtual ezGALShader* CreateShaderPlatform(const ezGALShaderCreationDescription& Description) override;
+
+  virtual void DestroyShaderPlatform(ezGALShader* pShader) override;
+
+  virtual ezGALBuffer* CreateBufferPlatform(const ezGALBufferCreationDescription& Description, ezArrayPtr<const ezUInt8> pInitialData) override;
+
+  virtual void DestroyBufferPlatform(ezGALBuffer* pBuffer) override;
+
+  virtual ezGALTexture* CreateTexturePlatform(
+    const ezGALTextureCreationDescription& Description, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData) override;
+
+  virtual void DestroyTexturePlatform(ezGALTexture* pTexture) override;
+
+  virtual ezGALResourceView* CreateResourceViewPlatform(
+    ezGALResourceBase* pResource, const ezGALResourceViewCreationDescription& Description) override;
+
+  virtual void DestroyResourceViewPlatform(ezGALResourceView* pResourceView) override;
+
+  virtual ezGALRenderTargetView* CreateRenderTargetViewPlatform(
+    ezGALTexture* pTexture, const ezGALRenderTargetViewCreationDescription& Description) override;
+
+  virtual void DestroyRenderTargetViewPlatform(ezGALRenderTargetView* pRenderTargetView) override;
+
+  virtual ezGALUnorderedAccessView* CreateUnorderedAccessViewPlatform(
+    ezGALResourceBase* pResource, const ezGALUnorderedAccessViewCreationDescription& Description) override;
+
+  virtual void DestroyUnorderedAccessViewPlatform(ezGALUnorderedAccessView* pUnorderedAccessView) override;
+
+  // Other rendering creation functions
+
+  virtual ezGALSwapChain* CreateSwapChainPlatform(const ezGALSwapChainCreationDescription& Description) override;
+
+  virtual void DestroySwapChainPlatform(ezGALSwapChain* pSwapChain) override;
+
+  virtual ezGALFence* CreateFencePlatform() override;
+
+  virtual void DestroyFencePlatform(ezGALFence* pFence) override;
+
+  virtual ezGALQuery* CreateQueryPlatform(const ezGALQueryCreationDescription& Description) override;
+
+  virtual void DestroyQueryPlatform(ezGALQuery* pQuery) override;
+
+  virtual ezGALVertexDeclaration* CreateVertexDeclarationPlatform(const ezGALVertexDeclarationCreationDescription& Description) override;
+
+  virtual void DestroyVertexDeclarationPlatform(ezGALVertexDeclaration* pVertexDeclaration) override;
+
+  // Timestamp functions
+
+  virtual ezGALTimestampHandle GetTimestampPlatform() override;
+
+  virtual ezResult GetTimestampResultPlatform(ezGALTimestampHandle hTimestamp, ezTime& result) override;
+
+  // Swap chain functions
+
+  virtual void PresentPlatform(ezGALSwapChain* pSwapChain, bool bVSync) override;
+
+  // Misc functions
+
+  virtual void BeginFramePlatform() override;
+
+  virtual void EndFramePlatform() override;
+
+  virtual void SetPrimarySwapChainPlatform(ezGALSwapChain* pSwapChain) override;
+
+  virtual void FillCapabilitiesPlatform() override;
+
+private:
+  friend class ezGALContextNull;
+
+  void SetTimestamp(ezGALTimestampHandle hTimestamp, ezTime time);
+
+  ezGALNullContextStatistics m_LastFrameStatistics;
+
+  ezSizeU32 m_BackBufferSize = ezSizeU32(1280, 720);
+
+  ezDynamicArray<ezTime, ezLocalAllocatorWrapper> m_Timestamps;
+  ezUInt32 m_uiNextTimestamp = 0;
+
+  ezUInt64 m_uiFrameCounter = 0;
+};
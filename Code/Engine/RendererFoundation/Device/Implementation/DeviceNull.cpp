@@ -0,0 +1,516 @@
+#include <RendererFoundationPCH.h>
+
+#include <Foundation/Logging/Log.h>
+#include <RendererFoundation/Context/ContextNull.h>
+#include <RendererFoundation/Device/DeviceNull.h>
+#include <RendererFoundation/Device/SwapChain.h>
+#include <RendererFoundation/Resources/Buffer.h>
+#include <RendererFoundation/Resources/Fence.h>
+#include <RendererFoundation/Resources/Query.h>
+#include <RendererFoundation/Resources/RenderTargetView.h>
+#include <RendererFoundation/Resources/ResourceView.h>
+#include <RendererFoundation/Resources/Texture.h>
+#include <RendererFoundation/Resources/UnorderedAccesView.h>
+#include <RendererFoundation/Shader/Shader.h>
+#include <RendererFoundation/Shader/VertexDeclaration.h>
+#include <RendererFoundation/State/State.h>
+
+namespace
+{
+  // The null objects only hold the creation description that is stored by their base classes.
+
+  class ezGALBlendStateNull : public ezGALBlendState
+  {
+  public:
+    ezGALBlendStateNull(const ezGALBlendStateCreationDescription& Description)
+      : ezGALBlendState(Description)
+    {
+    }
+
+    virtual ezResult InitPlatform(ezGALDevice* pDevice) override { return EZ_SUCCESS; }
+    virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override { return EZ_SUCCESS; }
+  };
+
+  class ezGALDepthStencilStateNull : public ezGALDepthStencilState
+  {
+  public:
+    ezGALDepthStencilStateNull(const ezGALDepthStencilStateCreationDescription& Description)
+      : ezGALDepthStencilState(Description)
+    {
+    }
+
+    virtual ezResult InitPlatform(ezGALDevice* pDevice) override { return EZ_SUCCESS; }
+    virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override { return EZ_SUCCESS; }
+  };
+
+  class ezGALRasterizerStateNull : public ezGALRasterizerState
+  {
+  public:
+    ezGALRasterizerStateNull(const ezGALRasterizerStateCreationDescription& Description)
+      : ezGALRasterizerState(Description)
+    {
+    }
+
+    virtual ezResult InitPlatform(ezGALDevice* pDevice) override { return EZ_SUCCESS; }
+    virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override { return EZ_SUCCESS; }
+  };
+
+  class ezGALSamplerStateNull : public ezGALSamplerState
+  {
+  public:
+    ezGALSamplerStateNull(const ezGALSamplerStateCreationDescription& Description)
+      : ezGALSamplerState(Description)
+    {
+    }
+
+    virtual ezResult InitPlatform(ezGALDevice* pDevice) override { return EZ_SUCCESS; }
+    virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override { return EZ_SUCCESS; }
+  };
+
+  class ezGALShaderNull : public ezGALShader
+  {
+  public:
+    ezGALShaderNull(const ezGALShaderCreationDescription& Description)
+      : ezGALShader(Description)
+    {
+    }
+
+    virtual void SetDebugName(const char* szName) const override {}
+    virtual ezResult InitPlatform(ezGALDevice* pDevice) override { return EZ_SUCCESS; }
+    virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override { return EZ_SUCCESS; }
+  };
+
+  class ezGALBufferNull : public ezGALBuffer
+  {
+  public:
+    ezGALBufferNull(const ezGALBufferCreationDescription& Description)
+      : ezGALBuffer(Description)
+    {
+    }
+
+    virtual ezResult InitPlatform(ezGALDevice* pDevice, ezArrayPtr<const ezUInt8> pInitialData) override
+    {
+      if (!pInitialData.IsEmpty() && pInitialData.GetCount() < GetSize())
+      {
+        ezLog::Error("Initial data for buffer is smaller than the buffer size");
+        return EZ_FAILURE;
+      }
+
+      return EZ_SUCCESS;
+    }
+
+    virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override { return EZ_SUCCESS; }
+    virtual void SetDebugNamePlatform(const char* szName) const override {}
+  };
+
+  class ezGALTextureNull : public ezGALTexture
+  {
+  public:
+    ezGALTextureNull(const ezGALTextureCreationDescription& Description)
+      : ezGALTexture(Description)
+    {
+    }
+
+    virtual ezResult InitPlatform(ezGALDevice* pDevice, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData) override { return EZ_SUCCESS; }
+    virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override { return EZ_SUCCESS; }
+    virtual ezResult ReplaceExisitingNativeObject(void* pExisitingNativeObject) override { return EZ_SUCCESS; }
+    virtual void SetDebugNamePlatform(const char* szName) const override {}
+  };
+
+  class ezGALResourceViewNull : public ezGALResourceView
+  {
+  public:
+    ezGALResourceViewNull(ezGALResourceBase* pResource, const ezGALResourceViewCreationDescription& Description)
+      : ezGALResourceView(pResource, Description)
+    {
+    }
+
+    virtual ezResult InitPlatform(ezGALDevice* pDevice) override { return EZ_SUCCESS; }
+    virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override { return EZ_SUCCESS; }
+  };
+
+  class ezGALRenderTargetViewNull : public ezGALRenderTargetView
+  {
+  public:
+    ezGALRenderTargetViewNull(ezGALTexture* pTexture, const ezGALRenderTargetViewCreationDescription& Description)
+      : ezGALRenderTargetView(pTexture, Description)
+    {
+    }
+
+    virtual ezResult InitPlatform(ezGALDevice* pDevice) override { return EZ_SUCCESS; }
+    virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override { return EZ_SUCCESS; }
+  };
+
+  class ezGALUnorderedAccessViewNull : public ezGALUnorderedAccessView
+  {
+  public:
+    ezGALUnorderedAccessViewNull(ezGALResourceBase* pResource, const ezGALUnorderedAccessViewCreationDescription& Description)
+      : ezGALUnorderedAccessView(pResource, Description)
+    {
+    }
+
+    virtual ezResult InitPlatform(ezGALDevice* pDevice) override { return EZ_SUCCESS; }
+    virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override { return EZ_SUCCESS; }
+  };
+
+  class ezGALSwapChainNull : public ezGALSwapChain
+  {
+  public:
+    ezGALSwapChainNull(const ezGALSwapChainCreationDescription& Description)
+      : ezGALSwapChain(Description)
+    {
+    }
+
+    virtual ezResult InitPlatform(ezGALDevice* pDevice) override
+    {
+      const ezSizeU32 size = static_cast<ezGALDeviceNull*>(pDevice)->GetBackBufferSize();
+
+      ezGALTextureCreationDescription TexDesc;
+      TexDesc.m_uiWidth = size.width;
+      TexDesc.m_uiHeight = size.height;
+      TexDesc.m_SampleCount = m_Description.m_SampleCount;
+      TexDesc.m_Format = m_Description.m_BackBufferFormat;
+      TexDesc.m_bAllowShaderResourceView = false;
+      TexDesc.m_bCreateRenderTarget = true;
+      TexDesc.m_ResourceAccess.m_bImmutable = true;
+      TexDesc.m_ResourceAccess.m_bReadBack = m_Description.m_bAllowScreenshots;
+
+      m_hBackBufferTexture = pDevice->CreateTexture(TexDesc);
+      return m_hBackBufferTexture.IsInvalidated() ? EZ_FAILURE : EZ_SUCCESS;
+    }
+
+    virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override { return ezGALSwapChain::DeInitPlatform(pDevice); }
+  };
+
+  class ezGALFenceNull : public ezGALFence
+  {
+  public:
+    virtual ezResult InitPlatform(ezGALDevice* pDevice) override { return EZ_SUCCESS; }
+    virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override { return EZ_SUCCESS; }
+  };
+
+  class ezGALQueryNull : public ezGALQuery
+  {
+  public:
+    ezGALQueryNull(const ezGALQueryCreationDescription& Description)
+      : ezGALQuery(Description)
+    {
+    }
+
+    virtual ezResult InitPlatform(ezGALDevice* pDevice) override { return EZ_SUCCESS; }
+    virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override { return EZ_SUCCESS; }
+    virtual void SetDebugNamePlatform(const char* szName) const override {}
+  };
+
+  class ezGALVertexDeclarationNull : public ezGALVertexDeclaration
+  {
+  public:
+    ezGALVertexDeclarationNull(const ezGALVertexDeclarationCreationDescription& Description)
+      : ezGALVertexDeclaration(Description)
+    {
+    }
+
+    virtual ezResult InitPlatform(ezGALDevice* pDevice) override { return EZ_SUCCESS; }
+    virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override { return EZ_SUCCESS; }
+  };
+
+  template <typename NullType, typename BaseType, typename... Args>
+  BaseType* CreateNullObject(ezAllocatorBase* pAllocator, ezGALDevice* pDevice, Args&&... args)
+  {
+    NullType* pObject = EZ_NEW(pAllocator, NullType, std::forward<Args>(args)...);
+
+    if (pObject->InitPlatform(pDevice).Failed())
+    {
+      EZ_DELETE(pAllocator, pObject);
+      return nullptr;
+    }
+
+    return pObject;
+  }
+
+  template <typename NullType, typename BaseType>
+  void DestroyNullObject(ezAllocatorBase* pAllocator, ezGALDevice* pDevice, BaseType* pBaseObject)
+  {
+    NullType* pObject = static_cast<NullType*>(pBaseObject);
+    pObject->DeInitPlatform(pDevice).IgnoreResult();
+    EZ_DELETE(pAllocator, pObject);
+  }
+} // namespace
+
+ezGALDeviceNull::ezGALDeviceNull(const ezGALDeviceCreationDescription& Description)
+  : ezGALDevice(Description)
+{
+}
+
+ezGALDeviceNull::~ezGALDeviceNull() = default;
+
+// Init & shutdown functions
+
+ezResult ezGALDeviceNull::InitPlatform()
+{
+  EZ_LOG_BLOCK("ezGALDeviceNull::InitPlatform");
+
+  m_pPrimaryContext = EZ_NEW(&m_Allocator, ezGALContextNull, this);
+
+  m_Timestamps.SetCount(1024);
+
+  ezClipSpaceDepthRange::Default = ezClipSpaceDepthRange::ZeroToOne;
+
+  ezLog::Success("Initialized null device, nothing will be rendered.");
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALDeviceNull::ShutdownPlatform()
+{
+  m_Timestamps.Clear();
+
+  EZ_DELETE(&m_Allocator, m_pPrimaryContext);
+
+  return EZ_SUCCESS;
+}
+
+
+// State creation functions
+
+ezGALBlendState* ezGALDeviceNull::CreateBlendStatePlatform(const ezGALBlendStateCreationDescription& Description)
+{
+  return CreateNullObject<ezGALBlendStateNull, ezGALBlendState>(&m_Allocator, this, Description);
+}
+
+void ezGALDeviceNull::DestroyBlendStatePlatform(ezGALBlendState* pBlendState)
+{
+  DestroyNullObject<ezGALBlendStateNull>(&m_Allocator, this, pBlendState);
+}
+
+ezGALDepthStencilState* ezGALDeviceNull::CreateDepthStencilStatePlatform(const ezGALDepthStencilStateCreationDescription& Description)
+{
+  return CreateNullObject<ezGALDepthStencilStateNull, ezGALDepthStencilState>(&m_Allocator, this, Description);
+}
+
+void ezGALDeviceNull::DestroyDepthStencilStatePlatform(ezGALDepthStencilState* pDepthStencilState)
+{
+  DestroyNullObject<ezGALDepthStencilStateNull>(&m_Allocator, this, pDepthStencilState);
+}
+
+ezGALRasterizerState* ezGALDeviceNull::CreateRasterizerStatePlatform(const ezGALRasterizerStateCreationDescription& Description)
+{
+  return CreateNullObject<ezGALRasterizerStateNull, ezGALRasterizerState>(&m_Allocator, this, Description);
+}
+
+void ezGALDeviceNull::DestroyRasterizerStatePlatform(ezGALRasterizerState* pRasterizerState)
+{
+  DestroyNullObject<ezGALRasterizerStateNull>(&m_Allocator, this, pRasterizerState);
+}
+
+ezGALSamplerState* ezGALDeviceNull::CreateSamplerStatePlatform(const ezGALSamplerStateCreationDescription& Description)
+{
+  return CreateNullObject<ezGALSamplerStateNull, ezGALSamplerState>(&m_Allocator, this, Description);
+}
+
+void ezGALDeviceNull::DestroySamplerStatePlatform(ezGALSamplerState* pSamplerState)
+{
+  DestroyNullObject<ezGALSamplerStateNull>(&m_Allocator, this, pSamplerState);
+}
+
+
+// Resource creation functions
+
+ezGALShader* ezGALDeviceNull::CreateShaderPlatform(const ezGALShaderCreationDescription& Description)
+{
+  return CreateNullObject<ezGALShaderNull, ezGALShader>(&m_Allocator, this, Description);
+}
+
+void ezGALDeviceNull::DestroyShaderPlatform(ezGALShader* pShader)
+{
+  DestroyNullObject<ezGALShaderNull>(&m_Allocator, this, pShader);
+}
+
+ezGALBuffer* ezGALDeviceNull::CreateBufferPlatform(const ezGALBufferCreationDescription& Description, ezArrayPtr<const ezUInt8> pInitialData)
+{
+  ezGALBufferNull* pBuffer = EZ_NEW(&m_Allocator, ezGALBufferNull, Description);
+
+  if (pBuffer->InitPlatform(this, pInitialData).Failed())
+  {
+    EZ_DELETE(&m_Allocator, pBuffer);
+    return nullptr;
+  }
+
+  return pBuffer;
+}
+
+void ezGALDeviceNull::DestroyBufferPlatform(ezGALBuffer* pBuffer)
+{
+  DestroyNullObject<ezGALBufferNull>(&m_Allocator, this, pBuffer);
+}
+
+ezGALTexture* ezGALDeviceNull::CreateTexturePlatform(
+  const ezGALTextureCreationDescription& Description, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData)
+{
+  ezGALTextureNull* pTexture = EZ_NEW(&m_Allocator, ezGALTextureNull, Description);
+
+  if (pTexture->InitPlatform(this, pInitialData).Failed())
+  {
+    EZ_DELETE(&m_Allocator, pTexture);
+    return nullptr;
+  }
+
+  return pTexture;
+}
+
+void ezGALDeviceNull::DestroyTexturePlatform(ezGALTexture* pTexture)
+{
+  DestroyNullObject<ezGALTextureNull>(&m_Allocator, this, pTexture);
+}
+
+ezGALResourceView* ezGALDeviceNull::CreateResourceViewPlatform(ezGALResourceBase* pResource, const ezGALResourceViewCreationDescription& Description)
+{
+  return CreateNullObject<ezGALResourceViewNull, ezGALResourceView>(&m_Allocator, this, pResource, Description);
+}
+
+void ezGALDeviceNull::DestroyResourceViewPlatform(ezGALResourceView* pResourceView)
+{
+  DestroyNullObject<ezGALResourceViewNull>(&m_Allocator, this, pResourceView);
+}
+
+ezGALRenderTargetView* ezGALDeviceNull::CreateRenderTargetViewPlatform(ezGALTexture* pTexture, const ezGALRenderTargetViewCreationDescription& Description)
+{
+  return CreateNullObject<ezGALRenderTargetViewNull, ezGALRenderTargetView>(&m_Allocator, this, pTexture, Description);
+}
+
+void ezGALDeviceNull::DestroyRenderTargetViewPlatform(ezGALRenderTargetView* pRenderTargetView)
+{
+  DestroyNullObject<ezGALRenderTargetViewNull>(&m_Allocator, this, pRenderTargetView);
+}
+
+ezGALUnorderedAccessView* ezGALDeviceNull::CreateUnorderedAccessViewPlatform(
+  ezGALResourceBase* pResource, const ezGALUnorderedAccessViewCreationDescription& Description)
+{
+  return CreateNullObject<ezGALUnorderedAccessViewNull, ezGALUnorderedAccessView>(&m_Allocator, this, pResource, Description);
+}
+
+void ezGALDeviceNull::DestroyUnorderedAccessViewPlatform(ezGALUnorderedAccessView* pUnorderedAccessView)
+{
+  DestroyNullObject<ezGALUnorderedAccessViewNull>(&m_Allocator, this, pUnorderedAccessView);
+}
+
+
+
+// Other rendering creation functions
+
+ezGALSwapChain* ezGALDeviceNull::CreateSwapChainPlatform(const ezGALSwapChainCreationDescription& Description)
+{
+  return CreateNullObject<ezGALSwapChainNull, ezGALSwapChain>(&m_Allocator, this, Description);
+}
+
+void ezGALDeviceNull::DestroySwapChainPlatform(ezGALSwapChain* pSwapChain)
+{
+  DestroyNullObject<ezGALSwapChainNull>(&m_Allocator, this, pSwapChain);
+}
+
+ezGALFence* ezGALDeviceNull::CreateFencePlatform()
+{
+  return CreateNullObject<ezGALFenceNull, ezGALFence>(&m_Allocator, this);
+}
+
+void ezGALDeviceNull::DestroyFencePlatform(ezGALFence* pFence)
+{
+  DestroyNullObject<ezGALFenceNull>(&m_Allocator, this, pFence);
+}
+
+ezGALQuery* ezGALDeviceNull::CreateQueryPlatform(const ezGALQueryCreationDescription& Description)
+{
+  return CreateNullObject<ezGALQueryNull, ezGALQuery>(&m_Allocator, this, Description);
+}
+
+void ezGALDeviceNull::DestroyQueryPlatform(ezGALQuery* pQuery)
+{
+  DestroyNullObject<ezGALQueryNull>(&m_Allocator, this, pQuery);
+}
+
+ezGALVertexDeclaration* ezGALDeviceNull::CreateVertexDeclarationPlatform(const ezGALVertexDeclarationCreationDescription& Description)
+{
+  return CreateNullObject<ezGALVertexDeclarationNull, ezGALVertexDeclaration>(&m_Allocator, this, Description);
+}
+
+void ezGALDeviceNull::DestroyVertexDeclarationPlatform(ezGALVertexDeclaration* pVertexDeclaration)
+{
+  DestroyNullObject<ezGALVertexDeclarationNull>(&m_Allocator, this, pVertexDeclaration);
+}
+
+// Timestamp functions
+
+ezGALTimestampHandle ezGALDeviceNull::GetTimestampPlatform()
+{
+  ezUInt32 uiIndex = m_uiNextTimestamp;
+  m_uiNextTimestamp = (m_uiNextTimestamp + 1) % m_Timestamps.GetCount();
+  return {uiIndex, m_uiFrameCounter};
+}
+
+ezResult ezGALDeviceNull::GetTimestampResultPlatform(ezGALTimestampHandle hTimestamp, ezTime& result)
+{
+  // the 'GPU' executes everything immediately, so the timestamps are the CPU times at which they were inserted
+  result = m_Timestamps[static_cast<ezUInt32>(hTimestamp.m_uiIndex)];
+  return EZ_SUCCESS;
+}
+
+// Swap chain functions
+
+void ezGALDeviceNull::PresentPlatform(ezGALSwapChain* pSwapChain, bool bVSync) {}
+
+// Misc functions
+
+void ezGALDeviceNull::BeginFramePlatform()
+{
+  GetNullContext()->ClearRecordedCommands();
+}
+
+void ezGALDeviceNull::EndFramePlatform()
+{
+  m_LastFrameStatistics = GetNullContext()->GetStatistics();
+  GetNullContext()->ResetStatistics();
+
+  ++m_uiFrameCounter;
+}
+
+void ezGALDeviceNull::SetPrimarySwapChainPlatform(ezGALSwapChain* pSwapChain) {}
+
+void ezGALDeviceNull::FillCapabilitiesPlatform()
+{
+  m_Capabilities.m_sAdapterName = "Null Device";
+  m_Capabilities.m_bHardwareAccelerated = true; // not true, but nothing is slowed down by a software rasterizer either
+
+  // mirrors the capabilities of a D3D_FEATURE_LEVEL_11_1 device, so that the renderer takes the same code paths
+  m_Capabilities.m_bMultithreadedResourceCreation = true;
+  m_Capabilities.m_bNoOverwriteBufferUpdate = true;
+  m_Capabilities.m_bB5G6R5Textures = true;
+
+  for (ezUInt32 stage = 0; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
+  {
+    m_Capabilities.m_bShaderStageSupported[stage] = true;
+  }
+
+  m_Capabilities.m_bInstancing = true;
+  m_Capabilities.m_b32BitIndices = true;
+  m_Capabilities.m_bIndirectDraw = true;
+  m_Capabilities.m_bStreamOut = true;
+  m_Capabilities.m_bConservativeRasterization = true;
+  m_Capabilities.m_uiMaxConstantBuffers = EZ_GAL_MAX_CONSTANT_BUFFER_COUNT;
+  m_Capabilities.m_bTextureArrays = true;
+  m_Capabilities.m_bCubemapArrays = true;
+  m_Capabilities.m_uiMaxTextureDimension = 16384;
+  m_Capabilities.m_uiMaxCubemapDimension = 16384;
+  m_Capabilities.m_uiMax3DTextureDimension = 2048;
+  m_Capabilities.m_uiMaxAnisotropy = 16;
+  m_Capabilities.m_uiMaxRendertargets = EZ_GAL_MAX_RENDERTARGET_COUNT;
+  m_Capabilities.m_uiUAVCount = 64;
+  m_Capabilities.m_bAlphaToCoverage = true;
+}
+
+void ezGALDeviceNull::SetTimestamp(ezGALTimestampHandle hTimestamp, ezTime time)
+{
+  m_Timestamps[static_cast<ezUInt32>(hTimestamp.m_uiIndex)] = time;
+}
+
+
+
+EZ_STATICLINK_FILE(RendererFoundation, RendererFoundation_Device_Implementation_DeviceNull);
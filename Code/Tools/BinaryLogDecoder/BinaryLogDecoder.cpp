@@ -0,0 +1,236 @@
+#include <Foundation/Application/Application.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Logging/BinaryWriter.h>
+#include <Foundation/Logging/ConsoleWriter.h>
+#include <Foundation/Logging/HTMLWriter.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Logging/VisualStudioWriter.h>
+#include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Time/Timestamp.h>
+
+/* ezBinaryLogDecoder command line options:
+
+ezBinaryLogDecoder.exe "path/to/file.ezBinLog" [-out "path/to/file.txt"]
+
+Converts a log that was written with ezLogWriter::Binary back into human readable form.
+
+-out specifies the file to write to. If it ends with '.htm' or '.html', the output is an HTML log,
+otherwise it is a plain text log. The file will be overwritten, if it already exists.
+
+If no -out is specified, the text is written to the console.
+
+Every line starts with the time of the message and the index of the thread that logged it.
+Threads are numbered in the order in which they first logged something.
+
+*/
+
+class ezBinaryLogDecoder : public ezApplication
+{
+public:
+  typedef ezApplication SUPER;
+
+  ezString m_sInput;
+  ezString m_sOutput;
+
+  ezBinaryLogDecoder()
+    : ezApplication("BinaryLogDecoder")
+  {
+  }
+
+  ezResult ParseArguments()
+  {
+    if (GetArgumentCount() <= 1)
+    {
+      ezLog::Error("No arguments given");
+      return EZ_FAILURE;
+    }
+
+    ezCommandLineUtils& cmd = *ezCommandLineUtils::GetGlobalInstance();
+
+    m_sInput = ezOSFile::MakePathAbsoluteWithCWD(GetArgument(1));
+
+    if (!ezOSFile::ExistsFile(m_sInput))
+    {
+      ezLog::Error("Input file does not exist: '{}'", m_sInput);
+      return EZ_FAILURE;
+    }
+
+    m_sOutput = cmd.GetStringOption("-out");
+
+    if (!m_sOutput.IsEmpty())
+    {
+      m_sOutput = ezOSFile::MakePathAbsoluteWithCWD(m_sOutput);
+    }
+
+    return EZ_SUCCESS;
+  }
+
+  virtual void AfterCoreSystemsStartup() override
+  {
+    // Add the empty data directory to access files via absolute paths
+    ezFileSystem::AddDataDirectory("", "App", ":", ezFileSystem::AllowWrites);
+
+    ezGlobalLog::AddLogWriter(ezLogWriter::Console::LogMessageHandler);
+    ezGlobalLog::AddLogWriter(ezLogWriter::VisualStudio::LogMessageHandler);
+  }
+
+  virtual void BeforeCoreSystemsShutdown() override
+  {
+    // prevent further output during shutdown
+    ezGlobalLog::RemoveLogWriter(ezLogWriter::Console::LogMessageHandler);
+    ezGlobalLog::RemoveLogWriter(ezLogWriter::VisualStudio::LogMessageHandler);
+
+    SUPER::BeforeCoreSystemsShutdown();
+  }
+
+  static void FormatPrefix(const ezBinaryLogReader::Entry& entry, ezStringBuilder& out_sPrefix)
+  {
+    out_sPrefix.Format("[{}] [T{}] ", ezArgDateTime(ezDateTime(entry.m_Timestamp), ezArgDateTime::ShowDate | ezArgDateTime::ShowMilliseconds),
+      entry.m_uiThreadIndex);
+  }
+
+  static void FormatLine(const ezBinaryLogReader::Entry& entry, ezStringBuilder& out_sLine)
+  {
+    FormatPrefix(entry, out_sLine);
+
+    for (ezUInt32 i = 0; i < entry.m_uiIndentation; ++i)
+      out_sLine.Append(" ");
+
+    switch (entry.m_EventType)
+    {
+      case ezLogMsgType::BeginGroup:
+        out_sLine.AppendFormat("+++++ {} ({}) +++++", entry.m_sText, entry.m_sTag);
+        return;
+      case ezLogMsgType::EndGroup:
+        out_sLine.AppendFormat("----- {} ({} sec) -----", entry.m_sText, ezArgF(entry.m_fSeconds, 6));
+        return;
+      case ezLogMsgType::ErrorMsg:
+        out_sLine.Append("Error: ");
+        break;
+      case ezLogMsgType::SeriousWarningMsg:
+        out_sLine.Append("Seriously: ");
+        break;
+      case ezLogMsgType::WarningMsg:
+        out_sLine.Append("Warning: ");
+        break;
+      default:
+        break;
+    }
+
+    if (!entry.m_sTag.IsEmpty())
+    {
+      out_sLine.AppendFormat("[{}]", entry.m_sTag);
+    }
+
+    out_sLine.Append(entry.m_sText.GetView());
+  }
+
+  ezResult Decode()
+  {
+    ezFileReader file;
+    if (file.Open(m_sInput).Failed())
+    {
+      ezLog::Error("Failed to open '{}'", m_sInput);
+      return EZ_FAILURE;
+    }
+
+    ezBinaryLogReader reader;
+    if (reader.Open(file).Failed())
+    {
+      ezLog::Error("'{}' is not a binary log or was written with an unsupported version", m_sInput);
+      return EZ_FAILURE;
+    }
+
+    const ezStringView sExt = ezPathUtils::GetFileExtension(m_sOutput);
+    const bool bHtml = sExt.IsEqual_NoCase("htm") || sExt.IsEqual_NoCase("html");
+
+    ezLogWriter::HTML html;
+    ezFileWriter text;
+
+    if (bHtml)
+    {
+      ezStringBuilder sTitle = ezPathUtils::GetFileName(m_sInput);
+      html.BeginLog(m_sOutput, sTitle);
+      html.SetTimestampMode(ezLog::TimestampMode::None);
+    }
+    else if (!m_sOutput.IsEmpty() && text.Open(m_sOutput).Failed())
+    {
+      ezLog::Error("Failed to open '{}' for writing", m_sOutput);
+      return EZ_FAILURE;
+    }
+
+    ezUInt32 uiEntries = 0;
+    ezBinaryLogReader::Entry entry;
+    ezStringBuilder sLine;
+
+    while (reader.ReadEntry(entry))
+    {
+      ++uiEntries;
+
+      if (bHtml || m_sOutput.IsEmpty())
+      {
+        // the HTML and the console writer format groups and message types themselves, only prefix the text of messages with the original
+        // time and thread
+        if (entry.m_EventType != ezLogMsgType::BeginGroup && entry.m_EventType != ezLogMsgType::EndGroup)
+        {
+          FormatPrefix(entry, sLine);
+          sLine.Append(entry.m_sText.GetView());
+          entry.m_sText = sLine;
+        }
+
+        ezLoggingEventData le;
+        entry.GetEventData(le);
+
+        if (bHtml)
+        {
+          html.LogMessageHandler(le);
+        }
+        else
+        {
+          // written directly, so that decoded errors don't count as errors of this application
+          ezLogWriter::Console::LogMessageHandler(le);
+        }
+      }
+      else
+      {
+        FormatLine(entry, sLine);
+        sLine.Append("\n");
+        text.WriteBytes(sLine.GetData(), sLine.GetElementCount()).IgnoreResult();
+      }
+    }
+
+    if (bHtml)
+    {
+      html.EndLog();
+    }
+
+    if (!m_sOutput.IsEmpty())
+    {
+      ezLog::Info("Decoded {} log entries into '{}'", uiEntries, m_sOutput);
+    }
+
+    return EZ_SUCCESS;
+  }
+
+  virtual ApplicationExecution Run() override
+  {
+    if (ParseArguments().Failed())
+    {
+      SetReturnCode(1);
+      return ezApplication::Quit;
+    }
+
+    if (Decode().Failed())
+    {
+      ezLog::Error("Decoding the log failed");
+      SetReturnCode(2);
+    }
+
+    return ezApplication::Quit;
+  }
+};
+
+EZ_CONSOLEAPP_ENTRY_POINT(ezBinaryLogDecoder);
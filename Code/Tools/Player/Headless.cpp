@@ -0,0 +1,246 @@
+#include "Main.h"
+
+#include <Core/Collection/CollectionResource.h>
+#include <Core/ResourceManager/ResourceManager.h>
+#include <Core/World/World.h>
+#include <Foundation/IO/JSONWriter.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/ThreadUtils.h>
+#include <Foundation/Time/Clock.h>
+#include <Foundation/Time/TimeStatistics.h>
+
+/* Headless mode of the player:
+
+Player -scene "path/to/scene.ezObjectGraph" -headless [-frames 1000] [-warmup 10] [-timestep 0.0166667] [-seed 1]
+       [-collection "path/to/collection"] [-out "path/to/results.json"]
+
+Loads the scene and simulates it through ezWorld::Update() without a window and without rendering, with a fixed time step.
+Afterwards the application quits. The graphics device is an ezGALDeviceNull, so no GPU is needed either.
+
+-frames:     The number of frames that are measured.
+-warmup:     The number of frames that are simulated before measuring, e.g. to let components finish their initialization.
+-timestep:   The simulated time per frame in seconds.
+-seed:       The seed for the random number generator of the world, so that runs are reproducible.
+-collection: A collection asset whose resources are loaded before the simulation starts, so that resource loading doesn't
+             distort the measurements.
+-out:        The JSON file to write the results to. Without it, the results are only logged.
+
+The results contain statistics about the whole ezWorld::Update() and about each of its phases, as recorded by ezProfilingSystem.
+The phases are only available in builds with EZ_USE_PROFILING enabled.
+
+*/
+
+namespace
+{
+  // The scopes that ezWorld::Update() records for its phases.
+  const char* s_szPhaseScopes[] = {
+    "Pre-Async Phase",
+    "Async Phase",
+    "Post-Async Phase",
+    "Update Transforms",
+    "Post-Transform Phase",
+  };
+
+  constexpr ezUInt32 s_uiNumPhases = EZ_ARRAY_SIZE(s_szPhaseScopes);
+} // namespace
+
+void ezPlayerApplication::PreloadCollection()
+{
+  if (m_sHeadlessCollection.IsEmpty())
+    return;
+
+  EZ_LOG_BLOCK("PreloadCollection", m_sHeadlessCollection.GetData());
+
+  ezCollectionResourceHandle hCollection = ezResourceManager::LoadResource<ezCollectionResource>(m_sHeadlessCollection.GetData());
+
+  {
+    ezResourceLock<ezCollectionResource> pCollection(hCollection, ezResourceAcquireMode::BlockTillLoaded_NeverFail);
+
+    if (pCollection.GetAcquireResult() != ezResourceAcquireResult::Final)
+    {
+      ezLog::Error("Could not load collection '{0}'", m_sHeadlessCollection);
+      return;
+    }
+
+    pCollection->PreloadResources();
+  }
+
+  while (true)
+  {
+    {
+      ezResourceLock<ezCollectionResource> pCollection(hCollection, ezResourceAcquireMode::BlockTillLoaded_NeverFail);
+      if (pCollection->IsLoadingFinished())
+        break;
+    }
+
+    ezResourceManager::PerFrameUpdate();
+    ezThreadUtils::Sleep(ezTime::Milliseconds(10));
+  }
+}
+
+void ezPlayerApplication::RunHeadlessBenchmark()
+{
+  if (m_pWorld == nullptr)
+  {
+    SetReturnCode(1);
+    return;
+  }
+
+  PreloadCollection();
+
+  ezClock::GetGlobalClock()->SetFixedTimeStep(m_HeadlessTimeStep);
+
+  {
+    EZ_LOCK(m_pWorld->GetWriteMarker());
+    m_pWorld->GetClock().SetFixedTimeStep(m_HeadlessTimeStep);
+  }
+
+  // short phases are important as well
+  const ezTime oldDiscardThreshold = ezProfilingSystem::GetDiscardThreshold();
+  ezProfilingSystem::SetDiscardThreshold(ezTime::Zero());
+
+  // index 0 is the whole world update, the others are the phases
+  ezHybridArray<ezString, s_uiNumPhases + 1> phaseNames;
+  phaseNames.PushBack("World Update");
+  for (const char* szPhase : s_szPhaseScopes)
+  {
+    phaseNames.PushBack(szPhase);
+  }
+
+  ezHybridArray<ezDynamicArray<ezTime>, s_uiNumPhases + 1> phaseTimes;
+  phaseTimes.SetCount(phaseNames.GetCount());
+
+  for (auto& times : phaseTimes)
+  {
+    times.Reserve(m_uiHeadlessFrames);
+  }
+
+  ezProfilingSystem::ProfilingData profilingData;
+
+  const ezUInt32 uiTotalFrames = m_uiHeadlessWarmupFrames + m_uiHeadlessFrames;
+  for (ezUInt32 uiFrame = 0; uiFrame < uiTotalFrames; ++uiFrame)
+  {
+    const bool bMeasure = uiFrame >= m_uiHeadlessWarmupFrames;
+
+    ezTime updateTime;
+    {
+      EZ_LOCK(m_pWorld->GetWriteMarker());
+
+      const ezTime tStart = ezTime::Now();
+      m_pWorld->Update();
+      updateTime = ezTime::Now() - tStart;
+    }
+
+    Run_UpdatePlugins();
+
+    ezClock::GetGlobalClock()->Update();
+    ezGameApplicationBase::Run_FinishFrame();
+
+    // fetching the scopes after every frame keeps the profiling buffers from overflowing during long runs
+    ezProfilingSystem::Capture(profilingData, true);
+
+    if (!bMeasure)
+      continue;
+
+    phaseTimes[0].PushBack(updateTime);
+
+    ezTime phaseDurations[s_uiNumPhases];
+    for (const auto& eventBuffer : profilingData.m_AllEventBuffers)
+    {
+      for (const auto& scope : eventBuffer.m_Data)
+      {
+        for (ezUInt32 uiPhase = 0; uiPhase < s_uiNumPhases; ++uiPhase)
+        {
+          if (ezStringUtils::IsEqual(scope.m_szName, s_szPhaseScopes[uiPhase]))
+          {
+            phaseDurations[uiPhase] += scope.m_EndTime - scope.m_BeginTime;
+            break;
+          }
+        }
+      }
+    }
+
+    for (ezUInt32 uiPhase = 0; uiPhase < s_uiNumPhases; ++uiPhase)
+    {
+      phaseTimes[uiPhase + 1].PushBack(phaseDurations[uiPhase]);
+    }
+  }
+
+  ezClock::GetGlobalClock()->SetFixedTimeStep();
+  ezProfilingSystem::SetDiscardThreshold(oldDiscardThreshold);
+
+  for (ezUInt32 i = 0; i < phaseNames.GetCount(); ++i)
+  {
+    ezTimeStatistics stats;
+    stats.Compute(phaseTimes[i]);
+    ezLog::Info("{0}: mean {1} ms, median {2} ms, p95 {3} ms, max {4} ms", phaseNames[i], ezArgF(stats.m_fMean, 4), ezArgF(stats.m_fMedian, 4),
+      ezArgF(stats.m_fPercentile95, 4), ezArgF(stats.m_fMax, 4));
+  }
+
+  if (!m_sHeadlessOutput.IsEmpty() && WriteHeadlessResults(phaseNames, phaseTimes).Failed())
+  {
+    ezLog::Error("Failed to write the results to '{0}'", m_sHeadlessOutput);
+    SetReturnCode(2);
+  }
+}
+
+ezResult ezPlayerApplication::WriteHeadlessResults(ezArrayPtr<const ezString> phaseNames, ezArrayPtr<const ezDynamicArray<ezTime>> phaseTimes) const
+{
+  ezMemoryStreamStorage storage;
+
+  {
+    ezMemoryStreamWriter writer(&storage);
+
+    ezStandardJSONWriter js;
+    js.SetOutputStream(&writer);
+
+    js.BeginObject();
+    {
+      js.AddVariableString("m_sScene", m_sSceneFile.GetData());
+      js.AddVariableString("m_sCollection", m_sHeadlessCollection.GetData());
+      js.AddVariableUInt32("m_uiFrames", m_uiHeadlessFrames);
+      js.AddVariableUInt32("m_uiWarmupFrames", m_uiHeadlessWarmupFrames);
+      js.AddVariableDouble("m_fTimeStep", m_HeadlessTimeStep.GetSeconds());
+      js.AddVariableUInt64("m_uiSeed", m_uiHeadlessSeed);
+
+      // all times are in milliseconds
+      js.BeginArray("phases");
+      for (ezUInt32 i = 0; i < phaseNames.GetCount(); ++i)
+      {
+        ezTimeStatistics stats;
+        stats.Compute(phaseTimes[i]);
+
+        js.BeginObject();
+        {
+          js.AddVariableString("m_sName", phaseNames[i].GetData());
+          js.AddVariableDouble("m_fMean", stats.m_fMean);
+          js.AddVariableDouble("m_fMedian", stats.m_fMedian);
+          js.AddVariableDouble("m_fPercentile95", stats.m_fPercentile95);
+          js.AddVariableDouble("m_fMin", stats.m_fMin);
+          js.AddVariableDouble("m_fMax", stats.m_fMax);
+
+          js.BeginArray("m_Frames");
+          for (const ezTime& time : phaseTimes[i])
+          {
+            js.WriteDouble(time.GetMilliseconds());
+          }
+          js.EndArray();
+        }
+        js.EndObject();
+      }
+      js.EndArray();
+    }
+    js.EndObject();
+  }
+
+  ezOSFile file;
+  EZ_SUCCEED_OR_RETURN(file.Open(ezOSFile::MakePathAbsoluteWithCWD(m_sHeadlessOutput).GetData(), ezFileOpenMode::Write));
+  EZ_SUCCEED_OR_RETURN(file.Write(storage.GetData(), storage.GetStorageSize()));
+
+  ezLog::Success("Wrote the results to '{0}'", m_sHeadlessOutput);
+  return EZ_SUCCESS;
+}
@@ -13,6 +13,7 @@
 #include <GameEngine/Prefabs/SpawnComponent.h>
 #include <RendererCore/Components/CameraComponent.h>
 #include <RendererCore/Meshes/MeshComponent.h>
+#include <RendererFoundation/Device/DeviceNull.h>
 
 ezPlayerApplication::ezPlayerApplication()
   : ezGameApplication("ezPlayer", nullptr)
@@ -51,6 +52,24 @@ ezResult ezPlayerApplication::BeforeCoreSystemsStartup()
 
   EZ_ASSERT_ALWAYS(!m_sAppProjectPath.IsEmpty(), "No project directory could be found for scene file '{0}'", m_sSceneFile);
 
+  {
+    const ezCommandLineUtils* pCmd = ezCommandLineUtils::GetGlobalInstance();
+
+    m_bHeadless = pCmd->GetBoolOption("-headless");
+    m_uiHeadlessFrames = pCmd->GetUIntOption("-frames", m_uiHeadlessFrames);
+    m_uiHeadlessWarmupFrames = pCmd->GetUIntOption("-warmup", m_uiHeadlessWarmupFrames);
+    m_HeadlessTimeStep = ezTime::Seconds(pCmd->GetFloatOption("-timestep", m_HeadlessTimeStep.GetSeconds()));
+    m_uiHeadlessSeed = pCmd->GetUIntOption("-seed", (ezUInt32)m_uiHeadlessSeed);
+    m_sHeadlessCollection = pCmd->GetStringOption("-collection", 0, "");
+    m_sHeadlessOutput = pCmd->GetStringOption("-out", 0, "");
+  }
+
+  if (m_bHeadless)
+  {
+    // nothing is rendered, so neither a GPU nor a window is needed, which also allows to run on build machines
+    SetOverrideDefaultDeviceCreator([](const ezGALDeviceCreationDescription& desc) -> ezGALDevice* { return EZ_DEFAULT_NEW(ezGALDeviceNull, desc); });
+  }
+
   return EZ_SUCCESS;
 }
 
@@ -63,7 +82,22 @@ void ezPlayerApplication::AfterCoreSystemsStartup()
 
   SetupLevel();
 
-  ActivateGameState(m_pWorld.Borrow());
+  // the game state creates the window and the views, which are not needed without rendering
+  if (!m_bHeadless)
+  {
+    ActivateGameState(m_pWorld.Borrow());
+  }
+}
+
+ezApplication::ApplicationExecution ezPlayerApplication::Run()
+{
+  if (m_bHeadless)
+  {
+    RunHeadlessBenchmark();
+    return ezApplication::Quit;
+  }
+
+  return SUPER::Run();
 }
 
 void ezPlayerApplication::BeforeHighLevelSystemsShutdown()
@@ -81,6 +115,13 @@ void ezPlayerApplication::SetupLevel()
   ezString sSceneFile = sScenePath.GetFileName();
 
   ezWorldDesc desc(sSceneFile);
+
+  if (m_bHeadless)
+  {
+    // the same seed in every run, so that random decisions of the game logic are reproducible
+    desc.m_uiRandomNumberGeneratorSeed = m_uiHeadlessSeed;
+  }
+
   m_pWorld = EZ_DEFAULT_NEW(ezWorld, desc);
 
   EZ_LOCK(m_pWorld->GetWriteMarker());
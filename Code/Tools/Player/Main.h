@@ -19,6 +19,22 @@ private:
 
   virtual void BeforeHighLevelSystemsShutdown() override;
 
+  virtual ezApplication::ApplicationExecution Run() override;
+
+  /// \brief Simulates the world for a fixed number of frames without rendering and writes the timings of the world update phases to a
+  /// JSON file. See Headless.cpp for the command line options.
+  void RunHeadlessBenchmark();
+  void PreloadCollection();
+  ezResult WriteHeadlessResults(ezArrayPtr<const ezString> phaseNames, ezArrayPtr<const ezDynamicArray<ezTime>> phaseTimes) const;
+
   ezString m_sSceneFile;
   ezUniquePtr<ezWorld> m_pWorld;
+
+  bool m_bHeadless = false;
+  ezUInt32 m_uiHeadlessFrames = 1000;
+  ezUInt32 m_uiHeadlessWarmupFrames = 10;
+  ezTime m_HeadlessTimeStep = ezTime::Seconds(1.0 / 60.0);
+  ezUInt64 m_uiHeadlessSeed = 1;
+  ezString m_sHeadlessCollection;
+  ezString m_sHeadlessOutput;
 };
@@ -1,6 +1,8 @@
 #include <FoundationTestPCH.h>
 
 #include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Utilities/ConversionUtils.h>
 
 namespace
 {
@@ -11,6 +13,89 @@ namespace
     // Comparision via operator. Sorting algorithm should prefer Less operator
     bool operator()(ezInt32 a, ezInt32 b) const { return a < b; }
   };
+
+  struct KeyAndIndex
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezInt32 m_iKey;
+    ezUInt32 m_uiIndex;
+  };
+
+  struct KeyAndIndexComparer
+  {
+    EZ_ALWAYS_INLINE bool Less(const KeyAndIndex& a, const KeyAndIndex& b) const { return a.m_iKey < b.m_iKey; }
+  };
+
+  void FillKeyAndIndex(ezDynamicArray<KeyAndIndex>& inout_Data, ezUInt32 uiCount, ezInt32 iMaxKey)
+  {
+    inout_Data.SetCountUninitialized(uiCount);
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      inout_Data[i].m_iKey = (rand() % iMaxKey) - iMaxKey / 2;
+      inout_Data[i].m_uiIndex = i;
+    }
+  }
+
+  // sorted by key and elements with equal keys are still in their original order
+  bool IsSortedAndStable(const ezDynamicArray<KeyAndIndex>& data)
+  {
+    for (ezUInt32 i = 1; i < data.GetCount(); ++i)
+    {
+      if (data[i - 1].m_iKey > data[i].m_iKey)
+        return false;
+
+      if (data[i - 1].m_iKey == data[i].m_iKey && data[i - 1].m_uiIndex > data[i].m_uiIndex)
+        return false;
+    }
+
+    return true;
+  }
+
+  /// Not mem-relocatable, so sorting has to move and destruct it. Comparing an object that was already destructed is detected.
+  struct TrackedKey
+  {
+    TrackedKey(ezInt32 iKey, ezUInt32 uiIndex)
+      : m_iKey(iKey)
+      , m_uiIndex(uiIndex)
+      , m_pThis(this)
+    {
+    }
+
+    TrackedKey(TrackedKey&& other)
+      : m_iKey(other.m_iKey)
+      , m_uiIndex(other.m_uiIndex)
+      , m_pThis(this)
+    {
+    }
+
+    ~TrackedKey() { m_pThis = nullptr; }
+
+    void operator=(TrackedKey&& other)
+    {
+      m_iKey = other.m_iKey;
+      m_uiIndex = other.m_uiIndex;
+    }
+
+    ezInt32 m_iKey;
+    ezUInt32 m_uiIndex;
+    const TrackedKey* volatile m_pThis; // volatile, so the store in the destructor is not optimized away
+  };
+
+  struct TrackedKeyComparer
+  {
+    bool Less(const TrackedKey& a, const TrackedKey& b) const
+    {
+      if (a.m_pThis != &a || b.m_pThis != &b)
+        s_iNumInvalidComparisons.Increment();
+
+      return a.m_iKey < b.m_iKey;
+    }
+
+    static ezAtomicInteger32 s_iNumInvalidComparisons;
+  };
+
+  ezAtomicInteger32 TrackedKeyComparer::s_iNumInvalidComparisons;
 } // namespace
 
 EZ_CREATE_SIMPLE_TEST(Algorithm, Sorting)
@@ -52,4 +137,148 @@ EZ_CREATE_SIMPLE_TEST(Algorithm, Sorting)
       EZ_TEST_BOOL(a2[i - 1] >= a2[i]);
     }
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "RadixSort")
+  {
+    ezDynamicArray<KeyAndIndex> data;
+
+    for (ezUInt32 uiCount : {0u, 1u, 15u, 2000u, 100000u})
+    {
+      FillKeyAndIndex(data, uiCount, 1000);
+      ezSorting::RadixSort(data.GetArrayPtr(), [](const KeyAndIndex& e) { return e.m_iKey; });
+      EZ_TEST_BOOL(IsSortedAndStable(data));
+    }
+
+    ezDynamicArray<ezUInt64> a64;
+    for (ezUInt32 i = 0; i < 5000; ++i)
+    {
+      a64.PushBack((static_cast<ezUInt64>(rand()) << 40) ^ (static_cast<ezUInt64>(rand()) << 20) ^ rand());
+    }
+
+    ezDynamicArray<ezUInt64> a64Expected = a64;
+    a64Expected.Sort();
+
+    ezSorting::RadixSort(a64.GetArrayPtr(), [](ezUInt64 v) { return v; });
+    EZ_TEST_BOOL(a64 == a64Expected);
+
+    ezDynamicArray<float> aFloat;
+    for (ezUInt32 i = 0; i < 5000; ++i)
+    {
+      aFloat.PushBack((rand() % 20000 - 10000) * 0.37f);
+    }
+    aFloat.PushBack(-0.0f);
+    aFloat.PushBack(0.0f);
+
+    ezSorting::RadixSort(aFloat.GetArrayPtr(), [](float f) { return f; });
+
+    for (ezUInt32 i = 1; i < aFloat.GetCount(); ++i)
+    {
+      EZ_TEST_BOOL(aFloat[i - 1] <= aFloat[i]);
+    }
+
+    ezDynamicArray<ezString> aStrings;
+    for (ezUInt32 i = 0; i < 1000; ++i)
+    {
+      ezStringBuilder s;
+      s.Format("{0}", (i * 7919) % 1000);
+      aStrings.PushBack(s);
+    }
+
+    // non-POD elements are relocated through the temporary buffer
+    ezSorting::RadixSort(aStrings.GetArrayPtr(), [](const ezString& s) {
+      ezUInt32 uiValue = 0;
+      ezConversionUtils::StringToUInt(s.GetData(), uiValue).IgnoreResult();
+      return uiValue;
+    });
+
+    for (ezUInt32 i = 0; i < aStrings.GetCount(); ++i)
+    {
+      ezStringBuilder s;
+      s.Format("{0}", i);
+      EZ_TEST_STRING(aStrings[i], s);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "MergeSort")
+  {
+    ezDynamicArray<KeyAndIndex> data;
+
+    for (ezUInt32 uiCount : {0u, 1u, 15u, 17u, 2000u, 100000u})
+    {
+      FillKeyAndIndex(data, uiCount, 1000);
+      ezSorting::MergeSort(data.GetArrayPtr(), KeyAndIndexComparer());
+      EZ_TEST_BOOL(IsSortedAndStable(data));
+    }
+
+    ezDynamicArray<ezInt32> a2 = a1;
+    ezSorting::MergeSort(a2.GetArrayPtr(), CustomComparer());
+
+    for (ezUInt32 i = 1; i < a2.GetCount(); ++i)
+    {
+      EZ_TEST_BOOL(a2[i - 1] >= a2[i]);
+    }
+
+    a2 = a1;
+    ezSorting::MergeSort(a2.GetArrayPtr());
+
+    for (ezUInt32 i = 1; i < a2.GetCount(); ++i)
+    {
+      EZ_TEST_BOOL(a2[i - 1] <= a2[i]);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ParallelRadixSort / ParallelMergeSort")
+  {
+    ezDynamicArray<KeyAndIndex> data;
+
+    for (ezUInt32 uiCount : {1000u, 100000u, 1000000u})
+    {
+      FillKeyAndIndex(data, uiCount, 5000);
+      ezSorting::ParallelRadixSort(data.GetArrayPtr(), [](const KeyAndIndex& e) { return e.m_iKey; });
+      EZ_TEST_BOOL(IsSortedAndStable(data));
+
+      FillKeyAndIndex(data, uiCount, 5000);
+      ezSorting::ParallelMergeSort(data.GetArrayPtr(), KeyAndIndexComparer());
+      EZ_TEST_BOOL(IsSortedAndStable(data));
+
+      // already sorted input
+      ezSorting::ParallelMergeSort(data.GetArrayPtr(), KeyAndIndexComparer());
+      EZ_TEST_BOOL(IsSortedAndStable(data));
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ParallelMergeSort - Not Mem-Relocatable")
+  {
+    static_assert(ezGetTypeClass<TrackedKey>::value == ezTypeIsClass::value);
+
+    // enough workers to split every merge into several chunks
+    const ezUInt32 uiPrevShortWorkers = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks);
+    const ezUInt32 uiPrevLongWorkers = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::LongTasks);
+    ezTaskSystem::SetWorkerThreadCount(8, uiPrevLongWorkers);
+
+    ezDynamicArray<TrackedKey> data;
+    data.Reserve(100000);
+
+    for (ezUInt32 i = 0; i < 100000; ++i)
+    {
+      data.PushBack(TrackedKey((rand() % 5000) - 2500, i));
+    }
+
+    TrackedKeyComparer::s_iNumInvalidComparisons = 0;
+    ezSorting::ParallelMergeSort(data.GetArrayPtr(), TrackedKeyComparer());
+    EZ_TEST_INT(TrackedKeyComparer::s_iNumInvalidComparisons, 0);
+
+    ezTaskSystem::SetWorkerThreadCount(uiPrevShortWorkers, uiPrevLongWorkers);
+
+    bool bValid = data[0].m_pThis == &data[0];
+    bool bSortedAndStable = true;
+    for (ezUInt32 i = 1; i < data.GetCount(); ++i)
+    {
+      bValid &= data[i].m_pThis == &data[i];
+      bSortedAndStable &= data[i - 1].m_iKey < data[i].m_iKey || (data[i - 1].m_iKey == data[i].m_iKey && data[i - 1].m_uiIndex < data[i].m_uiIndex);
+    }
+
+    EZ_TEST_BOOL(bValid);
+    EZ_TEST_BOOL(bSortedAndStable);
+  }
 }
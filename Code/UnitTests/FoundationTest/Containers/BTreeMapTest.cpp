@@ -0,0 +1,461 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Containers/BTreeMap.h>
+#include <Foundation/Containers/Map.h>
+#include <Foundation/Strings/String.h>
+#include <algorithm>
+#include <iterator>
+
+EZ_CREATE_SIMPLE_TEST(Containers, BTreeMap)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Iterator")
+  {
+    ezBTreeMap<ezUInt32, ezUInt32> m;
+    for (ezUInt32 i = 0; i < 1000; ++i)
+      m[i] = i + 1;
+
+    auto itfound = std::find_if(begin(m), end(m), [](ezBTreeMap<ezUInt32, ezUInt32>::ConstIterator val) { return val.Value() == 500; });
+    EZ_TEST_INT(itfound.Key(), 499);
+
+    ezUInt32 prev = begin(m).Key();
+    for (auto it : m)
+    {
+      EZ_TEST_BOOL(it.Value() >= prev);
+      prev = it.Value();
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "IsEmpty / GetCount / Clear")
+  {
+    ezBTreeMap<ezUInt32, ezUInt32> m;
+    EZ_TEST_BOOL(m.IsEmpty());
+    EZ_TEST_INT(m.GetCount(), 0);
+
+    m[1] = 2;
+    EZ_TEST_BOOL(!m.IsEmpty());
+    EZ_TEST_INT(m.GetCount(), 1);
+
+    m[2] = 3;
+    m[1] = 4;
+    EZ_TEST_INT(m.GetCount(), 2);
+
+    m.Clear();
+    EZ_TEST_BOOL(m.IsEmpty());
+    EZ_TEST_INT(m.GetCount(), 0);
+    EZ_TEST_BOOL(m.GetHeapMemoryUsage() == 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Clear")
+  {
+    EZ_TEST_BOOL(ezConstructionCounter::HasAllDestructed());
+
+    {
+      ezBTreeMap<ezConstructionCounter, ezConstructionCounter> m1;
+      for (ezInt32 i = 0; i < 1000; ++i)
+        m1[ezConstructionCounter(i)] = ezConstructionCounter(i * 2);
+
+      for (ezInt32 i = 0; i < 1000; i += 3)
+        m1.Remove(ezConstructionCounter(i));
+
+      m1.Clear();
+      EZ_TEST_BOOL(ezConstructionCounter::HasAllDestructed());
+
+      for (ezInt32 i = 0; i < 100; ++i)
+        m1[ezConstructionCounter(i)] = ezConstructionCounter(i * 2);
+    }
+
+    EZ_TEST_BOOL(ezConstructionCounter::HasAllDestructed());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Insert")
+  {
+    ezBTreeMap<ezUInt32, ezUInt32> m;
+
+    EZ_TEST_BOOL(m.GetHeapMemoryUsage() == 0);
+
+    EZ_TEST_BOOL(m.Insert(1, 10).IsValid());
+    EZ_TEST_BOOL(m.Insert(1, 10).IsValid());
+    m.Insert(3, 30);
+    m.Insert(7, 70);
+    m.Insert(9, 90);
+    m.Insert(4, 40);
+    m.Insert(2, 20);
+    m.Insert(8, 80);
+    m.Insert(5, 50);
+    m.Insert(6, 60);
+
+    EZ_TEST_BOOL(m.Insert(7, 71).Value() == 71);
+    EZ_TEST_BOOL(m.Insert(7, 70) == m.Find(7));
+
+    EZ_TEST_BOOL(m.GetHeapMemoryUsage() >= sizeof(ezUInt32) * 2 * 9);
+
+    EZ_TEST_INT(m[1], 10);
+    EZ_TEST_INT(m[2], 20);
+    EZ_TEST_INT(m[3], 30);
+    EZ_TEST_INT(m[4], 40);
+    EZ_TEST_INT(m[5], 50);
+    EZ_TEST_INT(m[6], 60);
+    EZ_TEST_INT(m[7], 70);
+    EZ_TEST_INT(m[8], 80);
+    EZ_TEST_INT(m[9], 90);
+
+    EZ_TEST_INT(m.GetCount(), 9);
+
+    for (ezUInt32 i = 0; i < 1000000; ++i)
+      m[i] = i;
+
+    EZ_TEST_INT(m.GetCount(), 1000000);
+    EZ_TEST_BOOL(m.GetHeapMemoryUsage() >= sizeof(ezUInt32) * 2 * 1000000);
+
+    for (ezUInt32 i = 0; i < 1000000; i += 997)
+      EZ_TEST_INT(m[i], i);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Insert (reverse and interleaved)")
+  {
+    ezBTreeMap<ezInt32, ezInt32> m;
+
+    for (ezInt32 i = 10000; i > 0; --i)
+      m[i * 2] = i;
+
+    for (ezInt32 i = 0; i < 10000; ++i)
+      m[i * 2 + 1] = -i;
+
+    EZ_TEST_INT(m.GetCount(), 20000);
+
+    ezInt32 iExpected = 1;
+    for (auto it : m)
+    {
+      EZ_TEST_INT(it.Key(), iExpected);
+      ++iExpected;
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Find / Contains / GetValue")
+  {
+    ezBTreeMap<ezUInt32, ezUInt32> m;
+
+    for (ezInt32 i = 0; i < 1000; i += 2)
+      m[i] = i * 10;
+
+    const ezBTreeMap<ezUInt32, ezUInt32>& mConst = m;
+
+    for (ezInt32 i = 0; i < 1000; i += 2)
+    {
+      EZ_TEST_INT(m.Find(i).Value(), i * 10);
+      EZ_TEST_INT(mConst.Find(i).Value(), i * 10);
+      EZ_TEST_BOOL(!m.Find(i + 1).IsValid());
+
+      EZ_TEST_BOOL(m.Contains(i));
+      EZ_TEST_BOOL(!m.Contains(i + 1));
+
+      EZ_TEST_INT(*m.GetValue(i), i * 10);
+      EZ_TEST_INT(*mConst.GetValue(i), i * 10);
+      EZ_TEST_BOOL(m.GetValue(i + 1) == nullptr);
+
+      EZ_TEST_INT(m.GetValueOrDefault(i, 999), i * 10);
+      EZ_TEST_INT(m.GetValueOrDefault(i + 1, 999), 999);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindOrAdd")
+  {
+    ezBTreeMap<ezUInt32, ezUInt32> m;
+
+    for (ezInt32 i = 0; i < 1000; ++i)
+    {
+      bool bExisted = true;
+      m.FindOrAdd(i, &bExisted).Value() = i * 10;
+      EZ_TEST_BOOL(!bExisted);
+    }
+
+    for (ezInt32 i = 1000 - 1; i >= 0; --i)
+    {
+      bool bExisted = false;
+      EZ_TEST_INT(m.FindOrAdd(i, &bExisted).Value(), i * 10);
+      EZ_TEST_BOOL(bExisted);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Remove (non-existing)")
+  {
+    ezBTreeMap<ezUInt32, ezUInt32> m;
+
+    for (ezInt32 i = 0; i < 1000; ++i)
+    {
+      EZ_TEST_BOOL(!m.Remove(i));
+    }
+
+    for (ezInt32 i = 0; i < 1000; ++i)
+      m[i] = i * 10;
+
+    for (ezInt32 i = 0; i < 1000; ++i)
+    {
+      EZ_TEST_BOOL(m.Remove(i + 500) == (i < 500));
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Remove (Iterator)")
+  {
+    ezBTreeMap<ezUInt32, ezUInt32> m;
+
+    for (ezInt32 i = 0; i < 1000; ++i)
+      m[i] = i * 10;
+
+    for (ezInt32 i = 0; i < 1000 - 1; ++i)
+    {
+      ezBTreeMap<ezUInt32, ezUInt32>::Iterator itNext = m.Remove(m.Find(i));
+      EZ_TEST_BOOL(!m.Find(i).IsValid());
+      EZ_TEST_BOOL(itNext.Key() == i + 1);
+
+      EZ_TEST_INT(m.GetCount(), 1000 - 1 - i);
+    }
+
+    EZ_TEST_BOOL(!m.Remove(m.GetIterator()).IsValid());
+    EZ_TEST_BOOL(m.IsEmpty());
+
+    // remove every other element from the middle, the returned iterator must always point to the next element
+    for (ezInt32 i = 0; i < 1000; ++i)
+      m[i] = i;
+
+    for (auto it = m.Find(100u); it.IsValid() && it.Key() < 900;)
+    {
+      const ezUInt32 uiKey = it.Key();
+      it = m.Remove(it);
+      EZ_TEST_INT(it.Key(), uiKey + 1);
+      ++it;
+    }
+
+    EZ_TEST_INT(m.GetCount(), 600);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Remove (Key)")
+  {
+    ezBTreeMap<ezUInt32, ezUInt32> m;
+
+    for (ezInt32 i = 0; i < 1000; ++i)
+      m[i] = i * 10;
+
+    for (ezInt32 i = 0; i < 1000; ++i)
+    {
+      EZ_TEST_BOOL(m.Remove(i));
+      EZ_TEST_BOOL(!m.Find(i).IsValid());
+
+      EZ_TEST_INT(m.GetCount(), 1000 - 1 - i);
+    }
+
+    EZ_TEST_BOOL(m.GetHeapMemoryUsage() == 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Random Insert / Remove (compare with ezMap)")
+  {
+    ezBTreeMap<ezUInt32, ezUInt32> m;
+    ezMap<ezUInt32, ezUInt32> reference;
+
+    ezUInt32 uiSeed = 42;
+    auto Rand = [&uiSeed]() {
+      uiSeed = uiSeed * 1664525u + 1013904223u;
+      return uiSeed >> 8;
+    };
+
+    for (ezUInt32 uiRound = 0; uiRound < 4; ++uiRound)
+    {
+      for (ezUInt32 i = 0; i < 20000; ++i)
+      {
+        const ezUInt32 uiKey = Rand() % 5000;
+
+        if (Rand() % 3 != 0)
+        {
+          m[uiKey] = i;
+          reference[uiKey] = i;
+        }
+        else
+        {
+          EZ_TEST_BOOL(m.Remove(uiKey) == reference.Remove(uiKey));
+        }
+      }
+
+      EZ_TEST_INT(m.GetCount(), reference.GetCount());
+
+      auto itRef = reference.GetIterator();
+      for (auto it = m.GetIterator(); it.IsValid(); ++it, ++itRef)
+      {
+        EZ_TEST_INT(it.Key(), itRef.Key());
+        EZ_TEST_INT(it.Value(), itRef.Value());
+      }
+
+      EZ_TEST_BOOL(!itRef.IsValid());
+    }
+
+    while (!reference.IsEmpty())
+    {
+      const ezUInt32 uiKey = reference.GetIterator().Key();
+      reference.Remove(uiKey);
+      EZ_TEST_BOOL(m.Remove(uiKey));
+    }
+
+    EZ_TEST_BOOL(m.IsEmpty());
+    EZ_TEST_BOOL(m.GetHeapMemoryUsage() == 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "operator= / Copy Constructor")
+  {
+    ezBTreeMap<ezUInt32, ezUInt32> m, m2;
+
+    for (ezInt32 i = 0; i < 1000; ++i)
+      m[i] = i * 10;
+
+    m2 = m;
+    ezBTreeMap<ezUInt32, ezUInt32> m3(m);
+
+    for (ezInt32 i = 1000 - 1; i >= 0; --i)
+    {
+      EZ_TEST_INT(m2[i], i * 10);
+      EZ_TEST_INT(m3[i], i * 10);
+    }
+
+    // filling the copy in order packs the leaves
+    EZ_TEST_BOOL(m2.GetHeapMemoryUsage() <= m.GetHeapMemoryUsage());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "GetIterator / GetLastIterator")
+  {
+    ezBTreeMap<ezUInt32, ezUInt32> m;
+
+    EZ_TEST_BOOL(!m.GetIterator().IsValid());
+    EZ_TEST_BOOL(!m.GetLastIterator().IsValid());
+
+    for (ezInt32 i = 0; i < 1000; ++i)
+      m[i] = i * 10;
+
+    ezInt32 i = 0;
+    for (ezBTreeMap<ezUInt32, ezUInt32>::Iterator it = m.GetIterator(); it.IsValid(); ++it)
+    {
+      EZ_TEST_INT(it.Key(), i);
+      EZ_TEST_INT(it.Value(), i * 10);
+      ++i;
+    }
+
+    EZ_TEST_INT(i, 1000);
+
+    const ezBTreeMap<ezUInt32, ezUInt32> m2(m);
+
+    i = 1000 - 1;
+    for (ezBTreeMap<ezUInt32, ezUInt32>::ConstIterator it = m2.GetLastIterator(); it.IsValid(); --it)
+    {
+      EZ_TEST_INT(it.Key(), i);
+      EZ_TEST_INT(it.Value(), i * 10);
+      --i;
+    }
+
+    EZ_TEST_INT(i, -1);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "LowerBound / UpperBound")
+  {
+    ezBTreeMap<ezInt32, ezInt32> m;
+
+    for (ezInt32 i = 0; i < 1000; ++i)
+      m[i * 3] = i;
+
+    for (ezInt32 i = -1; i < 3000; ++i)
+    {
+      const ezInt32 iLower = i <= 0 ? 0 : ((i + 2) / 3) * 3;
+      const ezInt32 iUpper = i < 0 ? 0 : (i / 3 + 1) * 3;
+
+      if (iLower < 3000)
+        EZ_TEST_INT(m.LowerBound(i).Key(), iLower);
+      else
+        EZ_TEST_BOOL(!m.LowerBound(i).IsValid());
+
+      if (iUpper < 3000)
+        EZ_TEST_INT(m.UpperBound(i).Key(), iUpper);
+      else
+        EZ_TEST_BOOL(!m.UpperBound(i).IsValid());
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Negative and large keys")
+  {
+    ezBTreeMap<ezInt32, ezInt32> m;
+    ezBTreeMap<ezUInt32, ezInt32> m2;
+
+    for (ezInt32 i = -5000; i < 5000; ++i)
+    {
+      m[i * 1000] = i;
+      m2[static_cast<ezUInt32>(i) * 1000u] = i;
+    }
+
+    ezInt32 iExpected = -5000;
+    for (auto it : m)
+    {
+      EZ_TEST_INT(it.Value(), iExpected);
+      ++iExpected;
+    }
+
+    ezUInt32 uiPrev = 0;
+    for (auto it : m2)
+    {
+      EZ_TEST_BOOL(it.Key() >= uiPrev);
+      uiPrev = it.Key();
+      EZ_TEST_INT(m2.Find(it.Key()).Value(), it.Value());
+    }
+
+    EZ_TEST_INT(m2.LowerBound(0xFFFFFFFFu - 1500u).Key(), 0xFFFFFFFFu - 999u);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "String keys")
+  {
+    ezBTreeMap<ezString, ezInt32> m;
+
+    ezStringBuilder sKey;
+    for (ezInt32 i = 0; i < 1000; ++i)
+    {
+      sKey.Format("Key{0}", ezArgI(i, 4, true));
+      m[sKey] = i;
+    }
+
+    EZ_TEST_INT(m.GetCount(), 1000);
+    EZ_TEST_INT(m.Find("Key0500").Value(), 500);
+    EZ_TEST_BOOL(!m.Find("Key5000").IsValid());
+    EZ_TEST_BOOL(m.Remove("Key0000"));
+    EZ_TEST_STRING(m.GetIterator().Key(), "Key0001");
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "operator== / operator!=")
+  {
+    ezBTreeMap<ezUInt32, ezUInt32> m, m2;
+
+    EZ_TEST_BOOL(m == m2);
+
+    for (ezInt32 i = 0; i < 1000; ++i)
+      m[i] = i * 10;
+
+    EZ_TEST_BOOL(m != m2);
+
+    m2 = m;
+
+    EZ_TEST_BOOL(m == m2);
+
+    m2[0] = 1;
+
+    EZ_TEST_BOOL(m != m2);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Swap")
+  {
+    ezBTreeMap<ezUInt32, ezUInt32> m, m2;
+
+    for (ezInt32 i = 0; i < 1000; ++i)
+      m[i] = i;
+
+    m2[5] = 6;
+
+    m.Swap(m2);
+
+    EZ_TEST_INT(m.GetCount(), 1);
+    EZ_TEST_INT(m[5], 6);
+    EZ_TEST_INT(m2.GetCount(), 1000);
+    EZ_TEST_INT(m2[999], 999);
+  }
+}
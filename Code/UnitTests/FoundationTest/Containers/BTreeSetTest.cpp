@@ -0,0 +1,221 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Containers/BTreeSet.h>
+#include <Foundation/Containers/Set.h>
+
+EZ_CREATE_SIMPLE_TEST(Containers, BTreeSet)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "IsEmpty / GetCount")
+  {
+    ezBTreeSet<ezUInt32> m;
+    EZ_TEST_BOOL(m.IsEmpty());
+    EZ_TEST_INT(m.GetCount(), 0);
+
+    m.Insert(0);
+    m.Insert(1);
+    m.Insert(2);
+    m.Insert(1);
+    EZ_TEST_BOOL(!m.IsEmpty());
+    EZ_TEST_INT(m.GetCount(), 3);
+
+    m.Clear();
+    EZ_TEST_BOOL(m.IsEmpty());
+    EZ_TEST_INT(m.GetCount(), 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Clear")
+  {
+    EZ_TEST_BOOL(ezConstructionCounter::HasAllDestructed());
+
+    {
+      ezBTreeSet<ezConstructionCounter> m1;
+      for (ezInt32 i = 0; i < 1000; ++i)
+        m1.Insert(ezConstructionCounter(i));
+
+      for (ezInt32 i = 0; i < 1000; i += 2)
+        m1.Remove(ezConstructionCounter(i));
+
+      EZ_TEST_INT(m1.GetCount(), 500);
+
+      m1.Clear();
+      EZ_TEST_BOOL(ezConstructionCounter::HasAllDestructed());
+
+      m1.Insert(ezConstructionCounter(1));
+    }
+
+    EZ_TEST_BOOL(ezConstructionCounter::HasAllDestructed());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Insert / Find / Contains")
+  {
+    ezBTreeSet<ezUInt32> m;
+
+    for (ezInt32 i = 0; i < 10000; i += 2)
+      m.Insert(i);
+
+    for (ezInt32 i = 0; i < 10000; i += 2)
+    {
+      EZ_TEST_INT(m.Find(i).Key(), i);
+      EZ_TEST_BOOL(!m.Find(i + 1).IsValid());
+      EZ_TEST_BOOL(m.Contains(i));
+      EZ_TEST_BOOL(!m.Contains(i + 1));
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Remove")
+  {
+    ezBTreeSet<ezUInt32> m;
+
+    for (ezInt32 i = 0; i < 1000; ++i)
+      m.Insert(i);
+
+    for (ezInt32 i = 0; i < 1000; i += 2)
+      EZ_TEST_BOOL(m.Remove(i));
+
+    EZ_TEST_BOOL(!m.Remove(0u));
+    EZ_TEST_INT(m.GetCount(), 500);
+
+    for (auto it = m.GetIterator(); it.IsValid();)
+    {
+      const ezUInt32 uiKey = it.Key();
+      it = m.Remove(it);
+      EZ_TEST_BOOL(!it.IsValid() || it.Key() == uiKey + 2);
+    }
+
+    EZ_TEST_BOOL(m.IsEmpty());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Iterator / GetLastIterator")
+  {
+    ezBTreeSet<ezUInt32> m;
+
+    for (ezInt32 i = 1000 - 1; i >= 0; --i)
+      m.Insert(i);
+
+    ezUInt32 i = 0;
+    for (ezUInt32 uiKey : m)
+    {
+      EZ_TEST_INT(uiKey, i);
+      ++i;
+    }
+
+    EZ_TEST_INT(i, 1000);
+
+    for (auto it = m.GetLastIterator(); it.IsValid(); --it)
+    {
+      --i;
+      EZ_TEST_INT(it.Key(), i);
+    }
+
+    EZ_TEST_INT(i, 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "LowerBound / UpperBound")
+  {
+    ezBTreeSet<ezInt32> m;
+    m.Insert(0);
+    m.Insert(3);
+    m.Insert(7);
+    m.Insert(9);
+
+    EZ_TEST_INT(m.LowerBound(-1).Key(), 0);
+    EZ_TEST_INT(m.LowerBound(3).Key(), 3);
+    EZ_TEST_INT(m.LowerBound(4).Key(), 7);
+    EZ_TEST_BOOL(!m.LowerBound(10).IsValid());
+
+    EZ_TEST_INT(m.UpperBound(-1).Key(), 0);
+    EZ_TEST_INT(m.UpperBound(3).Key(), 7);
+    EZ_TEST_INT(m.UpperBound(8).Key(), 9);
+    EZ_TEST_BOOL(!m.UpperBound(9).IsValid());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Union / Difference / Intersection / ContainsSet")
+  {
+    ezBTreeSet<ezUInt32> base;
+    base.Insert(1);
+    base.Insert(3);
+    base.Insert(5);
+
+    ezBTreeSet<ezUInt32> operand;
+    operand.Insert(2);
+    operand.Insert(3);
+    operand.Insert(4);
+
+    ezBTreeSet<ezUInt32> res = base;
+    res.Union(operand);
+    EZ_TEST_INT(res.GetCount(), 5);
+    EZ_TEST_BOOL(res.ContainsSet(base));
+    EZ_TEST_BOOL(res.ContainsSet(operand));
+    EZ_TEST_BOOL(!base.ContainsSet(res));
+
+    res = base;
+    res.Difference(operand);
+    EZ_TEST_INT(res.GetCount(), 2);
+    EZ_TEST_BOOL(res.Contains(1));
+    EZ_TEST_BOOL(res.Contains(5));
+
+    res = base;
+    res.Intersection(operand);
+    EZ_TEST_INT(res.GetCount(), 1);
+    EZ_TEST_BOOL(res.Contains(3));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Random Insert / Remove (compare with ezSet)")
+  {
+    ezBTreeSet<ezInt32> m;
+    ezSet<ezInt32> reference;
+
+    ezUInt32 uiSeed = 7;
+    auto Rand = [&uiSeed]() {
+      uiSeed = uiSeed * 1664525u + 1013904223u;
+      return uiSeed >> 8;
+    };
+
+    for (ezUInt32 i = 0; i < 50000; ++i)
+    {
+      const ezInt32 iKey = static_cast<ezInt32>(Rand() % 8000) - 4000;
+
+      if (Rand() % 2 == 0)
+      {
+        m.Insert(iKey);
+        reference.Insert(iKey);
+      }
+      else
+      {
+        EZ_TEST_BOOL(m.Remove(iKey) == reference.Remove(iKey));
+      }
+    }
+
+    EZ_TEST_INT(m.GetCount(), reference.GetCount());
+
+    auto itRef = reference.GetIterator();
+    for (auto it = m.GetIterator(); it.IsValid(); ++it, ++itRef)
+    {
+      EZ_TEST_INT(it.Key(), itRef.Key());
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "operator== / Swap / GetHeapMemoryUsage")
+  {
+    ezBTreeSet<ezUInt32> m, m2;
+    EZ_TEST_BOOL(m == m2);
+    EZ_TEST_BOOL(m.GetHeapMemoryUsage() == 0);
+
+    for (ezInt32 i = 0; i < 1000; ++i)
+      m.Insert(i);
+
+    EZ_TEST_BOOL(m.GetHeapMemoryUsage() >= sizeof(ezUInt32) * 1000);
+    EZ_TEST_BOOL(m != m2);
+
+    m2 = m;
+    EZ_TEST_BOOL(m == m2);
+
+    m2.Remove(500u);
+    EZ_TEST_BOOL(m != m2);
+
+    m2.Clear();
+    m.Swap(m2);
+    EZ_TEST_BOOL(m.IsEmpty());
+    EZ_TEST_INT(m2.GetCount(), 1000);
+  }
+}
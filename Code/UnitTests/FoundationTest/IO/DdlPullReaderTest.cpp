@@ -0,0 +1,331 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/IO/OpenDdlPullReader.h>
+#include <Foundation/IO/OpenDdlUtils.h>
+#include <Foundation/Strings/StringBuilder.h>
+#include <FoundationTest/IO/JSONTestHelpers.h>
+#include <TestFramework/Utilities/TestLogInterface.h>
+
+namespace
+{
+  ezArrayPtr<const ezUInt8> ToBuffer(const char* szText)
+  {
+    return ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(szText), ezStringUtils::GetStringElementCount(szText));
+  }
+
+  /// \brief Writes all events of the document into a string, so that different inputs can be compared easily.
+  void DescribeEvents(ezOpenDdlPullReader& reader, ezStringBuilder& out)
+  {
+    out.Clear();
+
+    while (true)
+    {
+      switch (reader.Next())
+      {
+        case ezOpenDdlPullReader::Event::EndOfDocument:
+          return;
+
+        case ezOpenDdlPullReader::Event::BeginObject:
+          out.AppendFormat("<{0}:{1}>", reader.GetCustomType(), reader.HasName() ? reader.GetName() : "");
+          break;
+
+        case ezOpenDdlPullReader::Event::EndObject:
+          out.Append("</>");
+          break;
+
+        case ezOpenDdlPullReader::Event::BeginPrimitiveList:
+          out.AppendFormat("[{0}:{1}", (int)reader.GetPrimitivesType(), reader.HasName() ? reader.GetName() : "");
+          break;
+
+        case ezOpenDdlPullReader::Event::EndPrimitiveList:
+          out.Append("]");
+          break;
+
+        case ezOpenDdlPullReader::Event::Primitives:
+          switch (reader.GetPrimitivesType())
+          {
+            case ezOpenDdlPrimitiveType::Int32:
+              for (ezInt32 i : reader.GetPrimitivesInt32())
+                out.AppendFormat(" {0}", i);
+              break;
+
+            case ezOpenDdlPrimitiveType::Float:
+              for (float f : reader.GetPrimitivesFloat())
+                out.AppendFormat(" {0}", f);
+              break;
+
+            case ezOpenDdlPrimitiveType::String:
+              for (ezStringView s : reader.GetPrimitivesString())
+                out.AppendFormat(" '{0}'", s);
+              break;
+
+            default:
+              out.AppendFormat(
+                " ({0})", reader.GetPrimitivesType() == ezOpenDdlPrimitiveType::Bool ? reader.GetPrimitivesBool().GetCount() : 0);
+              break;
+          }
+          break;
+      }
+    }
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(IO, DdlPullReader)
+{
+  const char* szTestData = "\
+Node $global\n\
+{\n\
+  Name { string { \"ConstantColor\" } }\n\
+  float %MyFloats { 1.5, 3, -2 }\n\
+  int32 { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }\n\
+  string { \"plain\", \"esc\\\"aped\", \"\" }\n\
+  bool { true, false }\n\
+  Properties\n\
+  {\n\
+    Property { Name { string { \"Color\" } } }\n\
+  }\n\
+}\n\
+";
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Events")
+  {
+    ezOpenDdlPullReader reader;
+    reader.SetInput(ToBuffer(szTestData));
+
+    EZ_TEST_BOOL(reader.Next() == ezOpenDdlPullReader::Event::BeginObject);
+    EZ_TEST_STRING(reader.GetCustomType(), "Node");
+    EZ_TEST_STRING(reader.GetName(), "global");
+    EZ_TEST_BOOL(reader.IsNameGlobal());
+
+    EZ_TEST_BOOL(reader.Next() == ezOpenDdlPullReader::Event::BeginObject);
+    EZ_TEST_STRING(reader.GetCustomType(), "Name");
+    EZ_TEST_BOOL(!reader.HasName());
+
+    EZ_TEST_BOOL(reader.Next() == ezOpenDdlPullReader::Event::BeginPrimitiveList);
+    EZ_TEST_BOOL(reader.GetPrimitivesType() == ezOpenDdlPrimitiveType::String);
+
+    ezStringBuilder sDesc;
+    DescribeEvents(reader, sDesc);
+    EZ_TEST_STRING(sDesc, " 'ConstantColor']</>[9:MyFloats 1.5 3 -2][3: 0 1 2 3 4 5 6 7 8 9][11: 'plain' 'esc\"aped' ''][0: (2)]<Properties:><Property:><Name:>[11: 'Color']</></></></>");
+
+    EZ_TEST_BOOL(reader.Next() == ezOpenDdlPullReader::Event::EndOfDocument);
+    EZ_TEST_BOOL(!reader.HadFatalParsingError());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Buffer vs. Stream")
+  {
+    ezStringBuilder sFromBuffer, sFromStream;
+
+    {
+      ezOpenDdlPullReader reader;
+      reader.SetInput(ToBuffer(szTestData));
+      DescribeEvents(reader, sFromBuffer);
+    }
+
+    {
+      StringStream stream(szTestData);
+
+      // use a tiny cache, to get the primitives in several chunks
+      ezOpenDdlPullReader reader;
+      reader.SetInput(stream, 0, ezLog::GetThreadLocalLogSystem(), 0);
+      DescribeEvents(reader, sFromStream);
+    }
+
+    EZ_TEST_STRING(sFromBuffer, sFromStream);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Stream Larger Than One Chunk")
+  {
+    // the stream is read in chunks of 4 KB, so tokens and strings cross the chunk boundaries
+    ezStringBuilder sData = "Node\n{\n";
+    for (ezUInt32 i = 0; i < 300; ++i)
+    {
+      sData.AppendFormat("  int32 { {0}, {1}, {2} }\n  string { \"Value{0}\", \"esc\\\"{1}\" }\n", i, i * 1000, -(ezInt32)i);
+    }
+    sData.Append("}\n");
+    EZ_TEST_BOOL(sData.GetElementCount() > 3 * 4096);
+
+    ezStringBuilder sFromBuffer, sFromStream;
+
+    {
+      ezOpenDdlPullReader reader;
+      reader.SetInput(ToBuffer(sData));
+      DescribeEvents(reader, sFromBuffer);
+      EZ_TEST_BOOL(!reader.HadFatalParsingError());
+    }
+
+    {
+      StringStream stream(sData.GetData());
+
+      ezOpenDdlPullReader reader;
+      reader.SetInput(stream);
+      DescribeEvents(reader, sFromStream);
+      EZ_TEST_BOOL(!reader.HadFatalParsingError());
+    }
+
+    EZ_TEST_STRING(sFromBuffer, sFromStream);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Zero-Copy Strings")
+  {
+    const ezArrayPtr<const ezUInt8> data = ToBuffer(szTestData);
+    const char* pStart = szTestData;
+    const char* pEnd = szTestData + data.GetCount();
+
+    ezOpenDdlPullReader reader;
+    reader.SetInput(data);
+
+    ezUInt32 uiStrings = 0;
+    while (reader.Next() != ezOpenDdlPullReader::Event::EndOfDocument)
+    {
+      if (reader.GetEvent() != ezOpenDdlPullReader::Event::Primitives || reader.GetPrimitivesType() != ezOpenDdlPrimitiveType::String)
+        continue;
+
+      for (ezStringView s : reader.GetPrimitivesString())
+      {
+        ++uiStrings;
+
+        const bool bInBuffer = s.GetStartPointer() >= pStart && s.GetEndPointer() <= pEnd;
+        const bool bEscaped = s.FindSubString("\"") != nullptr;
+
+        // strings with escape sequences have to be unescaped into a temporary buffer
+        EZ_TEST_BOOL(bInBuffer != bEscaped);
+      }
+    }
+
+    EZ_TEST_INT(uiStrings, 5);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "SkipElement")
+  {
+    ezOpenDdlPullReader reader;
+    reader.SetInput(ToBuffer(szTestData));
+
+    ezStringBuilder sDesc;
+    while (reader.Next() != ezOpenDdlPullReader::Event::EndOfDocument)
+    {
+      if (reader.GetEvent() == ezOpenDdlPullReader::Event::BeginObject)
+      {
+        sDesc.AppendFormat("<{0}>", reader.GetCustomType());
+
+        if (!ezStringUtils::IsEqual(reader.GetCustomType(), "Node"))
+          reader.SkipElement();
+      }
+      else if (reader.GetEvent() == ezOpenDdlPullReader::Event::BeginPrimitiveList)
+      {
+        sDesc.Append("[]");
+        reader.SkipElement();
+      }
+      else if (reader.GetEvent() == ezOpenDdlPullReader::Event::EndObject)
+      {
+        sDesc.Append("</>");
+      }
+      else
+      {
+        EZ_TEST_FAILURE("Unexpected event", "Skipped elements must not report any events");
+      }
+    }
+
+    EZ_TEST_STRING(sDesc, "<Node><Name>[][][][]<Properties></>");
+    EZ_TEST_BOOL(!reader.HadFatalParsingError());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ReadElement")
+  {
+    const char* szData = "\
+Transform { Vec3 %Position { float { 1, 2, 3 } } string %Tags { \"a\", \"b\\\\c\" } }\n\
+int32 %After { 42 }\n\
+";
+
+    ezOpenDdlPullReader reader;
+    reader.SetInput(ToBuffer(szData));
+
+    EZ_TEST_BOOL(reader.Next() == ezOpenDdlPullReader::Event::BeginObject);
+
+    const ezOpenDdlReaderElement* pTransform = reader.ReadElement();
+    EZ_TEST_BOOL(pTransform != nullptr);
+    EZ_TEST_STRING(pTransform->GetCustomType(), "Transform");
+    EZ_TEST_INT(pTransform->GetNumChildObjects(), 2);
+
+    const ezOpenDdlReaderElement* pPosition = pTransform->FindChild("Position");
+    EZ_TEST_BOOL(pPosition != nullptr);
+
+    ezVariant value;
+    EZ_TEST_BOOL(ezOpenDdlUtils::ConvertToVariant(pPosition, value).Succeeded());
+    EZ_TEST_VEC3(value.Get<ezVec3>(), ezVec3(1, 2, 3), 0);
+
+    const ezOpenDdlReaderElement* pTags = pTransform->FindChildOfType(ezOpenDdlPrimitiveType::String, "Tags");
+    EZ_TEST_BOOL(pTags != nullptr);
+    EZ_TEST_INT(pTags->GetNumPrimitives(), 2);
+    EZ_TEST_STRING(ezString(pTags->GetPrimitivesString()[0]), "a");
+    EZ_TEST_STRING(ezString(pTags->GetPrimitivesString()[1]), "b\\c");
+
+    // reading continues after the element
+    EZ_TEST_BOOL(reader.Next() == ezOpenDdlPullReader::Event::BeginPrimitiveList);
+    EZ_TEST_STRING(reader.GetName(), "After");
+
+    const ezOpenDdlReaderElement* pAfter = reader.ReadElement();
+    EZ_TEST_INT(pAfter->GetNumPrimitives(), 1);
+    EZ_TEST_INT(pAfter->GetPrimitivesInt32()[0], 42);
+
+    EZ_TEST_BOOL(reader.Next() == ezOpenDdlPullReader::Event::EndOfDocument);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Fatal Errors")
+  {
+    const char* szData = "\
+Node { string{\"s1\",\"s2\"\n\
+string{\"bla\"} }\n\
+";
+
+    ezTestLogInterface log;
+    ezTestLogSystemScope logSystemScope(&log);
+
+    log.ExpectMessage("Line 2 (2): Expected , or } or a \"", ezLogMsgType::ErrorMsg);
+
+    ezOpenDdlPullReader reader;
+    reader.SetInput(ToBuffer(szData));
+
+    EZ_TEST_BOOL(reader.Next() == ezOpenDdlPullReader::Event::BeginObject);
+    EZ_TEST_BOOL(reader.ReadElement() == nullptr);
+    EZ_TEST_BOOL(reader.HadFatalParsingError());
+    EZ_TEST_BOOL(reader.Next() == ezOpenDdlPullReader::Event::EndOfDocument);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Embedded Zero")
+  {
+    // a '\0' ends the document, also in the middle of a string that could otherwise be returned without a copy
+    const char szData[] = "Node { string { \"abc\0def\" } }\n";
+    const ezArrayPtr<const ezUInt8> data(reinterpret_cast<const ezUInt8*>(szData), EZ_ARRAY_SIZE(szData) - 1);
+
+    ezTestLogInterface log;
+    ezTestLogSystemScope logSystemScope(&log);
+
+    log.ExpectMessage("Reached end of document before end of string was found", ezLogMsgType::ErrorMsg, 2);
+
+    {
+      ezOpenDdlPullReader reader;
+      reader.SetInput(data);
+
+      while (reader.Next() != ezOpenDdlPullReader::Event::EndOfDocument)
+      {
+      }
+
+      EZ_TEST_BOOL(reader.HadFatalParsingError());
+    }
+
+    {
+      ezRawMemoryStreamReader stream(data.GetPtr(), data.GetCount());
+
+      ezOpenDdlPullReader reader;
+      reader.SetInput(stream);
+
+      while (reader.Next() != ezOpenDdlPullReader::Event::EndOfDocument)
+      {
+      }
+
+      EZ_TEST_BOOL(reader.HadFatalParsingError());
+    }
+  }
+}
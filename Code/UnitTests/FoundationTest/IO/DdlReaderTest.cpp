@@ -331,4 +331,23 @@ string{\"s\\2\",\"bla\"}\n\
     ezOpenDdlReader doc;
     EZ_TEST_BOOL(doc.ParseDocument(stream).Failed());
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Parse From Memory")
+  {
+    const char* szTestData = "\
+Node $global\n\
+{\n\
+	string{\"plain\",\"esc\\\"aped\"}\n\
+	float{1.5,-3}\n\
+}\n\
+";
+
+    const ezArrayPtr<const ezUInt8> data(reinterpret_cast<const ezUInt8*>(szTestData), ezStringUtils::GetStringElementCount(szTestData));
+
+    ezOpenDdlReader doc;
+    EZ_TEST_BOOL(doc.ParseDocument(data).Succeeded());
+
+    TestDoc(doc, szTestData);
+    EZ_TEST_BOOL(doc.FindElement("global") != nullptr);
+  }
 }
@@ -0,0 +1,290 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/IO/JSONCursor.h>
+#include <Foundation/Strings/StringBuilder.h>
+#include <TestFramework/Utilities/TestLogInterface.h>
+
+namespace
+{
+  ezArrayPtr<const ezUInt8> JsonToBuffer(const char* szText)
+  {
+    return ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(szText), ezStringUtils::GetStringElementCount(szText));
+  }
+
+  /// \brief Reads the entire value at the cursor position and writes it in a compact form.
+  void DescribeValue(ezJSONCursor& json, ezStringBuilder& out)
+  {
+    switch (json.GetValueType())
+    {
+      case ezJSONCursor::ValueType::Object:
+      {
+        json.BeginObject();
+        out.Append("{");
+
+        ezStringView sKey;
+        while (json.NextMember(sKey))
+        {
+          out.AppendFormat("{0}=", sKey);
+          DescribeValue(json, out);
+          out.Append(";");
+        }
+
+        out.Append("}");
+      }
+      break;
+
+      case ezJSONCursor::ValueType::Array:
+      {
+        json.BeginArray();
+        out.Append("[");
+
+        while (json.NextElement())
+        {
+          DescribeValue(json, out);
+          out.Append(";");
+        }
+
+        out.Append("]");
+      }
+      break;
+
+      case ezJSONCursor::ValueType::String:
+      {
+        ezStringView sValue;
+        EZ_TEST_BOOL(json.ReadString(sValue).Succeeded());
+        out.AppendFormat("'{0}'", sValue);
+      }
+      break;
+
+      case ezJSONCursor::ValueType::Number:
+      {
+        double fValue = 0;
+        EZ_TEST_BOOL(json.ReadDouble(fValue).Succeeded());
+        out.AppendFormat("{0}", fValue);
+      }
+      break;
+
+      case ezJSONCursor::ValueType::Bool:
+      {
+        bool bValue = false;
+        EZ_TEST_BOOL(json.ReadBool(bValue).Succeeded());
+        out.Append(bValue ? "true" : "false");
+      }
+      break;
+
+      case ezJSONCursor::ValueType::Null:
+        EZ_TEST_BOOL(json.ReadNull().Succeeded());
+        out.Append("null");
+        break;
+
+      default:
+        out.Append("<invalid>");
+        break;
+    }
+  }
+
+  void TestDocument(const char* szJSON, const char* szExpected)
+  {
+    ezJSONCursor json;
+    EZ_TEST_BOOL(json.SetInput(JsonToBuffer(szJSON)).Succeeded());
+
+    ezStringBuilder sResult;
+    DescribeValue(json, sResult);
+
+    EZ_TEST_BOOL(!json.HadError());
+    EZ_TEST_BOOL(json.IsAtEnd());
+    EZ_TEST_STRING(sResult, szExpected);
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(IO, JSONCursor)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Values")
+  {
+    TestDocument("{ \"a\" : 1, \"b\":[ true,false , null], \"c\" : { \"d\" : \"text\" }, \"e\" : [], \"f\" : {} }",
+      "{a=1;b=[true;false;null;];c={d='text';};e=[];f={};}");
+
+    TestDocument("[ -1.5, 2e3, 0.25, 1E-2, 3., .5 ]", "[-1.5;2000;0.25;0.01;3;0.5;]");
+
+    // superfluous commas
+    TestDocument("{,\"a\":[1,2,],,\"b\":3,}", "{a=[1;2;];b=3;}");
+
+    TestDocument("", "<invalid>");
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Numbers")
+  {
+    // the first values take the fast path, the others need the full conversion
+    const char* szJSON = "[ 0, -17, 123.456, 5e-3, 12345678901234567890, 1.7976931348623157e308, 2.5e-300, 0.1e-30 ]";
+    const double expected[] = {0.0, -17.0, 123.456, 5e-3, 12345678901234567890.0, 1.7976931348623157e308, 2.5e-300, 0.1e-30};
+
+    ezJSONCursor json;
+    EZ_TEST_BOOL(json.SetInput(JsonToBuffer(szJSON)).Succeeded());
+    EZ_TEST_BOOL(json.BeginArray());
+
+    for (double fExpected : expected)
+    {
+      double fValue = 1.0;
+      EZ_TEST_BOOL(json.NextElement());
+      EZ_TEST_BOOL(json.ReadDouble(fValue).Succeeded());
+      EZ_TEST_BOOL(fValue == fExpected);
+    }
+
+    EZ_TEST_BOOL(!json.NextElement());
+    EZ_TEST_BOOL(!json.HadError());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Strings")
+  {
+    const char* szJSON = "[ \"plain\", \"esc\\\"aped\\\\\", \"\\u00e4\\uD83D\\uDE00\\n\", \"\", \"with [brackets], {braces} and : commas\" ]";
+
+    ezJSONCursor json;
+    EZ_TEST_BOOL(json.SetInput(JsonToBuffer(szJSON)).Succeeded());
+    EZ_TEST_BOOL(json.BeginArray());
+
+    ezStringView sValue;
+
+    // strings without escape sequences point into the input
+    EZ_TEST_BOOL(json.NextElement());
+    EZ_TEST_BOOL(json.ReadString(sValue).Succeeded());
+    EZ_TEST_BOOL(sValue == "plain");
+    EZ_TEST_BOOL(sValue.GetStartPointer() == szJSON + 3);
+
+    EZ_TEST_BOOL(json.NextElement());
+    EZ_TEST_BOOL(json.ReadString(sValue).Succeeded());
+    EZ_TEST_BOOL(sValue == "esc\"aped\\");
+
+    EZ_TEST_BOOL(json.NextElement());
+    EZ_TEST_BOOL(json.ReadString(sValue).Succeeded());
+    EZ_TEST_BOOL(sValue == ezStringView("\xC3\xA4\xF0\x9F\x98\x80\n"));
+
+    EZ_TEST_BOOL(json.NextElement());
+    EZ_TEST_BOOL(json.ReadString(sValue).Succeeded());
+    EZ_TEST_BOOL(sValue.IsEmpty());
+
+    EZ_TEST_BOOL(json.NextElement());
+    EZ_TEST_BOOL(json.ReadString(sValue).Succeeded());
+    EZ_TEST_BOOL(sValue == "with [brackets], {braces} and : commas");
+
+    EZ_TEST_BOOL(!json.NextElement());
+    EZ_TEST_BOOL(json.IsAtEnd());
+    EZ_TEST_BOOL(!json.HadError());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Block Boundaries")
+  {
+    // escape sequences and strings crossing the 64 byte blocks of the index
+    for (ezUInt32 uiPadding = 0; uiPadding < 70; ++uiPadding)
+    {
+      ezStringBuilder sJSON, sExpected;
+      sJSON.Append("{\"");
+      sExpected.Append("{");
+
+      for (ezUInt32 i = 0; i < uiPadding; ++i)
+      {
+        sJSON.Append("k");
+        sExpected.Append("k");
+      }
+
+      sJSON.Append("\":\"\\\\\\\"{[,\\\\\", \"x\": 12.5 , \"y\":[\"\\\\\"]}");
+      sExpected.Append("='\\\"{[,\\';x=12.5;y=['\\';];}");
+
+      TestDocument(sJSON, sExpected);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Comments")
+  {
+    TestDocument("// header\n{ \"a\" : tr/**/ue, /* \"b\" : 1, */ \"c\" : 12/* x */34, \"d\" : \"/* not a comment */\" }",
+      "{a=true;c=1234;d='/* not a comment */';}");
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "SkipValue")
+  {
+    ezJSONCursor json;
+    EZ_TEST_BOOL(json.SetInput(JsonToBuffer("{ \"skip\" : { \"a\" : [ 1, { \"b\" : \"}]\" } ] }, \"s\" : \"x\", \"n\" : 5 }")).Succeeded());
+    EZ_TEST_BOOL(json.BeginObject());
+
+    ezStringView sKey;
+    ezStringBuilder sKeys;
+    while (json.NextMember(sKey))
+    {
+      sKeys.Append(sKey);
+
+      if (sKey == "n")
+      {
+        double fValue = 0;
+        EZ_TEST_BOOL(json.ReadDouble(fValue).Succeeded());
+        EZ_TEST_DOUBLE(fValue, 5.0, 0.0);
+      }
+      else
+      {
+        json.SkipValue();
+      }
+    }
+
+    EZ_TEST_STRING(sKeys, "skipsn");
+    EZ_TEST_BOOL(json.IsAtEnd());
+    EZ_TEST_BOOL(!json.HadError());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Errors")
+  {
+    ezTestLogInterface log;
+    ezTestLogSystemScope logSystemScope(&log);
+
+    {
+      log.ExpectMessage("Line 2 (12): After parsing value: Expected a comma or closing braces. Got '\"' instead.", ezLogMsgType::ErrorMsg);
+
+      ezJSONCursor json;
+      EZ_TEST_BOOL(json.SetInput(JsonToBuffer("{ \"a\" : 1,\n/**/\"b\" : 2 \"c\" : 3 }")).Succeeded());
+
+      ezStringBuilder sResult;
+      DescribeValue(json, sResult);
+      EZ_TEST_BOOL(json.HadError());
+
+      ezUInt32 uiLine, uiColumn;
+      json.GetErrorPosition(uiLine, uiColumn);
+      EZ_TEST_INT(uiLine, 2);
+      EZ_TEST_INT(uiColumn, 12);
+
+      // all further reads fail
+      EZ_TEST_BOOL(json.GetValueType() == ezJSONCursor::ValueType::Invalid);
+      EZ_TEST_BOOL(!json.BeginObject());
+    }
+
+    {
+      log.ExpectMessage("Reached end of document before end of string was found.", ezLogMsgType::ErrorMsg);
+
+      ezJSONCursor json;
+      EZ_TEST_BOOL(json.SetInput(JsonToBuffer("{ \"a\" : \"text }")).Failed());
+    }
+
+    {
+      log.ExpectMessage("Unknown escape-sequence '\\x'", ezLogMsgType::ErrorMsg);
+
+      ezJSONCursor json;
+      EZ_TEST_BOOL(json.SetInput(JsonToBuffer("[ \"\\x\" ]")).Succeeded());
+      EZ_TEST_BOOL(json.BeginArray());
+      EZ_TEST_BOOL(json.NextElement());
+
+      ezStringView sValue;
+      EZ_TEST_BOOL(json.ReadString(sValue).Failed());
+      EZ_TEST_BOOL(json.HadError());
+      EZ_TEST_BOOL(!json.NextElement());
+    }
+
+    {
+      log.ExpectMessage("Parsing value: Expected 'true' or 'false', Got 'tru' instead.", ezLogMsgType::ErrorMsg);
+
+      ezJSONCursor json;
+      EZ_TEST_BOOL(json.SetInput(JsonToBuffer("[ tru ]")).Succeeded());
+      EZ_TEST_BOOL(json.BeginArray());
+      EZ_TEST_BOOL(json.NextElement());
+
+      bool bValue = false;
+      EZ_TEST_BOOL(json.ReadBool(bValue).Failed());
+      EZ_TEST_BOOL(json.HadError());
+    }
+  }
+}
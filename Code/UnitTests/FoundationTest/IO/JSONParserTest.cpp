@@ -75,10 +75,26 @@ public:
     EZ_TEST_INT(m_Results.GetCount(), 0);
   }
 
-  void ParseStream(ezStreamReader& stream)
+  /// \brief Parses the document once from a stream and once directly from memory. Both must report the same results.
+  void Parse(const char* szTestData)
   {
+    const ezDeque<ParseResult> expectedResults = m_Results;
+    const ezInt32 iExpectedParsingErrors = m_iExpectedParsingErrors;
+
+    StringStream stream(szTestData);
     SetInputStream(stream);
     ParseAll();
+
+    EZ_TEST_INT(m_Results.GetCount(), 0);
+    EZ_TEST_INT(m_iExpectedParsingErrors, 0);
+
+    m_Results = expectedResults;
+    m_iExpectedParsingErrors = iExpectedParsingErrors;
+    m_bSkipObject = false;
+    m_bSkipArray = false;
+
+    ParseBuffer(ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(szTestData), ezStringUtils::GetStringElementCount(szTestData)))
+      .IgnoreResult();
   }
 
   void Add(ParseResult pr) { m_Results.PushBack(pr); }
@@ -220,8 +236,6 @@ EZ_CREATE_SIMPLE_TEST(IO, JSONParser)
 \"test\" : \"text\"\n\
 }";
 
-    StringStream stream(szTestData);
-
     TestReader reader;
 
     reader.Add(ParseResult(BeginObject));
@@ -303,58 +317,50 @@ EZ_CREATE_SIMPLE_TEST(IO, JSONParser)
 
     reader.Add(ParseResult(EndObject));
 
-    reader.ParseStream(stream);
+    reader.Parse(szTestData);
   }
 
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "Empty Document (string")
   {
     const char* szTestData = "";
 
-    StringStream stream(szTestData);
-
     TestReader reader;
 
-    reader.ParseStream(stream);
+    reader.Parse(szTestData);
   }
 
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "Empty Document (Whitespace)")
   {
     const char* szTestData = " \n  \t ";
 
-    StringStream stream(szTestData);
-
     TestReader reader;
 
-    reader.ParseStream(stream);
+    reader.Parse(szTestData);
   }
 
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "Empty Document")
   {
     const char* szTestData = "{}";
 
-    StringStream stream(szTestData);
-
     TestReader reader;
 
     reader.Add(ParseResult(BeginObject));
     reader.Add(ParseResult(EndObject));
 
-    reader.ParseStream(stream);
+    reader.Parse(szTestData);
   }
 
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "Two Empty Documents")
   {
     const char* szTestData = "{}{}";
 
-    StringStream stream(szTestData);
-
     TestReader reader;
 
     // only the first will be read
     reader.Add(ParseResult(BeginObject));
     reader.Add(ParseResult(EndObject));
 
-    reader.ParseStream(stream);
+    reader.Parse(szTestData);
   }
 
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "No Whitespace")
@@ -362,8 +368,6 @@ EZ_CREATE_SIMPLE_TEST(IO, JSONParser)
     // I want C++ 11 raw string literals
     const char* szTestData = "{\"a\":4,\"b\":true,\"c\":\"\",\"d\":\"v\"}";
 
-    StringStream stream(szTestData);
-
     TestReader reader;
 
     reader.Add(ParseResult(BeginObject));
@@ -382,7 +386,7 @@ EZ_CREATE_SIMPLE_TEST(IO, JSONParser)
 
     reader.Add(ParseResult(EndObject));
 
-    reader.ParseStream(stream);
+    reader.Parse(szTestData);
 
     EZ_TEST_INT(reader.m_iExpectedParsingErrors, 0);
   }
@@ -392,8 +396,6 @@ EZ_CREATE_SIMPLE_TEST(IO, JSONParser)
     // I want C++ 11 raw string literals
     const char* szTestData = "{\"a\":{},\"b\":[],\"c\":[{}],\"d\":{}}";
 
-    StringStream stream(szTestData);
-
     TestReader reader;
 
     reader.Add(ParseResult(BeginObject));
@@ -418,7 +420,7 @@ EZ_CREATE_SIMPLE_TEST(IO, JSONParser)
 
     reader.Add(ParseResult(EndObject));
 
-    reader.ParseStream(stream);
+    reader.Parse(szTestData);
 
     EZ_TEST_INT(reader.m_iExpectedParsingErrors, 0);
   }
@@ -431,8 +433,6 @@ EZ_CREATE_SIMPLE_TEST(IO, JSONParser)
     // allow ONE superfluous comma at the end of arrays (more will fail)
     const char* szTestData = "{\"a\":{,},,\"b\":[3.],\"c\":[.3,],\"d\":{},}//the end is near (here somewhere)";
 
-    StringStream stream(szTestData);
-
     TestReader reader;
 
     reader.Add(ParseResult(BeginObject));
@@ -457,7 +457,7 @@ EZ_CREATE_SIMPLE_TEST(IO, JSONParser)
 
     reader.Add(ParseResult(EndObject));
 
-    reader.ParseStream(stream);
+    reader.Parse(szTestData);
 
     EZ_TEST_INT(reader.m_iExpectedParsingErrors, 0);
   }
@@ -467,8 +467,6 @@ EZ_CREATE_SIMPLE_TEST(IO, JSONParser)
     // I want C++ 11 raw string literals
     const char* szTestData = "{\"a\":[,]/**/}";
 
-    StringStream stream(szTestData);
-
     TestReader reader;
     reader.m_iExpectedParsingErrors = 1;
 
@@ -480,7 +478,7 @@ EZ_CREATE_SIMPLE_TEST(IO, JSONParser)
 
     // reader.Add(ParseResult(EndObject));
 
-    reader.ParseStream(stream);
+    reader.Parse(szTestData);
 
     EZ_TEST_INT(reader.m_iExpectedParsingErrors, 0); // must fail to parse
   }
@@ -490,8 +488,6 @@ EZ_CREATE_SIMPLE_TEST(IO, JSONParser)
     // I want C++ 11 raw string literals
     const char* szTestData = "{\"a\":tr/**/u/*\n*//**/e/* */, \"b\":234/* adf */56//78\n}";
 
-    StringStream stream(szTestData);
-
     TestReader reader;
 
     reader.Add(ParseResult(BeginObject));
@@ -504,7 +500,7 @@ EZ_CREATE_SIMPLE_TEST(IO, JSONParser)
 
     reader.Add(ParseResult(EndObject));
 
-    reader.ParseStream(stream);
+    reader.Parse(szTestData);
   }
 
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "Skip Object")
@@ -512,8 +508,6 @@ EZ_CREATE_SIMPLE_TEST(IO, JSONParser)
     // I want C++ 11 raw string literals
     const char* szTestData = "{ \"skip_obj\" : { \"a\" : 1, \"b\" : 2, \"c\" : [ { }, { \"e\" : { } } ] }, \"d\" : 3, \"skip_obj\" : { } }";
 
-    StringStream stream(szTestData);
-
     TestReader reader;
 
     reader.Add(ParseResult(BeginObject));
@@ -531,7 +525,7 @@ EZ_CREATE_SIMPLE_TEST(IO, JSONParser)
 
     reader.Add(ParseResult(EndObject));
 
-    reader.ParseStream(stream);
+    reader.Parse(szTestData);
   }
 
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "Skip Array")
@@ -539,8 +533,6 @@ EZ_CREATE_SIMPLE_TEST(IO, JSONParser)
     // I want C++ 11 raw string literals
     const char* szTestData = "{ \"skip_array\" : [ \"a\",  1, \"b\",  2, \"c\", [ { }, { \"e\" : { } } ] ], \"d\" : 3, \"skip_array\" : [ ] }";
 
-    StringStream stream(szTestData);
-
     TestReader reader;
 
     reader.Add(ParseResult(BeginObject));
@@ -558,7 +550,7 @@ EZ_CREATE_SIMPLE_TEST(IO, JSONParser)
 
     reader.Add(ParseResult(EndObject));
 
-    reader.ParseStream(stream);
+    reader.Parse(szTestData);
   }
 
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "Skip Variable")
@@ -567,8 +559,6 @@ EZ_CREATE_SIMPLE_TEST(IO, JSONParser)
     const char* szTestData = "{ \"skip_var\" : { \"a\" : 1, \"b\" : 2, \"c\" : [ { }, { \"e\" : { } } ] }, \"d\" : 3, \"f\" : { \"g\" : 4, "
                              "\"skip_var\" : [ { }, 3, [], true ], \"h\" : 5} }";
 
-    StringStream stream(szTestData);
-
     TestReader reader;
 
     reader.Add(ParseResult(BeginObject));
@@ -595,6 +585,6 @@ EZ_CREATE_SIMPLE_TEST(IO, JSONParser)
 
     reader.Add(ParseResult(EndObject));
 
-    reader.ParseStream(stream);
+    reader.Parse(szTestData);
   }
 }
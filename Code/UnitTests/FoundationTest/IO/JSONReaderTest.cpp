@@ -462,8 +462,18 @@ EZ_CREATE_SIMPLE_TEST(IO, JSONReader)
 
     sCompare.PushBack("</object>");
 
+    ezDeque<ezString> sCompareFromMemory = sCompare;
+
     JSONReaderTestDetail::TraverseTree(reader.GetTopLevelObject(), sCompare);
 
     EZ_TEST_BOOL(sCompare.IsEmpty());
+
+    // the same document, parsed directly from memory
+    ezJSONReader readerFromMemory;
+    EZ_TEST_BOOL(readerFromMemory.Parse(ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(szTestData), sTD.GetElementCount())).Succeeded());
+
+    JSONReaderTestDetail::TraverseTree(readerFromMemory.GetTopLevelObject(), sCompareFromMemory);
+
+    EZ_TEST_BOOL(sCompareFromMemory.IsEmpty());
   }
 }
@@ -0,0 +1,215 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Logging/BinaryWriter.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/ThreadUtils.h>
+
+namespace
+{
+  class BinaryLogInterface : public ezLogInterface
+  {
+  public:
+    virtual void HandleLogMessage(const ezLoggingEventData& le) override { m_Writer.LogMessageHandler(le); }
+
+    ezLogWriter::Binary m_Writer;
+  };
+
+  void ReadAllEntries(ezMemoryStreamStorage& storage, ezDynamicArray<ezBinaryLogReader::Entry>& out_entries)
+  {
+    ezMemoryStreamReader stream(&storage);
+
+    ezBinaryLogReader reader;
+    EZ_TEST_BOOL(reader.Open(stream).Succeeded());
+
+    ezBinaryLogReader::Entry entry;
+    while (reader.ReadEntry(entry))
+    {
+      out_entries.PushBack(entry);
+    }
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Logging, BinaryWriter)
+{
+  ezMemoryStreamStorage storage;
+
+  {
+    ezMemoryStreamWriter stream(&storage);
+
+    BinaryLogInterface log;
+    log.m_Writer.BeginLog(stream);
+
+    ezLog::Info(&log, "Plain text");
+    ezLog::Info(&log, "Value {0} of {1}", 1, 10);
+    ezLog::Info(&log, "Value {0} of {1}", 2, 10);
+    ezLog::Warning(&log, "[Tag]Float {}", ezArgF(1.5f, 2));
+
+    {
+      EZ_LOG_BLOCK(&log, "Outer", "Context");
+      ezLog::Error(&log, "Error in {}", "block");
+
+      {
+        EZ_LOG_BLOCK(&log, "Inner");
+        ezLog::Dev(&log, "{} {} {} {} {} {} {} {} {} {}", 0, 1, 2, 3, 4, 5, 6, 7, 8, 9);
+      }
+    }
+
+    ezLog::Success(&log, "Done");
+    log.m_Writer.EndLog();
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Read Entries")
+  {
+    ezDynamicArray<ezBinaryLogReader::Entry> entries;
+    ReadAllEntries(storage, entries);
+
+    if (EZ_TEST_INT(entries.GetCount(), 11).Succeeded())
+    {
+      EZ_TEST_INT(entries[0].m_EventType, ezLogMsgType::InfoMsg);
+      EZ_TEST_STRING(entries[0].m_sText, "Plain text");
+      EZ_TEST_STRING(entries[1].m_sText, "Value 1 of 10");
+      EZ_TEST_STRING(entries[2].m_sText, "Value 2 of 10");
+
+      EZ_TEST_INT(entries[3].m_EventType, ezLogMsgType::WarningMsg);
+      EZ_TEST_STRING(entries[3].m_sText, "Float 1.50");
+      EZ_TEST_STRING(entries[3].m_sTag, "Tag");
+
+      EZ_TEST_INT(entries[4].m_EventType, ezLogMsgType::BeginGroup);
+      EZ_TEST_STRING(entries[4].m_sText, "Outer");
+      EZ_TEST_STRING(entries[4].m_sTag, "Context");
+      EZ_TEST_INT(entries[4].m_uiIndentation, 0);
+
+      EZ_TEST_INT(entries[5].m_EventType, ezLogMsgType::ErrorMsg);
+      EZ_TEST_STRING(entries[5].m_sText, "Error in block");
+      EZ_TEST_INT(entries[5].m_uiIndentation, 1);
+
+      EZ_TEST_INT(entries[6].m_EventType, ezLogMsgType::BeginGroup);
+      EZ_TEST_STRING(entries[6].m_sText, "Inner");
+
+      EZ_TEST_INT(entries[7].m_EventType, ezLogMsgType::DevMsg);
+      EZ_TEST_STRING(entries[7].m_sText, "0 1 2 3 4 5 6 7 8 9");
+      EZ_TEST_INT(entries[7].m_uiIndentation, 2);
+
+      EZ_TEST_INT(entries[8].m_EventType, ezLogMsgType::EndGroup);
+      EZ_TEST_STRING(entries[8].m_sText, "Inner");
+      EZ_TEST_INT(entries[9].m_EventType, ezLogMsgType::EndGroup);
+      EZ_TEST_STRING(entries[9].m_sText, "Outer");
+      EZ_TEST_BOOL(entries[9].m_fSeconds >= entries[8].m_fSeconds);
+
+      EZ_TEST_INT(entries[10].m_EventType, ezLogMsgType::SuccessMsg);
+      EZ_TEST_STRING(entries[10].m_sText, "Done");
+
+      for (const auto& entry : entries)
+      {
+        EZ_TEST_INT(entry.m_uiThreadIndex, 1);
+        EZ_TEST_BOOL(entry.m_uiThreadId == (ezUInt64)ezThreadUtils::GetCurrentThreadID());
+        EZ_TEST_BOOL(entry.m_Timestamp.GetInt64(ezSIUnitOfTime::Microsecond) >= entries[0].m_Timestamp.GetInt64(ezSIUnitOfTime::Microsecond));
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Strings are only stored once")
+  {
+    ezMemoryStreamStorage storage2;
+
+    {
+      ezMemoryStreamWriter stream(&storage2);
+
+      BinaryLogInterface log;
+      log.m_Writer.BeginLog(stream);
+
+      ezLog::Info(&log, "A rather long format string that is only stored once {0}", 1);
+      const ezUInt32 uiSizeAfterFirst = storage2.GetStorageSize();
+
+      ezLog::Info(&log, "A rather long format string that is only stored once {0}", 2);
+      EZ_TEST_BOOL(storage2.GetStorageSize() - uiSizeAfterFirst < 16);
+
+      log.m_Writer.EndLog();
+    }
+
+    ezDynamicArray<ezBinaryLogReader::Entry> entries;
+    ReadAllEntries(storage2, entries);
+
+    if (EZ_TEST_INT(entries.GetCount(), 2).Succeeded())
+    {
+      EZ_TEST_STRING(entries[1].m_sText, "A rather long format string that is only stored once 2");
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Many Plain Texts")
+  {
+    // only the first plain texts are deduplicated, all others are stored inline
+    const ezUInt32 uiNumTexts = 1100;
+
+    ezMemoryStreamStorage storage2;
+
+    {
+      ezMemoryStreamWriter stream(&storage2);
+
+      BinaryLogInterface log;
+      log.m_Writer.BeginLog(stream);
+
+      ezStringBuilder sText;
+      for (ezUInt32 i = 0; i < uiNumTexts; ++i)
+      {
+        sText.Format("Plain text number {0}", i);
+        ezLog::Info(&log, sText);
+      }
+
+      ezLog::Info(&log, "Plain text number 0");
+      const ezUInt32 uiSizeBeforeInline = storage2.GetStorageSize();
+
+      ezLog::Info(&log, "Plain text number 1099");
+      EZ_TEST_BOOL(storage2.GetStorageSize() - uiSizeBeforeInline > ezStringUtils::GetStringElementCount("Plain text number 1099"));
+
+      log.m_Writer.EndLog();
+    }
+
+    ezDynamicArray<ezBinaryLogReader::Entry> entries;
+    ReadAllEntries(storage2, entries);
+
+    if (EZ_TEST_INT(entries.GetCount(), uiNumTexts + 2).Succeeded())
+    {
+      ezStringBuilder sExpected;
+      for (ezUInt32 i = 0; i < uiNumTexts; ++i)
+      {
+        sExpected.Format("Plain text number {0}", i);
+        EZ_TEST_STRING(entries[i].m_sText, sExpected);
+      }
+
+      EZ_TEST_STRING(entries[uiNumTexts].m_sText, "Plain text number 0");
+      EZ_TEST_STRING(entries[uiNumTexts + 1].m_sText, "Plain text number 1099");
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Truncated Log")
+  {
+    ezMemoryStreamStorage truncated;
+
+    {
+      ezMemoryStreamWriter writer(&truncated);
+      writer.WriteBytes(storage.GetData(), storage.GetStorageSize() - 3).IgnoreResult();
+    }
+
+    ezDynamicArray<ezBinaryLogReader::Entry> entries;
+    ReadAllEntries(truncated, entries);
+
+    // the last, incomplete message is dropped
+    EZ_TEST_INT(entries.GetCount(), 10);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Invalid Header")
+  {
+    ezMemoryStreamStorage invalid;
+
+    {
+      ezMemoryStreamWriter writer(&invalid);
+      writer.WriteBytes("EZLOG", 5).IgnoreResult();
+    }
+
+    ezMemoryStreamReader stream(&invalid);
+    ezBinaryLogReader reader;
+    EZ_TEST_BOOL(reader.Open(stream).Failed());
+  }
+}
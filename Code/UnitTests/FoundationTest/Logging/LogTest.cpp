@@ -7,6 +7,8 @@
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Logging/VisualStudioWriter.h>
 #include <Foundation/Threading/Thread.h>
+#include <Foundation/Threading/ThreadSignal.h>
+#include <Foundation/Utilities/ConversionUtils.h>
 #include <TestFramework/Utilities/TestLogInterface.h>
 
 EZ_CREATE_SIMPLE_TEST_GROUP(Logging);
@@ -254,3 +256,187 @@ EZ_CREATE_SIMPLE_TEST(Logging, GlobalTestLog)
     }
   }
 }
+
+namespace
+{
+  class AsyncLogCollector
+  {
+    EZ_DISALLOW_COPY_AND_ASSIGN(AsyncLogCollector);
+
+  public:
+    AsyncLogCollector() { m_WriterID = ezGlobalLog::AddLogWriter(ezMakeDelegate(&AsyncLogCollector::LogMessageHandler, this)); }
+    ~AsyncLogCollector() { ezGlobalLog::RemoveLogWriter(m_WriterID); }
+
+    void LogMessageHandler(const ezLoggingEventData& le)
+    {
+      if (le.m_EventType == ezLogMsgType::WarningMsg && ezStringUtils::FindSubString(le.m_szText, "were dropped") != nullptr)
+      {
+        m_iDroppedReports.Increment();
+        return;
+      }
+
+      if (!ezStringUtils::IsEqual(le.m_szTag, "AsyncTest"))
+        return;
+
+      if (ezStringUtils::IsEqual(le.m_szText, "Block"))
+      {
+        m_bBlocked = true;
+        m_Release.WaitForSignal();
+        return;
+      }
+
+      EZ_LOCK(m_Mutex);
+      m_Messages.PushBack(le.m_szText);
+    }
+
+    ezMutex m_Mutex;
+    ezDynamicArray<ezStringBuilder> m_Messages;
+    ezAtomicInteger32 m_iDroppedReports;
+    ezAtomicBool m_bBlocked;
+    ezThreadSignal m_Release;
+    ezEventSubscriptionID m_WriterID = 0;
+  };
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Logging, AsyncLog)
+{
+  ezLog::GetThreadLocalLogSystem()->SetLogLevel(ezLogMsgType::All);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Order")
+  {
+    AsyncLogCollector collector;
+
+    ezGlobalLog::EnableAsyncMode(64, ezTime::Seconds(10));
+    EZ_TEST_BOOL(ezGlobalLog::IsAsyncModeEnabled());
+
+    ezLog::Info("[AsyncTest]1");
+    ezLog::Warning("[AsyncTest]2");
+    ezLog::Info("[AsyncTest]3");
+
+    // nothing is written before the flush interval has passed
+    EZ_TEST_INT(collector.m_Messages.GetCount(), 0);
+
+    // messages that don't fit into the queue are written immediately, after everything that was logged before
+    // (the same happens for errors, but those would make the test fail)
+    ezStringBuilder sLongMessage;
+    sLongMessage.Append("[AsyncTest]4");
+    for (ezUInt32 i = 0; i < 1000; ++i)
+    {
+      sLongMessage.Append(" ");
+    }
+
+    ezLog::Info(sLongMessage);
+    EZ_TEST_INT(collector.m_Messages.GetCount(), 4);
+    collector.m_Messages[3].Trim(" ");
+
+    ezLog::Info("[AsyncTest]5");
+    ezGlobalLog::FlushAsyncMessages();
+
+    EZ_TEST_INT(collector.m_Messages.GetCount(), 5);
+    for (ezUInt32 i = 0; i < collector.m_Messages.GetCount(); ++i)
+    {
+      ezStringBuilder sExpected;
+      sExpected.Format("{0}", i + 1);
+      EZ_TEST_STRING(collector.m_Messages[i], sExpected);
+    }
+
+    ezGlobalLog::DisableAsyncMode();
+    EZ_TEST_BOOL(!ezGlobalLog::IsAsyncModeEnabled());
+
+    // synchronous again
+    ezLog::Info("[AsyncTest]6");
+    EZ_TEST_INT(collector.m_Messages.GetCount(), 6);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Drop Messages")
+  {
+    AsyncLogCollector collector;
+
+    const ezUInt64 uiDroppedBefore = ezGlobalLog::GetDroppedMessageCount();
+
+    ezGlobalLog::EnableAsyncMode(4, ezTime::Milliseconds(1));
+
+    // keep the writer thread busy, so that the queue fills up
+    ezLog::Info("[AsyncTest]Block");
+    while (!collector.m_bBlocked)
+    {
+      ezThreadUtils::YieldTimeSlice();
+    }
+
+    // one slot is still occupied by the blocking message
+    for (ezUInt32 i = 0; i < 10; ++i)
+    {
+      ezLog::Info("[AsyncTest]Info {0}", i);
+    }
+
+    EZ_TEST_INT(ezGlobalLog::GetDroppedMessageCount() - uiDroppedBefore, 7);
+
+    collector.m_Release.RaiseSignal();
+    ezGlobalLog::DisableAsyncMode();
+
+    EZ_TEST_INT(collector.m_Messages.GetCount(), 3);
+    EZ_TEST_INT(collector.m_iDroppedReports, 1);
+    EZ_TEST_INT(ezGlobalLog::GetDroppedMessageCount() - uiDroppedBefore, 7);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Multiple Threads")
+  {
+    constexpr ezUInt32 uiThreads = 4;
+    constexpr ezUInt32 uiMessages = 250;
+
+    AsyncLogCollector collector;
+
+    ezGlobalLog::EnableAsyncMode(uiThreads * uiMessages, ezTime::Milliseconds(1));
+
+    class LogThread : public ezThread
+    {
+    public:
+      ezUInt32 m_uiIndex = 0;
+
+      virtual ezUInt32 Run() override
+      {
+        for (ezUInt32 i = 0; i < uiMessages; ++i)
+        {
+          ezLog::Info("[AsyncTest]{0} {1}", m_uiIndex, i);
+        }
+        return 0;
+      }
+    };
+
+    LogThread threads[uiThreads];
+    for (ezUInt32 i = 0; i < uiThreads; ++i)
+    {
+      threads[i].m_uiIndex = i;
+      threads[i].Start();
+    }
+
+    for (ezUInt32 i = 0; i < uiThreads; ++i)
+    {
+      threads[i].Join();
+    }
+
+    ezGlobalLog::DisableAsyncMode();
+
+    EZ_TEST_INT(collector.m_Messages.GetCount(), uiThreads * uiMessages);
+
+    // the messages of each thread arrive in order
+    ezUInt32 uiNextMessage[uiThreads] = {};
+    for (const ezStringBuilder& sMessage : collector.m_Messages)
+    {
+      ezInt32 iThread = 0, iMessage = 0;
+      const char* szPos = nullptr;
+      ezConversionUtils::StringToInt(sMessage, iThread, &szPos).IgnoreResult();
+      ezConversionUtils::StringToInt(szPos, iMessage).IgnoreResult();
+
+      const ezUInt32 uiThread = static_cast<ezUInt32>(iThread);
+      const ezUInt32 uiMessage = static_cast<ezUInt32>(iMessage);
+
+      EZ_TEST_BOOL(uiThread < uiThreads);
+      if (uiThread >= uiThreads)
+        break;
+
+      EZ_TEST_INT(uiMessage, uiNextMessage[uiThread]);
+      uiNextMessage[uiThread] = uiMessage + 1;
+    }
+  }
+}
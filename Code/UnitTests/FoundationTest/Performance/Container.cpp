@@ -1,6 +1,8 @@
 #include <FoundationTestPCH.h>
 
+#include <Foundation/Containers/BTreeMap.h>
 #include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Containers/Map.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Reflection/Reflection.h>
 #include <Foundation/Strings/String.h>
@@ -75,6 +77,45 @@ namespace
 
   ezUInt32 SomeBigObject::constructionCount = 0;
   ezUInt32 SomeBigObject::destructionCount = 0;
+
+  template <typename MapType>
+  void BenchmarkOrderedMap(const char* szName, const ezDynamicArray<ezUInt32>& keys)
+  {
+    const ezUInt32 uiSize = keys.GetCount();
+    ezUInt32 sum = 0;
+
+    MapType map;
+
+    ezTime t0 = ezTime::Now();
+    for (ezUInt32 i = 0; i < uiSize; ++i)
+    {
+      map.Insert(keys[i], i);
+    }
+
+    ezTime t1 = ezTime::Now();
+    for (ezUInt32 i = 0; i < uiSize; ++i)
+    {
+      sum += map.Find(keys[i]).Value();
+    }
+
+    ezTime t2 = ezTime::Now();
+    for (auto it = map.GetIterator(); it.IsValid(); ++it)
+    {
+      sum += it.Value();
+    }
+
+    ezTime t3 = ezTime::Now();
+    for (ezUInt32 i = 0; i < uiSize; i += 2)
+    {
+      map.Remove(keys[i]);
+    }
+
+    ezTime t4 = ezTime::Now();
+
+    ezLog::Info("[test]{0} size = {1} => Insert {2}ms, Find {3}ms, Iterate {4}ms, Remove {5}ms", szName, uiSize,
+      ezArgF((t1 - t0).GetMilliseconds(), 4), ezArgF((t2 - t1).GetMilliseconds(), 4), ezArgF((t3 - t2).GetMilliseconds(), 4),
+      ezArgF((t4 - t3).GetMilliseconds(), 4), sum);
+  }
 } // namespace
 
 // Enable when needed
@@ -423,4 +464,23 @@ EZ_CREATE_SIMPLE_TEST(Performance, Container)
         ezArgF((t1 - t0).GetMilliseconds() / static_cast<double>(NUM_SAMPLES), 4), sum);
     }
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::DisabledNoWarning, "ezMap vs. ezBTreeMap<ezUInt32, ezUInt32>")
+  {
+    for (ezUInt32 size = 1000; size <= 10000000; size *= 10)
+    {
+      ezDynamicArray<ezUInt32> keys;
+      keys.SetCountUninitialized(size);
+
+      ezUInt32 uiSeed = 1;
+      for (ezUInt32 i = 0; i < size; ++i)
+      {
+        uiSeed = uiSeed * 1664525u + 1013904223u;
+        keys[i] = uiSeed;
+      }
+
+      BenchmarkOrderedMap<ezMap<ezUInt32, ezUInt32>>("ezMap", keys);
+      BenchmarkOrderedMap<ezBTreeMap<ezUInt32, ezUInt32>>("ezBTreeMap", keys);
+    }
+  }
 }
@@ -0,0 +1,87 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/IO/OpenDdlPullReader.h>
+#include <Foundation/IO/OpenDdlReader.h>
+#include <Foundation/IO/OpenDdlUtils.h>
+#include <Foundation/IO/OpenDdlWriter.h>
+#include <Foundation/Time/Time.h>
+
+EZ_CREATE_SIMPLE_TEST(Performance, DdlReader)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Benchmark, "DOM vs. Pull")
+  {
+    constexpr ezUInt32 uiObjects = 20000;
+    constexpr ezUInt32 uiIterations = 10;
+
+    ezMemoryStreamStorage storage;
+
+    {
+      ezMemoryStreamWriter writer(&storage);
+
+      ezOpenDdlWriter ddl;
+      ddl.SetOutputStream(&writer);
+      ddl.SetCompactMode(true);
+
+      ezStringBuilder sName;
+      for (ezUInt32 i = 0; i < uiObjects; ++i)
+      {
+        sName.Format("Object{0}", i);
+
+        ddl.BeginObject("o");
+        ezOpenDdlUtils::StoreString(ddl, sName, "n");
+        ezOpenDdlUtils::StoreVec3(ddl, ezVec3((float)i, 1.0f, 2.0f), "p");
+        ezOpenDdlUtils::StoreQuat(ddl, ezQuat::IdentityQuaternion(), "r");
+        ezOpenDdlUtils::StoreString(ddl, "SomeMesh.ezMesh", "m");
+        ddl.EndObject();
+      }
+    }
+
+    const ezArrayPtr<const ezUInt8> data(storage.GetData(), storage.GetStorageSize());
+
+    ezTime tDom, tPull;
+    ezUInt32 uiDomStrings = 0, uiPullStrings = 0;
+
+    {
+      ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiIterations; ++i)
+      {
+        ezMemoryStreamReader reader(&storage);
+
+        ezOpenDdlReader doc;
+        EZ_TEST_BOOL(doc.ParseDocument(reader).Succeeded());
+
+        for (auto pObj = doc.GetRootElement()->GetFirstChild(); pObj != nullptr; pObj = pObj->GetSibling())
+        {
+          for (auto pChild = pObj->GetFirstChild(); pChild != nullptr; pChild = pChild->GetSibling())
+          {
+            if (pChild->GetPrimitivesType() == ezOpenDdlPrimitiveType::String)
+              uiDomStrings += pChild->GetNumPrimitives();
+          }
+        }
+      }
+      tDom = ezTime::Now() - t0;
+    }
+
+    {
+      ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiIterations; ++i)
+      {
+        ezOpenDdlPullReader reader;
+        reader.SetInput(data);
+
+        while (reader.Next() != ezOpenDdlPullReader::Event::EndOfDocument)
+        {
+          if (reader.GetEvent() == ezOpenDdlPullReader::Event::Primitives && reader.GetPrimitivesType() == ezOpenDdlPrimitiveType::String)
+            uiPullStrings += reader.GetPrimitivesString().GetCount();
+        }
+      }
+      tPull = ezTime::Now() - t0;
+    }
+
+    EZ_TEST_INT(uiDomStrings, uiPullStrings);
+
+    ezLog::Info("[test]DDL {0} KB: DOM {1}ms, Pull {2}ms", data.GetCount() / 1024, ezArgF(tDom.GetMilliseconds() / uiIterations, 2),
+      ezArgF(tPull.GetMilliseconds() / uiIterations, 2));
+  }
+}
@@ -0,0 +1,121 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Time/Time.h>
+#include <Foundation/Types/UniquePtr.h>
+
+namespace
+{
+  class HashedStringBenchmarkThread : public ezThread
+  {
+  public:
+    HashedStringBenchmarkThread(const ezDynamicArray<ezString>& strings, ezUInt32 uiIterations)
+      : ezThread("HashedString Benchmark Thread")
+      , m_Strings(strings)
+      , m_uiIterations(uiIterations)
+    {
+    }
+
+  private:
+    virtual ezUInt32 Run() override
+    {
+      ezHashedString s;
+
+      for (ezUInt32 uiIteration = 0; uiIteration < m_uiIterations; ++uiIteration)
+      {
+        for (const ezString& sString : m_Strings)
+        {
+          s.Assign(sString.GetData());
+        }
+      }
+
+      return 0;
+    }
+
+    const ezDynamicArray<ezString>& m_Strings;
+    ezUInt32 m_uiIterations;
+  };
+
+  void BenchmarkAssign(const char* szName, const ezDynamicArray<ezDynamicArray<ezString>>& stringsPerThread, ezUInt32 uiIterations)
+  {
+    ezDynamicArray<ezUniquePtr<HashedStringBenchmarkThread>> threads;
+
+    for (const ezDynamicArray<ezString>& strings : stringsPerThread)
+    {
+      threads.PushBack(EZ_DEFAULT_NEW(HashedStringBenchmarkThread, strings, uiIterations));
+    }
+
+    ezTime t0 = ezTime::Now();
+
+    for (auto& pThread : threads)
+      pThread->Start();
+
+    for (auto& pThread : threads)
+      pThread->Join();
+
+    ezTime t1 = ezTime::Now();
+
+    const ezUInt32 uiNumAssigns = threads.GetCount() * stringsPerThread[0].GetCount() * uiIterations;
+    ezLog::Info("[test]{0} threads = {1} => {2}ms ({3} assigns/ms)", szName, threads.GetCount(), ezArgF((t1 - t0).GetMilliseconds(), 4),
+      ezArgF(uiNumAssigns / (t1 - t0).GetMilliseconds(), 1));
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Performance, HashedString)
+{
+  EZ_TEST_BLOCK(ezTestBlock::DisabledNoWarning, "Multi-threaded Assign")
+  {
+    constexpr ezUInt32 uiNumStrings = 10000;
+    ezStringBuilder sb;
+
+    for (ezUInt32 uiNumThreads = 1; uiNumThreads <= 16; uiNumThreads *= 2)
+    {
+      // all threads look up the same existing strings
+      {
+        ezDynamicArray<ezDynamicArray<ezString>> stringsPerThread;
+        stringsPerThread.SetCount(uiNumThreads);
+
+        for (ezUInt32 t = 0; t < uiNumThreads; ++t)
+        {
+          for (ezUInt32 i = 0; i < uiNumStrings; ++i)
+          {
+            sb.Format("Shared String {}", i);
+            stringsPerThread[t].PushBack(sb);
+          }
+        }
+
+        ezHashedString s;
+        for (const ezString& sString : stringsPerThread[0])
+        {
+          s.Assign(sString.GetData());
+        }
+
+        BenchmarkAssign("Lookup existing", stringsPerThread, 100);
+      }
+
+      // every thread creates its own new strings
+      {
+        ezDynamicArray<ezDynamicArray<ezString>> stringsPerThread;
+        stringsPerThread.SetCount(uiNumThreads);
+
+        for (ezUInt32 t = 0; t < uiNumThreads; ++t)
+        {
+          for (ezUInt32 i = 0; i < uiNumStrings; ++i)
+          {
+            sb.Format("Thread {} String {}", t, i);
+            stringsPerThread[t].PushBack(sb);
+          }
+        }
+
+        BenchmarkAssign("Create new", stringsPerThread, 1);
+      }
+
+#if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
+      ezHashedString::ClearUnusedStrings();
+#endif
+    }
+  }
+}
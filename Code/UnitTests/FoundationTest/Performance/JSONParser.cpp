@@ -0,0 +1,172 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/IO/JSONCursor.h>
+#include <Foundation/IO/JSONReader.h>
+#include <Foundation/IO/JSONWriter.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Time/Time.h>
+
+namespace
+{
+  ezUInt32 CountStrings(const ezVariant& value);
+
+  ezUInt32 CountStrings(const ezVariantDictionary& dictionary)
+  {
+    ezUInt32 uiCount = 0;
+    for (auto it = dictionary.GetIterator(); it.IsValid(); ++it)
+      uiCount += CountStrings(it.Value());
+    return uiCount;
+  }
+
+  ezUInt32 CountStrings(const ezVariant& value)
+  {
+    switch (value.GetType())
+    {
+      case ezVariantType::String:
+        return 1;
+
+      case ezVariantType::VariantArray:
+      {
+        ezUInt32 uiCount = 0;
+        for (const ezVariant& element : value.Get<ezVariantArray>())
+          uiCount += CountStrings(element);
+        return uiCount;
+      }
+
+      case ezVariantType::VariantDictionary:
+        return CountStrings(value.Get<ezVariantDictionary>());
+
+      default:
+        return 0;
+    }
+  }
+
+  ezUInt32 CountStrings(ezJSONCursor& json)
+  {
+    switch (json.GetValueType())
+    {
+      case ezJSONCursor::ValueType::String:
+      {
+        ezStringView sValue;
+        json.ReadString(sValue).IgnoreResult();
+        return 1;
+      }
+
+      case ezJSONCursor::ValueType::Number:
+      {
+        double fValue;
+        json.ReadDouble(fValue).IgnoreResult();
+        return 0;
+      }
+
+      case ezJSONCursor::ValueType::Array:
+      {
+        ezUInt32 uiCount = 0;
+        json.BeginArray();
+        while (json.NextElement())
+          uiCount += CountStrings(json);
+        return uiCount;
+      }
+
+      case ezJSONCursor::ValueType::Object:
+      {
+        ezUInt32 uiCount = 0;
+        ezStringView sKey;
+        json.BeginObject();
+        while (json.NextMember(sKey))
+          uiCount += CountStrings(json);
+        return uiCount;
+      }
+
+      default:
+        json.SkipValue();
+        return 0;
+    }
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Performance, JSONParser)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Benchmark, "Stream vs. Buffer vs. Cursor")
+  {
+    constexpr ezUInt32 uiObjects = 10000;
+    constexpr ezUInt32 uiIterations = 3;
+
+    ezMemoryStreamStorage storage;
+
+    {
+      ezMemoryStreamWriter writer(&storage);
+
+      ezStandardJSONWriter json;
+      json.SetOutputStream(&writer);
+      json.BeginObject();
+      json.BeginArray("objects");
+
+      ezStringBuilder sName;
+      for (ezUInt32 i = 0; i < uiObjects; ++i)
+      {
+        sName.Format("Object{0}", i);
+
+        json.BeginObject();
+        json.AddVariableString("name", sName);
+        json.AddVariableVec3("position", ezVec3((float)i, 1.5f, -2.25f));
+        json.AddVariableQuat("rotation", ezQuat::IdentityQuaternion());
+        json.AddVariableString("mesh", "Meshes/Some \"Quoted\" Mesh.ezMesh");
+        json.AddVariableBool("visible", (i & 1) != 0);
+        json.AddVariableUInt32("layer", i % 7);
+        json.EndObject();
+      }
+
+      json.EndArray();
+      json.EndObject();
+    }
+
+    const ezArrayPtr<const ezUInt8> data(storage.GetData(), storage.GetStorageSize());
+
+    ezTime tStream, tBuffer, tCursor;
+    ezUInt32 uiStreamStrings = 0, uiBufferStrings = 0, uiCursorStrings = 0;
+
+    {
+      ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiIterations; ++i)
+      {
+        ezMemoryStreamReader reader(&storage);
+
+        ezJSONReader json;
+        EZ_TEST_BOOL(json.Parse(reader).Succeeded());
+        uiStreamStrings += CountStrings(json.GetTopLevelObject());
+      }
+      tStream = ezTime::Now() - t0;
+    }
+
+    {
+      ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiIterations; ++i)
+      {
+        ezJSONReader json;
+        EZ_TEST_BOOL(json.Parse(data).Succeeded());
+        uiBufferStrings += CountStrings(json.GetTopLevelObject());
+      }
+      tBuffer = ezTime::Now() - t0;
+    }
+
+    {
+      ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiIterations; ++i)
+      {
+        ezJSONCursor json;
+        EZ_TEST_BOOL(json.SetInput(data).Succeeded());
+        uiCursorStrings += CountStrings(json);
+        EZ_TEST_BOOL(!json.HadError());
+      }
+      tCursor = ezTime::Now() - t0;
+    }
+
+    EZ_TEST_INT(uiStreamStrings, uiBufferStrings);
+    EZ_TEST_INT(uiStreamStrings, uiCursorStrings);
+
+    ezLog::Info("[test]JSON {0} KB: Stream {1}ms, Buffer {2}ms, Cursor {3}ms", data.GetCount() / 1024,
+      ezArgF(tStream.GetMilliseconds() / uiIterations, 2), ezArgF(tBuffer.GetMilliseconds() / uiIterations, 2),
+      ezArgF(tCursor.GetMilliseconds() / uiIterations, 2));
+  }
+}
@@ -0,0 +1,75 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Logging/BinaryWriter.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Time/Time.h>
+
+namespace
+{
+  /// Writes the messages the way the text based writers do, with a timestamp in front of every line.
+  class TextLogInterface : public ezLogInterface
+  {
+  public:
+    virtual void HandleLogMessage(const ezLoggingEventData& le) override
+    {
+      ezLog::GenerateFormattedTimestamp(ezLog::TimestampMode::Numeric, m_sLine);
+      m_sLine.Append(le.m_szText, "\n");
+      m_pStream->WriteBytes(m_sLine.GetData(), m_sLine.GetElementCount()).IgnoreResult();
+    }
+
+    ezStreamWriter* m_pStream = nullptr;
+    ezStringBuilder m_sLine;
+  };
+
+  class BinaryLogInterface : public ezLogInterface
+  {
+  public:
+    virtual void HandleLogMessage(const ezLoggingEventData& le) override { m_Writer.LogMessageHandler(le); }
+
+    ezLogWriter::Binary m_Writer;
+  };
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Performance, Logging)
+{
+  EZ_TEST_BLOCK(ezTestBlock::DisabledNoWarning, "Text vs. Binary")
+  {
+    constexpr ezUInt32 uiMessages = 100000;
+
+    auto logMessages = [&](ezLogInterface* pLog) -> ezTime {
+      const ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiMessages; ++i)
+      {
+        ezLog::Info(pLog, "Loaded resource '{0}' in {1} ms ({2} bytes)", "Textures/Environment/Sky.dds", ezArgF(i * 0.01, 2), i * 17);
+      }
+      return ezTime::Now() - t0;
+    };
+
+    ezMemoryStreamStorage textStorage;
+    ezMemoryStreamStorage binaryStorage;
+
+    ezTime tText, tBinary;
+
+    {
+      ezMemoryStreamWriter stream(&textStorage);
+
+      TextLogInterface log;
+      log.m_pStream = &stream;
+      tText = logMessages(&log);
+    }
+
+    {
+      ezMemoryStreamWriter stream(&binaryStorage);
+
+      BinaryLogInterface log;
+      log.m_Writer.BeginLog(stream);
+      tBinary = logMessages(&log);
+      log.m_Writer.EndLog();
+    }
+
+    ezLog::Info("[test]Logging {0} messages: text {1}ns / {2} bytes per message, binary {3}ns / {4} bytes per message", uiMessages,
+      ezArgF(tText.GetNanoseconds() / uiMessages, 1), ezArgF((double)textStorage.GetStorageSize() / uiMessages, 1),
+      ezArgF(tBinary.GetNanoseconds() / uiMessages, 1), ezArgF((double)binaryStorage.GetStorageSize() / uiMessages, 1));
+  }
+}
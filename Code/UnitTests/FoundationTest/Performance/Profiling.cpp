@@ -0,0 +1,40 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Time/Time.h>
+
+EZ_CREATE_SIMPLE_TEST(Performance, Profiling)
+{
+  EZ_TEST_BLOCK(ezTestBlock::DisabledNoWarning, "Record Scopes")
+  {
+    constexpr ezUInt32 uiScopes = 1000000;
+
+    const ezTime oldThreshold = ezProfilingSystem::GetDiscardThreshold();
+    ezProfilingSystem::SetDiscardThreshold(ezTime::Zero());
+
+    auto recordScopes = [&]() -> ezTime {
+      const ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiScopes; ++i)
+      {
+        ezProfilingSystem::AddCPUScope("Scope", EZ_SOURCE_FUNCTION, t0, t0);
+      }
+      return ezTime::Now() - t0;
+    };
+
+    const ezTime tIdle = recordScopes();
+
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+
+    ezProfilingSystem::StartStreamingCapture(writer, ezTime::Milliseconds(1));
+    const ezTime tStreaming = recordScopes();
+    ezProfilingSystem::StopStreamingCapture();
+
+    ezProfilingSystem::SetDiscardThreshold(oldThreshold);
+
+    ezLog::Info("[test]Profiling {0} scopes: {1}ns per scope, {2}ns per scope while streaming ({3} KB written, {4} scopes lost)", uiScopes,
+      ezArgF(tIdle.GetNanoseconds() / uiScopes, 1), ezArgF(tStreaming.GetNanoseconds() / uiScopes, 1), storage.GetStorageSize() / 1024,
+      ezProfilingSystem::GetStreamingCaptureLostScopes());
+  }
+}
@@ -0,0 +1,134 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Serialization/AbstractObjectGraph.h>
+#include <Foundation/Serialization/BinarySerializer.h>
+#include <Foundation/Serialization/ReflectionBinarySerializer.h>
+#include <Foundation/Serialization/RttiConverter.h>
+#include <Foundation/Time/Time.h>
+#include <FoundationTest/Reflection/ReflectionTestClasses.h>
+
+namespace
+{
+  void WriteGraph(ezStreamWriter& stream, const ezRTTI* pRtti, const void* pObject)
+  {
+    ezAbstractObjectGraph graph;
+    ezRttiConverterContext context;
+    ezRttiConverterWriter conv(&graph, &context, false, true);
+
+    ezUuid guid;
+    guid.CreateNewUuid();
+    context.RegisterObject(guid, pRtti, const_cast<void*>(pObject));
+    conv.AddObjectToGraph(pRtti, const_cast<void*>(pObject), "root");
+
+    ezAbstractGraphBinarySerializer::Write(stream, &graph);
+  }
+
+  void ReadGraph(ezStreamReader& stream, const ezRTTI* pRtti, void* pObject)
+  {
+    ezAbstractObjectGraph graph;
+    ezAbstractGraphBinarySerializer::Read(stream, &graph);
+
+    ezRttiConverterContext context;
+    ezRttiConverterReader convRead(&graph, &context);
+    auto* pRootNode = graph.GetNodeByName("root");
+
+    convRead.ApplyPropertiesToObject(pRootNode, pRtti, pObject);
+  }
+
+  template <typename T>
+  void Benchmark(const char* szName, const T& object, ezUInt32 uiIterations)
+  {
+    const ezRTTI* pRtti = ezGetStaticRTTI<T>();
+
+    ezMemoryStreamStorage graphStorage;
+    ezMemoryStreamStorage directStorage;
+
+    ezTime tWriteGraph, tWriteDirect, tReadGraph, tReadDirect;
+
+    {
+      ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiIterations; ++i)
+      {
+        graphStorage.Clear();
+        ezMemoryStreamWriter writer(&graphStorage);
+        WriteGraph(writer, pRtti, &object);
+      }
+      tWriteGraph = ezTime::Now() - t0;
+    }
+
+    {
+      ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiIterations; ++i)
+      {
+        directStorage.Clear();
+        ezMemoryStreamWriter writer(&directStorage);
+        ezReflectionBinarySerializer::WriteObject(writer, pRtti, &object).IgnoreResult();
+      }
+      tWriteDirect = ezTime::Now() - t0;
+    }
+
+    {
+      ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiIterations; ++i)
+      {
+        T target;
+        ezMemoryStreamReader reader(&graphStorage);
+        ReadGraph(reader, pRtti, &target);
+      }
+      tReadGraph = ezTime::Now() - t0;
+    }
+
+    {
+      ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiIterations; ++i)
+      {
+        T target;
+        ezMemoryStreamReader reader(&directStorage);
+        ezReflectionBinarySerializer::ReadObjectProperties(reader, *pRtti, &target).IgnoreResult();
+      }
+      tReadDirect = ezTime::Now() - t0;
+    }
+
+    ezLog::Info("[test]{0}: Graph {1} bytes, write {2}ms, read {3}ms", szName, graphStorage.GetStorageSize(),
+      ezArgF(tWriteGraph.GetMilliseconds(), 2), ezArgF(tReadGraph.GetMilliseconds(), 2));
+    ezLog::Info("[test]{0}: Direct {1} bytes, write {2}ms, read {3}ms", szName, directStorage.GetStorageSize(),
+      ezArgF(tWriteDirect.GetMilliseconds(), 2), ezArgF(tReadDirect.GetMilliseconds(), 2));
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Performance, ReflectionSerializer)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Benchmark, "Graph vs. Direct")
+  {
+    constexpr ezUInt32 uiIterations = 10000;
+
+    {
+      ezTestClass2 object;
+      object.m_Color = ezColor::Yellow;
+      object.m_Time = ezTime::Seconds(22.2f);
+      object.m_enumClass = ezExampleEnum::Value3;
+      object.m_Variant = ezVec4(1, 2, 3, 4);
+      object.SetText("LALALALA");
+
+      for (ezUInt32 i = 0; i < 16; ++i)
+        object.m_array.PushBack((float)i);
+
+      Benchmark("ezTestClass2", object, uiIterations);
+    }
+
+    {
+      ezTestArrays object;
+
+      for (ezUInt32 i = 0; i < 64; ++i)
+      {
+        object.m_Hybrid.PushBack(i * 0.5);
+        object.m_HybridChar.PushBack("Test");
+        object.m_Dynamic.PushBack(ezTestStruct3(i * 2.0, static_cast<ezInt16>(i)));
+      }
+
+      Benchmark("ezTestArrays", object, uiIterations / 10);
+    }
+  }
+}
@@ -0,0 +1,105 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Algorithm/Sorting.h>
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Time/Time.h>
+
+namespace
+{
+  struct SortableItem
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt64 m_uiSortingKey;
+    void* m_pData;
+  };
+
+  struct SortableItemComparer
+  {
+    EZ_ALWAYS_INLINE bool Less(const SortableItem& a, const SortableItem& b) const { return a.m_uiSortingKey < b.m_uiSortingKey; }
+  };
+
+  template <typename SortFunc>
+  void BenchmarkSort(const char* szName, const ezDynamicArray<SortableItem>& source, SortFunc sortFunc)
+  {
+    ezDynamicArray<SortableItem> items = source;
+
+    ezTime t0 = ezTime::Now();
+    sortFunc(items);
+    ezTime t1 = ezTime::Now();
+
+    bool bSorted = true;
+    for (ezUInt32 i = 1; i < items.GetCount(); ++i)
+    {
+      bSorted &= items[i - 1].m_uiSortingKey <= items[i].m_uiSortingKey;
+    }
+
+    EZ_TEST_BOOL(bSorted);
+    ezLog::Info("[test]{0} size = {1} => {2}ms", szName, items.GetCount(), ezArgF((t1 - t0).GetMilliseconds(), 4));
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Performance, Sorting)
+{
+  EZ_TEST_BLOCK(ezTestBlock::DisabledNoWarning, "Sorting 64 bit keys")
+  {
+    for (ezUInt32 uiSize = 10000; uiSize <= 10000000; uiSize *= 10)
+    {
+      ezDynamicArray<SortableItem> source;
+      source.SetCountUninitialized(uiSize);
+
+      ezUInt64 uiSeed = 1;
+      for (ezUInt32 i = 0; i < uiSize; ++i)
+      {
+        uiSeed = uiSeed * 6364136223846793005ull + 1442695040888963407ull;
+        source[i].m_uiSortingKey = uiSeed;
+        source[i].m_pData = nullptr;
+      }
+
+      BenchmarkSort("QuickSort", source, [](ezDynamicArray<SortableItem>& items) { items.Sort(SortableItemComparer()); });
+      BenchmarkSort("MergeSort", source, [](ezDynamicArray<SortableItem>& items) { ezSorting::MergeSort(items.GetArrayPtr(), SortableItemComparer()); });
+      BenchmarkSort("ParallelMergeSort", source,
+        [](ezDynamicArray<SortableItem>& items) { ezSorting::ParallelMergeSort(items.GetArrayPtr(), SortableItemComparer()); });
+      BenchmarkSort("RadixSort", source,
+        [](ezDynamicArray<SortableItem>& items) { ezSorting::RadixSort(items.GetArrayPtr(), [](const SortableItem& item) { return item.m_uiSortingKey; }); });
+      BenchmarkSort("ParallelRadixSort", source, [](ezDynamicArray<SortableItem>& items) {
+        ezSorting::ParallelRadixSort(items.GetArrayPtr(), [](const SortableItem& item) { return item.m_uiSortingKey; });
+      });
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Benchmark, "Sorting 100000 keys")
+  {
+    constexpr ezUInt32 uiSize = 100000;
+
+    ezDynamicArray<SortableItem> source;
+    source.SetCountUninitialized(uiSize);
+
+    ezUInt64 uiSeed = 1;
+    for (ezUInt32 i = 0; i < uiSize; ++i)
+    {
+      uiSeed = uiSeed * 6364136223846793005ull + 1442695040888963407ull;
+      source[i].m_uiSortingKey = uiSeed;
+      source[i].m_pData = nullptr;
+    }
+
+    // every run has to start with unsorted data, copying it is cheap compared to sorting
+    ezDynamicArray<SortableItem> items;
+
+    EZ_TEST_BENCHMARK("QuickSort", [&]() {
+      items = source;
+      items.Sort(SortableItemComparer());
+    });
+
+    EZ_TEST_BENCHMARK("MergeSort", [&]() {
+      items = source;
+      ezSorting::MergeSort(items.GetArrayPtr(), SortableItemComparer());
+    });
+
+    EZ_TEST_BENCHMARK("RadixSort", [&]() {
+      items = source;
+      ezSorting::RadixSort(items.GetArrayPtr(), [](const SortableItem& item) { return item.m_uiSortingKey; });
+    });
+  }
+}
@@ -0,0 +1,75 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Time/Time.h>
+#include <Foundation/Utilities/Stats.h>
+
+EZ_CREATE_SIMPLE_TEST(Performance, Stats)
+{
+  EZ_TEST_BLOCK(ezTestBlock::DisabledNoWarning, "Update Stats")
+  {
+    constexpr ezUInt32 uiUpdates = 1000000;
+
+    // this is what code had to do before, to get a per-object stat
+    ezTime tSetStat;
+    {
+      const ezTime t0 = ezTime::Now();
+      ezStringBuilder sStatName;
+      for (ezUInt32 i = 0; i < uiUpdates; ++i)
+      {
+        sStatName.Format("Performance/{0}/Value", "Stats");
+        ezStats::SetStat(sStatName, i);
+      }
+      tSetStat = ezTime::Now() - t0;
+    }
+
+    ezStatsCounter counter("Performance/Stats/Counter");
+    ezStatsGauge gauge("Performance/Stats/Gauge");
+    ezStatsHistogram histogram("Performance/Stats/Histogram");
+
+    ezTime tCounter, tGauge, tHistogram;
+    {
+      const ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiUpdates; ++i)
+      {
+        counter.Increment();
+      }
+      tCounter = ezTime::Now() - t0;
+    }
+    {
+      const ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiUpdates; ++i)
+      {
+        gauge.Set(i);
+      }
+      tGauge = ezTime::Now() - t0;
+    }
+    {
+      const ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiUpdates; ++i)
+      {
+        histogram.Record(i);
+      }
+      tHistogram = ezTime::Now() - t0;
+    }
+
+    ezTime tFlush;
+    {
+      const ezTime t0 = ezTime::Now();
+      ezStats::FlushMetrics();
+      tFlush = ezTime::Now() - t0;
+    }
+
+    ezLog::Info("[test]Stats {0} updates: SetStat {1}ns, Counter {2}ns, Gauge {3}ns, Histogram {4}ns per update, FlushMetrics {5}us", uiUpdates,
+      ezArgF(tSetStat.GetNanoseconds() / uiUpdates, 1), ezArgF(tCounter.GetNanoseconds() / uiUpdates, 1),
+      ezArgF(tGauge.GetNanoseconds() / uiUpdates, 1), ezArgF(tHistogram.GetNanoseconds() / uiUpdates, 1),
+      ezArgF(tFlush.GetMicroseconds(), 1));
+
+    for (const char* szStat : {"Value", "Counter", "Gauge", "Histogram/Count", "Histogram/Mean", "Histogram/P50", "Histogram/P90",
+           "Histogram/P99", "Histogram/Max"})
+    {
+      ezStringBuilder sName;
+      sName.Set("Performance/Stats/", szStat);
+      ezStats::RemoveStat(sName);
+    }
+  }
+}
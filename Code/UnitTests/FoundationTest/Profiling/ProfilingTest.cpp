@@ -2,7 +2,9 @@
 
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/Thread.h>
 #include <Foundation/Threading/ThreadUtils.h>
 
 namespace
@@ -21,6 +23,51 @@ namespace
       ezLog::Info("Profiling capture saved to '{0}'.", fileWriter.GetFilePathAbsolute().GetData());
     }
   }
+
+  void ProfileBusyScope(const char* szName)
+  {
+    EZ_PROFILE_SCOPE(szName);
+
+    const ezTime endTime = ezTime::Now() + ezTime::Milliseconds(1);
+    while (ezTime::Now() < endTime)
+    {
+    }
+  }
+
+  class ProfilingTestThread : public ezThread
+  {
+  public:
+    ProfilingTestThread()
+      : ezThread("Profiling Test Thread")
+    {
+    }
+
+  private:
+    virtual ezUInt32 Run() override
+    {
+      for (ezUInt32 i = 0; i < 10; ++i)
+      {
+        ProfileBusyScope("Thread scope");
+      }
+
+      return 0;
+    }
+  };
+
+  ezUInt32 CountScopes(const ezProfilingSystem::ProfilingData& data, const char* szName)
+  {
+    ezUInt32 uiCount = 0;
+    for (const auto& buffer : data.m_AllEventBuffers)
+    {
+      for (const auto& scope : buffer.m_Data)
+      {
+        if (ezStringUtils::IsEqual(scope.m_szName, szName))
+          ++uiCount;
+      }
+    }
+
+    return uiCount;
+  }
 } // namespace
 
 EZ_CREATE_SIMPLE_TEST_GROUP(Profiling);
@@ -52,4 +99,155 @@ EZ_CREATE_SIMPLE_TEST(Profiling, Profiling)
 
     WriteOutProfilingCapture(":output/profilingScopes.json");
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Clear")
+  {
+    ProfileBusyScope("Before clear");
+
+    ezProfilingSystem::ProfilingData profilingData;
+    ezProfilingSystem::Capture(profilingData, true);
+    EZ_TEST_BOOL(CountScopes(profilingData, "Before clear") > 0);
+
+    ProfileBusyScope("After clear");
+
+    ezProfilingSystem::Capture(profilingData);
+    EZ_TEST_INT(CountScopes(profilingData, "Before clear"), 0);
+    EZ_TEST_INT(CountScopes(profilingData, "After clear"), 1);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Streaming Capture")
+  {
+    ProfileBusyScope("Not streamed");
+
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+
+    ezProfilingSystem::StartStreamingCapture(writer, ezTime::Milliseconds(1));
+    EZ_TEST_BOOL(ezProfilingSystem::IsStreamingCaptureActive());
+
+    ProfilingTestThread thread;
+    thread.Start();
+
+    for (ezUInt32 i = 0; i < 5; ++i)
+    {
+      ezProfilingSystem::StartNewFrame();
+      ProfileBusyScope("Frame scope");
+    }
+
+    thread.Join();
+
+    ezProfilingSystem::StopStreamingCapture();
+    EZ_TEST_BOOL(!ezProfilingSystem::IsStreamingCaptureActive());
+    EZ_TEST_INT(ezProfilingSystem::GetStreamingCaptureLostScopes(), 0);
+
+    ezMemoryStreamReader reader(&storage);
+
+    ezProfilingSystem::ProfilingData profilingData;
+    EZ_TEST_BOOL(profilingData.ReadStreamingCapture(reader).Succeeded());
+
+    EZ_TEST_INT(CountScopes(profilingData, "Not streamed"), 0);
+    EZ_TEST_INT(CountScopes(profilingData, "Frame scope"), 5);
+    EZ_TEST_INT(CountScopes(profilingData, "Thread scope"), 10);
+    EZ_TEST_INT(profilingData.m_FrameStartTimes.GetCount(), 5);
+
+    for (const auto& buffer : profilingData.m_AllEventBuffers)
+    {
+      for (const auto& scope : buffer.m_Data)
+      {
+        EZ_TEST_BOOL(scope.m_EndTime >= scope.m_BeginTime + ezTime::Milliseconds(1));
+        EZ_TEST_BOOL(scope.m_szFunctionName != nullptr && ezStringUtils::FindSubString(scope.m_szFunctionName, "ProfileBusyScope") != nullptr);
+      }
+    }
+
+    bool bThreadNameFound = false;
+    for (const auto& info : profilingData.m_ThreadInfos)
+    {
+      bThreadNameFound |= info.m_sName == "Profiling Test Thread";
+    }
+    EZ_TEST_BOOL(bThreadNameFound);
+
+    // conversion to JSON
+    ezMemoryStreamStorage jsonStorage;
+    ezMemoryStreamWriter jsonWriter(&jsonStorage);
+    EZ_TEST_BOOL(profilingData.Write(jsonWriter).Succeeded());
+    EZ_TEST_BOOL(jsonStorage.GetStorageSize() > 0);
+  }
+
+#if EZ_ENABLED(EZ_PLATFORM_LINUX)
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Sampling")
+  {
+    ezProfilingSystem::Clear();
+
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+    ezProfilingSystem::StartStreamingCapture(writer, ezTime::Milliseconds(10));
+
+    const ezTime startTime = ezTime::Now();
+
+    EZ_TEST_BOOL(ezProfilingSystem::StartSampling(1000).Succeeded());
+    EZ_TEST_BOOL(ezProfilingSystem::IsSamplingActive());
+
+    for (ezUInt32 i = 0; i < 100; ++i)
+    {
+      ProfileBusyScope("Sampled scope");
+    }
+
+    ezProfilingSystem::StopSampling();
+    EZ_TEST_BOOL(!ezProfilingSystem::IsSamplingActive());
+
+    const ezTime endTime = ezTime::Now();
+
+    ezProfilingSystem::StopStreamingCapture();
+
+    auto checkSamples = [&](const ezProfilingSystem::ProfilingData& data) {
+      // the samples of the main thread, whose name isn't known anymore after the capture in the 'Clear' block
+      ezUInt64 uiSamplesThreadId = 0;
+      for (const auto& info : data.m_ThreadInfos)
+      {
+        if (info.m_sName.EndsWith(" (Samples)") && info.m_sName != "Profiling Capture (Samples)")
+        {
+          uiSamplesThreadId = info.m_uiThreadId;
+        }
+      }
+
+      EZ_TEST_BOOL(uiSamplesThreadId != 0);
+
+      ezUInt32 uiSampledScopes = 0;
+      for (const auto& buffer : data.m_AllEventBuffers)
+      {
+        if (buffer.m_uiThreadId != uiSamplesThreadId)
+          continue;
+
+        for (const auto& scope : buffer.m_Data)
+        {
+          ++uiSampledScopes;
+
+          EZ_TEST_BOOL(scope.m_szFunctionName != nullptr && !ezStringUtils::IsNullOrEmpty(scope.m_szFunctionName));
+          EZ_TEST_BOOL(scope.m_BeginTime >= startTime);
+          EZ_TEST_BOOL(scope.m_EndTime > scope.m_BeginTime);
+          EZ_TEST_BOOL(scope.m_BeginTime <= endTime);
+        }
+      }
+
+      EZ_TEST_BOOL(uiSampledScopes > 0);
+
+      // the instrumented scopes are still there
+      EZ_TEST_INT(CountScopes(data, "Sampled scope"), 100);
+    };
+
+    ezProfilingSystem::ProfilingData profilingData;
+    ezProfilingSystem::Capture(profilingData);
+    checkSamples(profilingData);
+
+    ezMemoryStreamReader reader(&storage);
+
+    ezProfilingSystem::ProfilingData streamedData;
+    EZ_TEST_BOOL(streamedData.ReadStreamingCapture(reader).Succeeded());
+    checkSamples(streamedData);
+
+    ezMemoryStreamStorage jsonStorage;
+    ezMemoryStreamWriter jsonWriter(&jsonStorage);
+    EZ_TEST_BOOL(profilingData.Write(jsonWriter).Succeeded());
+  }
+#endif
 }
@@ -0,0 +1,319 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Serialization/AbstractObjectGraph.h>
+#include <Foundation/Serialization/BinarySerializer.h>
+#include <Foundation/Serialization/ReflectionBinarySerializer.h>
+#include <Foundation/Serialization/ReflectionSerializer.h>
+#include <Foundation/Serialization/RttiConverter.h>
+#include <FoundationTest/Reflection/ReflectionTestClasses.h>
+#include <TestFramework/Utilities/TestLogInterface.h>
+
+class ezBinarySerializerTestOwner : public ezReflectedClass
+{
+  EZ_ADD_DYNAMIC_REFLECTION(ezBinarySerializerTestOwner, ezReflectedClass);
+
+public:
+  ~ezBinarySerializerTestOwner()
+  {
+    if (m_pOwned)
+      m_pOwned->GetDynamicRTTI()->GetAllocator()->Deallocate(m_pOwned);
+  }
+
+  ezString m_sName;
+  ezTestClass1* m_pOwned = nullptr;
+  ezTestStruct3 m_Struct;
+  ezMap<ezString, ezTestStruct3> m_Structs;
+};
+
+// clang-format off
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezBinarySerializerTestOwner, 1, ezRTTIDefaultAllocator<ezBinarySerializerTestOwner>)
+{
+  EZ_BEGIN_PROPERTIES
+  {
+    EZ_MEMBER_PROPERTY("Name", m_sName),
+    EZ_MEMBER_PROPERTY("Owned", m_pOwned)->AddFlags(ezPropertyFlags::PointerOwner),
+    EZ_MEMBER_PROPERTY("Struct", m_Struct),
+    EZ_MAP_MEMBER_PROPERTY("Structs", m_Structs),
+  }
+  EZ_END_PROPERTIES;
+}
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+// clang-format on
+
+namespace
+{
+  ezUInt32 GetFormatTag(const ezMemoryStreamStorage& storage)
+  {
+    ezUInt32 uiTag = 0;
+    if (storage.GetStorageSize() >= sizeof(uiTag))
+      ezMemoryUtils::RawByteCopy(&uiTag, storage.GetData(), sizeof(uiTag));
+
+    return uiTag;
+  }
+
+  void FillOwner(ezBinarySerializerTestOwner& owner)
+  {
+    owner.m_sName = "Owner";
+    owner.m_Struct = ezTestStruct3(2.5, 7);
+    owner.m_Structs.Insert("a", ezTestStruct3(1.0, 1));
+    owner.m_Structs.Insert("b", ezTestStruct3(-3.0, 300));
+
+    ezTestClass2* pOwned = EZ_DEFAULT_NEW(ezTestClass2);
+    pOwned->m_Color = ezColor::Yellow;
+    pOwned->m_Time = ezTime::Seconds(3);
+    pOwned->m_enumClass = ezExampleEnum::Value3;
+    pOwned->m_array.PushBack(5.0f);
+    pOwned->SetText("Owned");
+    owner.m_pOwned = pOwned;
+  }
+
+  void CheckOwner(const ezBinarySerializerTestOwner& owner, const ezBinarySerializerTestOwner& expected)
+  {
+    EZ_TEST_STRING(owner.m_sName, expected.m_sName);
+    EZ_TEST_BOOL(owner.m_Struct == expected.m_Struct);
+    EZ_TEST_BOOL(owner.m_Structs == expected.m_Structs);
+
+    if (EZ_TEST_BOOL(owner.m_pOwned != nullptr).Failed())
+      return;
+
+    EZ_TEST_BOOL(owner.m_pOwned->GetDynamicRTTI() == ezGetStaticRTTI<ezTestClass2>());
+    EZ_TEST_BOOL(*static_cast<ezTestClass2*>(owner.m_pOwned) == *static_cast<ezTestClass2*>(expected.m_pOwned));
+    EZ_TEST_BOOL(*owner.m_pOwned == *expected.m_pOwned);
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Serialization, ReflectionBinarySerializer)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Direct Format")
+  {
+    ezTestClass2 source;
+    source.m_Color = ezColor::Yellow;
+    source.m_Struct.m_fFloat1 = 5.0f;
+    source.m_Struct.m_variant = "A";
+    source.m_Time = ezTime::Seconds(22.2f);
+    source.m_enumClass = ezExampleEnum::Value3;
+    source.m_bitflagsClass = ezExampleBitflags::Value1 | ezExampleBitflags::Value2;
+    source.m_array.PushBack(40.0f);
+    source.m_Variant = ezVec4(1, 2, 3, 4);
+    source.SetText("LALALALA");
+
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+    ezReflectionSerializer::WriteObjectToBinary(writer, ezGetStaticRTTI<ezTestClass2>(), &source);
+
+    EZ_TEST_INT(GetFormatTag(storage), ezReflectionBinarySerializer::s_uiFormatTag);
+
+    {
+      ezMemoryStreamReader reader(&storage);
+      ezTestClass2 target;
+      ezReflectionSerializer::ReadObjectPropertiesFromBinary(reader, *ezGetStaticRTTI<ezTestClass2>(), &target);
+
+      EZ_TEST_BOOL(target == source);
+      EZ_TEST_BOOL(static_cast<ezTestClass1&>(target) == source);
+    }
+
+    {
+      ezMemoryStreamReader reader(&storage);
+      const ezRTTI* pRtti = nullptr;
+      void* pObject = ezReflectionSerializer::ReadObjectFromBinary(reader, pRtti);
+
+      EZ_TEST_BOOL(pRtti == ezGetStaticRTTI<ezTestClass2>());
+      EZ_TEST_BOOL(*static_cast<ezTestClass2*>(pObject) == source);
+
+      pRtti->GetAllocator()->Deallocate(pObject);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Owned Pointers")
+  {
+    ezBinarySerializerTestOwner source;
+    FillOwner(source);
+
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+    EZ_TEST_BOOL(ezReflectionBinarySerializer::WriteObject(writer, ezGetStaticRTTI<ezBinarySerializerTestOwner>(), &source).Succeeded());
+
+    {
+      // the existing owned object has to be replaced
+      ezBinarySerializerTestOwner target;
+      target.m_pOwned = EZ_DEFAULT_NEW(ezTestClass1);
+      target.m_Structs.Insert("c", ezTestStruct3());
+
+      ezMemoryStreamReader reader(&storage);
+      EZ_TEST_BOOL(ezReflectionBinarySerializer::ReadObjectProperties(reader, *ezGetStaticRTTI<ezBinarySerializerTestOwner>(), &target).Succeeded());
+      CheckOwner(target, source);
+    }
+
+    {
+      ezMemoryStreamReader reader(&storage);
+      const ezRTTI* pRtti = nullptr;
+      ezBinarySerializerTestOwner* pTarget = static_cast<ezBinarySerializerTestOwner*>(ezReflectionBinarySerializer::ReadObject(reader, pRtti));
+
+      EZ_TEST_BOOL(pRtti == ezGetStaticRTTI<ezBinarySerializerTestOwner>());
+      CheckOwner(*pTarget, source);
+
+      pRtti->GetAllocator()->Deallocate(pTarget);
+    }
+
+    {
+      ezBinarySerializerTestOwner empty;
+
+      ezMemoryStreamStorage storage2;
+      ezMemoryStreamWriter writer2(&storage2);
+      EZ_TEST_BOOL(ezReflectionBinarySerializer::WriteObject(writer2, ezGetStaticRTTI<ezBinarySerializerTestOwner>(), &empty).Succeeded());
+
+      ezBinarySerializerTestOwner target;
+      FillOwner(target);
+
+      ezMemoryStreamReader reader(&storage2);
+      EZ_TEST_BOOL(ezReflectionBinarySerializer::ReadObjectProperties(reader, *ezGetStaticRTTI<ezBinarySerializerTestOwner>(), &target).Succeeded());
+      EZ_TEST_BOOL(target.m_pOwned == nullptr);
+      EZ_TEST_BOOL(target.m_Structs.IsEmpty());
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Changed Schema")
+  {
+    ezBinarySerializerTestOwner source;
+    FillOwner(source);
+
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+    EZ_TEST_BOOL(ezReflectionBinarySerializer::WriteObject(writer, ezGetStaticRTTI<ezBinarySerializerTestOwner>(), &source).Succeeded());
+
+    // Bump the version of the root type in the stream, which forces the data to be read through the object graph.
+    // The header starts with the tag, the format version, the number of types and the name of the root type.
+    const ezUInt32 uiVersionOffset = 4 + 1 + 4 + 4 + ezStringUtils::GetStringElementCount("ezBinarySerializerTestOwner");
+    ezUInt32 uiVersion = 0;
+    ezMemoryUtils::RawByteCopy(&uiVersion, storage.GetData() + uiVersionOffset, sizeof(ezUInt32));
+    EZ_TEST_INT(uiVersion, 1);
+
+    ezDynamicArray<ezUInt8> patchedData;
+    patchedData.SetCountUninitialized(storage.GetStorageSize());
+    ezMemoryUtils::Copy(patchedData.GetData(), storage.GetData(), storage.GetStorageSize());
+    uiVersion = 2;
+    ezMemoryUtils::RawByteCopy(patchedData.GetData() + uiVersionOffset, &uiVersion, sizeof(ezUInt32));
+
+    {
+      ezBinarySerializerTestOwner target;
+      ezRawMemoryStreamReader reader(patchedData);
+      EZ_TEST_BOOL(ezReflectionBinarySerializer::ReadObjectProperties(reader, *ezGetStaticRTTI<ezBinarySerializerTestOwner>(), &target).Succeeded());
+      CheckOwner(target, source);
+    }
+
+    {
+      // properties are matched by name when reading into a different type
+      ezTestClass2b target;
+      ezMemoryStreamReader reader(&storage);
+      EZ_TEST_BOOL(ezReflectionBinarySerializer::ReadObjectProperties(reader, *ezTestClass2b::GetStaticRTTI(), &target).Succeeded());
+      EZ_TEST_STRING(target.GetText(), "Tut");
+    }
+
+    {
+      ezTestClass2 source2;
+      source2.m_Color = ezColor::Red;
+      source2.m_Struct.m_fFloat1 = 8.0f;
+
+      ezMemoryStreamStorage storage2;
+      ezMemoryStreamWriter writer2(&storage2);
+      ezReflectionSerializer::WriteObjectToBinary(writer2, ezGetStaticRTTI<ezTestClass2>(), &source2);
+
+      ezTestClass1 target;
+      ezMemoryStreamReader reader(&storage2);
+      ezReflectionSerializer::ReadObjectPropertiesFromBinary(reader, *ezGetStaticRTTI<ezTestClass1>(), &target);
+      EZ_TEST_BOOL(target == source2);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Corrupted Data")
+  {
+    ezBinarySerializerTestOwner source;
+    FillOwner(source);
+
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+    EZ_TEST_BOOL(ezReflectionBinarySerializer::WriteObject(writer, ezGetStaticRTTI<ezBinarySerializerTestOwner>(), &source).Succeeded());
+
+    const ezUInt32 uiNumTypesOffset = 4 + 1;
+    const ezUInt32 uiVersionOffset = uiNumTypesOffset + 4 + 4 + ezStringUtils::GetStringElementCount("ezBinarySerializerTestOwner");
+    const ezUInt32 uiSchemaSizeOffset = uiVersionOffset + 4;
+    const ezUInt32 uiSchemaOffset = uiSchemaSizeOffset + 4;
+
+    auto ReadPatched = [&](ezUInt32 uiOffset, ezUInt32 uiValue, const char* szExpectedError) {
+      ezDynamicArray<ezUInt8> patchedData;
+      patchedData.SetCountUninitialized(storage.GetStorageSize());
+      ezMemoryUtils::Copy(patchedData.GetData(), storage.GetData(), storage.GetStorageSize());
+      ezMemoryUtils::RawByteCopy(patchedData.GetData() + uiOffset, &uiValue, sizeof(ezUInt32));
+
+      // a changed version forces the schemas to be parsed
+      const ezUInt32 uiVersion = 2;
+      ezMemoryUtils::RawByteCopy(patchedData.GetData() + uiVersionOffset, &uiVersion, sizeof(ezUInt32));
+
+      ezTestLogInterface log;
+      ezTestLogSystemScope logSystemScope(&log);
+      log.ExpectMessage(szExpectedError, ezLogMsgType::ErrorMsg);
+
+      ezBinarySerializerTestOwner target;
+      ezRawMemoryStreamReader reader(patchedData);
+      EZ_TEST_BOOL(ezReflectionBinarySerializer::ReadObjectProperties(reader, *ezGetStaticRTTI<ezBinarySerializerTestOwner>(), &target).Failed());
+    };
+
+    ReadPatched(uiNumTypesOffset, 0x7FFFFFFF, "Reflection binary data is truncated.");
+    ReadPatched(uiSchemaSizeOffset, 0x7FFFFFFF, "Reflection binary data is truncated.");
+    ReadPatched(uiSchemaOffset, 0x7FFFFFFF, "Invalid schema for type 'ezBinarySerializerTestOwner'.");
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Unsupported Types")
+  {
+    // pointers in containers are not handled by the direct serializer
+    ezTestPtr source;
+    source.m_sString = "Test";
+    source.m_ArrayPtr.PushBack(EZ_DEFAULT_NEW(ezTestArrays));
+    source.m_ArrayPtr[0]->m_Hybrid.PushBack(5.0);
+
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+    EZ_TEST_BOOL(ezReflectionBinarySerializer::WriteObject(writer, ezGetStaticRTTI<ezTestPtr>(), &source).Failed());
+    EZ_TEST_INT(storage.GetStorageSize(), 0);
+
+    ezReflectionSerializer::WriteObjectToBinary(writer, ezGetStaticRTTI<ezTestPtr>(), &source);
+    EZ_TEST_BOOL(GetFormatTag(storage) != ezReflectionBinarySerializer::s_uiFormatTag);
+
+    ezTestPtr target;
+    ezMemoryStreamReader reader(&storage);
+    ezReflectionSerializer::ReadObjectPropertiesFromBinary(reader, *ezGetStaticRTTI<ezTestPtr>(), &target);
+    EZ_TEST_BOOL(target == source);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Graph Format")
+  {
+    // data written by earlier versions is still readable
+    ezTestClass2 source;
+    source.m_Color = ezColor::Yellow;
+    source.m_Time = ezTime::Seconds(5);
+    source.SetText("Graph");
+
+    ezAbstractObjectGraph graph;
+    ezRttiConverterContext context;
+    ezRttiConverterWriter conv(&graph, &context, false, true);
+
+    ezUuid guid;
+    guid.CreateNewUuid();
+    context.RegisterObject(guid, ezGetStaticRTTI<ezTestClass2>(), &source);
+    conv.AddObjectToGraph(ezGetStaticRTTI<ezTestClass2>(), &source, "root");
+
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+    ezAbstractGraphBinarySerializer::Write(writer, &graph);
+
+    ezMemoryStreamReader reader(&storage);
+    const ezRTTI* pRtti = nullptr;
+    void* pObject = ezReflectionSerializer::ReadObjectFromBinary(reader, pRtti);
+
+    EZ_TEST_BOOL(pRtti == ezGetStaticRTTI<ezTestClass2>());
+    EZ_TEST_BOOL(*static_cast<ezTestClass2*>(pObject) == source);
+
+    pRtti->GetAllocator()->Deallocate(pObject);
+  }
+}
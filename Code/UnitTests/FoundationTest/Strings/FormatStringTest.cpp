@@ -165,6 +165,11 @@ EZ_CREATE_SIMPLE_TEST(Strings, FormatString)
     CompareSnprintf(perfLog, ezFmt("{}, {}, {}, {}, {}, {}, {}, {}, {}, {}", 0, 1, 2, 3, 4, 5, 6, 7, 8, 9), "%i, %i, %i, %i, %i, %i, %i, %i, %i, %i",
       0, 1, 2, 3, 4, 5, 6, 7, 8, 9);
 
+    CompareSnprintf(perfLog, ezFmt(EZ_FMT_STRING("Hello {0}, i = {1}, f = {2}"), "World", 42, ezArgF(3.141f, 2)), "Hello %s, i = %i, f = %.2f",
+      "World", 42, 3.141f);
+    CompareSnprintf(perfLog, ezFmt(EZ_FMT_STRING("{0}, {1}, {2}, {3}, {4}"), "AAAAAA", "BBBBBBB", "CCCCCC", "DDDDDDDDDDDDD", "EE"),
+      "%s, %s, %s, %s, %s", "AAAAAA", "BBBBBBB", "CCCCCC", "DDDDDDDDDDDDD", "EE");
+
     // FILE* file = fopen("D:\\snprintf_perf.txt", "wb");
     // if (file)
     //{
@@ -185,6 +190,43 @@ EZ_CREATE_SIMPLE_TEST(Strings, FormatString)
     TestFormat(ezFmt("{2}, {}, {1}, {}", ezUInt8(1), ezUInt16(2), ezUInt32(3), ezUInt64(4), ezUInt64(5)), "3, 4, 2, 3");
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Compile-Time Format String")
+  {
+    ezString string = "string";
+    ezStringBuilder sb = "builder";
+
+    TestFormat(ezFmt(EZ_FMT_STRING("")), "");
+    TestFormat(ezFmt(EZ_FMT_STRING("No formatting at all")), "No formatting at all");
+    TestFormat(ezFmt(EZ_FMT_STRING("{0}, {1}, {2}, {3}"), ezInt8(-1), ezInt16(-2), ezInt32(-3), ezInt64(-4)), "-1, -2, -3, -4");
+    TestFormat(ezFmt(EZ_FMT_STRING("{3}, {1}, {0}, {2}"), ezArgF(23.12345f, 1), ezArgI(42), 17, 12.34f), "12.34, 42, 23.1, 17");
+    TestFormat(ezFmt(EZ_FMT_STRING("'{0}', '{1}', '{0}'"), string, sb), "'string', 'builder', 'string'");
+    TestFormat(ezFmt(EZ_FMT_STRING("{2}, {}, {1}, {}"), ezUInt8(1), ezUInt16(2), ezUInt32(3), ezUInt64(4)), "3, 4, 2, 3");
+    TestFormat(ezFmt(EZ_FMT_STRING("100%% {}{}%%"), 5, "0"), "100% 50%");
+    TestFormat(ezFmt(EZ_FMT_STRING("{a} {} {"), true), "{a} true {");
+    TestFormat(ezFmt(EZ_FMT_STRING(u8"\u00B5{}\u00B0"), 3), u8"\u00B53\u00B0");
+
+    // same results as the runtime path
+    TestFormat(ezFmt("100%% {}{}%%", 5, "0"), "100% 50%");
+    TestFormat(ezFmt("{a} {} {", true), "{a} true {");
+
+    ezStringBuilder tmp;
+    tmp.Format(ezFmt(EZ_FMT_STRING("World Update/{0}/Game Object Count"), string));
+    EZ_TEST_STRING(tmp, "World Update/string/Game Object Count");
+
+    constexpr ezUInt32 uiNumSegments = ezInternal::CountFormatStringSegments("a{}b{0}%%c");
+    EZ_TEST_INT(uiNumSegments, 6);
+
+    constexpr auto segments = ezInternal::ParseFormatString<uiNumSegments>("a{}b{0}%%c", 1);
+    EZ_TEST_BOOL(!segments.m_bArgumentOutOfRange);
+    EZ_TEST_INT(segments.m_Segments[1].m_iArgument, 0);
+    EZ_TEST_INT(segments.m_Segments[3].m_iArgument, 0);
+    EZ_TEST_INT(segments.m_Segments[4].m_uiLength, 1); // "%"
+    EZ_TEST_INT(segments.m_Segments[5].m_uiStart, 9);  // "c"
+
+    EZ_TEST_BOOL(ezInternal::ParseFormatString<uiNumSegments>("a{}b{0}%%c", 0).m_bArgumentOutOfRange);
+    EZ_TEST_BOOL(ezInternal::ParseFormatString<2>("a%b", 0).m_bSinglePercentSign);
+  }
+
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "ezTime")
   {
     TestFormat(ezFmt("{}", ezTime()), "0ns");
@@ -1,6 +1,85 @@
 #include <FoundationTestPCH.h>
 
 #include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Types/UniquePtr.h>
+
+namespace
+{
+  ezAtomicBool g_bStopClearingStrings;
+
+  class HashedStringTestThread : public ezThread
+  {
+  public:
+    HashedStringTestThread(ezUInt32 uiIndex)
+      : ezThread("HashedString Test Thread")
+      , m_uiIndex(uiIndex)
+    {
+    }
+
+    ezUInt32 m_uiErrors = 0;
+
+  private:
+    virtual ezUInt32 Run() override
+    {
+      ezStringBuilder sb;
+
+      for (ezUInt32 uiRound = 0; uiRound < 50; ++uiRound)
+      {
+        for (ezUInt32 i = 0; i < 100; ++i)
+        {
+          // strings that all threads look up concurrently
+          sb.Format("Shared {}", i);
+          ezHashedString sShared;
+          sShared.Assign(sb.GetData());
+          Check(sShared, sb);
+
+          // strings that are only used by this thread and are unused again after this iteration
+          sb.Format("Thread {} Round {} String {}", m_uiIndex, uiRound, i);
+          ezHashedString sUnique;
+          sUnique.Assign(sb.GetData());
+          Check(sUnique, sb);
+
+          ezHashedString sCopy = sUnique;
+          Check(sCopy, sb);
+          m_uiErrors += (sCopy == sUnique) ? 0 : 1;
+        }
+      }
+
+      return 0;
+    }
+
+    void Check(const ezHashedString& s, const ezStringBuilder& sb)
+    {
+      if (s.GetString() != sb || s.GetHash() != ezTempHashedString::ComputeHash(sb.GetData()))
+        ++m_uiErrors;
+    }
+
+    ezUInt32 m_uiIndex;
+  };
+
+#if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
+  class ClearUnusedStringsThread : public ezThread
+  {
+  public:
+    ClearUnusedStringsThread()
+      : ezThread("ClearUnusedStrings Test Thread")
+    {
+    }
+
+  private:
+    virtual ezUInt32 Run() override
+    {
+      while (!g_bStopClearingStrings)
+      {
+        ezHashedString::ClearUnusedStrings();
+      }
+
+      return 0;
+    }
+  };
+#endif
+} // namespace
 
 EZ_CREATE_SIMPLE_TEST(Strings, HashedString)
 {
@@ -201,4 +280,43 @@ EZ_CREATE_SIMPLE_TEST(Strings, HashedString)
     EZ_TEST_INT(ezHashedString::ClearUnusedStrings(), 0);
   }
 #endif
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Multi-threaded")
+  {
+    g_bStopClearingStrings = false;
+
+#if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
+    ClearUnusedStringsThread clearThread;
+    clearThread.Start();
+#endif
+
+    constexpr ezUInt32 uiNumThreads = 8;
+    ezUniquePtr<HashedStringTestThread> threads[uiNumThreads];
+
+    for (ezUInt32 t = 0; t < uiNumThreads; ++t)
+    {
+      threads[t] = EZ_DEFAULT_NEW(HashedStringTestThread, t);
+      threads[t]->Start();
+    }
+
+    for (ezUInt32 t = 0; t < uiNumThreads; ++t)
+    {
+      threads[t]->Join();
+      EZ_TEST_INT(threads[t]->m_uiErrors, 0);
+    }
+
+    g_bStopClearingStrings = true;
+
+#if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
+    clearThread.Join();
+
+    // all strings of the test threads are unused now, after one more cleanup nothing is left to remove
+    ezHashedString::ClearUnusedStrings();
+    EZ_TEST_INT(ezHashedString::ClearUnusedStrings(), 0);
+#endif
+
+    ezHashedString s;
+    s.Assign("Shared 42");
+    EZ_TEST_STRING(s.GetData(), "Shared 42");
+  }
 }
@@ -3,6 +3,7 @@
 // NOTE: Always save this file as "Unicode (UTF-8 with signature)"
 // otherwise important Unicode characters are not encoded
 
+#include <Foundation/Memory/CommonAllocators.h>
 #include <Foundation/Strings/String.h>
 
 EZ_CREATE_SIMPLE_TEST_GROUP(Strings);
@@ -867,4 +868,115 @@ EZ_CREATE_SIMPLE_TEST(Strings, StringUtils)
     EZ_TEST_BOOL(ezStringUtils::IsValidIdentifierName("asdf1"));
     EZ_TEST_BOOL(ezStringUtils::IsValidIdentifierName("_asdf"));
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Short Strings at the End of a Page")
+  {
+    // The guarded allocator puts the allocation at the very end of a page that is followed by an inaccessible one. Reading a single byte
+    // past the terminator would crash.
+    ezGuardedAllocator allocator("end of page test allocator");
+    char* pPageEnd = static_cast<char*>(allocator.Allocate(16, 16)) + 16;
+
+    for (ezUInt32 uiLength = 0; uiLength < 16; ++uiLength)
+    {
+      char* s = pPageEnd - uiLength - 1;
+      for (ezUInt32 i = 0; i < uiLength; ++i)
+        s[i] = static_cast<char>('a' + i);
+      s[uiLength] = '\0';
+
+      ezStringBuilder sCopy = s;
+      const char* s2 = sCopy.GetData();
+
+      EZ_TEST_INT(ezStringUtils::GetStringElementCount(s), uiLength);
+      EZ_TEST_INT(ezStringUtils::GetCharacterCount(s), uiLength);
+      EZ_TEST_BOOL(ezUnicodeUtils::IsValidUtf8(s));
+      EZ_TEST_BOOL(ezStringUtils::IsEqual(s, s2));
+      EZ_TEST_BOOL(ezStringUtils::IsEqual(s2, s));
+      EZ_TEST_BOOL(ezStringUtils::IsEqual_NoCase(s, s2));
+      EZ_TEST_BOOL(ezStringUtils::IsEqual_NoCase(s2, s));
+      EZ_TEST_INT(ezStringUtils::Compare(s, s2), 0);
+      EZ_TEST_INT(ezStringUtils::Compare_NoCase(s2, s), 0);
+      EZ_TEST_BOOL(ezStringUtils::StartsWith(s, s2));
+      EZ_TEST_BOOL(ezStringUtils::FindSubString(s, "!") == nullptr);
+      EZ_TEST_BOOL(ezStringUtils::FindSubString_NoCase(s, "!") == nullptr);
+    }
+
+    allocator.Deallocate(pPageEnd - 16);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Long Strings")
+  {
+    // Long enough to exercise the SIMD code paths. Some of the strings cross a memory page boundary, where those fall back to the scalar code.
+    EZ_ALIGN_VARIABLE(static char szBuffer1[8192], 4096);
+    EZ_ALIGN_VARIABLE(static char szBuffer2[8192], 4096);
+
+    for (ezUInt32 uiOffset : {0u, 4096u - 37u, 4096u - 5u})
+    {
+      for (ezUInt32 uiLength = 1; uiLength < 70; ++uiLength)
+      {
+        char* s1 = szBuffer1 + uiOffset;
+        char* s2 = szBuffer2 + uiOffset + (uiLength % 3);
+
+        for (ezUInt32 i = 0; i < uiLength; ++i)
+        {
+          s1[i] = static_cast<char>('a' + (i * 7) % 26);
+          s2[i] = static_cast<char>('A' + (i * 7) % 26);
+        }
+
+        s1[uiLength] = '\0';
+        s2[uiLength] = '\0';
+
+        EZ_TEST_INT(ezStringUtils::GetStringElementCount(s1), uiLength);
+        EZ_TEST_INT(ezStringUtils::GetCharacterCount(s1), uiLength);
+        EZ_TEST_INT(ezStringUtils::GetCharacterCount(s1, s1 + uiLength / 2), uiLength / 2);
+        EZ_TEST_BOOL(ezUnicodeUtils::IsValidUtf8(s1));
+
+        EZ_TEST_BOOL(ezStringUtils::IsEqual_NoCase(s1, s2));
+        EZ_TEST_BOOL(!ezStringUtils::IsEqual_NoCase(s1, s2, s1 + uiLength, s2 + uiLength - 1));
+        EZ_TEST_BOOL(ezStringUtils::Compare(s1, s2) > 0);
+        EZ_TEST_BOOL(ezStringUtils::FindSubString_NoCase(s1, s2 + uiLength - 1) != nullptr);
+
+        for (ezUInt32 i = 0; i < uiLength; ++i)
+          s2[i] = s1[i];
+
+        EZ_TEST_BOOL(ezStringUtils::IsEqual(s1, s2));
+        EZ_TEST_BOOL(ezStringUtils::StartsWith(s1, s2));
+        EZ_TEST_BOOL(ezStringUtils::FindSubString(s1, s2 + uiLength - 1) != nullptr);
+
+        // a difference at every position
+        for (ezUInt32 i = 0; i < uiLength; ++i)
+        {
+          const char c = s2[i];
+          s2[i] = '!';
+
+          EZ_TEST_BOOL(ezStringUtils::Compare(s1, s2) > 0);
+          EZ_TEST_BOOL(ezStringUtils::Compare(s2, s1) < 0);
+          EZ_TEST_BOOL(ezStringUtils::IsEqual(s1, s2, s1 + i, s2 + i));
+          EZ_TEST_BOOL(!ezStringUtils::IsEqual(s1, s2, s1 + i + 1, s2 + i + 1));
+          EZ_TEST_BOOL(!ezStringUtils::IsEqual_NoCase(s1, s2));
+          EZ_TEST_BOOL(ezStringUtils::IsEqual_NoCase(s1, s2, s1 + i, s2 + i));
+          EZ_TEST_BOOL(!ezStringUtils::StartsWith(s1, s2));
+          EZ_TEST_BOOL(ezStringUtils::FindSubString(s2, "!") == s2 + i);
+          EZ_TEST_BOOL(ezStringUtils::FindSubString(s2, "!", s2 + i) == nullptr);
+
+          // a two byte Utf8 character
+          s2[i] = static_cast<char>(0xC3);
+          s2[i + 1] = static_cast<char>(0xA4);
+          const char c2 = s2[i + 2];
+          s2[i + 2] = '\0';
+
+          EZ_TEST_INT(ezStringUtils::GetCharacterCount(s2), i + 1);
+          EZ_TEST_BOOL(ezUnicodeUtils::IsValidUtf8(s2));
+          EZ_TEST_BOOL(ezStringUtils::Compare_NoCase(s1, s2) < 0);
+          EZ_TEST_BOOL(ezStringUtils::FindSubString_NoCase(s2, "\xC3\xA4") == s2 + i);
+
+          // cut off sequence
+          EZ_TEST_BOOL(!ezUnicodeUtils::IsValidUtf8(s2, s2 + i + 1));
+
+          s2[i + 2] = c2;
+          s2[i + 1] = s1[i + 1];
+          s2[i] = c;
+        }
+      }
+    }
+  }
 }
@@ -266,4 +266,23 @@ EZ_CREATE_SIMPLE_TEST(Strings, UnicodeUtils)
     EZ_TEST_BOOL(ezUnicodeUtils::SkipUtf16BomBE(pString) == false);
     EZ_TEST_BOOL(pString == szNoBom);
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "IsValidUtf8")
+  {
+    EZ_TEST_BOOL(ezUnicodeUtils::IsValidUtf8(""));
+    EZ_TEST_BOOL(ezUnicodeUtils::IsValidUtf8("abc"));
+    EZ_TEST_BOOL(ezUnicodeUtils::IsValidUtf8(ezStringUtf8(L"äöü abc ßßß").GetData()));
+    EZ_TEST_BOOL(ezUnicodeUtils::IsValidUtf8("0123456789abcdef0123456789abcdef \xC3\xA4 0123456789abcdef0123456789abcdef \xE2\x82\xAC"));
+
+    EZ_TEST_BOOL(!ezUnicodeUtils::IsValidUtf8("\xA4"));
+    EZ_TEST_BOOL(!ezUnicodeUtils::IsValidUtf8("0123456789abcdef0123456789abcdef \xC3"));
+    EZ_TEST_BOOL(!ezUnicodeUtils::IsValidUtf8("0123456789abcdef0123456789abcdef \xC3\xA4 0123456789abcdef\xE2\x82 0123456789abcdef"));
+    EZ_TEST_BOOL(!ezUnicodeUtils::IsValidUtf8("0123456789abcdef0123456789abcdef \xC0\x80"));
+
+    // only the given range is checked
+    const char* sz = "0123456789abcdef0123456789abcdef \xC3\xA4";
+    EZ_TEST_BOOL(ezUnicodeUtils::IsValidUtf8(sz, sz + 33));
+    EZ_TEST_BOOL(!ezUnicodeUtils::IsValidUtf8(sz, sz + 34));
+    EZ_TEST_BOOL(ezUnicodeUtils::IsValidUtf8(sz, sz + 35));
+  }
 }
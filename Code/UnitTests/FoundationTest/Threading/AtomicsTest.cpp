@@ -364,4 +364,19 @@ EZ_CREATE_SIMPLE_TEST(Threading, Atomics)
     g_PostDecValues32.Clear();
     g_PostDecValues64.Clear();
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ReadPointer / WritePointer")
+  {
+    ezInt32 iValue = 0;
+    void* pPointer = nullptr;
+
+    EZ_TEST_BOOL(ezAtomicUtils::ReadPointer(&pPointer) == nullptr);
+
+    ezAtomicUtils::WritePointer(&pPointer, &iValue);
+    EZ_TEST_BOOL(ezAtomicUtils::ReadPointer(&pPointer) == &iValue);
+    EZ_TEST_BOOL(pPointer == &iValue);
+
+    ezAtomicUtils::WritePointer(&pPointer, nullptr);
+    EZ_TEST_BOOL(ezAtomicUtils::ReadPointer(&pPointer) == nullptr);
+  }
 }
@@ -0,0 +1,52 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Time/TimeStatistics.h>
+
+EZ_CREATE_SIMPLE_TEST(Time, TimeStatistics)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "No Samples")
+  {
+    ezTimeStatistics stats;
+    stats.m_fMax = 1.0;
+    stats.Compute({});
+
+    EZ_TEST_INT(stats.m_uiSamples, 0);
+    EZ_TEST_DOUBLE(stats.m_fMedian, 0.0, 0.0);
+    EZ_TEST_DOUBLE(stats.m_fMax, 0.0, 0.0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Odd Number of Samples")
+  {
+    // one outlier, which must not affect the median and the MAD
+    const ezTime samples[] = {ezTime::Milliseconds(3), ezTime::Milliseconds(1), ezTime::Milliseconds(100), ezTime::Milliseconds(2),
+      ezTime::Milliseconds(4)};
+
+    ezTimeStatistics stats;
+    stats.Compute(samples);
+
+    EZ_TEST_INT(stats.m_uiSamples, 5);
+    EZ_TEST_DOUBLE(stats.m_fMin, 1.0, 0.0001);
+    EZ_TEST_DOUBLE(stats.m_fMax, 100.0, 0.0001);
+    EZ_TEST_DOUBLE(stats.m_fMean, 22.0, 0.0001);
+    EZ_TEST_DOUBLE(stats.m_fMedian, 3.0, 0.0001);
+    EZ_TEST_DOUBLE(stats.m_fPercentile95, 100.0, 0.0001);
+    EZ_TEST_DOUBLE(stats.m_fMedianAbsoluteDeviation, 1.0, 0.0001);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Even Number of Samples")
+  {
+    ezDynamicArray<ezTime> samples;
+    for (ezUInt32 i = 1; i <= 20; ++i)
+    {
+      samples.PushBack(ezTime::Milliseconds(i));
+    }
+
+    ezTimeStatistics stats;
+    stats.Compute(samples);
+
+    EZ_TEST_INT(stats.m_uiSamples, 20);
+    EZ_TEST_DOUBLE(stats.m_fMedian, 10.5, 0.0001);
+    EZ_TEST_DOUBLE(stats.m_fPercentile95, 19.0, 0.0001);
+    EZ_TEST_DOUBLE(stats.m_fMedianAbsoluteDeviation, 5.0, 0.0001);
+  }
+}
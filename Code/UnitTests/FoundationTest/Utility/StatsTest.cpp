@@ -0,0 +1,185 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Utilities/Stats.h>
+
+EZ_CREATE_SIMPLE_TEST(Utility, Stats)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "SetStat / RemoveStat")
+  {
+    ezStats::SetStat("StatsTest/Value", 42);
+    EZ_TEST_BOOL(ezStats::GetStat("StatsTest/Value") == ezVariant(42));
+
+    ezStats::SetStat("StatsTest/Value", "Text");
+    EZ_TEST_BOOL(ezStats::GetStat("StatsTest/Value") == ezVariant("Text"));
+
+    ezStats::RemoveStat("StatsTest/Value");
+    EZ_TEST_BOOL(!ezStats::GetAllStats().Contains("StatsTest/Value"));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Counter")
+  {
+    ezStatsCounter counter("StatsTest/Counter");
+    ezStatsCounter perFrameCounter("StatsTest/PerFrame", true);
+
+    counter.Increment();
+    counter.Add(9);
+    perFrameCounter.Add(5);
+    EZ_TEST_INT(counter.GetValue(), 10);
+
+    // nothing is written to the stats before the flush
+    EZ_TEST_BOOL(!ezStats::GetAllStats().Contains("StatsTest/Counter"));
+
+    ezStats::FlushMetrics();
+    EZ_TEST_BOOL(ezStats::GetStat("StatsTest/Counter") == ezVariant(ezInt64(10)));
+    EZ_TEST_BOOL(ezStats::GetStat("StatsTest/PerFrame") == ezVariant(ezInt64(5)));
+
+    counter.Increment();
+    perFrameCounter.Increment();
+    EZ_TEST_INT(counter.GetValue(), 11);
+    EZ_TEST_INT(perFrameCounter.GetValue(), 1);
+
+    ezStats::FlushMetrics();
+    EZ_TEST_BOOL(ezStats::GetStat("StatsTest/Counter") == ezVariant(ezInt64(11)));
+    EZ_TEST_BOOL(ezStats::GetStat("StatsTest/PerFrame") == ezVariant(ezInt64(1)));
+
+    ezStats::FlushMetrics();
+    EZ_TEST_BOOL(ezStats::GetStat("StatsTest/PerFrame") == ezVariant(ezInt64(0)));
+
+    ezStats::RemoveStat("StatsTest/Counter");
+    ezStats::RemoveStat("StatsTest/PerFrame");
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Counter Multithreaded")
+  {
+    constexpr ezUInt32 uiTasks = 16;
+    constexpr ezUInt32 uiIncrements = 10000;
+
+    ezStatsCounter counter("StatsTest/Counter");
+
+    ezTaskSystem::ParallelForIndexed(0, uiTasks, [&](ezUInt32 uiStart, ezUInt32 uiEnd) {
+      for (ezUInt32 t = uiStart; t < uiEnd; ++t)
+      {
+        for (ezUInt32 i = 0; i < uiIncrements; ++i)
+        {
+          counter.Increment();
+        }
+      }
+    });
+
+    EZ_TEST_INT(counter.GetValue(), uiTasks * uiIncrements);
+
+    ezStats::FlushMetrics();
+    EZ_TEST_BOOL(ezStats::GetStat("StatsTest/Counter") == ezVariant(ezInt64(uiTasks * uiIncrements)));
+    ezStats::RemoveStat("StatsTest/Counter");
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Gauge")
+  {
+    ezStatsGauge gauge;
+    gauge.Set(7);
+
+    // unnamed metrics are not flushed
+    ezStats::FlushMetrics();
+
+    gauge.SetName("StatsTest/Gauge");
+    gauge.Add(3);
+    EZ_TEST_INT(gauge.GetValue(), 10);
+
+    ezStats::FlushMetrics();
+    EZ_TEST_BOOL(ezStats::GetStat("StatsTest/Gauge") == ezVariant(ezInt64(10)));
+
+    gauge.Set(2);
+    ezStats::FlushMetrics();
+    EZ_TEST_BOOL(ezStats::GetStat("StatsTest/Gauge") == ezVariant(ezInt64(2)));
+
+    ezStats::RemoveStat("StatsTest/Gauge");
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Histogram Buckets")
+  {
+    for (ezUInt64 i = 0; i < ezStatsHistogram::SubBucketCount * 2; ++i)
+    {
+      EZ_TEST_INT(ezStatsHistogram::GetBucketIndex(i), i);
+      EZ_TEST_INT(ezStatsHistogram::GetBucketLowerBound(static_cast<ezUInt32>(i)), i);
+    }
+
+    EZ_TEST_INT(ezStatsHistogram::GetBucketIndex(0xFFFFFFFFFFFFFFFFull), ezStatsHistogram::BucketCount - 1);
+
+    ezUInt32 uiPrevBucket = 0;
+    for (ezUInt64 uiValue = 1; uiValue < 0x8000000000000000ull; uiValue += uiValue / 2 + 1)
+    {
+      const ezUInt32 uiBucket = ezStatsHistogram::GetBucketIndex(uiValue);
+      EZ_TEST_BOOL(uiBucket >= uiPrevBucket);
+      EZ_TEST_BOOL(ezStatsHistogram::GetBucketLowerBound(uiBucket) <= uiValue);
+      EZ_TEST_BOOL(uiBucket + 1 == ezStatsHistogram::BucketCount || ezStatsHistogram::GetBucketLowerBound(uiBucket + 1) > uiValue);
+
+      // the relative error of the reported value is at most half a sub-bucket
+      const double fValue = static_cast<double>(uiValue);
+      EZ_TEST_DOUBLE(static_cast<double>(ezStatsHistogram::GetBucketValue(uiBucket)), fValue, fValue / ezStatsHistogram::SubBucketCount);
+
+      uiPrevBucket = uiBucket;
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Histogram")
+  {
+    ezStatsHistogram histogram("StatsTest/Histogram");
+
+    for (ezUInt64 i = 1; i <= 1000; ++i)
+    {
+      histogram.Record(i);
+    }
+
+    ezStats::FlushMetrics();
+
+    EZ_TEST_BOOL(ezStats::GetStat("StatsTest/Histogram/Count") == ezVariant(ezInt64(1000)));
+    EZ_TEST_BOOL(ezStats::GetStat("StatsTest/Histogram/Mean") == ezVariant(ezInt64(500)));
+    EZ_TEST_BOOL(ezStats::GetStat("StatsTest/Histogram/Max") == ezVariant(ezInt64(1000)));
+    EZ_TEST_DOUBLE(ezStats::GetStat("StatsTest/Histogram/P50").ConvertTo<double>(), 500.0, 500.0 / 8);
+    EZ_TEST_DOUBLE(ezStats::GetStat("StatsTest/Histogram/P90").ConvertTo<double>(), 900.0, 900.0 / 8);
+    EZ_TEST_DOUBLE(ezStats::GetStat("StatsTest/Histogram/P99").ConvertTo<double>(), 990.0, 990.0 / 8);
+
+    // the histogram only covers a single frame
+    histogram.Record(3);
+    ezStats::FlushMetrics();
+
+    EZ_TEST_BOOL(ezStats::GetStat("StatsTest/Histogram/Count") == ezVariant(ezInt64(1)));
+    EZ_TEST_BOOL(ezStats::GetStat("StatsTest/Histogram/P50") == ezVariant(ezInt64(3)));
+    EZ_TEST_BOOL(ezStats::GetStat("StatsTest/Histogram/Max") == ezVariant(ezInt64(3)));
+
+    // frames without values only update the count
+    ezStats::FlushMetrics();
+    EZ_TEST_BOOL(ezStats::GetStat("StatsTest/Histogram/Count") == ezVariant(ezInt64(0)));
+    EZ_TEST_BOOL(ezStats::GetStat("StatsTest/Histogram/Max") == ezVariant(ezInt64(3)));
+
+    for (const char* szStat : {"Count", "Mean", "P50", "P90", "P99", "Max"})
+    {
+      ezStringBuilder sName;
+      sName.Set("StatsTest/Histogram/", szStat);
+      ezStats::RemoveStat(sName);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Histogram Time")
+  {
+    ezStatsHistogram histogram("StatsTest/Time", ezStatsHistogram::ValueType::Time);
+
+    histogram.RecordTime(ezTime::Milliseconds(1));
+    histogram.RecordTime(ezTime::Milliseconds(3));
+
+    ezStats::FlushMetrics();
+
+    const ezVariant max = ezStats::GetStat("StatsTest/Time/Max");
+    EZ_TEST_BOOL(max.IsA<ezTime>());
+    EZ_TEST_DOUBLE(max.Get<ezTime>().GetMilliseconds(), 3.0, 0.001);
+    EZ_TEST_DOUBLE(ezStats::GetStat("StatsTest/Time/Mean").Get<ezTime>().GetMilliseconds(), 2.0, 0.001);
+
+    for (const char* szStat : {"Count", "Mean", "P50", "P90", "P99", "Max"})
+    {
+      ezStringBuilder sName;
+      sName.Set("StatsTest/Time/", szStat);
+      ezStats::RemoveStat(sName);
+    }
+  }
+}
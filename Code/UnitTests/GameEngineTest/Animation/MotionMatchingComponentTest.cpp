@@ -0,0 +1,180 @@
+#include <GameEngineTestPCH.h>
+
+#include <Core/Graphics/Geometry.h>
+#include <Core/ResourceManager/ResourceManager.h>
+#include <Foundation/Configuration/Startup.h>
+#include <GameEngine/Animation/Skeletal/JointAttachmentComponent.h>
+#include <GameEngine/Animation/Skeletal/MotionMatchingComponent.h>
+#include <RendererCore/AnimationSystem/AnimationClipResource.h>
+#include <RendererCore/AnimationSystem/SkeletonBuilder.h>
+#include <RendererCore/AnimationSystem/SkeletonResource.h>
+#include <RendererCore/Meshes/MeshResource.h>
+#include <RendererFoundation/Device/DeviceNull.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Animation);
+
+namespace
+{
+  constexpr ezUInt16 s_uiNumFrames = 48;
+  constexpr float s_fRootMotionPerFrame = 0.05f;
+
+  ezSkeletonResourceHandle CreateSkeleton()
+  {
+    ezTransform identity;
+    identity.SetIdentity();
+
+    ezTransform leftFoot = identity;
+    leftFoot.m_vPosition.Set(0, 0.2f, 0);
+
+    ezTransform rightFoot = identity;
+    rightFoot.m_vPosition.Set(0, -0.2f, 0);
+
+    ezSkeletonBuilder builder;
+    const ezUInt32 uiRoot = builder.AddJoint("Bip01", identity);
+    builder.AddJoint("Bip01_L_Foot", leftFoot, uiRoot);
+    builder.AddJoint("Bip01_R_Foot", rightFoot, uiRoot);
+
+    ezSkeletonResourceDescriptor desc;
+    builder.BuildSkeleton(desc.m_Skeleton);
+
+    return ezResourceManager::CreateResource<ezSkeletonResource>("MotionMatchingComponentTest_Skeleton", std::move(desc));
+  }
+
+  ezMeshResourceHandle CreateSkinnedMesh(const ezSkeletonResourceHandle& hSkeleton)
+  {
+    ezGeometry geom;
+    geom.AddBox(ezVec3(0.5f), ezColor::White);
+
+    ezMeshResourceDescriptor desc;
+    desc.MeshBufferDesc().AddStream(ezGALVertexAttributeSemantic::Position, ezGALResourceFormat::XYZFloat);
+    desc.MeshBufferDesc().AllocateStreamsFromGeometry(geom);
+    desc.AddSubMesh(desc.MeshBufferDesc().GetPrimitiveCount(), 0, 0);
+    desc.SetMaterial(0, "");
+    desc.SetSkeleton(hSkeleton);
+    desc.ComputeBounds();
+
+    return ezResourceManager::CreateResource<ezMeshResource>("MotionMatchingComponentTest_Mesh", std::move(desc));
+  }
+
+  /// A walk cycle in place: the feet swing back and forth and the root moves forward with constant speed.
+  ezAnimationClipResourceHandle CreateWalkClip()
+  {
+    const char* szJoints[] = {"Bip01", "Bip01_L_Foot", "Bip01_R_Foot"};
+
+    ezAnimationClipResourceDescriptor desc;
+    desc.Configure(EZ_ARRAY_SIZE(szJoints), s_uiNumFrames, 24, true);
+
+    for (ezTransform& t : desc.GetJointKeyframes(desc.GetRootMotionJoint()))
+    {
+      t.SetIdentity();
+      t.m_vPosition.Set(s_fRootMotionPerFrame, 0, 0);
+    }
+
+    for (const char* szJoint : szJoints)
+    {
+      ezHashedString sName;
+      sName.Assign(szJoint);
+      const ezUInt16 uiJoint = desc.AddJointName(sName);
+
+      ezArrayPtr<ezTransform> keyframes = desc.GetJointKeyframes(uiJoint);
+      for (ezUInt16 uiFrame = 0; uiFrame < s_uiNumFrames; ++uiFrame)
+      {
+        const float fSwing = 0.3f * ezMath::Sin(ezAngle::Degree(uiFrame * 360.0f / s_uiNumFrames));
+
+        keyframes[uiFrame].SetIdentity();
+
+        if (ezStringUtils::IsEqual(szJoint, "Bip01_L_Foot"))
+          keyframes[uiFrame].m_vPosition.Set(fSwing, 0.2f, 0);
+        else if (ezStringUtils::IsEqual(szJoint, "Bip01_R_Foot"))
+          keyframes[uiFrame].m_vPosition.Set(-fSwing, -0.2f, 0);
+      }
+    }
+
+    return ezResourceManager::CreateResource<ezAnimationClipResource>("MotionMatchingComponentTest_Walk", std::move(desc));
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Animation, MotionMatchingComponent)
+{
+  // The component creates a skinning buffer, which the null device can do without a window or GPU.
+  ezGALDeviceCreationDescription deviceDesc;
+  deviceDesc.m_bCreatePrimarySwapChain = false;
+
+  ezGALDeviceNull* pDevice = EZ_DEFAULT_NEW(ezGALDeviceNull, deviceDesc);
+  if (EZ_TEST_BOOL(pDevice->Init().Succeeded()).Failed())
+  {
+    EZ_DEFAULT_DELETE(pDevice);
+    return;
+  }
+
+  ezGALDevice::SetDefaultDevice(pDevice);
+  ezStartup::StartupHighLevelSystems();
+
+  {
+    ezSkeletonResourceHandle hSkeleton = CreateSkeleton();
+    ezMeshResourceHandle hMesh = CreateSkinnedMesh(hSkeleton);
+    ezAnimationClipResourceHandle hWalk = CreateWalkClip();
+
+    ezWorldDesc worldDesc("MotionMatchingComponentTest");
+    ezWorld world(worldDesc);
+    world.SetWorldSimulationEnabled(true);
+    world.GetClock().SetFixedTimeStep(ezTime::Seconds(1.0 / 24.0));
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "Publish Pose")
+    {
+      EZ_LOCK(world.GetWriteMarker());
+
+      ezGameObjectDesc desc;
+      desc.m_bDynamic = true;
+
+      ezGameObject* pCharacter = nullptr;
+      world.CreateObject(desc, pCharacter);
+
+      ezMotionMatchingComponent* pMotionMatching = nullptr;
+      ezMotionMatchingComponent::CreateComponent(pCharacter, pMotionMatching);
+      pMotionMatching->SetMesh(hMesh);
+      pMotionMatching->SetAnimation(0, hWalk);
+
+      desc.m_hParent = pCharacter->GetHandle();
+
+      ezGameObject* pLeftFoot = nullptr;
+      world.CreateObject(desc, pLeftFoot);
+
+      ezJointAttachmentComponent* pAttachment = nullptr;
+      ezJointAttachmentComponent::CreateComponent(pLeftFoot, pAttachment);
+      pAttachment->SetJointName("Bip01_L_Foot");
+
+      // the first update starts the simulation, every following one evaluates a pose in the async phase and publishes it afterwards
+      const ezUInt32 uiNumUpdates = 10;
+      for (ezUInt32 i = 0; i < uiNumUpdates; ++i)
+      {
+        world.Update();
+      }
+
+      // the root motion moves the character forward
+      const ezVec3 vCharacterPos = pCharacter->GetLocalPosition();
+      EZ_TEST_BOOL(vCharacterPos.x > s_fRootMotionPerFrame * (uiNumUpdates - 2));
+      EZ_TEST_FLOAT(vCharacterPos.y, 0.0f, 0.0001f);
+      EZ_TEST_FLOAT(vCharacterPos.z, 0.0f, 0.0001f);
+
+      // without any input the character does not turn
+      EZ_TEST_BOOL(pCharacter->GetLocalRotation().IsEqualRotation(ezQuat::IdentityQuaternion(), 0.0001f));
+
+      // ezMsgAnimationPoseUpdated reached the joint attachment on the child object
+      const ezVec3 vFootPos = pLeftFoot->GetLocalPosition();
+      EZ_TEST_FLOAT(vFootPos.y, 0.2f, 0.001f);
+      EZ_TEST_FLOAT(vFootPos.z, 0.0f, 0.001f);
+      EZ_TEST_BOOL(ezMath::Abs(vFootPos.x) <= 0.3f + 0.001f);
+
+      world.DeleteObjectNow(pCharacter->GetHandle());
+    }
+  }
+
+  // the mesh buffers have to be destroyed while the device still exists
+  ezResourceManager::FreeAllUnusedResources();
+
+  ezStartup::ShutdownHighLevelSystems();
+
+  pDevice->Shutdown().IgnoreResult();
+  EZ_DEFAULT_DELETE(pDevice);
+}
@@ -0,0 +1,267 @@
+#include <RendererTestPCH.h>
+
+#include <Foundation/Math/Random.h>
+#include <RendererCore/AnimationSystem/AnimationPose.h>
+#include <RendererCore/AnimationSystem/AnimationPoseSoA.h>
+#include <RendererCore/AnimationSystem/SkeletonBuilder.h>
+#include <TestFramework/Framework/Benchmark.h>
+
+namespace
+{
+  /// Builds a humanoid-sized skeleton: a spine with arms, legs and fingers, which gives a hierarchy with many levels of different width.
+  void CreateSkeleton(ezSkeleton& out_skeleton)
+  {
+    ezSkeletonBuilder builder;
+
+    auto AddChain = [&](ezUInt32 uiParent, ezUInt32 uiLength, const ezVec3& vOffset) {
+      for (ezUInt32 i = 0; i < uiLength; ++i)
+      {
+        ezTransform t;
+        t.SetIdentity();
+        t.m_vPosition = vOffset;
+        t.m_qRotation.SetFromAxisAndAngle(ezVec3(0, 1, 0), ezAngle::Degree(5.0f * i));
+        uiParent = builder.AddJoint("Joint", t, uiParent);
+      }
+      return uiParent;
+    };
+
+    ezTransform root;
+    root.SetIdentity();
+    const ezUInt32 uiRoot = builder.AddJoint("Root", root);
+
+    const ezUInt32 uiChest = AddChain(uiRoot, 4, ezVec3(0, 0, 0.2f));
+    AddChain(uiChest, 3, ezVec3(0, 0, 0.1f)); // neck and head
+
+    for (float fSide : {-1.0f, 1.0f})
+    {
+      const ezUInt32 uiHand = AddChain(uiChest, 4, ezVec3(fSide * 0.2f, 0, 0));
+      for (ezUInt32 uiFinger = 0; uiFinger < 5; ++uiFinger)
+      {
+        AddChain(uiHand, 3, ezVec3(fSide * 0.03f, 0.01f * uiFinger, 0));
+      }
+
+      AddChain(uiRoot, 5, ezVec3(fSide * 0.1f, 0, -0.4f));
+    }
+
+    builder.BuildSkeleton(out_skeleton);
+  }
+
+  void SetRandomPose(const ezSkeleton& skeleton, ezRandom& rng, ezAnimationPoseSoA& out_pose, ezAnimationPose* out_pMatrixPose)
+  {
+    for (ezUInt16 uiJoint = 0; uiJoint < skeleton.GetJointCount(); ++uiJoint)
+    {
+      ezTransform t = skeleton.GetJointByIndex(uiJoint).GetBindPoseLocalTransform();
+
+      ezVec3 vAxis(rng.FloatMinMax(-1.0f, 1.0f), rng.FloatMinMax(-1.0f, 1.0f), rng.FloatMinMax(-1.0f, 1.0f));
+      vAxis.NormalizeIfNotZero(ezVec3(0, 0, 1)).IgnoreResult();
+
+      ezQuat q;
+      q.SetFromAxisAndAngle(vAxis, ezAngle::Degree(rng.FloatMinMax(-90.0f, 90.0f)));
+
+      t.m_qRotation = q * t.m_qRotation;
+      t.m_vScale.Set(rng.FloatMinMax(0.8f, 1.2f));
+
+      out_pose.SetTransform(uiJoint, t);
+
+      if (out_pMatrixPose)
+        out_pMatrixPose->SetTransform(uiJoint, t.GetAsMat4());
+    }
+  }
+
+  bool IsEqual(const ezTransform& a, const ezTransform& b, float fEpsilon)
+  {
+    return a.m_vPosition.IsEqual(b.m_vPosition, fEpsilon) && a.m_vScale.IsEqual(b.m_vScale, fEpsilon) &&
+           ezMath::Abs(a.m_qRotation.Dot(b.m_qRotation)) > 1.0f - fEpsilon;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(AnimationSystem, AnimationPoseSoA)
+{
+  ezSkeleton skeleton;
+  CreateSkeleton(skeleton);
+
+  const ezUInt16 uiNumJoints = skeleton.GetJointCount();
+
+  ezRandom rng;
+  rng.Initialize(42);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "SetTransform / GetTransform")
+  {
+    ezAnimationPoseSoA pose;
+    pose.Configure(skeleton);
+
+    EZ_TEST_INT(pose.GetJointCount(), uiNumJoints);
+
+    for (ezUInt16 uiJoint = 0; uiJoint < uiNumJoints; ++uiJoint)
+    {
+      EZ_TEST_BOOL(pose.GetTransform(uiJoint).IsIdentical(skeleton.GetJointByIndex(uiJoint).GetBindPoseLocalTransform()));
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ConvertToObjectSpace / ConvertToSkinningSpace")
+  {
+    ezAnimationPoseSoA pose;
+    pose.Configure(skeleton);
+
+    ezAnimationPose matrixPose;
+    matrixPose.Configure(skeleton);
+
+    SetRandomPose(skeleton, rng, pose, &matrixPose);
+
+    ezAnimationPose objectSpacePose;
+    objectSpacePose.Configure(skeleton);
+    pose.ConvertToObjectSpace(objectSpacePose);
+
+    matrixPose.ConvertFromLocalSpaceToObjectSpace(skeleton);
+
+    bool bObjectSpaceEqual = true;
+    for (ezUInt16 uiJoint = 0; uiJoint < uiNumJoints; ++uiJoint)
+    {
+      bObjectSpaceEqual &= objectSpacePose.IsTransformValid(uiJoint);
+      bObjectSpaceEqual &= objectSpacePose.GetTransform(uiJoint).IsEqual(matrixPose.GetTransform(uiJoint), 0.001f);
+    }
+    EZ_TEST_BOOL(bObjectSpaceEqual);
+
+    ezDynamicArray<ezMat4> skinningMatrices;
+    skinningMatrices.SetCountUninitialized(uiNumJoints);
+    pose.ConvertToSkinningSpace(skinningMatrices);
+
+    matrixPose.ConvertFromObjectSpaceToSkinningSpace(skeleton);
+
+    bool bSkinningSpaceEqual = true;
+    for (ezUInt16 uiJoint = 0; uiJoint < uiNumJoints; ++uiJoint)
+    {
+      bSkinningSpaceEqual &= skinningMatrices[uiJoint].IsEqual(matrixPose.GetTransform(uiJoint), 0.001f);
+    }
+    EZ_TEST_BOOL(bSkinningSpaceEqual);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Blend")
+  {
+    ezAnimationPoseSoA pose0, pose1;
+    pose0.Configure(skeleton);
+    pose1.Configure(skeleton);
+    SetRandomPose(skeleton, rng, pose0, nullptr);
+    SetRandomPose(skeleton, rng, pose1, nullptr);
+
+    ezAnimationPoseSoA blended = pose0;
+    blended.Blend(pose1, 0.3f);
+
+    bool bEqual = true;
+    for (ezUInt16 uiJoint = 0; uiJoint < uiNumJoints; ++uiJoint)
+    {
+      const ezTransform t0 = pose0.GetTransform(uiJoint);
+      const ezTransform t1 = pose1.GetTransform(uiJoint);
+
+      // normalized lerp along the shorter arc
+      const float fSign = t0.m_qRotation.Dot(t1.m_qRotation) < 0.0f ? -1.0f : 1.0f;
+      ezVec4 vRotation = ezMath::Lerp(ezVec4(t0.m_qRotation.v.x, t0.m_qRotation.v.y, t0.m_qRotation.v.z, t0.m_qRotation.w),
+        ezVec4(t1.m_qRotation.v.x, t1.m_qRotation.v.y, t1.m_qRotation.v.z, t1.m_qRotation.w) * fSign, 0.3f);
+      vRotation.Normalize();
+
+      ezTransform expected;
+      expected.m_vPosition = ezMath::Lerp(t0.m_vPosition, t1.m_vPosition, 0.3f);
+      expected.m_qRotation = ezQuat(vRotation.x, vRotation.y, vRotation.z, vRotation.w);
+      expected.m_vScale = ezMath::Lerp(t0.m_vScale, t1.m_vScale, 0.3f);
+
+      bEqual &= IsEqual(blended.GetTransform(uiJoint), expected, 0.0001f);
+    }
+    EZ_TEST_BOOL(bEqual);
+
+    // a mask restricts blending to one branch
+    ezAnimationJointMask mask;
+    mask.Configure(skeleton, 0.0f);
+    mask.SetBranchWeight(skeleton, 5, 1.0f);
+
+    EZ_TEST_FLOAT(mask.GetWeight(4), 0.0f, 0.0f);
+    EZ_TEST_FLOAT(mask.GetWeight(5), 1.0f, 0.0f);
+
+    blended = pose0;
+    blended.Blend(pose1, 1.0f, &mask);
+
+    bool bMasked = true;
+    for (ezUInt16 uiJoint = 0; uiJoint < uiNumJoints; ++uiJoint)
+    {
+      const ezAnimationPoseSoA& expected = skeleton.IsJointDescendantOf(uiJoint, 5) ? pose1 : pose0;
+      bMasked &= IsEqual(blended.GetTransform(uiJoint), expected.GetTransform(uiJoint), 0.0001f);
+    }
+    EZ_TEST_BOOL(bMasked);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "AddAdditive")
+  {
+    ezAnimationPoseSoA pose, additive;
+    pose.Configure(skeleton);
+    additive.Configure(skeleton);
+    SetRandomPose(skeleton, rng, pose, nullptr);
+    SetRandomPose(skeleton, rng, additive, nullptr);
+
+    ezAnimationPoseSoA result = pose;
+    result.AddAdditive(additive, 0.0f);
+
+    ezAnimationPoseSoA result2 = pose;
+    result2.AddAdditive(additive, 1.0f);
+
+    bool bUnchanged = true;
+    bool bFullyApplied = true;
+    for (ezUInt16 uiJoint = 0; uiJoint < uiNumJoints; ++uiJoint)
+    {
+      const ezTransform t = pose.GetTransform(uiJoint);
+      const ezTransform a = additive.GetTransform(uiJoint);
+
+      bUnchanged &= IsEqual(result.GetTransform(uiJoint), t, 0.0001f);
+
+      ezTransform expected;
+      expected.m_vPosition = t.m_vPosition + a.m_vPosition;
+      expected.m_qRotation = a.m_qRotation * t.m_qRotation;
+      expected.m_vScale = t.m_vScale.CompMul(a.m_vScale);
+
+      bFullyApplied &= IsEqual(result2.GetTransform(uiJoint), expected, 0.0001f);
+    }
+    EZ_TEST_BOOL(bUnchanged);
+    EZ_TEST_BOOL(bFullyApplied);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Benchmark, "Pose to skinning matrices")
+  {
+    ezLog::Info("[test]Skeleton with {0} joints", uiNumJoints);
+
+    ezAnimationPoseSoA pose;
+    pose.Configure(skeleton);
+    SetRandomPose(skeleton, rng, pose, nullptr);
+
+    ezDynamicArray<ezTransform> localTransforms;
+    for (ezUInt16 uiJoint = 0; uiJoint < uiNumJoints; ++uiJoint)
+    {
+      localTransforms.PushBack(pose.GetTransform(uiJoint));
+    }
+
+    ezAnimationPose matrixPose;
+    matrixPose.Configure(skeleton);
+
+    ezDynamicArray<ezMat4> skinningMatrices;
+    skinningMatrices.SetCountUninitialized(uiNumJoints);
+
+    EZ_TEST_BENCHMARK("Matrix pose, 100 characters", [&]() {
+      for (ezUInt32 i = 0; i < 100; ++i)
+      {
+        for (ezUInt16 uiJoint = 0; uiJoint < uiNumJoints; ++uiJoint)
+        {
+          matrixPose.SetTransform(uiJoint, localTransforms[uiJoint].GetAsMat4());
+        }
+
+        matrixPose.ConvertFromLocalSpaceToObjectSpace(skeleton);
+        matrixPose.ConvertFromObjectSpaceToSkinningSpace(skeleton);
+        ezMemoryUtils::Copy(skinningMatrices.GetData(), matrixPose.GetAllTransforms().GetPtr(), uiNumJoints);
+      }
+    });
+
+    EZ_TEST_BENCHMARK("SoA pose, 100 characters", [&]() {
+      for (ezUInt32 i = 0; i < 100; ++i)
+      {
+        pose.ConvertToObjectSpace(matrixPose);
+        pose.ConvertToSkinningSpace(skinningMatrices);
+      }
+    });
+  }
+}
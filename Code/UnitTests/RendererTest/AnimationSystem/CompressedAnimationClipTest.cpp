@@ -0,0 +1,238 @@
+#include <RendererTestPCH.h>
+
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Time/Time.h>
+#include <RendererCore/AnimationSystem/CompressedAnimationClip.h>
+#include <TestFramework/Framework/Benchmark.h>
+#include <TestFramework/Utilities/TestLogInterface.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(AnimationSystem);
+
+namespace
+{
+  /// Creates keyframes that resemble a mocap clip: only the root moves, all joints rotate smoothly around their own axis and the scale never changes.
+  void CreateSyntheticClip(ezUInt16 uiNumJoints, ezUInt16 uiNumFrames, ezDynamicArray<ezTransform>& out_keyframes)
+  {
+    out_keyframes.SetCountUninitialized(uiNumJoints * uiNumFrames);
+
+    for (ezUInt32 uiJoint = 0; uiJoint < uiNumJoints; ++uiJoint)
+    {
+      ezVec3 vAxis(ezMath::Sin(ezAngle::Radian(uiJoint * 1.3f)), ezMath::Cos(ezAngle::Radian(uiJoint * 0.7f)), 0.5f);
+      vAxis.Normalize();
+
+      const float fPhase = uiJoint * 0.37f;
+      const float fSpeed = 0.05f + (uiJoint % 5) * 0.02f;
+
+      for (ezUInt32 uiFrame = 0; uiFrame < uiNumFrames; ++uiFrame)
+      {
+        ezTransform& t = out_keyframes[uiJoint * uiNumFrames + uiFrame];
+
+        if (uiJoint == 0)
+          t.m_vPosition.Set(uiFrame * 0.02f, ezMath::Sin(ezAngle::Radian(uiFrame * 0.1f)) * 0.1f, 1.0f);
+        else
+          t.m_vPosition.Set(0.1f * (uiJoint % 3), 0.2f, 0.05f * (uiJoint % 7));
+
+        t.m_qRotation.SetFromAxisAndAngle(vAxis, ezAngle::Radian(1.5f * ezMath::Sin(ezAngle::Radian(fPhase + uiFrame * fSpeed))));
+        t.m_vScale.Set(1.0f);
+      }
+    }
+  }
+
+  ezTransform SampleReference(ezArrayPtr<const ezTransform> keyframes, ezUInt16 uiNumFrames, ezUInt16 uiJoint, ezUInt16 uiFrame, float fLerp)
+  {
+    const ezTransform& t0 = keyframes[uiJoint * uiNumFrames + uiFrame];
+    const ezTransform& t1 = keyframes[uiJoint * uiNumFrames + ezMath::Min<ezUInt16>(uiFrame + 1, uiNumFrames - 1)];
+
+    ezTransform res;
+    res.m_vPosition = ezMath::Lerp(t0.m_vPosition, t1.m_vPosition, fLerp);
+    res.m_qRotation.SetSlerp(t0.m_qRotation, t1.m_qRotation, fLerp);
+    res.m_vScale = ezMath::Lerp(t0.m_vScale, t1.m_vScale, fLerp);
+    return res;
+  }
+
+  void CompareWithReference(const ezCompressedAnimationClip& clip, ezArrayPtr<const ezTransform> keyframes)
+  {
+    const ezAnimationClipCompressionSettings settings;
+
+    ezDynamicArray<ezTransform> sampled;
+    sampled.SetCountUninitialized(clip.GetNumJoints());
+
+    float fMaxPositionError = 0.0f;
+    float fMaxScaleError = 0.0f;
+    ezAngle maxRotationError;
+
+    const float fLerps[] = {0.0f, 0.25f, 0.5f, 0.9f};
+
+    for (ezUInt16 uiFrame = 0; uiFrame < clip.GetNumFrames(); ++uiFrame)
+    {
+      for (float fLerp : fLerps)
+      {
+        clip.SampleJoints(uiFrame, fLerp, sampled);
+
+        for (ezUInt16 uiJoint = 0; uiJoint < clip.GetNumJoints(); ++uiJoint)
+        {
+          const ezTransform ref = SampleReference(keyframes, clip.GetNumFrames(), uiJoint, uiFrame, fLerp);
+
+          fMaxPositionError = ezMath::Max(fMaxPositionError, (sampled[uiJoint].m_vPosition - ref.m_vPosition).GetLength());
+          fMaxScaleError = ezMath::Max(fMaxScaleError, (sampled[uiJoint].m_vScale - ref.m_vScale).GetLength());
+
+          // |q0 - q1| = 2 * sin(angle / 4), the acos of the dot product is too imprecise in float for tolerances below 0.1 degree
+          const ezVec4 q0(sampled[uiJoint].m_qRotation.v.x, sampled[uiJoint].m_qRotation.v.y, sampled[uiJoint].m_qRotation.v.z, sampled[uiJoint].m_qRotation.w);
+          const ezVec4 q1(ref.m_qRotation.v.x, ref.m_qRotation.v.y, ref.m_qRotation.v.z, ref.m_qRotation.w);
+          const float fDistance = ezMath::Min((q0 - q1).GetLength(), (q0 + q1).GetLength());
+          maxRotationError = ezMath::Max(maxRotationError, 4.0f * ezMath::ASin(ezMath::Min(0.5f * fDistance, 1.0f)));
+        }
+      }
+    }
+
+    EZ_TEST_FLOAT(fMaxPositionError, 0.0f, settings.m_fTranslationTolerance);
+    EZ_TEST_FLOAT(fMaxScaleError, 0.0f, settings.m_fScaleTolerance);
+    EZ_TEST_FLOAT(maxRotationError.GetDegree(), 0.0f, settings.m_RotationTolerance.GetDegree());
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(AnimationSystem, CompressedAnimationClip)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Constant Tracks")
+  {
+    ezDynamicArray<ezTransform> keyframes;
+    keyframes.SetCountUninitialized(5 * 20);
+
+    for (ezUInt32 i = 0; i < keyframes.GetCount(); ++i)
+    {
+      const ezUInt32 uiJoint = i / 20;
+      keyframes[i].m_vPosition.Set((float)uiJoint, 2.0f, -3.0f);
+      keyframes[i].m_qRotation.SetFromAxisAndAngle(ezVec3(0, 0, 1), ezAngle::Degree(uiJoint * 50.0f));
+      keyframes[i].m_vScale.Set(1.0f, 2.0f, 3.0f);
+    }
+
+    ezCompressedAnimationClip clip;
+    clip.Compress(5, 20, keyframes, ezAnimationClipCompressionSettings());
+
+    EZ_TEST_INT(clip.GetNumJoints(), 5);
+    EZ_TEST_INT(clip.GetNumFrames(), 20);
+
+    // one key per track
+    EZ_TEST_INT(clip.GetNumKeys(), 5 * 3);
+
+    CompareWithReference(clip, keyframes);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Animated Tracks")
+  {
+    // 13 joints, to also test a group of four joints that is only partially used
+    ezDynamicArray<ezTransform> keyframes;
+    CreateSyntheticClip(13, 200, keyframes);
+
+    ezCompressedAnimationClip clip;
+    clip.Compress(13, 200, keyframes, ezAnimationClipCompressionSettings());
+
+    EZ_TEST_BOOL(clip.GetNumKeys() < 13 * 200 * 3 / 2);
+
+    CompareWithReference(clip, keyframes);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Save and Load")
+  {
+    ezDynamicArray<ezTransform> keyframes;
+    CreateSyntheticClip(7, 50, keyframes);
+
+    ezCompressedAnimationClip clip;
+    clip.Compress(7, 50, keyframes, ezAnimationClipCompressionSettings());
+
+    ezMemoryStreamStorage storage;
+    {
+      ezMemoryStreamWriter writer(&storage);
+      clip.Save(writer);
+    }
+
+    ezCompressedAnimationClip clip2;
+    {
+      ezMemoryStreamReader reader(&storage);
+      EZ_TEST_BOOL(clip2.Load(reader).Succeeded());
+    }
+
+    EZ_TEST_INT(clip2.GetNumJoints(), 7);
+    EZ_TEST_INT(clip2.GetNumFrames(), 50);
+    EZ_TEST_INT(clip2.GetNumKeys(), clip.GetNumKeys());
+
+    ezTransform sampled[7], sampled2[7];
+    clip.SampleJoints(33, 0.6f, ezMakeArrayPtr(sampled));
+    clip2.SampleJoints(33, 0.6f, ezMakeArrayPtr(sampled2));
+
+    for (ezUInt32 i = 0; i < 7; ++i)
+    {
+      EZ_TEST_BOOL(sampled[i].IsIdentical(sampled2[i]));
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Load Unknown Version")
+  {
+    // version 1 stored the rotations differently, so it must be rejected instead of being sampled as garbage
+    ezMemoryStreamStorage storage;
+    {
+      ezMemoryStreamWriter writer(&storage);
+      writer << static_cast<ezUInt8>(1);
+    }
+
+    ezTestLogInterface log;
+    ezTestLogSystemScope logSystemScope(&log);
+    log.ExpectMessage("Unsupported compressed animation clip version 1", ezLogMsgType::ErrorMsg);
+
+    ezCompressedAnimationClip clip;
+    ezMemoryStreamReader reader(&storage);
+    EZ_TEST_BOOL(clip.Load(reader).Failed());
+    EZ_TEST_INT(clip.GetNumKeys(), 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Benchmark, "Compression ratio and sampling")
+  {
+    constexpr ezUInt16 uiNumJoints = 64;
+    constexpr ezUInt16 uiNumFrames = 3000;
+
+    ezDynamicArray<ezTransform> keyframes;
+    CreateSyntheticClip(uiNumJoints, uiNumFrames, keyframes);
+
+    ezCompressedAnimationClip clip;
+    clip.Compress(uiNumJoints, uiNumFrames, keyframes, ezAnimationClipCompressionSettings());
+
+    const ezUInt64 uiRawSize = keyframes.GetHeapMemoryUsage();
+    const ezUInt64 uiCompressedSize = clip.GetHeapMemoryUsage();
+    ezLog::Info("[test]Compression: {0} KB -> {1} KB, ratio {2}:1, {3} of {4} keys kept", uiRawSize / 1024, uiCompressedSize / 1024,
+      ezArgF((double)uiRawSize / uiCompressedSize, 1), clip.GetNumKeys(), uiNumJoints * uiNumFrames * 3);
+
+    ezDynamicArray<ezTransform> sampled;
+    sampled.SetCountUninitialized(uiNumJoints);
+
+    ezUInt32 uiFrame = 0;
+    EZ_TEST_BENCHMARK("Sample compressed clip, 64 joints x 1000 frames", [&]() {
+      for (ezUInt32 i = 0; i < 1000; ++i)
+      {
+        uiFrame = (uiFrame + 7) % (uiNumFrames - 1);
+        clip.SampleJoints(static_cast<ezUInt16>(uiFrame), 0.3f, sampled);
+      }
+    });
+
+    EZ_TEST_BENCHMARK("Sample raw keyframes, 64 joints x 1000 frames", [&]() {
+      for (ezUInt32 i = 0; i < 1000; ++i)
+      {
+        uiFrame = (uiFrame + 7) % (uiNumFrames - 1);
+        for (ezUInt16 uiJoint = 0; uiJoint < uiNumJoints; ++uiJoint)
+        {
+          sampled[uiJoint] = SampleReference(keyframes, uiNumFrames, uiJoint, static_cast<ezUInt16>(uiFrame), 0.3f);
+        }
+      }
+    });
+
+    // a single, directly measured number for the log, as the benchmark results are reported per run
+    const ezTime tStart = ezTime::Now();
+    for (ezUInt32 i = 0; i < 1000; ++i)
+    {
+      clip.SampleJoints(static_cast<ezUInt16>((i * 7) % (uiNumFrames - 1)), 0.3f, sampled);
+    }
+    const ezTime tSampling = ezTime::Now() - tStart;
+
+    ezLog::Info("[test]Sampling: {0} ns per joint", ezArgF(tSampling.GetNanoseconds() / (1000.0 * uiNumJoints), 1));
+  }
+}
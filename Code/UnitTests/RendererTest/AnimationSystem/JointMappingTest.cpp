@@ -0,0 +1,100 @@
+#include <RendererTestPCH.h>
+
+#include <RendererCore/AnimationSystem/AnimationClipResource.h>
+#include <RendererCore/AnimationSystem/AnimationPoseSoA.h>
+#include <RendererCore/AnimationSystem/JointMapping.h>
+#include <RendererCore/AnimationSystem/SkeletonBuilder.h>
+
+EZ_CREATE_SIMPLE_TEST(AnimationSystem, JointMapping)
+{
+  ezTransform identity;
+  identity.SetIdentity();
+
+  // Root -> Spine -> Head, Spine -> Arm -> Hand
+  ezSkeleton skeleton;
+  {
+    ezSkeletonBuilder builder;
+    const ezUInt32 uiRoot = builder.AddJoint("Root", identity);
+    const ezUInt32 uiSpine = builder.AddJoint("Spine", identity, uiRoot);
+    builder.AddJoint("Head", identity, uiSpine);
+    const ezUInt32 uiArm = builder.AddJoint("Arm", identity, uiSpine);
+    builder.AddJoint("Hand", identity, uiArm);
+    builder.BuildSkeleton(skeleton);
+  }
+
+  // the clip stores its joints in a different order and has one joint that the skeleton doesn't know
+  const char* szClipJoints[] = {"Hand", "Unknown", "Spine", "Arm"};
+
+  ezAnimationClipResourceDescriptor clip;
+  clip.Configure(EZ_ARRAY_SIZE(szClipJoints), 2, 30, false);
+
+  for (ezUInt16 uiJoint = 0; uiJoint < EZ_ARRAY_SIZE(szClipJoints); ++uiJoint)
+  {
+    ezHashedString sName;
+    sName.Assign(szClipJoints[uiJoint]);
+    clip.AddJointName(sName);
+
+    for (ezTransform& t : clip.GetJointKeyframes(uiJoint))
+    {
+      t = identity;
+      t.m_vPosition.Set(uiJoint + 1.0f, 0, 0);
+    }
+  }
+
+  auto FindMapping = [](const ezJointMapping& mapping, ezUInt16 uiJointInSkeleton) -> ezUInt16 {
+    for (const ezJointMapping::Mapping& m : mapping.GetAllMappings())
+    {
+      if (m.m_uiJointInSkeleton == uiJointInSkeleton)
+        return m.m_uiJointInAnimation;
+    }
+    return ezInvalidJointIndex;
+  };
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "CreateMapping")
+  {
+    ezJointMapping mapping;
+    mapping.CreateMapping(skeleton, clip);
+
+    EZ_TEST_INT(mapping.GetAllMappings().GetCount(), 3);
+    EZ_TEST_INT(FindMapping(mapping, skeleton.FindJointByName("Root")), ezInvalidJointIndex);
+    EZ_TEST_INT(FindMapping(mapping, skeleton.FindJointByName("Spine")), 2);
+    EZ_TEST_INT(FindMapping(mapping, skeleton.FindJointByName("Arm")), 3);
+    EZ_TEST_INT(FindMapping(mapping, skeleton.FindJointByName("Hand")), 0);
+
+    // recreating the mapping replaces the previous one
+    mapping.CreateMapping(skeleton, clip);
+    EZ_TEST_INT(mapping.GetAllMappings().GetCount(), 3);
+
+    mapping.Clear();
+    EZ_TEST_BOOL(mapping.GetAllMappings().IsEmpty());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "CreatePartialMapping")
+  {
+    ezJointMapping mapping;
+    mapping.CreatePartialMapping(skeleton, clip, ezTempHashedString("Arm"));
+
+    EZ_TEST_INT(mapping.GetAllMappings().GetCount(), 2);
+    EZ_TEST_INT(FindMapping(mapping, skeleton.FindJointByName("Spine")), ezInvalidJointIndex);
+    EZ_TEST_INT(FindMapping(mapping, skeleton.FindJointByName("Arm")), 3);
+    EZ_TEST_INT(FindMapping(mapping, skeleton.FindJointByName("Hand")), 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "SetPoseToKeyframe")
+  {
+    ezJointMapping mapping;
+    mapping.CreateMapping(skeleton, clip);
+
+    ezAnimationPoseSoA pose;
+    pose.Configure(skeleton);
+    pose.SetToBindPose(skeleton);
+
+    clip.SetPoseToKeyframe(pose, mapping, 0);
+
+    EZ_TEST_VEC3(pose.GetTransform(skeleton.FindJointByName("Root")).m_vPosition, ezVec3(0, 0, 0), 0.0f);
+    EZ_TEST_VEC3(pose.GetTransform(skeleton.FindJointByName("Spine")).m_vPosition, ezVec3(3, 0, 0), 0.0f);
+    EZ_TEST_VEC3(pose.GetTransform(skeleton.FindJointByName("Head")).m_vPosition, ezVec3(0, 0, 0), 0.0f);
+    EZ_TEST_VEC3(pose.GetTransform(skeleton.FindJointByName("Arm")).m_vPosition, ezVec3(4, 0, 0), 0.0f);
+    EZ_TEST_VEC3(pose.GetTransform(skeleton.FindJointByName("Hand")).m_vPosition, ezVec3(1, 0, 0), 0.0f);
+  }
+}
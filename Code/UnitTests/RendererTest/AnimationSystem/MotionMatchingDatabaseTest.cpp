@@ -0,0 +1,161 @@
+#include <RendererTestPCH.h>
+
+#include <Foundation/Math/Random.h>
+#include <RendererCore/AnimationSystem/MotionMatchingDatabase.h>
+
+namespace
+{
+  ezMotionMatchingFeatures CreateRandomFeatures(ezRandom& rng)
+  {
+    ezMotionMatchingFeatures features;
+    features.m_vRootVelocity.Set((float)rng.DoubleMinMax(-3, 3), (float)rng.DoubleMinMax(-3, 3), 0.0f);
+    features.m_vLeftFootPosition.Set((float)rng.DoubleMinMax(-0.5, 0.5), (float)rng.DoubleMinMax(-0.3, 0.3), (float)rng.DoubleMinMax(0, 0.4));
+    features.m_vRightFootPosition.Set((float)rng.DoubleMinMax(-0.5, 0.5), (float)rng.DoubleMinMax(-0.3, 0.3), (float)rng.DoubleMinMax(0, 0.4));
+
+    for (ezVec2& vPoint : features.m_vTrajectory)
+    {
+      vPoint.Set((float)rng.DoubleMinMax(-3, 3), (float)rng.DoubleMinMax(-3, 3));
+    }
+
+    return features;
+  }
+
+  void FillDatabase(ezMotionMatchingDatabase& db, ezRandom& rng, ezUInt16 uiNumClips, ezUInt16 uiNumFrames)
+  {
+    ezDynamicArray<ezMotionMatchingFeatures> frames;
+    frames.SetCountUninitialized(uiNumFrames);
+
+    for (ezUInt16 uiClip = 0; uiClip < uiNumClips; ++uiClip)
+    {
+      for (ezMotionMatchingFeatures& features : frames)
+      {
+        features = CreateRandomFeatures(rng);
+      }
+
+      db.AddClip(uiClip, frames);
+    }
+
+    db.Build(ezMotionMatchingDatabase::Weights());
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(AnimationSystem, MotionMatchingDatabase)
+{
+  ezRandom rng;
+  rng.Initialize(42);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Empty")
+  {
+    ezMotionMatchingDatabase db;
+    db.Build(ezMotionMatchingDatabase::Weights());
+
+    EZ_TEST_INT(db.GetEntryCount(), 0);
+    EZ_TEST_INT(db.FindBestEntry(CreateRandomFeatures(rng)), ezInvalidIndex);
+    EZ_TEST_INT(db.FindEntry(0, 0), ezInvalidIndex);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Entries")
+  {
+    ezMotionMatchingDatabase db;
+    FillDatabase(db, rng, 3, 7);
+
+    EZ_TEST_INT(db.GetEntryCount(), 21);
+    EZ_TEST_INT(db.FindEntry(3, 0), ezInvalidIndex);
+    EZ_TEST_INT(db.FindEntry(1, 7), ezInvalidIndex);
+
+    const ezUInt32 uiEntry = db.FindEntry(2, 5);
+    EZ_TEST_INT(db.GetEntryClip(uiEntry), 2);
+    EZ_TEST_INT(db.GetEntryKeyframe(uiEntry), 5);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Exact Match")
+  {
+    ezDynamicArray<ezMotionMatchingFeatures> frames;
+    for (ezUInt32 i = 0; i < 500; ++i)
+    {
+      frames.PushBack(CreateRandomFeatures(rng));
+    }
+
+    ezMotionMatchingDatabase db;
+    db.AddClip(0, frames);
+    db.Build(ezMotionMatchingDatabase::Weights());
+
+    for (ezUInt16 uiFrame = 0; uiFrame < frames.GetCount(); uiFrame += 7)
+    {
+      float fDistance = -1.0f;
+      const ezUInt32 uiEntry = db.FindBestEntry(frames[uiFrame], ezMotionMatchingDatabase::FilterFunction(), &fDistance);
+
+      EZ_TEST_INT(db.GetEntryKeyframe(uiEntry), uiFrame);
+      EZ_TEST_FLOAT(fDistance, 0.0f, 0.0001f);
+      EZ_TEST_FLOAT(db.ComputeDistance(uiEntry, frames[uiFrame]), 0.0f, 0.0001f);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "KD-Tree equals Brute Force")
+  {
+    ezMotionMatchingDatabase db;
+    FillDatabase(db, rng, 100, 61);
+
+    for (ezUInt32 i = 0; i < 200; ++i)
+    {
+      const ezMotionMatchingFeatures query = CreateRandomFeatures(rng);
+
+      float fDistance = 0.0f;
+      float fBruteForceDistance = 0.0f;
+      const ezUInt32 uiEntry = db.FindBestEntry(query, ezMotionMatchingDatabase::FilterFunction(), &fDistance);
+      const ezUInt32 uiBruteForceEntry = db.FindBestEntryBruteForce(query, ezMotionMatchingDatabase::FilterFunction(), &fBruteForceDistance);
+
+      EZ_TEST_INT(uiEntry, uiBruteForceEntry);
+      EZ_TEST_FLOAT(fDistance, fBruteForceDistance, 0.0f);
+      EZ_TEST_FLOAT(fDistance, db.ComputeDistance(uiEntry, query), 0.001f);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Filter")
+  {
+    ezMotionMatchingDatabase db;
+    FillDatabase(db, rng, 100, 61);
+
+    const ezMotionMatchingDatabase::FilterFunction onlyEvenClips([](ezUInt16 uiClip, ezUInt16 uiKeyframe) -> bool { return (uiClip % 2) == 0; });
+    const ezMotionMatchingDatabase::FilterFunction nothing([](ezUInt16 uiClip, ezUInt16 uiKeyframe) -> bool { return false; });
+
+    for (ezUInt32 i = 0; i < 100; ++i)
+    {
+      const ezMotionMatchingFeatures query = CreateRandomFeatures(rng);
+
+      const ezUInt32 uiEntry = db.FindBestEntry(query, onlyEvenClips);
+      EZ_TEST_INT(uiEntry, db.FindBestEntryBruteForce(query, onlyEvenClips));
+      EZ_TEST_INT(db.GetEntryClip(uiEntry) % 2, 0);
+
+      EZ_TEST_INT(db.FindBestEntry(query, nothing), ezInvalidIndex);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Benchmark, "Query 300 Clips")
+  {
+    ezMotionMatchingDatabase db;
+    FillDatabase(db, rng, 300, 60);
+
+    ezDynamicArray<ezMotionMatchingFeatures> queries;
+    for (ezUInt32 i = 0; i < 100; ++i)
+    {
+      queries.PushBack(CreateRandomFeatures(rng));
+    }
+
+    ezUInt32 uiChecksum = 0;
+
+    EZ_TEST_BENCHMARK("Brute force, 18000 frames, 100 queries", [&]() {
+      for (const ezMotionMatchingFeatures& query : queries)
+      {
+        uiChecksum += db.FindBestEntryBruteForce(query);
+      }
+    });
+
+    EZ_TEST_BENCHMARK("KD-tree, 18000 frames, 100 queries", [&]() {
+      for (const ezMotionMatchingFeatures& query : queries)
+      {
+        uiChecksum += db.FindBestEntry(query);
+      }
+    });
+  }
+}
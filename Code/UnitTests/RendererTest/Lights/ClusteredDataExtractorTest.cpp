@@ -0,0 +1,470 @@
+#include <RendererTestPCH.h>
+
+#include <Core/World/World.h>
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/Math/Random.h>
+#include <RendererCore/Decals/DecalComponent.h>
+#include <RendererCore/Lights/ClusteredDataExtractor.h>
+#include <RendererCore/Lights/DirectionalLightComponent.h>
+#include <RendererCore/Lights/PointLightComponent.h>
+#include <RendererCore/Lights/SpotLightComponent.h>
+#include <RendererCore/Pipeline/ExtractedRenderData.h>
+#include <RendererCore/Pipeline/View.h>
+#include <RendererCore/RenderWorld/RenderWorld.h>
+#include <RendererFoundation/Device/DeviceNull.h>
+#include <TestFramework/Framework/Benchmark.h>
+
+#include <RendererCore/Lights/Implementation/ClusteredDataUtils.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Lights);
+
+namespace
+{
+  /// Fills the extracted render data with randomly placed point lights, spot lights and decals in front of the camera.
+  void CreateSyntheticLightSet(ezUInt32 uiNumPointLights, ezUInt32 uiNumSpotLights, ezUInt32 uiNumDecals, ezExtractedRenderData& out_renderData)
+  {
+    ezRandom rng;
+    rng.Initialize(42);
+
+    auto RandomPosition = [&]() { return ezVec3(rng.FloatMinMax(1.0f, 150.0f), rng.FloatMinMax(-60.0f, 60.0f), rng.FloatMinMax(-30.0f, 30.0f)); };
+
+    auto RandomRotation = [&]() {
+      ezVec3 vAxis(rng.FloatMinMax(-1.0f, 1.0f), rng.FloatMinMax(-1.0f, 1.0f), rng.FloatMinMax(-1.0f, 1.0f));
+      vAxis.NormalizeIfNotZero(ezVec3(0, 0, 1)).IgnoreResult();
+
+      ezQuat q;
+      q.SetFromAxisAndAngle(vAxis, ezAngle::Degree(rng.FloatMinMax(0.0f, 360.0f)));
+      return q;
+    };
+
+    for (ezUInt32 i = 0; i < uiNumPointLights; ++i)
+    {
+      auto pRenderData = ezCreateRenderDataForThisFrame<ezPointLightRenderData>(nullptr);
+      pRenderData->m_GlobalTransform.SetIdentity();
+      pRenderData->m_GlobalTransform.m_vPosition = RandomPosition();
+      pRenderData->m_LightColor = ezColor::White;
+      pRenderData->m_fIntensity = 10.0f;
+      pRenderData->m_fRange = rng.FloatMinMax(1.0f, 10.0f);
+      pRenderData->m_uiShadowDataOffset = ezInvalidIndex;
+      pRenderData->FillBatchIdAndSortingKey(1.0f);
+
+      out_renderData.AddRenderData(pRenderData, ezDefaultRenderDataCategories::Light);
+    }
+
+    for (ezUInt32 i = 0; i < uiNumSpotLights; ++i)
+    {
+      auto pRenderData = ezCreateRenderDataForThisFrame<ezSpotLightRenderData>(nullptr);
+      pRenderData->m_GlobalTransform.SetIdentity();
+      pRenderData->m_GlobalTransform.m_vPosition = RandomPosition();
+      pRenderData->m_GlobalTransform.m_qRotation = RandomRotation();
+      pRenderData->m_LightColor = ezColor::White;
+      pRenderData->m_fIntensity = 10.0f;
+      pRenderData->m_fRange = rng.FloatMinMax(2.0f, 20.0f);
+      pRenderData->m_OuterSpotAngle = ezAngle::Degree(rng.FloatMinMax(10.0f, 90.0f));
+      pRenderData->m_InnerSpotAngle = pRenderData->m_OuterSpotAngle * 0.5f;
+      pRenderData->m_uiShadowDataOffset = ezInvalidIndex;
+      pRenderData->FillBatchIdAndSortingKey(1.0f);
+
+      out_renderData.AddRenderData(pRenderData, ezDefaultRenderDataCategories::Light);
+    }
+
+    for (ezUInt32 i = 0; i < uiNumDecals; ++i)
+    {
+      auto pRenderData = ezCreateRenderDataForThisFrame<ezDecalRenderData>(nullptr);
+      pRenderData->m_GlobalTransform.m_vPosition = RandomPosition();
+      pRenderData->m_GlobalTransform.m_qRotation = RandomRotation();
+      pRenderData->m_GlobalTransform.m_vScale = ezVec3(rng.FloatMinMax(0.5f, 4.0f), rng.FloatMinMax(0.5f, 4.0f), rng.FloatMinMax(0.5f, 4.0f));
+      pRenderData->m_uiApplyOnlyToId = 0;
+      pRenderData->m_uiFlags = 0;
+      pRenderData->m_uiAngleFadeParams = 0;
+      pRenderData->m_BaseColor = ezColor::White;
+      pRenderData->m_EmissiveColor = ezColor::Black;
+      pRenderData->m_uiBaseColorAtlasScale = 0;
+      pRenderData->m_uiBaseColorAtlasOffset = 0;
+      pRenderData->m_uiNormalAtlasScale = 0;
+      pRenderData->m_uiNormalAtlasOffset = 0;
+      pRenderData->m_uiORMAtlasScale = 0;
+      pRenderData->m_uiORMAtlasOffset = 0;
+      pRenderData->m_uiSortingKey = i;
+
+      out_renderData.AddRenderData(pRenderData, ezDefaultRenderDataCategories::Decal);
+    }
+
+    out_renderData.SortAndBatch();
+  }
+
+  void CreateDirectionalLights(ezUInt32 uiNumLights, ezExtractedRenderData& out_renderData)
+  {
+    for (ezUInt32 i = 0; i < uiNumLights; ++i)
+    {
+      auto pRenderData = ezCreateRenderDataForThisFrame<ezDirectionalLightRenderData>(nullptr);
+      pRenderData->m_GlobalTransform.SetIdentity();
+      pRenderData->m_LightColor = ezColor::White;
+      pRenderData->m_fIntensity = 1.0f;
+      pRenderData->m_uiShadowDataOffset = ezInvalidIndex;
+      pRenderData->FillBatchIdAndSortingKey(1.0f);
+
+      out_renderData.AddRenderData(pRenderData, ezDefaultRenderDataCategories::Light);
+    }
+
+    out_renderData.SortAndBatch();
+  }
+
+  struct TestClusterRange
+  {
+    ezUInt8 m_uiMinX;
+    ezUInt8 m_uiMaxX;
+    ezUInt8 m_uiMinY;
+    ezUInt8 m_uiMaxY;
+    ezUInt8 m_uiMinZ;
+    ezUInt8 m_uiMaxZ;
+
+    bool Contains(ezUInt32 x, ezUInt32 y, ezUInt32 z) const
+    {
+      return x >= m_uiMinX && x <= m_uiMaxX && y >= m_uiMinY && y <= m_uiMaxY && z >= m_uiMinZ && z <= m_uiMaxZ;
+    }
+  };
+
+  struct TestLightBinningData
+  {
+    ezSimdVec4f m_PositionAndRange;
+    ezSimdVec4f m_ForwardDir;
+    ezSimdVec4f m_SinCosAngle;
+    ezUInt32 m_uiType;
+  };
+
+  struct TestDecalBinningData
+  {
+    ezSimdMat4f m_WorldToDecal;
+    ezSimdVec4f m_RadiusScale;
+  };
+
+  enum class Overlap
+  {
+    No,
+    Yes,
+    Borderline,
+  };
+
+  /// The vectorized intersection tests compute the same values as the scalar ones, but MulAdd may be a fused multiply-add and round
+  /// differently. Tests whose values are that close to the limit may thus legitimately have a different result.
+  Overlap Classify(bool bOverlaps, float fValue, float fLimit)
+  {
+    if (ezMath::Abs(fValue - fLimit) <= 1e-4f * ezMath::Max(ezMath::Abs(fLimit), 1.0f))
+      return Overlap::Borderline;
+
+    return bOverlaps ? Overlap::Yes : Overlap::No;
+  }
+
+  /// Compares the binning of the extractor with the scalar intersection tests of the original, non-vectorized binning. Returns the
+  /// number of borderline tests, which are not compared.
+  ezUInt32 CheckAgainstScalarBinning(const ezView& view, const ezExtractedRenderData& renderData, const ezClusteredDataCPU& data)
+  {
+    const ezCamera* pCamera = view.GetCullingCamera();
+    const float fAspectRatio = view.GetViewport().width / view.GetViewport().height;
+
+    ezDynamicArray<ezSimdBSphere, ezAlignedAllocatorWrapper> clusterSpheres;
+    clusterSpheres.SetCountUninitialized(NUM_CLUSTERS);
+    FillClusterBoundingSpheres(*pCamera, fAspectRatio, clusterSpheres);
+
+    ezMat4 tmp = pCamera->GetViewMatrix();
+    const ezSimdMat4f viewMatrix = ezSimdConversion::ToMat4(tmp);
+
+    pCamera->GetProjectionMatrix(fAspectRatio, tmp);
+    const ezSimdMat4f projectionMatrix = ezSimdConversion::ToMat4(tmp);
+    const ezSimdMat4f viewProjectionMatrix = projectionMatrix * viewMatrix;
+
+    // the items of every cluster as bit sets, with the full item counts
+    const ezUInt32 uiBlocksPerCluster = ezClusteredDataCPU::MAX_LIGHT_DATA / 32;
+    ezDynamicArray<ezUInt32> binnedLights;
+    ezDynamicArray<ezUInt32> binnedDecals;
+    binnedLights.SetCount(NUM_CLUSTERS * uiBlocksPerCluster);
+    binnedDecals.SetCount(NUM_CLUSTERS * uiBlocksPerCluster);
+
+    for (ezUInt32 uiCluster = 0; uiCluster < NUM_CLUSTERS; ++uiCluster)
+    {
+      const ezPerClusterData& cluster = data.m_ClusterData[uiCluster];
+      const ezUInt32* pItems = data.m_ClusterItemList.GetPtr() + cluster.offset;
+
+      for (ezUInt32 i = 0; i < GET_LIGHT_INDEX(cluster.counts); ++i)
+      {
+        const ezUInt32 uiLight = GET_LIGHT_INDEX(pItems[i]);
+        binnedLights[uiCluster * uiBlocksPerCluster + uiLight / 32] |= 1u << (uiLight % 32);
+      }
+
+      for (ezUInt32 i = 0; i < GET_DECAL_INDEX(cluster.counts); ++i)
+      {
+        const ezUInt32 uiDecal = GET_DECAL_INDEX(pItems[i]);
+        binnedDecals[uiCluster * uiBlocksPerCluster + uiDecal / 32] |= 1u << (uiDecal % 32);
+      }
+    }
+
+    ezUInt32 uiBorderline = 0;
+    ezUInt32 uiMismatches = 0;
+
+    auto CheckItem = [&](const ezDynamicArray<ezUInt32>& binned, ezUInt32 uiItem, const TestClusterRange& range, auto overlapFunc) {
+      for (ezUInt32 z = 0; z < NUM_CLUSTERS_Z; ++z)
+      {
+        for (ezUInt32 y = 0; y < NUM_CLUSTERS_Y; ++y)
+        {
+          for (ezUInt32 x = 0; x < NUM_CLUSTERS_X; ++x)
+          {
+            const ezUInt32 uiCluster = GetClusterIndexFromCoord(x, y, z);
+            const Overlap overlap = range.Contains(x, y, z) ? overlapFunc(clusterSpheres[uiCluster]) : Overlap::No;
+            const bool bBinned = (binned[uiCluster * uiBlocksPerCluster + uiItem / 32] & (1u << (uiItem % 32))) != 0;
+
+            if (overlap == Overlap::Borderline)
+              ++uiBorderline;
+            else if (bBinned != (overlap == Overlap::Yes))
+              ++uiMismatches;
+          }
+        }
+      }
+    };
+
+    ezUInt32 uiLightIndex = 0;
+    auto lightBatches = renderData.GetRenderDataBatchesWithCategory(ezDefaultRenderDataCategories::Light);
+    for (ezUInt32 uiBatch = 0; uiBatch < lightBatches.GetBatchCount(); ++uiBatch)
+    {
+      for (auto it = lightBatches.GetBatch(uiBatch).GetIterator<ezRenderData>(); it.IsValid(); ++it, ++uiLightIndex)
+      {
+        TestLightBinningData binningData;
+        TestClusterRange range;
+
+        if (auto pPointLight = ezDynamicCast<const ezPointLightRenderData*>(it))
+        {
+          const ezSimdBSphere sphere(ezSimdConversion::ToVec3(pPointLight->m_GlobalTransform.m_vPosition), pPointLight->m_fRange);
+          FillPointLightBinningData(binningData, range, sphere, viewMatrix, projectionMatrix);
+
+          CheckItem(binnedLights, uiLightIndex, range, [&](const ezSimdBSphere& clusterSphere) {
+            const float fRadius = sphere.GetRadius() + clusterSphere.GetRadius();
+            const float fDistSq = (clusterSphere.GetCenter() - sphere.GetCenter()).GetLengthSquared<3>();
+            return Classify(sphere.Overlaps(clusterSphere), fDistSq, fRadius * fRadius);
+          });
+        }
+        else if (auto pSpotLight = ezDynamicCast<const ezSpotLightRenderData*>(it))
+        {
+          const ezAngle halfAngle = pSpotLight->m_OuterSpotAngle / 2.0f;
+
+          BoundingCone cone;
+          cone.m_PositionAndRange = ezSimdConversion::ToVec3(pSpotLight->m_GlobalTransform.m_vPosition);
+          cone.m_PositionAndRange.SetW(pSpotLight->m_fRange);
+          cone.m_ForwardDir = ezSimdConversion::ToVec3(pSpotLight->m_GlobalTransform.m_qRotation * ezVec3(1.0f, 0.0f, 0.0f));
+          cone.m_SinCosAngle = ezSimdVec4f(ezMath::Sin(halfAngle), ezMath::Cos(halfAngle), 0.0f);
+          FillSpotLightBinningData(binningData, range, cone, viewMatrix, projectionMatrix);
+
+          CheckItem(binnedLights, uiLightIndex, range, [&](const ezSimdBSphere& clusterSphere) {
+            const ezSimdVec4f position = cone.m_PositionAndRange;
+            const float fRange = cone.m_PositionAndRange.w();
+            const float fSinAngle = cone.m_SinCosAngle.x();
+            const float fCosAngle = cone.m_SinCosAngle.y();
+            const float fClusterRadius = clusterSphere.GetRadius();
+
+            const ezSimdVec4f toConePos = clusterSphere.m_CenterAndRadius - position;
+            const float fProjected = cone.m_ForwardDir.Dot<3>(toConePos);
+            const float fDistToConeSq = toConePos.Dot<3>(toConePos);
+            const float fDistClosestP = fCosAngle * ezMath::Sqrt(ezMath::Max(fDistToConeSq - fProjected * fProjected, 0.0f)) - fProjected * fSinAngle;
+
+            const Overlap angle = Classify(fDistClosestP <= fClusterRadius, fDistClosestP, fClusterRadius);
+            const Overlap front = Classify(fProjected <= fClusterRadius + fRange, fProjected, fClusterRadius + fRange);
+            const Overlap back = Classify(fProjected >= -fClusterRadius, fProjected, -fClusterRadius);
+
+            if (angle == Overlap::No || front == Overlap::No || back == Overlap::No)
+              return Overlap::No;
+
+            if (angle == Overlap::Borderline || front == Overlap::Borderline || back == Overlap::Borderline)
+              return Overlap::Borderline;
+
+            return Overlap::Yes;
+          });
+        }
+        else if (ezDynamicCast<const ezDirectionalLightRenderData*>(it) != nullptr)
+        {
+          FillDirLightBinningData(binningData, range);
+
+          CheckItem(binnedLights, uiLightIndex, range, [](const ezSimdBSphere&) { return Overlap::Yes; });
+        }
+      }
+    }
+
+    ezUInt32 uiDecalIndex = 0;
+    auto decalBatches = renderData.GetRenderDataBatchesWithCategory(ezDefaultRenderDataCategories::Decal);
+    for (ezUInt32 uiBatch = 0; uiBatch < decalBatches.GetBatchCount(); ++uiBatch)
+    {
+      for (auto it = decalBatches.GetBatch(uiBatch).GetIterator<ezDecalRenderData>(); it.IsValid(); ++it, ++uiDecalIndex)
+      {
+        TestDecalBinningData binningData;
+        TestClusterRange range;
+        FillDecalBinningData(binningData, range, it, viewProjectionMatrix);
+
+        const ezSimdBBox localDecalBounds(ezSimdVec4f(-1.0f), ezSimdVec4f(1.0f));
+
+        CheckItem(binnedDecals, uiDecalIndex, range, [&](const ezSimdBSphere& clusterSphere) {
+          ezSimdBSphere localSphere = clusterSphere;
+          localSphere.Transform(binningData.m_WorldToDecal);
+
+          const float fRadius = localSphere.GetRadius();
+          const float fDistSq = (localSphere.GetCenter() - localDecalBounds.GetClampedPoint(localSphere.GetCenter())).GetLengthSquared<3>();
+          return Classify(localDecalBounds.Overlaps(localSphere), fDistSq, fRadius * fRadius);
+        });
+      }
+    }
+
+    EZ_TEST_INT(uiLightIndex, data.m_LightData.GetCount());
+    EZ_TEST_INT(uiDecalIndex, data.m_DecalData.GetCount());
+    EZ_TEST_INT(uiMismatches, 0);
+
+    return uiBorderline;
+  }
+
+  const ezClusteredDataCPU* ExtractClusteredData(
+    ezClusteredDataExtractor& extractor, const ezView& view, const ezExtractedRenderData& renderData, ezExtractedRenderData& out_extractedData)
+  {
+    // every extraction adds its own frame data, so start from a copy of the sorted render data every time
+    out_extractedData = renderData;
+    extractor.PostSortAndBatch(view, ezDynamicArray<const ezGameObject*>(), out_extractedData);
+
+    return out_extractedData.GetFrameData<ezClusteredDataCPU>();
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Lights, ClusteredDataExtractor)
+{
+  // The extractor only needs the render world, so the null device is sufficient and no window or GPU is required.
+  ezGALDeviceCreationDescription deviceDesc;
+  deviceDesc.m_bCreatePrimarySwapChain = false;
+
+  ezGALDeviceNull* pDevice = EZ_DEFAULT_NEW(ezGALDeviceNull, deviceDesc);
+  if (EZ_TEST_BOOL(pDevice->Init().Succeeded()).Failed())
+  {
+    EZ_DEFAULT_DELETE(pDevice);
+    return;
+  }
+
+  ezGALDevice::SetDefaultDevice(pDevice);
+  ezStartup::StartupHighLevelSystems();
+
+  {
+    ezWorldDesc worldDesc("ClusteredDataExtractorTest");
+    ezWorld world(worldDesc);
+
+    ezCamera camera;
+    camera.SetCameraMode(ezCameraMode::PerspectiveFixedFovX, 90.0f, 0.1f, 1000.0f);
+    camera.LookAt(ezVec3::ZeroVector(), ezVec3(1, 0, 0), ezVec3(0, 0, 1));
+
+    ezView* pView = nullptr;
+    ezViewHandle hView = ezRenderWorld::CreateView("ClusteredDataExtractorTest", pView);
+    pView->SetWorld(&world);
+    pView->SetCamera(&camera);
+    pView->SetViewport(ezRectFloat(0.0f, 0.0f, 1920.0f, 1080.0f));
+
+    ezCVarBool* pParallelBinning = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("r_ParallelClusterBinning"));
+    EZ_TEST_BOOL(pParallelBinning != nullptr);
+
+    ezClusteredDataExtractor extractor;
+
+    ezExtractedRenderData renderData;
+    CreateSyntheticLightSet(600, 400, 500, renderData);
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "Serial and parallel binning")
+    {
+      *pParallelBinning = false;
+      ezExtractedRenderData serialData;
+      const ezClusteredDataCPU* pSerial = ExtractClusteredData(extractor, *pView, renderData, serialData);
+
+      *pParallelBinning = true;
+      ezExtractedRenderData parallelData;
+      const ezClusteredDataCPU* pParallel = ExtractClusteredData(extractor, *pView, renderData, parallelData);
+
+      if (EZ_TEST_BOOL(pSerial != nullptr && pParallel != nullptr).Succeeded())
+      {
+        EZ_TEST_INT(pSerial->m_LightData.GetCount(), 1000);
+        EZ_TEST_INT(pSerial->m_DecalData.GetCount(), 500);
+
+        EZ_TEST_BOOL(pSerial->m_ClusterItemList.GetCount() > 0);
+        EZ_TEST_BOOL(pSerial->m_ClusterItemList == pParallel->m_ClusterItemList);
+
+        bool bSameClusters = true;
+        bool bPacked = true;
+        ezUInt32 uiExpectedOffset = 0;
+        for (ezUInt32 i = 0; i < NUM_CLUSTERS; ++i)
+        {
+          const ezPerClusterData& cluster = pSerial->m_ClusterData[i];
+          bSameClusters &= cluster.offset == pParallel->m_ClusterData[i].offset && cluster.counts == pParallel->m_ClusterData[i].counts;
+
+          // the items of all clusters are packed without gaps
+          bPacked &= cluster.offset == uiExpectedOffset;
+          uiExpectedOffset += ezMath::Max<ezUInt32>(GET_LIGHT_INDEX(cluster.counts), GET_DECAL_INDEX(cluster.counts));
+        }
+
+        EZ_TEST_BOOL(bSameClusters);
+        EZ_TEST_BOOL(bPacked);
+        EZ_TEST_INT(uiExpectedOffset, pSerial->m_ClusterItemList.GetCount());
+      }
+    }
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "Scalar binning")
+    {
+      for (bool bParallel : {false, true})
+      {
+        *pParallelBinning = bParallel;
+        ezExtractedRenderData extractedData;
+        const ezClusteredDataCPU* pData = ExtractClusteredData(extractor, *pView, renderData, extractedData);
+
+        if (EZ_TEST_BOOL(pData != nullptr).Succeeded())
+        {
+          const ezUInt32 uiBorderline = CheckAgainstScalarBinning(*pView, renderData, *pData);
+          ezLog::Info("{0} of the intersection tests were too close to call", uiBorderline);
+        }
+      }
+    }
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "More than 1023 items per cluster")
+    {
+      // The counts in the cluster data only have 10 bits. They are clamped, but the item list still has room for all items.
+      ezExtractedRenderData dirLights;
+      CreateDirectionalLights(ezClusteredDataCPU::MAX_LIGHT_DATA, dirLights);
+
+      ezExtractedRenderData extractedData;
+      const ezClusteredDataCPU* pData = ExtractClusteredData(extractor, *pView, dirLights, extractedData);
+
+      if (EZ_TEST_BOOL(pData != nullptr).Succeeded())
+      {
+        EZ_TEST_INT(pData->m_ClusterItemList.GetCount(), NUM_CLUSTERS * ezClusteredDataCPU::MAX_LIGHT_DATA);
+
+        bool bOffsetsCorrect = true;
+        bool bCountsClamped = true;
+        for (ezUInt32 i = 0; i < NUM_CLUSTERS; ++i)
+        {
+          bOffsetsCorrect &= pData->m_ClusterData[i].offset == i * ezClusteredDataCPU::MAX_LIGHT_DATA;
+          bCountsClamped &= pData->m_ClusterData[i].counts == LIGHT_BITMASK;
+        }
+
+        EZ_TEST_BOOL(bOffsetsCorrect);
+        EZ_TEST_BOOL(bCountsClamped);
+
+        const ezUInt32* pLastCluster = pData->m_ClusterItemList.GetPtr() + (NUM_CLUSTERS - 1) * ezClusteredDataCPU::MAX_LIGHT_DATA;
+        EZ_TEST_INT(pLastCluster[ezClusteredDataCPU::MAX_LIGHT_DATA - 1], ezClusteredDataCPU::MAX_LIGHT_DATA - 1);
+      }
+    }
+
+    EZ_TEST_BLOCK(ezTestBlock::Benchmark, "Binning 1000 lights and 500 decals")
+    {
+      ezExtractedRenderData extractedData;
+
+      *pParallelBinning = false;
+      EZ_TEST_BENCHMARK("Serial", [&]() { ExtractClusteredData(extractor, *pView, renderData, extractedData); });
+
+      *pParallelBinning = true;
+      EZ_TEST_BENCHMARK("Parallel", [&]() { ExtractClusteredData(extractor, *pView, renderData, extractedData); });
+    }
+
+    ezRenderWorld::DeleteView(hView);
+  }
+
+  ezStartup::ShutdownHighLevelSystems();
+
+  pDevice->Shutdown().IgnoreResult();
+  EZ_DEFAULT_DELETE(pDevice);
+}
@@ -0,0 +1,225 @@
+#include <RendererTestPCH.h>
+
+#include "NullDevice.h"
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/Math/Mat4.h>
+#include <Foundation/Memory/MemoryTracker.h>
+#include <RendererFoundation/Shader/ShaderByteCode.h>
+#include <TestFramework/Framework/Benchmark.h>
+
+ezResult ezRendererTestNullDevice::InitializeSubTest(ezInt32 iIdentifier)
+{
+  ezStartup::StartupCoreSystems();
+
+  ezGALDeviceCreationDescription deviceDesc;
+  deviceDesc.m_bCreatePrimarySwapChain = false;
+
+  m_pDevice = EZ_DEFAULT_NEW(ezGALDeviceNull, deviceDesc);
+  if (m_pDevice->Init().Failed())
+  {
+    // DeInitializeSubTest() is not called after a failed initialization
+    EZ_DEFAULT_DELETE(m_pDevice);
+    ezStartup::ShutdownCoreSystems();
+    return EZ_FAILURE;
+  }
+
+  // the null device never looks at the byte code, it only has to exist
+  const ezUInt8 dummyByteCode[] = {0xDE, 0xAD, 0xBE, 0xEF};
+  m_pByteCode = EZ_DEFAULT_NEW(ezGALShaderByteCode, ezMakeArrayPtr(dummyByteCode));
+
+  ezGALShaderCreationDescription shaderDesc;
+  shaderDesc.m_ByteCodes[ezGALShaderStage::VertexShader] = m_pByteCode;
+  shaderDesc.m_ByteCodes[ezGALShaderStage::PixelShader] = m_pByteCode;
+  m_hShader = m_pDevice->CreateShader(shaderDesc);
+
+  ezGALVertexDeclarationCreationDescription vertexDeclDesc;
+  vertexDeclDesc.m_hShader = m_hShader;
+  vertexDeclDesc.m_VertexAttributes.PushBack(
+    ezGALVertexAttribute(ezGALVertexAttributeSemantic::Position, ezGALResourceFormat::XYZFloat, 0, 0, false));
+  m_hVertexDeclaration = m_pDevice->CreateVertexDeclaration(vertexDeclDesc);
+
+  m_hRasterizerState = m_pDevice->CreateRasterizerState(ezGALRasterizerStateCreationDescription());
+  m_hConstantBuffer = m_pDevice->CreateConstantBuffer(sizeof(ezMat4));
+
+  for (ezUInt32 i = 0; i < NumMeshes; ++i)
+  {
+    m_hVertexBuffers[i] = m_pDevice->CreateVertexBuffer(sizeof(ezVec3), 24);
+    m_hIndexBuffers[i] = m_pDevice->CreateIndexBuffer(ezGALIndexType::UShort, 36);
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezRendererTestNullDevice::DeInitializeSubTest(ezInt32 iIdentifier)
+{
+  if (m_pDevice)
+  {
+    for (ezUInt32 i = 0; i < NumMeshes; ++i)
+    {
+      m_pDevice->DestroyBuffer(m_hVertexBuffers[i]);
+      m_pDevice->DestroyBuffer(m_hIndexBuffers[i]);
+      m_hVertexBuffers[i].Invalidate();
+      m_hIndexBuffers[i].Invalidate();
+    }
+
+    m_pDevice->DestroyBuffer(m_hConstantBuffer);
+    m_pDevice->DestroyRasterizerState(m_hRasterizerState);
+    m_pDevice->DestroyVertexDeclaration(m_hVertexDeclaration);
+    m_pDevice->DestroyShader(m_hShader);
+    m_hConstantBuffer.Invalidate();
+    m_hRasterizerState.Invalidate();
+    m_hVertexDeclaration.Invalidate();
+    m_hShader.Invalidate();
+
+    m_pDevice->Shutdown().IgnoreResult();
+    EZ_DEFAULT_DELETE(m_pDevice);
+  }
+
+  // the shader holds a reference to the byte code until the device destroyed it
+  EZ_DEFAULT_DELETE(m_pByteCode);
+
+  ezStartup::ShutdownCoreSystems();
+  ezMemoryTracker::DumpMemoryLeaks();
+  return EZ_SUCCESS;
+}
+
+void ezRendererTestNullDevice::RenderObjects(ezUInt32 uiNumObjects, ezUInt32 uiObjectsPerMesh)
+{
+  ezGALContext* pContext = m_pDevice->GetPrimaryContext();
+
+  pContext->SetShader(m_hShader);
+  pContext->SetVertexDeclaration(m_hVertexDeclaration);
+  pContext->SetPrimitiveTopology(ezGALPrimitiveTopology::Triangles);
+  pContext->SetRasterizerState(m_hRasterizerState);
+  pContext->SetConstantBuffer(0, m_hConstantBuffer);
+
+  ezMat4 mTransform;
+  mTransform.SetIdentity();
+
+  for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+  {
+    const ezUInt32 uiMesh = (i / uiObjectsPerMesh) % NumMeshes;
+    pContext->SetVertexBuffer(0, m_hVertexBuffers[uiMesh]);
+    pContext->SetIndexBuffer(m_hIndexBuffers[uiMesh]);
+
+    mTransform.SetTranslationVector(ezVec3((float)i, 0.0f, 0.0f));
+    pContext->UpdateBuffer(m_hConstantBuffer, 0, ezMakeArrayPtr(reinterpret_cast<const ezUInt8*>(&mTransform), sizeof(ezMat4)));
+
+    pContext->DrawIndexed(36, 0);
+  }
+}
+
+ezTestAppRun ezRendererTestNullDevice::SubtestStatistics()
+{
+  if (EZ_TEST_BOOL(!m_hShader.IsInvalidated() && !m_hVertexDeclaration.IsInvalidated()).Failed())
+    return ezTestAppRun::Quit;
+
+  m_pDevice->BeginFrame();
+
+  // shader, vertex declaration, topology, rasterizer state and constant buffer, then vertex and index buffer for every mesh switch
+  RenderObjects(100, 10);
+
+  const ezGALNullContextStatistics& stats = m_pDevice->GetNullContext()->GetStatistics();
+  EZ_TEST_INT(stats.m_uiDrawCalls, 100);
+  EZ_TEST_INT(stats.m_uiInstances, 100);
+  EZ_TEST_INT(stats.m_uiStateChanges, 5 + 10 * 2);
+  EZ_TEST_INT(stats.m_uiBufferUpdates, 100);
+  EZ_TEST_INT(stats.m_uiBufferBytesUploaded, 100 * sizeof(ezMat4));
+  EZ_TEST_INT(stats.m_uiDispatchCalls, 0);
+
+  m_pDevice->EndFrame();
+
+  // the statistics are kept for the last frame and reset for the next one
+  EZ_TEST_INT(m_pDevice->GetLastFrameStatistics().m_uiDrawCalls, 100);
+  EZ_TEST_INT(m_pDevice->GetNullContext()->GetStatistics().m_uiDrawCalls, 0);
+
+  m_pDevice->BeginFrame();
+
+  // everything is still bound, so only the mesh switches reach the device
+  RenderObjects(20, 10);
+  EZ_TEST_INT(m_pDevice->GetNullContext()->GetStatistics().m_uiStateChanges, 2 * 2);
+
+  m_pDevice->EndFrame();
+
+  return ezTestAppRun::Quit;
+}
+
+ezTestAppRun ezRendererTestNullDevice::SubtestRecordCommands()
+{
+  ezGALContextNull* pContext = m_pDevice->GetNullContext();
+  pContext->SetRecordCommands(true);
+
+  m_pDevice->BeginFrame();
+  RenderObjects(2, 1);
+
+  const ezGALNullCommand::Type expectedCommands[] = {
+    ezGALNullCommand::Type::SetShader,
+    ezGALNullCommand::Type::SetVertexDeclaration,
+    ezGALNullCommand::Type::SetPrimitiveTopology,
+    ezGALNullCommand::Type::SetRasterizerState,
+    ezGALNullCommand::Type::SetConstantBuffer,
+    ezGALNullCommand::Type::SetVertexBuffer,
+    ezGALNullCommand::Type::SetIndexBuffer,
+    ezGALNullCommand::Type::UpdateBuffer,
+    ezGALNullCommand::Type::Draw,
+    ezGALNullCommand::Type::SetVertexBuffer,
+    ezGALNullCommand::Type::SetIndexBuffer,
+    ezGALNullCommand::Type::UpdateBuffer,
+    ezGALNullCommand::Type::Draw,
+  };
+
+  ezArrayPtr<const ezGALNullCommand> commands = pContext->GetRecordedCommands();
+  if (EZ_TEST_INT(commands.GetCount(), EZ_ARRAY_SIZE(expectedCommands)).Succeeded())
+  {
+    for (ezUInt32 i = 0; i < commands.GetCount(); ++i)
+    {
+      EZ_TEST_BOOL(commands[i].m_Type == expectedCommands[i]);
+    }
+
+    EZ_TEST_INT(commands[7].m_uiArg0, sizeof(ezMat4));
+    EZ_TEST_INT(commands[8].m_uiArg0, 36);
+    EZ_TEST_INT(commands[8].m_uiArg1, 1);
+    EZ_TEST_BOOL(commands[5].m_pObject == m_pDevice->GetBuffer(m_hVertexBuffers[0]));
+    EZ_TEST_BOOL(commands[9].m_pObject == m_pDevice->GetBuffer(m_hVertexBuffers[1]));
+  }
+
+  m_pDevice->EndFrame();
+
+  // recorded commands are cleared at the beginning of every frame
+  m_pDevice->BeginFrame();
+  EZ_TEST_INT(pContext->GetRecordedCommands().GetCount(), 0);
+
+  pContext->SetRecordCommands(false);
+  RenderObjects(2, 1);
+  EZ_TEST_INT(pContext->GetRecordedCommands().GetCount(), 0);
+
+  m_pDevice->EndFrame();
+
+  return ezTestAppRun::Quit;
+}
+
+ezTestAppRun ezRendererTestNullDevice::SubtestRenderBenchmark()
+{
+  // Measures the CPU cost of submitting draw calls through ezGALContext, ie. state filtering, constant buffer updates and draws.
+  EZ_TEST_BLOCK(ezTestBlock::Benchmark, "Draw call submission")
+  {
+    EZ_TEST_BENCHMARK("10000 objects, 16 meshes", [&]() {
+      m_pDevice->BeginFrame();
+      RenderObjects(NumObjects, NumObjects / NumMeshes);
+      m_pDevice->EndFrame();
+    });
+
+    EZ_TEST_BENCHMARK("10000 objects, mesh switch per object", [&]() {
+      m_pDevice->BeginFrame();
+      RenderObjects(NumObjects, 1);
+      m_pDevice->EndFrame();
+    });
+
+    EZ_TEST_INT(m_pDevice->GetLastFrameStatistics().m_uiDrawCalls, NumObjects);
+    EZ_TEST_INT(m_pDevice->GetLastFrameStatistics().m_uiBufferUpdates, NumObjects);
+  }
+
+  return ezTestAppRun::Quit;
+}
+
+static ezRendererTestNullDevice g_Test;
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <RendererFoundation/Device/DeviceNull.h>
+#include <TestFramework/Framework/TestBaseClass.h>
+
+class ezGALShaderByteCode;
+
+/// \brief Runs the GAL on ezGALDeviceNull, so these tests neither need a GPU nor a window and also run on build machines.
+class ezRendererTestNullDevice : public ezTestBaseClass
+{
+public:
+  virtual const char* GetTestName() const override { return "Null Device"; }
+
+private:
+  enum SubTests
+  {
+    ST_Statistics,
+    ST_RecordCommands,
+    ST_RenderBenchmark,
+  };
+
+  enum
+  {
+    NumMeshes = 16,
+    NumObjects = 10000,
+  };
+
+  virtual void SetupSubTests() override
+  {
+    AddSubTest("Statistics", SubTests::ST_Statistics);
+    AddSubTest("Record Commands", SubTests::ST_RecordCommands);
+    AddSubTest("Render Benchmark", SubTests::ST_RenderBenchmark);
+  }
+
+  virtual ezResult InitializeSubTest(ezInt32 iIdentifier) override;
+  virtual ezResult DeInitializeSubTest(ezInt32 iIdentifier) override;
+
+  virtual ezTestAppRun RunSubTest(ezInt32 iIdentifier, ezUInt32 uiInvocationCount) override
+  {
+    if (iIdentifier == SubTests::ST_Statistics)
+      return SubtestStatistics();
+
+    if (iIdentifier == SubTests::ST_RecordCommands)
+      return SubtestRecordCommands();
+
+    if (iIdentifier == SubTests::ST_RenderBenchmark)
+      return SubtestRenderBenchmark();
+
+    return ezTestAppRun::Quit;
+  }
+
+  ezTestAppRun SubtestStatistics();
+  ezTestAppRun SubtestRecordCommands();
+  ezTestAppRun SubtestRenderBenchmark();
+
+  /// \brief Binds the shared state and renders the given number of objects, switching the mesh every uiObjectsPerMesh objects.
+  void RenderObjects(ezUInt32 uiNumObjects, ezUInt32 uiObjectsPerMesh);
+
+  ezGALDeviceNull* m_pDevice = nullptr;
+  ezGALShaderByteCode* m_pByteCode = nullptr;
+
+  ezGALShaderHandle m_hShader;
+  ezGALVertexDeclarationHandle m_hVertexDeclaration;
+  ezGALRasterizerStateHandle m_hRasterizerState;
+  ezGALBufferHandle m_hConstantBuffer;
+  ezGALBufferHandle m_hVertexBuffers[NumMeshes];
+  ezGALBufferHandle m_hIndexBuffers[NumMeshes];
+};
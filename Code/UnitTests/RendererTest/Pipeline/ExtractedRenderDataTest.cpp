@@ -0,0 +1,191 @@
+#include <RendererTestPCH.h>
+
+#include <Core/ResourceManager/ResourceManager.h>
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/Configuration/Startup.h>
+#include <RendererCore/Meshes/MeshComponentBase.h>
+#include <RendererCore/Pipeline/ExtractedRenderData.h>
+#include <RendererCore/RenderWorld/RenderWorld.h>
+#include <RendererFoundation/Device/DeviceNull.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Pipeline);
+
+namespace
+{
+  /// Adds mesh render data at the origin. The sorting key defines the order after sorting, the batch id is only overwritten if it is not
+  /// zero, which allows to simulate hash collisions.
+  void AddMeshRenderData(
+    ezExtractedRenderData& renderData, const ezMeshResourceHandle& hMesh, ezUInt32 uiSortingKey, ezUInt32 uiBatchId = 0, ezUInt32 uiSubMesh = 0)
+  {
+    auto pRenderData = ezCreateRenderDataForThisFrame<ezMeshRenderData>(nullptr);
+    pRenderData->m_GlobalTransform.SetIdentity();
+    pRenderData->m_GlobalBounds.SetInvalid();
+    pRenderData->m_hMesh = hMesh;
+    pRenderData->m_uiSubMeshIndex = uiSubMesh;
+    pRenderData->m_uiFlipWinding = 0;
+    pRenderData->m_uiUniformScale = 1;
+    pRenderData->FillBatchIdAndSortingKey();
+
+    pRenderData->m_uiSortingKey = uiSortingKey;
+    if (uiBatchId != 0)
+    {
+      pRenderData->m_uiBatchId = uiBatchId;
+    }
+
+    renderData.AddRenderData(pRenderData, ezDefaultRenderDataCategories::LitOpaque);
+  }
+
+  /// Checks that every batch only contains render data of a single mesh and sub mesh and returns the meshes of the batches.
+  void GetBatchMeshes(const ezExtractedRenderData& renderData, ezDynamicArray<ezMeshResourceHandle>& out_meshes, ezDynamicArray<ezUInt32>& out_counts)
+  {
+    out_meshes.Clear();
+    out_counts.Clear();
+
+    auto batches = renderData.GetRenderDataBatchesWithCategory(ezDefaultRenderDataCategories::LitOpaque);
+    for (ezUInt32 uiBatch = 0; uiBatch < batches.GetBatchCount(); ++uiBatch)
+    {
+      const ezRenderDataBatch batch = batches.GetBatch(uiBatch);
+      const ezMeshRenderData* pFirst = batch.GetFirstData<ezMeshRenderData>();
+
+      for (auto it = batch.GetIterator<ezMeshRenderData>(); it.IsValid(); ++it)
+      {
+        EZ_TEST_BOOL(it->m_hMesh == pFirst->m_hMesh);
+        EZ_TEST_INT(it->m_uiSubMeshIndex, pFirst->m_uiSubMeshIndex);
+      }
+
+      out_meshes.PushBack(pFirst->m_hMesh);
+      out_counts.PushBack(batch.GetCount());
+    }
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Pipeline, ExtractedRenderData)
+{
+  // Batching only needs the render world, so the null device is sufficient and no window or GPU is required.
+  ezGALDeviceCreationDescription deviceDesc;
+  deviceDesc.m_bCreatePrimarySwapChain = false;
+
+  ezGALDeviceNull* pDevice = EZ_DEFAULT_NEW(ezGALDeviceNull, deviceDesc);
+  if (EZ_TEST_BOOL(pDevice->Init().Succeeded()).Failed())
+  {
+    EZ_DEFAULT_DELETE(pDevice);
+    return;
+  }
+
+  ezGALDevice::SetDefaultDevice(pDevice);
+  ezStartup::StartupHighLevelSystems();
+
+  ezCVarBool* pAutoInstancing = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("r_AutoInstancing"));
+  EZ_TEST_BOOL(pAutoInstancing != nullptr);
+  const bool bOldAutoInstancing = *pAutoInstancing;
+  *pAutoInstancing = true;
+
+  {
+    // the meshes are never acquired, so they are not loaded
+    ezMeshResourceHandle hMeshA = ezResourceManager::LoadResource<ezMeshResource>("ExtractedRenderDataTest_MeshA");
+    ezMeshResourceHandle hMeshB = ezResourceManager::LoadResource<ezMeshResource>("ExtractedRenderDataTest_MeshB");
+
+    ezCamera camera;
+    camera.SetCameraMode(ezCameraMode::PerspectiveFixedFovX, 90.0f, 0.1f, 1000.0f);
+
+    ezDynamicArray<ezMeshResourceHandle> batchMeshes;
+    ezDynamicArray<ezUInt32> batchCounts;
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "Merge Non-Adjacent Runs")
+    {
+      ezExtractedRenderData renderData;
+      renderData.SetCamera(camera);
+
+      AddMeshRenderData(renderData, hMeshA, 1);
+      AddMeshRenderData(renderData, hMeshB, 2);
+      AddMeshRenderData(renderData, hMeshA, 3);
+      AddMeshRenderData(renderData, hMeshB, 4);
+      AddMeshRenderData(renderData, hMeshA, 5);
+      renderData.SortAndBatch();
+
+      GetBatchMeshes(renderData, batchMeshes, batchCounts);
+      if (EZ_TEST_INT(batchMeshes.GetCount(), 2).Succeeded())
+      {
+        EZ_TEST_BOOL(batchMeshes[0] == hMeshA);
+        EZ_TEST_INT(batchCounts[0], 3);
+        EZ_TEST_BOOL(batchMeshes[1] == hMeshB);
+        EZ_TEST_INT(batchCounts[1], 2);
+      }
+    }
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "Batch Id Collisions")
+    {
+      // different meshes and sub meshes with the same batch id must never end up in the same batch
+      ezExtractedRenderData renderData;
+      renderData.SetCamera(camera);
+
+      AddMeshRenderData(renderData, hMeshA, 1, 42);
+      AddMeshRenderData(renderData, hMeshB, 2, 42);
+      AddMeshRenderData(renderData, hMeshA, 3, 42, 1);
+      AddMeshRenderData(renderData, hMeshB, 4, 42);
+      AddMeshRenderData(renderData, hMeshA, 5, 42);
+
+      // adjacent after sorting, but still a different mesh
+      AddMeshRenderData(renderData, hMeshA, 6, 42);
+      AddMeshRenderData(renderData, hMeshB, 6, 42);
+      renderData.SortAndBatch();
+
+      GetBatchMeshes(renderData, batchMeshes, batchCounts);
+      if (EZ_TEST_INT(batchMeshes.GetCount(), 3).Succeeded())
+      {
+        EZ_TEST_BOOL(batchMeshes[0] == hMeshA);
+        EZ_TEST_INT(batchCounts[0], 3);
+        EZ_TEST_BOOL(batchMeshes[1] == hMeshB);
+        EZ_TEST_INT(batchCounts[1], 3);
+        EZ_TEST_BOOL(batchMeshes[2] == hMeshA);
+        EZ_TEST_INT(batchCounts[2], 1);
+      }
+    }
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "Draw Calls")
+    {
+      // Every batch is rendered with one instanced draw call, so the null device has to see one draw call per mesh.
+      auto FillRenderData = [&](ezExtractedRenderData& out_renderData) {
+        out_renderData.SetCamera(camera);
+
+        for (ezUInt32 i = 0; i < 100; ++i)
+        {
+          AddMeshRenderData(out_renderData, (i % 2) ? hMeshA : hMeshB, i);
+        }
+        out_renderData.SortAndBatch();
+      };
+
+      ezExtractedRenderData renderData;
+      FillRenderData(renderData);
+
+      pDevice->BeginFrame();
+
+      ezGALContextNull* pContext = pDevice->GetNullContext();
+      pContext->ResetStatistics();
+
+      auto batches = renderData.GetRenderDataBatchesWithCategory(ezDefaultRenderDataCategories::LitOpaque);
+      for (ezUInt32 uiBatch = 0; uiBatch < batches.GetBatchCount(); ++uiBatch)
+      {
+        pContext->DrawIndexedInstanced(36, batches.GetBatch(uiBatch).GetCount(), 0);
+      }
+
+      EZ_TEST_INT(pContext->GetStatistics().m_uiDrawCalls, 2);
+      EZ_TEST_INT(pContext->GetStatistics().m_uiInstances, 100);
+
+      pDevice->EndFrame();
+
+      *pAutoInstancing = false;
+      ezExtractedRenderData unmergedRenderData;
+      FillRenderData(unmergedRenderData);
+      EZ_TEST_INT(unmergedRenderData.GetRenderDataBatchesWithCategory(ezDefaultRenderDataCategories::LitOpaque).GetBatchCount(), 100);
+      *pAutoInstancing = true;
+    }
+  }
+
+  *pAutoInstancing = bOldAutoInstancing;
+
+  ezStartup::ShutdownHighLevelSystems();
+
+  pDevice->Shutdown().IgnoreResult();
+  EZ_DEFAULT_DELETE(pDevice);
+}
@@ -0,0 +1,234 @@
+#include <RendererTestPCH.h>
+
+#include <Core/World/World.h>
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/Configuration/Startup.h>
+#include <RendererCore/Lights/PointLightComponent.h>
+#include <RendererCore/Pipeline/ExtractedRenderData.h>
+#include <RendererCore/Pipeline/Extractor.h>
+#include <RendererCore/Pipeline/View.h>
+#include <RendererCore/RenderWorld/RenderWorld.h>
+#include <RendererFoundation/Device/DeviceNull.h>
+
+namespace
+{
+  /// Creates objects with a point light each. Point lights without shadows are cached if their owner is static.
+  void CreateLightObjects(ezWorld& world, ezUInt32 uiNumObjects, bool bDynamic, ezDynamicArray<const ezGameObject*>& out_objects)
+  {
+    EZ_LOCK(world.GetWriteMarker());
+
+    for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+    {
+      ezGameObjectDesc desc;
+      desc.m_bDynamic = bDynamic;
+      desc.m_LocalPosition.Set(10.0f + (i % 32), (float)(i / 32), 0.0f);
+
+      ezGameObject* pObject = nullptr;
+      world.CreateObject(desc, pObject);
+
+      ezPointLightComponent* pLight = nullptr;
+      ezPointLightComponent::CreateComponent(pObject, pLight);
+
+      out_objects.PushBack(pObject);
+    }
+
+    // initializes the components
+    world.Update();
+  }
+
+  /// Extracts the objects like a frame of the render world would and returns the extracted light render data.
+  void ExtractFrame(ezExtractor& extractor, const ezView& view, const ezDynamicArray<const ezGameObject*>& objects,
+    ezDynamicArray<const ezRenderData*>& out_renderData)
+  {
+    ezExtractedRenderData extractedData;
+    extractedData.SetCamera(*view.GetCamera());
+    extractor.Extract(view, objects, extractedData);
+    extractedData.SortAndBatch();
+
+    out_renderData.Clear();
+
+    auto batches = extractedData.GetRenderDataBatchesWithCategory(ezDefaultRenderDataCategories::Light);
+    for (ezUInt32 uiBatch = 0; uiBatch < batches.GetBatchCount(); ++uiBatch)
+    {
+      const ezRenderDataBatch batch = batches.GetBatch(uiBatch);
+      for (auto it = batch.GetIterator<ezRenderData>(); it.IsValid(); ++it)
+      {
+        out_renderData.PushBack(it);
+      }
+    }
+
+    // new cache entries are only added at the end of the frame
+    ezRenderWorld::EndFrame();
+  }
+
+  ezUInt32 CountCachedObjects(const ezView& view, const ezDynamicArray<const ezGameObject*>& objects)
+  {
+    ezUInt32 uiNumCached = 0;
+    for (auto pObject : objects)
+    {
+      if (!ezRenderWorld::GetCachedRenderData(view, pObject->GetHandle()).IsEmpty())
+      {
+        ++uiNumCached;
+      }
+    }
+
+    return uiNumCached;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Pipeline, Extractor)
+{
+  // Extraction only needs the render world, so the null device is sufficient and no window or GPU is required.
+  ezGALDeviceCreationDescription deviceDesc;
+  deviceDesc.m_bCreatePrimarySwapChain = false;
+
+  ezGALDeviceNull* pDevice = EZ_DEFAULT_NEW(ezGALDeviceNull, deviceDesc);
+  if (EZ_TEST_BOOL(pDevice->Init().Succeeded()).Failed())
+  {
+    EZ_DEFAULT_DELETE(pDevice);
+    return;
+  }
+
+  ezGALDevice::SetDefaultDevice(pDevice);
+  ezStartup::StartupHighLevelSystems();
+
+  {
+    ezWorldDesc worldDesc("ExtractorTest");
+    ezWorld world(worldDesc);
+
+    ezCamera camera;
+    camera.SetCameraMode(ezCameraMode::PerspectiveFixedFovX, 90.0f, 0.1f, 1000.0f);
+    camera.LookAt(ezVec3::ZeroVector(), ezVec3(1, 0, 0), ezVec3(0, 0, 1));
+
+    ezView* pView = nullptr;
+    ezViewHandle hView = ezRenderWorld::CreateView("ExtractorTest", pView);
+    pView->SetWorld(&world);
+    pView->SetCamera(&camera);
+    pView->SetViewport(ezRectFloat(0.0f, 0.0f, 1920.0f, 1080.0f));
+
+    ezVisibleObjectsExtractor extractor;
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "Render Data Cache")
+    {
+      ezCVarInt* pMaxNewEntries = static_cast<ezCVarInt*>(ezCVar::FindCVarByName("r_CacheRenderDataMaxNewEntries"));
+      EZ_TEST_BOOL(pMaxNewEntries != nullptr);
+      const ezInt32 iOldMaxNewEntries = *pMaxNewEntries;
+
+      ezDynamicArray<const ezGameObject*> objects;
+      CreateLightObjects(world, 100, false, objects);
+      EZ_TEST_BOOL(objects[0]->IsStatic());
+
+      ezDynamicArray<const ezRenderData*> renderData;
+      ezDynamicArray<const ezRenderData*> cachedRenderData;
+
+      // The first frame only measures how many components want to be cached, the cache grows at the end of it.
+      // Nothing is allocated for the new entries upfront, so a view without static objects does not pay for the cvar maximum.
+      ExtractFrame(extractor, *pView, objects, renderData);
+      EZ_TEST_INT(renderData.GetCount(), 100);
+      EZ_TEST_INT(CountCachedObjects(*pView, objects), 0);
+
+      ExtractFrame(extractor, *pView, objects, renderData);
+      EZ_TEST_INT(CountCachedObjects(*pView, objects), 100);
+
+      // from now on the cached render data is reused every frame instead of extracting it again
+      ExtractFrame(extractor, *pView, objects, cachedRenderData);
+      EZ_TEST_INT(cachedRenderData.GetCount(), 100);
+
+      for (auto pObject : objects)
+      {
+        auto cacheEntries = ezRenderWorld::GetCachedRenderData(*pView, pObject->GetHandle());
+        if (EZ_TEST_INT(cacheEntries.GetCount(), 1).Succeeded())
+        {
+          EZ_TEST_BOOL(cachedRenderData.Contains(cacheEntries[0].m_pRenderData));
+          EZ_TEST_BOOL(!renderData.Contains(cacheEntries[0].m_pRenderData));
+        }
+      }
+
+      ExtractFrame(extractor, *pView, objects, renderData);
+      EZ_TEST_BOOL(renderData == cachedRenderData);
+
+      // with a lower limit only that many components are added to the cache per frame
+      *pMaxNewEntries = 30;
+      ezRenderWorld::DeleteCachedRenderData(*pView);
+      ezRenderWorld::EndFrame();
+
+      for (ezUInt32 uiFrame = 1; uiFrame <= 4; ++uiFrame)
+      {
+        ExtractFrame(extractor, *pView, objects, renderData);
+        EZ_TEST_INT(CountCachedObjects(*pView, objects), ezMath::Min(uiFrame * 30, 100u));
+      }
+
+      *pMaxNewEntries = iOldMaxNewEntries;
+
+      {
+        EZ_LOCK(world.GetWriteMarker());
+        for (auto pObject : objects)
+        {
+          world.DeleteObjectNow(pObject->GetHandle());
+        }
+      }
+    }
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "Parallel Extraction")
+    {
+      ezCVarBool* pParallelExtraction = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("r_ParallelExtraction"));
+      ezCVarBool* pMultithreading = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("r_Multithreading"));
+      EZ_TEST_BOOL(pParallelExtraction != nullptr && pMultithreading != nullptr);
+
+      const bool bOldParallelExtraction = *pParallelExtraction;
+      const bool bOldMultithreading = *pMultithreading;
+      *pMultithreading = true;
+
+      // dynamic objects are extracted every frame, enough of them for several chunks, the last one only partially filled
+      ezDynamicArray<const ezGameObject*> objects;
+      CreateLightObjects(world, 1000, true, objects);
+
+      ezDynamicArray<const ezRenderData*> serialRenderData;
+      *pParallelExtraction = false;
+      ExtractFrame(extractor, *pView, objects, serialRenderData);
+
+      ezDynamicArray<const ezRenderData*> parallelRenderData;
+      *pParallelExtraction = true;
+      ExtractFrame(extractor, *pView, objects, parallelRenderData);
+
+      // All lights have the same sorting key, so the order after sorting only depends on the order in which the render data was added.
+      if (EZ_TEST_INT(parallelRenderData.GetCount(), serialRenderData.GetCount()).Succeeded())
+      {
+        EZ_TEST_INT(serialRenderData.GetCount(), 1000);
+
+        bool bSameOrder = true;
+        bool bSameContent = true;
+        for (ezUInt32 i = 0; i < serialRenderData.GetCount(); ++i)
+        {
+          const ezPointLightRenderData* pSerial = static_cast<const ezPointLightRenderData*>(serialRenderData[i]);
+          const ezPointLightRenderData* pParallel = static_cast<const ezPointLightRenderData*>(parallelRenderData[i]);
+
+          bSameOrder &= pSerial->m_hOwner == pParallel->m_hOwner;
+          bSameContent &= pSerial->m_GlobalTransform.IsIdentical(pParallel->m_GlobalTransform) && pSerial->m_fRange == pParallel->m_fRange &&
+                          pSerial->m_uiSortingKey == pParallel->m_uiSortingKey && pSerial->m_uiBatchId == pParallel->m_uiBatchId;
+        }
+
+        EZ_TEST_BOOL(bSameOrder);
+        EZ_TEST_BOOL(bSameContent);
+      }
+
+      *pParallelExtraction = bOldParallelExtraction;
+      *pMultithreading = bOldMultithreading;
+
+      {
+        EZ_LOCK(world.GetWriteMarker());
+        for (auto pObject : objects)
+        {
+          world.DeleteObjectNow(pObject->GetHandle());
+        }
+      }
+    }
+
+    ezRenderWorld::DeleteView(hView);
+  }
+
+  ezStartup::ShutdownHighLevelSystems();
+
+  pDevice->Shutdown().IgnoreResult();
+  EZ_DEFAULT_DELETE(pDevice);
+}
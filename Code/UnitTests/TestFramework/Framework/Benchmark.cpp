@@ -0,0 +1,148 @@
+#include <TestFrameworkPCH.h>
+
+#include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/JSONReader.h>
+#include <Foundation/Types/ScopeExit.h>
+#include <TestFramework/Framework/Benchmark.h>
+#include <TestFramework/Framework/TestFramework.h>
+
+namespace
+{
+  ezResult AddJsonDataDirectory(const char* szFileName, ezStringBuilder& out_sPath)
+  {
+    if (ezPathUtils::IsAbsolutePath(szFileName))
+    {
+      // Make sure we can access raw absolute file paths
+      if (ezFileSystem::AddDataDirectory("", "benchmarks", ":", ezFileSystem::AllowWrites).Failed())
+        return EZ_FAILURE;
+
+      out_sPath = szFileName;
+    }
+    else
+    {
+      // If this is a relative path, we use the eztest/ data directory to make sure that this works properly with the fileserver.
+      if (ezFileSystem::AddDataDirectory(">eztest/", "benchmarks", ":", ezFileSystem::AllowWrites).Failed())
+        return EZ_FAILURE;
+
+      out_sPath = ":";
+      out_sPath.AppendPath(szFileName);
+    }
+
+    return EZ_SUCCESS;
+  }
+} // namespace
+
+////////////////////////////////////////////////////////////////////////
+// ezTestBenchmark public functions
+////////////////////////////////////////////////////////////////////////
+
+ezBenchmarkResult ezTestBenchmark::Record(
+  const char* szName, ezArrayPtr<const ezTime> samples, const char* szFile, ezInt32 iLine, const char* szFunction)
+{
+  ezBenchmarkResult result;
+  result.m_sName = szName;
+  result.Compute(samples);
+
+  if (ezTestFramework* pFramework = ezTestFramework::GetInstance())
+  {
+    pFramework->AddBenchmarkResult(result, szFile, iLine, szFunction);
+  }
+
+  return result;
+}
+
+bool ezTestBenchmark::WriteJsonToFile(const char* szFileName, const ezTestConfiguration& config, const std::deque<ezBenchmarkResult>& results)
+{
+  ezStartup::StartupCoreSystems();
+  EZ_SCOPE_EXIT(ezStartup::ShutdownCoreSystems());
+
+  ezStringBuilder jsonFilename;
+  if (AddJsonDataDirectory(szFileName, jsonFilename).Failed())
+    return false;
+
+  ezFileWriter file;
+  if (file.Open(jsonFilename).Failed())
+    return false;
+
+  ezStandardJSONWriter js;
+  js.SetOutputStream(&file);
+
+  js.BeginObject();
+  {
+    js.BeginObject("configuration");
+    {
+      js.AddVariableUInt32("m_uiCPUCoreCount", config.m_uiCPUCoreCount);
+      js.AddVariableString("m_sPlatformName", config.m_sPlatformName.c_str());
+      js.AddVariableString("m_sBuildConfiguration", config.m_sBuildConfiguration.c_str());
+      js.AddVariableInt64("m_iDateTime", config.m_iDateTime);
+      js.AddVariableInt32("m_iRCSRevision", config.m_iRCSRevision);
+      js.AddVariableString("m_sHostName", config.m_sHostName.c_str());
+    }
+    js.EndObject();
+
+    js.BeginArray("benchmarks");
+    {
+      for (const ezBenchmarkResult& result : results)
+      {
+        js.BeginObject();
+        {
+          js.AddVariableString("m_sName", result.m_sName.c_str());
+          js.AddVariableUInt32("m_uiRuns", result.m_uiSamples);
+          js.AddVariableDouble("m_fMedian", result.m_fMedian);
+          js.AddVariableDouble("m_fPercentile95", result.m_fPercentile95);
+          js.AddVariableDouble("m_fMedianAbsoluteDeviation", result.m_fMedianAbsoluteDeviation);
+          js.AddVariableDouble("m_fMin", result.m_fMin);
+          js.AddVariableDouble("m_fMax", result.m_fMax);
+          js.AddVariableDouble("m_fMean", result.m_fMean);
+        }
+        js.EndObject();
+      }
+    }
+    js.EndArray();
+  }
+  js.EndObject();
+
+  return true;
+}
+
+ezResult ezTestBenchmark::ReadBaselineFromFile(const char* szFileName, std::map<std::string, double>& out_baseline)
+{
+  ezStartup::StartupCoreSystems();
+  EZ_SCOPE_EXIT(ezStartup::ShutdownCoreSystems());
+
+  ezStringBuilder jsonFilename;
+  if (AddJsonDataDirectory(szFileName, jsonFilename).Failed())
+    return EZ_FAILURE;
+
+  ezFileReader file;
+  if (file.Open(jsonFilename).Failed())
+    return EZ_FAILURE;
+
+  ezJSONReader reader;
+  if (reader.Parse(file).Failed())
+    return EZ_FAILURE;
+
+  const ezVariant* pBenchmarks = nullptr;
+  if (!reader.GetTopLevelObject().TryGetValue("benchmarks", pBenchmarks) || !pBenchmarks->IsA<ezVariantArray>())
+    return EZ_FAILURE;
+
+  for (const ezVariant& benchmark : pBenchmarks->Get<ezVariantArray>())
+  {
+    if (!benchmark.IsA<ezVariantDictionary>())
+      continue;
+
+    const ezVariantDictionary& values = benchmark.Get<ezVariantDictionary>();
+
+    const ezVariant* pName = nullptr;
+    const ezVariant* pMedian = nullptr;
+    if (values.TryGetValue("m_sName", pName) && values.TryGetValue("m_fMedian", pMedian) && pName->IsA<ezString>() &&
+        pMedian->CanConvertTo<double>())
+    {
+      out_baseline[pName->Get<ezString>().GetData()] = pMedian->ConvertTo<double>();
+    }
+  }
+
+  return EZ_SUCCESS;
+}
+
+EZ_STATICLINK_FILE(TestFramework, TestFramework_Framework_Benchmark);
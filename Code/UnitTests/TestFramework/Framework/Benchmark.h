@@ -0,0 +1,88 @@
+#pragma once
+
+#include <Foundation/Containers/HybridArray.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <Foundation/Time/TimeStatistics.h>
+#include <TestFramework/Framework/TestResults.h>
+#include <TestFramework/TestFrameworkDLL.h>
+
+#include <deque>
+#include <map>
+#include <string>
+
+/// \brief Configures how often a benchmark is executed by ezTestBenchmark::Run().
+struct ezBenchmarkSettings
+{
+  ezUInt32 m_uiWarmupRuns = 3; ///< Runs that are executed before measuring, to fill caches and let lazy initialization happen.
+  ezUInt32 m_uiRuns = 21;      ///< Number of measured runs. An odd number makes the median an actual sample.
+};
+
+/// \brief The statistics of all measured runs of a single benchmark, see ezTimeStatistics.
+struct EZ_TEST_DLL ezBenchmarkResult : public ezTimeStatistics
+{
+  std::string m_sName;
+};
+
+/// \brief Helper functions to measure benchmarks inside of tests.
+///
+/// Benchmarks are usually put into test blocks that are tagged with ezTestBlock::Benchmark, which are only executed when the
+/// test application is started with '-benchmark'. All results are written to the json file passed via '-benchmarkJson'.
+/// If a baseline file from a previous run is passed via '-benchmarkBaseline', every benchmark whose median is more than
+/// '-benchmarkThreshold' percent (default 10) slower than in the baseline, fails its test.
+///
+/// Running on a CI machine without a window could look like this:
+///   FoundationTest -nogui -all -close -filter Performance -benchmark -benchmarkJson bench.json -benchmarkBaseline baseline.json
+class EZ_TEST_DLL ezTestBenchmark
+{
+public:
+  /// \brief Executes func the configured number of times, measures every run and reports the result to the test framework.
+  template <typename Func>
+  static ezBenchmarkResult Run(
+    const char* szName, const ezBenchmarkSettings& settings, const char* szFile, ezInt32 iLine, const char* szFunction, Func func);
+
+  /// \brief Reports the statistics of samples that were measured elsewhere, e.g. the frame times of an application.
+  static ezBenchmarkResult Record(const char* szName, ezArrayPtr<const ezTime> samples, const char* szFile, ezInt32 iLine, const char* szFunction);
+
+  /// \brief Writes all results into a json file. Relative paths are written to the eztest/ data directory.
+  static bool WriteJsonToFile(const char* szFileName, const ezTestConfiguration& config, const std::deque<ezBenchmarkResult>& results);
+
+  /// \brief Reads the median of all benchmarks from a file that was written with WriteJsonToFile().
+  static ezResult ReadBaselineFromFile(const char* szFileName, std::map<std::string, double>& out_baseline);
+};
+
+template <typename Func>
+ezBenchmarkResult ezTestBenchmark::Run(
+  const char* szName, const ezBenchmarkSettings& settings, const char* szFile, ezInt32 iLine, const char* szFunction, Func func)
+{
+  for (ezUInt32 i = 0; i < settings.m_uiWarmupRuns; ++i)
+  {
+    func();
+  }
+
+  ezHybridArray<ezTime, 64> samples;
+  samples.Reserve(settings.m_uiRuns);
+
+  ezStopwatch sw;
+  for (ezUInt32 i = 0; i < settings.m_uiRuns; ++i)
+  {
+    sw.Checkpoint();
+    func();
+    samples.PushBack(sw.Checkpoint());
+  }
+
+  return Record(szName, samples, szFile, iLine, szFunction);
+}
+
+/// \brief Measures the given function with the default ezBenchmarkSettings and reports the result under the given name.
+///
+/// The function is passed as the last argument, such that lambdas may contain commas that are not enclosed in parentheses, e.g.
+///   EZ_TEST_BENCHMARK("Sort", [&]() { ezUInt32 a = 0, b = 1; Sort(a, b); });
+#define EZ_TEST_BENCHMARK(szName, ...)                                                                                                               \
+  ezTestBenchmark::Run(szName, ezBenchmarkSettings(), EZ_SOURCE_FILE, EZ_SOURCE_LINE, EZ_SOURCE_FUNCTION, __VA_ARGS__)
+
+/// \brief Same as EZ_TEST_BENCHMARK, but with custom ezBenchmarkSettings.
+#define EZ_TEST_BENCHMARK_SETTINGS(szName, settings, ...)                                                                                            \
+  ezTestBenchmark::Run(szName, settings, EZ_SOURCE_FILE, EZ_SOURCE_LINE, EZ_SOURCE_FUNCTION, __VA_ARGS__)
+
+/// \brief Reports externally measured samples, e.g. frame times, as a benchmark result.
+#define EZ_TEST_BENCHMARK_SAMPLES(szName, samples) ezTestBenchmark::Record(szName, samples, EZ_SOURCE_FILE, EZ_SOURCE_LINE, EZ_SOURCE_FUNCTION)
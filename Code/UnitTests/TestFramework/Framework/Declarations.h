@@ -66,4 +66,8 @@ struct TestSettings
   bool m_bEnableAllTests = false;    /// Enables all test.
   std::string m_sTestFilter;         /// Filter that does a 'contains' test on each test name.
   ezUInt8 m_uiFullPasses = 1;        /// All tests are done this often, to check whether some tests fail only when executed multiple times.
+  bool m_bRunBenchmarks = false;     /// Executes test blocks that are tagged with ezTestBlock::Benchmark.
+  std::string m_sBenchmarkOutput;    /// Path to the json file the benchmark results should be written to.
+  std::string m_sBenchmarkBaseline;  /// Path to a benchmark json file of a previous run, that the results are compared against.
+  double m_fBenchmarkThreshold = 10; /// How many percent a benchmark median may exceed the baseline, before the test fails.
 };
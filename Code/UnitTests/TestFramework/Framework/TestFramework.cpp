@@ -303,6 +303,15 @@ void ezTestFramework::GetTestSettingsFromCommandLine(const ezCommandLineUtils& c
   if (cmd.GetStringOptionArguments("-json") == 1)
     m_Settings.m_sJsonOutput = cmd.GetStringOption("-json", 0, "");
 
+  m_Settings.m_bRunBenchmarks = cmd.GetBoolOption("-benchmark", false);
+  m_Settings.m_fBenchmarkThreshold = cmd.GetFloatOption("-benchmarkThreshold", m_Settings.m_fBenchmarkThreshold);
+
+  if (cmd.GetStringOptionArguments("-benchmarkJson") == 1)
+    m_Settings.m_sBenchmarkOutput = cmd.GetStringOption("-benchmarkJson", 0, "");
+
+  if (cmd.GetStringOptionArguments("-benchmarkBaseline") == 1)
+    m_Settings.m_sBenchmarkBaseline = cmd.GetStringOption("-benchmarkBaseline", 0, "");
+
   if (cmd.GetStringOptionArguments("-outputDir") == 1)
   {
     m_sAbsTestOutputDir = cmd.GetStringOption("-outputDir", 0, "");
@@ -576,6 +585,18 @@ void ezTestFramework::StartTests()
   m_bTestsRunning = true;
   ezTestFramework::Output(ezTestOutput::StartOutput, "");
 
+  m_BenchmarkResults.clear();
+  m_BenchmarkBaseline.clear();
+
+  if (m_Settings.m_bRunBenchmarks && !m_Settings.m_sBenchmarkBaseline.empty())
+  {
+    if (ezTestBenchmark::ReadBaselineFromFile(m_Settings.m_sBenchmarkBaseline.c_str(), m_BenchmarkBaseline).Failed())
+    {
+      ezTestFramework::Output(
+        ezTestOutput::Warning, "Failed to read benchmark baseline '%s', results are not compared.", m_Settings.m_sBenchmarkBaseline.c_str());
+    }
+  }
+
   // Start timeout thread.
   std::scoped_lock lock(m_timeoutLock);
   m_useTimeout = true;
@@ -787,6 +808,9 @@ void ezTestFramework::EndTests()
   if (!m_Settings.m_sJsonOutput.empty())
     m_Result.WriteJsonToFile(m_Settings.m_sJsonOutput.c_str());
 
+  if (m_Settings.m_bRunBenchmarks && !m_Settings.m_sBenchmarkOutput.empty())
+    ezTestBenchmark::WriteJsonToFile(m_Settings.m_sBenchmarkOutput.c_str(), m_Result.GetConfiguration(), m_BenchmarkResults);
+
   m_iExecutingTest = -1;
   m_iExecutingSubTest = -1;
   m_bAbortTests = false;
@@ -1536,10 +1560,43 @@ ezResult ezTestFramework::CaptureRegressionStat(ezStringView testName, ezStringV
   return EZ_SUCCESS;
 }
 
+void ezTestFramework::AddBenchmarkResult(ezBenchmarkResult& ref_result, const char* szFile, ezInt32 iLine, const char* szFunction)
+{
+  // make the name unique across all tests, so that it can be found in the baseline again
+  if (const ezSubTestEntry* pSubTest = GetCurrentSubTest())
+  {
+    ref_result.m_sName = std::string(GetCurrentTest()->m_szTestName) + "." + pSubTest->m_szSubTestName + "." + ref_result.m_sName;
+  }
+
+  ezTestFramework::Output(ezTestOutput::Details, "Benchmark '%s': median %.4f ms, p95 %.4f ms, MAD %.4f ms (%u runs)", ref_result.m_sName.c_str(),
+    ref_result.m_fMedian, ref_result.m_fPercentile95, ref_result.m_fMedianAbsoluteDeviation, ref_result.m_uiSamples);
+
+  m_BenchmarkResults.push_back(ref_result);
+
+  auto it = m_BenchmarkBaseline.find(ref_result.m_sName);
+  if (it == m_BenchmarkBaseline.end())
+    return;
+
+  const double fBaseline = it->second;
+  const double fAllowed = fBaseline * (1.0 + m_Settings.m_fBenchmarkThreshold / 100.0);
+
+  if (ref_result.m_fMedian > fAllowed)
+  {
+    ezTestFramework::Error("Benchmark regression", szFile, iLine, szFunction,
+      "'%s' takes %.4f ms, the baseline is %.4f ms (+%.1f%%, %.1f%% allowed)", ref_result.m_sName.c_str(), ref_result.m_fMedian, fBaseline,
+      (ref_result.m_fMedian / fBaseline - 1.0) * 100.0, m_Settings.m_fBenchmarkThreshold);
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////
 // ezTestFramework static functions
 ////////////////////////////////////////////////////////////////////////
 
+bool ezTestFramework::IsBenchmarkModeEnabled()
+{
+  return s_pInstance != nullptr && s_pInstance->m_Settings.m_bRunBenchmarks;
+}
+
 void ezTestFramework::Output(ezTestOutput::Enum Type, const char* szMsg, ...)
 {
   va_list args;
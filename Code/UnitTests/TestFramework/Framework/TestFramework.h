@@ -1,5 +1,6 @@
 #pragma once
 
+#include <TestFramework/Framework/Benchmark.h>
 #include <TestFramework/Framework/Declarations.h>
 #include <TestFramework/Framework/SimpleTest.h>
 #include <TestFramework/Framework/TestBaseClass.h>
@@ -119,6 +120,14 @@ public:
 
   static ezResult CaptureRegressionStat(ezStringView testName, ezStringView name, ezStringView unit, float value, ezInt32 testId = -1);
 
+  // Benchmarks
+  /// \brief Returns whether test blocks tagged with ezTestBlock::Benchmark are executed ('-benchmark' command line option).
+  static bool IsBenchmarkModeEnabled();
+
+  /// \brief Stores the result for the json output and fails the current test, if it is slower than the baseline. See ezTestBenchmark.
+  void AddBenchmarkResult(ezBenchmarkResult& ref_result, const char* szFile, ezInt32 iLine, const char* szFunction);
+  const std::deque<ezBenchmarkResult>& GetBenchmarkResults() const { return m_BenchmarkResults; }
+
 protected:
   void Initialize();
   void DeInitialize();
@@ -201,6 +210,10 @@ private:
   std::string m_sImageReferenceFolderName = "Images_Reference";
   std::string m_sImageReferenceOverrideFolderName;
 
+  // benchmarks
+  std::deque<ezBenchmarkResult> m_BenchmarkResults;
+  std::map<std::string, double> m_BenchmarkBaseline; ///< Median per benchmark name, read from m_Settings.m_sBenchmarkBaseline.
+
 protected:
   ezInt32 m_iCurrentTestIndex = -1;
   ezInt32 m_iCurrentSubTestIndex = -1;
@@ -313,6 +326,7 @@ struct ezTestBlock
     Enabled,           ///< The test block is enabled.
     Disabled,          ///< The test block will be skipped. The test framework will print a warning message, that some block is deactivated.
     DisabledNoWarning, ///< The test block will be skipped, but no warning printed. Used to deactivate 'on demand/optional' tests.
+    Benchmark,         ///< The test block is only executed when benchmarks are enabled ('-benchmark'), otherwise it is skipped without a warning.
   };
 };
 
@@ -330,7 +344,7 @@ struct ezTestBlock
     ezTestFramework::s_szTestBlockName = "";                                                                                                         \
     ezTestFramework::Output(ezTestOutput::Warning, "Skipped Test Block '%s'", name);                                                                 \
   }                                                                                                                                                  \
-  else if (enable == ezTestBlock::DisabledNoWarning)                                                                                                 \
+  else if (enable == ezTestBlock::DisabledNoWarning || (enable == ezTestBlock::Benchmark && !ezTestFramework::IsBenchmarkModeEnabled()))             \
   {                                                                                                                                                  \
     ezTestFramework::s_szTestBlockName = "";                                                                                                         \
   }                                                                                                                                                  \
@@ -132,6 +132,7 @@ public:
   ezInt32 GetTestIndexByName(const char* szTestName) const;
   ezInt32 GetSubTestIndexByName(ezUInt32 uiTestIndex, const char* szSubTestName) const;
   double GetTotalTestDuration() const;
+  const ezTestConfiguration& GetConfiguration() const { return m_config; }
   const ezTestResultData& GetTestResultData(ezUInt32 uiTestIndex, ezInt32 iSubTestIndex) const;
 
   // Test output
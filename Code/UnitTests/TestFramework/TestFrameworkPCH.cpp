@@ -5,6 +5,7 @@ EZ_STATICLINK_LIBRARY(TestFramework)
   if (bReturn)
     return;
 
+  EZ_STATICLINK_REFERENCE(TestFramework_Framework_Benchmark);
   EZ_STATICLINK_REFERENCE(TestFramework_Framework_Qt_qtLogMessageDock);
   EZ_STATICLINK_REFERENCE(TestFramework_Framework_Qt_qtTestDelegate);
   EZ_STATICLINK_REFERENCE(TestFramework_Framework_Qt_qtTestFramework);